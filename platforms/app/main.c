@@ -26,9 +26,8 @@
 #include "m3_env.h"
 
 /*
- * NOTE: Gas metering/limit only applies to pre-instrumented modules.
- * You can generate a metered version from any wasm file automatically, using
- *   https://github.com/ewasm/wasm-metering
+ * NOTE: Modules pre-instrumented to import metering.usegas (e.g. by https://github.com/ewasm/wasm-metering)
+ * are limited by that. Any other module is metered natively (1 gas per opcode) once --gas-limit is given.
  */
 #define GAS_LIMIT       500000000
 #define GAS_FACTOR      10000LL
@@ -43,12 +42,16 @@ static IM3Runtime runtime;
 
 static u8* wasm_bins[MAX_MODULES];
 static int wasm_bins_qty = 0;
+static bool use_jit = false;
+static unsigned jit_threshold = 0;
 
 #if defined(GAS_LIMIT)
 
 static int64_t initial_gas = GAS_FACTOR * GAS_LIMIT;
 static int64_t current_gas = GAS_FACTOR * GAS_LIMIT;
 static bool is_gas_metered = false;
+static bool is_gas_native = false;
+static uint64_t native_gas_limit = 0;
 
 m3ApiRawFunction(metering_usegas)
 {
@@ -90,7 +93,18 @@ M3Result link_all  (IM3Module module)
         fprintf(stderr, "Warning: Gas is limited to %0.4f\n", (double)(current_gas) / GAS_FACTOR);
         is_gas_metered = true;
     }
-    if (res == m3Err_functionLookupFailed) { res = NULL; }
+    if (res == m3Err_functionLookupFailed) {
+        res = NULL;
+        // functions are compiled lazily, so metering can still be switched on for this module
+        if (native_gas_limit && !is_gas_native) {
+            res = m3_EnableGasMetering (env, NULL);
+            if (!res) res = m3_SetGasLimit (module->runtime, native_gas_limit);
+            if (!res) {
+                fprintf(stderr, "Warning: Gas is limited to %" PRIu64 "\n", native_gas_limit);
+                is_gas_native = true;
+            }
+        }
+    }
 #endif
 
     return res;
@@ -222,6 +236,9 @@ void print_gas_used()
     if (is_gas_metered) {
         fprintf(stderr, "Gas used: %0.4f\n", (double)(initial_gas - current_gas) / GAS_FACTOR);
     }
+    if (is_gas_native) {
+        fprintf(stderr, "Gas used: %" PRIu64 "\n", m3_GetGasUsed (runtime));
+    }
 #endif
 }
 
@@ -455,6 +472,27 @@ M3Result repl_dump  ()
     return m3Err_none;
 }
 
+M3Result repl_preinit  (const char* init, const char* fn)
+{
+    uint8_t* wasm;
+    uint32_t len;
+    M3Result result = m3_PreinitializeModule(runtime->modules, init, &wasm, &len);
+    if (result) return result;
+
+    FILE* f = fopen (fn, "wb");
+    if (!f) {
+        result = "cannot open file";
+    } else {
+        if (fwrite (wasm, 1, len, f) != len) {
+            result = "cannot write file";
+        }
+        fclose (f);
+    }
+
+    m3_FreePreinitializedModule(wasm);
+    return result;
+}
+
 void repl_free  ()
 {
     if (runtime) {
@@ -475,6 +513,18 @@ M3Result repl_init  (unsigned stack)
     if (runtime == NULL) {
         return "m3_NewRuntime failed";
     }
+    if (jit_threshold) {
+        M3Result result = m3_EnableTiering (runtime, jit_threshold);
+        if (result) return result;
+    } else if (use_jit) {
+        M3Result result = m3_EnableJit (runtime);
+        if (result) return result;
+    }
+#if defined(GAS_LIMIT)
+    if (is_gas_native) {
+        return m3_SetGasLimit (runtime, native_gas_limit);
+    }
+#endif
     return m3Err_none;
 }
 
@@ -552,8 +602,12 @@ void print_usage() {
     puts("  --func <function>     function to run       default: _start");
     puts("  --stack-size <size>   stack size in bytes   default: 64KB");
     puts("  --compile             disable lazy compilation");
+    puts("  --cache-dir <dir>     cache compiled code   implies --compile");
     puts("  --dump-on-trap        dump wasm memory");
     puts("  --gas-limit           set gas limit");
+    puts("  --jit                 translate functions to native code (x86-64 Linux)");
+    puts("  --jit-threshold <n>   translate functions once they've been called or looped n times");
+    puts("  --preinit <file>      write the module, initialized by its start function & --func, to <file>");
 }
 
 #define ARGV_SHIFT()  { i_argc--; i_argv++; }
@@ -570,6 +624,8 @@ int  main  (int i_argc, const char* i_argv[])
     bool argCompile = false;
     const char* argFile = NULL;
     const char* argFunc = "_start";
+    const char* argPreinit = NULL;
+    bool argFuncSet = false;
     unsigned argStackSize = 64*1024;
 
 //    m3_PrintM3Info ();
@@ -594,6 +650,19 @@ int  main  (int i_argc, const char* i_argv[])
             argDumpOnTrap = true;
         } else if (!strcmp("--compile", arg)) {
             argCompile = true;
+        } else if (!strcmp("--jit", arg)) {
+            use_jit = true;
+        } else if (!strcmp("--jit-threshold", arg)) {
+            const char* tmp = "1000";
+            ARGV_SET(tmp);
+            jit_threshold = atol(tmp);
+            use_jit = true;
+        } else if (!strcmp("--cache-dir", arg)) {
+            const char* argCacheDir = NULL;
+            ARGV_SET(argCacheDir);
+            result = m3_SetCodeCacheDirectory(env, argCacheDir);
+            if (result) FATAL("m3_SetCodeCacheDirectory: %s", result);
+            argCompile = true;
         } else if (!strcmp("--stack-size", arg)) {
             const char* tmp = "65536";
             ARGV_SET(tmp);
@@ -602,12 +671,16 @@ int  main  (int i_argc, const char* i_argv[])
             const char* tmp = "0";
             ARGV_SET(tmp);
             initial_gas = current_gas = GAS_FACTOR * atol(tmp);
+            native_gas_limit = strtoull(tmp, NULL, 10);
         } else if (!strcmp("--dir", arg)) {
             const char* argDir;
             ARGV_SET(argDir);
             (void)argDir;
         } else if (!strcmp("--func", arg) or !strcmp("-f", arg)) {
             ARGV_SET(argFunc);
+            argFuncSet = true;
+        } else if (!strcmp("--preinit", arg)) {
+            ARGV_SET(argPreinit);
         }
     }
 
@@ -631,6 +704,12 @@ int  main  (int i_argc, const char* i_argv[])
             repl_compile();
         }
 
+        if (argPreinit) {
+            result = repl_preinit(argFuncSet ? argFunc : NULL, argPreinit);
+            if (result) FATAL("repl_preinit: %s", result);
+            goto _onfatal;
+        }
+
         if (argFunc and not argRepl) {
             if (!strcmp(argFunc, "_start")) {
                 // When passing args to WASI, include wasm filename as argv[0]
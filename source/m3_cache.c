@@ -0,0 +1,648 @@
+//
+//  m3_cache.c
+//
+//  On-disk cache of compiled modules
+//
+
+#include <stdio.h>
+
+#include "m3_cache.h"
+#include "m3_exception.h"
+
+// a cached image is the module's code pages verbatim, plus a list of the words in them that hold addresses. those
+// are stored as an index (page, function, global, type) or, for operations, as an offset into the wasm3 binary.
+// images are only valid for the exact build that produced them: the build id fingerprints the operation layout.
+
+#define c_m3CacheMagic          0x6363336d      // "m3cc"
+#define c_m3CacheVersion        4
+
+enum
+{
+    c_m3Reloc_op,               // value: offset from GetRelocationAnchor ()
+    c_m3Reloc_code,             // index: page; value: line
+    c_m3Reloc_function,         // index: function
+    c_m3Reloc_functionEntry,    // index: function that was compiled outside of the cached pages (host functions)
+    c_m3Reloc_global,           // index: global; value: offset into the M3Global
+    c_m3Reloc_module,
+    c_m3Reloc_funcType          // index: module type
+};
+
+typedef struct M3CacheHeader
+{
+    u32                     magic;
+    u32                     version;
+    u64                     buildId;
+    u64                     moduleHash;
+
+    u32                     numFunctions;
+    u32                     numGlobals;
+    u32                     numFuncTypes;
+
+    u32                     numPages;
+    u32                     numRelocations;
+    u32                     numCompiled;
+}
+M3CacheHeader;
+
+typedef struct M3CachePage
+{
+    u32                     numLines;
+    u32                     numMapEntries;
+}
+M3CachePage;
+
+typedef struct M3CacheRelocation
+{
+    u32                     page;
+    u32                     line;
+    u32                     kind;
+    u32                     index;
+    u64                     value;
+}
+M3CacheRelocation;
+
+typedef struct M3CacheFunction
+{
+    u32                     index;
+    u32                     page;
+    u32                     line;
+
+    u16                     maxStackSlots;
+    u16                     numRetSlots;
+    u16                     numRetAndArgSlots;
+    u16                     numLocalBytes;
+    u16                     firstZeroedLocalByte;
+    u16                     numZeroedLocalBytes;
+    u16                     numConstantBytes;
+    u16                     unused;
+}
+M3CacheFunction;
+
+
+static const char * const   c_m3Err_cacheMismatch       = "code cache doesn't match the module";
+static const char * const   c_m3Err_cacheCorrupt        = "code cache is corrupt";
+static const char * const   c_m3Err_cacheUnrelocatable  = "compiled code can't be relocated";
+
+
+static
+u64  Hash  (u64 i_hash, const void * i_data, size_t i_size)
+{
+    const u8 * data = (const u8 *) i_data;
+
+    // FNV-1a
+    while (i_size--)
+    {
+        i_hash ^= * data++;
+        i_hash *= 0x100000001b3ull;
+    }
+
+    return i_hash;
+}
+
+static const u64 c_hashBasis = 0xcbf29ce484222325ull;
+
+
+static
+const u8 *  GetRelocationAnchor  (void)
+{
+    return (const u8 *) (uintptr_t) & GetOpInfo;
+}
+
+
+static
+u64  GetBuildId  (void)
+{
+    u64 hash = Hash (c_hashBasis, M3_VERSION, sizeof (M3_VERSION));
+
+    const u32 config [] = { M3_SIZEOF_PTR, d_m3Use32BitSlots, d_m3RecordBacktraces, d_m3CompactCode, c_m3CacheVersion,
+                            sizeof (M3Function), sizeof (M3Global), sizeof (M3CodePageHeader) };
+    hash = Hash (hash, config, sizeof (config));
+
+    const u8 * anchor = GetRelocationAnchor ();
+
+    for (u32 i = 0; i < 0x200; ++i)
+    {
+        m3opcode_t opcode = (i < 0x100) ? i : ((c_waOp_extended << 8) | (i & 0xff));
+        IM3OpInfo info = GetOpInfo (opcode);
+
+        if (info)
+        {
+            for (u32 j = 0; j < 4; ++j)
+            {
+                i64 offset = info->operations [j] ? (const u8 *) (uintptr_t) info->operations [j] - anchor : 0;
+                hash = Hash (hash, & offset, sizeof (offset));
+            }
+        }
+    }
+
+    return hash;
+}
+
+
+static
+M3Result  GetCachePath  (char * o_path, size_t i_size, IM3Module i_module, cstr_t i_directory, u64 * o_buildId, u64 * o_moduleHash)
+{
+    * o_buildId = GetBuildId ();
+    * o_moduleHash = Hash (c_hashBasis, i_module->wasmStart, i_module->wasmEnd - i_module->wasmStart);
+
+    // metered code is different code
+    u32 * gasCosts = i_module->environment->gasCosts;
+    if (gasCosts)
+        * o_moduleHash = Hash (* o_moduleHash, gasCosts, 256 * sizeof (u32));
+
+#if d_m3HasJit
+    // so is code counted for tiering
+    IM3Runtime runtime = i_module->runtime;
+    if (runtime and runtime->tierThreshold and not i_module->isTemplate)
+    {
+        u8 counted = 1;
+        * o_moduleHash = Hash (* o_moduleHash, & counted, sizeof (counted));
+    }
+#endif
+
+    int length = snprintf (o_path, i_size, "%s/%016llx%016llx.m3c", i_directory,
+                           (unsigned long long) * o_buildId, (unsigned long long) * o_moduleHash);
+
+    return (length > 0 and (size_t) length < i_size) ? m3Err_none : "code cache path too long";
+}
+
+
+static
+bool  FindPageLine  (IM3CodePage * i_pages, u32 i_numPages, const void * i_pc, u32 * o_page, u32 * o_line)
+{
+    for (u32 i = 0; i < i_numPages; ++i)
+    {
+        IM3CodePage page = i_pages [i];
+        pc_t start = GetPageStartPC (page);
+
+        if ((pc_t) i_pc >= start and (pc_t) i_pc <= GetPagePC (page))
+        {
+            * o_page = i;
+            * o_line = (u32) ((pc_t) i_pc - start);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static
+M3Result  ClassifyPointer  (M3CacheRelocation * io_relocation, IM3Module i_module, IM3CodePage * i_pages, u32 i_numPages, const void * i_pointer)
+{
+    u32 page, line;
+    const u8 * pointer = (const u8 *) i_pointer;
+
+    const u8 * functions = (const u8 *) i_module->functions;
+    const u8 * globals = (const u8 *) i_module->globals;
+
+    if (FindPageLine (i_pages, i_numPages, i_pointer, & page, & line))
+    {
+        io_relocation->kind = c_m3Reloc_code;
+        io_relocation->index = page;
+        io_relocation->value = line;
+        return m3Err_none;
+    }
+
+    if (pointer >= functions and pointer < functions + i_module->numFunctions * sizeof (M3Function))
+    {
+        size_t offset = pointer - functions;
+
+        if (offset % sizeof (M3Function) == 0)
+        {
+            io_relocation->kind = c_m3Reloc_function;
+            io_relocation->index = (u32) (offset / sizeof (M3Function));
+            return m3Err_none;
+        }
+    }
+
+    if (pointer >= globals and pointer < globals + i_module->numGlobals * sizeof (M3Global))
+    {
+        size_t offset = pointer - globals;
+
+        io_relocation->kind = c_m3Reloc_global;
+        io_relocation->index = (u32) (offset / sizeof (M3Global));
+        io_relocation->value = offset % sizeof (M3Global);
+        return m3Err_none;
+    }
+
+    if (i_pointer == i_module)
+    {
+        io_relocation->kind = c_m3Reloc_module;
+        return m3Err_none;
+    }
+
+    for (u32 i = 0; i < i_module->numFuncTypes; ++i)
+    {
+        if (i_pointer == i_module->funcTypes [i])
+        {
+            io_relocation->kind = c_m3Reloc_funcType;
+            io_relocation->index = i;
+            return m3Err_none;
+        }
+    }
+
+    for (u32 i = 0; i < i_module->numFunctions; ++i)
+    {
+        if (i_pointer == i_module->functions [i].compiled)
+        {
+            io_relocation->kind = c_m3Reloc_functionEntry;
+            io_relocation->index = i;
+            return m3Err_none;
+        }
+    }
+
+    return c_m3Err_cacheUnrelocatable;
+}
+
+
+#define WriteCache(DATA, SIZE)      { checksum = Hash (checksum, DATA, SIZE); \
+                                      _throwif ("code cache write failed", fwrite (DATA, 1, SIZE, file) != (SIZE)); }
+
+M3Result  SaveCodeCache  (IM3Module i_module, cstr_t i_directory, IM3CodePage i_pages, M3CodeRelocations * i_relocations)
+{
+    M3Result result = m3Err_none;
+
+    IM3CodePage * pages = NULL;
+    M3CacheRelocation * relocations = NULL;
+    FILE * file = NULL;
+
+    char path [1024];
+    char tempPath [1040];
+    u64 buildId, moduleHash;
+    u64 checksum = c_hashBasis;
+    M3CacheHeader header;
+
+    const u8 * anchor = GetRelocationAnchor ();
+
+    u32 numPages = CountCodePages (i_pages);
+    u32 numSites = i_relocations->ops.numSites + i_relocations->pointers.numSites;
+    u32 numRelocations = 0;
+
+    if (not numPages)
+        return m3Err_none;
+
+_   (GetCachePath (path, sizeof (path), i_module, i_directory, & buildId, & moduleHash));
+    snprintf (tempPath, sizeof (tempPath), "%s.tmp", path);
+
+    pages = m3_AllocArray (IM3CodePage, numPages);
+    _throwifnull (pages);
+
+    for (u32 i = 0; i < numPages; ++i)
+    {
+        pages [i] = i_pages;
+        i_pages = i_pages->info.next;
+    }
+
+    relocations = m3_AllocArray (M3CacheRelocation, numSites);
+    _throwifnull (relocations);
+
+    for (u32 i = 0; i < numSites; ++i)
+    {
+        bool isOp = (i < i_relocations->ops.numSites);
+        pc_t site = isOp ? i_relocations->ops.sites [i] : i_relocations->pointers.sites [i - i_relocations->ops.numSites];
+        const void * pointer = isOp ? (const void *) d_m3Operation (* site) : * (const void * const *) site;
+
+        // null pointers (e.g. the module of template code) are stored as they are
+        if (not pointer)
+            continue;
+
+        M3CacheRelocation * relocation = & relocations [numRelocations++];
+
+        _throwif (c_m3Err_cacheUnrelocatable, not FindPageLine (pages, numPages, site, & relocation->page, & relocation->line));
+
+        if (isOp)
+        {
+            relocation->kind = c_m3Reloc_op;
+            relocation->value = (u64) ((const u8 *) pointer - anchor);
+        }
+        else
+        {
+_           (ClassifyPointer (relocation, i_module, pages, numPages, pointer));
+        }
+    }
+
+    header = (M3CacheHeader) { c_m3CacheMagic, c_m3CacheVersion, buildId, moduleHash,
+                               i_module->numFunctions, i_module->numGlobals, i_module->numFuncTypes,
+                               numPages, numRelocations, 0 };
+
+    for (u32 i = 0; i < i_module->numFunctions; ++i)
+    {
+        u32 page, line;
+        if (i_module->functions [i].wasm and FindPageLine (pages, numPages, i_module->functions [i].compiled, & page, & line))
+            header.numCompiled++;
+    }
+
+    file = fopen (tempPath, "wb");
+    _throwif ("code cache couldn't be created", not file);
+
+    WriteCache (& header, sizeof (header));
+
+    for (u32 i = 0; i < numPages; ++i)
+    {
+        IM3CodePage page = pages [i];
+        M3CachePage info = { page->info.lineIndex, 0 };
+
+#       if d_m3RecordBacktraces
+            info.numMapEntries = page->info.mapping->size;
+#       endif
+
+        WriteCache (& info, sizeof (info));
+        WriteCache (GetPageStartPC (page), info.numLines * sizeof (code_t));
+
+#       if d_m3RecordBacktraces
+            WriteCache (page->info.mapping->entries, info.numMapEntries * sizeof (M3CodeMapEntry));
+#       endif
+    }
+
+    WriteCache (relocations, numRelocations * sizeof (M3CacheRelocation));
+
+    for (u32 i = 0; i < i_module->numFunctions; ++i)
+    {
+        IM3Function function = & i_module->functions [i];
+        M3CacheFunction record = { i };
+
+        if (function->wasm and FindPageLine (pages, numPages, function->compiled, & record.page, & record.line))
+        {
+            record.maxStackSlots        = function->maxStackSlots;
+            record.numRetSlots          = function->numRetSlots;
+            record.numRetAndArgSlots    = function->numRetAndArgSlots;
+            record.numLocalBytes        = function->numLocalBytes;
+            record.firstZeroedLocalByte = function->firstZeroedLocalByte;
+            record.numZeroedLocalBytes  = function->numZeroedLocalBytes;
+            record.numConstantBytes     = function->numConstantBytes;
+
+            WriteCache (& record, sizeof (record));
+            WriteCache (function->constants, function->numConstantBytes);
+        }
+    }
+
+    // the image is trailed by a hash of everything before it, so that damaged files are never executed
+    _throwif ("code cache write failed", fwrite (& checksum, 1, sizeof (checksum), file) != sizeof (checksum));
+
+    {
+        int closed = fclose (file);
+        file = NULL;
+        _throwif ("code cache write failed", closed != 0);
+    }
+
+    // written aside and renamed, so that concurrent processes never see a partial image
+    _throwif ("code cache couldn't be created", rename (tempPath, path) != 0);
+
+    _catch:
+
+    if (file)
+        fclose (file);
+
+    if (result)
+        remove (tempPath);
+
+    m3_Free (relocations);
+    m3_Free (pages);
+
+    return result;
+}
+
+
+static
+M3Result  ReadCache  (void * o_data, size_t i_size, bytes_t * io_bytes, bytes_t i_end)
+{
+    if (i_size > (size_t) (i_end - * io_bytes))
+        return c_m3Err_cacheCorrupt;
+
+    memcpy (o_data, * io_bytes, i_size);
+    * io_bytes += i_size;
+
+    return m3Err_none;
+}
+
+
+static
+M3Result  ReadCacheFile  (u8 ** o_data, size_t * o_size, cstr_t i_path)
+{
+    M3Result result = m3Err_none;
+    u8 * data = NULL;
+    long size;
+
+    FILE * file = fopen (i_path, "rb");
+    _throwif ("no cached code", not file);
+
+    _throwif (c_m3Err_cacheCorrupt, fseek (file, 0, SEEK_END) != 0);
+    size = ftell (file);
+    _throwif (c_m3Err_cacheCorrupt, size < (long) (sizeof (M3CacheHeader) + sizeof (u64)));
+    rewind (file);
+
+    data = m3_Malloc ("M3CodeCache", size);
+    _throwifnull (data);
+
+    _throwif (c_m3Err_cacheCorrupt, fread (data, 1, size, file) != (size_t) size);
+
+    * o_data = data;
+    * o_size = size;
+    data = NULL;
+
+    _catch:
+
+    if (file)
+        fclose (file);
+
+    m3_Free (data);
+
+    return result;
+}
+
+
+M3Result  LoadCodeCache  (IM3Module io_module, cstr_t i_directory)
+{
+    M3Result result = m3Err_none;
+
+    IM3Runtime runtime = io_module->runtime;
+
+    u8 * data = NULL;
+    size_t size = 0;
+    IM3CodePage * pages = NULL;
+    M3CacheFunction * records = NULL;
+    void ** constants = NULL;
+    M3CacheHeader header = { 0 };
+
+    char path [1024];
+    u64 buildId, moduleHash;
+    bytes_t bytes, end;
+
+    const u8 * anchor = GetRelocationAnchor ();
+
+_   (GetCachePath (path, sizeof (path), io_module, i_directory, & buildId, & moduleHash));
+_   (ReadCacheFile (& data, & size, path));
+
+    bytes = data;
+    end = data + size - sizeof (u64);
+
+    {
+        u64 checksum;
+        memcpy (& checksum, end, sizeof (checksum));
+        _throwif (c_m3Err_cacheCorrupt, checksum != Hash (c_hashBasis, data, end - data));
+    }
+
+_   (ReadCache (& header, sizeof (header), & bytes, end));
+
+    _throwif (c_m3Err_cacheMismatch, header.magic != c_m3CacheMagic or header.version != c_m3CacheVersion or
+                                     header.buildId != buildId or header.moduleHash != moduleHash or
+                                     header.numFunctions != io_module->numFunctions or header.numGlobals != io_module->numGlobals or
+                                     header.numFuncTypes != io_module->numFuncTypes);
+
+    _throwif (c_m3Err_cacheCorrupt, not header.numPages or header.numPages > size or header.numCompiled > header.numFunctions);
+
+    pages = m3_AllocArray (IM3CodePage, header.numPages);
+    _throwifnull (pages);
+
+    for (u32 i = 0; i < header.numPages; ++i)
+    {
+        M3CachePage info;
+_       (ReadCache (& info, sizeof (info), & bytes, end));
+        _throwif (c_m3Err_cacheCorrupt, info.numLines > (size_t) (end - bytes) / sizeof (code_t));
+
+        pages [i] = NewCodePage (runtime, info.numLines);
+        _throwifnull (pages [i]);
+
+        IM3CodePage page = pages [i];
+_       (ReadCache (page->code, info.numLines * sizeof (code_t), & bytes, end));
+        page->info.lineIndex = info.numLines;
+
+#       if d_m3RecordBacktraces
+            _throwif (c_m3Err_cacheCorrupt, info.numMapEntries > page->info.mapping->capacity);
+_           (ReadCache (page->info.mapping->entries, info.numMapEntries * sizeof (M3CodeMapEntry), & bytes, end));
+            page->info.mapping->size = info.numMapEntries;
+#       else
+            _throwif (c_m3Err_cacheMismatch, info.numMapEntries);
+#       endif
+    }
+
+    for (u32 i = 0; i < header.numRelocations; ++i)
+    {
+        M3CacheRelocation relocation;
+_       (ReadCache (& relocation, sizeof (relocation), & bytes, end));
+
+        u32 numLines = (relocation.kind == c_m3Reloc_op) ? 1 : d_m3CodeLines (void *);
+        _throwif (c_m3Err_cacheCorrupt, relocation.page >= header.numPages or relocation.line + numLines > pages [relocation.page]->info.lineIndex);
+
+        code_t * line = & pages [relocation.page]->code [relocation.line];
+        const void ** site = (const void **) line;
+        u32 index = relocation.index;
+
+        switch (relocation.kind)
+        {
+            case c_m3Reloc_op:
+                * line = d_m3OperationWord (anchor + relocation.value);
+                break;
+
+            case c_m3Reloc_code:
+                _throwif (c_m3Err_cacheCorrupt, index >= header.numPages or relocation.value > pages [index]->info.lineIndex);
+                * site = & pages [index]->code [relocation.value];
+                break;
+
+            case c_m3Reloc_function:
+                _throwif (c_m3Err_cacheCorrupt, index >= io_module->numFunctions);
+                * site = & io_module->functions [index];
+                break;
+
+            case c_m3Reloc_functionEntry:
+                _throwif (c_m3Err_cacheCorrupt, index >= io_module->numFunctions);
+                // the callee (e.g. an import that isn't linked yet) must be compiled the way it was when cached
+                _throwif (c_m3Err_cacheMismatch, not io_module->functions [index].compiled);
+                * site = io_module->functions [index].compiled;
+                break;
+
+            case c_m3Reloc_global:
+                _throwif (c_m3Err_cacheCorrupt, index >= io_module->numGlobals or relocation.value >= sizeof (M3Global));
+                * site = (u8 *) & io_module->globals [index] + relocation.value;
+                break;
+
+            case c_m3Reloc_module:
+                * site = io_module;
+                break;
+
+            case c_m3Reloc_funcType:
+                _throwif (c_m3Err_cacheCorrupt, index >= io_module->numFuncTypes);
+                * site = io_module->funcTypes [index];
+                break;
+
+            default:
+                _throw (c_m3Err_cacheCorrupt);
+        }
+    }
+
+    // nothing is committed to the module until the whole image has been read
+    records = m3_AllocArray (M3CacheFunction, header.numCompiled + 1);
+    constants = m3_AllocArray (void *, header.numCompiled + 1);
+    _throwif (m3Err_mallocFailed, not records or not constants);
+
+    for (u32 i = 0; i < header.numCompiled; ++i)
+    {
+        M3CacheFunction * record = & records [i];
+_       (ReadCache (record, sizeof (M3CacheFunction), & bytes, end));
+
+        _throwif (c_m3Err_cacheCorrupt, record->index >= io_module->numFunctions or not io_module->functions [record->index].wasm or
+                                        record->page >= header.numPages or record->line >= pages [record->page]->info.lineIndex or
+                                        (u32) record->firstZeroedLocalByte + record->numZeroedLocalBytes > record->numLocalBytes);
+
+        if (record->numConstantBytes)
+        {
+            constants [i] = m3_Malloc ("M3FunctionConstants", record->numConstantBytes);
+            _throwifnull (constants [i]);
+_           (ReadCache (constants [i], record->numConstantBytes, & bytes, end));
+        }
+    }
+
+    for (u32 i = 0; i < header.numCompiled; ++i)
+    {
+        M3CacheFunction * record = & records [i];
+        IM3Function function = & io_module->functions [record->index];
+
+        // functions that have been compiled meanwhile keep their code
+        if (function->compiled)
+            continue;
+
+        function->compiled              = & pages [record->page]->code [record->line];
+        function->maxStackSlots         = record->maxStackSlots;
+        function->numRetSlots           = record->numRetSlots;
+        function->numRetAndArgSlots     = record->numRetAndArgSlots;
+        function->numLocalBytes         = record->numLocalBytes;
+        function->firstZeroedLocalByte  = record->firstZeroedLocalByte;
+        function->numZeroedLocalBytes   = record->numZeroedLocalBytes;
+        function->numConstantBytes      = record->numConstantBytes;
+        function->constants             = constants [i];
+
+        constants [i] = NULL;
+    }
+
+    for (u32 i = 0; i < header.numPages; ++i)
+    {
+        ReleaseCodePageNoTrack (runtime, pages [i]);
+        runtime->numCodePages++;
+        pages [i] = NULL;
+    }
+
+    _catch:
+
+    if (pages)
+    {
+        for (u32 i = 0; i < header.numPages; ++i)
+        {
+            IM3CodePage page = pages [i];
+            FreeCodePages (& page);
+        }
+    }
+
+    if (constants)
+    {
+        for (u32 i = 0; i < header.numCompiled; ++i)
+            m3_Free (constants [i]);
+    }
+
+    m3_Free (constants);
+    m3_Free (records);
+    m3_Free (pages);
+    m3_Free (data);
+
+    return result;
+}
@@ -0,0 +1,22 @@
+//
+//  m3_cache.h
+//
+//  On-disk cache of compiled modules
+//
+
+#ifndef m3_cache_h
+#define m3_cache_h
+
+#include "m3_env.h"
+
+d_m3BeginExternC
+
+// restores the module's functions from a cached image; fails if there's no (usable) image
+M3Result    LoadCodeCache               (IM3Module io_module, cstr_t i_directory);
+
+// i_pages must hold all of the code compiled for the module (and nothing else); i_relocations all of its address words
+M3Result    SaveCodeCache               (IM3Module i_module, cstr_t i_directory, IM3CodePage i_pages, M3CodeRelocations * i_relocations);
+
+d_m3EndExternC
+
+#endif // m3_cache_h
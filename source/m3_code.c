@@ -93,8 +93,9 @@ u32  NumFreeLines  (IM3CodePage i_page)
 
 
 void  EmitWord_impl  (IM3CodePage i_page, void * i_word)
-{                                                                       d_m3Assert (i_page->info.lineIndex+1 <= i_page->info.numLines);
-    i_page->code [i_page->info.lineIndex++] = i_word;
+{                                                                       d_m3Assert (i_page->info.lineIndex + d_m3CodeLines (void *) <= i_page->info.numLines);
+    memcpy (& i_page->code[i_page->info.lineIndex], & i_word, sizeof(i_word));
+    i_page->info.lineIndex += d_m3CodeLines (void *);
 }
 
 void  EmitWord32  (IM3CodePage i_page, const u32 i_word)
@@ -102,17 +103,11 @@ void  EmitWord32  (IM3CodePage i_page, const u32 i_word)
     memcpy (& i_page->code[i_page->info.lineIndex++], & i_word, sizeof(i_word));
 }
 
+// takes two lines on a 32-bit host or with d_m3CompactCode
 void  EmitWord64  (IM3CodePage i_page, const u64 i_word)
-{
-#if M3_SIZEOF_PTR == 4
-                                                                        d_m3Assert (i_page->info.lineIndex+2 <= i_page->info.numLines);
-    memcpy (& i_page->code[i_page->info.lineIndex], & i_word, sizeof(i_word));
-    i_page->info.lineIndex += 2;
-#else
-                                                                        d_m3Assert (i_page->info.lineIndex+1 <= i_page->info.numLines);
+{                                                                       d_m3Assert (i_page->info.lineIndex + d_m3CodeLines (u64) <= i_page->info.numLines);
     memcpy (& i_page->code[i_page->info.lineIndex], & i_word, sizeof(i_word));
-    i_page->info.lineIndex += 1;
-#endif
+    i_page->info.lineIndex += d_m3CodeLines (u64);
 }
 
 
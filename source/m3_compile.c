@@ -13,6 +13,7 @@
 #include "m3_exec.h"
 #include "m3_exception.h"
 #include "m3_info.h"
+#include "m3_jit.h"
 
 //----- EMIT --------------------------------------------------------------------------------------------------------------
 
@@ -22,12 +23,29 @@ pc_t GetPC (IM3Compilation o)
     return GetPagePC (o->page);
 }
 
+static inline
+void  EmitOperationWord  (IM3CodePage i_page, IM3Operation i_operation)
+{
+# if d_m3CompactCode
+    EmitWord32 (i_page, d_m3OperationWord (i_operation));
+# else
+    EmitWord (i_page, i_operation);
+# endif
+}
+
+static
+void  RecordRelocation  (IM3Compilation o, M3CodeSites * io_sites)
+{
+    if (AddCodeSite (io_sites, GetPC (o)))
+        o->relocations->incomplete = true;
+}
+
 static M3_NOINLINE
 M3Result  EnsureCodePageNumLines  (IM3Compilation o, u32 i_numLines)
 {
     M3Result result = m3Err_none;
 
-    i_numLines += 2; // room for Bridge
+    i_numLines += 1 + d_m3CodeLines (pc_t); // room for Bridge
 
     if (NumFreeLines (o->page) < i_numLines)
     {
@@ -36,10 +54,20 @@ M3Result  EnsureCodePageNumLines  (IM3Compilation o, u32 i_numLines)
         if (page)
         {
             m3log (emit, "bridging new code page from: %d %p (free slots: %d) to: %d", o->page->info.sequence, GetPC (o), NumFreeLines (o->page), page->info.sequence);
-            d_m3Assert (NumFreeLines (o->page) >= 2);
+            d_m3Assert (NumFreeLines (o->page) >= 1 + d_m3CodeLines (pc_t));
 
-            EmitWord (o->page, op_Branch);
-            EmitWord (o->page, GetPagePC (page));
+            if (o->relocations)
+            {
+                RecordRelocation (o, & o->relocations->ops);
+                EmitOperationWord (o->page, op_Branch);
+                RecordRelocation (o, & o->relocations->pointers);
+                EmitWord (o->page, GetPagePC (page));
+            }
+            else
+            {
+                EmitOperationWord (o->page, op_Branch);
+                EmitWord (o->page, GetPagePC (page));
+            }
 
             ReleaseCodePage (o->runtime, o->page);
 
@@ -72,7 +100,10 @@ M3Result  EmitOp  (IM3Compilation o, IM3Operation i_operation)
 # if d_m3RecordBacktraces
             EmitMappingEntry (o->page, o->lastOpcodeStart - o->module->wasmStart);
 # endif // d_m3RecordBacktraces
-            EmitWord (o->page, i_operation);
+            if (o->relocations)
+                RecordRelocation (o, & o->relocations->ops);
+
+            EmitOperationWord (o->page, i_operation);
         }
     }
 
@@ -100,7 +131,12 @@ pc_t  EmitPointer  (IM3Compilation o, const void * const i_pointer)
     pc_t ptr = GetPagePC (o->page);
 
     if (o->page)
+    {
+        if (o->relocations)
+            RecordRelocation (o, & o->relocations->pointers);
+
         EmitWord (o->page, i_pointer);
+    }
 
     return ptr;
 }
@@ -113,6 +149,22 @@ void * ReservePointer (IM3Compilation o)
     return (void *) ptr;
 }
 
+// an empty M3CallCache. it holds no address until the code runs, so the code cache saves it as it is
+static M3_NOINLINE
+void  EmitCallCache  (IM3Compilation o)
+{
+    if (o->page)
+    {
+        M3CallCache cache = { 0, c_m3CallCacheEmpty, NULL };
+        pc_t site = GetPagePC (o->page);
+
+        for (u32 i = 0; i < d_m3CodeLines (M3CallCache); ++i)
+            EmitWord32 (o->page, 0);
+
+        memcpy ((void *) site, & cache, sizeof (cache));
+    }
+}
+
 
 //-------------------------------------------------------------------------------------------------------------------------
 
@@ -124,6 +176,7 @@ void * ReservePointer (IM3Compilation o)
 #define f_32    c_m3Type_f32
 #define f_64    c_m3Type_f64
 #define none    c_m3Type_none
+#define v_128   c_m3Type_v128
 #define any     (u8)-1
 
 #if d_m3HasFloat
@@ -138,6 +191,8 @@ static const IM3Operation c_setSetOps [] =       { NULL, op_SetSlot_i32,
                                                     FPOP(op_SetSlot_f32),         FPOP(op_SetSlot_f64) };
 static const IM3Operation c_setGlobalOps [] =    { NULL, op_SetGlobal_i32,             op_SetGlobal_i64,
                                                     FPOP(op_SetGlobal_f32),       FPOP(op_SetGlobal_f64) };
+static const IM3Operation c_setInstanceGlobalOps [] =  { NULL, op_SetInstanceGlobal_i32,     op_SetInstanceGlobal_i64,
+                                                    FPOP(op_SetInstanceGlobal_f32), FPOP(op_SetInstanceGlobal_f64) };
 static const IM3Operation c_setRegisterOps [] =  { NULL, op_SetRegister_i32,           op_SetRegister_i64,
                                                     FPOP(op_SetRegister_f32),     FPOP(op_SetRegister_f64) };
 
@@ -150,9 +205,265 @@ static const IM3Operation c_fpSelectOps [2] [2] [3] = { { { op_Select_f32_sss, o
                                                           { op_Select_f64_rss, op_Select_f64_rrs, op_Select_f64_rsr } } };    // selector in reg
 #endif
 
+// kinds of conditional branch that can absorb the comparison before them; see FuseConditionalBranch
+enum { c_fusedBranchIf, c_fusedIf, c_fusedContinueLoopIf };
+
+#if d_m3FuseOperations
+// superinstructions that also store the result to a slot, so that a local.set/tee, a register spill or a block result
+// copy that follows the operation needn't be dispatched on its own (see TargetResultToSlot). picked from the most
+// frequent producers across the test/wasi corpus; add an entry here (and the op in m3_exec.h) to grow the set.
+typedef struct M3FusedOp
+{
+    IM3Operation        op;
+    IM3Operation        fused;
+}
+M3FusedOp;
+
+#define d_fuse(OP)              { op_##OP, op_##OP##_SetSlot }
+#define d_fuseCommutative(OP)   d_fuse (OP##_rs), d_fuse (OP##_ss)
+#define d_fuseBinary(OP)        d_fuseCommutative (OP), d_fuse (OP##_sr)
+#define d_fuseLoad(OP)          d_fuse (OP##_r), d_fuse (OP##_s)
+#define d_fuseSelect(TYPE)      d_fuse (Select_##TYPE##_rss), d_fuse (Select_##TYPE##_srs), \
+                                d_fuse (Select_##TYPE##_ssr), d_fuse (Select_##TYPE##_sss)
+
+static const M3FusedOp c_setSlotFusions [] =
+{
+    d_fuseCommutative (i32_Add),        d_fuseCommutative (i64_Add),
+    d_fuseBinary (i32_Subtract),        d_fuseBinary (i64_Subtract),
+    d_fuseCommutative (i32_Multiply),   d_fuseCommutative (i64_Multiply),
+    d_fuseCommutative (u32_And),        d_fuseCommutative (u64_And),
+    d_fuseCommutative (u32_Or),         d_fuseCommutative (u64_Or),
+    d_fuseCommutative (u32_Xor),        d_fuseCommutative (u64_Xor),
+    d_fuseBinary (u32_ShiftLeft),       d_fuseBinary (u64_ShiftLeft),
+    d_fuseBinary (i32_ShiftRight),      d_fuseBinary (i64_ShiftRight),
+    d_fuseBinary (u32_ShiftRight),      d_fuseBinary (u64_ShiftRight),
+
+    d_fuseLoad (i32_Load_i32),          d_fuseLoad (i64_Load_i64),
+    d_fuseLoad (i32_Load_i8),           d_fuseLoad (i32_Load_u8),
+    d_fuseLoad (i32_Load_i16),          d_fuseLoad (i32_Load_u16),
+
+    d_fuseSelect (i32),                 d_fuseSelect (i64),
+# if d_m3HasFloat
+    d_fuseCommutative (f32_Add),        d_fuseCommutative (f64_Add),
+    d_fuseBinary (f32_Subtract),        d_fuseBinary (f64_Subtract),
+    d_fuseCommutative (f32_Multiply),   d_fuseCommutative (f64_Multiply),
+
+    d_fuseLoad (f64_Load_f64),
+# endif
+};
+
+// compare-and-branch superinstructions. the comparison result is only ever needed by the branch that follows it
+typedef struct M3FusedBranch
+{
+    IM3Operation        op;
+    IM3Operation        branches        [3];    // indexed by the enum above
+}
+M3FusedBranch;
+
+#define d_fuseBranch(OP)                { op_##OP, { op_BranchIf_##OP, op_If_##OP, op_ContinueLoopIf_##OP } }
+#define d_fuseCommutativeCompare(OP)    d_fuseBranch (OP##_rs), d_fuseBranch (OP##_ss)
+#define d_fuseCompare(OP)               d_fuseCommutativeCompare (OP), d_fuseBranch (OP##_sr)
+#define d_fuseTest(OP)                  d_fuseBranch (OP##_r), d_fuseBranch (OP##_s)
+
+static const M3FusedBranch c_branchFusions [] =
+{
+    d_fuseTest (i32_EqualToZero),                   d_fuseTest (i64_EqualToZero),
+
+    d_fuseCommutativeCompare (i32_Equal),           d_fuseCommutativeCompare (i64_Equal),
+    d_fuseCommutativeCompare (i32_NotEqual),        d_fuseCommutativeCompare (i64_NotEqual),
+
+    d_fuseCompare (i32_LessThan),                   d_fuseCompare (i64_LessThan),
+    d_fuseCompare (i32_GreaterThan),                d_fuseCompare (i64_GreaterThan),
+    d_fuseCompare (i32_LessThanOrEqual),            d_fuseCompare (i64_LessThanOrEqual),
+    d_fuseCompare (i32_GreaterThanOrEqual),         d_fuseCompare (i64_GreaterThanOrEqual),
+
+    d_fuseCompare (u32_LessThan),                   d_fuseCompare (u64_LessThan),
+    d_fuseCompare (u32_GreaterThan),                d_fuseCompare (u64_GreaterThan),
+    d_fuseCompare (u32_LessThanOrEqual),            d_fuseCompare (u64_LessThanOrEqual),
+    d_fuseCompare (u32_GreaterThanOrEqual),         d_fuseCompare (u64_GreaterThanOrEqual),
+# if d_m3HasFloat
+    d_fuseCommutativeCompare (f32_Equal),           d_fuseCommutativeCompare (f64_Equal),
+    d_fuseCommutativeCompare (f32_NotEqual),        d_fuseCommutativeCompare (f64_NotEqual),
+    d_fuseCompare (f32_LessThan),                   d_fuseCompare (f64_LessThan),
+    d_fuseCompare (f32_GreaterThan),                d_fuseCompare (f64_GreaterThan),
+    d_fuseCompare (f32_LessThanOrEqual),            d_fuseCompare (f64_LessThanOrEqual),
+    d_fuseCompare (f32_GreaterThanOrEqual),         d_fuseCompare (f64_GreaterThanOrEqual),
+# endif
+};
+#endif // d_m3FuseOperations
+
+#if d_m3HasJit
+// the operations m3_jit.c has a native template for. the others run in the interpreter, so an op only needs an
+// entry here once it's frequent enough to matter
+#define d_jit(OP, KIND, FORM, TYPE, ARG)        { op_##OP, c_m3Jit##KIND, c_m3JitForm_##FORM, c_m3Type_##TYPE, ARG }
+
+#define d_jitCommutative(OP, TYPE, ARG)         d_jit (OP##_rs, Alu, rs, TYPE, ARG), d_jit (OP##_ss, Alu, ss, TYPE, ARG)
+#define d_jitBinary(OP, TYPE, ARG)              d_jitCommutative (OP, TYPE, ARG), d_jit (OP##_sr, Alu, sr, TYPE, ARG)
+#define d_jitUnary(OP, TYPE, ARG)               d_jit (OP##_r, Alu, r, TYPE, ARG), d_jit (OP##_s, Alu, s, TYPE, ARG)
+
+#define d_jitCommutativeSet(OP, TYPE, ARG)      d_jit (OP##_rs_SetSlot, AluSetSlot, rs, TYPE, ARG), d_jit (OP##_ss_SetSlot, AluSetSlot, ss, TYPE, ARG)
+#define d_jitBinarySet(OP, TYPE, ARG)           d_jitCommutativeSet (OP, TYPE, ARG), d_jit (OP##_sr_SetSlot, AluSetSlot, sr, TYPE, ARG)
+
+#define d_jitBranchForm(OP, FORM, TYPE, ARG)    d_jit (BranchIf_##OP##_##FORM, BranchIf, FORM, TYPE, ARG), \
+                                                d_jit (If_##OP##_##FORM, If, FORM, TYPE, ARG),             \
+                                                d_jit (ContinueLoopIf_##OP##_##FORM, ContinueLoopIf, FORM, TYPE, ARG)
+#define d_jitTestBranch(OP, TYPE, ARG)          d_jitBranchForm (OP, r, TYPE, ARG), d_jitBranchForm (OP, s, TYPE, ARG)
+#define d_jitCommutativeBranch(OP, TYPE, ARG)   d_jitBranchForm (OP, rs, TYPE, ARG), d_jitBranchForm (OP, ss, TYPE, ARG)
+#define d_jitCompareBranch(OP, TYPE, ARG)       d_jitCommutativeBranch (OP, TYPE, ARG), d_jitBranchForm (OP, sr, TYPE, ARG)
+
+#define d_jitLoad(TYPE, FROM, ACCESS)           d_jit (TYPE##_Load_##FROM##_r, Load, r, TYPE, ACCESS), d_jit (TYPE##_Load_##FROM##_s, Load, s, TYPE, ACCESS)
+#define d_jitLoadSet(TYPE, FROM, ACCESS)        d_jit (TYPE##_Load_##FROM##_r_SetSlot, LoadSetSlot, r, TYPE, ACCESS), \
+                                                d_jit (TYPE##_Load_##FROM##_s_SetSlot, LoadSetSlot, s, TYPE, ACCESS)
+#define d_jitStore(TYPE, TO, ACCESS)            d_jit (TYPE##_Store_##TO##_rs, Store, rs, TYPE, ACCESS), d_jit (TYPE##_Store_##TO##_sr, Store, sr, TYPE, ACCESS), \
+                                                d_jit (TYPE##_Store_##TO##_ss, Store, ss, TYPE, ACCESS)
+
+#define d_jitMoves(TYPE)                        d_jit (SetRegister_##TYPE, SetRegister, s, TYPE, 0), d_jit (SetSlot_##TYPE, SetSlot, r, TYPE, 0), \
+                                                d_jit (PreserveSetSlot_##TYPE, PreserveSetSlot, r, TYPE, 0)
+#define d_jitSelect(TYPE)                       d_jit (Select_##TYPE##_rss, Select, rss, TYPE, 0), d_jit (Select_##TYPE##_srs, Select, srs, TYPE, 0), \
+                                                d_jit (Select_##TYPE##_ssr, Select, ssr, TYPE, 0), d_jit (Select_##TYPE##_sss, Select, sss, TYPE, 0)
+#define d_jitSelectSet(TYPE)                    d_jit (Select_##TYPE##_rss_SetSlot, SelectSetSlot, rss, TYPE, 0), d_jit (Select_##TYPE##_srs_SetSlot, SelectSetSlot, srs, TYPE, 0), \
+                                                d_jit (Select_##TYPE##_ssr_SetSlot, SelectSetSlot, ssr, TYPE, 0), d_jit (Select_##TYPE##_sss_SetSlot, SelectSetSlot, sss, TYPE, 0)
+
+static const M3JitOp c_jitOps [] =
+{
+    d_jitCommutative (i32_Add, i32, c_m3JitOp_Add),             d_jitCommutative (i64_Add, i64, c_m3JitOp_Add),
+    d_jitBinary (i32_Subtract, i32, c_m3JitOp_Sub),             d_jitBinary (i64_Subtract, i64, c_m3JitOp_Sub),
+    d_jitCommutative (i32_Multiply, i32, c_m3JitOp_Mul),        d_jitCommutative (i64_Multiply, i64, c_m3JitOp_Mul),
+    d_jitCommutative (u32_And, i32, c_m3JitOp_And),             d_jitCommutative (u64_And, i64, c_m3JitOp_And),
+    d_jitCommutative (u32_Or, i32, c_m3JitOp_Or),               d_jitCommutative (u64_Or, i64, c_m3JitOp_Or),
+    d_jitCommutative (u32_Xor, i32, c_m3JitOp_Xor),             d_jitCommutative (u64_Xor, i64, c_m3JitOp_Xor),
+    d_jitBinary (u32_ShiftLeft, i32, c_m3JitOp_Shl),            d_jitBinary (u64_ShiftLeft, i64, c_m3JitOp_Shl),
+    d_jitBinary (i32_ShiftRight, i32, c_m3JitOp_ShrS),          d_jitBinary (i64_ShiftRight, i64, c_m3JitOp_ShrS),
+    d_jitBinary (u32_ShiftRight, i32, c_m3JitOp_ShrU),          d_jitBinary (u64_ShiftRight, i64, c_m3JitOp_ShrU),
+    d_jitBinary (u32_Rotl, i32, c_m3JitOp_Rotl),                d_jitBinary (u64_Rotl, i64, c_m3JitOp_Rotl),
+    d_jitBinary (u32_Rotr, i32, c_m3JitOp_Rotr),                d_jitBinary (u64_Rotr, i64, c_m3JitOp_Rotr),
+    d_jitBinary (i32_Divide, i32, c_m3JitOp_DivS),              d_jitBinary (i64_Divide, i64, c_m3JitOp_DivS),
+    d_jitBinary (u32_Divide, i32, c_m3JitOp_DivU),              d_jitBinary (u64_Divide, i64, c_m3JitOp_DivU),
+    d_jitBinary (i32_Remainder, i32, c_m3JitOp_RemS),           d_jitBinary (i64_Remainder, i64, c_m3JitOp_RemS),
+    d_jitBinary (u32_Remainder, i32, c_m3JitOp_RemU),           d_jitBinary (u64_Remainder, i64, c_m3JitOp_RemU),
+
+    d_jit (i32_DivideConstant_r, DivideByConstant, r, i32, c_m3JitOp_DivS),     d_jit (i32_DivideConstant_s, DivideByConstant, s, i32, c_m3JitOp_DivS),
+    d_jit (i64_DivideConstant_r, DivideByConstant, r, i64, c_m3JitOp_DivS),     d_jit (i64_DivideConstant_s, DivideByConstant, s, i64, c_m3JitOp_DivS),
+    d_jit (i32_RemainderConstant_r, DivideByConstant, r, i32, c_m3JitOp_RemS),  d_jit (i32_RemainderConstant_s, DivideByConstant, s, i32, c_m3JitOp_RemS),
+    d_jit (i64_RemainderConstant_r, DivideByConstant, r, i64, c_m3JitOp_RemS),  d_jit (i64_RemainderConstant_s, DivideByConstant, s, i64, c_m3JitOp_RemS),
+
+    d_jitCommutative (i32_Equal, i32, c_m3JitOp_Eq),            d_jitCommutative (i64_Equal, i64, c_m3JitOp_Eq),
+    d_jitCommutative (i32_NotEqual, i32, c_m3JitOp_Ne),         d_jitCommutative (i64_NotEqual, i64, c_m3JitOp_Ne),
+    d_jitBinary (i32_LessThan, i32, c_m3JitOp_LtS),             d_jitBinary (i64_LessThan, i64, c_m3JitOp_LtS),
+    d_jitBinary (u32_LessThan, i32, c_m3JitOp_LtU),             d_jitBinary (u64_LessThan, i64, c_m3JitOp_LtU),
+    d_jitBinary (i32_GreaterThan, i32, c_m3JitOp_GtS),          d_jitBinary (i64_GreaterThan, i64, c_m3JitOp_GtS),
+    d_jitBinary (u32_GreaterThan, i32, c_m3JitOp_GtU),          d_jitBinary (u64_GreaterThan, i64, c_m3JitOp_GtU),
+    d_jitBinary (i32_LessThanOrEqual, i32, c_m3JitOp_LeS),      d_jitBinary (i64_LessThanOrEqual, i64, c_m3JitOp_LeS),
+    d_jitBinary (u32_LessThanOrEqual, i32, c_m3JitOp_LeU),      d_jitBinary (u64_LessThanOrEqual, i64, c_m3JitOp_LeU),
+    d_jitBinary (i32_GreaterThanOrEqual, i32, c_m3JitOp_GeS),   d_jitBinary (i64_GreaterThanOrEqual, i64, c_m3JitOp_GeS),
+    d_jitBinary (u32_GreaterThanOrEqual, i32, c_m3JitOp_GeU),   d_jitBinary (u64_GreaterThanOrEqual, i64, c_m3JitOp_GeU),
+
+    d_jitUnary (i32_EqualToZero, i32, c_m3JitOp_Eqz),           d_jitUnary (i64_EqualToZero, i64, c_m3JitOp_Eqz),
+    d_jitUnary (i32_Extend8_s, i32, c_m3JitOp_Extend8),         d_jitUnary (i64_Extend8_s, i64, c_m3JitOp_Extend8),
+    d_jitUnary (i32_Extend16_s, i32, c_m3JitOp_Extend16),       d_jitUnary (i64_Extend16_s, i64, c_m3JitOp_Extend16),
+    d_jitUnary (i64_Extend32_s, i64, c_m3JitOp_Extend32),
+    d_jitUnary (i64_Extend_i32, i32, c_m3JitOp_Extend32),       d_jitUnary (i64_Extend_u32, i32, c_m3JitOp_ExtendU32),
+    d_jitUnary (i32_Wrap_i64, i64, c_m3JitOp_Wrap),
+
+    d_jitCommutative (f32_Add, f32, c_m3JitOp_Add),             d_jitCommutative (f64_Add, f64, c_m3JitOp_Add),
+    d_jitBinary (f32_Subtract, f32, c_m3JitOp_Sub),             d_jitBinary (f64_Subtract, f64, c_m3JitOp_Sub),
+    d_jitCommutative (f32_Multiply, f32, c_m3JitOp_Mul),        d_jitCommutative (f64_Multiply, f64, c_m3JitOp_Mul),
+    d_jitBinary (f32_Divide, f32, c_m3JitOp_Div),               d_jitBinary (f64_Divide, f64, c_m3JitOp_Div),
+
+# if d_m3FuseOperations
+    d_jitCommutativeSet (i32_Add, i32, c_m3JitOp_Add),          d_jitCommutativeSet (i64_Add, i64, c_m3JitOp_Add),
+    d_jitBinarySet (i32_Subtract, i32, c_m3JitOp_Sub),          d_jitBinarySet (i64_Subtract, i64, c_m3JitOp_Sub),
+    d_jitCommutativeSet (i32_Multiply, i32, c_m3JitOp_Mul),     d_jitCommutativeSet (i64_Multiply, i64, c_m3JitOp_Mul),
+    d_jitCommutativeSet (u32_And, i32, c_m3JitOp_And),          d_jitCommutativeSet (u64_And, i64, c_m3JitOp_And),
+    d_jitCommutativeSet (u32_Or, i32, c_m3JitOp_Or),            d_jitCommutativeSet (u64_Or, i64, c_m3JitOp_Or),
+    d_jitCommutativeSet (u32_Xor, i32, c_m3JitOp_Xor),          d_jitCommutativeSet (u64_Xor, i64, c_m3JitOp_Xor),
+    d_jitBinarySet (u32_ShiftLeft, i32, c_m3JitOp_Shl),         d_jitBinarySet (u64_ShiftLeft, i64, c_m3JitOp_Shl),
+    d_jitBinarySet (i32_ShiftRight, i32, c_m3JitOp_ShrS),       d_jitBinarySet (i64_ShiftRight, i64, c_m3JitOp_ShrS),
+    d_jitBinarySet (u32_ShiftRight, i32, c_m3JitOp_ShrU),       d_jitBinarySet (u64_ShiftRight, i64, c_m3JitOp_ShrU),
+    d_jitCommutativeSet (f32_Add, f32, c_m3JitOp_Add),          d_jitCommutativeSet (f64_Add, f64, c_m3JitOp_Add),
+    d_jitBinarySet (f32_Subtract, f32, c_m3JitOp_Sub),          d_jitBinarySet (f64_Subtract, f64, c_m3JitOp_Sub),
+    d_jitCommutativeSet (f32_Multiply, f32, c_m3JitOp_Mul),     d_jitCommutativeSet (f64_Multiply, f64, c_m3JitOp_Mul),
+
+    d_jitTestBranch (i32_EqualToZero, i32, c_m3JitOp_Eqz),              d_jitTestBranch (i64_EqualToZero, i64, c_m3JitOp_Eqz),
+    d_jitCommutativeBranch (i32_Equal, i32, c_m3JitOp_Eq),              d_jitCommutativeBranch (i64_Equal, i64, c_m3JitOp_Eq),
+    d_jitCommutativeBranch (i32_NotEqual, i32, c_m3JitOp_Ne),           d_jitCommutativeBranch (i64_NotEqual, i64, c_m3JitOp_Ne),
+    d_jitCompareBranch (i32_LessThan, i32, c_m3JitOp_LtS),              d_jitCompareBranch (i64_LessThan, i64, c_m3JitOp_LtS),
+    d_jitCompareBranch (u32_LessThan, i32, c_m3JitOp_LtU),              d_jitCompareBranch (u64_LessThan, i64, c_m3JitOp_LtU),
+    d_jitCompareBranch (i32_GreaterThan, i32, c_m3JitOp_GtS),           d_jitCompareBranch (i64_GreaterThan, i64, c_m3JitOp_GtS),
+    d_jitCompareBranch (u32_GreaterThan, i32, c_m3JitOp_GtU),           d_jitCompareBranch (u64_GreaterThan, i64, c_m3JitOp_GtU),
+    d_jitCompareBranch (i32_LessThanOrEqual, i32, c_m3JitOp_LeS),       d_jitCompareBranch (i64_LessThanOrEqual, i64, c_m3JitOp_LeS),
+    d_jitCompareBranch (u32_LessThanOrEqual, i32, c_m3JitOp_LeU),       d_jitCompareBranch (u64_LessThanOrEqual, i64, c_m3JitOp_LeU),
+    d_jitCompareBranch (i32_GreaterThanOrEqual, i32, c_m3JitOp_GeS),    d_jitCompareBranch (i64_GreaterThanOrEqual, i64, c_m3JitOp_GeS),
+    d_jitCompareBranch (u32_GreaterThanOrEqual, i32, c_m3JitOp_GeU),    d_jitCompareBranch (u64_GreaterThanOrEqual, i64, c_m3JitOp_GeU),
+
+    d_jitLoadSet (i32, i8, c_m3JitAccess_i8),   d_jitLoadSet (i32, u8, c_m3JitAccess_u8),
+    d_jitLoadSet (i32, i16, c_m3JitAccess_i16), d_jitLoadSet (i32, u16, c_m3JitAccess_u16),
+    d_jitLoadSet (i32, i32, c_m3JitAccess_i32),
+    d_jitLoadSet (i64, i64, c_m3JitAccess_64),  d_jitLoadSet (f64, f64, c_m3JitAccess_f64),
+
+    d_jitSelectSet (i32),   d_jitSelectSet (i64),
+# endif
+
+    d_jitLoad (i32, i8, c_m3JitAccess_i8),      d_jitLoad (i64, i8, c_m3JitAccess_i8),
+    d_jitLoad (i32, u8, c_m3JitAccess_u8),      d_jitLoad (i64, u8, c_m3JitAccess_u8),
+    d_jitLoad (i32, i16, c_m3JitAccess_i16),    d_jitLoad (i64, i16, c_m3JitAccess_i16),
+    d_jitLoad (i32, u16, c_m3JitAccess_u16),    d_jitLoad (i64, u16, c_m3JitAccess_u16),
+    d_jitLoad (i32, i32, c_m3JitAccess_i32),    d_jitLoad (i64, i32, c_m3JitAccess_i32),
+                                                d_jitLoad (i64, u32, c_m3JitAccess_u32),
+                                                d_jitLoad (i64, i64, c_m3JitAccess_64),
+    d_jitLoad (f32, f32, c_m3JitAccess_f32),    d_jitLoad (f64, f64, c_m3JitAccess_f64),
+
+    d_jitStore (i32, u8, c_m3JitAccess_u8),     d_jitStore (i64, u8, c_m3JitAccess_u8),
+    d_jitStore (i32, i16, c_m3JitAccess_u16),   d_jitStore (i64, i16, c_m3JitAccess_u16),
+    d_jitStore (i32, i32, c_m3JitAccess_u32),   d_jitStore (i64, i32, c_m3JitAccess_u32),
+                                                d_jitStore (i64, i64, c_m3JitAccess_64),
+    d_jitStore (f32, f32, c_m3JitAccess_f32),   d_jit (f32_Store_f32_rr, Store, rr, f32, c_m3JitAccess_f32),
+    d_jitStore (f64, f64, c_m3JitAccess_f64),   d_jit (f64_Store_f64_rr, Store, rr, f64, c_m3JitAccess_f64),
+
+    d_jitMoves (i32),   d_jitMoves (i64),   d_jitMoves (f32),   d_jitMoves (f64),
+    d_jit (CopySlot_32, CopySlot, none, i32, 0),                d_jit (CopySlot_64, CopySlot, none, i64, 0),
+    d_jit (PreserveCopySlot_32, PreserveCopySlot, none, i32, 0),d_jit (PreserveCopySlot_64, PreserveCopySlot, none, i64, 0),
+    d_jit (Const32, Const, none, i32, 0),                       d_jit (Const64, Const, none, i64, 0),
+    d_jitSelect (i32),  d_jitSelect (i64),
+
+    d_jit (GetGlobal_s32, GetGlobal, none, i32, 0),             d_jit (GetGlobal_s64, GetGlobal, none, i64, 0),
+    d_jit (SetGlobal_i32, SetGlobal, r, i32, 0),                d_jit (SetGlobal_i64, SetGlobal, r, i64, 0),
+    d_jit (SetGlobal_s32, SetGlobal, s, i32, 0),                d_jit (SetGlobal_s64, SetGlobal, s, i64, 0),
+    d_jit (SetGlobal_f32, SetGlobal, r, f32, 0),                d_jit (SetGlobal_f64, SetGlobal, r, f64, 0),
+
+    d_jit (BranchIf_r, BranchIf, r, i32, c_m3JitOp_NonZero),    d_jit (BranchIf_s, BranchIf, s, i32, c_m3JitOp_NonZero),
+    d_jit (If_r, If, r, i32, c_m3JitOp_NonZero),                d_jit (If_s, If, s, i32, c_m3JitOp_NonZero),
+    d_jit (BranchIfPrologue_r, If, r, i32, c_m3JitOp_NonZero),  d_jit (BranchIfPrologue_s, If, s, i32, c_m3JitOp_NonZero),
+    d_jit (ContinueLoopIf, ContinueLoopIf, r, i32, c_m3JitOp_NonZero),
+
+    d_jit (Branch, Branch, none, none, 0),                      d_jit (BranchTable, BranchTable, none, none, 0),
+    d_jit (Loop, Loop, none, none, 0),                          d_jit (ContinueLoop, ContinueLoop, none, none, 0),
+    d_jit (Return, Return, none, none, 0),                      d_jit (End, Return, none, none, 0),
+    d_jit (UseGas, UseGas, none, none, 0),                      d_jit (MemSize, MemSize, none, none, 0),
+    d_jit (Call, Call, none, none, 0),                          d_jit (Compile, Compile, none, none, 0),
+    d_jit (CallIndirect, CallIndirect, none, none, 0),
+};
+
+const M3JitOps c_m3JitOps = { op_Entry, op_JitEntry, op_Call, op_CountHotness, op_JitLoop, c_jitOps, M3_COUNT_OF (c_jitOps) };
+#endif // d_m3HasJit
+
 // all args & returns are 64-bit aligned, so use 2 slots for a d_m3Use32BitSlots=1 build
 static const u16 c_ioSlotCount = sizeof (u64) / sizeof (m3slot_t);
 
+// ...and a v128 arg or return takes two of those 64-bit words
+static inline
+u16  GetTypeNumIOSlots  (u8 i_type)
+{
+    return IsVectorType (i_type) ? 2 * c_ioSlotCount : c_ioSlotCount;
+}
+
+// picks the 32, 64 or 128-bit flavor of a slot operation (CopySlot_32, GetGlobal_s64...)
+#if d_m3HasSIMD
+#   define d_slotTypeOp(TYPE, NAME)     (IsVectorType (TYPE) ? op_##NAME##128 : Is64BitType (TYPE) ? op_##NAME##64 : op_##NAME##32)
+#else
+#   define d_slotTypeOp(TYPE, NAME)     (Is64BitType (TYPE) ? op_##NAME##64 : op_##NAME##32)
+#endif
+
 static
 M3Result  AcquireCompilationCodePage  (IM3Compilation o, IM3CodePage * o_codePage)
 {
@@ -194,6 +505,11 @@ void  ReleaseCompilationCodePage  (IM3Compilation o)
 static inline
 u16 GetTypeNumSlots (u8 i_type)
 {
+#   if d_m3HasSIMD
+        if (IsVectorType (i_type))
+            return 16 / sizeof (m3slot_t);
+#   endif
+
 #   if d_m3Use32BitSlots
         return Is64BitType (i_type) ? 2 : 1;
 #   else
@@ -204,7 +520,7 @@ u16 GetTypeNumSlots (u8 i_type)
 static inline
 void  AlignSlotToType  (u16 * io_slot, u8 i_type)
 {
-    // align 64-bit words to even slots (if d_m3Use32BitSlots)
+    // align 64-bit words to even slots (if d_m3Use32BitSlots) and v128s to their size
     u16 numSlots = GetTypeNumSlots (i_type);
 
     u16 mask = numSlots - 1;
@@ -361,11 +677,15 @@ M3Result  AllocateSlotsWithinRange  (IM3Compilation o, u16 * o_slot, u8 i_type,
 
     AlignSlotToType (& i_startSlot, i_type);
 
-    // search for 1 or 2 consecutive slots in the execution stack
+    // search for 1, 2 or 4 consecutive slots in the execution stack
     u16 i = i_startSlot;
     while (i + searchOffset < i_endSlot)
     {
-        if (o->m3Slots [i] == 0 and o->m3Slots [i + searchOffset] == 0)
+        u16 numFree = 0;
+        while (numFree < numSlots and o->m3Slots [i + numFree] == 0)
+            ++numFree;
+
+        if (numFree == numSlots)
         {
             MarkSlotsAllocated (o, i, numSlots);
 
@@ -374,7 +694,7 @@ M3Result  AllocateSlotsWithinRange  (IM3Compilation o, u16 * o_slot, u8 i_type,
             break;
         }
 
-        // keep 2-slot allocations even-aligned
+        // keep multi-slot allocations aligned
         i += numSlots;
     }
 
@@ -470,6 +790,44 @@ u16  GetMaxUsedSlotPlusOne  (IM3Compilation o)
     return o->slotMaxAllocatedIndexPlusOne;
 }
 
+// the result of the last emitted operation is still the register stack top. if nothing has been emitted since, a
+// superinstruction can take its place, storing to a slot as well.
+static
+void  NoteFusionCandidate  (IM3Compilation o, pc_t i_operationPC)
+{
+    o->fusionPC = i_operationPC;
+    o->fusionEndPC = GetPC (o);
+    o->fusionStackIndex = o->stackIndex;
+}
+
+// result targeting: when the register value at i_stackIndex is what the last emitted operation produced, it writes
+// the value to i_slot itself rather than leaving it to a following op_SetSlot. values pushed since (local.get,
+// constants) emit nothing, so this also catches a result that's spilled to make room for the next one.
+static
+bool  TargetResultToSlot  (IM3Compilation o, u16 i_stackIndex, u16 i_slot)
+{
+# if d_m3FuseOperations
+    if (o->fusionPC and o->fusionEndPC == GetPC (o) and o->fusionStackIndex == i_stackIndex + 1 and IsStackIndexInRegister (o, i_stackIndex))
+    {
+        code_t * operation = (code_t *) o->fusionPC;
+
+        for (u32 i = 0; i < M3_COUNT_OF (c_setSlotFusions); ++i)
+        {
+            if (* operation == d_m3OperationWord (c_setSlotFusions [i].op))
+            {                                                   m3log (compile, d_indent " (targeted slot: %d)", get_indention_string (o), i_slot);
+                * operation = d_m3OperationWord (c_setSlotFusions [i].fused);
+                EmitSlotOffset (o, i_slot);
+
+                NoteFusionCandidate (o, NULL);
+                return true;
+            }
+        }
+    }
+# endif
+
+    return false;
+}
+
 static
 M3Result  PreserveRegisterIfOccupied  (IM3Compilation o, u8 i_registerType)
 {
@@ -480,17 +838,20 @@ M3Result  PreserveRegisterIfOccupied  (IM3Compilation o, u8 i_registerType)
     if (IsRegisterAllocated (o, regSelect))
     {
         u16 stackIndex = GetRegisterStackIndex (o, regSelect);
-        DeallocateRegister (o, regSelect);
-
         u8 type = GetStackTypeFromBottom (o, stackIndex);
 
         // and point to a exec slot
         u16 slot = c_slotUnused;
 _       (AllocateSlots (o, & slot, type));
-        o->wasmStack [stackIndex] = slot;
 
-_       (EmitOp (o, c_setSetOps [type]));
-        EmitSlotOffset (o, slot);
+        if (not TargetResultToSlot (o, stackIndex, slot))
+        {
+_           (EmitOp (o, c_setSetOps [type]));
+            EmitSlotOffset (o, slot);
+        }
+
+        DeallocateRegister (o, regSelect);
+        o->wasmStack [stackIndex] = slot;
     }
 
     _catch: return result;
@@ -818,6 +1179,8 @@ void  PatchBranches  (IM3Compilation o)
     pc_t patches = o->block.patches;
     o->block.patches = NULL;
 
+    o->fusionPC = NULL;     // code at a branch target can't be folded into what precedes it
+
     while (patches)
     {                                                           m3log (compile, "patching location: %p to pc: %p", patches, pc);
         pc_t next = * (pc_t *) patches;
@@ -826,6 +1189,69 @@ void  PatchBranches  (IM3Compilation o)
     }
 }
 
+// gas is charged per segment: a run of code that's entered at the top and, unless it branches or traps, left at the
+// bottom. a segment starts at the function entry, at each loop head and arm of an if, and after a loop, an if or a
+// block that's branched to. its op_UseGas is charged what the opcodes up to the next one cost, which is patched in
+// once that's known; a br_if that's taken has paid for the rest of its segment.
+static
+void  FinishGasSegment  (IM3Compilation o)
+{
+    if (o->gasCharge)
+        * o->gasCharge = o->gasCost;
+
+    o->gasCharge = NULL;
+    o->gasCost = 0;
+}
+
+static
+M3Result  StartGasSegment  (IM3Compilation o)
+{
+    M3Result result = m3Err_none;
+
+    if (o->gasCosts)
+    {
+        FinishGasSegment (o);
+
+_       (EmitOp (o, op_UseGas));
+
+        if (o->page)
+            o->gasCharge = (u32 *) GetPC (o);
+
+        EmitConstant32 (o, 0);
+    }
+
+    _catch: return result;
+}
+
+#if d_m3HasJit
+// while the runtime is tiering, functions are first compiled with a counter at the entry & at each loop head; see
+// op_CountHotness. template code is shared by runtimes, so it isn't counted
+static
+M3Result  EmitHotnessCount  (IM3Compilation o)
+{
+    M3Result result = m3Err_none;
+
+    IM3Function function = o->function;
+
+    if (function and o->runtime->tierThreshold and not function->tier and
+        not o->module->isTemplate and not o->module->templateModule)
+    {
+_       (EmitOp (o, op_CountHotness));
+        EmitPointer (o, function);
+    }
+
+    _catch: return result;
+}
+#endif
+
+static inline
+void  ChargeGas  (IM3Compilation o, m3opcode_t i_opcode)
+{
+    u32 cost = o->gasCosts [(i_opcode > 0xff) ? i_opcode >> 8 : i_opcode];
+
+    o->gasCost = (o->gasCost > UINT32_MAX - cost) ? UINT32_MAX : o->gasCost + cost;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------
 
 static
@@ -840,9 +1266,12 @@ M3Result  CopyStackIndexToSlot  (IM3Compilation o, u16 i_destSlot, u16 i_stackIn
 
     if (inRegister)
     {
+        if (TargetResultToSlot (o, i_stackIndex, i_destSlot))
+            return result;
+
         op = c_setSetOps [type];
     }
-    else op = Is64BitType (type) ? op_CopySlot_64 : op_CopySlot_32;
+    else op = d_slotTypeOp (type, CopySlot_);
 
 _   (EmitOp (o, op));
     EmitSlotOffset (o, i_destSlot);
@@ -887,7 +1316,7 @@ M3Result  PreservedCopyTopSlot  (IM3Compilation o, u16 i_destSlot, u16 i_preserv
     {
         op = c_preserveSetSlot [type];
     }
-    else op = Is64BitType (type) ? op_PreserveCopySlot_64 : op_PreserveCopySlot_32;
+    else op = d_slotTypeOp (type, PreserveCopySlot_);
 
 _   (EmitOp (o, op));
     EmitSlotOffset (o, i_destSlot);
@@ -1013,15 +1442,17 @@ M3Result  CopyStackSlotsR  (IM3Compilation o, u16 i_targetSlotStackIndex, u16 i_
                 u16 otherSlot1 = GetSlotForStackIndex (o, checkIndex);
                 u16 otherSlot2 = GetExtraSlotForStackIndex (o, checkIndex);
 
-                if (targetSlot == otherSlot1 or
-                    targetSlot == otherSlot2 or
-                    targetSlot + extraSlot == otherSlot1)
+                if (targetSlot <= otherSlot2 and otherSlot1 <= targetSlot + extraSlot)
                 {
-                    _throwif (m3Err_functionStackOverflow, i_tempSlot >= d_m3MaxFunctionSlots);
+                    u8 otherType = GetStackTypeFromBottom (o, checkIndex);
+                    u16 numTempSlots = M3_MAX (GetTypeNumSlots (otherType), GetTypeNumSlots (c_m3Type_i64));
+                    AlignSlotToType (& i_tempSlot, otherType);
+
+                    _throwif (m3Err_functionStackOverflow, i_tempSlot + numTempSlots > d_m3MaxFunctionSlots);
 
 _                   (CopyStackIndexToSlot (o, i_tempSlot, checkIndex));
                     o->wasmStack [checkIndex] = i_tempSlot;
-                    i_tempSlot += GetTypeNumSlots (c_m3Type_i64);
+                    i_tempSlot += numTempSlots;
                     TouchSlot (o, i_tempSlot - 1);
 
                     // restore this on the way back down
@@ -1115,7 +1546,10 @@ M3Result  ReturnValues  (IM3Compilation o, IM3CompilationScope i_functionBlock,
     if (numReturns)
     {
         // return slots like args are 64-bit aligned
-        u16 returnSlot = numReturns * c_ioSlotCount;
+        u16 returnSlot = 0;
+        for (u16 i = 0; i < numReturns; ++i)
+            returnSlot += GetTypeNumIOSlots (GetFuncTypeResultType (i_functionBlock->type, i));
+
         u16 stackTop = GetStackTopIndex (o);
 
         for (u16 i = 0; i < numReturns; ++i)
@@ -1131,7 +1565,7 @@ M3Result  ReturnValues  (IM3Compilation o, IM3CompilationScope i_functionBlock,
 
             if (not IsStackPolymorphic (o))
             {
-                returnSlot -= c_ioSlotCount;
+                returnSlot -= GetTypeNumIOSlots (returnType);
 _               (CopyStackIndexToSlot (o, returnSlot, stackTop--));
             }
         }
@@ -1225,6 +1659,34 @@ _   ((* compiler) (o, i_opcode));
 
     } _catch: return result;
 }
+
+# if d_m3HasSIMD || d_m3HasThreads
+// the 0xFD (SIMD) & 0xFE (atomic) opcodes are LEB encoded
+static
+M3Result  Compile_LebPrefixedOpcode  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    u32 opcode;
+_   (ReadLEB_u32 (& opcode, & o->wasm, o->wasmEnd));        m3log (compile, d_indent " (%X: %" PRIi32 ")", get_indention_string (o), i_opcode, opcode);
+    _throwif (m3Err_unknownOpcode, opcode > 0xff);
+
+    i_opcode = (i_opcode << 8) | opcode;
+
+    _throwif (m3Err_restrictedOpcode, not o->function and i_opcode != ((c_waOp_simd << 8) | c_waOp_v128_const));
+
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+    M3Compiler compiler = opInfo->compiler;
+    _throwif (m3Err_noCompiler, not compiler);
+
+_   ((* compiler) (o, i_opcode));
+
+    o->previousOpcode = i_opcode;
+
+    } _catch: return result;
+}
+# endif
 #endif
 
 static
@@ -1290,6 +1752,65 @@ _           (EmitOp (o, op_Return));
 }
 
 
+// turns the comparison that produced the condition at the stack top into a compare-and-branch. the caller pops
+// the condition and emits the branch target.
+static
+bool  FuseConditionalBranch  (IM3Compilation o, u32 i_branchKind)
+{
+# if d_m3FuseOperations
+    if (o->fusionPC and o->fusionEndPC == GetPC (o) and o->fusionStackIndex == o->stackIndex and IsStackTopInRegister (o))
+    {
+        code_t * operation = (code_t *) o->fusionPC;
+
+        for (u32 i = 0; i < M3_COUNT_OF (c_branchFusions); ++i)
+        {
+            if (* operation == d_m3OperationWord (c_branchFusions [i].op))
+            {                                                   m3log (compile, d_indent " (fused compare & branch)", get_indention_string (o));
+                * operation = d_m3OperationWord (c_branchFusions [i].branches [i_branchKind]);
+
+                NoteFusionCandidate (o, NULL);
+                return true;
+            }
+        }
+    }
+# endif
+
+    return false;
+}
+
+// emits the conditional branch on the stack top, folded into its comparison where possible. the target comes next
+static
+M3Result  EmitConditionalBranchOp  (IM3Compilation o, u32 i_branchKind, IM3Operation i_opForRegister, IM3Operation i_opForSlot)
+{
+    M3Result result = m3Err_none;
+
+    if (FuseConditionalBranch (o, i_branchKind))
+    {
+_       (PopType (o, c_m3Type_i32));
+    }
+    else
+    {
+_       (EmitOp (o, IsStackTopInRegister (o) ? i_opForRegister : i_opForSlot));
+_       (EmitSlotNumOfStackTopAndPop (o)); // condition
+    }
+
+    _catch: return result;
+}
+
+
+// locals start out zero. one that's written at the top level of the body (outside of any block, loop or if) before
+// it's read has been written on every path to that read, so op_Entry needn't zero it. the rest are spanned by
+// slotFirstZeroedLocal & slotMaxZeroedLocal
+static
+void  NoteLocalRead  (IM3Compilation o, u32 i_localIndex, u16 i_slot, u8 i_type)
+{
+    if (not o->localAssigned [i_localIndex])
+    {
+        o->slotFirstZeroedLocal = M3_MIN (o->slotFirstZeroedLocal, i_slot);
+        o->slotMaxZeroedLocal = M3_MAX (o->slotMaxZeroedLocal, i_slot + GetTypeNumSlots (i_type));
+    }
+}
+
 static
 M3Result  Compile_SetLocal  (IM3Compilation o, m3opcode_t i_opcode)
 {
@@ -1312,6 +1833,9 @@ _           (PreservedCopyTopSlot (o, localSlot, preserveSlot))
 
         if (i_opcode != c_waOp_teeLocal)
 _           (Pop (o));
+
+        if (o->block.depth == 0)
+            o->localAssigned [localIndex] = true;
     }
     else _throw ("local index out of bounds");
 
@@ -1332,6 +1856,8 @@ _   (ReadLEB_u32 (& localIndex, & o->wasm, o->wasmEnd));
     u8 type = GetStackTypeFromBottom (o, localIndex);
     u16 slot = GetSlotForStackIndex (o, localIndex);
 
+    NoteLocalRead (o, localIndex, slot, type);
+
 _   (Push (o, type, slot));
 
     } _catch: return result;
@@ -1342,9 +1868,19 @@ M3Result  Compile_GetGlobal  (IM3Compilation o, M3Global * i_global)
 {
     M3Result result;
 
-    IM3Operation op = Is64BitType (i_global->type) ? op_GetGlobal_s64 : op_GetGlobal_s32;
-_   (EmitOp (o, op));
-    EmitPointer (o, & i_global->i64Value);
+    if (o->module->isTemplate)
+    {
+        IM3Operation op = d_slotTypeOp (i_global->type, GetInstanceGlobal_s);
+_       (EmitOp (o, op));
+        EmitConstant32 (o, (u32) (i_global - o->module->globals));
+    }
+    else
+    {
+        IM3Operation op = d_slotTypeOp (i_global->type, GetGlobal_s);
+_       (EmitOp (o, op));
+        EmitPointer (o, & i_global->i64Value);
+    }
+
 _   (PushAllocatedSlotAndEmit (o, i_global->type));
 
     _catch: return result;
@@ -1360,14 +1896,28 @@ M3Result  Compile_SetGlobal  (IM3Compilation o, M3Global * i_global)
         IM3Operation op;
         u8 type = GetStackTopType (o);
 
-        if (IsStackTopInRegister (o))
+        if (o->module->isTemplate)
         {
-            op = c_setGlobalOps [type];
+            if (IsStackTopInRegister (o))
+            {
+                op = c_setInstanceGlobalOps [type];
+            }
+            else op = d_slotTypeOp (type, SetInstanceGlobal_s);
+
+_          (EmitOp (o, op));
+            EmitConstant32 (o, (u32) (i_global - o->module->globals));
         }
-        else op = Is64BitType (type) ? op_SetGlobal_s64 : op_SetGlobal_s32;
+        else
+        {
+            if (IsStackTopInRegister (o))
+            {
+                op = c_setGlobalOps [type];
+            }
+            else op = d_slotTypeOp (type, SetGlobal_s);
 
-_      (EmitOp (o, op));
-        EmitPointer (o, & i_global->i64Value);
+_          (EmitOp (o, op));
+            EmitPointer (o, & i_global->i64Value);
+        }
 
         if (IsStackTopInSlot (o))
             EmitSlotOffset (o, GetStackTopSlotNumber (o));
@@ -1438,10 +1988,7 @@ _   (GetBlockScope (o, & scope, depth));
         {
             if (GetFuncTypeNumParams (scope->type))
             {
-                IM3Operation op = IsStackTopInRegister (o) ? op_BranchIfPrologue_r : op_BranchIfPrologue_s;
-
-_               (EmitOp (o, op));
-_               (EmitSlotNumOfStackTopAndPop (o));
+_               (EmitConditionalBranchOp (o, c_fusedIf, op_BranchIfPrologue_r, op_BranchIfPrologue_s));
 
                 pc_t * jumpTo = (pc_t *) ReservePointer (o);
 
@@ -1452,6 +1999,12 @@ _               (EmitOp (o, op_ContinueLoop));
 
                 * jumpTo = GetPC (o);
             }
+            else if (FuseConditionalBranch (o, c_fusedContinueLoopIf))
+            {
+_               (PopType (o, c_m3Type_i32));
+
+                EmitPointer (o, scope->pc);
+            }
             else
             {
                 // move the condition to a register
@@ -1482,20 +2035,14 @@ _               (EmitOp (o, op_ContinueLoopIf));
         {
             if (targetHasResults or isReturn)
             {
-                IM3Operation op = IsStackTopInRegister (o) ? op_BranchIfPrologue_r : op_BranchIfPrologue_s;
-
-    _           (EmitOp (o, op));
-    _           (EmitSlotNumOfStackTopAndPop (o)); // condition
+    _           (EmitConditionalBranchOp (o, c_fusedIf, op_BranchIfPrologue_r, op_BranchIfPrologue_s));
 
                 // this is continuation point, if the branch isn't taken
                 jumpTo = (pc_t *) ReservePointer (o);
             }
             else
             {
-                IM3Operation op = IsStackTopInRegister (o) ? op_BranchIf_r : op_BranchIf_s;
-
-    _           (EmitOp (o, op));
-    _           (EmitSlotNumOfStackTopAndPop (o)); // condition
+    _           (EmitConditionalBranchOp (o, c_fusedBranchIf, op_BranchIf_r, op_BranchIf_s));
 
                 EmitPatchingBranchPointer (o, scope);
                 goto _catch;
@@ -1543,7 +2090,7 @@ _   (Pop (o));
     // result type consume matching operands first and push them back on the operand stack after unwinding"
     // So, this move-to-reg is only necessary if the target scopes have a type.
 
-    u32 numCodeLines = targetCount + 4; // 3 => IM3Operation + slot + target_count + default_target
+    u32 numCodeLines = (targetCount + 1) * d_m3CodeLines (pc_t) + 3; // IM3Operation + slot + target_count + the targets & default_target
 _   (EnsureCodePageNumLines (o, numCodeLines));
 
 _   (EmitOp (o, op_BranchTable));
@@ -1633,11 +2180,14 @@ _       (Pop (o));
     u16 numArgs = GetFuncTypeNumParams (i_type);
     u16 numRets = GetFuncTypeNumResults (i_type);
 
-    u16 argTop = topSlot + (numArgs + numRets) * c_ioSlotCount;
+    u16 argTop = topSlot;
+    for (u16 i = 0; i < numArgs + numRets; ++i)
+        argTop += GetTypeNumIOSlots (i_type->types [i]);
 
     while (numArgs--)
     {
-_       (CopyStackTopToSlot (o, argTop -= c_ioSlotCount));
+        argTop -= GetTypeNumIOSlots (GetFuncTypeParamType (i_type, numArgs));
+_       (CopyStackTopToSlot (o, argTop));
 _       (Pop (o));
     }
 
@@ -1649,12 +2199,49 @@ _       (Pop (o));
 _       (Push (o, type, topSlot));
         MarkSlotsAllocatedByType (o, topSlot, type);
 
-        topSlot += c_ioSlotCount;
+        topSlot += GetTypeNumIOSlots (type);
     }
 
     } _catch: return result;
 }
 
+M3Result  AddCodeSite  (M3CodeSites * io_sites, pc_t i_site)
+{
+    if (io_sites->numSites == io_sites->capacity)
+    {
+        u32 capacity = io_sites->capacity ? io_sites->capacity * 2 : 64;
+
+        pc_t * sites = m3_ReallocArray (pc_t, io_sites->sites, capacity, io_sites->capacity);
+        if (not sites)
+            return m3Err_mallocFailed;
+
+        io_sites->sites = sites;
+        io_sites->capacity = capacity;
+    }
+
+    io_sites->sites [io_sites->numSites++] = i_site;
+
+    return m3Err_none;
+}
+
+
+void  LinkDeferredCalls  (M3CodeSites * io_calls)
+{
+    for (u32 i = 0; i < io_calls->numSites; ++i)
+    {
+        code_t * site = (code_t *) io_calls->sites [i];
+        IM3Function function = * (IM3Function *) (site + 1);
+
+        // callees that failed to compile keep op_Compile and report the error when called
+        if (function->compiled)
+        {
+            site [0] = d_m3OperationWord (op_Call);
+            * (pc_t *) (site + 1) = function->compiled;
+        }
+    }
+}
+
+
 static
 M3Result  Compile_Call  (IM3Compilation o, m3opcode_t i_opcode)
 {
@@ -1675,7 +2262,10 @@ _           (CompileCallArgsAndReturn (o, & slotTop, function->funcType, false))
             IM3Operation op;
             const void * operand;
 
-            if (function->compiled)
+            // when compiling in parallel, the callee's code may be written concurrently; link it afterwards
+            bool deferred = (o->deferredCalls and function->wasm);
+
+            if (not deferred and function->compiled)
             {
                 op = op_Call;
                 operand = function->compiled;
@@ -1687,6 +2277,10 @@ _           (CompileCallArgsAndReturn (o, & slotTop, function->funcType, false))
             }
 
 _           (EmitOp     (o, op));
+
+            if (deferred)
+_               (AddCodeSite (o->deferredCalls, GetPC (o) - 1));
+
             EmitPointer (o, operand);
             EmitSlotOffset  (o, slotTop);
         }
@@ -1701,19 +2295,54 @@ _           (EmitOp     (o, op));
 }
 
 static
-M3Result  Compile_CallIndirect  (IM3Compilation o, m3opcode_t i_opcode)
+M3Result  Compile_ReturnCall  (IM3Compilation o, m3opcode_t i_opcode)
 {
 _try {
-    u32 typeIndex;
-_   (ReadLEB_u32 (& typeIndex, & o->wasm, o->wasmEnd));
+    u32 functionIndex;
+    bytes_t wasm = o->wasm;
+_   (ReadLEB_u32 (& functionIndex, & wasm, o->wasmEnd));
 
-    u32 tableIndex;
-_   (ReadLEB_u32 (& tableIndex, & o->wasm, o->wasmEnd));
+    IM3Function function = Module_GetFunction (o->module, functionIndex);
+    _throwif (m3Err_functionLookupFailed, not function);
 
-    _throwif ("function call type index out of range", typeIndex >= o->module->numFuncTypes);
+    if (function->import.moduleUtf8 or function->import.fieldUtf8)
+    {
+        // host functions have no frame to reuse; compile as call + return
+_       (Compile_Call (o, i_opcode));
+_       (Compile_Return (o, i_opcode));
+    }
+    else
+    {                                                                   m3log (compile, d_indent " (func= [%d] '%s'; args= %d)",
+                                                                                get_indention_string (o), functionIndex, m3_GetFunctionName (function), function->funcType->numArgs);
+        o->wasm = wasm;
 
-    if (IsStackTopInRegister (o))
-_       (PreserveRegisterIfOccupied (o, c_m3Type_i32));
+        u16 slotTop;
+_       (CompileCallArgsAndReturn (o, & slotTop, function->funcType, false));
+
+_       (EmitOp     (o, op_ReturnCall));
+        EmitPointer (o, function);
+        EmitSlotOffset  (o, slotTop);
+
+_       (SetStackPolymorphic (o));
+    }
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_CallIndirect  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    u32 typeIndex;
+_   (ReadLEB_u32 (& typeIndex, & o->wasm, o->wasmEnd));
+
+    u32 tableIndex;
+_   (ReadLEB_u32 (& tableIndex, & o->wasm, o->wasmEnd));
+
+    _throwif ("function call type index out of range", typeIndex >= o->module->numFuncTypes);
+
+    if (IsStackTopInRegister (o))
+_       (PreserveRegisterIfOccupied (o, c_m3Type_i32));
 
     u16 tableIndexSlot = GetStackTopSlotNumber (o);
 
@@ -1721,12 +2350,20 @@ _       (PreserveRegisterIfOccupied (o, c_m3Type_i32));
     IM3FuncType type = o->module->funcTypes [typeIndex];
 _   (CompileCallArgsAndReturn (o, & execTop, type, true));
 
-_   (EmitOp         (o, op_CallIndirect));
+    bool isTailCall = (i_opcode == c_waOp_returnCallIndirect);
+
+_   (EmitOp         (o, isTailCall ? op_ReturnCallIndirect : op_CallIndirect));
     EmitSlotOffset  (o, tableIndexSlot);
-    EmitPointer     (o, o->module);
+    EmitPointer     (o, o->module->isTemplate ? NULL : o->module);  // template code finds the table through the runtime
     EmitPointer     (o, type);              // TODO: unify all types in M3Environment
     EmitSlotOffset  (o, execTop);
 
+    if (isTailCall)
+    {
+_       (SetStackPolymorphic (o));
+    }
+    else EmitCallCache (o);
+
 } _catch:
     return result;
 }
@@ -1793,6 +2430,82 @@ _   (EmitSlotNumOfStackTopAndPop (o));
 }
 
 
+static
+M3Result  Compile_Memory_InitDrop  (IM3Compilation o, m3opcode_t i_opcode)
+{
+    M3Result result = m3Err_none;
+
+    u32 segmentIndex;
+_   (ReadLEB_u32 (& segmentIndex, & o->wasm, o->wasmEnd));
+    _throwif ("data segment index out of range", segmentIndex >= o->module->numDataSegments);
+
+    if (i_opcode == c_waOp_memoryInit)
+    {
+        u32 memoryIdx;
+_       (ReadLEB_u32 (& memoryIdx, & o->wasm, o->wasmEnd));
+
+_       (CopyStackTopToRegister (o, false));
+
+_       (EmitOp  (o, op_MemInit));
+_       (PopType (o, c_m3Type_i32));
+_       (EmitSlotNumOfStackTopAndPop (o));
+_       (EmitSlotNumOfStackTopAndPop (o));
+    }
+    else
+    {
+_       (EmitOp  (o, op_DataDrop));
+    }
+
+    EmitPointer     (o, o->module->isTemplate ? NULL : o->module);  // template code finds its segments through the runtime
+    EmitConstant32  (o, segmentIndex);
+
+    _catch: return result;
+}
+
+
+#if d_m3HasThreads
+// every atomic operand is an integer. the top one is copied to _r0 and the rest are passed as slots
+static
+M3Result  Compile_Atomic  (IM3Compilation o, m3opcode_t i_opcode)
+{
+    M3Result result = m3Err_none;
+
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+
+    if (i_opcode == c_waOp_atomicFence)
+    {
+        u8 reserved;
+_       (Read_u8 (& reserved, & o->wasm, o->wasmEnd));
+
+_       (EmitOp (o, op_AtomicFence));
+    }
+    else
+    {
+        u32 alignHint, memoryOffset;
+_       (ReadLEB_u32 (& alignHint, & o->wasm, o->wasmEnd));
+_       (ReadLEB_u32 (& memoryOffset, & o->wasm, o->wasmEnd));
+
+        i32 numOperands = (opInfo->type != c_m3Type_none) - opInfo->stackOffset;
+
+_       (CopyStackTopToRegister (o, false));
+
+_       (EmitOp (o, opInfo->operations [0]));
+_       (Pop (o));
+
+        for (i32 i = 1; i < numOperands; ++i)
+_           (EmitSlotNumOfStackTopAndPop (o));
+
+        EmitConstant32 (o, memoryOffset);
+
+        if (opInfo->type != c_m3Type_none)
+_           (PushRegister (o, opInfo->type));
+    }
+
+    _catch: return result;
+}
+#endif
+
+
 static
 M3Result  ReadBlockType  (IM3Compilation o, IM3FuncType * o_blockType)
 {
@@ -1834,7 +2547,7 @@ _           (FindReferencedLocalWithinCurrentBlock (o, & preservedSlotNumber, sl
             if (preservedSlotNumber != slot)
             {
                 u8 type = GetStackTypeFromBottom (o, i);                    d_m3Assert (type != c_m3Type_none)
-                IM3Operation op = Is64BitType (type) ? op_CopySlot_64 : op_CopySlot_32;
+                IM3Operation op = d_slotTypeOp (type, CopySlot_);
 
                 EmitOp          (o, op);
                 EmitSlotOffset  (o, preservedSlotNumber);
@@ -1965,10 +2678,7 @@ _try {
 _   (PreserveNonTopRegisters (o));
 _   (PreserveArgsAndLocals (o));
 
-    IM3Operation op = IsStackTopInRegister (o) ? op_If_r : op_If_s;
-
-_   (EmitOp (o, op));
-_   (EmitSlotNumOfStackTopAndPop (o));
+_   (EmitConditionalBranchOp (o, c_fusedIf, op_If_r, op_If_s));
 
     pc_t * pc = (pc_t *) ReservePointer (o);
 
@@ -2004,6 +2714,9 @@ _           (CompileElseBlock (o, pc, blockType));
         else * pc = GetPC (o);
     }
 
+    // both arms continue here
+_   (StartGasSegment (o));
+
     } _catch: return result;
 }
 
@@ -2017,6 +2730,7 @@ M3Result  Compile_Select  (IM3Compilation o, m3opcode_t i_opcode)
     u8 type = GetStackTypeFromTop (o, 1); // get type of selection
 
     IM3Operation op = NULL;
+    pc_t operationPC = NULL;                // the int selects can store their result to a slot; see c_setSlotFusions
 
     if (IsFpType (type))
     {
@@ -2073,16 +2787,41 @@ _          (Pop (o));
 
         op = c_intSelectOps [type - c_m3Type_i32] [opIndex];
     }
+#   if d_m3HasSIMD
+    else if (IsVectorType (type))
+    {
+        // only the selector can be in a register
+        op = IsStackTopInRegister (o) ? op_Select_v128_rss : op_Select_v128_sss;
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            if (not IsStackTopInRegister (o))
+                slots [i] = GetStackTopSlotNumber (o);
+
+_          (Pop (o));
+        }
+    }
+#   endif
     else if (not IsStackPolymorphic (o))
         _throw (m3Err_functionStackUnderrun);
 
     EmitOp (o, op);
+
+    if (o->page and IsIntType (type))
+        operationPC = GetPC (o) - 1;
+
     for (u32 i = 0; i < 3; i++)
     {
         if (IsValidSlot (slots [i]))
             EmitSlotOffset (o, slots [i]);
     }
-_   (PushRegister (o, type));
+
+    if (IsVectorType (type))
+_       (PushAllocatedSlotAndEmit (o, type))
+    else
+_       (PushRegister (o, type));
+
+    NoteFusionCandidate (o, operationPC);
 
     _catch: return result;
 }
@@ -2135,6 +2874,333 @@ _   (SetStackPolymorphic (o));
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------------
+// operators on constants are evaluated here, and those with a constant divisor or multiplier made cheaper. nothing
+// that would trap is folded, so it still traps when it's run.
+
+// the type of the operands of an integer operator that can be folded
+static
+u8  GetFoldableOperandType  (m3opcode_t i_opcode)
+{
+    if ((i_opcode >= 0x45 and i_opcode <= 0x4f) or (i_opcode >= 0x67 and i_opcode <= 0x78) or      // i32.eqz .. i32.ge_u, i32.clz .. i32.rotr
+        i_opcode == 0xac or i_opcode == 0xad or i_opcode == 0xc0 or i_opcode == 0xc1)               // i64.extend_i32_*, i32.extend*_s
+        return c_m3Type_i32;
+
+    if ((i_opcode >= 0x50 and i_opcode <= 0x5a) or (i_opcode >= 0x79 and i_opcode <= 0x8a) or      // the i64 forms
+        i_opcode == 0xa7 or (i_opcode >= 0xc2 and i_opcode <= 0xc4))                                // i32.wrap_i64, i64.extend*_s
+        return c_m3Type_i64;
+
+    return c_m3Type_none;
+}
+
+static
+bool  GetConstantStackValue  (IM3Compilation o, u16 i_stackIndex, u64 * o_value)
+{
+    u16 slot = GetSlotForStackIndex (o, i_stackIndex);
+
+    if (not IsConstantSlot (o, slot))
+        return false;
+
+    if (Is64BitType (GetStackTypeFromBottom (o, i_stackIndex)))
+    {
+        memcpy (o_value, & o->constants [slot - o->slotFirstConstIndex], sizeof (u64));
+    }
+    else
+    {
+        u32 value;
+        memcpy (& value, & o->constants [slot - o->slotFirstConstIndex], sizeof (u32));
+        * o_value = value;
+    }
+
+    return true;
+}
+
+// returns false for an operation that traps. the i64 forms are passed as their i32 opcode
+static
+bool  FoldIntegerOperator  (m3opcode_t i_opcode, bool i_is64, u64 i_a, u64 i_b, u64 * o_result)
+{
+    u32 bits = i_is64 ? 64 : 32;
+    u64 mask = i_is64 ? UINT64_MAX : UINT32_MAX;
+    u64 a = i_a & mask, b = i_b & mask;
+    i64 sa = i_is64 ? (i64) a : (i64) (i32) a;
+    i64 sb = i_is64 ? (i64) b : (i64) (i32) b;
+    i64 min = i_is64 ? INT64_MIN : INT32_MIN;
+
+    u64 r;
+
+    switch (i_opcode)
+    {
+        case 0x45: r = (a == 0);                    break;      // eqz
+        case 0x46: r = (a == b);                    break;      // eq
+        case 0x47: r = (a != b);                    break;      // ne
+        case 0x48: r = (sa < sb);                   break;      // lt_s
+        case 0x49: r = (a < b);                     break;      // lt_u
+        case 0x4a: r = (sa > sb);                   break;      // gt_s
+        case 0x4b: r = (a > b);                     break;      // gt_u
+        case 0x4c: r = (sa <= sb);                  break;      // le_s
+        case 0x4d: r = (a <= b);                    break;      // le_u
+        case 0x4e: r = (sa >= sb);                  break;      // ge_s
+        case 0x4f: r = (a >= b);                    break;      // ge_u
+
+        case 0x67: r = a ? (u64) (i_is64 ? __builtin_clzll (a) : __builtin_clz ((u32) a)) : bits;  break;      // clz
+        case 0x68: r = a ? (u64) (i_is64 ? __builtin_ctzll (a) : __builtin_ctz ((u32) a)) : bits;  break;      // ctz
+        case 0x69: r = (u64) (i_is64 ? __builtin_popcountll (a) : __builtin_popcount ((u32) a));    break;      // popcnt
+
+        case 0x6a: r = a + b;                       break;      // add
+        case 0x6b: r = a - b;                       break;      // sub
+        case 0x6c: r = a * b;                       break;      // mul
+        case 0x6d:                                              // div_s
+            if (b == 0 or (sa == min and sb == -1))
+                return false;
+            r = (u64) (sa / sb);
+            break;
+        case 0x6e:                                              // div_u
+            if (b == 0)
+                return false;
+            r = a / b;
+            break;
+        case 0x6f:                                              // rem_s
+            if (b == 0)
+                return false;
+            r = (sb == -1) ? 0 : (u64) (sa % sb);
+            break;
+        case 0x70:                                              // rem_u
+            if (b == 0)
+                return false;
+            r = a % b;
+            break;
+        case 0x71: r = a & b;                       break;
+        case 0x72: r = a | b;                       break;
+        case 0x73: r = a ^ b;                       break;
+        case 0x74: r = a << (b & (bits - 1));       break;      // shl
+        case 0x75: r = (u64) (sa >> (b & (bits - 1)));  break;  // shr_s
+        case 0x76: r = a >> (b & (bits - 1));       break;      // shr_u
+        case 0x77: r = i_is64 ? rotl64 (a, (unsigned) b) : rotl32 ((u32) a, (unsigned) b);         break;
+        case 0x78: r = i_is64 ? rotr64 (a, (unsigned) b) : rotr32 ((u32) a, (unsigned) b);         break;
+
+        default: return false;
+    }
+
+    * o_result = r & mask;
+
+    return true;
+}
+
+static
+bool  FoldConversion  (m3opcode_t i_opcode, u64 i_value, u64 * o_result)
+{
+    switch (i_opcode)
+    {
+        case 0xa7: * o_result = (u32) i_value;                      break;      // i32.wrap_i64
+        case 0xac: * o_result = (u64) (i64) (i32) i_value;          break;      // i64.extend_i32_s
+        case 0xad: * o_result = (u32) i_value;                      break;      // i64.extend_i32_u
+        case 0xc0: * o_result = (u32) (i32) (i8) i_value;           break;      // i32.extend8_s
+        case 0xc1: * o_result = (u32) (i32) (i16) i_value;          break;      // i32.extend16_s
+        case 0xc2: * o_result = (u64) (i64) (i8) i_value;           break;      // i64.extend8_s
+        case 0xc3: * o_result = (u64) (i64) (i16) i_value;          break;      // i64.extend16_s
+        case 0xc4: * o_result = (u64) (i64) (i32) i_value;          break;      // i64.extend32_s
+        default: return false;
+    }
+
+    return true;
+}
+
+// the magic number & shift that turn a signed division by i_divisor into a multiply-high (Hacker's Delight, 10-1).
+// i_divisor mustn't be 0, 1 or -1
+static
+void  GetSignedDivisionMagic  (i64 i_divisor, u32 i_bits, i64 * o_magic, u32 * o_shift)
+{
+    u64 mask = (i_bits == 64) ? UINT64_MAX : UINT32_MAX;
+    u64 two = 1ull << (i_bits - 1);
+
+    u64 d = (u64) i_divisor & mask;
+    u64 ad = ((i_divisor < 0) ? 0 - (u64) i_divisor : (u64) i_divisor) & mask;
+    u64 t = two + (d >> (i_bits - 1));
+    u64 anc = t - 1 - t % ad;                                   // |nc|
+
+    u32 p = i_bits - 1;
+    u64 q1 = two / anc, r1 = two - q1 * anc;
+    u64 q2 = two / ad, r2 = two - q2 * ad;
+    u64 delta;
+
+    do
+    {
+        ++p;
+        q1 = (2 * q1) & mask;   r1 = (2 * r1) & mask;
+        if (r1 >= anc) { q1 = (q1 + 1) & mask;  r1 = (r1 - anc) & mask; }
+
+        q2 = (2 * q2) & mask;   r2 = (2 * r2) & mask;
+        if (r2 >= ad) { q2 = (q2 + 1) & mask;  r2 = (r2 - ad) & mask; }
+
+        delta = ad - r2;
+    }
+    while (q1 < delta or (q1 == delta and r1 == 0));
+
+    u64 magic = (q2 + 1) & mask;
+    if (i_divisor < 0)
+        magic = (0 - magic) & mask;
+
+    * o_magic = (i_bits == 64) ? (i64) magic : (i64) (i32) (u32) magic;
+    * o_shift = p - i_bits;
+}
+
+// the dividend is at the stack top, the divisor already popped
+static
+M3Result  EmitDivideByConstant  (IM3Compilation o, m3opcode_t i_opcode, u8 i_type, i64 i_divisor)
+{
+    M3Result result;
+
+    bool isDivide = (i_opcode == c_waOp_i32_div_s or i_opcode == c_waOp_i64_div_s);
+    bool is64 = (i_type == c_m3Type_i64);
+
+    i64 magic; u32 shift;
+    GetSignedDivisionMagic (i_divisor, is64 ? 64 : 32, & magic, & shift);
+
+    static const IM3Operation ops [2] [2] [2] =     // [is64] [isDivide] [in slot]
+    {
+        { { op_i32_RemainderConstant_r, op_i32_RemainderConstant_s }, { op_i32_DivideConstant_r, op_i32_DivideConstant_s } },
+        { { op_i64_RemainderConstant_r, op_i64_RemainderConstant_s }, { op_i64_DivideConstant_r, op_i64_DivideConstant_s } }
+    };
+
+    bool inSlot = IsStackTopInSlot (o);
+    if (inSlot)
+_       (PreserveRegisterIfOccupied (o, i_type));
+
+    // two 64-bit constants can exceed the usual maximum when they take two lines each
+    if (is64 and o->page)
+_       (EnsureCodePageNumLines (o, 3 + 2 * d_m3CodeLines (u64)));
+
+_   (EmitOp (o, ops [is64] [isDivide] [inSlot]));
+
+    if (inSlot)
+        EmitSlotOffset (o, GetStackTopSlotNumber (o));
+
+    if (is64)
+    {
+        if (o->page)
+        {
+            EmitWord64 (o->page, (u64) magic);
+            EmitWord64 (o->page, (u64) i_divisor);
+        }
+    }
+    else
+    {
+        EmitConstant32 (o, (u32) magic);
+        EmitConstant32 (o, (u32) i_divisor);
+    }
+
+    EmitConstant32 (o, shift);
+
+_   (Pop (o));
+_   (PushRegister (o, i_type));
+
+    _catch: return result;
+}
+
+static
+M3Result  Compile_Operator  (IM3Compilation o, m3opcode_t i_opcode);
+
+// sets o_reduced when it has compiled the operator itself
+static
+M3Result  ReduceIntegerOperator  (IM3Compilation o, m3opcode_t i_opcode, bool * o_reduced)
+{
+    M3Result result = m3Err_none;
+
+    u8 type = GetFoldableOperandType (i_opcode);
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    bool isBinary = (opInfo->stackOffset < 0);
+    u16 numOperands = isBinary ? 2 : 1;
+
+    // leaves underruns & type mismatches to be reported as usual
+    if (GetNumBlockValuesOnStack (o) < numOperands)
+        return result;
+
+    u16 top = GetStackTopIndex (o);
+
+    if (GetStackTypeFromBottom (o, top) != type or (isBinary and GetStackTypeFromBottom (o, top - 1) != type))
+        return result;
+
+    bool is64 = (type == c_m3Type_i64);
+    u64 a = 0, b = 0, value;
+
+    bool isConstant2 = GetConstantStackValue (o, top, & b);
+    bool isConstant1 = isBinary ? GetConstantStackValue (o, top - 1, & a) : isConstant2;
+
+    if (not isBinary)
+        a = b;
+
+    if (isConstant1 and isConstant2)
+    {
+        m3opcode_t opcode = i_opcode;
+
+        if (i_opcode >= 0x50 and i_opcode <= 0x5a)
+            opcode -= 0x0b;
+        else if (i_opcode >= 0x79 and i_opcode <= 0x8a)
+            opcode -= 0x12;
+
+        if (FoldConversion (i_opcode, a, & value) or FoldIntegerOperator (opcode, is64, a, b, & value))
+        {                                                                   m3log (compile, d_indent " (folded)", get_indention_string (o));
+_           (Pop (o));
+            if (isBinary)
+_               (Pop (o));
+
+_           (PushConst (o, value, opInfo->type));
+            * o_reduced = true;
+        }
+    }
+    else if (isConstant2 and isBinary)
+    {
+        i64 divisor = is64 ? (i64) b : (i64) (i32) b;
+        bool isPowerOfTwo = (b and not (b & (b - 1)));
+
+        m3opcode_t opcode = 0;                                          // the operator it's rewritten to, if any
+        u64 operand = 0;
+
+        switch (i_opcode)
+        {
+            case c_waOp_i32_mul:    case c_waOp_i64_mul:
+            case c_waOp_i32_div_u:  case c_waOp_i64_div_u:
+                if (isPowerOfTwo)
+                {
+                    opcode = (i_opcode == c_waOp_i32_mul) ? c_waOp_i32_shl : (i_opcode == c_waOp_i64_mul) ? c_waOp_i64_shl :
+                             (i_opcode == c_waOp_i32_div_u) ? c_waOp_i32_shr_u : c_waOp_i64_shr_u;
+                    operand = is64 ? __builtin_ctzll (b) : __builtin_ctz ((u32) b);
+                }
+                break;
+
+            case c_waOp_i32_rem_u:  case c_waOp_i64_rem_u:
+                if (isPowerOfTwo)
+                {
+                    opcode = is64 ? c_waOp_i64_and : c_waOp_i32_and;
+                    operand = b - 1;
+                }
+                break;
+
+            case c_waOp_i32_div_s:  case c_waOp_i64_div_s:
+            case c_waOp_i32_rem_s:  case c_waOp_i64_rem_s:
+                // 0 traps & -1 can overflow, so those are left to the runtime op
+                if (divisor != 0 and divisor != 1 and divisor != -1)
+                {                                                           m3log (compile, d_indent " (division by constant)", get_indention_string (o));
+_                   (Pop (o));
+_                   (EmitDivideByConstant (o, i_opcode, type, divisor));
+                    * o_reduced = true;
+                }
+                break;
+        }
+
+        if (opcode)
+        {                                                                   m3log (compile, d_indent " (strength reduced)", get_indention_string (o));
+_           (Pop (o));
+_           (PushConst (o, operand, type));
+_           (Compile_Operator (o, opcode));
+            * o_reduced = true;
+        }
+    }
+
+    _catch: return result;
+}
+
+
 // OPTZ: currently all stack slot indices take up a full word, but
 // dual stack source operands could be packed together
 static
@@ -2145,6 +3211,15 @@ M3Result  Compile_Operator  (IM3Compilation o, m3opcode_t i_opcode)
     IM3OpInfo opInfo = GetOpInfo (i_opcode);
     _throwif (m3Err_unknownOpcode, not opInfo);
 
+    if (o->page and GetFoldableOperandType (i_opcode))
+    {
+        bool reduced = false;
+        result = ReduceIntegerOperator (o, i_opcode, & reduced);
+
+        if (result or reduced)
+            return result;
+    }
+
     IM3Operation op;
 
     // This preserve is for for FP compare operations.
@@ -2198,6 +3273,7 @@ _           (PreserveRegisterIfOccupied (o, opInfo->type));     // _ss
     if (op)
     {
 _       (EmitOp (o, op));
+        pc_t operationPC = o->page ? GetPC (o) - 1 : NULL;
 
 _       (EmitSlotNumOfStackTopAndPop (o));
 
@@ -2206,6 +3282,8 @@ _           (EmitSlotNumOfStackTopAndPop (o));
 
         if (opInfo->type != c_m3Type_none)
 _           (PushRegister (o, opInfo->type));
+
+        NoteFusionCandidate (o, operationPC);
     }
     else
     {
@@ -2262,23 +3340,348 @@ _       (PreserveRegisterIfOccupied (o, c_m3Type_f64));
 _   (Compile_Operator (o, i_opcode));
 
     EmitConstant32 (o, memoryOffset);
+
+    if (o->fusionPC)
+        NoteFusionCandidate (o, o->fusionPC);   // the offset belongs to the load
+}
+    _catch: return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------
+#if d_m3HasSIMD
+
+// v128 values are never in a register, so they always have a slot to emit
+static
+M3Result  EmitVectorSlotAndPop  (IM3Compilation o)
+{
+    EmitSlotOffset (o, GetStackTopSlotNumber (o));
+
+    return PopType (o, c_m3Type_v128);
+}
+
+// the number of lanes indexed by the immediate of a *_lane operation
+static
+u32  GetSimdLaneCount  (m3opcode_t i_opcode)
+{
+    switch (i_opcode & 0xff)
+    {
+        case 0x15: case 0x16: case 0x17: case 0x54: case 0x58:                  return 16;
+        case 0x18: case 0x19: case 0x1a: case 0x55: case 0x59:                  return 8;
+        case 0x1b: case 0x1c: case 0x1f: case 0x20: case 0x56: case 0x5a:       return 4;
+        default:                                                                return 2;
+    }
+}
+
+static
+M3Result  ReadSimdLane  (IM3Compilation o, u8 * o_lane, m3opcode_t i_opcode)
+{
+    M3Result result = Read_u8 (o_lane, & o->wasm, o->wasmEnd);
+
+    if (not result and * o_lane >= GetSimdLaneCount (i_opcode))
+        result = m3Err_wasmMalformed;
+
+    return result;
+}
+
+static
+void  EmitV128  (IM3Compilation o, m3v128_t i_value)
+{
+    if (o->page)
+    {
+        EmitWord64 (o->page, i_value.u64x2 [0]);
+        EmitWord64 (o->page, i_value.u64x2 [1]);
+    }
 }
+
+// v128 constants share the constant table with the scalars and fall back to an inline op_Const128 once it's full
+static
+M3Result  PushConstV128  (IM3Compilation o, m3v128_t i_value)
+{
+    M3Result result = m3Err_none;
+
+    // Early-exit if we're not emitting
+    if (!o->page) return result;
+
+    u16 numRequiredSlots = GetTypeNumSlots (c_m3Type_v128);
+
+    // search for a duplicate to reuse. the 16 bytes might well span scalar constants; that's fine
+    u16 firstConstSlot = o->slotFirstConstIndex;
+    AlignSlotToType (& firstConstSlot, c_m3Type_v128);
+
+    for (u16 slot = firstConstSlot; slot + numRequiredSlots <= o->slotMaxConstIndex; slot += numRequiredSlots)
+    {
+        bool allocated = true;
+        for (u16 i = 0; i < numRequiredSlots; ++i)
+            allocated = allocated and IsSlotAllocated (o, slot + i);
+
+        if (allocated and memcmp (& o->constants [slot - o->slotFirstConstIndex], & i_value, sizeof (i_value)) == 0)
+        {
+            return Push (o, c_m3Type_v128, slot);
+        }
+    }
+
+    u16 slot = c_slotUnused;
+    result = AllocateConstantSlots (o, & slot, c_m3Type_v128);
+
+    if (result || slot == c_slotUnused) // no more constant table space; use an inline constant
+    {
+        result = m3Err_none;
+
+_       (EmitOp (o, op_Const128));
+        EmitV128 (o, i_value);
+
+_       (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+    }
+    else
+    {
+        u16 constTableIndex = slot - o->slotFirstConstIndex;                    d_m3Assert (constTableIndex < d_m3MaxConstantTableSize);
+
+        memcpy (& o->constants [constTableIndex], & i_value, sizeof (i_value));
+
+_       (Push (o, c_m3Type_v128, slot));
+
+        o->slotMaxConstIndex = M3_MAX (slot + numRequiredSlots, o->slotMaxConstIndex);
+    }
+
     _catch: return result;
 }
 
+static
+M3Result  Compile_SimdConst  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    m3v128_t value;
+
+    _throwif (m3Err_wasmUnderrun, o->wasm + sizeof (value) > o->wasmEnd);
+    memcpy (& value, o->wasm, sizeof (value));
+    o->wasm += sizeof (value);
+
+_   (PushConstV128 (o, value));
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_SimdShuffle  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    m3v128_t lanes;
+
+    _throwif (m3Err_wasmUnderrun, o->wasm + sizeof (lanes) > o->wasmEnd);
+    memcpy (& lanes, o->wasm, sizeof (lanes));
+    o->wasm += sizeof (lanes);
+
+    for (u32 i = 0; i < 16; ++i)
+        _throwif (m3Err_wasmMalformed, lanes.u8x16 [i] >= 32);
+
+    // the operation, its 2 slots, the lane indices & the result can exceed the usual maximum on 32-bit platforms
+    if (o->page)
+_       (EnsureCodePageNumLines (o, 4 + c_m3V128CodeLines));
+
+_   (EmitOp (o, op_i8x16_Shuffle));
+_   (EmitVectorSlotAndPop (o));
+_   (EmitVectorSlotAndPop (o));
+    EmitV128 (o, lanes);
+_   (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+// v128 -> v128, or v128 -> i32 for the lane tests (any_true, all_true, bitmask)
+static
+M3Result  Compile_SimdUnary  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+    if (IsVectorType (opInfo->type))
+    {
+_       (EmitOp (o, opInfo->operations [0]));
+_       (EmitVectorSlotAndPop (o));
+_       (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+    }
+    else
+    {
+_       (PreserveRegisterIfOccupied (o, opInfo->type));
+_       (EmitOp (o, opInfo->operations [0]));
+_       (EmitVectorSlotAndPop (o));
+_       (PushRegister (o, opInfo->type));
+    }
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_SimdBinary  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+_   (EmitOp (o, opInfo->operations [0]));
+_   (EmitVectorSlotAndPop (o));
+_   (EmitVectorSlotAndPop (o));
+_   (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_SimdBitSelect  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+_   (EmitOp (o, op_v128_BitSelect));
+_   (EmitVectorSlotAndPop (o));
+_   (EmitVectorSlotAndPop (o));
+_   (EmitVectorSlotAndPop (o));
+_   (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+// the scalar operand of a shift, splat or replace_lane is on top: [0]= in register, [1]= in slot
+static
+M3Result  EmitSimdScalarOperand  (IM3Compilation o, IM3OpInfo i_opInfo)
+{
+    M3Result result;
+
+    IM3Operation op = i_opInfo->operations [IsStackTopInRegister (o) ? 0 : 1];
+
+_   (EmitOp (o, op));
+_   (EmitSlotNumOfStackTopAndPop (o));
+
+    _catch: return result;
+}
+
+static
+M3Result  Compile_SimdSplat  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+_   (EmitSimdScalarOperand (o, opInfo));
+_   (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_SimdShift  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+_   (EmitSimdScalarOperand (o, opInfo));
+_   (EmitVectorSlotAndPop (o));
+_   (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_SimdReplaceLane  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    u8 lane;
+_   (ReadSimdLane (o, & lane, i_opcode));
+
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+_   (EmitSimdScalarOperand (o, opInfo));
+_   (EmitVectorSlotAndPop (o));
+    EmitConstant32 (o, lane);
+_   (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+static
+M3Result  Compile_SimdExtractLane  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    u8 lane;
+_   (ReadSimdLane (o, & lane, i_opcode));
+
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+_   (PreserveRegisterIfOccupied (o, opInfo->type));
+_   (EmitOp (o, opInfo->operations [0]));
+_   (EmitVectorSlotAndPop (o));
+    EmitConstant32 (o, lane);
+_   (PushRegister (o, opInfo->type));
+
+    } _catch: return result;
+}
+
+// loads, load_lane, store & store_lane. operations: [0]= address in register, [1]= address in slot
+static
+M3Result  Compile_SimdLoadStore  (IM3Compilation o, m3opcode_t i_opcode)
+{
+_try {
+    u32 alignHint, memoryOffset;
+
+_   (ReadLEB_u32 (& alignHint, & o->wasm, o->wasmEnd));
+_   (ReadLEB_u32 (& memoryOffset, & o->wasm, o->wasmEnd));
+                                                                        m3log (compile, d_indent " (offset = %d)", get_indention_string (o), memoryOffset);
+    IM3OpInfo opInfo = GetOpInfo (i_opcode);
+    _throwif (m3Err_unknownOpcode, not opInfo);
+
+    u8 simdOpcode = i_opcode & 0xff;
+    bool hasLane = (simdOpcode >= 0x54 and simdOpcode <= 0x5b);
+    bool isStore = (simdOpcode == 0x0b or (simdOpcode >= 0x58 and simdOpcode <= 0x5b));
+
+    u8 lane = 0;
+    if (hasLane)
+_       (ReadSimdLane (o, & lane, i_opcode));
+
+    if (hasLane or isStore)
+    {
+        // [address] [vector]
+        bool addressInRegister = IsStackTopMinus1InRegister (o);
+
+_       (EmitOp (o, opInfo->operations [addressInRegister ? 0 : 1]));
+_       (EmitVectorSlotAndPop (o));
+    }
+    else
+    {
+        bool addressInRegister = IsStackTopInRegister (o);
+
+_       (EmitOp (o, opInfo->operations [addressInRegister ? 0 : 1]));
+    }
+
+_   (EmitSlotNumOfStackTopAndPop (o));
+    EmitConstant32 (o, memoryOffset);
+
+    if (hasLane)
+        EmitConstant32 (o, lane);
+
+    if (not isStore)
+_       (PushAllocatedSlotAndEmit (o, c_m3Type_v128));
+
+    } _catch: return result;
+}
+
+#endif // d_m3HasSIMD
+
 
 M3Result  CompileRawFunction  (IM3Module io_module,  IM3Function io_function, const void * i_function, const void * i_userdata)
 {
     d_m3Assert (io_module->runtime);
 
-    IM3CodePage page = AcquireCodePageWithCapacity (io_module->runtime, 4);
+    IM3CodePage page = AcquireCodePageWithCapacity (io_module->runtime, 1 + 3 * d_m3CodeLines (void *));
 
     if (page)
     {
         io_function->compiled = GetPagePC (page);
         io_function->module = io_module;
 
-        EmitWord (page, op_CallRawFunction);
+        EmitOperationWord (page, op_CallRawFunction);
         EmitWord (page, i_function);
         EmitWord (page, io_function);
         EmitWord (page, i_userdata);
@@ -2300,6 +3703,8 @@ M3Result  CompileRawFunction  (IM3Module io_module,  IM3Function io_function, co
 #define d_emptyOpList                       { NULL,                     NULL,                       NULL,                       NULL }
 #define d_unaryOpList(TYPE, NAME)           { op_##TYPE##_##NAME##_r,   op_##TYPE##_##NAME##_s,     NULL,                       NULL }
 #define d_binOpList(TYPE, NAME)             { op_##TYPE##_##NAME##_rs,  op_##TYPE##_##NAME##_sr,    op_##TYPE##_##NAME##_ss,    NULL }
+#define d_simdOpList(TYPE, NAME)            { op_##TYPE##_##NAME,       NULL,                       NULL,                       NULL }
+#define d_atomicOpList(TYPE, NAME)          { op_##TYPE##_##NAME,       NULL,                       NULL,                       NULL }
 #define d_storeFpOpList(TYPE, NAME)         { op_##TYPE##_##NAME##_rs,  op_##TYPE##_##NAME##_sr,    op_##TYPE##_##NAME##_ss,    op_##TYPE##_##NAME##_rr }
 #define d_commutativeBinOpList(TYPE, NAME)  { op_##TYPE##_##NAME##_rs,  NULL,                       op_##TYPE##_##NAME##_ss,    NULL }
 #define d_convertOpList(OP)                 { op_##OP##_r_r,            op_##OP##_r_s,              op_##OP##_s_r,              op_##OP##_s_s }
@@ -2328,8 +3733,8 @@ const M3OpInfo c_operations [] =
     M3OP( "return",              0, any,    d_logOp (Return),                   Compile_Return ),       // 0x0f
     M3OP( "call",                0, any,    d_logOp (Call),                     Compile_Call ),         // 0x10
     M3OP( "call_indirect",       0, any,    d_logOp (CallIndirect),             Compile_CallIndirect ), // 0x11
-    M3OP( "return_call",         0, any,    d_emptyOpList,                      Compile_Call ),         // 0x12 TODO: Optimize
-    M3OP( "return_call_indirect",0, any,    d_emptyOpList,                      Compile_CallIndirect ), // 0x13
+    M3OP( "return_call",         0, any,    d_logOp (ReturnCall),               Compile_ReturnCall ),   // 0x12
+    M3OP( "return_call_indirect",0, any,    d_logOp (ReturnCallIndirect),       Compile_CallIndirect ), // 0x13
 
     M3OP_RESERVED,  M3OP_RESERVED,                                                                      // 0x14...
     M3OP_RESERVED,  M3OP_RESERVED,                                                                      // ...0x17
@@ -2545,7 +3950,7 @@ const M3OpInfo c_operations [] =
 # endif
 
     d_m3DebugOp (Compile),          d_m3DebugOp (Entry),            d_m3DebugOp (End),
-    d_m3DebugOp (Unsupported),      d_m3DebugOp (CallRawFunction),
+    d_m3DebugOp (Unsupported),      d_m3DebugOp (CallRawFunction),  d_m3DebugOp (UseGas),
 
     d_m3DebugOp (GetGlobal_s32),    d_m3DebugOp (GetGlobal_s64),    d_m3DebugOp (ContinueLoop),     d_m3DebugOp (ContinueLoopIf),
 
@@ -2563,7 +3968,7 @@ const M3OpInfo c_operations [] =
     d_m3DebugOp (Select_f64_rss),   d_m3DebugOp (Select_f64_rrs),   d_m3DebugOp (Select_f64_rsr),
 # endif
 
-    d_m3DebugOp (MemFill),          d_m3DebugOp (MemCopy),
+    d_m3DebugOp (MemFill),          d_m3DebugOp (MemCopy),          d_m3DebugOp (MemInit),          d_m3DebugOp (DataDrop),
 
     d_m3DebugTypedOp (SetGlobal),   d_m3DebugOp (SetGlobal_s32),    d_m3DebugOp (SetGlobal_s64),
 
@@ -2572,6 +3977,12 @@ const M3OpInfo c_operations [] =
 
 # if d_m3CascadedOpcodes
     [c_waOp_extended] = M3OP( "0xFC", 0, c_m3Type_unknown,   d_emptyOpList,  Compile_ExtendedOpcode ),
+#   if d_m3HasSIMD
+    [c_waOp_simd]     = M3OP( "0xFD", 0, c_m3Type_unknown,   d_emptyOpList,  Compile_LebPrefixedOpcode ),
+#   endif
+#   if d_m3HasThreads
+    [c_waOp_atomic]   = M3OP( "0xFE", 0, c_m3Type_unknown,   d_emptyOpList,  Compile_LebPrefixedOpcode ),
+#   endif
 # endif
 
 # ifdef DEBUG
@@ -2590,7 +4001,8 @@ const M3OpInfo c_operationsFC [] =
     M3OP_F( "i64.trunc_s:sat/f64",0,  i_64,   d_convertOpList (i64_TruncSat_f64),        Compile_Convert ),  // 0x06
     M3OP_F( "i64.trunc_u:sat/f64",0,  i_64,   d_convertOpList (u64_TruncSat_f64),        Compile_Convert ),  // 0x07
 
-    M3OP_RESERVED, M3OP_RESERVED,
+    M3OP( "memory.init",            0,  none,   d_emptyOpList,                           Compile_Memory_InitDrop ), // 0x08
+    M3OP( "data.drop",              0,  none,   d_emptyOpList,                           Compile_Memory_InitDrop ), // 0x09
 
     M3OP( "memory.copy",            0,  none,   d_emptyOpList,                           Compile_Memory_CopyFill ), // 0x0a
     M3OP( "memory.fill",            0,  none,   d_emptyOpList,                           Compile_Memory_CopyFill ), // 0x0b
@@ -2601,6 +4013,361 @@ const M3OpInfo c_operationsFC [] =
 # endif
 };
 
+# if d_m3HasSIMD
+const M3OpInfo c_operationsFD [] =
+{
+    M3OP( "v128.load",                    0, v_128, d_unaryOpList (v128, Load),                   Compile_SimdLoadStore     ),  // 0x00
+    M3OP( "v128.load8x8_s",               0, v_128, d_unaryOpList (i16x8, Load_i8x8),             Compile_SimdLoadStore     ),  // 0x01
+    M3OP( "v128.load8x8_u",               0, v_128, d_unaryOpList (i16x8, Load_u8x8),             Compile_SimdLoadStore     ),  // 0x02
+    M3OP( "v128.load16x4_s",              0, v_128, d_unaryOpList (i32x4, Load_i16x4),            Compile_SimdLoadStore     ),  // 0x03
+    M3OP( "v128.load16x4_u",              0, v_128, d_unaryOpList (i32x4, Load_u16x4),            Compile_SimdLoadStore     ),  // 0x04
+    M3OP( "v128.load32x2_s",              0, v_128, d_unaryOpList (i64x2, Load_i32x2),            Compile_SimdLoadStore     ),  // 0x05
+    M3OP( "v128.load32x2_u",              0, v_128, d_unaryOpList (i64x2, Load_u32x2),            Compile_SimdLoadStore     ),  // 0x06
+    M3OP( "v128.load8_splat",             0, v_128, d_unaryOpList (i8x16, LoadSplat),             Compile_SimdLoadStore     ),  // 0x07
+    M3OP( "v128.load16_splat",            0, v_128, d_unaryOpList (i16x8, LoadSplat),             Compile_SimdLoadStore     ),  // 0x08
+    M3OP( "v128.load32_splat",            0, v_128, d_unaryOpList (i32x4, LoadSplat),             Compile_SimdLoadStore     ),  // 0x09
+    M3OP( "v128.load64_splat",            0, v_128, d_unaryOpList (i64x2, LoadSplat),             Compile_SimdLoadStore     ),  // 0x0a
+    M3OP( "v128.store",                  -2, none,  d_unaryOpList (v128, Store),                  Compile_SimdLoadStore     ),  // 0x0b
+    M3OP( "v128.const",                   1, v_128, d_logOp (Const128),                           Compile_SimdConst         ),  // 0x0c
+    M3OP( "i8x16.shuffle",               -1, v_128, d_simdOpList (i8x16, Shuffle),                Compile_SimdShuffle       ),  // 0x0d
+    M3OP( "i8x16.swizzle",               -1, v_128, d_simdOpList (i8x16, Swizzle),                Compile_SimdBinary        ),  // 0x0e
+    M3OP( "i8x16.splat",                  0, v_128, d_unaryOpList (i8x16, Splat),                 Compile_SimdSplat         ),  // 0x0f
+    M3OP( "i16x8.splat",                  0, v_128, d_unaryOpList (i16x8, Splat),                 Compile_SimdSplat         ),  // 0x10
+    M3OP( "i32x4.splat",                  0, v_128, d_unaryOpList (i32x4, Splat),                 Compile_SimdSplat         ),  // 0x11
+    M3OP( "i64x2.splat",                  0, v_128, d_unaryOpList (i64x2, Splat),                 Compile_SimdSplat         ),  // 0x12
+    M3OP( "f32x4.splat",                  0, v_128, d_unaryOpList (f32x4, Splat),                 Compile_SimdSplat         ),  // 0x13
+    M3OP( "f64x2.splat",                  0, v_128, d_unaryOpList (f64x2, Splat),                 Compile_SimdSplat         ),  // 0x14
+    M3OP( "i8x16.extract_lane_s",         0, i_32,  d_simdOpList (i8x16, ExtractLane),            Compile_SimdExtractLane   ),  // 0x15
+    M3OP( "i8x16.extract_lane_u",         0, i_32,  d_simdOpList (u8x16, ExtractLane),            Compile_SimdExtractLane   ),  // 0x16
+    M3OP( "i8x16.replace_lane",          -1, v_128, d_unaryOpList (i8x16, ReplaceLane),           Compile_SimdReplaceLane   ),  // 0x17
+    M3OP( "i16x8.extract_lane_s",         0, i_32,  d_simdOpList (i16x8, ExtractLane),            Compile_SimdExtractLane   ),  // 0x18
+    M3OP( "i16x8.extract_lane_u",         0, i_32,  d_simdOpList (u16x8, ExtractLane),            Compile_SimdExtractLane   ),  // 0x19
+    M3OP( "i16x8.replace_lane",          -1, v_128, d_unaryOpList (i16x8, ReplaceLane),           Compile_SimdReplaceLane   ),  // 0x1a
+    M3OP( "i32x4.extract_lane",           0, i_32,  d_simdOpList (i32x4, ExtractLane),            Compile_SimdExtractLane   ),  // 0x1b
+    M3OP( "i32x4.replace_lane",          -1, v_128, d_unaryOpList (i32x4, ReplaceLane),           Compile_SimdReplaceLane   ),  // 0x1c
+    M3OP( "i64x2.extract_lane",           0, i_64,  d_simdOpList (i64x2, ExtractLane),            Compile_SimdExtractLane   ),  // 0x1d
+    M3OP( "i64x2.replace_lane",          -1, v_128, d_unaryOpList (i64x2, ReplaceLane),           Compile_SimdReplaceLane   ),  // 0x1e
+    M3OP( "f32x4.extract_lane",           0, f_32,  d_simdOpList (f32x4, ExtractLane),            Compile_SimdExtractLane   ),  // 0x1f
+    M3OP( "f32x4.replace_lane",          -1, v_128, d_unaryOpList (f32x4, ReplaceLane),           Compile_SimdReplaceLane   ),  // 0x20
+    M3OP( "f64x2.extract_lane",           0, f_64,  d_simdOpList (f64x2, ExtractLane),            Compile_SimdExtractLane   ),  // 0x21
+    M3OP( "f64x2.replace_lane",          -1, v_128, d_unaryOpList (f64x2, ReplaceLane),           Compile_SimdReplaceLane   ),  // 0x22
+    M3OP( "i8x16.eq",                    -1, v_128, d_simdOpList (i8x16, Equal),                  Compile_SimdBinary        ),  // 0x23
+    M3OP( "i8x16.ne",                    -1, v_128, d_simdOpList (i8x16, NotEqual),               Compile_SimdBinary        ),  // 0x24
+    M3OP( "i8x16.lt_s",                  -1, v_128, d_simdOpList (i8x16, LessThan),               Compile_SimdBinary        ),  // 0x25
+    M3OP( "i8x16.lt_u",                  -1, v_128, d_simdOpList (u8x16, LessThan),               Compile_SimdBinary        ),  // 0x26
+    M3OP( "i8x16.gt_s",                  -1, v_128, d_simdOpList (i8x16, GreaterThan),            Compile_SimdBinary        ),  // 0x27
+    M3OP( "i8x16.gt_u",                  -1, v_128, d_simdOpList (u8x16, GreaterThan),            Compile_SimdBinary        ),  // 0x28
+    M3OP( "i8x16.le_s",                  -1, v_128, d_simdOpList (i8x16, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x29
+    M3OP( "i8x16.le_u",                  -1, v_128, d_simdOpList (u8x16, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x2a
+    M3OP( "i8x16.ge_s",                  -1, v_128, d_simdOpList (i8x16, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x2b
+    M3OP( "i8x16.ge_u",                  -1, v_128, d_simdOpList (u8x16, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x2c
+    M3OP( "i16x8.eq",                    -1, v_128, d_simdOpList (i16x8, Equal),                  Compile_SimdBinary        ),  // 0x2d
+    M3OP( "i16x8.ne",                    -1, v_128, d_simdOpList (i16x8, NotEqual),               Compile_SimdBinary        ),  // 0x2e
+    M3OP( "i16x8.lt_s",                  -1, v_128, d_simdOpList (i16x8, LessThan),               Compile_SimdBinary        ),  // 0x2f
+    M3OP( "i16x8.lt_u",                  -1, v_128, d_simdOpList (u16x8, LessThan),               Compile_SimdBinary        ),  // 0x30
+    M3OP( "i16x8.gt_s",                  -1, v_128, d_simdOpList (i16x8, GreaterThan),            Compile_SimdBinary        ),  // 0x31
+    M3OP( "i16x8.gt_u",                  -1, v_128, d_simdOpList (u16x8, GreaterThan),            Compile_SimdBinary        ),  // 0x32
+    M3OP( "i16x8.le_s",                  -1, v_128, d_simdOpList (i16x8, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x33
+    M3OP( "i16x8.le_u",                  -1, v_128, d_simdOpList (u16x8, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x34
+    M3OP( "i16x8.ge_s",                  -1, v_128, d_simdOpList (i16x8, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x35
+    M3OP( "i16x8.ge_u",                  -1, v_128, d_simdOpList (u16x8, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x36
+    M3OP( "i32x4.eq",                    -1, v_128, d_simdOpList (i32x4, Equal),                  Compile_SimdBinary        ),  // 0x37
+    M3OP( "i32x4.ne",                    -1, v_128, d_simdOpList (i32x4, NotEqual),               Compile_SimdBinary        ),  // 0x38
+    M3OP( "i32x4.lt_s",                  -1, v_128, d_simdOpList (i32x4, LessThan),               Compile_SimdBinary        ),  // 0x39
+    M3OP( "i32x4.lt_u",                  -1, v_128, d_simdOpList (u32x4, LessThan),               Compile_SimdBinary        ),  // 0x3a
+    M3OP( "i32x4.gt_s",                  -1, v_128, d_simdOpList (i32x4, GreaterThan),            Compile_SimdBinary        ),  // 0x3b
+    M3OP( "i32x4.gt_u",                  -1, v_128, d_simdOpList (u32x4, GreaterThan),            Compile_SimdBinary        ),  // 0x3c
+    M3OP( "i32x4.le_s",                  -1, v_128, d_simdOpList (i32x4, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x3d
+    M3OP( "i32x4.le_u",                  -1, v_128, d_simdOpList (u32x4, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x3e
+    M3OP( "i32x4.ge_s",                  -1, v_128, d_simdOpList (i32x4, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x3f
+    M3OP( "i32x4.ge_u",                  -1, v_128, d_simdOpList (u32x4, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x40
+    M3OP( "f32x4.eq",                    -1, v_128, d_simdOpList (f32x4, Equal),                  Compile_SimdBinary        ),  // 0x41
+    M3OP( "f32x4.ne",                    -1, v_128, d_simdOpList (f32x4, NotEqual),               Compile_SimdBinary        ),  // 0x42
+    M3OP( "f32x4.lt",                    -1, v_128, d_simdOpList (f32x4, LessThan),               Compile_SimdBinary        ),  // 0x43
+    M3OP( "f32x4.gt",                    -1, v_128, d_simdOpList (f32x4, GreaterThan),            Compile_SimdBinary        ),  // 0x44
+    M3OP( "f32x4.le",                    -1, v_128, d_simdOpList (f32x4, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x45
+    M3OP( "f32x4.ge",                    -1, v_128, d_simdOpList (f32x4, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x46
+    M3OP( "f64x2.eq",                    -1, v_128, d_simdOpList (f64x2, Equal),                  Compile_SimdBinary        ),  // 0x47
+    M3OP( "f64x2.ne",                    -1, v_128, d_simdOpList (f64x2, NotEqual),               Compile_SimdBinary        ),  // 0x48
+    M3OP( "f64x2.lt",                    -1, v_128, d_simdOpList (f64x2, LessThan),               Compile_SimdBinary        ),  // 0x49
+    M3OP( "f64x2.gt",                    -1, v_128, d_simdOpList (f64x2, GreaterThan),            Compile_SimdBinary        ),  // 0x4a
+    M3OP( "f64x2.le",                    -1, v_128, d_simdOpList (f64x2, LessThanOrEqual),        Compile_SimdBinary        ),  // 0x4b
+    M3OP( "f64x2.ge",                    -1, v_128, d_simdOpList (f64x2, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0x4c
+    M3OP( "v128.not",                     0, v_128, d_simdOpList (v128, Not),                     Compile_SimdUnary         ),  // 0x4d
+    M3OP( "v128.and",                    -1, v_128, d_simdOpList (v128, And),                     Compile_SimdBinary        ),  // 0x4e
+    M3OP( "v128.andnot",                 -1, v_128, d_simdOpList (v128, AndNot),                  Compile_SimdBinary        ),  // 0x4f
+    M3OP( "v128.or",                     -1, v_128, d_simdOpList (v128, Or),                      Compile_SimdBinary        ),  // 0x50
+    M3OP( "v128.xor",                    -1, v_128, d_simdOpList (v128, Xor),                     Compile_SimdBinary        ),  // 0x51
+    M3OP( "v128.bitselect",              -2, v_128, d_simdOpList (v128, BitSelect),               Compile_SimdBitSelect     ),  // 0x52
+    M3OP( "v128.any_true",                0, i_32,  d_simdOpList (v128, AnyTrue),                 Compile_SimdUnary         ),  // 0x53
+    M3OP( "v128.load8_lane",             -1, v_128, d_unaryOpList (i8x16, LoadLane),              Compile_SimdLoadStore     ),  // 0x54
+    M3OP( "v128.load16_lane",            -1, v_128, d_unaryOpList (i16x8, LoadLane),              Compile_SimdLoadStore     ),  // 0x55
+    M3OP( "v128.load32_lane",            -1, v_128, d_unaryOpList (i32x4, LoadLane),              Compile_SimdLoadStore     ),  // 0x56
+    M3OP( "v128.load64_lane",            -1, v_128, d_unaryOpList (i64x2, LoadLane),              Compile_SimdLoadStore     ),  // 0x57
+    M3OP( "v128.store8_lane",            -2, none,  d_unaryOpList (i8x16, StoreLane),             Compile_SimdLoadStore     ),  // 0x58
+    M3OP( "v128.store16_lane",           -2, none,  d_unaryOpList (i16x8, StoreLane),             Compile_SimdLoadStore     ),  // 0x59
+    M3OP( "v128.store32_lane",           -2, none,  d_unaryOpList (i32x4, StoreLane),             Compile_SimdLoadStore     ),  // 0x5a
+    M3OP( "v128.store64_lane",           -2, none,  d_unaryOpList (i64x2, StoreLane),             Compile_SimdLoadStore     ),  // 0x5b
+    M3OP( "v128.load32_zero",             0, v_128, d_unaryOpList (i32x4, LoadZero),              Compile_SimdLoadStore     ),  // 0x5c
+    M3OP( "v128.load64_zero",             0, v_128, d_unaryOpList (i64x2, LoadZero),              Compile_SimdLoadStore     ),  // 0x5d
+    M3OP( "f32x4.demote_f64x2_zero",      0, v_128, d_simdOpList (f32x4, DemoteZero_f64x2),       Compile_SimdUnary         ),  // 0x5e
+    M3OP( "f64x2.promote_low_f32x4",      0, v_128, d_simdOpList (f64x2, PromoteLow_f32x4),       Compile_SimdUnary         ),  // 0x5f
+    M3OP( "i8x16.abs",                    0, v_128, d_simdOpList (i8x16, Abs),                    Compile_SimdUnary         ),  // 0x60
+    M3OP( "i8x16.neg",                    0, v_128, d_simdOpList (i8x16, Negate),                 Compile_SimdUnary         ),  // 0x61
+    M3OP( "i8x16.popcnt",                 0, v_128, d_simdOpList (i8x16, Popcnt),                 Compile_SimdUnary         ),  // 0x62
+    M3OP( "i8x16.all_true",               0, i_32,  d_simdOpList (i8x16, AllTrue),                Compile_SimdUnary         ),  // 0x63
+    M3OP( "i8x16.bitmask",                0, i_32,  d_simdOpList (i8x16, Bitmask),                Compile_SimdUnary         ),  // 0x64
+    M3OP( "i8x16.narrow_i16x8_s",        -1, v_128, d_simdOpList (i8x16, Narrow_i16x8),           Compile_SimdBinary        ),  // 0x65
+    M3OP( "i8x16.narrow_i16x8_u",        -1, v_128, d_simdOpList (u8x16, Narrow_i16x8),           Compile_SimdBinary        ),  // 0x66
+    M3OP( "f32x4.ceil",                   0, v_128, d_simdOpList (f32x4, Ceil),                   Compile_SimdUnary         ),  // 0x67
+    M3OP( "f32x4.floor",                  0, v_128, d_simdOpList (f32x4, Floor),                  Compile_SimdUnary         ),  // 0x68
+    M3OP( "f32x4.trunc",                  0, v_128, d_simdOpList (f32x4, Trunc),                  Compile_SimdUnary         ),  // 0x69
+    M3OP( "f32x4.nearest",                0, v_128, d_simdOpList (f32x4, Nearest),                Compile_SimdUnary         ),  // 0x6a
+    M3OP( "i8x16.shl",                   -1, v_128, d_unaryOpList (i8x16, ShiftLeft),             Compile_SimdShift         ),  // 0x6b
+    M3OP( "i8x16.shr_s",                 -1, v_128, d_unaryOpList (i8x16, ShiftRight),            Compile_SimdShift         ),  // 0x6c
+    M3OP( "i8x16.shr_u",                 -1, v_128, d_unaryOpList (u8x16, ShiftRight),            Compile_SimdShift         ),  // 0x6d
+    M3OP( "i8x16.add",                   -1, v_128, d_simdOpList (i8x16, Add),                    Compile_SimdBinary        ),  // 0x6e
+    M3OP( "i8x16.add_sat_s",             -1, v_128, d_simdOpList (i8x16, AddSat),                 Compile_SimdBinary        ),  // 0x6f
+    M3OP( "i8x16.add_sat_u",             -1, v_128, d_simdOpList (u8x16, AddSat),                 Compile_SimdBinary        ),  // 0x70
+    M3OP( "i8x16.sub",                   -1, v_128, d_simdOpList (i8x16, Subtract),               Compile_SimdBinary        ),  // 0x71
+    M3OP( "i8x16.sub_sat_s",             -1, v_128, d_simdOpList (i8x16, SubtractSat),            Compile_SimdBinary        ),  // 0x72
+    M3OP( "i8x16.sub_sat_u",             -1, v_128, d_simdOpList (u8x16, SubtractSat),            Compile_SimdBinary        ),  // 0x73
+    M3OP( "f64x2.ceil",                   0, v_128, d_simdOpList (f64x2, Ceil),                   Compile_SimdUnary         ),  // 0x74
+    M3OP( "f64x2.floor",                  0, v_128, d_simdOpList (f64x2, Floor),                  Compile_SimdUnary         ),  // 0x75
+    M3OP( "i8x16.min_s",                 -1, v_128, d_simdOpList (i8x16, Min),                    Compile_SimdBinary        ),  // 0x76
+    M3OP( "i8x16.min_u",                 -1, v_128, d_simdOpList (u8x16, Min),                    Compile_SimdBinary        ),  // 0x77
+    M3OP( "i8x16.max_s",                 -1, v_128, d_simdOpList (i8x16, Max),                    Compile_SimdBinary        ),  // 0x78
+    M3OP( "i8x16.max_u",                 -1, v_128, d_simdOpList (u8x16, Max),                    Compile_SimdBinary        ),  // 0x79
+    M3OP( "f64x2.trunc",                  0, v_128, d_simdOpList (f64x2, Trunc),                  Compile_SimdUnary         ),  // 0x7a
+    M3OP( "i8x16.avgr_u",                -1, v_128, d_simdOpList (u8x16, AvgRound),               Compile_SimdBinary        ),  // 0x7b
+    M3OP( "i16x8.extadd_pairwise_i8x16_s",  0, v_128, d_simdOpList (i16x8, ExtAddPairwise_i8x16),   Compile_SimdUnary         ),  // 0x7c
+    M3OP( "i16x8.extadd_pairwise_i8x16_u",  0, v_128, d_simdOpList (i16x8, ExtAddPairwise_u8x16),   Compile_SimdUnary         ),  // 0x7d
+    M3OP( "i32x4.extadd_pairwise_i16x8_s",  0, v_128, d_simdOpList (i32x4, ExtAddPairwise_i16x8),   Compile_SimdUnary         ),  // 0x7e
+    M3OP( "i32x4.extadd_pairwise_i16x8_u",  0, v_128, d_simdOpList (i32x4, ExtAddPairwise_u16x8),   Compile_SimdUnary         ),  // 0x7f
+    M3OP( "i16x8.abs",                    0, v_128, d_simdOpList (i16x8, Abs),                    Compile_SimdUnary         ),  // 0x80
+    M3OP( "i16x8.neg",                    0, v_128, d_simdOpList (i16x8, Negate),                 Compile_SimdUnary         ),  // 0x81
+    M3OP( "i16x8.q15mulr_sat_s",         -1, v_128, d_simdOpList (i16x8, Q15MulRSat),             Compile_SimdBinary        ),  // 0x82
+    M3OP( "i16x8.all_true",               0, i_32,  d_simdOpList (i16x8, AllTrue),                Compile_SimdUnary         ),  // 0x83
+    M3OP( "i16x8.bitmask",                0, i_32,  d_simdOpList (i16x8, Bitmask),                Compile_SimdUnary         ),  // 0x84
+    M3OP( "i16x8.narrow_i32x4_s",        -1, v_128, d_simdOpList (i16x8, Narrow_i32x4),           Compile_SimdBinary        ),  // 0x85
+    M3OP( "i16x8.narrow_i32x4_u",        -1, v_128, d_simdOpList (u16x8, Narrow_i32x4),           Compile_SimdBinary        ),  // 0x86
+    M3OP( "i16x8.extend_low_i8x16_s",     0, v_128, d_simdOpList (i16x8, ExtendLow_i8x16),        Compile_SimdUnary         ),  // 0x87
+    M3OP( "i16x8.extend_high_i8x16_s",    0, v_128, d_simdOpList (i16x8, ExtendHigh_i8x16),       Compile_SimdUnary         ),  // 0x88
+    M3OP( "i16x8.extend_low_i8x16_u",     0, v_128, d_simdOpList (i16x8, ExtendLow_u8x16),        Compile_SimdUnary         ),  // 0x89
+    M3OP( "i16x8.extend_high_i8x16_u",    0, v_128, d_simdOpList (i16x8, ExtendHigh_u8x16),       Compile_SimdUnary         ),  // 0x8a
+    M3OP( "i16x8.shl",                   -1, v_128, d_unaryOpList (i16x8, ShiftLeft),             Compile_SimdShift         ),  // 0x8b
+    M3OP( "i16x8.shr_s",                 -1, v_128, d_unaryOpList (i16x8, ShiftRight),            Compile_SimdShift         ),  // 0x8c
+    M3OP( "i16x8.shr_u",                 -1, v_128, d_unaryOpList (u16x8, ShiftRight),            Compile_SimdShift         ),  // 0x8d
+    M3OP( "i16x8.add",                   -1, v_128, d_simdOpList (i16x8, Add),                    Compile_SimdBinary        ),  // 0x8e
+    M3OP( "i16x8.add_sat_s",             -1, v_128, d_simdOpList (i16x8, AddSat),                 Compile_SimdBinary        ),  // 0x8f
+    M3OP( "i16x8.add_sat_u",             -1, v_128, d_simdOpList (u16x8, AddSat),                 Compile_SimdBinary        ),  // 0x90
+    M3OP( "i16x8.sub",                   -1, v_128, d_simdOpList (i16x8, Subtract),               Compile_SimdBinary        ),  // 0x91
+    M3OP( "i16x8.sub_sat_s",             -1, v_128, d_simdOpList (i16x8, SubtractSat),            Compile_SimdBinary        ),  // 0x92
+    M3OP( "i16x8.sub_sat_u",             -1, v_128, d_simdOpList (u16x8, SubtractSat),            Compile_SimdBinary        ),  // 0x93
+    M3OP( "f64x2.nearest",                0, v_128, d_simdOpList (f64x2, Nearest),                Compile_SimdUnary         ),  // 0x94
+    M3OP( "i16x8.mul",                   -1, v_128, d_simdOpList (i16x8, Multiply),               Compile_SimdBinary        ),  // 0x95
+    M3OP( "i16x8.min_s",                 -1, v_128, d_simdOpList (i16x8, Min),                    Compile_SimdBinary        ),  // 0x96
+    M3OP( "i16x8.min_u",                 -1, v_128, d_simdOpList (u16x8, Min),                    Compile_SimdBinary        ),  // 0x97
+    M3OP( "i16x8.max_s",                 -1, v_128, d_simdOpList (i16x8, Max),                    Compile_SimdBinary        ),  // 0x98
+    M3OP( "i16x8.max_u",                 -1, v_128, d_simdOpList (u16x8, Max),                    Compile_SimdBinary        ),  // 0x99
+    M3OP_RESERVED,                                                                                // 0x9a
+    M3OP( "i16x8.avgr_u",                -1, v_128, d_simdOpList (u16x8, AvgRound),               Compile_SimdBinary        ),  // 0x9b
+    M3OP( "i16x8.extmul_low_i8x16_s",    -1, v_128, d_simdOpList (i16x8, ExtMulLow_i8x16),        Compile_SimdBinary        ),  // 0x9c
+    M3OP( "i16x8.extmul_high_i8x16_s",   -1, v_128, d_simdOpList (i16x8, ExtMulHigh_i8x16),       Compile_SimdBinary        ),  // 0x9d
+    M3OP( "i16x8.extmul_low_i8x16_u",    -1, v_128, d_simdOpList (i16x8, ExtMulLow_u8x16),        Compile_SimdBinary        ),  // 0x9e
+    M3OP( "i16x8.extmul_high_i8x16_u",   -1, v_128, d_simdOpList (i16x8, ExtMulHigh_u8x16),       Compile_SimdBinary        ),  // 0x9f
+    M3OP( "i32x4.abs",                    0, v_128, d_simdOpList (i32x4, Abs),                    Compile_SimdUnary         ),  // 0xa0
+    M3OP( "i32x4.neg",                    0, v_128, d_simdOpList (i32x4, Negate),                 Compile_SimdUnary         ),  // 0xa1
+    M3OP_RESERVED,                                                                                // 0xa2
+    M3OP( "i32x4.all_true",               0, i_32,  d_simdOpList (i32x4, AllTrue),                Compile_SimdUnary         ),  // 0xa3
+    M3OP( "i32x4.bitmask",                0, i_32,  d_simdOpList (i32x4, Bitmask),                Compile_SimdUnary         ),  // 0xa4
+    M3OP_RESERVED,                                                                                // 0xa5
+    M3OP_RESERVED,                                                                                // 0xa6
+    M3OP( "i32x4.extend_low_i16x8_s",     0, v_128, d_simdOpList (i32x4, ExtendLow_i16x8),        Compile_SimdUnary         ),  // 0xa7
+    M3OP( "i32x4.extend_high_i16x8_s",    0, v_128, d_simdOpList (i32x4, ExtendHigh_i16x8),       Compile_SimdUnary         ),  // 0xa8
+    M3OP( "i32x4.extend_low_i16x8_u",     0, v_128, d_simdOpList (i32x4, ExtendLow_u16x8),        Compile_SimdUnary         ),  // 0xa9
+    M3OP( "i32x4.extend_high_i16x8_u",    0, v_128, d_simdOpList (i32x4, ExtendHigh_u16x8),       Compile_SimdUnary         ),  // 0xaa
+    M3OP( "i32x4.shl",                   -1, v_128, d_unaryOpList (i32x4, ShiftLeft),             Compile_SimdShift         ),  // 0xab
+    M3OP( "i32x4.shr_s",                 -1, v_128, d_unaryOpList (i32x4, ShiftRight),            Compile_SimdShift         ),  // 0xac
+    M3OP( "i32x4.shr_u",                 -1, v_128, d_unaryOpList (u32x4, ShiftRight),            Compile_SimdShift         ),  // 0xad
+    M3OP( "i32x4.add",                   -1, v_128, d_simdOpList (i32x4, Add),                    Compile_SimdBinary        ),  // 0xae
+    M3OP_RESERVED,                                                                                // 0xaf
+    M3OP_RESERVED,                                                                                // 0xb0
+    M3OP( "i32x4.sub",                   -1, v_128, d_simdOpList (i32x4, Subtract),               Compile_SimdBinary        ),  // 0xb1
+    M3OP_RESERVED,                                                                                // 0xb2
+    M3OP_RESERVED,                                                                                // 0xb3
+    M3OP_RESERVED,                                                                                // 0xb4
+    M3OP( "i32x4.mul",                   -1, v_128, d_simdOpList (i32x4, Multiply),               Compile_SimdBinary        ),  // 0xb5
+    M3OP( "i32x4.min_s",                 -1, v_128, d_simdOpList (i32x4, Min),                    Compile_SimdBinary        ),  // 0xb6
+    M3OP( "i32x4.min_u",                 -1, v_128, d_simdOpList (u32x4, Min),                    Compile_SimdBinary        ),  // 0xb7
+    M3OP( "i32x4.max_s",                 -1, v_128, d_simdOpList (i32x4, Max),                    Compile_SimdBinary        ),  // 0xb8
+    M3OP( "i32x4.max_u",                 -1, v_128, d_simdOpList (u32x4, Max),                    Compile_SimdBinary        ),  // 0xb9
+    M3OP( "i32x4.dot_i16x8_s",           -1, v_128, d_simdOpList (i32x4, Dot_i16x8),              Compile_SimdBinary        ),  // 0xba
+    M3OP_RESERVED,                                                                                // 0xbb
+    M3OP( "i32x4.extmul_low_i16x8_s",    -1, v_128, d_simdOpList (i32x4, ExtMulLow_i16x8),        Compile_SimdBinary        ),  // 0xbc
+    M3OP( "i32x4.extmul_high_i16x8_s",   -1, v_128, d_simdOpList (i32x4, ExtMulHigh_i16x8),       Compile_SimdBinary        ),  // 0xbd
+    M3OP( "i32x4.extmul_low_i16x8_u",    -1, v_128, d_simdOpList (i32x4, ExtMulLow_u16x8),        Compile_SimdBinary        ),  // 0xbe
+    M3OP( "i32x4.extmul_high_i16x8_u",   -1, v_128, d_simdOpList (i32x4, ExtMulHigh_u16x8),       Compile_SimdBinary        ),  // 0xbf
+    M3OP( "i64x2.abs",                    0, v_128, d_simdOpList (i64x2, Abs),                    Compile_SimdUnary         ),  // 0xc0
+    M3OP( "i64x2.neg",                    0, v_128, d_simdOpList (i64x2, Negate),                 Compile_SimdUnary         ),  // 0xc1
+    M3OP_RESERVED,                                                                                // 0xc2
+    M3OP( "i64x2.all_true",               0, i_32,  d_simdOpList (i64x2, AllTrue),                Compile_SimdUnary         ),  // 0xc3
+    M3OP( "i64x2.bitmask",                0, i_32,  d_simdOpList (i64x2, Bitmask),                Compile_SimdUnary         ),  // 0xc4
+    M3OP_RESERVED,                                                                                // 0xc5
+    M3OP_RESERVED,                                                                                // 0xc6
+    M3OP( "i64x2.extend_low_i32x4_s",     0, v_128, d_simdOpList (i64x2, ExtendLow_i32x4),        Compile_SimdUnary         ),  // 0xc7
+    M3OP( "i64x2.extend_high_i32x4_s",    0, v_128, d_simdOpList (i64x2, ExtendHigh_i32x4),       Compile_SimdUnary         ),  // 0xc8
+    M3OP( "i64x2.extend_low_i32x4_u",     0, v_128, d_simdOpList (i64x2, ExtendLow_u32x4),        Compile_SimdUnary         ),  // 0xc9
+    M3OP( "i64x2.extend_high_i32x4_u",    0, v_128, d_simdOpList (i64x2, ExtendHigh_u32x4),       Compile_SimdUnary         ),  // 0xca
+    M3OP( "i64x2.shl",                   -1, v_128, d_unaryOpList (i64x2, ShiftLeft),             Compile_SimdShift         ),  // 0xcb
+    M3OP( "i64x2.shr_s",                 -1, v_128, d_unaryOpList (i64x2, ShiftRight),            Compile_SimdShift         ),  // 0xcc
+    M3OP( "i64x2.shr_u",                 -1, v_128, d_unaryOpList (u64x2, ShiftRight),            Compile_SimdShift         ),  // 0xcd
+    M3OP( "i64x2.add",                   -1, v_128, d_simdOpList (i64x2, Add),                    Compile_SimdBinary        ),  // 0xce
+    M3OP_RESERVED,                                                                                // 0xcf
+    M3OP_RESERVED,                                                                                // 0xd0
+    M3OP( "i64x2.sub",                   -1, v_128, d_simdOpList (i64x2, Subtract),               Compile_SimdBinary        ),  // 0xd1
+    M3OP_RESERVED,                                                                                // 0xd2
+    M3OP_RESERVED,                                                                                // 0xd3
+    M3OP_RESERVED,                                                                                // 0xd4
+    M3OP( "i64x2.mul",                   -1, v_128, d_simdOpList (i64x2, Multiply),               Compile_SimdBinary        ),  // 0xd5
+    M3OP( "i64x2.eq",                    -1, v_128, d_simdOpList (i64x2, Equal),                  Compile_SimdBinary        ),  // 0xd6
+    M3OP( "i64x2.ne",                    -1, v_128, d_simdOpList (i64x2, NotEqual),               Compile_SimdBinary        ),  // 0xd7
+    M3OP( "i64x2.lt_s",                  -1, v_128, d_simdOpList (i64x2, LessThan),               Compile_SimdBinary        ),  // 0xd8
+    M3OP( "i64x2.gt_s",                  -1, v_128, d_simdOpList (i64x2, GreaterThan),            Compile_SimdBinary        ),  // 0xd9
+    M3OP( "i64x2.le_s",                  -1, v_128, d_simdOpList (i64x2, LessThanOrEqual),        Compile_SimdBinary        ),  // 0xda
+    M3OP( "i64x2.ge_s",                  -1, v_128, d_simdOpList (i64x2, GreaterThanOrEqual),     Compile_SimdBinary        ),  // 0xdb
+    M3OP( "i64x2.extmul_low_i32x4_s",    -1, v_128, d_simdOpList (i64x2, ExtMulLow_i32x4),        Compile_SimdBinary        ),  // 0xdc
+    M3OP( "i64x2.extmul_high_i32x4_s",   -1, v_128, d_simdOpList (i64x2, ExtMulHigh_i32x4),       Compile_SimdBinary        ),  // 0xdd
+    M3OP( "i64x2.extmul_low_i32x4_u",    -1, v_128, d_simdOpList (i64x2, ExtMulLow_u32x4),        Compile_SimdBinary        ),  // 0xde
+    M3OP( "i64x2.extmul_high_i32x4_u",   -1, v_128, d_simdOpList (i64x2, ExtMulHigh_u32x4),       Compile_SimdBinary        ),  // 0xdf
+    M3OP( "f32x4.abs",                    0, v_128, d_simdOpList (f32x4, Abs),                    Compile_SimdUnary         ),  // 0xe0
+    M3OP( "f32x4.neg",                    0, v_128, d_simdOpList (f32x4, Negate),                 Compile_SimdUnary         ),  // 0xe1
+    M3OP_RESERVED,                                                                                // 0xe2
+    M3OP( "f32x4.sqrt",                   0, v_128, d_simdOpList (f32x4, Sqrt),                   Compile_SimdUnary         ),  // 0xe3
+    M3OP( "f32x4.add",                   -1, v_128, d_simdOpList (f32x4, Add),                    Compile_SimdBinary        ),  // 0xe4
+    M3OP( "f32x4.sub",                   -1, v_128, d_simdOpList (f32x4, Subtract),               Compile_SimdBinary        ),  // 0xe5
+    M3OP( "f32x4.mul",                   -1, v_128, d_simdOpList (f32x4, Multiply),               Compile_SimdBinary        ),  // 0xe6
+    M3OP( "f32x4.div",                   -1, v_128, d_simdOpList (f32x4, Divide),                 Compile_SimdBinary        ),  // 0xe7
+    M3OP( "f32x4.min",                   -1, v_128, d_simdOpList (f32x4, Min),                    Compile_SimdBinary        ),  // 0xe8
+    M3OP( "f32x4.max",                   -1, v_128, d_simdOpList (f32x4, Max),                    Compile_SimdBinary        ),  // 0xe9
+    M3OP( "f32x4.pmin",                  -1, v_128, d_simdOpList (f32x4, PseudoMin),              Compile_SimdBinary        ),  // 0xea
+    M3OP( "f32x4.pmax",                  -1, v_128, d_simdOpList (f32x4, PseudoMax),              Compile_SimdBinary        ),  // 0xeb
+    M3OP( "f64x2.abs",                    0, v_128, d_simdOpList (f64x2, Abs),                    Compile_SimdUnary         ),  // 0xec
+    M3OP( "f64x2.neg",                    0, v_128, d_simdOpList (f64x2, Negate),                 Compile_SimdUnary         ),  // 0xed
+    M3OP_RESERVED,                                                                                // 0xee
+    M3OP( "f64x2.sqrt",                   0, v_128, d_simdOpList (f64x2, Sqrt),                   Compile_SimdUnary         ),  // 0xef
+    M3OP( "f64x2.add",                   -1, v_128, d_simdOpList (f64x2, Add),                    Compile_SimdBinary        ),  // 0xf0
+    M3OP( "f64x2.sub",                   -1, v_128, d_simdOpList (f64x2, Subtract),               Compile_SimdBinary        ),  // 0xf1
+    M3OP( "f64x2.mul",                   -1, v_128, d_simdOpList (f64x2, Multiply),               Compile_SimdBinary        ),  // 0xf2
+    M3OP( "f64x2.div",                   -1, v_128, d_simdOpList (f64x2, Divide),                 Compile_SimdBinary        ),  // 0xf3
+    M3OP( "f64x2.min",                   -1, v_128, d_simdOpList (f64x2, Min),                    Compile_SimdBinary        ),  // 0xf4
+    M3OP( "f64x2.max",                   -1, v_128, d_simdOpList (f64x2, Max),                    Compile_SimdBinary        ),  // 0xf5
+    M3OP( "f64x2.pmin",                  -1, v_128, d_simdOpList (f64x2, PseudoMin),              Compile_SimdBinary        ),  // 0xf6
+    M3OP( "f64x2.pmax",                  -1, v_128, d_simdOpList (f64x2, PseudoMax),              Compile_SimdBinary        ),  // 0xf7
+    M3OP( "i32x4.trunc_sat_f32x4_s",      0, v_128, d_simdOpList (i32x4, TruncSat_f32x4),         Compile_SimdUnary         ),  // 0xf8
+    M3OP( "i32x4.trunc_sat_f32x4_u",      0, v_128, d_simdOpList (u32x4, TruncSat_f32x4),         Compile_SimdUnary         ),  // 0xf9
+    M3OP( "f32x4.convert_i32x4_s",        0, v_128, d_simdOpList (f32x4, Convert_i32x4),          Compile_SimdUnary         ),  // 0xfa
+    M3OP( "f32x4.convert_i32x4_u",        0, v_128, d_simdOpList (f32x4, Convert_u32x4),          Compile_SimdUnary         ),  // 0xfb
+    M3OP( "i32x4.trunc_sat_f64x2_s_zero",  0, v_128, d_simdOpList (i32x4, TruncSatZero_f64x2),     Compile_SimdUnary         ),  // 0xfc
+    M3OP( "i32x4.trunc_sat_f64x2_u_zero",  0, v_128, d_simdOpList (u32x4, TruncSatZero_f64x2),     Compile_SimdUnary         ),  // 0xfd
+    M3OP( "f64x2.convert_low_i32x4_s",    0, v_128, d_simdOpList (f64x2, ConvertLow_i32x4),       Compile_SimdUnary         ),  // 0xfe
+    M3OP( "f64x2.convert_low_i32x4_u",    0, v_128, d_simdOpList (f64x2, ConvertLow_u32x4),       Compile_SimdUnary         ),  // 0xff
+
+# ifdef DEBUG
+    M3OP( "termination", 0, c_m3Type_unknown ) // for find_operation_info
+# endif
+};
+# endif
+
+# if d_m3HasThreads
+const M3OpInfo c_operationsFE [] =
+{
+    M3OP( "memory.atomic.notify",        -1, i_32, { op_MemoryAtomicNotify },              Compile_Atomic ),  // 0x00
+    M3OP( "memory.atomic.wait32",        -2, i_32, { op_MemoryAtomicWait_u32 },            Compile_Atomic ),  // 0x01
+    M3OP( "memory.atomic.wait64",        -2, i_32, { op_MemoryAtomicWait_u64 },            Compile_Atomic ),  // 0x02
+    M3OP( "atomic.fence",                 0, none, { op_AtomicFence },                     Compile_Atomic ),  // 0x03
+
+    M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED,                              // 0x04 - 0x09
+    M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED, M3OP_RESERVED,                              // 0x0a - 0x0f
+
+    M3OP( "i32.atomic.load",              0, i_32, d_atomicOpList (i32, AtomicLoad_u32),   Compile_Atomic ),  // 0x10
+    M3OP( "i64.atomic.load",              0, i_64, d_atomicOpList (i64, AtomicLoad_u64),   Compile_Atomic ),  // 0x11
+    M3OP( "i32.atomic.load8_u",           0, i_32, d_atomicOpList (i32, AtomicLoad_u8),    Compile_Atomic ),  // 0x12
+    M3OP( "i32.atomic.load16_u",          0, i_32, d_atomicOpList (i32, AtomicLoad_u16),   Compile_Atomic ),  // 0x13
+    M3OP( "i64.atomic.load8_u",           0, i_64, d_atomicOpList (i64, AtomicLoad_u8),    Compile_Atomic ),  // 0x14
+    M3OP( "i64.atomic.load16_u",          0, i_64, d_atomicOpList (i64, AtomicLoad_u16),   Compile_Atomic ),  // 0x15
+    M3OP( "i64.atomic.load32_u",          0, i_64, d_atomicOpList (i64, AtomicLoad_u32),   Compile_Atomic ),  // 0x16
+
+    M3OP( "i32.atomic.store",            -2, none, d_atomicOpList (i32, AtomicStore_u32),  Compile_Atomic ),  // 0x17
+    M3OP( "i64.atomic.store",            -2, none, d_atomicOpList (i64, AtomicStore_u64),  Compile_Atomic ),  // 0x18
+    M3OP( "i32.atomic.store8",           -2, none, d_atomicOpList (i32, AtomicStore_u8),   Compile_Atomic ),  // 0x19
+    M3OP( "i32.atomic.store16",          -2, none, d_atomicOpList (i32, AtomicStore_u16),  Compile_Atomic ),  // 0x1a
+    M3OP( "i64.atomic.store8",           -2, none, d_atomicOpList (i64, AtomicStore_u8),   Compile_Atomic ),  // 0x1b
+    M3OP( "i64.atomic.store16",          -2, none, d_atomicOpList (i64, AtomicStore_u16),  Compile_Atomic ),  // 0x1c
+    M3OP( "i64.atomic.store32",          -2, none, d_atomicOpList (i64, AtomicStore_u32),  Compile_Atomic ),  // 0x1d
+
+    M3OP( "i32.atomic.rmw.add",          -1, i_32, d_atomicOpList (i32, AtomicAdd_u32),    Compile_Atomic ),  // 0x1e
+    M3OP( "i64.atomic.rmw.add",          -1, i_64, d_atomicOpList (i64, AtomicAdd_u64),    Compile_Atomic ),  // 0x1f
+    M3OP( "i32.atomic.rmw8.add_u",       -1, i_32, d_atomicOpList (i32, AtomicAdd_u8),     Compile_Atomic ),  // 0x20
+    M3OP( "i32.atomic.rmw16.add_u",      -1, i_32, d_atomicOpList (i32, AtomicAdd_u16),    Compile_Atomic ),  // 0x21
+    M3OP( "i64.atomic.rmw8.add_u",       -1, i_64, d_atomicOpList (i64, AtomicAdd_u8),     Compile_Atomic ),  // 0x22
+    M3OP( "i64.atomic.rmw16.add_u",      -1, i_64, d_atomicOpList (i64, AtomicAdd_u16),    Compile_Atomic ),  // 0x23
+    M3OP( "i64.atomic.rmw32.add_u",      -1, i_64, d_atomicOpList (i64, AtomicAdd_u32),    Compile_Atomic ),  // 0x24
+
+    M3OP( "i32.atomic.rmw.sub",          -1, i_32, d_atomicOpList (i32, AtomicSub_u32),    Compile_Atomic ),  // 0x25
+    M3OP( "i64.atomic.rmw.sub",          -1, i_64, d_atomicOpList (i64, AtomicSub_u64),    Compile_Atomic ),  // 0x26
+    M3OP( "i32.atomic.rmw8.sub_u",       -1, i_32, d_atomicOpList (i32, AtomicSub_u8),     Compile_Atomic ),  // 0x27
+    M3OP( "i32.atomic.rmw16.sub_u",      -1, i_32, d_atomicOpList (i32, AtomicSub_u16),    Compile_Atomic ),  // 0x28
+    M3OP( "i64.atomic.rmw8.sub_u",       -1, i_64, d_atomicOpList (i64, AtomicSub_u8),     Compile_Atomic ),  // 0x29
+    M3OP( "i64.atomic.rmw16.sub_u",      -1, i_64, d_atomicOpList (i64, AtomicSub_u16),    Compile_Atomic ),  // 0x2a
+    M3OP( "i64.atomic.rmw32.sub_u",      -1, i_64, d_atomicOpList (i64, AtomicSub_u32),    Compile_Atomic ),  // 0x2b
+
+    M3OP( "i32.atomic.rmw.and",          -1, i_32, d_atomicOpList (i32, AtomicAnd_u32),    Compile_Atomic ),  // 0x2c
+    M3OP( "i64.atomic.rmw.and",          -1, i_64, d_atomicOpList (i64, AtomicAnd_u64),    Compile_Atomic ),  // 0x2d
+    M3OP( "i32.atomic.rmw8.and_u",       -1, i_32, d_atomicOpList (i32, AtomicAnd_u8),     Compile_Atomic ),  // 0x2e
+    M3OP( "i32.atomic.rmw16.and_u",      -1, i_32, d_atomicOpList (i32, AtomicAnd_u16),    Compile_Atomic ),  // 0x2f
+    M3OP( "i64.atomic.rmw8.and_u",       -1, i_64, d_atomicOpList (i64, AtomicAnd_u8),     Compile_Atomic ),  // 0x30
+    M3OP( "i64.atomic.rmw16.and_u",      -1, i_64, d_atomicOpList (i64, AtomicAnd_u16),    Compile_Atomic ),  // 0x31
+    M3OP( "i64.atomic.rmw32.and_u",      -1, i_64, d_atomicOpList (i64, AtomicAnd_u32),    Compile_Atomic ),  // 0x32
+
+    M3OP( "i32.atomic.rmw.or",           -1, i_32, d_atomicOpList (i32, AtomicOr_u32),     Compile_Atomic ),  // 0x33
+    M3OP( "i64.atomic.rmw.or",           -1, i_64, d_atomicOpList (i64, AtomicOr_u64),     Compile_Atomic ),  // 0x34
+    M3OP( "i32.atomic.rmw8.or_u",        -1, i_32, d_atomicOpList (i32, AtomicOr_u8),      Compile_Atomic ),  // 0x35
+    M3OP( "i32.atomic.rmw16.or_u",       -1, i_32, d_atomicOpList (i32, AtomicOr_u16),     Compile_Atomic ),  // 0x36
+    M3OP( "i64.atomic.rmw8.or_u",        -1, i_64, d_atomicOpList (i64, AtomicOr_u8),      Compile_Atomic ),  // 0x37
+    M3OP( "i64.atomic.rmw16.or_u",       -1, i_64, d_atomicOpList (i64, AtomicOr_u16),     Compile_Atomic ),  // 0x38
+    M3OP( "i64.atomic.rmw32.or_u",       -1, i_64, d_atomicOpList (i64, AtomicOr_u32),     Compile_Atomic ),  // 0x39
+
+    M3OP( "i32.atomic.rmw.xor",          -1, i_32, d_atomicOpList (i32, AtomicXor_u32),    Compile_Atomic ),  // 0x3a
+    M3OP( "i64.atomic.rmw.xor",          -1, i_64, d_atomicOpList (i64, AtomicXor_u64),    Compile_Atomic ),  // 0x3b
+    M3OP( "i32.atomic.rmw8.xor_u",       -1, i_32, d_atomicOpList (i32, AtomicXor_u8),     Compile_Atomic ),  // 0x3c
+    M3OP( "i32.atomic.rmw16.xor_u",      -1, i_32, d_atomicOpList (i32, AtomicXor_u16),    Compile_Atomic ),  // 0x3d
+    M3OP( "i64.atomic.rmw8.xor_u",       -1, i_64, d_atomicOpList (i64, AtomicXor_u8),     Compile_Atomic ),  // 0x3e
+    M3OP( "i64.atomic.rmw16.xor_u",      -1, i_64, d_atomicOpList (i64, AtomicXor_u16),    Compile_Atomic ),  // 0x3f
+    M3OP( "i64.atomic.rmw32.xor_u",      -1, i_64, d_atomicOpList (i64, AtomicXor_u32),    Compile_Atomic ),  // 0x40
+
+    M3OP( "i32.atomic.rmw.xchg",         -1, i_32, d_atomicOpList (i32, AtomicXchg_u32),   Compile_Atomic ),  // 0x41
+    M3OP( "i64.atomic.rmw.xchg",         -1, i_64, d_atomicOpList (i64, AtomicXchg_u64),   Compile_Atomic ),  // 0x42
+    M3OP( "i32.atomic.rmw8.xchg_u",      -1, i_32, d_atomicOpList (i32, AtomicXchg_u8),    Compile_Atomic ),  // 0x43
+    M3OP( "i32.atomic.rmw16.xchg_u",     -1, i_32, d_atomicOpList (i32, AtomicXchg_u16),   Compile_Atomic ),  // 0x44
+    M3OP( "i64.atomic.rmw8.xchg_u",      -1, i_64, d_atomicOpList (i64, AtomicXchg_u8),    Compile_Atomic ),  // 0x45
+    M3OP( "i64.atomic.rmw16.xchg_u",     -1, i_64, d_atomicOpList (i64, AtomicXchg_u16),   Compile_Atomic ),  // 0x46
+    M3OP( "i64.atomic.rmw32.xchg_u",     -1, i_64, d_atomicOpList (i64, AtomicXchg_u32),   Compile_Atomic ),  // 0x47
+
+    M3OP( "i32.atomic.rmw.cmpxchg",      -2, i_32, d_atomicOpList (i32, AtomicCmpxchg_u32),Compile_Atomic ),  // 0x48
+    M3OP( "i64.atomic.rmw.cmpxchg",      -2, i_64, d_atomicOpList (i64, AtomicCmpxchg_u64),Compile_Atomic ),  // 0x49
+    M3OP( "i32.atomic.rmw8.cmpxchg_u",   -2, i_32, d_atomicOpList (i32, AtomicCmpxchg_u8), Compile_Atomic ),  // 0x4a
+    M3OP( "i32.atomic.rmw16.cmpxchg_u",  -2, i_32, d_atomicOpList (i32, AtomicCmpxchg_u16),Compile_Atomic ),  // 0x4b
+    M3OP( "i64.atomic.rmw8.cmpxchg_u",   -2, i_64, d_atomicOpList (i64, AtomicCmpxchg_u8), Compile_Atomic ),  // 0x4c
+    M3OP( "i64.atomic.rmw16.cmpxchg_u",  -2, i_64, d_atomicOpList (i64, AtomicCmpxchg_u16),Compile_Atomic ),  // 0x4d
+    M3OP( "i64.atomic.rmw32.cmpxchg_u",  -2, i_64, d_atomicOpList (i64, AtomicCmpxchg_u32),Compile_Atomic ),  // 0x4e
+
+# ifdef DEBUG
+    M3OP( "termination", 0, c_m3Type_unknown ) // for find_operation_info
+# endif
+};
+# endif
+
 
 IM3OpInfo  GetOpInfo  (m3opcode_t opcode)
 {
@@ -2616,6 +4383,22 @@ IM3OpInfo  GetOpInfo  (m3opcode_t opcode)
             return &c_operationsFC[opcode];
         }
         break;
+# if d_m3HasThreads
+    case c_waOp_atomic:
+        opcode &= 0xFF;
+        if (M3_LIKELY(opcode < M3_COUNT_OF(c_operationsFE))) {
+            return &c_operationsFE[opcode];
+        }
+        break;
+# endif
+# if d_m3HasSIMD
+    case c_waOp_simd:
+        opcode &= 0xFF;
+        if (M3_LIKELY(opcode < M3_COUNT_OF(c_operationsFD))) {
+            return &c_operationsFD[opcode];
+        }
+        break;
+# endif
     }
     return NULL;
 }
@@ -2648,12 +4431,21 @@ _       (Read_opcode (& opcode, & o->wasm, o->wasmEnd));                log_opco
             case c_waOp_i32_const: case c_waOp_i64_const:
             case c_waOp_f32_const: case c_waOp_f64_const:
             case c_waOp_getGlobal: case c_waOp_end:
+# if d_m3HasSIMD && d_m3CascadedOpcodes
+            case c_waOp_simd:                                   // Compile_LebPrefixedOpcode lets only v128.const through
+# elif d_m3HasSIMD
+            case (c_waOp_simd << 8) | c_waOp_v128_const:
+# endif
                 break;
             default:
                 _throw(m3Err_restrictedOpcode);
             }
         }
 
+        // dead code (after a br, return or unreachable) doesn't cost anything
+        if (o->gasCosts and not IsStackPolymorphic (o))
+            ChargeGas (o, opcode);
+
         IM3OpInfo opinfo = GetOpInfo (opcode);
 
         if (opinfo == NULL)
@@ -2797,6 +4589,14 @@ _           (PopType (o, type));
 
     //--------------------------------------------------------
 
+    if (i_blockOpcode == c_waOp_loop or i_blockOpcode == c_waOp_if or i_blockOpcode == c_waOp_else)
+_       (StartGasSegment (o));
+
+#if d_m3HasJit
+    if (i_blockOpcode == c_waOp_loop)
+_       (EmitHotnessCount (o));
+#endif
+
 _   (CompileBlockStatements (o));
 
 _   (ValidateBlockEnd (o));
@@ -2815,10 +4615,16 @@ _           (PushBlockResults (o));
         }
     }
 
+    // what follows a loop mustn't be charged with each iteration. (Compile_If starts the segment after an if.)
+    bool isNewSegment = (o->block.patches or o->block.isPolymorphic or i_blockOpcode == c_waOp_loop);
+
     PatchBranches (o);
 
     o->block = outerScope;
 
+    if (isNewSegment and i_blockOpcode != c_waOp_if and i_blockOpcode != c_waOp_else)
+_       (StartGasSegment (o));
+
 }   _catch: return result;
 }
 
@@ -2827,6 +4633,7 @@ M3Result  CompileLocals  (IM3Compilation o)
 {
     M3Result result;
 
+    u32 numArgs = o->stackIndex;                    // they've been pushed already
     u32 numLocals = 0;
     u32 numLocalBlocks;
 _   (ReadLEB_u32 (& numLocalBlocks, & o->wasm, o->wasmEnd));
@@ -2848,6 +4655,13 @@ _           (PushAllocatedSlot (o, localType));
     if (o->function)
         o->function->numLocals = numLocals;
 
+    // the args are written by the caller
+    memset (o->localAssigned, true, numArgs);
+    memset (o->localAssigned + numArgs, false, numLocals);
+
+    o->slotFirstZeroedLocal = c_slotUnused;
+    o->slotMaxZeroedLocal = 0;
+
     _catch: return result;
 }
 
@@ -2870,6 +4684,10 @@ M3Result  ReserveConstants  (IM3Compilation o)
             addSlots = 1;
         else if (code == c_waOp_i64_const or code == c_waOp_f64_const)
             addSlots = GetTypeNumSlots (c_m3Type_i64);
+#   if d_m3HasSIMD
+        else if (code == c_waOp_simd and wa < o->wasmEnd and * wa == c_waOp_v128_const)
+            addSlots = GetTypeNumSlots (c_m3Type_v128);
+#   endif
 
         if (numConstantSlots + addSlots >= d_m3MaxConstantTableSize)
             break;
@@ -2893,23 +4711,22 @@ M3Result  ReserveConstants  (IM3Compilation o)
 }
 
 
-M3Result  CompileFunction  (IM3Function io_function)
+M3Result  CompileFunctionWithContext  (IM3Compilation o, IM3Function io_function)
 {
     if (!io_function->wasm) return "function body is missing";
 
     IM3FuncType funcType = io_function->funcType;                   m3log (compile, "compiling: [%d] %s %s; wasm-size: %d",
                                                                         io_function->index, m3_GetFunctionName (io_function), SPrintFuncTypeSignature (funcType), (u32) (io_function->wasmEnd - io_function->wasm));
-    IM3Runtime runtime = io_function->module->runtime;
-
-    IM3Compilation o = & runtime->compilation;                      d_m3Assert (d_m3MaxFunctionSlots >= d_m3MaxFunctionStackHeight * (d_m3Use32BitSlots + 1))  // need twice as many slots in 32-bit mode
-    memset (o, 0x0, sizeof (M3Compilation));
-
-    o->runtime  = runtime;
+                                                                    d_m3Assert (d_m3MaxFunctionSlots >= d_m3MaxFunctionStackHeight * (d_m3Use32BitSlots + 1))  // need twice as many slots in 32-bit mode
     o->module   = io_function->module;
     o->function = io_function;
     o->wasm     = io_function->wasm;
     o->wasmEnd  = io_function->wasmEnd;
     o->block.type = funcType;
+    o->fusionPC = NULL;
+    o->gasCosts = o->module->environment->gasCosts;
+    o->gasCharge = NULL;
+    o->gasCost = 0;
 
 _try {
     // skip over code size. the end was already calculated during parse phase
@@ -2920,7 +4737,9 @@ _   (AcquireCompilationCodePage (o, & o->page));
 
     pc_t pc = GetPagePC (o->page);
 
-    u16 numRetSlots = GetFunctionNumReturns (o->function) * c_ioSlotCount;
+    u16 numRetSlots = 0;
+    for (u16 i = 0; i < GetFunctionNumReturns (o->function); ++i)
+        numRetSlots += GetTypeNumIOSlots (GetFuncTypeResultType (funcType, i));
 
     for (u16 i = 0; i < numRetSlots; ++i)
         MarkSlotAllocated (o, i);
@@ -2933,10 +4752,14 @@ _   (AcquireCompilationCodePage (o, & o->page));
     for (u16 i = 0; i < numArgs; ++i)
     {
         u8 type = GetFunctionArgType (o->function, i);
-_       (PushAllocatedSlot (o, type));
+
+        // args are packed by the caller, so a v128 arg isn't necessarily aligned like an allocated v128 slot
+        u16 slot = o->slotFirstDynamicIndex;
+        MarkSlotsAllocatedByType (o, slot, type);
+_       (Push (o, type, slot));
 
         // prevent allocator fill-in
-        o->slotFirstDynamicIndex += c_ioSlotCount;
+        o->slotFirstDynamicIndex += GetTypeNumIOSlots (type);
     }
 
     o->slotMaxAllocatedIndexPlusOne = o->function->numRetAndArgSlots = o->slotFirstLocalIndex = o->slotFirstDynamicIndex;
@@ -2957,17 +4780,36 @@ _   (ReserveConstants (o));
 
     o->block.blockStackIndex = o->stackFirstDynamicIndex = o->stackIndex;                           m3log (compile, "start stack index: %d",
                                                                                                           (u32) o->stackFirstDynamicIndex);
+    // op_ReturnCall enters the body directly after op_Entry, so the two mustn't be split by a page bridge
+_   (EnsureCodePageNumLines (o, d_m3CodePageFreeLinesThreshold));
+    pc = GetPC (o);
+
 _   (EmitOp (o, op_Entry));
     EmitPointer (o, io_function);
 
+#if d_m3HasJit
+_   (EmitHotnessCount (o));
+#endif
+
+_   (StartGasSegment (o));
+
 _   (CompileBlockStatements (o));
 
+    FinishGasSegment (o);
+
     // TODO: validate opcode sequences
     _throwif(m3Err_wasmMalformed, o->previousOpcode != c_waOp_end);
 
     io_function->compiled = pc;
     io_function->maxStackSlots = o->maxStackSlots;
 
+    if (o->slotMaxZeroedLocal > o->slotFirstZeroedLocal)
+    {
+        io_function->firstZeroedLocalByte = (o->slotFirstZeroedLocal - o->slotFirstLocalIndex) * sizeof (m3slot_t);
+        io_function->numZeroedLocalBytes = (o->slotMaxZeroedLocal - o->slotFirstZeroedLocal) * sizeof (m3slot_t);
+    }
+    else io_function->firstZeroedLocalByte = io_function->numZeroedLocalBytes = 0;
+
     u16 numConstantSlots = o->slotMaxConstIndex - o->slotFirstConstIndex;                           m3log (compile, "unique constant slots: %d; unused slots: %d",
                                                                                                            numConstantSlots, o->slotFirstDynamicIndex - o->slotMaxConstIndex);
     io_function->numConstantBytes = numConstantSlots * sizeof (m3slot_t);
@@ -2984,3 +4826,75 @@ _   (CompileBlockStatements (o));
 
     return result;
 }
+
+
+M3Result  CompileFunction  (IM3Function io_function)
+{
+    // an import gets its module (and its code) when it's linked; a call through the table can still reach one that wasn't
+    if (not io_function->module)
+        return m3Err_functionImportMissing;
+
+    IM3Runtime runtime = io_function->module->runtime;
+
+    IM3Compilation o = Environment_AcquireCompilation (runtime->environment);
+    if (not o)
+        return m3Err_mallocFailed;
+
+    o->runtime = runtime;
+
+    // template code is run by instances on any thread, so it mustn't be left to op_Compile to rewrite; see m3_CompileModule
+    u32 numTemplateCalls = runtime->templateCalls.numSites;
+    if (io_function->module->isTemplate)
+        o->deferredCalls = & runtime->templateCalls;
+
+    M3Result result = CompileFunctionWithContext (o, io_function);
+
+    // the sites of code that failed to compile may be in lines that are reused
+    if (result)
+        runtime->templateCalls.numSites = numTemplateCalls;
+
+    Environment_ReleaseCompilation (runtime->environment, o);
+
+#if d_m3HasJit
+    if (not result and runtime->jit)
+        TranslateFunction (io_function);
+#endif
+
+    return result;
+}
+
+
+#if d_m3HasJit
+void  TierUpFunction  (IM3Function io_function)
+{
+    pc_t entry              = io_function->compiled;
+    void * constants        = io_function->constants;
+    u16 numConstantBytes    = io_function->numConstantBytes;
+    u16 maxStackSlots       = io_function->maxStackSlots;
+
+    // once is enough: a function that fails to recompile just stays counted
+    io_function->tier = 1;
+
+    io_function->constants = NULL;
+
+    M3Result result = CompileFunction (io_function);
+
+    if (not result)
+    {                                                                       m3log (runtime, "tiered up %s after %u",
+                                                                                   m3_GetFunctionName (io_function), io_function->hotness);
+        m3_Free (constants);
+
+        // frames already running the old code finish in it. calls that still go to it are forwarded to the new code
+        * (void * volatile *) entry = (void *) op_Recompiled;
+    }
+    else
+    {
+        m3_Free (io_function->constants);
+
+        io_function->compiled           = entry;
+        io_function->constants          = constants;
+        io_function->numConstantBytes   = numConstantBytes;
+        io_function->maxStackSlots      = maxStackSlots;
+    }
+}
+#endif
@@ -31,6 +31,8 @@ enum
     c_waOp_branchTable          = 0x0e,
     c_waOp_branchIf             = 0x0d,
     c_waOp_call                 = 0x10,
+    c_waOp_returnCall           = 0x12,
+    c_waOp_returnCallIndirect   = 0x13,
     c_waOp_getLocal             = 0x20,
     c_waOp_setLocal             = 0x21,
     c_waOp_teeLocal             = 0x22,
@@ -45,10 +47,36 @@ enum
     c_waOp_f32_const            = 0x43,
     c_waOp_f64_const            = 0x44,
 
+    c_waOp_i32_mul              = 0x6c,
+    c_waOp_i32_div_s            = 0x6d,
+    c_waOp_i32_div_u            = 0x6e,
+    c_waOp_i32_rem_s            = 0x6f,
+    c_waOp_i32_rem_u            = 0x70,
+    c_waOp_i32_and              = 0x71,
+    c_waOp_i32_shl              = 0x74,
+    c_waOp_i32_shr_u            = 0x76,
+
+    c_waOp_i64_mul              = 0x7e,
+    c_waOp_i64_div_s            = 0x7f,
+    c_waOp_i64_div_u            = 0x80,
+    c_waOp_i64_rem_s            = 0x81,
+    c_waOp_i64_rem_u            = 0x82,
+    c_waOp_i64_and              = 0x83,
+    c_waOp_i64_shl              = 0x86,
+    c_waOp_i64_shr_u            = 0x88,
+
     c_waOp_extended             = 0xfc,
+    c_waOp_simd                 = 0xfd,
+    c_waOp_atomic               = 0xfe,
 
+    c_waOp_memoryInit           = 0xfc08,
+    c_waOp_dataDrop             = 0xfc09,
     c_waOp_memoryCopy           = 0xfc0a,
-    c_waOp_memoryFill           = 0xfc0b
+    c_waOp_memoryFill           = 0xfc0b,
+
+    c_waOp_atomicFence          = 0xfe03,
+
+    c_waOp_v128_const           = 0x0c      // 0xfd prefixed
 };
 
 
@@ -75,8 +103,28 @@ M3CompilationScope;
 
 typedef M3CompilationScope *        IM3CompilationScope;
 
-typedef struct
+// locations in the code stream that are revisited once compilation has finished
+typedef struct M3CodeSites
+{
+    pc_t *                          sites;
+    u32                             numSites;
+    u32                             capacity;
+}
+M3CodeSites;
+
+// the words of the compiled code that hold addresses, so that it can be relocated into another process (m3_cache.c)
+typedef struct M3CodeRelocations
 {
+    M3CodeSites                     ops;
+    M3CodeSites                     pointers;
+    bool                            incomplete;         // a site couldn't be recorded
+}
+M3CodeRelocations;
+
+typedef struct M3Compilation
+{
+    struct M3Compilation *  next;               // environment pool linkage; see Environment_AcquireCompilation
+
     IM3Runtime          runtime;
     IM3Module           module;
 
@@ -90,6 +138,9 @@ typedef struct
 
     IM3CodePage         page;
 
+    M3CodeSites *       deferredCalls;              // non-null during parallel compilation (see m3_CompileModuleParallel) & for templates
+    M3CodeRelocations * relocations;                // non-null when the code is going to be cached
+
 #ifdef DEBUG
     u32                 numEmits;
     u32                 numOpcodes;
@@ -105,6 +156,9 @@ typedef struct
     u16                 slotFirstLocalIndex;
     u16                 slotFirstDynamicIndex;      // numArgs + numLocals + numReservedConstants. the first mutable slot available to the compiler.
 
+    u16                 slotFirstZeroedLocal;       // the span of locals that op_Entry has to zero; see NoteLocalRead
+    u16                 slotMaxZeroedLocal;
+
     u16                 maxStackSlots;
 
     m3slot_t            constants                   [d_m3MaxConstantTableSize];
@@ -116,11 +170,22 @@ typedef struct
     // 'm3Slots' contains allocation usage counts
     u8                  m3Slots                     [d_m3MaxFunctionSlots];
 
+    // by local index: set once the local has been written at the top level of the function body
+    bool                localAssigned               [d_m3MaxFunctionStackHeight];
+
     u16                 slotMaxAllocatedIndexPlusOne;
 
     u16                 regStackIndexPlusOne        [2];
 
     m3opcode_t          previousOpcode;
+
+    pc_t                fusionPC;                   // the last operation that might store its result to a slot too; see TargetResultToSlot
+    pc_t                fusionEndPC;                // ...and where its immediates end
+    u16                 fusionStackIndex;           // ...and the stack entry holding its result
+
+    const u32 *         gasCosts;                   // non-null when metering; see StartGasSegment
+    u32 *               gasCharge;                  // the immediate of the current segment's op_UseGas
+    u32                 gasCost;                    // ...and what the segment has cost so far
 }
 M3Compilation;
 
@@ -205,6 +270,19 @@ M3Result    CompileBlock                (IM3Compilation io, IM3FuncType i_blockT
 M3Result    CompileBlockStatements      (IM3Compilation io);
 M3Result    CompileFunction             (IM3Function io_function);
 
+#if d_m3HasJit
+// recompiles a function that op_CountHotness found hot, without the counters, & translates it
+void        TierUpFunction              (IM3Function io_function);
+#endif
+
+// compiles into a cleared context supplied by the caller; code pages come from o->runtime
+M3Result    CompileFunctionWithContext  (IM3Compilation o, IM3Function io_function);
+
+M3Result    AddCodeSite                 (M3CodeSites * io_sites, pc_t i_site);
+
+// call sites emitted as op_Compile while other functions may still have been compiling on other threads
+void        LinkDeferredCalls           (M3CodeSites * io_calls);
+
 M3Result    CompileRawFunction          (IM3Module io_module, IM3Function io_function, const void * i_function, const void * i_userdata);
 
 d_m3EndExternC
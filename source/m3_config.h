@@ -151,6 +151,90 @@
 #   define d_m3SkipMemoryBoundsCheck            0       // skip memory bounds checks
 # endif
 
+# ifndef d_m3UseGuardPages
+#   define d_m3UseGuardPages                    0       // reserve linear memory behind guard pages and trap out-of-bounds accesses
+# endif                                                 // from a SIGSEGV handler instead of checking each load/store (64-bit Linux).
+                                                        // a memory that isn't a whole number of host pages faults past the last one
+
+# ifndef d_m3FuseOperations
+#   define d_m3FuseOperations                   1       // fold common operation sequences (e.g. i32.add + local.set) into superinstructions
+# endif
+
+# ifndef d_m3DispatchLoop
+#   define d_m3DispatchLoop                     0       // ops return to a dispatch loop instead of tail calling the next one. slower,
+# endif                                                 // but for compilers that can't eliminate tail calls it bounds the native stack
+
+# ifndef d_m3FlattenLoops
+#   if d_m3EnableStrace >= 3
+#     define d_m3FlattenLoops                   0       // op_Loop traces each iteration
+#   elif d_m3DispatchLoop || (M3_HAS_TAIL_CALL && M3_COMPILER_HAS_ATTRIBUTE(musttail))
+#     define d_m3FlattenLoops                   1       // loops iterate by jumping back to their head, which needs every tail
+#   else                                                // call eliminated: only musttail guarantees that (GCC at -O1 doesn't)
+#     define d_m3FlattenLoops                   0       // loops iterate by returning to op_Loop
+#   endif
+# endif
+
+# ifndef d_m3CompactCode
+#   define d_m3CompactCode                      0       // 64-bit hosts: metacode lines are 32 bits; ops are stored as offsets from m3_OpBase
+# endif                                                 // & pointers take two lines. roughly halves the size of the code pages
+
+# if d_m3CompactCode && M3_SIZEOF_PTR != 8
+#   undef  d_m3CompactCode
+#   define d_m3CompactCode                      0       // the lines are already 32 bits
+# endif
+
+# ifndef d_m3HasSIMD
+#   if d_m3HasFloat && !defined(M3_BIG_ENDIAN)
+#     define d_m3HasSIMD                        1       // implement the fixed-width SIMD proposal (v128 & the 0xFD opcodes)
+#   else
+#     define d_m3HasSIMD                        0       // vector lanes are accessed in little-endian order
+#   endif
+# endif
+
+# ifndef d_m3HasPthreads
+#   if (defined(__unix__) || defined(__APPLE__)) && !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+#     define d_m3HasPthreads                    1       // m3_CompileModuleParallel uses worker threads
+#   else
+#     define d_m3HasPthreads                    0       // m3_CompileModuleParallel compiles on the calling thread
+#   endif
+# endif
+
+# ifndef d_m3HasThreads
+#   if d_m3HasPthreads && (defined(__linux__) || defined(__APPLE__)) && !defined(M3_BIG_ENDIAN) && !defined(__STDC_NO_ATOMICS__)
+#     define d_m3HasThreads                     1       // implement the threads proposal (shared memories & the 0xFE atomic opcodes)
+#   else
+#     define d_m3HasThreads                     0       // the 0xFE opcodes are unknown & a shared memory is an ordinary one
+#   endif
+# endif
+
+# ifndef d_m3HasSnapshots
+#   if (defined(__linux__) || defined(__APPLE__)) && M3_SIZEOF_PTR == 8 && !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+#     define d_m3HasSnapshots                   1       // m3_RestoreRuntime remaps linear memory copy-on-write from the snapshot
+#   else
+#     define d_m3HasSnapshots                   0       // m3_SnapshotRuntime isn't supported
+#   endif
+# endif
+
+# ifndef d_m3HasSuspend
+#   if (defined(__x86_64__) || defined(__aarch64__)) && (defined(__unix__) || defined(__APPLE__)) && !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+#     define d_m3HasSuspend                     1       // m3_EnableSuspension runs calls on a native stack of the runtime's own
+#   else
+#     define d_m3HasSuspend                     0       // m3_Suspend always fails; the stack switch is only written for x86-64 & arm64
+#   endif
+# endif
+
+# ifndef d_m3FiberStackSize
+#   define d_m3FiberStackSize                   (1024*1024) // default native stack reserved per suspendable runtime
+# endif
+
+# ifndef d_m3HasJit
+#   if defined(__x86_64__) && defined(__linux__) && d_m3HasFloat && !d_m3EnableOpTracing && !d_m3EnableOpProfiling && !d_m3EnableStrace && !d_m3CompactCode && !d_m3DispatchLoop
+#     define d_m3HasJit                         1       // m3_EnableJit translates a runtime's compiled functions to x86-64 code
+#   else
+#     define d_m3HasJit                         0       // m3_EnableJit isn't supported; everything is interpreted
+#   endif
+# endif
+
 #define d_m3EnableCodePageRefCounting           0       // not supported currently
 
 #endif // m3_config_h
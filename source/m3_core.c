@@ -5,6 +5,10 @@
 //  Copyright © 2019 Steven Massey. All rights reserved.
 //
 
+#if defined(__linux__)
+#   define _GNU_SOURCE                  // memfd_create
+#endif
+
 #define M3_IMPLEMENT_ERROR_STRINGS
 #include "m3_config.h"
 #include "wasm3.h"
@@ -161,6 +165,43 @@ void *  m3_CopyMem  (const void * i_from, size_t i_size)
     return ptr;
 }
 
+#if d_m3CompactCode
+// compact code stores each operation as its distance from here (see d_m3Operation)
+void  m3_OpBase  (void)
+{
+}
+#endif
+
+#if d_m3HasThreads || d_m3HasSnapshots
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if !defined(__linux__)
+#   include <stdatomic.h>
+#endif
+
+int  OpenAnonymousFile  (cstr_t i_name)
+{
+# if defined(__linux__)
+    return memfd_create (i_name, MFD_CLOEXEC);
+# else
+    static _Atomic u32 s_sequence = 0;
+
+    char name [32];
+    snprintf (name, sizeof (name), "/wasm3.%d.%u", (int) getpid (), atomic_fetch_add (& s_sequence, 1));
+
+    int fd = shm_open (name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0)
+        shm_unlink (name);
+
+    return fd;
+# endif
+}
+
+#endif
+
 //--------------------------------------------------------------------------------------------
 
 #if d_m3LogNativeStack
@@ -203,6 +244,10 @@ M3Result NormalizeType (u8 * o_type, i8 i_convolutedWasmType)
 
     if (type == 0x40)
         type = c_m3Type_none;
+# if d_m3HasSIMD
+    else if (type == 0x80 - c_waType_v128)
+        type = c_m3Type_v128;       // v128 doesn't follow on from f64; see M3ValueType
+# endif
     else if (type < c_m3Type_i32 or type > c_m3Type_f64)
         result = m3Err_invalidTypeId;
 
@@ -212,12 +257,24 @@ M3Result NormalizeType (u8 * o_type, i8 i_convolutedWasmType)
 }
 
 
+u8  GetWasmValueType  (u8 i_m3Type)
+{
+    return IsVectorType (i_m3Type) ? c_waType_v128 : 0x80 - i_m3Type;
+}
+
+
 bool  IsFpType  (u8 i_m3Type)
 {
     return (i_m3Type == c_m3Type_f32 or i_m3Type == c_m3Type_f64);
 }
 
 
+bool  IsVectorType  (u8 i_m3Type)
+{
+    return (i_m3Type == c_m3Type_v128);
+}
+
+
 bool  IsIntType  (u8 i_m3Type)
 {
     return (i_m3Type == c_m3Type_i32 or i_m3Type == c_m3Type_i64);
@@ -238,6 +295,8 @@ u32  SizeOfType  (u8 i_m3Type)
 {
     if (i_m3Type == c_m3Type_i32 or i_m3Type == c_m3Type_f32)
         return sizeof (i32);
+    if (i_m3Type == c_m3Type_v128)
+        return 16;
 
     return sizeof (i64);
 }
@@ -343,6 +402,18 @@ M3Result  Read_opcode  (m3opcode_t * o_value, bytes_t  * io_bytes, cbytes_t i_en
             }
             else return m3Err_wasmUnderrun;
         }
+#   if d_m3HasSIMD || d_m3HasThreads
+        else if (M3_UNLIKELY(opcode == c_waOp_simd or opcode == c_waOp_atomic))
+        {
+            // SIMD & atomic opcodes are LEB encoded; all of the fixed-width SIMD & the atomic ones are below 0x100
+            u32 index;
+            M3Result result = ReadLEB_u32 (& index, & ptr, i_end);
+            if (result) return result;
+            if (index > 0xff) return m3Err_unknownOpcode;
+
+            opcode = (opcode << 8) | index;
+        }
+#   endif
 #endif
         * o_value = opcode;
         * io_bytes = ptr;
@@ -69,6 +69,24 @@ typedef u64                     m3slot_t;
 
 typedef m3slot_t *              m3stack_t;
 
+# if d_m3HasSIMD
+// a v128 value occupies 16 bytes (2 or 4 consecutive slots) and is never held in a register. lane 0 is at the lowest address.
+typedef union m3v128_t
+{
+    i8      i8x16  [16];
+    u8      u8x16  [16];
+    i16     i16x8  [8];
+    u16     u16x8  [8];
+    i32     i32x4  [4];
+    u32     u32x4  [4];
+    i64     i64x2  [2];
+    u64     u64x2  [2];
+    f32     f32x4  [4];
+    f64     f64x2  [2];
+}
+m3v128_t;
+# endif
+
 typedef
 const void * const  cvptr_t;
 
@@ -125,9 +143,16 @@ const void * const  cvptr_t;
 #   define d_m3Assert(ASS)
 # endif
 
+# if d_m3CompactCode
+typedef u32                                 code_t;     // an op is a distance from m3_OpBase; a pointer or a u64 takes two lines
+# else
 typedef void /*const*/ *                    code_t;
+# endif
 typedef code_t const * /*__restrict__*/     pc_t;
 
+// the number of lines an immediate of TYPE occupies in the code stream
+# define d_m3CodeLines(TYPE)                ((sizeof (TYPE) + sizeof (code_t) - 1) / sizeof (code_t))
+
 
 typedef struct M3MemoryHeader
 {
@@ -155,7 +180,11 @@ typedef struct M3CodePageHeader
 M3CodePageHeader;
 
 
-#define d_m3CodePageFreeLinesThreshold      4+2       // max is: select _sss & CallIndirect + 2 for bridge
+# if d_m3CompactCode
+#define d_m3CodePageFreeLinesThreshold      (2*(6+2)) // pointers & 64-bit constants take two lines
+# else
+#define d_m3CodePageFreeLinesThreshold      6+2       // max is: CallIndirect & its M3CallCache + 2 for bridge
+# endif
 
 #define d_m3DefaultMemPageSize              65536
 
@@ -179,8 +208,10 @@ M3CodePageHeader;
 #define d_externalKind_memory               2
 #define d_externalKind_global               3
 
-static const char * const c_waTypes []          = { "nil", "i32", "i64", "f32", "f64", "unknown" };
-static const char * const c_waCompactTypes []   = { "_", "i", "I", "f", "F", "?" };
+#define c_waType_v128                       0x7b
+
+static const char * const c_waTypes []          = { "nil", "i32", "i64", "f32", "f64", "unknown", "v128" };
+static const char * const c_waCompactTypes []   = { "_", "i", "I", "f", "F", "?", "V" };
 
 
 # if d_m3VerboseErrorMessages
@@ -223,6 +254,11 @@ void *      m3_Realloc_Impl         (void * i_ptr, size_t i_newSize, size_t i_ol
 void        m3_Free_Impl            (void * i_ptr);
 void *      m3_CopyMem              (const void * i_from, size_t i_size);
 
+#if d_m3HasThreads || d_m3HasSnapshots
+// a file that's only reachable through the returned descriptor (memfd, or an unlinked shm object); -1 on failure
+int         OpenAnonymousFile       (cstr_t i_name);
+#endif
+
 #if d_m3LogHeapOps
 
 // Tracing format: timestamp;heap:OpCode;name;size(bytes);new items;new ptr;old items;old ptr
@@ -272,9 +308,11 @@ static inline void * m3_Realloc (ccstr_t name, void * i_ptr, size_t i_newSize, s
 #endif
 
 M3Result    NormalizeType           (u8 * o_type, i8 i_convolutedWasmType);
+u8          GetWasmValueType        (u8 i_m3Type);
 
 bool        IsIntType               (u8 i_wasmType);
 bool        IsFpType                (u8 i_wasmType);
+bool        IsVectorType            (u8 i_wasmType);
 bool        Is64BitType             (u8 i_m3Type);
 u32         SizeOfType              (u8 i_m3Type);
 
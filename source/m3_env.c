@@ -12,6 +12,45 @@
 #include "m3_compile.h"
 #include "m3_exception.h"
 #include "m3_info.h"
+#include "m3_cache.h"
+#include "m3_threads.h"
+#include "m3_snapshot.h"
+#include "m3_suspend.h"
+#include "m3_interrupt.h"
+#include "m3_jit.h"
+
+#if d_m3UseGuardPages
+#   if !(defined(__linux__) && M3_SIZEOF_PTR == 8)
+#       error "d_m3UseGuardPages requires a 64-bit Linux host"
+#   endif
+#   include <setjmp.h>
+#   include <signal.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#endif
+
+#if d_m3HasPthreads
+#   include <pthread.h>
+#   include <unistd.h>
+#endif
+
+
+static
+void  LockEnvironment  (IM3Environment i_environment)
+{
+#if d_m3HasPthreads
+    pthread_mutex_lock (& i_environment->lock);
+#endif
+}
+
+
+static
+void  UnlockEnvironment  (IM3Environment i_environment)
+{
+#if d_m3HasPthreads
+    pthread_mutex_unlock (& i_environment->lock);
+#endif
+}
 
 
 IM3Environment  m3_NewEnvironment  ()
@@ -20,11 +59,17 @@ IM3Environment  m3_NewEnvironment  ()
 
     if (env)
     {
+#if d_m3HasPthreads
+        pthread_mutex_init (& env->lock, NULL);
+#endif
         _try
         {
             // create FuncTypes for all simple block return ValueTypes
-            for (u8 t = c_m3Type_none; t <= c_m3Type_f64; t++)
+            for (u8 t = c_m3Type_none; t <= c_m3Type_v128; t++)
             {
+                if (t == c_m3Type_unknown)
+                    continue;
+
                 IM3FuncType ftype;
 _               (AllocFuncType (& ftype, 1));
 
@@ -34,7 +79,6 @@ _               (AllocFuncType (& ftype, 1));
 
                 Environment_AddFuncType (env, & ftype);
 
-                d_m3Assert (t < 5);
                 env->retFuncTypes [t] = ftype;
             }
         }
@@ -64,6 +108,51 @@ void  Environment_Release  (IM3Environment i_environment)
 
     m3log (runtime, "freeing %d pages from environment", CountCodePages (i_environment->pagesReleased));
     FreeCodePages (& i_environment->pagesReleased);
+
+    IM3Compilation compilation = i_environment->compilationsReleased;
+
+    while (compilation)
+    {
+        IM3Compilation next = compilation->next;
+        m3_Free (compilation);
+        compilation = next;
+    }
+
+    m3_Free (i_environment->codeCacheDirectory);
+    m3_Free (i_environment->gasCosts);
+}
+
+
+IM3Compilation  Environment_AcquireCompilation  (IM3Environment i_environment)
+{
+    LockEnvironment (i_environment);
+
+    IM3Compilation compilation = i_environment->compilationsReleased;
+    if (compilation)
+        i_environment->compilationsReleased = compilation->next;
+
+    UnlockEnvironment (i_environment);
+
+    if (compilation)
+        memset (compilation, 0x0, sizeof (M3Compilation));
+    else
+        compilation = m3_AllocStruct (M3Compilation);
+
+    return compilation;
+}
+
+
+void  Environment_ReleaseCompilation  (IM3Environment i_environment, IM3Compilation i_compilation)
+{
+    if (i_compilation)
+    {
+        LockEnvironment (i_environment);
+
+        i_compilation->next = i_environment->compilationsReleased;
+        i_environment->compilationsReleased = i_compilation;
+
+        UnlockEnvironment (i_environment);
+    }
 }
 
 
@@ -72,6 +161,9 @@ void  m3_FreeEnvironment  (IM3Environment i_environment)
     if (i_environment)
     {
         Environment_Release (i_environment);
+#if d_m3HasPthreads
+        pthread_mutex_destroy (& i_environment->lock);
+#endif
         m3_Free (i_environment);
     }
 }
@@ -83,9 +175,42 @@ void m3_SetCustomSectionHandler  (IM3Environment i_environment, M3SectionHandler
 }
 
 
+M3Result  m3_SetCodeCacheDirectory  (IM3Environment i_environment, const char * i_path)
+{
+    m3_Free (i_environment->codeCacheDirectory);
+
+    if (i_path)
+    {
+        i_environment->codeCacheDirectory = m3_CopyMem (i_path, strlen (i_path) + 1);
+        if (not i_environment->codeCacheDirectory)
+            return m3Err_mallocFailed;
+    }
+
+    return m3Err_none;
+}
+
+
+M3Result  m3_EnableGasMetering  (IM3Environment i_environment, const uint32_t * i_opcodeCosts)
+{
+    if (not i_environment->gasCosts)
+    {
+        i_environment->gasCosts = m3_AllocArray (u32, 256);
+        if (not i_environment->gasCosts)
+            return m3Err_mallocFailed;
+    }
+
+    for (u32 i = 0; i < 256; ++i)
+        i_environment->gasCosts [i] = i_opcodeCosts ? i_opcodeCosts [i] : 1;
+
+    return m3Err_none;
+}
+
+
 // returns the same io_funcType or replaces it with an equivalent that's already in the type linked list
 void  Environment_AddFuncType  (IM3Environment i_environment, IM3FuncType * io_funcType)
 {
+    LockEnvironment (i_environment);
+
     IM3FuncType addType = * io_funcType;
     IM3FuncType newType = i_environment->funcTypes;
 
@@ -107,6 +232,8 @@ void  Environment_AddFuncType  (IM3Environment i_environment, IM3FuncType * io_f
         i_environment->funcTypes = newType;
     }
 
+    UnlockEnvironment (i_environment);
+
     * io_funcType = newType;
 }
 
@@ -139,7 +266,11 @@ IM3CodePage RemoveCodePageOfCapacity (M3CodePage ** io_list, u32 i_minimumLineCo
 
 IM3CodePage  Environment_AcquireCodePage (IM3Environment i_environment, u32 i_minimumLineCount)
 {
-    return RemoveCodePageOfCapacity (& i_environment->pagesReleased, i_minimumLineCount);
+    LockEnvironment (i_environment);
+    IM3CodePage page = RemoveCodePageOfCapacity (& i_environment->pagesReleased, i_minimumLineCount);
+    UnlockEnvironment (i_environment);
+
+    return page;
 }
 
 
@@ -164,8 +295,10 @@ void  Environment_ReleaseCodePages  (IM3Environment i_environment, IM3CodePage i
     if (end)
     {
         // push list to front
+        LockEnvironment (i_environment);
         end->info.next = i_environment->pagesReleased;
         i_environment->pagesReleased = i_codePageList;
+        UnlockEnvironment (i_environment);
     }
 }
 
@@ -180,6 +313,7 @@ IM3Runtime  m3_NewRuntime  (IM3Environment i_environment, u32 i_stackSizeInBytes
 
         runtime->environment = i_environment;
         runtime->userdata = i_userdata;
+        runtime->gasLeft = runtime->gasLimit = INT64_MAX;
 
         runtime->originStack = m3_Malloc ("Wasm Stack", i_stackSizeInBytes + 4*sizeof (m3slot_t)); // TODO: more precise stack checks
 
@@ -200,6 +334,33 @@ void *  m3_GetUserData  (IM3Runtime i_runtime)
 }
 
 
+M3Result  m3_SetGasLimit  (IM3Runtime io_runtime, uint64_t i_limit)
+{
+    if (not io_runtime->environment->gasCosts)
+        return "gas metering isn't enabled";
+
+    io_runtime->gasLeft = io_runtime->gasLimit = (i64) M3_MIN (i_limit, (u64) INT64_MAX);
+
+    return m3Err_none;
+}
+
+
+uint64_t  m3_GetGasUsed  (IM3Runtime i_runtime)
+{
+    return (u64) (i_runtime->gasLimit - i_runtime->gasLeft);
+}
+
+
+void  m3_GetCallCacheCounts  (IM3Runtime i_runtime, uint64_t * o_hits, uint64_t * o_misses)
+{
+    if (o_hits)
+        * o_hits = i_runtime->callCacheHits;
+
+    if (o_misses)
+        * o_misses = i_runtime->callCacheMisses;
+}
+
+
 void *  ForEachModule  (IM3Runtime i_runtime, ModuleVisitor i_visitor, void * i_info)
 {
     void * r = NULL;
@@ -229,13 +390,26 @@ void *  _FreeModule  (IM3Module i_module, void * i_info)
 
 void  Runtime_Release  (IM3Runtime i_runtime)
 {
+#if d_m3HasPthreads
+    DisarmDeadline (i_runtime);
+#endif
+
     ForEachModule (i_runtime, _FreeModule, NULL);                   d_m3Assert (i_runtime->numActiveCodePages == 0);
 
     Environment_ReleaseCodePages (i_runtime->environment, i_runtime->pagesOpen);
     Environment_ReleaseCodePages (i_runtime->environment, i_runtime->pagesFull);
 
     m3_Free (i_runtime->originStack);
-    m3_Free (i_runtime->memory.mallocated);
+    m3_Free (i_runtime->templateCalls.sites);
+    FreeMemory (& i_runtime->memory);
+
+#if d_m3HasSuspend
+    FreeFiber (i_runtime);
+#endif
+
+#if d_m3HasJit
+    FreeJit (i_runtime);
+#endif
 }
 
 
@@ -273,7 +447,14 @@ M3Result  EvaluateExpression  (IM3Module i_module, void * o_expressed, u8 i_type
     IM3Runtime savedRuntime = i_module->runtime;
     i_module->runtime = & runtime;
 
-    IM3Compilation o = & runtime.compilation;
+    IM3Compilation o = Environment_AcquireCompilation (runtime.environment);
+
+    if (not o)
+    {
+        i_module->runtime = savedRuntime;
+        return m3Err_mallocFailed;
+    }
+
     o->runtime = & runtime;
     o->module =  i_module;
     o->wasm =    * io_bytes;
@@ -310,10 +491,11 @@ M3Result  EvaluateExpression  (IM3Module i_module, void * o_expressed, u8 i_type
                 {
                     * (u32 *) o_expressed = * ((u32 *) stack);
                 }
-                else
+                else if (SizeOfType (i_type) == sizeof (u64))
                 {
                     * (u64 *) o_expressed = * ((u64 *) stack);
                 }
+                else memcpy (o_expressed, stack, SizeOfType (i_type));
             }
         }
 
@@ -328,14 +510,250 @@ M3Result  EvaluateExpression  (IM3Module i_module, void * o_expressed, u8 i_type
 
     * io_bytes = o->wasm;
 
+    Environment_ReleaseCompilation (runtime.environment, o);
+
     return result;
 }
 
 
+#if d_m3UseGuardPages
+
+// a load/store address is a u32 operand plus a u32 offset, so any access the interpreter can
+// generate lands within 8GiB (+ the access width) of the linear memory base
+const size_t c_m3GuardRegionSize = (8ull << 30) + 65536;
+
+typedef struct M3FaultContext
+{
+    struct M3FaultContext *     previous;
+    IM3Runtime                  runtime;
+    sigjmp_buf                  jump;
+}
+M3FaultContext;
+
+static __thread M3FaultContext *    s_faultContext          = NULL;
+static struct sigaction             s_previousSegvAction;
+static volatile int                 s_faultHandlerInstalled = 0;
+
+
+static
+size_t  GetHostPageSize  ()
+{
+    return (size_t) sysconf (_SC_PAGESIZE);
+}
+
+
+static
+u8 *  GetMemoryReservation  (IM3Memory i_memory)
+{
+    return m3MemData (i_memory->mallocated) - GetHostPageSize ();
+}
+
+
+static
+bool  IsGuardedAddress  (IM3Memory i_memory, const void * i_address)
+{
+    if (i_memory->mallocated)
+    {
+        u8 * base = GetMemoryReservation (i_memory);
+        u8 * address = (u8 *) i_address;
+
+        return (address >= base and address < base + GetHostPageSize () + c_m3GuardRegionSize);
+    }
+    else return false;
+}
+
+
+static
+void  HandleMemoryFault  (int i_signal, siginfo_t * i_info, void * i_context)
+{
+    M3FaultContext * context = s_faultContext;
+
+    if (context and IsGuardedAddress (& context->runtime->memory, i_info->si_addr))
+        siglongjmp (context->jump, 1);
+
+    // not a wasm access; chain to whoever had the signal before us. a default or ignored disposition can't be called,
+    // so it's reinstated for the fault to reoccur with (the process is going down, so this handler isn't needed again)
+    if (s_previousSegvAction.sa_flags & SA_SIGINFO)
+        s_previousSegvAction.sa_sigaction (i_signal, i_info, i_context);
+    else if (s_previousSegvAction.sa_handler == SIG_DFL or s_previousSegvAction.sa_handler == SIG_IGN)
+        sigaction (i_signal, & s_previousSegvAction, NULL);
+    else
+        s_previousSegvAction.sa_handler (i_signal);
+}
+
+
+M3Result  InstallMemoryFaultHandler  ()
+{
+    M3Result result = m3Err_none;
+
+    if (__sync_bool_compare_and_swap (& s_faultHandlerInstalled, 0, 1))
+    {
+        struct sigaction action;
+        M3_INIT (action);
+
+        action.sa_sigaction = HandleMemoryFault;
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset (& action.sa_mask);
+
+        if (sigaction (SIGSEGV, & action, & s_previousSegvAction))
+        {
+            s_faultHandlerInstalled = 0;
+            result = "couldn't install linear memory fault handler";
+        }
+    }
+
+    return result;
+}
+
+
+static
+M3Result  ReserveMemory  (IM3Memory io_memory, size_t i_numPageBytes)
+{
+    M3Result result = m3Err_none;
+
+    size_t hostPageSize = GetHostPageSize ();
+
+    // access is granted in host pages. a memory that isn't a multiple of them (a custom page size, or one clamped by
+    // the runtime's memoryLimit) is accessible up to the next host page boundary; its length in the M3MemoryHeader is exact
+    size_t numAccessibleBytes = (i_numPageBytes + hostPageSize - 1) / hostPageSize * hostPageSize;
+
+    if (not io_memory->mallocated)
+    {
+_       (InstallMemoryFaultHandler ());
+
+        // one leading page holds the M3MemoryHeader; the linear memory itself starts page-aligned after it
+        u8 * base = (u8 *) mmap (NULL, hostPageSize + c_m3GuardRegionSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        _throwif (m3Err_mallocFailed, base == MAP_FAILED);
+
+        if (mprotect (base, hostPageSize, PROT_READ | PROT_WRITE))
+        {
+            munmap (base, hostPageSize + c_m3GuardRegionSize);
+            _throw (m3Err_mallocFailed);
+        }
+
+        io_memory->mallocated = (M3MemoryHeader *) (base + hostPageSize - sizeof (M3MemoryHeader));
+    }
+
+    // pages are only ever added, so the previously accessible span is simply extended
+    if (numAccessibleBytes)
+    {
+        _throwif (m3Err_mallocFailed, mprotect (m3MemData (io_memory->mallocated), numAccessibleBytes, PROT_READ | PROT_WRITE));
+    }
+
+    _catch: return result;
+}
+
+
+void  FreeMemory  (IM3Memory io_memory)
+{
+# if d_m3HasSnapshots
+    ReleaseMemoryCheckpoint (io_memory);
+# endif
+
+# if d_m3HasThreads
+    if (io_memory->shared)
+        DetachSharedMemory (io_memory);
+# endif
+
+    if (io_memory->mallocated)
+        munmap (GetMemoryReservation (io_memory), GetHostPageSize () + c_m3GuardRegionSize);
+
+    io_memory->mallocated = NULL;
+}
+
+
+static
+M3Result  RunCodeWithFaultHandler  (IM3Runtime i_runtime, pc_t i_pc)
+{
+    M3Result result;
+
+    M3FaultContext context;
+    context.previous = s_faultContext;
+    context.runtime = i_runtime;
+
+    s_faultContext = & context;
+
+    if (sigsetjmp (context.jump, 0) == 0)
+    {
+# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
+        result = (M3Result) RunCode (i_pc, (m3stack_t) i_runtime->stack, i_runtime->memory.mallocated, d_m3OpDefaultArgs, d_m3BaseCstr);
+# else
+        result = (M3Result) RunCode (i_pc, (m3stack_t) i_runtime->stack, i_runtime->memory.mallocated, d_m3OpDefaultArgs);
+# endif
+    }
+    else result = m3Err_trapOutOfBoundsMemoryAccess;
+
+    s_faultContext = context.previous;
+
+    return result;
+}
+
+
+void *  SwapFaultContext  (void * i_context)
+{
+    M3FaultContext * previous = s_faultContext;
+    s_faultContext = (M3FaultContext *) i_context;
+
+    return previous;
+}
+
+#else
+
+void  FreeMemory  (IM3Memory io_memory)
+{
+# if d_m3HasSnapshots
+    ReleaseMemoryCheckpoint (io_memory);
+# endif
+
+# if d_m3HasThreads
+    if (io_memory->shared)
+    {
+        DetachSharedMemory (io_memory);
+        return;
+    }
+# endif
+
+# if d_m3HasSnapshots
+    if (io_memory->numMappedBytes)
+    {
+        FreeMappedMemory (io_memory);
+        return;
+    }
+# endif
+
+    m3_Free (io_memory->mallocated);
+}
+
+#endif // d_m3UseGuardPages
+
+
+M3Result  RunFunctionCode  (IM3Runtime i_runtime, pc_t i_pc)
+{
+#if d_m3UseGuardPages
+    return RunCodeWithFaultHandler (i_runtime, i_pc);
+#elif (d_m3EnableOpProfiling || d_m3EnableOpTracing)
+    return (M3Result) RunCode (i_pc, (m3stack_t) i_runtime->stack, i_runtime->memory.mallocated, d_m3OpDefaultArgs, d_m3BaseCstr);
+#else
+    return (M3Result) RunCode (i_pc, (m3stack_t) i_runtime->stack, i_runtime->memory.mallocated, d_m3OpDefaultArgs);
+#endif
+}
+
+
 M3Result  InitMemory  (IM3Runtime io_runtime, IM3Module i_module)
 {
     M3Result result = m3Err_none;                                     //d_m3Assert (not io_runtime->memory.wasmPages);
 
+#if d_m3HasThreads
+    if (i_module->memoryInfo.shared)
+    {
+        result = AttachSharedMemory (io_runtime, i_module);
+    }
+    else if (io_runtime->memory.shared)
+    {
+        result = "module memory isn't shared";
+    }
+    else
+#endif
     if (not i_module->memoryImported)
     {
         u32 maxPages = i_module->memoryInfo.maxPages;
@@ -358,6 +776,11 @@ M3Result  ResizeMemory  (IM3Runtime io_runtime, u32 i_numPages)
 
     M3Memory * memory = & io_runtime->memory;
 
+#if d_m3HasThreads
+    if (memory->shared)
+        return ResizeSharedMemory (io_runtime, i_numPages);
+#endif
+
 #if 0 // Temporary fix for memory allocation
     if (memory->mallocated) {
         memory->numPages = i_numPages;
@@ -387,15 +810,29 @@ M3Result  ResizeMemory  (IM3Runtime io_runtime, u32 i_numPages)
         if (numPreviousBytes)
             numPreviousBytes += sizeof (M3MemoryHeader);
 
-        void* newMem = m3_Realloc ("Wasm Linear Memory", memory->mallocated, numBytes, numPreviousBytes);
-        _throwifnull(newMem);
-
-        memory->mallocated = (M3MemoryHeader*)newMem;
-
 # if d_m3LogRuntime
         M3MemoryHeader * oldMallocated = memory->mallocated;
 # endif
 
+# if d_m3UseGuardPages
+        (void) numBytes; (void) numPreviousBytes;
+_       (ReserveMemory (memory, numPageBytes));
+# else
+#  if d_m3HasSnapshots
+        if (memory->numMappedBytes)
+        {
+_           (ResizeMappedMemory (memory, numPageBytes));
+        }
+        else
+#  endif
+        {
+            void* newMem = m3_Realloc ("Wasm Linear Memory", memory->mallocated, numBytes, numPreviousBytes);
+            _throwifnull(newMem);
+
+            memory->mallocated = (M3MemoryHeader*)newMem;
+        }
+# endif
+
         memory->numPages = numPagesToAlloc;
 
         memory->mallocated->length =  numPageBytes;
@@ -459,10 +896,21 @@ M3Result  InitDataSegments  (M3Memory * io_memory, IM3Module io_module)
 
     _throwif ("unallocated linear memory", !(io_memory->mallocated));
 
+    if (io_module->numDataSegments)
+    {
+        io_module->droppedDataSegments = m3_AllocArray (bool, io_module->numDataSegments);
+        _throwifnull (io_module->droppedDataSegments);
+    }
+
     for (u32 i = 0; i < io_module->numDataSegments; ++i)
     {
         M3DataSegment * segment = & io_module->dataSegments [i];
 
+        if (not segment->initExpr)      // passive
+            continue;
+
+        io_module->droppedDataSegments [i] = true;
+
         i32 segmentOffset;
         bytes_t start = segment->initExpr;
 _       (EvaluateExpression (io_module, & segmentOffset, c_m3Type_i32, & start, segment->initExpr + segment->initExprSize));
@@ -523,6 +971,8 @@ _               (ReadLEB_u32 (& functionIndex, & bytes, end));
                 IM3Function function = & io_module->functions [functionIndex];      d_m3Assert (function); //printf ("table: %s\n", m3_GetFunctionName(function));
                 io_module->table0 [e + offset] = function;
             }
+
+            io_module->table0Version++;
         }
         else _throw ("element table index must be zero for MVP");
     }
@@ -530,7 +980,8 @@ _               (ReadLEB_u32 (& functionIndex, & bytes, end));
     _catch: return result;
 }
 
-M3Result  m3_CompileModule  (IM3Module io_module)
+static
+M3Result  CompileFunctions  (IM3Module io_module)
 {
     M3Result result = m3Err_none;
 
@@ -546,6 +997,263 @@ _           (CompileFunction (f));
     _catch: return result;
 }
 
+
+typedef struct M3CompileWorker
+{
+    M3Environment           environment;    // empty; keeps workers away from the shared pool of released code pages
+    M3Runtime               codePages;      // private code page allocator. its pages are handed to the module runtime afterwards
+    M3CodeSites             calls;
+    M3CodeRelocations       relocations;
+
+    IM3Compilation          compilation;
+    IM3Module               module;
+    u32 *                   nextFunction;
+
+#if d_m3HasPthreads
+    pthread_t               thread;
+    bool                    started;
+#endif
+
+    M3Result                result;
+}
+M3CompileWorker;
+
+
+static
+void *  CompileModuleWorker  (void * i_worker)
+{
+    M3CompileWorker * worker = (M3CompileWorker *) i_worker;
+    IM3Module module = worker->module;
+
+    while (not worker->result)
+    {
+#if d_m3HasPthreads
+        u32 i = __sync_fetch_and_add (worker->nextFunction, 1);
+#else
+        u32 i = (* worker->nextFunction)++;
+#endif
+        if (i >= module->numFunctions)
+            break;
+
+        IM3Function f = & module->functions [i];
+        if (f->wasm and not f->compiled)
+        {
+            IM3Compilation o = worker->compilation;
+            memset (o, 0x0, sizeof (M3Compilation));
+
+            o->runtime = & worker->codePages;
+            o->deferredCalls = & worker->calls;
+
+            if (module->environment->codeCacheDirectory)
+                o->relocations = & worker->relocations;
+
+            worker->result = CompileFunctionWithContext (o, f);
+
+            // stop the other workers from claiming more functions
+#if d_m3HasPthreads
+            if (worker->result)
+                __sync_lock_test_and_set (worker->nextFunction, module->numFunctions);
+#endif
+        }
+    }
+
+    return NULL;
+}
+
+
+static
+void  SpliceCodePages  (IM3CodePage * io_list, IM3CodePage i_pages)
+{
+    while (i_pages)
+    {
+        IM3CodePage next = i_pages->info.next;
+        PushCodePage (io_list, i_pages);
+        i_pages = next;
+    }
+}
+
+
+static
+M3Result  AppendCodeSites  (M3CodeSites * io_sites, M3CodeSites * i_sites)
+{
+    M3Result result = m3Err_none;
+
+    for (u32 i = 0; i < i_sites->numSites and not result; ++i)
+        result = AddCodeSite (io_sites, i_sites->sites [i]);
+
+    return result;
+}
+
+
+// compiles the module's functions into private code pages, on up to i_numWorkers threads. these pages are cached
+// when the environment has a cache directory
+static
+M3Result  CompileModuleWithWorkers  (IM3Module io_module, u32 i_numWorkers)
+{
+    M3Result result = m3Err_none;
+
+    IM3Runtime runtime = io_module->runtime;
+    IM3Environment env = runtime->environment;
+    cstr_t cacheDirectory = env->codeCacheDirectory;
+    u32 nextFunction = 0;
+
+    IM3CodePage pages = NULL;
+    M3CodeRelocations * relocations = NULL;
+
+    // any functions that the cached image doesn't cover are compiled as usual
+    if (cacheDirectory and not LoadCodeCache (io_module, cacheDirectory))
+    {
+        result = CompileFunctions (io_module);
+#if d_m3HasJit
+        TranslateModule (io_module);
+#endif
+        return result;
+    }
+
+    M3CompileWorker * workers = m3_AllocArray (M3CompileWorker, i_numWorkers);
+    _throwifnull (workers);
+
+    for (u32 i = 0; i < i_numWorkers; ++i)
+    {
+        M3CompileWorker * worker = & workers [i];
+
+        worker->codePages.environment = & worker->environment;
+#if d_m3HasJit
+        // the code is the module runtime's: counted while it's tiering (see EmitHotnessCount)
+        worker->codePages.tierThreshold = runtime->tierThreshold;
+#endif
+        worker->module = io_module;
+        worker->nextFunction = & nextFunction;
+        worker->compilation = Environment_AcquireCompilation (env);
+        _throwifnull (worker->compilation);
+    }
+
+#if d_m3HasPthreads
+    // the calling thread works too. if a thread can't be started, the others pick up its share
+    for (u32 i = 1; i < i_numWorkers; ++i)
+        workers [i].started = (pthread_create (& workers [i].thread, NULL, CompileModuleWorker, & workers [i]) == 0);
+#endif
+
+    CompileModuleWorker (& workers [0]);
+
+#if d_m3HasPthreads
+    for (u32 i = 1; i < i_numWorkers; ++i)
+    {
+        if (workers [i].started)
+            pthread_join (workers [i].thread, NULL);
+    }
+#endif
+
+    relocations = & workers [0].relocations;
+
+    for (u32 i = 0; i < i_numWorkers; ++i)
+    {
+        M3CompileWorker * worker = & workers [i];
+
+        SpliceCodePages (& pages, worker->codePages.pagesOpen);
+        SpliceCodePages (& pages, worker->codePages.pagesFull);
+        runtime->numCodePages += worker->codePages.numCodePages;
+
+        LinkDeferredCalls (& worker->calls);
+
+        if (i and cacheDirectory)
+        {
+            relocations->incomplete |= worker->relocations.incomplete;
+            relocations->incomplete |= (AppendCodeSites (& relocations->ops, & worker->relocations.ops) != m3Err_none);
+            relocations->incomplete |= (AppendCodeSites (& relocations->pointers, & worker->relocations.pointers) != m3Err_none);
+        }
+
+        if (worker->result and not result)
+        {
+            result = worker->result;
+
+            if (worker->codePages.error.result)
+            {
+                runtime->error = worker->codePages.error;
+                runtime->error.runtime = runtime;
+#               if d_m3VerboseErrorMessages
+                    memcpy (runtime->error_message, worker->codePages.error_message, sizeof (runtime->error_message));
+                    runtime->error.message = runtime->error_message;
+#               endif
+            }
+        }
+    }
+
+    // a module that can't be cached still runs; it's just compiled again next time
+    if (cacheDirectory and not result and not relocations->incomplete)
+        SaveCodeCache (io_module, cacheDirectory, pages, relocations);
+
+    while (pages)
+        ReleaseCodePageNoTrack (runtime, PopCodePage (& pages));
+
+#if d_m3HasJit
+    // after the cache is written: translating rewrites each function's entry op
+    if (not result)
+        TranslateModule (io_module);
+#endif
+
+    _catch:
+
+    if (workers)
+    {
+        for (u32 i = 0; i < i_numWorkers; ++i)
+        {
+            Environment_ReleaseCompilation (env, workers [i].compilation);
+            m3_Free (workers [i].calls.sites);
+            m3_Free (workers [i].relocations.ops.sites);
+            m3_Free (workers [i].relocations.pointers.sites);
+        }
+
+        m3_Free (workers);
+    }
+
+    return result;
+}
+
+
+M3Result  m3_CompileModule  (IM3Module io_module)
+{
+    M3Result result;
+
+    if (io_module->environment->codeCacheDirectory)
+        result = CompileModuleWithWorkers (io_module, 1);
+    else
+        result = CompileFunctions (io_module);
+
+    // a template's calls are linked once all of its functions are compiled, so that its instances never rewrite the
+    // shared code (see CompileFunction)
+    M3CodeSites * calls = & io_module->runtime->templateCalls;
+
+    if (io_module->isTemplate and calls->numSites and not result)
+    {
+        LinkDeferredCalls (calls);
+        calls->numSites = 0;
+    }
+
+    return result;
+}
+
+
+M3Result  m3_CompileModuleParallel  (IM3Module io_module, uint32_t i_numThreads)
+{
+#if d_m3HasPthreads
+    if (i_numThreads == 0)
+    {
+        long numCores = sysconf (_SC_NPROCESSORS_ONLN);
+        i_numThreads = (numCores > 0) ? (u32) numCores : 1;
+    }
+
+    if (i_numThreads > io_module->numFunctions)
+        i_numThreads = io_module->numFunctions;
+
+    if (i_numThreads > 1)
+        return CompileModuleWithWorkers (io_module, i_numThreads);
+#endif
+
+    return m3_CompileModule (io_module);
+}
+
+
 M3Result  m3_RunStart  (IM3Module io_module)
 {
 #ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
@@ -572,14 +1280,14 @@ _           (CompileFunction (function));
         IM3Module module = function->module;
         IM3Runtime runtime = module->runtime;
 
+# if d_m3HasSuspend
+        _throwif (m3Err_runtimeSuspended, IsSuspended (runtime));
+# endif
+
         startFunctionTmp = io_module->startFunction;
         io_module->startFunction = -1;
 
-# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
-        result = (M3Result) RunCode (function->compiled, (m3stack_t) runtime->stack, runtime->memory.mallocated, d_m3OpDefaultArgs, d_m3BaseCstr);
-# else
-        result = (M3Result) RunCode (function->compiled, (m3stack_t) runtime->stack, runtime->memory.mallocated, d_m3OpDefaultArgs);
-# endif
+        result = RunFunctionCode (runtime, function->compiled);
 
         if (result)
         {
@@ -625,6 +1333,137 @@ _catch:
     return result;
 }
 
+static
+bool  IsModuleCompiled  (IM3Module i_module)
+{
+    for (u32 i = 0; i < i_module->numFunctions; ++i)
+    {
+        IM3Function f = & i_module->functions [i];
+        if (f->wasm and not f->compiled)
+            return false;
+    }
+
+    return true;
+}
+
+
+M3Result  m3_NewModuleTemplate  (IM3Environment i_environment, IM3ModuleTemplate * o_template, const uint8_t * const i_wasmBytes, uint32_t i_numWasmBytes)
+{
+    IM3ModuleTemplate t = NULL;
+
+_try {
+    t = m3_AllocStruct (M3ModuleTemplate);
+    _throwifnull (t);
+
+    // this runtime only holds the template module & its code pages; nothing executes on it
+    t->runtime = m3_NewRuntime (i_environment, 0, NULL);
+    _throwifnull (t->runtime);
+
+_   (m3_ParseModule (i_environment, & t->module, i_wasmBytes, i_numWasmBytes));
+
+    // memory, globals, data & elements are initialized per instance, so the module is attached without m3_LoadModule
+    t->module->isTemplate = true;
+    t->module->runtime = t->runtime;
+    t->runtime->modules = t->module;
+
+#ifdef DEBUG
+    // done here so that instances share the generated names rather than allocate their own
+    Module_GenerateNames (t->module);
+#endif
+
+    * o_template = t;
+
+} _catch:
+
+    if (result)
+    {
+        if (t and t->module and not t->module->runtime)
+            m3_FreeModule (t->module);
+
+        m3_FreeModuleTemplate (t);
+    }
+
+    return result;
+}
+
+
+void  m3_FreeModuleTemplate  (IM3ModuleTemplate i_template)
+{
+    if (i_template)
+    {
+        m3_FreeRuntime (i_template->runtime);
+        m3_Free (i_template);
+    }
+}
+
+
+IM3Module  m3_GetTemplateModule  (IM3ModuleTemplate i_template)
+{
+    return i_template ? i_template->module : NULL;
+}
+
+
+M3Result  m3_InstantiateTemplate  (IM3Runtime io_runtime, IM3ModuleTemplate i_template, IM3Module * o_module)
+{
+    IM3Module source = i_template->module;
+    IM3Module instance = NULL;
+
+_try {
+    _throwif ("runtime already holds a template instance", io_runtime->instance);
+    _throwif ("template belongs to another environment", io_runtime->environment != source->environment);
+
+    // once it's compiled, the template is only read: instances can then be created on any thread
+    if (not IsModuleCompiled (source))
+_       (m3_CompileModule (source));
+
+    instance = m3_AllocStruct (M3Module);
+    _throwifnull (instance);
+
+    // the parsed sections, names & types are shared; functions get their own structs so that the
+    // API can find the instance (and runtime) through them, but point at the shared compiled code
+    * instance = * source;
+
+    instance->isTemplate = false;
+    instance->templateModule = source;
+    instance->runtime = NULL;
+    instance->next = NULL;
+    instance->globals = NULL;
+    instance->droppedDataSegments = NULL;
+    instance->table0 = NULL;
+    instance->table0Size = 0;
+    instance->allFunctions = source->numFunctions;
+
+    instance->functions = NULL;
+
+    if (source->numFunctions)
+    {
+        instance->functions = m3_CopyMem (source->functions, source->numFunctions * sizeof (M3Function));
+        _throwifnull (instance->functions);
+
+        for (u32 i = 0; i < instance->numFunctions; ++i)
+            instance->functions [i].module = instance;
+    }
+
+    if (source->numGlobals)
+    {
+        instance->globals = m3_CopyMem (source->globals, source->numGlobals * sizeof (M3Global));
+        _throwifnull (instance->globals);
+    }
+
+_   (m3_LoadModule (io_runtime, instance));
+
+    io_runtime->instance = instance;
+    * o_module = instance;
+
+} _catch:
+
+    if (result)
+        m3_FreeModule (instance);
+
+    return result;
+}
+
+
 IM3Global  m3_FindGlobal  (IM3Module               io_module,
                            const char * const      i_globalName)
 {
@@ -853,10 +1692,31 @@ u8 *  GetStackPointerForArgs  (IM3Function i_function)
 
     stack += ftype->numRets;
 
+# if d_m3HasSIMD
+    // a v128 return takes two words
+    for (u32 i = 0; i < ftype->numRets; ++i)
+    {
+        if (IsVectorType (d_FuncRetType (ftype, i)))
+            stack++;
+    }
+# endif
+
     return (u8 *) stack;
 }
 
 
+static
+M3Result  RunCall  (IM3Runtime i_runtime, IM3Function i_function)
+{
+#if d_m3HasSuspend
+    if (i_runtime->fiber)
+        return RunSuspendableCall (i_runtime, i_function);
+#endif
+
+    return RunFunctionCode (i_runtime, i_function->compiled);
+}
+
+
 M3Result  m3_CallV  (IM3Function i_function, ...)
 {
     va_list ap;
@@ -887,6 +1747,12 @@ M3Result  m3_CallVL  (IM3Function i_function, va_list i_args)
         return m3Err_missingCompiledCode;
     }
 
+# if d_m3HasSuspend
+    if (IsSuspended (runtime)) {
+        return m3Err_runtimeSuspended;
+    }
+# endif
+
 # if d_m3RecordBacktraces
     ClearBacktrace (runtime);
 # endif
@@ -910,11 +1776,7 @@ _   (checkStartFunction(i_function->module))
         }
     }
 
-# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
-    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs, d_m3BaseCstr);
-# else
-    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs);
-# endif
+    result = RunCall (runtime, i_function);
     ReportNativeStackUsage ();
 
     runtime->lastCalled = result ? NULL : i_function;
@@ -936,6 +1798,12 @@ M3Result  m3_Call  (IM3Function i_function, uint32_t i_argc, const void * i_argp
         return m3Err_missingCompiledCode;
     }
 
+# if d_m3HasSuspend
+    if (IsSuspended (runtime)) {
+        return m3Err_runtimeSuspended;
+    }
+# endif
+
 # if d_m3RecordBacktraces
     ClearBacktrace (runtime);
 # endif
@@ -954,16 +1822,15 @@ _   (checkStartFunction(i_function->module))
 # if d_m3HasFloat
         case c_m3Type_f32:  *(f32*)(s) = *(f32*)i_argptrs[i];  s += 8; break;
         case c_m3Type_f64:  *(f64*)(s) = *(f64*)i_argptrs[i];  s += 8; break;
+# endif
+# if d_m3HasSIMD
+        case c_m3Type_v128: memcpy (s, i_argptrs[i], 16);      s += 16; break;
 # endif
         default: return "unknown argument type";
         }
     }
 
-# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
-    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs, d_m3BaseCstr);
-# else
-    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs);
-# endif
+    result = RunCall (runtime, i_function);
 
     ReportNativeStackUsage ();
 
@@ -986,6 +1853,12 @@ M3Result  m3_CallArgv  (IM3Function i_function, uint32_t i_argc, const char * i_
         return m3Err_missingCompiledCode;
     }
 
+# if d_m3HasSuspend
+    if (IsSuspended (runtime)) {
+        return m3Err_runtimeSuspended;
+    }
+# endif
+
 # if d_m3RecordBacktraces
     ClearBacktrace (runtime);
 # endif
@@ -1009,11 +1882,7 @@ _   (checkStartFunction(i_function->module))
         }
     }
 
-# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
-    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs, d_m3BaseCstr);
-# else
-    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs);
-# endif
+    result = RunCall (runtime, i_function);
     
     ReportNativeStackUsage ();
 
@@ -1052,6 +1921,9 @@ M3Result  m3_GetResults  (IM3Function i_function, uint32_t i_retc, const void *
 # if d_m3HasFloat
         case c_m3Type_f32:  *(f32*)o_retptrs[i] = *(f32*)(s); s += 8; break;
         case c_m3Type_f64:  *(f64*)o_retptrs[i] = *(f64*)(s); s += 8; break;
+# endif
+# if d_m3HasSIMD
+        case c_m3Type_v128: memcpy ((void *) o_retptrs[i], s, 16); s += 16; break;
 # endif
         default: return "unknown return type";
         }
@@ -1086,6 +1958,9 @@ M3Result  m3_GetResultsVL  (IM3Function i_function, va_list o_rets)
 # if d_m3HasFloat
         case c_m3Type_f32:  *va_arg(o_rets, f32*) = *(f32*)(s);  s += 8; break;
         case c_m3Type_f64:  *va_arg(o_rets, f64*) = *(f64*)(s);  s += 8; break;
+# endif
+# if d_m3HasSIMD
+        case c_m3Type_v128: memcpy (va_arg(o_rets, void*), s, 16); s += 16; break;
 # endif
         default: return "unknown argument type";
         }
@@ -12,6 +12,10 @@
 #include "m3_code.h"
 #include "m3_compile.h"
 
+#if d_m3HasPthreads
+#   include <pthread.h>
+#endif
+
 d_m3BeginExternC
 
 
@@ -22,6 +26,7 @@ typedef struct M3MemoryInfo
     u32     initPages;
     u32     maxPages;
     u32     pageSize;
+    bool    shared;
 }
 M3MemoryInfo;
 
@@ -33,6 +38,18 @@ typedef struct M3Memory
     u32                     numPages;
     u32                     maxPages;
     u32                     pageSize;
+
+#if d_m3HasThreads
+    struct M3SharedMemory * shared;         // set when the pages are shared with other runtimes; see m3_threads.c
+    struct M3Memory *       nextAttached;
+#endif
+
+#if d_m3HasSnapshots
+    struct M3MemoryImage *  checkpoint;         // see m3_CheckpointMemory
+#endif
+#if d_m3HasSnapshots && !d_m3UseGuardPages
+    size_t                  numMappedBytes;     // set once the memory was moved into a reservation to map an image over it; see m3_snapshot.c
+#endif
 }
 M3Memory;
 
@@ -75,6 +92,9 @@ typedef struct M3Global
 #if d_m3HasFloat
         f64 f64Value;
         f32 f32Value;
+#endif
+#if d_m3HasSIMD
+        m3v128_t v128Value;
 #endif
     };
 
@@ -111,6 +131,7 @@ typedef struct M3Module
 
     u32                     numDataSegments;
     M3DataSegment *         dataSegments;
+    bool *                  droppedDataSegments;    // per instance; active segments are dropped once they've been copied
 
     //u32                     importedGlobals;
     u32                     numGlobals;
@@ -122,6 +143,7 @@ typedef struct M3Module
 
     IM3Function *           table0;
     u32                     table0Size;
+    u32                     table0Version;          // changes with table0; see M3CallCache
     const char*             table0ExportName;
 
     M3MemoryInfo            memoryInfo;
@@ -130,6 +152,9 @@ typedef struct M3Module
     const char*             memoryExportName;
 
     //bool                    hasWasmCodeCopy;
+
+    bool                    isTemplate;             // compiled code is shared; per-instance state is reached through the runtime
+    struct M3Module *       templateModule;         // set for template instances, which only own their functions, globals & table
     
     u32                     numTags;
     M3Tag *                 tags;
@@ -156,16 +181,31 @@ typedef struct M3Environment
 
     IM3FuncType             funcTypes;                          // linked list of unique M3FuncType structs that can be compared using pointer-equivalence
 
-    IM3FuncType             retFuncTypes [c_m3Type_unknown];    // these 'point' to elements in the linked list above.
+    IM3FuncType             retFuncTypes [c_m3Type_v128 + 1];   // these 'point' to elements in the linked list above.
                                                                 // the number of elements must match the basic types as per M3ValueType
     M3CodePage *            pagesReleased;
 
+    IM3Compilation          compilationsReleased;               // pool of compiler scratch contexts (each is ~100KB with default limits)
+
+#if d_m3HasPthreads
+    pthread_mutex_t         lock;                               // guards funcTypes & the two pools above: the runtimes of an
+#endif                                                          // environment may load & compile on different threads
+
     M3SectionHandler        customSectionHandler;
+
+    char *                  codeCacheDirectory;                 // see m3_SetCodeCacheDirectory
+
+    u32 *                   gasCosts;                           // 256, by opcode byte; NULL unless metering (see m3_EnableGasMetering)
 }
 M3Environment;
 
 void                        Environment_Release         (IM3Environment i_environment);
 
+// compilation contexts are only needed while compiling, so they're pooled per environment rather than held by each runtime.
+// any thread may acquire & release them (see M3Environment.lock)
+IM3Compilation              Environment_AcquireCompilation  (IM3Environment i_environment);
+void                        Environment_ReleaseCompilation  (IM3Environment i_environment, IM3Compilation i_compilation);
+
 // takes ownership of io_funcType and returns a pointer to the persistent version (could be same or different)
 void                        Environment_AddFuncType     (IM3Environment i_environment, IM3FuncType * io_funcType);
 
@@ -173,8 +213,6 @@ void                        Environment_AddFuncType     (IM3Environment i_enviro
 
 typedef struct M3Runtime
 {
-    M3Compilation           compilation;
-
     IM3Environment          environment;
 
     M3CodePage *            pagesOpen;      // linked list of code pages with writable space on them
@@ -184,6 +222,8 @@ typedef struct M3Runtime
     u32                     numActiveCodePages;
 
     IM3Module               modules;        // linked list of imported modules
+    IM3Module               instance;       // the module template instance loaded into this runtime, if any
+    M3CodeSites             templateCalls;  // a template runtime's op_Compile sites, linked once its module is compiled
 
     void *                  stack;
     void *                  originStack;
@@ -196,6 +236,18 @@ typedef struct M3Runtime
     M3Memory                memory;
     u32                     memoryLimit;
 
+    i64                     gasLeft;        // op_UseGas charges this; negative once it has run out
+    i64                     gasLimit;
+
+    u64                     callCacheHits;  // see m3_GetCallCacheCounts
+    u64                     callCacheMisses;
+
+    volatile u32            interrupted;    // see m3_InterruptRuntime; op_Loop & function entry poll it
+#if d_m3HasPthreads
+    i64                     deadline;       // monotonic ns; see m3_SetDeadline
+    u32                     deadlineIndex;  // 1 + its place in the watchdog's heap; 0 when no deadline is armed
+#endif
+
 #if d_m3EnableStrace >= 2
     u32                     callDepth;
 #endif
@@ -210,13 +262,44 @@ typedef struct M3Runtime
 #endif
 
 	u32						newCodePageSequence;
+
+#if d_m3HasSuspend
+    struct M3Fiber *        fiber;          // see m3_EnableSuspension
+#endif
+
+#if d_m3HasJit
+    struct M3Jit *          jit;            // see m3_EnableJit
+    u32                     tierThreshold;  // see m3_EnableTiering; 0 translates functions as they're compiled
+#endif
 }
 M3Runtime;
 
+typedef struct M3ModuleTemplate
+{
+    IM3Runtime              runtime;        // owns the template module and the shared code pages; never executes
+    IM3Module               module;
+}
+M3ModuleTemplate;
+
+//---------------------------------------------------------------------------------------------------------------------------------
+
 void                        InitRuntime                 (IM3Runtime io_runtime, u32 i_stackSizeInBytes);
 void                        Runtime_Release             (IM3Runtime io_runtime);
 
 M3Result                    ResizeMemory                (IM3Runtime io_runtime, u32 i_numPages);
+void                        FreeMemory                  (IM3Memory io_memory);
+
+#if d_m3UseGuardPages
+// a guarded linear memory is a page holding the M3MemoryHeader followed by this much reserved address space
+extern const size_t         c_m3GuardRegionSize;
+
+M3Result                    InstallMemoryFaultHandler   (void);
+
+// installs the thread's chain of fault handling frames, returning the one it replaces (a fiber keeps a chain of its own)
+void *                      SwapFaultContext            (void * i_context);
+#endif
+
+M3Result                    RunFunctionCode             (IM3Runtime i_runtime, pc_t i_pc);
 
 typedef void *              (* ModuleVisitor)           (IM3Module i_module, void * i_info);
 void *                      ForEachModule               (IM3Runtime i_runtime, ModuleVisitor i_visitor, void * i_info);
@@ -226,6 +309,7 @@ void *                      v_FindFunction              (IM3Module i_module, con
 IM3CodePage                 AcquireCodePage             (IM3Runtime io_runtime);
 IM3CodePage                 AcquireCodePageWithCapacity (IM3Runtime io_runtime, u32 i_lineCount);
 void                        ReleaseCodePage             (IM3Runtime io_runtime, IM3CodePage i_codePage);
+void                        ReleaseCodePageNoTrack      (IM3Runtime io_runtime, IM3CodePage i_codePage);
 
 d_m3EndExternC
 
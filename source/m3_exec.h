@@ -31,32 +31,43 @@
 #include "m3_env.h"
 #include "m3_info.h"
 #include "m3_exec_defs.h"
+#include "m3_threads.h"
 
 #include <limits.h>
 
 d_m3BeginExternC
 
-# define rewrite_op(OP)             * ((void **) (_pc-1)) = (void*)(OP)
+# define rewrite_op(OP)             * ((code_t *) (_pc-1)) = d_m3OperationWord (OP)
 
-# define immediate(TYPE)            * ((TYPE *) _pc++)
-# define skip_immediate(TYPE)       (_pc++)
+// with d_m3CompactCode a pointer immediate takes two lines
+# define immediate(TYPE)            * ((TYPE *) ((_pc += d_m3CodeLines (TYPE)) - d_m3CodeLines (TYPE)))
+# define skip_immediate(TYPE)       (_pc += d_m3CodeLines (TYPE))
 
 # define slot(TYPE)                 * (TYPE *) (_sp + immediate (i32))
 # define slot_ptr(TYPE)             (TYPE *) (_sp + immediate (i32))
 
 
 # if d_m3EnableOpProfiling
-                                    d_m3RetSig  profileOp   (d_m3OpSig, cstr_t i_operationName);
-#   define nextOp()                 M3_MUSTTAIL return profileOp (d_m3OpAllArgs, __FUNCTION__)
+                                    d_m3RetSig  profileOp   (d_m3OperationSig, cstr_t i_operationName);
+#   define nextOp()                 M3_MUSTTAIL return profileOp (d_m3OperationArgs, __FUNCTION__)
 # elif d_m3EnableOpTracing
-                                    d_m3RetSig  debugOp     (d_m3OpSig, cstr_t i_operationName);
-#   define nextOp()                 M3_MUSTTAIL return debugOp (d_m3OpAllArgs, __FUNCTION__)
+                                    d_m3RetSig  debugOp     (d_m3OperationSig, cstr_t i_operationName);
+#   define nextOp()                 M3_MUSTTAIL return debugOp (d_m3OperationArgs, __FUNCTION__)
 # else
 #   define nextOp()                 nextOpDirect()
 # endif
 
 #define jumpOp(PC)                  jumpOpDirect(PC)
 
+// iterates the loop whose id (the first op of its body) is LOOP_ID; see op_Loop. this is where an interrupt is noticed
+# if d_m3FlattenLoops
+#   define continueLoop(LOOP_ID)    {   m3ret_t interrupted = CheckInterrupt (m3MemRuntime (_mem));     \
+                                        if (M3_UNLIKELY(interrupted)) newTrap (interrupted);            \
+                                        jumpOp (LOOP_ID);   }
+# else
+#   define continueLoop(LOOP_ID)    return (LOOP_ID)
+# endif
+
 #if d_m3RecordBacktraces
     #define pushBacktraceFrame()            (PushBacktraceFrame (_mem->runtime, _pc - 1))
     #define fillBacktraceFrame(FUNCTION)    (FillBacktraceFunctionInfo (_mem->runtime, function))
@@ -117,9 +128,18 @@ d_m3RetSig  Call  (d_m3OpSig)
     m3ret_t possible_trap = m3_Yield ();
     if (M3_UNLIKELY(possible_trap)) return possible_trap;
 
-    nextOpDirect();
+    d_m3StartDispatch ();
 }
 
+# if d_m3DispatchLoop
+// the ops below reach the registers through the M3OpState of the dispatch loop
+#   define _pc                      (_state->pc)
+#   define _sp                      (_state->sp)
+#   define _mem                     (_state->mem)
+#   define _r0                      (_state->r0)
+#   define _fp0                     (_state->fp0)
+# endif
+
 // TODO: OK, this needs some explanation here ;0
 
 #define d_m3CommutativeOpMacro(RES, REG, TYPE, NAME, OP, ...) \
@@ -247,6 +267,40 @@ d_m3OpMacro_i(i32, Remainder, OP_REM_S, INT32_MIN);
 d_m3OpMacro_i(u64, Remainder, OP_REM_U);
 d_m3OpMacro_i(i64, Remainder, OP_REM_S, INT64_MIN);
 
+// signed division & remainder by a constant, which the compiler has found the magic number & shift for. a 64-bit
+// immediate takes two lines on a 32-bit host or with d_m3CompactCode (see EmitWord64)
+#define d_m3DivisionConstants_32                                \
+    i32 magic = immediate (i32);                                \
+    i32 divisor = immediate (i32);                              \
+    u32 shift = immediate (u32);
+
+#define d_m3DivisionConstants_64                                \
+    i64 magic, divisor;                                         \
+    memcpy (& magic, _pc, sizeof (magic));                      \
+    _pc += d_m3CodeLines (u64);                                 \
+    memcpy (& divisor, _pc, sizeof (divisor));                  \
+    _pc += d_m3CodeLines (u64);                                 \
+    u32 shift = immediate (u32);
+
+#define d_m3ByConstantOp(TYPE, NAME, BITS, FUNC)                \
+d_m3Op(TYPE##_##NAME##Constant_r)                               \
+{                                                               \
+    TYPE operand = (TYPE) _r0;                                  \
+    d_m3DivisionConstants_##BITS                                \
+    _r0 = FUNC (operand, magic, divisor, shift);                \
+    nextOp ();                                                  \
+}                                                               \
+d_m3Op(TYPE##_##NAME##Constant_s)                               \
+{                                                               \
+    TYPE operand = slot (TYPE);                                 \
+    d_m3DivisionConstants_##BITS                                \
+    _r0 = FUNC (operand, magic, divisor, shift);                \
+    nextOp ();                                                  \
+}
+
+d_m3ByConstantOp (i32, Divide,      32, div_const_i32)      d_m3ByConstantOp (i64, Divide,      64, div_const_i64)
+d_m3ByConstantOp (i32, Remainder,   32, rem_const_i32)      d_m3ByConstantOp (i64, Remainder,   64, rem_const_i64)
+
 #if d_m3HasFloat
 d_m3OpFunc_f(f32, Min, min_f32);
 d_m3OpFunc_f(f32, Max, max_f32);
@@ -257,6 +311,64 @@ d_m3OpFunc_f(f32, CopySign, copysignf);
 d_m3OpFunc_f(f64, CopySign, copysign);
 #endif
 
+
+// Superinstructions: a binary op fused with the slot store that consumes its result (see c_setSlotFusions).
+// The result still lands in the register; it's also stored to the slot that trails the operands.
+#if d_m3FuseOperations
+
+#define d_m3CommutativeSetSlotOpMacro(RES, REG, TYPE, NAME, OP, ...) \
+d_m3Op(TYPE##_##NAME##_rs_SetSlot)                      \
+{                                                       \
+    TYPE operand = slot (TYPE);                         \
+    OP((RES), operand, ((TYPE) REG), ##__VA_ARGS__);    \
+    slot (TYPE) = (TYPE) RES;                           \
+    nextOp ();                                          \
+}                                                       \
+d_m3Op(TYPE##_##NAME##_ss_SetSlot)                      \
+{                                                       \
+    TYPE operand2 = slot (TYPE);                        \
+    TYPE operand1 = slot (TYPE);                        \
+    OP((RES), operand1, operand2, ##__VA_ARGS__);       \
+    slot (TYPE) = (TYPE) RES;                           \
+    nextOp ();                                          \
+}
+
+#define d_m3SetSlotOpMacro(RES, REG, TYPE, NAME, OP, ...) \
+d_m3Op(TYPE##_##NAME##_sr_SetSlot)                      \
+{                                                       \
+    TYPE operand = slot (TYPE);                         \
+    OP((RES), ((TYPE) REG), operand, ##__VA_ARGS__);    \
+    slot (TYPE) = (TYPE) RES;                           \
+    nextOp ();                                          \
+}                                                       \
+d_m3CommutativeSetSlotOpMacro(RES, REG, TYPE, NAME, OP, ##__VA_ARGS__)
+
+#define d_m3CommutativeSetSlotOpFunc_i(TYPE, NAME, OP)  d_m3CommutativeSetSlotOpMacro   ( _r0,  _r0, TYPE, NAME, M3_FUNC, OP)
+#define d_m3SetSlotOpFunc_i(TYPE, NAME, OP)             d_m3SetSlotOpMacro              ( _r0,  _r0, TYPE, NAME, M3_FUNC, OP)
+#define d_m3CommutativeSetSlotOp_i(TYPE, NAME, OP)      d_m3CommutativeSetSlotOpMacro   ( _r0,  _r0, TYPE, NAME, M3_OPER, OP)
+#define d_m3CommutativeSetSlotOp_f(TYPE, NAME, OP)      d_m3CommutativeSetSlotOpMacro   (_fp0, _fp0, TYPE, NAME, M3_OPER, OP)
+#define d_m3SetSlotOp_f(TYPE, NAME, OP)                 d_m3SetSlotOpMacro              (_fp0, _fp0, TYPE, NAME, M3_OPER, OP)
+
+d_m3CommutativeSetSlotOpFunc_i (i32, Add,       OP_ADD_32)  d_m3CommutativeSetSlotOpFunc_i (i64, Add,       OP_ADD_64)
+d_m3CommutativeSetSlotOpFunc_i (i32, Multiply,  OP_MUL_32)  d_m3CommutativeSetSlotOpFunc_i (i64, Multiply,  OP_MUL_64)
+d_m3SetSlotOpFunc_i (i32, Subtract,             OP_SUB_32)  d_m3SetSlotOpFunc_i (i64, Subtract,             OP_SUB_64)
+
+d_m3SetSlotOpFunc_i (u32, ShiftLeft,            OP_SHL_32)  d_m3SetSlotOpFunc_i (u64, ShiftLeft,            OP_SHL_64)
+d_m3SetSlotOpFunc_i (i32, ShiftRight,           OP_SHR_32)  d_m3SetSlotOpFunc_i (i64, ShiftRight,           OP_SHR_64)
+d_m3SetSlotOpFunc_i (u32, ShiftRight,           OP_SHR_32)  d_m3SetSlotOpFunc_i (u64, ShiftRight,           OP_SHR_64)
+
+d_m3CommutativeSetSlotOp_i (u32, And,           &)          d_m3CommutativeSetSlotOp_i (u64, And,           &)
+d_m3CommutativeSetSlotOp_i (u32, Or,            |)          d_m3CommutativeSetSlotOp_i (u64, Or,            |)
+d_m3CommutativeSetSlotOp_i (u32, Xor,           ^)          d_m3CommutativeSetSlotOp_i (u64, Xor,           ^)
+
+#if d_m3HasFloat
+d_m3CommutativeSetSlotOp_f (f32, Add,           +)          d_m3CommutativeSetSlotOp_f (f64, Add,           +)
+d_m3CommutativeSetSlotOp_f (f32, Multiply,      *)          d_m3CommutativeSetSlotOp_f (f64, Multiply,      *)
+d_m3SetSlotOp_f (f32, Subtract,                 -)          d_m3SetSlotOp_f (f64, Subtract,                 -)
+#endif
+
+#endif // d_m3FuseOperations
+
 // Unary operations
 // Note: This macro follows the principle of d_m3OpMacro
 
@@ -571,52 +683,74 @@ d_m3Op  (CallIndirect)
     IM3Module module            = immediate (IM3Module);
     IM3FuncType type            = immediate (IM3FuncType);
     i32 stackOffset             = immediate (i32);
+    M3CallCache * cache         = (M3CallCache *) _pc;
     IM3Memory memory            = m3MemInfo (_mem);
+    IM3Runtime runtime          = m3MemRuntime (_mem);
+
+    skip_immediate (M3CallCache);
 
     m3stack_t sp = _sp + stackOffset;
 
     m3ret_t r = m3Err_none;
+    pc_t callPC = NULL;
 
-    if (M3_LIKELY(tableIndex < module->table0Size))
+    // the callee's type was checked when the cache was filled
+    if (M3_LIKELY(module and tableIndex == cache->tableIndex and module->table0Version == cache->tableVersion))
     {
-        IM3Function function = module->table0 [tableIndex];
+        callPC = cache->compiled;
+        runtime->callCacheHits++;
+    }
+    else
+    {
+        // shared template code has no module; the table belongs to the executing instance
+        IM3Module instance = module ? module : runtime->instance;
 
-        if (M3_LIKELY(function))
+        runtime->callCacheMisses++;
+
+        if (M3_LIKELY(tableIndex < instance->table0Size))
         {
-            if (M3_LIKELY(type == function->funcType))
-            {
-                if (M3_UNLIKELY(not function->compiled))
-                    r = CompileFunction (function);
+            IM3Function function = instance->table0 [tableIndex];
 
-                if (M3_LIKELY(not r))
+            if (M3_LIKELY(function))
+            {
+                if (M3_LIKELY(type == function->funcType))
                 {
-
-# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
-                    r = Call (function->compiled, sp, _mem, d_m3OpDefaultArgs, d_m3BaseCstr);
-# else
-                    r = Call (function->compiled, sp, _mem, d_m3OpDefaultArgs);
-# endif
-
-                    _mem = memory->mallocated;
+                    if (M3_UNLIKELY(not function->compiled))
+                        r = CompileFunction (function);
 
                     if (M3_LIKELY(not r))
-                        nextOpDirect ();
-                    else
                     {
-                        pushBacktraceFrame ();
-                        forwardTrap (r);
+                        callPC = function->compiled;
+
+                        if (module)
+                            * cache = (M3CallCache) { tableIndex, module->table0Version, callPC };
                     }
                 }
+                else r = m3Err_trapIndirectCallTypeMismatch;
             }
-            else r = m3Err_trapIndirectCallTypeMismatch;
+            else r = m3Err_trapTableElementIsNull;
         }
-        else r = m3Err_trapTableElementIsNull;
+        else r = m3Err_trapTableIndexOutOfRange;
+
+        if (M3_UNLIKELY(r))
+            newTrap (r);
     }
-    else r = m3Err_trapTableIndexOutOfRange;
 
-    if (M3_UNLIKELY(r))
-        newTrap (r);
-    else forwardTrap (r);
+# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
+    r = Call (callPC, sp, _mem, d_m3OpDefaultArgs, d_m3BaseCstr);
+# else
+    r = Call (callPC, sp, _mem, d_m3OpDefaultArgs);
+# endif
+
+    _mem = memory->mallocated;
+
+    if (M3_LIKELY(not r))
+        nextOpDirect ();
+    else
+    {
+        pushBacktraceFrame ();
+        forwardTrap (r);
+    }
 }
 
 
@@ -626,7 +760,7 @@ d_m3Op  (CallRawFunction)
 
     M3ImportContext ctx;
 
-    M3RawCall call = (M3RawCall) (* _pc++);
+    M3RawCall call = immediate (M3RawCall);
     ctx.function = immediate (IM3Function);
     ctx.userdata = immediate (void *);
     u64* const sp = ((u64*)_sp);
@@ -709,6 +843,16 @@ d_m3Op  (MemGrow)
     IM3Memory memory            = & runtime->memory;
 
     i32 numPagesToGrow = _r0;
+
+#if d_m3HasThreads
+    if (memory->shared)
+    {
+        // the pages aren't moved, so _mem stays valid
+        _r0 = (numPagesToGrow >= 0) ? GrowSharedMemory (memory, numPagesToGrow) : -1;
+        nextOp ();
+    }
+#endif
+
     if (numPagesToGrow >= 0) {
         _r0 = memory->numPages;
 
@@ -770,6 +914,48 @@ d_m3Op  (MemFill)
 }
 
 
+d_m3Op  (MemInit)
+{
+    u32 size = (u32) _r0;
+    u64 source = slot (u32);
+    u64 destination = slot (u32);
+    IM3Module module = immediate (IM3Module);
+    u32 segmentIndex = immediate (u32);
+
+    if (not module)
+        module = m3MemRuntime (_mem)->instance;
+
+    M3DataSegment * segment = & module->dataSegments [segmentIndex];
+    u64 segmentSize = module->droppedDataSegments [segmentIndex] ? 0 : segment->size;
+
+    if (M3_LIKELY(destination + size <= _mem->length))
+    {
+        if (M3_LIKELY(source + size <= segmentSize))
+        {
+            memcpy (m3MemData (_mem) + destination, segment->data + source, size);
+
+            nextOp ();
+        }
+        else d_outOfBoundsMemOp (source, size);
+    }
+    else d_outOfBoundsMemOp (destination, size);
+}
+
+
+d_m3Op  (DataDrop)
+{
+    IM3Module module = immediate (IM3Module);
+    u32 segmentIndex = immediate (u32);
+
+    if (not module)
+        module = m3MemRuntime (_mem)->instance;
+
+    module->droppedDataSegments [segmentIndex] = true;
+
+    nextOp ();
+}
+
+
 // it's a debate: should the compilation be trigger be the caller or callee page.
 // it's a much easier to put it in the caller pager. if it's in the callee, either the entire page
 // has be left dangling or it's just a stub that jumps to a newly acquired page.  In Gestalt, I opted
@@ -789,7 +975,8 @@ d_m3Op  (Compile)
     if (not result)
     {
         // patch up compiled pc and call rewritten op_Call
-        * ((void**) --_pc) = (void*) (function->compiled);
+        _pc -= d_m3CodeLines (IM3Function);
+        * ((pc_t *) _pc) = function->compiled;
         --_pc;
         nextOpDirect ();
     }
@@ -799,6 +986,38 @@ d_m3Op  (Compile)
 
 
 
+// m3_InterruptRuntime raises the flag; it's polled at function entry & when a loop is about to iterate again.
+// the trap consumes it
+static inline
+m3ret_t  CheckInterrupt  (IM3Runtime io_runtime)
+{
+    if (M3_UNLIKELY(io_runtime->interrupted))
+    {
+        io_runtime->interrupted = 0;
+        return m3Err_trapInterrupted;
+    }
+
+    return m3Err_none;
+}
+
+
+// only the locals that might be read before they're written are zeroed (see NoteLocalRead). i_copyConstants is
+// false for translated code, which stores its constants itself
+static inline
+void  InitFunctionFrame  (IM3Function i_function, m3stack_t i_sp, bool i_copyConstants)
+{
+    u8 * locals = (u8 *) ((m3slot_t *) i_sp + i_function->numRetAndArgSlots);
+
+    if (i_function->numZeroedLocalBytes)
+        memset (locals + i_function->firstZeroedLocalByte, 0x0, i_function->numZeroedLocalBytes);
+
+    if (i_copyConstants and i_function->constants)
+    {
+        memcpy (locals + i_function->numLocalBytes, i_function->constants, i_function->numConstantBytes);
+    }
+}
+
+
 d_m3Op  (Entry)
 {
     d_m3ClearRegisters
@@ -808,6 +1027,10 @@ d_m3Op  (Entry)
     IM3Function function = immediate (IM3Function);
     IM3Memory memory = m3MemInfo (_mem);
 
+    m3ret_t interrupted = CheckInterrupt (m3MemRuntime (_mem));
+    if (M3_UNLIKELY(interrupted))
+        newTrap (interrupted);
+
 #if d_m3SkipStackCheck
     if (true)
 #else
@@ -817,15 +1040,7 @@ d_m3Op  (Entry)
 #if defined(DEBUG)
         function->hits++;
 #endif
-        u8 * stack = (u8 *) ((m3slot_t *) _sp + function->numRetAndArgSlots);
-
-        memset (stack, 0x0, function->numLocalBytes);
-        stack += function->numLocalBytes;
-
-        if (function->constants)
-        {
-            memcpy (stack, function->constants, function->numConstantBytes);
-        }
+        InitFunctionFrame (function, _sp, true);
 
 #if d_m3EnableStrace >= 2
         d_m3TracePrint("%s %s {", m3_GetFunctionName(function), SPrintFunctionArgList (function, _sp + function->numRetSlots));
@@ -861,6 +1076,202 @@ d_m3Op  (Entry)
 }
 
 
+#if d_m3HasJit
+// replaces op_Entry once m3_jit.c has translated the function. the native body has the signature of an op &
+// runs until the function returns or traps
+d_m3Op  (JitEntry)
+{
+    IM3Function function = immediate (IM3Function);
+    IM3Memory memory = m3MemInfo (_mem);
+
+    m3ret_t interrupted = CheckInterrupt (m3MemRuntime (_mem));
+    if (M3_UNLIKELY(interrupted))
+        newTrap (interrupted);
+
+#if d_m3SkipStackCheck
+    if (true)
+#else
+    if (M3_LIKELY ((void *) (_sp + function->maxStackSlots) < _mem->maxStack))
+#endif
+    {
+        InitFunctionFrame (function, _sp, false);
+
+        m3ret_t r = ((IM3Operation) function->native) (_pc, d_m3OpArgs);
+
+        if (M3_UNLIKELY(r)) {
+            _mem = memory->mallocated;
+            fillBacktraceFrame ();
+        }
+        forwardTrap (r);
+    }
+    else newTrap (m3Err_trapStackOverflow);
+}
+
+
+// heads a function body & each loop body while the runtime is tiering (see m3_EnableTiering). the function is
+// recompiled & translated in here once it's hot; the rest of this call still runs the code it's in
+d_m3Op  (CountHotness)
+{
+    IM3Function function = immediate (IM3Function);
+
+    if (M3_UNLIKELY(++function->hotness >= function->module->runtime->tierThreshold and not function->tier))
+        TierUpFunction (function);
+
+    nextOp ();
+}
+
+
+// replaces the op_Entry of code that's been recompiled, so call sites still pointing at it forward to the new code
+d_m3Op  (Recompiled)
+{
+    IM3Function function = immediate (IM3Function);
+
+    jumpOp (function->compiled);
+}
+#endif
+
+
+// return_call reuses the caller's frame: the outgoing arguments are moved down to the frame base
+// and execution jumps straight into the callee's body, past its op_Entry. the original op_Entry's
+// native frame is the only one on the C stack, so tail-recursive code runs in constant space.
+static inline
+m3ret_t  PrepareTailCallFrame  (IM3Function i_function, m3stack_t i_sp, m3stack_t i_args, M3MemoryHeader * i_mem)
+{
+    if (M3_UNLIKELY(not i_function->compiled))
+    {
+        M3Result result = CompileFunction (i_function);
+        if (result)
+            return result;
+    }
+
+    // the jump skips the callee's op_Entry, so a tail-recursive loop has to be polled here
+    m3ret_t interrupted = CheckInterrupt (m3MemRuntime (i_mem));
+    if (M3_UNLIKELY(interrupted))
+        return interrupted;
+
+#if !d_m3SkipStackCheck
+    if (M3_UNLIKELY ((void *) (i_sp + i_function->maxStackSlots) >= i_mem->maxStack))
+        return m3Err_trapStackOverflow;
+#endif
+
+    u16 numRetSlots = i_function->numRetSlots;
+    memmove (i_sp + numRetSlots, i_args + numRetSlots, (i_function->numRetAndArgSlots - numRetSlots) * sizeof (m3slot_t));
+
+    InitFunctionFrame (i_function, i_sp, true);
+
+    return m3_Yield ();
+}
+
+// CompileFunction always emits op_Entry + IM3Function at the very start of the compiled code
+# define d_m3FunctionBody(FUNCTION)     ((FUNCTION)->compiled + 1 + d_m3CodeLines (IM3Function))
+
+
+d_m3Op  (ReturnCall)
+{
+    IM3Function function        = immediate (IM3Function);
+    i32 stackOffset             = immediate (i32);
+
+    m3ret_t r = PrepareTailCallFrame (function, _sp, _sp + stackOffset, _mem);
+
+    if (M3_LIKELY(not r))
+    {
+        d_m3ClearRegisters
+        jumpOp (d_m3FunctionBody (function));
+    }
+    else newTrap (r);
+}
+
+
+d_m3Op  (ReturnCallIndirect)
+{
+    u32 tableIndex              = slot (u32);
+    IM3Module module            = immediate (IM3Module);
+    IM3FuncType type            = immediate (IM3FuncType);
+    i32 stackOffset             = immediate (i32);
+    IM3Memory memory            = m3MemInfo (_mem);
+
+    m3stack_t sp = _sp + stackOffset;
+
+    m3ret_t r = m3Err_none;
+
+    if (M3_UNLIKELY(not module))                // shared template code; the table belongs to the executing instance
+        module = m3MemRuntime (_mem)->instance;
+
+    if (M3_LIKELY(tableIndex < module->table0Size))
+    {
+        IM3Function function = module->table0 [tableIndex];
+
+        if (M3_LIKELY(function))
+        {
+            if (M3_LIKELY(type == function->funcType))
+            {
+                if (M3_LIKELY(not (function->import.moduleUtf8 or function->import.fieldUtf8)))
+                {
+                    r = PrepareTailCallFrame (function, _sp, sp, _mem);
+
+                    if (M3_LIKELY(not r))
+                    {
+                        d_m3ClearRegisters
+                        jumpOp (d_m3FunctionBody (function));
+                    }
+                }
+                else
+                {
+                    // host functions have no frame to reuse; call through and hand back the results
+                    if (M3_UNLIKELY(not function->compiled))
+                        r = CompileFunction (function);
+
+                    if (M3_UNLIKELY(r))
+                        newTrap (r);
+
+# if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
+                    r = Call (function->compiled, sp, _mem, d_m3OpDefaultArgs, d_m3BaseCstr);
+# else
+                    r = Call (function->compiled, sp, _mem, d_m3OpDefaultArgs);
+# endif
+
+                    if (M3_LIKELY(not r))
+                    {
+                        // results are laid out like the io slots of a compiled function: a v128 takes two u64s
+                        u32 numResultBytes = 0;
+                        for (u16 i = 0; i < type->numRets; ++i)
+                            numResultBytes += IsVectorType (type->types [i]) ? 2 * sizeof (u64) : sizeof (u64);
+
+                        memmove (_sp, sp, numResultBytes);
+                        return m3Err_none;
+                    }
+                    else
+                    {
+                        _mem = memory->mallocated;
+                        pushBacktraceFrame ();
+                        forwardTrap (r);
+                    }
+                }
+            }
+            else r = m3Err_trapIndirectCallTypeMismatch;
+        }
+        else r = m3Err_trapTableElementIsNull;
+    }
+    else r = m3Err_trapTableIndexOutOfRange;
+
+    newTrap (r);
+}
+
+
+# if d_m3FlattenLoops
+
+// a loop is iterated by op_ContinueLoop jumping back to the first op of its body, the loop id. the memory pointer
+// is refreshed by the ops that can move it (calls & memory.grow), so there's nothing to do when the loop is entered
+d_m3Op  (Loop)
+{
+    nextOp ();
+}
+
+# else
+
+// op_Loop calls its body until it returns something other than the loop id (the first op of the body), which is
+// what op_ContinueLoop returns to iterate again. each iteration unwinds the native stack, whether or not the C
+// compiler eliminates tail calls
 d_m3Op  (Loop)
 {
     d_m3TracePrepare
@@ -872,6 +1283,9 @@ d_m3Op  (Loop)
     m3ret_t r;
 
     IM3Memory memory = m3MemInfo (_mem);
+    IM3Runtime runtime = m3MemRuntime (_mem);
+
+    pc_t loopPC = _pc;      // op_ContinueLoop returns this. (with d_m3DispatchLoop, the body moves _pc along)
 
     do
     {
@@ -879,6 +1293,7 @@ d_m3Op  (Loop)
         d_m3TracePrint("iter {");
         trace_rt->callDepth++;
 #endif
+        _pc = loopPC;
         r = nextOpImpl ();
 
 #if d_m3EnableStrace >= 3
@@ -888,16 +1303,31 @@ d_m3Op  (Loop)
         // linear memory pointer needs refreshed here because the block it's looping over
         // can potentially invoke the grow operation.
         _mem = memory->mallocated;
+
+        if (M3_UNLIKELY(r == loopPC and runtime->interrupted))
+            r = CheckInterrupt (runtime);
     }
-    while (r == _pc);
+    while (r == loopPC);
 
     forwardTrap (r);
 }
 
+# endif // d_m3FlattenLoops
+
+
+#if d_m3HasJit
+// what m3_jit.c patches op_Loop & the back-edges of a translated loop to, so that code the translation hands back to
+// the interpreter returns to the native loop at the next iteration. _pc is the loop id
+d_m3Op  (JitLoop)
+{
+    return _pc;
+}
+#endif
+
 
 d_m3Op  (Branch)
 {
-    jumpOp (* _pc);
+    jumpOp (* (pc_t *) _pc);
 }
 
 d_m3Op  (Try)
@@ -1117,6 +1547,34 @@ d_m3Op  (Select_##TYPE##_sss)                   \
 d_m3Select_i (i32, _r0)
 d_m3Select_i (i64, _r0)
 
+#if d_m3FuseOperations
+
+// select fused with the slot store that consumes its result; the destination slot trails the operands
+#define d_m3SelectSetSlot_i(TYPE, REG, FORM, CONDITION, OPERAND2, OPERAND1) \
+d_m3Op  (Select_##TYPE##_##FORM##_SetSlot)      \
+{                                               \
+    i32 condition = CONDITION;                  \
+                                                \
+    TYPE operand2 = OPERAND2;                   \
+    TYPE operand1 = OPERAND1;                   \
+                                                \
+    REG = (condition) ? operand1 : operand2;    \
+    slot (TYPE) = (TYPE) REG;                   \
+                                                \
+    nextOp ();                                  \
+}
+
+#define d_m3SelectSetSlotForms_i(TYPE, REG)                                                         \
+d_m3SelectSetSlot_i (TYPE, REG, rss, (i32) REG,     slot (TYPE),    slot (TYPE))                    \
+d_m3SelectSetSlot_i (TYPE, REG, srs, slot (i32),    (TYPE) REG,     slot (TYPE))                    \
+d_m3SelectSetSlot_i (TYPE, REG, ssr, slot (i32),    slot (TYPE),    (TYPE) REG)                     \
+d_m3SelectSetSlot_i (TYPE, REG, sss, slot (i32),    slot (TYPE),    slot (TYPE))
+
+d_m3SelectSetSlotForms_i (i32, _r0)
+d_m3SelectSetSlotForms_i (i64, _r0)
+
+#endif // d_m3FuseOperations
+
 
 #define d_m3Select_f(TYPE, REG, LABEL, SELECTOR)  \
 d_m3Op  (Select_##TYPE##_##LABEL##ss)           \
@@ -1232,24 +1690,115 @@ d_m3Op  (ContinueLoop)
     // OR it can go in the Loop operation. I think it's best to do here. adding code to the loop operation
     // has the potential to increase its native-stack usage. (don't forget ContinueLoopIf too.)
 
-    void * loopId = immediate (void *);
-    return loopId;
+    pc_t loopId = immediate (pc_t);
+    continueLoop (loopId);
+}
+
+
+d_m3Op  (UseGas)
+{
+    IM3Runtime runtime = m3MemRuntime (_mem);
+
+    i64 gasLeft = runtime->gasLeft - immediate (u32);
+    runtime->gasLeft = gasLeft;
+
+    if (M3_UNLIKELY (gasLeft < 0))
+        newTrap (m3Err_trapOutOfGas);
+
+    nextOp ();
 }
 
 
 d_m3Op  (ContinueLoopIf)
 {
     i32 condition = (i32) _r0;
-    void * loopId = immediate (void *);
+    pc_t loopId = immediate (pc_t);
 
     if (condition)
     {
-        return loopId;
+        continueLoop (loopId);
     }
     else nextOp ();
 }
 
 
+// Compare-and-branch superinstructions (see c_branchFusions). The operands are read like the comparison's own;
+// the branch target trails them. If_* doubles as the BranchIfPrologue: both skip ahead when the condition fails.
+#if d_m3FuseOperations
+
+#define d_m3BranchOnCondition(FORM, TYPE, NAME, OPERANDS, CONDITION) \
+d_m3Op  (BranchIf_##TYPE##_##NAME##_##FORM)             \
+{                                                       \
+    OPERANDS;                                           \
+    pc_t branch = immediate (pc_t);                     \
+                                                        \
+    if (CONDITION)                                      \
+    {                                                   \
+        jumpOp (branch);                                \
+    }                                                   \
+    else nextOp ();                                     \
+}                                                       \
+d_m3Op  (If_##TYPE##_##NAME##_##FORM)                   \
+{                                                       \
+    OPERANDS;                                           \
+    pc_t elsePC = immediate (pc_t);                     \
+                                                        \
+    if (CONDITION)                                      \
+        nextOp ();                                      \
+    else                                                \
+        jumpOp (elsePC);                                \
+}                                                       \
+d_m3Op  (ContinueLoopIf_##TYPE##_##NAME##_##FORM)       \
+{                                                       \
+    OPERANDS;                                           \
+    pc_t loopId = immediate (pc_t);                     \
+                                                        \
+    if (CONDITION)                                      \
+    {                                                   \
+        continueLoop (loopId);                          \
+    }                                                   \
+    else nextOp ();                                     \
+}
+
+#define d_m3CommutativeCompareBranch(REG, TYPE, NAME, OP) \
+d_m3BranchOnCondition (rs, TYPE, NAME, TYPE operand = slot (TYPE),                                   (operand OP ((TYPE) REG)))  \
+d_m3BranchOnCondition (ss, TYPE, NAME, TYPE operand2 = slot (TYPE); TYPE operand1 = slot (TYPE),     (operand1 OP operand2))
+
+#define d_m3CompareBranch(REG, TYPE, NAME, OP) \
+d_m3BranchOnCondition (sr, TYPE, NAME, TYPE operand = slot (TYPE),                                   (((TYPE) REG) OP operand))  \
+d_m3CommutativeCompareBranch (REG, TYPE, NAME, OP)
+
+#define d_m3TestBranch(TYPE, NAME) \
+d_m3BranchOnCondition (r, TYPE, NAME, TYPE operand = (TYPE) _r0,                                     (operand == 0))  \
+d_m3BranchOnCondition (s, TYPE, NAME, TYPE operand = slot (TYPE),                                    (operand == 0))
+
+d_m3TestBranch (i32, EqualToZero)                                   d_m3TestBranch (i64, EqualToZero)
+
+d_m3CommutativeCompareBranch (_r0, i32, Equal,              ==)     d_m3CommutativeCompareBranch (_r0, i64, Equal,              ==)
+d_m3CommutativeCompareBranch (_r0, i32, NotEqual,           !=)     d_m3CommutativeCompareBranch (_r0, i64, NotEqual,           !=)
+
+d_m3CompareBranch (_r0, i32, LessThan,                      < )     d_m3CompareBranch (_r0, i64, LessThan,                      < )
+d_m3CompareBranch (_r0, i32, GreaterThan,                   > )     d_m3CompareBranch (_r0, i64, GreaterThan,                   > )
+d_m3CompareBranch (_r0, i32, LessThanOrEqual,               <=)     d_m3CompareBranch (_r0, i64, LessThanOrEqual,               <=)
+d_m3CompareBranch (_r0, i32, GreaterThanOrEqual,            >=)     d_m3CompareBranch (_r0, i64, GreaterThanOrEqual,            >=)
+
+d_m3CompareBranch (_r0, u32, LessThan,                      < )     d_m3CompareBranch (_r0, u64, LessThan,                      < )
+d_m3CompareBranch (_r0, u32, GreaterThan,                   > )     d_m3CompareBranch (_r0, u64, GreaterThan,                   > )
+d_m3CompareBranch (_r0, u32, LessThanOrEqual,               <=)     d_m3CompareBranch (_r0, u64, LessThanOrEqual,               <=)
+d_m3CompareBranch (_r0, u32, GreaterThanOrEqual,            >=)     d_m3CompareBranch (_r0, u64, GreaterThanOrEqual,            >=)
+
+#if d_m3HasFloat
+d_m3CommutativeCompareBranch (_fp0, f32, Equal,             ==)     d_m3CommutativeCompareBranch (_fp0, f64, Equal,             ==)
+d_m3CommutativeCompareBranch (_fp0, f32, NotEqual,          !=)     d_m3CommutativeCompareBranch (_fp0, f64, NotEqual,          !=)
+d_m3CompareBranch (_fp0, f32, LessThan,                     < )     d_m3CompareBranch (_fp0, f64, LessThan,                     < )
+d_m3CompareBranch (_fp0, f32, GreaterThan,                  > )     d_m3CompareBranch (_fp0, f64, GreaterThan,                  > )
+d_m3CompareBranch (_fp0, f32, LessThanOrEqual,              <=)     d_m3CompareBranch (_fp0, f64, LessThanOrEqual,              <=)
+d_m3CompareBranch (_fp0, f32, GreaterThanOrEqual,           >=)     d_m3CompareBranch (_fp0, f64, GreaterThanOrEqual,           >=)
+#endif
+
+#endif // d_m3FuseOperations
+
+
 d_m3Op  (Const32)
 {
     u32 value = * (u32 *)_pc++;
@@ -1261,7 +1810,7 @@ d_m3Op  (Const32)
 d_m3Op  (Const64)
 {
     u64 value = * (u64 *)_pc;
-    _pc += (M3_SIZEOF_PTR == 4) ? 2 : 1;
+    _pc += d_m3CodeLines (u64);
     slot (u64) = value;
     nextOp ();
 }
@@ -1322,7 +1871,84 @@ d_m3Op  (SetGlobal_f64)
 #endif
 
 
-#if d_m3SkipMemoryBoundsCheck
+// code compiled from a module template is shared by all of its instances, so globals are found
+// by index in the executing runtime's instance instead of by address
+# define d_m3InstanceGlobal()           (& m3MemRuntime (_mem)->instance->globals [immediate (u32)])
+
+d_m3Op  (GetInstanceGlobal_s32)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    slot (i32) = global->i32Value;
+
+    nextOp ();
+}
+
+
+d_m3Op  (GetInstanceGlobal_s64)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    slot (i64) = global->i64Value;
+
+    nextOp ();
+}
+
+
+d_m3Op  (SetInstanceGlobal_i32)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->i32Value = (i32) _r0;
+
+    nextOp ();
+}
+
+
+d_m3Op  (SetInstanceGlobal_i64)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->i64Value = (i64) _r0;
+
+    nextOp ();
+}
+
+
+d_m3Op  (SetInstanceGlobal_s32)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->i32Value = slot (i32);
+
+    nextOp ();
+}
+
+
+d_m3Op  (SetInstanceGlobal_s64)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->i64Value = slot (i64);
+
+    nextOp ();
+}
+
+#if d_m3HasFloat
+d_m3Op  (SetInstanceGlobal_f32)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->f32Value = _fp0;
+
+    nextOp ();
+}
+
+
+d_m3Op  (SetInstanceGlobal_f64)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->f64Value = _fp0;
+
+    nextOp ();
+}
+#endif
+
+
+#if d_m3SkipMemoryBoundsCheck || d_m3UseGuardPages
 #  define m3MemCheck(x) true
 #else
 #  define m3MemCheck(x) M3_LIKELY(x)
@@ -1399,6 +2025,68 @@ d_m3Load_i (i64, i32);
 d_m3Load_i (i64, u32);
 d_m3Load_i (i64, i64);
 
+#if d_m3FuseOperations
+
+// load fused with the slot store that follows it; the destination slot trails the offset
+#define d_m3LoadSetSlot(REG,DEST_TYPE,SRC_TYPE)         \
+d_m3Op(DEST_TYPE##_Load_##SRC_TYPE##_r_SetSlot)         \
+{                                                       \
+    d_m3TracePrepare                                    \
+    u32 offset = immediate (u32);                       \
+    u64 operand = (u32) _r0;                            \
+    operand += offset;                                  \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + sizeof (SRC_TYPE) <= _mem->length     \
+    )) {                                                \
+        {                                               \
+            u8* src8 = m3MemData(_mem) + operand;       \
+            SRC_TYPE value;                             \
+            memcpy(&value, src8, sizeof(value));        \
+            M3_BSWAP_##SRC_TYPE(value);                 \
+            REG = (DEST_TYPE)value;                     \
+            d_m3TraceLoad(DEST_TYPE, operand, REG);     \
+        }                                               \
+        slot (DEST_TYPE) = (DEST_TYPE) REG;             \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}                                                       \
+d_m3Op(DEST_TYPE##_Load_##SRC_TYPE##_s_SetSlot)         \
+{                                                       \
+    d_m3TracePrepare                                    \
+    u64 operand = slot (u32);                           \
+    u32 offset = immediate (u32);                       \
+    operand += offset;                                  \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + sizeof (SRC_TYPE) <= _mem->length     \
+    )) {                                                \
+        {                                               \
+            u8* src8 = m3MemData(_mem) + operand;       \
+            SRC_TYPE value;                             \
+            memcpy(&value, src8, sizeof(value));        \
+            M3_BSWAP_##SRC_TYPE(value);                 \
+            REG = (DEST_TYPE)value;                     \
+            d_m3TraceLoad(DEST_TYPE, operand, REG);     \
+        }                                               \
+        slot (DEST_TYPE) = (DEST_TYPE) REG;             \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}
+
+#if d_m3HasFloat
+d_m3LoadSetSlot (_fp0, f64, f64);
+#endif
+
+d_m3LoadSetSlot (_r0, i32, i8);
+d_m3LoadSetSlot (_r0, i32, u8);
+d_m3LoadSetSlot (_r0, i32, i16);
+d_m3LoadSetSlot (_r0, i32, u16);
+d_m3LoadSetSlot (_r0, i32, i32);
+d_m3LoadSetSlot (_r0, i64, i64);
+
+#endif // d_m3FuseOperations
+
 #define d_m3Store(REG, SRC_TYPE, DEST_TYPE)             \
 d_m3Op  (SRC_TYPE##_Store_##DEST_TYPE##_rs)             \
 {                                                       \
@@ -1504,6 +2192,14 @@ d_m3Store_i (i64, i16)
 d_m3Store_i (i64, i32)
 d_m3Store_i (i64, i64)
 
+#if d_m3HasSIMD
+# include "m3_exec_simd.h"
+#endif
+
+#if d_m3HasThreads
+# include "m3_exec_atomic.h"
+#endif
+
 #undef m3MemCheck
 
 
@@ -1511,7 +2207,7 @@ d_m3Store_i (i64, i64)
 // debug/profiling
 //---------------------------------------------------------------------------------------------------------------------
 #if d_m3EnableOpTracing
-d_m3RetSig  debugOp  (d_m3OpSig, cstr_t i_opcode)
+d_m3RetSig  debugOp  (d_m3OperationSig, cstr_t i_opcode)
 {
     char name [100];
     strcpy (name, strstr (i_opcode, "op_") + 3);
@@ -1526,7 +2222,7 @@ d_m3RetSig  debugOp  (d_m3OpSig, cstr_t i_opcode)
 # endif
 
 # if d_m3EnableOpProfiling
-d_m3RetSig  profileOp  (d_m3OpSig, cstr_t i_operationName)
+d_m3RetSig  profileOp  (d_m3OperationSig, cstr_t i_operationName)
 {
     ProfileHit (i_operationName);
 
@@ -1534,6 +2230,14 @@ d_m3RetSig  profileOp  (d_m3OpSig, cstr_t i_operationName)
 }
 # endif
 
+# if d_m3DispatchLoop
+#   undef _pc
+#   undef _sp
+#   undef _mem
+#   undef _r0
+#   undef _fp0
+# endif
+
 d_m3EndExternC
 
 #endif // m3_exec_h
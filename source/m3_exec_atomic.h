@@ -0,0 +1,157 @@
+//
+//  m3_exec_atomic.h
+//
+//  Atomic memory operations (threads proposal). included by m3_exec.h
+//
+//  every access is sequentially consistent. the top operand is in _r0 and any others are in slots, deepest
+//  last; the memarg offset trails them. atomic accesses trap when they aren't naturally aligned, and their bounds
+//  are always checked explicitly (even with guard pages) so that an access that's both out of bounds & unaligned
+//  reports the former, as the spec orders it.
+//
+
+#ifndef m3_exec_atomic_h
+#define m3_exec_atomic_h
+
+#if d_m3HasThreads
+
+#include <stdatomic.h>
+
+#define d_m3AtomicAddress(SRC_TYPE)                                             \
+    operand += offset;                                                          \
+                                                                                \
+    if (M3_UNLIKELY(operand + sizeof (SRC_TYPE) > _mem->length))                \
+        d_outOfBounds;                                                          \
+    if (M3_UNLIKELY(operand % sizeof (SRC_TYPE)))                               \
+        newTrap (m3Err_trapUnalignedAtomic);                                    \
+                                                                                \
+    _Atomic SRC_TYPE * address = (_Atomic SRC_TYPE *) (m3MemData (_mem) + operand);
+
+
+#define d_m3AtomicLoad(DEST_TYPE, SRC_TYPE)                                     \
+d_m3Op  (DEST_TYPE##_AtomicLoad_##SRC_TYPE)                                     \
+{                                                                               \
+    u32 offset = immediate (u32);                                               \
+    u64 operand = (u32) _r0;                                                    \
+                                                                                \
+    d_m3AtomicAddress (SRC_TYPE)                                                \
+                                                                                \
+    _r0 = (DEST_TYPE) atomic_load (address);                                    \
+                                                                                \
+    nextOp ();                                                                  \
+}
+
+#define d_m3AtomicStore(SRC_TYPE, DEST_TYPE)                                    \
+d_m3Op  (SRC_TYPE##_AtomicStore_##DEST_TYPE)                                    \
+{                                                                               \
+    u64 operand = slot (u32);                                                   \
+    u32 offset = immediate (u32);                                               \
+                                                                                \
+    d_m3AtomicAddress (DEST_TYPE)                                               \
+                                                                                \
+    atomic_store (address, (DEST_TYPE) _r0);                                    \
+                                                                                \
+    nextOp ();                                                                  \
+}
+
+// read-modify-write: the result is the value that was in memory
+#define d_m3AtomicRmw(NAME, FUNCTION, DEST_TYPE, SRC_TYPE)                      \
+d_m3Op  (DEST_TYPE##_Atomic##NAME##_##SRC_TYPE)                                 \
+{                                                                               \
+    u64 operand = slot (u32);                                                   \
+    u32 offset = immediate (u32);                                               \
+                                                                                \
+    d_m3AtomicAddress (SRC_TYPE)                                                \
+                                                                                \
+    _r0 = (DEST_TYPE) FUNCTION (address, (SRC_TYPE) _r0);                       \
+                                                                                \
+    nextOp ();                                                                  \
+}
+
+// the replacement is in _r0, the expected value in a slot. narrow forms compare the wrapped expected value
+#define d_m3AtomicCmpxchg(DEST_TYPE, SRC_TYPE)                                  \
+d_m3Op  (DEST_TYPE##_AtomicCmpxchg_##SRC_TYPE)                                  \
+{                                                                               \
+    DEST_TYPE expected = slot (DEST_TYPE);                                      \
+    u64 operand = slot (u32);                                                   \
+    u32 offset = immediate (u32);                                               \
+                                                                                \
+    d_m3AtomicAddress (SRC_TYPE)                                                \
+                                                                                \
+    SRC_TYPE value = (SRC_TYPE) expected;                                       \
+    atomic_compare_exchange_strong (address, & value, (SRC_TYPE) _r0);          \
+    _r0 = (DEST_TYPE) value;                                                    \
+                                                                                \
+    nextOp ();                                                                  \
+}
+
+#define d_m3AtomicOps(DEST_TYPE, SRC_TYPE)                                      \
+d_m3AtomicLoad      (DEST_TYPE, SRC_TYPE)                                       \
+d_m3AtomicStore     (DEST_TYPE, SRC_TYPE)                                       \
+d_m3AtomicRmw       (Add,   atomic_fetch_add,   DEST_TYPE, SRC_TYPE)            \
+d_m3AtomicRmw       (Sub,   atomic_fetch_sub,   DEST_TYPE, SRC_TYPE)            \
+d_m3AtomicRmw       (And,   atomic_fetch_and,   DEST_TYPE, SRC_TYPE)            \
+d_m3AtomicRmw       (Or,    atomic_fetch_or,    DEST_TYPE, SRC_TYPE)            \
+d_m3AtomicRmw       (Xor,   atomic_fetch_xor,   DEST_TYPE, SRC_TYPE)            \
+d_m3AtomicRmw       (Xchg,  atomic_exchange,    DEST_TYPE, SRC_TYPE)            \
+d_m3AtomicCmpxchg   (DEST_TYPE, SRC_TYPE)
+
+d_m3AtomicOps (i32, u8)
+d_m3AtomicOps (i32, u16)
+d_m3AtomicOps (i32, u32)
+
+d_m3AtomicOps (i64, u8)
+d_m3AtomicOps (i64, u16)
+d_m3AtomicOps (i64, u32)
+d_m3AtomicOps (i64, u64)
+
+
+// the timeout (ns; negative is forever) is in _r0, the expected value in a slot
+#define d_m3AtomicWait(TYPE)                                                    \
+d_m3Op  (MemoryAtomicWait_##TYPE)                                               \
+{                                                                               \
+    TYPE expected = slot (TYPE);                                                \
+    u64 operand = slot (u32);                                                   \
+    u32 offset = immediate (u32);                                               \
+                                                                                \
+    d_m3AtomicAddress (TYPE)                                                    \
+    (void) address;                                                             \
+                                                                                \
+    IM3Memory memory = m3MemInfo (_mem);                                        \
+    if (M3_UNLIKELY(not memory->shared))                                        \
+        newTrap (m3Err_trapExpectedSharedMemory);                               \
+                                                                                \
+    _r0 = SharedMemory_Wait (memory, operand, expected, sizeof (TYPE), (i64) _r0); \
+                                                                                \
+    nextOp ();                                                                  \
+}
+
+d_m3AtomicWait (u32)
+d_m3AtomicWait (u64)
+
+
+d_m3Op  (MemoryAtomicNotify)
+{
+    u64 operand = slot (u32);
+    u32 offset = immediate (u32);
+
+    d_m3AtomicAddress (u32)
+    (void) address;
+
+    // nothing can be waiting on an unshared memory
+    IM3Memory memory = m3MemInfo (_mem);
+    _r0 = memory->shared ? SharedMemory_Notify (memory, operand, (u32) _r0) : 0;
+
+    nextOp ();
+}
+
+
+d_m3Op  (AtomicFence)
+{
+    atomic_thread_fence (memory_order_seq_cst);
+
+    nextOp ();
+}
+
+#endif // d_m3HasThreads
+
+#endif // m3_exec_atomic_h
@@ -44,23 +44,101 @@ d_m3BeginExternC
 # endif
 
 
+# if d_m3DispatchLoop
+// rather than tail calling the next op, each op returns d_m3DispatchNext to the loop in Dispatch, which calls ops
+// until one returns anything else: a trap, a loop id or null once the function has returned. the registers live
+// in an M3OpState held by RunCode (or Call); inside m3_exec.h _pc, _sp, _mem, _r0 & _fp0 name its fields. the
+// native stack then only grows with wasm calls & loops, whether or not the C compiler eliminates tail calls
+typedef struct M3OpState
+{
+    pc_t                    pc;
+    m3stack_t               sp;
+    M3MemoryHeader *        mem;
+    m3reg_t                 r0;
+#   if d_m3HasFloat
+    f64                     fp0;
+#   endif
+}
+M3OpState;
+
+#   define d_m3OperationSig         M3OpState * _state
+#   define d_m3OperationArgs        _state
+#   define d_m3DispatchNext         ((m3ret_t) 1)     // never a trap string or a pc
+# else
+#   define d_m3OperationSig         d_m3OpSig
+#   define d_m3OperationArgs        d_m3OpAllArgs
+# endif
+
+
 #define d_m3RetSig                  static inline m3ret_t vectorcall
 # if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
-    typedef m3ret_t (vectorcall * IM3Operation) (d_m3OpSig, cstr_t i_operationName);
-#    define d_m3Op(NAME)                M3_NO_UBSAN d_m3RetSig op_##NAME (d_m3OpSig, cstr_t i_operationName)
+    typedef m3ret_t (vectorcall * IM3Operation) (d_m3OperationSig, cstr_t i_operationName);
+#    define d_m3Op(NAME)                M3_NO_UBSAN d_m3RetSig op_##NAME (d_m3OperationSig, cstr_t i_operationName)
 
-#    define nextOpImpl()            ((IM3Operation)(* _pc))(_pc + 1, d_m3OpArgs, __FUNCTION__)
-#    define jumpOpImpl(PC)          ((IM3Operation)(*  PC))( PC + 1, d_m3OpArgs, __FUNCTION__)
+#    define nextOpImpl()            d_m3Operation (* _pc)(_pc + 1, d_m3OpArgs, __FUNCTION__)
+#    define jumpOpImpl(PC)          d_m3Operation (*  PC)( PC + 1, d_m3OpArgs, __FUNCTION__)
+#    define d_m3CallOperation(OP)   (OP) (_state, d_m3BaseCstr)
 # else
-    typedef m3ret_t (vectorcall * IM3Operation) (d_m3OpSig);
-#    define d_m3Op(NAME)                M3_NO_UBSAN d_m3RetSig op_##NAME (d_m3OpSig)
+    typedef m3ret_t (vectorcall * IM3Operation) (d_m3OperationSig);
+#    define d_m3Op(NAME)                M3_NO_UBSAN d_m3RetSig op_##NAME (d_m3OperationSig)
+
+#    define nextOpImpl()            d_m3Operation (* _pc)(_pc + 1, d_m3OpArgs)
+#    define jumpOpImpl(PC)          d_m3Operation (*  PC)( PC + 1, d_m3OpArgs)
+#    define d_m3CallOperation(OP)   (OP) (_state)
+# endif
 
-#    define nextOpImpl()            ((IM3Operation)(* _pc))(_pc + 1, d_m3OpArgs)
-#    define jumpOpImpl(PC)          ((IM3Operation)(*  PC))( PC + 1, d_m3OpArgs)
+// how an operation is stored in a line of code. compact code keeps the signed 32-bit distance from m3_OpBase, which
+// must be linked into the same image as the operations (it's in m3_core.c)
+# if d_m3CompactCode
+    void                            m3_OpBase               (void);
+#    define d_m3OperationWord(OP)   ((code_t) ((uintptr_t) (OP) - (uintptr_t) m3_OpBase))
+#    define d_m3Operation(WORD)     ((IM3Operation) ((uintptr_t) m3_OpBase + (uintptr_t) (intptr_t) (i32) (WORD)))
+# else
+#    define d_m3OperationWord(OP)   ((code_t) (OP))
+#    define d_m3Operation(WORD)     ((IM3Operation) (WORD))
 # endif
 
-#define nextOpDirect()              M3_MUSTTAIL return nextOpImpl()
-#define jumpOpDirect(PC)            M3_MUSTTAIL return jumpOpImpl((pc_t)(PC))
+// op_CallIndirect remembers the last table entry it called in the lines that trail its immediates. the entry holds
+// while the module's table0Version is what it was then. the compiler emits it empty; code shared by the instances of
+// a module template (which has no module to check against) leaves it so
+typedef struct M3CallCache
+{
+    u32                     tableIndex;
+    u32                     tableVersion;   // c_m3CallCacheEmpty, or the table0Version of the entry
+    pc_t                    compiled;
+}
+M3CallCache;
+
+# define c_m3CallCacheEmpty             0xffffffff      // table versions count up from 0
+
+# if d_m3DispatchLoop
+d_m3RetSig  Dispatch  (M3OpState * _state)
+{
+    m3ret_t r;
+
+    do
+    {
+        IM3Operation operation = d_m3Operation (* _state->pc++);
+        r = d_m3CallOperation (operation);
+    }
+    while (r == d_m3DispatchNext);
+
+    return r;
+}
+
+#   undef  nextOpImpl
+#   define nextOpImpl()             Dispatch (_state)                                   // runs the rest of the code
+#   define nextOpDirect()           return d_m3DispatchNext
+#   define jumpOpDirect(PC)         return (_pc = (pc_t) (PC), d_m3DispatchNext)
+
+// RunCode & Call take the registers as arguments & start a loop with them
+#   define d_m3StartDispatch()      M3OpState state = { d_m3OpAllArgs }; return Dispatch (& state)
+# else
+#   define nextOpDirect()           M3_MUSTTAIL return nextOpImpl()
+#   define jumpOpDirect(PC)         M3_MUSTTAIL return jumpOpImpl((pc_t)(PC))
+
+#   define d_m3StartDispatch()      nextOpDirect()
+# endif
 
 # if (d_m3EnableOpProfiling || d_m3EnableOpTracing)
 d_m3RetSig  RunCode  (d_m3OpSig, cstr_t i_operationName)
@@ -68,7 +146,7 @@ d_m3RetSig  RunCode  (d_m3OpSig, cstr_t i_operationName)
 d_m3RetSig  RunCode  (d_m3OpSig)
 # endif
 {
-    nextOpDirect();
+    d_m3StartDispatch ();
 }
 
 d_m3EndExternC
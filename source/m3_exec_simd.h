@@ -0,0 +1,1360 @@
+//
+//  m3_exec_simd.h
+//
+//  Fixed-width SIMD operations. included by m3_exec.h
+//
+//  a v128 value is never held in a register: operations read their vector operands from slots
+//  and write their vector result to a slot. scalar results (extract_lane, any_true, bitmask...)
+//  go to _r0/_fp0 as usual. each kernel uses SSE2/SSSE3/SSE4.1 or aarch64 NEON when the build
+//  targets it (-msse4.1, -mavx2, -march=native...) and otherwise works through the lanes in C.
+//
+
+#ifndef m3_exec_simd_h
+#define m3_exec_simd_h
+
+#if d_m3HasSIMD
+
+# if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define d_m3SimdSSE2                 1
+# endif
+# if defined(__SSSE3__) || defined(__AVX__)
+#   include <tmmintrin.h>
+#   define d_m3SimdSSSE3                1
+# endif
+# if defined(__SSE4_1__) || defined(__AVX__)
+#   include <smmintrin.h>
+#   define d_m3SimdSSE41                1
+# endif
+# if defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#   include <arm_neon.h>
+#   define d_m3SimdNEON                 1
+# endif
+
+# ifndef d_m3SimdSSE2
+#   define d_m3SimdSSE2                 0
+# endif
+# ifndef d_m3SimdSSSE3
+#   define d_m3SimdSSSE3                0
+# endif
+# ifndef d_m3SimdSSE41
+#   define d_m3SimdSSE41                0
+# endif
+# ifndef d_m3SimdNEON
+#   define d_m3SimdNEON                 0
+# endif
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// slot access. slots are only 4 or 8 byte aligned, so vectors are moved with memcpy
+
+static inline
+m3v128_t  v128_Load  (const void * i_source)
+{
+    m3v128_t value;
+    memcpy (& value, i_source, sizeof (value));
+    return value;
+}
+
+static inline
+void  v128_Store  (void * o_destination, m3v128_t i_value)
+{
+    memcpy (o_destination, & i_value, sizeof (i_value));
+}
+
+# define v128_slot()                    v128_Load (slot_ptr (u8))
+# define v128_setSlot(VALUE)            v128_Store (slot_ptr (u8), VALUE)
+
+// 16 bytes embedded in the code stream take 2 lines on 64-bit platforms and 4 on 32-bit
+# define c_m3V128CodeLines              (sizeof (m3v128_t) / sizeof (code_t))
+
+
+# if d_m3SimdSSE2
+static inline __m128i   ToM128i     (m3v128_t v)    { return _mm_loadu_si128 ((const __m128i *) & v); }
+static inline __m128    ToM128      (m3v128_t v)    { return _mm_loadu_ps (v.f32x4); }
+static inline __m128d   ToM128d     (m3v128_t v)    { return _mm_loadu_pd (v.f64x2); }
+static inline m3v128_t  FromM128i   (__m128i x)     { m3v128_t v; _mm_storeu_si128 ((__m128i *) & v, x); return v; }
+static inline m3v128_t  FromM128    (__m128 x)      { m3v128_t v; _mm_storeu_ps (v.f32x4, x); return v; }
+static inline m3v128_t  FromM128d   (__m128d x)     { m3v128_t v; _mm_storeu_pd (v.f64x2, x); return v; }
+# endif
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// kernel building blocks. a kernel lists its vector forms first; whichever one the build supports returns and the
+// portable lane loop at the end is only reached when none did.
+
+# define d_m3SimdUnary(NAME)            static inline m3v128_t  simd_##NAME  (m3v128_t a)
+# define d_m3SimdBinary(NAME)           static inline m3v128_t  simd_##NAME  (m3v128_t a, m3v128_t b)
+# define d_m3SimdShift(NAME)            static inline m3v128_t  simd_##NAME  (m3v128_t a, u32 n)
+# define d_m3SimdTest(NAME)             static inline i32       simd_##NAME  (m3v128_t a)
+
+// lane loops: 'x' and 'y' are the lanes of 'a' and 'b'
+# define d_lanes1(LANES, TYPE, EXPR)                                    \
+    {                                                                   \
+        m3v128_t r;                                                     \
+        for (u32 i = 0; i < M3_COUNT_OF (r.LANES); ++i)                 \
+        {                                                               \
+            TYPE x = a.LANES [i];                                       \
+            r.LANES [i] = (EXPR);                                       \
+        }                                                               \
+        return r;                                                       \
+    }
+
+# define d_lanes(LANES, TYPE, EXPR)                                     \
+    {                                                                   \
+        m3v128_t r;                                                     \
+        for (u32 i = 0; i < M3_COUNT_OF (r.LANES); ++i)                 \
+        {                                                               \
+            TYPE x = a.LANES [i], y = b.LANES [i];                      \
+            r.LANES [i] = (EXPR);                                       \
+        }                                                               \
+        return r;                                                       \
+    }
+
+// comparisons produce all-ones or all-zero lanes of the same width
+# define d_compare(LANES, MASK, EXPR)                                   \
+    {                                                                   \
+        m3v128_t r;                                                     \
+        for (u32 i = 0; i < M3_COUNT_OF (r.MASK); ++i)                  \
+        {                                                               \
+            r.MASK [i] = (a.LANES [i] EXPR b.LANES [i]) ? -1 : 0;       \
+        }                                                               \
+        return r;                                                       \
+    }
+
+# define d_saturate(VALUE, MIN, MAX)    ((VALUE) < (MIN) ? (MIN) : (VALUE) > (MAX) ? (MAX) : (VALUE))
+
+# if d_m3SimdSSE2
+#   define d_sse(OP)                    return FromM128i (OP (ToM128i (a), ToM128i (b)));
+#   define d_ssePs(OP)                  return FromM128 (OP (ToM128 (a), ToM128 (b)));
+#   define d_ssePd(OP)                  return FromM128d (OP (ToM128d (a), ToM128d (b)));
+#   define d_sseShift(OP, MASK)         return FromM128i (OP (ToM128i (a), _mm_cvtsi32_si128 ((int) (n & MASK))));
+# else
+#   define d_sse(OP)
+#   define d_ssePs(OP)
+#   define d_ssePd(OP)
+#   define d_sseShift(OP, MASK)
+# endif
+
+# if d_m3SimdSSSE3
+#   define d_ssse3Unary(OP)             return FromM128i (OP (ToM128i (a)));
+# else
+#   define d_ssse3Unary(OP)
+# endif
+
+# if d_m3SimdSSE41
+#   define d_sse41(OP)                  d_sse (OP)
+#   define d_sse41Unary(OP)             return FromM128i (OP (ToM128i (a)));
+#   define d_sse41ExtendHigh(OP)        return FromM128i (OP (_mm_srli_si128 (ToM128i (a), 8)));
+# else
+#   define d_sse41(OP)
+#   define d_sse41Unary(OP)
+#   define d_sse41ExtendHigh(OP)
+# endif
+
+# if d_m3SimdNEON
+#   define d_neonLanes_s8               i8x16
+#   define d_neonLanes_u8               u8x16
+#   define d_neonLanes_s16              i16x8
+#   define d_neonLanes_u16              u16x8
+#   define d_neonLanes_s32              i32x4
+#   define d_neonLanes_u32              u32x4
+#   define d_neonLanes_s64              i64x2
+#   define d_neonLanes_u64              u64x2
+#   define d_neonLanes_f32              f32x4
+#   define d_neonLanes_f64              f64x2
+
+#   define d_neonGet(T, V)              vld1q_##T ((V).d_neonLanes_##T)
+#   define d_neonReturn(T, VALUE)       { m3v128_t r; vst1q_##T (r.d_neonLanes_##T, VALUE); return r; }
+
+#   define d_neon(T, OP)                d_neonReturn (T, OP (d_neonGet (T, a), d_neonGet (T, b)))
+#   define d_neonUnary(T, OP)           d_neonReturn (T, OP (d_neonGet (T, a)))
+#   define d_neonCompare(T, U, OP)      d_neonReturn (U, OP (d_neonGet (T, a), d_neonGet (T, b)))
+#   define d_neonShift(T, S, COUNT)     d_neonReturn (T, vshlq_##T (d_neonGet (T, a), vdupq_n_##S (COUNT)))
+
+    // widening: the result lanes are twice the width of T
+#   define d_neonWide_s8                s16
+#   define d_neonWide_u8                u16
+#   define d_neonWide_s16               s32
+#   define d_neonWide_u16               u32
+#   define d_neonWide_s32               s64
+#   define d_neonWide_u32               u64
+#   define d_neonReturnAs(T, VALUE)     d_neonReturn (T, VALUE)
+#   define d_neonWiden(T, VALUE)        d_neonReturnAs (d_neonWide_##T, VALUE)
+# else
+#   define d_neonReturn(T, VALUE)
+#   define d_neonWiden(T, VALUE)
+#   define d_neon(T, OP)
+#   define d_neonUnary(T, OP)
+#   define d_neonCompare(T, U, OP)
+#   define d_neonShift(T, S, COUNT)
+# endif
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// bitwise
+
+d_m3SimdUnary  (v128_Not)               { d_neonUnary (u8, vmvnq_u8)                                d_lanes1 (u64x2, u64, ~x) }
+d_m3SimdBinary (v128_And)               { d_sse (_mm_and_si128)         d_neon (u8, vandq_u8)       d_lanes (u64x2, u64, x & y) }
+d_m3SimdBinary (v128_AndNot)            {                               d_neon (u8, vbicq_u8)       d_lanes (u64x2, u64, x & ~y) }
+d_m3SimdBinary (v128_Or)                { d_sse (_mm_or_si128)          d_neon (u8, vorrq_u8)       d_lanes (u64x2, u64, x | y) }
+d_m3SimdBinary (v128_Xor)               { d_sse (_mm_xor_si128)         d_neon (u8, veorq_u8)       d_lanes (u64x2, u64, x ^ y) }
+
+static inline
+m3v128_t  simd_v128_BitSelect  (m3v128_t a, m3v128_t b, m3v128_t c)
+{
+# if d_m3SimdSSE2
+    __m128i mask = ToM128i (c);
+    return FromM128i (_mm_or_si128 (_mm_and_si128 (ToM128i (a), mask), _mm_andnot_si128 (mask, ToM128i (b))));
+# elif d_m3SimdNEON
+    d_neonReturn (u8, vbslq_u8 (d_neonGet (u8, c), d_neonGet (u8, a), d_neonGet (u8, b)))
+# else
+    m3v128_t r;
+    for (u32 i = 0; i < 2; ++i)
+        r.u64x2 [i] = (a.u64x2 [i] & c.u64x2 [i]) | (b.u64x2 [i] & ~c.u64x2 [i]);
+    return r;
+# endif
+}
+
+d_m3SimdTest (v128_AnyTrue)
+{
+# if d_m3SimdSSE41
+    return not _mm_testz_si128 (ToM128i (a), ToM128i (a));
+# elif d_m3SimdNEON
+    return vmaxvq_u32 (d_neonGet (u32, a)) != 0;
+# else
+    return (a.u64x2 [0] | a.u64x2 [1]) != 0;
+# endif
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// integer arithmetic. wrapping lanes are computed unsigned
+
+d_m3SimdBinary (i8x16_Add)              { d_sse (_mm_add_epi8)          d_neon (u8, vaddq_u8)       d_lanes (u8x16, u8, x + y) }
+d_m3SimdBinary (i16x8_Add)              { d_sse (_mm_add_epi16)         d_neon (u16, vaddq_u16)     d_lanes (u16x8, u16, x + y) }
+d_m3SimdBinary (i32x4_Add)              { d_sse (_mm_add_epi32)         d_neon (u32, vaddq_u32)     d_lanes (u32x4, u32, x + y) }
+d_m3SimdBinary (i64x2_Add)              { d_sse (_mm_add_epi64)         d_neon (u64, vaddq_u64)     d_lanes (u64x2, u64, x + y) }
+
+d_m3SimdBinary (i8x16_Subtract)         { d_sse (_mm_sub_epi8)          d_neon (u8, vsubq_u8)       d_lanes (u8x16, u8, x - y) }
+d_m3SimdBinary (i16x8_Subtract)         { d_sse (_mm_sub_epi16)         d_neon (u16, vsubq_u16)     d_lanes (u16x8, u16, x - y) }
+d_m3SimdBinary (i32x4_Subtract)         { d_sse (_mm_sub_epi32)         d_neon (u32, vsubq_u32)     d_lanes (u32x4, u32, x - y) }
+d_m3SimdBinary (i64x2_Subtract)         { d_sse (_mm_sub_epi64)         d_neon (u64, vsubq_u64)     d_lanes (u64x2, u64, x - y) }
+
+d_m3SimdBinary (i16x8_Multiply)         { d_sse (_mm_mullo_epi16)       d_neon (u16, vmulq_u16)     d_lanes (u16x8, u32, x * y) }
+d_m3SimdBinary (i32x4_Multiply)         { d_sse41 (_mm_mullo_epi32)     d_neon (u32, vmulq_u32)     d_lanes (u32x4, u32, x * y) }
+d_m3SimdBinary (i64x2_Multiply)         {                                                           d_lanes (u64x2, u64, x * y) }
+
+d_m3SimdUnary  (i8x16_Negate)           { d_neonUnary (s8, vnegq_s8)                                d_lanes1 (u8x16, u32, 0 - x) }
+d_m3SimdUnary  (i16x8_Negate)           { d_neonUnary (s16, vnegq_s16)                              d_lanes1 (u16x8, u32, 0 - x) }
+d_m3SimdUnary  (i32x4_Negate)           { d_neonUnary (s32, vnegq_s32)                              d_lanes1 (u32x4, u32, 0 - x) }
+d_m3SimdUnary  (i64x2_Negate)           { d_neonUnary (s64, vnegq_s64)                              d_lanes1 (u64x2, u64, 0 - x) }
+
+d_m3SimdUnary  (i8x16_Abs)              { d_ssse3Unary (_mm_abs_epi8)   d_neonUnary (s8, vabsq_s8)      d_lanes1 (u8x16, u32, (x & 0x80) ? 0 - x : x) }
+d_m3SimdUnary  (i16x8_Abs)              { d_ssse3Unary (_mm_abs_epi16)  d_neonUnary (s16, vabsq_s16)    d_lanes1 (u16x8, u32, (x & 0x8000) ? 0 - x : x) }
+d_m3SimdUnary  (i32x4_Abs)              { d_ssse3Unary (_mm_abs_epi32)  d_neonUnary (s32, vabsq_s32)    d_lanes1 (u32x4, u32, (x >> 31) ? 0 - x : x) }
+d_m3SimdUnary  (i64x2_Abs)              {                               d_neonUnary (s64, vabsq_s64)    d_lanes1 (u64x2, u64, (x >> 63) ? 0 - x : x) }
+
+d_m3SimdBinary (i8x16_AddSat)           { d_sse (_mm_adds_epi8)         d_neon (s8, vqaddq_s8)      d_lanes (i8x16, i32, d_saturate (x + y, INT8_MIN, INT8_MAX)) }
+d_m3SimdBinary (u8x16_AddSat)           { d_sse (_mm_adds_epu8)         d_neon (u8, vqaddq_u8)      d_lanes (u8x16, i32, d_saturate (x + y, 0, UINT8_MAX)) }
+d_m3SimdBinary (i16x8_AddSat)           { d_sse (_mm_adds_epi16)        d_neon (s16, vqaddq_s16)    d_lanes (i16x8, i32, d_saturate (x + y, INT16_MIN, INT16_MAX)) }
+d_m3SimdBinary (u16x8_AddSat)           { d_sse (_mm_adds_epu16)        d_neon (u16, vqaddq_u16)    d_lanes (u16x8, i32, d_saturate (x + y, 0, UINT16_MAX)) }
+
+d_m3SimdBinary (i8x16_SubtractSat)      { d_sse (_mm_subs_epi8)         d_neon (s8, vqsubq_s8)      d_lanes (i8x16, i32, d_saturate (x - y, INT8_MIN, INT8_MAX)) }
+d_m3SimdBinary (u8x16_SubtractSat)      { d_sse (_mm_subs_epu8)         d_neon (u8, vqsubq_u8)      d_lanes (u8x16, i32, d_saturate (x - y, 0, UINT8_MAX)) }
+d_m3SimdBinary (i16x8_SubtractSat)      { d_sse (_mm_subs_epi16)        d_neon (s16, vqsubq_s16)    d_lanes (i16x8, i32, d_saturate (x - y, INT16_MIN, INT16_MAX)) }
+d_m3SimdBinary (u16x8_SubtractSat)      { d_sse (_mm_subs_epu16)        d_neon (u16, vqsubq_u16)    d_lanes (u16x8, i32, d_saturate (x - y, 0, UINT16_MAX)) }
+
+d_m3SimdBinary (i8x16_Min)              { d_sse41 (_mm_min_epi8)        d_neon (s8, vminq_s8)       d_lanes (i8x16, i8, x < y ? x : y) }
+d_m3SimdBinary (u8x16_Min)              { d_sse (_mm_min_epu8)          d_neon (u8, vminq_u8)       d_lanes (u8x16, u8, x < y ? x : y) }
+d_m3SimdBinary (i16x8_Min)              { d_sse (_mm_min_epi16)         d_neon (s16, vminq_s16)     d_lanes (i16x8, i16, x < y ? x : y) }
+d_m3SimdBinary (u16x8_Min)              { d_sse41 (_mm_min_epu16)       d_neon (u16, vminq_u16)     d_lanes (u16x8, u16, x < y ? x : y) }
+d_m3SimdBinary (i32x4_Min)              { d_sse41 (_mm_min_epi32)       d_neon (s32, vminq_s32)     d_lanes (i32x4, i32, x < y ? x : y) }
+d_m3SimdBinary (u32x4_Min)              { d_sse41 (_mm_min_epu32)       d_neon (u32, vminq_u32)     d_lanes (u32x4, u32, x < y ? x : y) }
+
+d_m3SimdBinary (i8x16_Max)              { d_sse41 (_mm_max_epi8)        d_neon (s8, vmaxq_s8)       d_lanes (i8x16, i8, x > y ? x : y) }
+d_m3SimdBinary (u8x16_Max)              { d_sse (_mm_max_epu8)          d_neon (u8, vmaxq_u8)       d_lanes (u8x16, u8, x > y ? x : y) }
+d_m3SimdBinary (i16x8_Max)              { d_sse (_mm_max_epi16)         d_neon (s16, vmaxq_s16)     d_lanes (i16x8, i16, x > y ? x : y) }
+d_m3SimdBinary (u16x8_Max)              { d_sse41 (_mm_max_epu16)       d_neon (u16, vmaxq_u16)     d_lanes (u16x8, u16, x > y ? x : y) }
+d_m3SimdBinary (i32x4_Max)              { d_sse41 (_mm_max_epi32)       d_neon (s32, vmaxq_s32)     d_lanes (i32x4, i32, x > y ? x : y) }
+d_m3SimdBinary (u32x4_Max)              { d_sse41 (_mm_max_epu32)       d_neon (u32, vmaxq_u32)     d_lanes (u32x4, u32, x > y ? x : y) }
+
+d_m3SimdBinary (u8x16_AvgRound)         { d_sse (_mm_avg_epu8)          d_neon (u8, vrhaddq_u8)     d_lanes (u8x16, u32, (x + y + 1) >> 1) }
+d_m3SimdBinary (u16x8_AvgRound)         { d_sse (_mm_avg_epu16)         d_neon (u16, vrhaddq_u16)   d_lanes (u16x8, u32, (x + y + 1) >> 1) }
+
+d_m3SimdUnary  (i8x16_Popcnt)           { d_neonUnary (u8, vcntq_u8)                                d_lanes1 (u8x16, u32, __builtin_popcount (x)) }
+
+d_m3SimdBinary (i16x8_Q15MulRSat)
+{
+# if d_m3SimdSSSE3
+    // pmulhrsw only differs from q15mulr_sat_s for 0x8000 * 0x8000, which it doesn't saturate
+    __m128i r = _mm_mulhrs_epi16 (ToM128i (a), ToM128i (b));
+    return FromM128i (_mm_xor_si128 (r, _mm_cmpeq_epi16 (r, _mm_set1_epi16 ((i16) 0x8000))));
+# endif
+    d_neon (s16, vqrdmulhq_s16)
+    d_lanes (i16x8, i32, d_saturate ((x * y + 0x4000) >> 15, INT16_MIN, INT16_MAX))
+}
+
+d_m3SimdBinary (i32x4_Dot_i16x8)
+{
+    d_sse (_mm_madd_epi16)
+# if d_m3SimdNEON
+    int16x8_t x = d_neonGet (s16, a), y = d_neonGet (s16, b);
+    d_neonReturn (s32, vpaddq_s32 (vmull_s16 (vget_low_s16 (x), vget_low_s16 (y)), vmull_high_s16 (x, y)))
+# endif
+    m3v128_t r;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        u32 lo = (u32) ((i32) a.i16x8 [2*i]   * b.i16x8 [2*i]);
+        u32 hi = (u32) ((i32) a.i16x8 [2*i+1] * b.i16x8 [2*i+1]);
+        r.u32x4 [i] = lo + hi;
+    }
+    return r;
+}
+
+# define d_m3SimdExtAddPairwise(TO, TO_LANES, FROM, FROM_LANES, NEON)       \
+d_m3SimdUnary (TO##_ExtAddPairwise_##FROM)                                  \
+{                                                                           \
+    d_neonUnary (NEON, vpaddlq_##NEON)                                      \
+    m3v128_t r;                                                             \
+    for (u32 i = 0; i < M3_COUNT_OF (r.TO_LANES); ++i)                      \
+        r.TO_LANES [i] = a.FROM_LANES [2*i] + a.FROM_LANES [2*i+1];         \
+    return r;                                                               \
+}
+
+d_m3SimdExtAddPairwise (i16x8, i16x8, i8x16, i8x16, s8)
+d_m3SimdExtAddPairwise (i16x8, u16x8, u8x16, u8x16, u8)
+d_m3SimdExtAddPairwise (i32x4, i32x4, i16x8, i16x8, s16)
+d_m3SimdExtAddPairwise (i32x4, u32x4, u16x8, u16x8, u16)
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// widening & narrowing
+
+// TO lanes are filled from the low or high half of the FROM lanes
+# define d_m3SimdExtend(TO, TO_LANES, FROM, FROM_LANES, SSE, NEON)                 \
+d_m3SimdUnary (TO##_ExtendLow_##FROM)                                               \
+{                                                                                   \
+    d_sse41Unary (_mm_cvt##SSE)                                                     \
+    d_neonWiden (NEON, vmovl_##NEON (vget_low_##NEON (d_neonGet (NEON, a))))        \
+    m3v128_t r;                                                                     \
+    for (u32 i = 0; i < M3_COUNT_OF (r.TO_LANES); ++i)                              \
+        r.TO_LANES [i] = a.FROM_LANES [i];                                          \
+    return r;                                                                       \
+}                                                                                   \
+d_m3SimdUnary (TO##_ExtendHigh_##FROM)                                              \
+{                                                                                   \
+    d_sse41ExtendHigh (_mm_cvt##SSE)                                                \
+    d_neonWiden (NEON, vmovl_high_##NEON (d_neonGet (NEON, a)))                     \
+    m3v128_t r;                                                                     \
+    for (u32 i = 0; i < M3_COUNT_OF (r.TO_LANES); ++i)                              \
+        r.TO_LANES [i] = a.FROM_LANES [i + M3_COUNT_OF (r.TO_LANES)];               \
+    return r;                                                                       \
+}
+
+d_m3SimdExtend (i16x8, i16x8, i8x16, i8x16, epi8_epi16,  s8)
+d_m3SimdExtend (i16x8, u16x8, u8x16, u8x16, epu8_epi16,  u8)
+d_m3SimdExtend (i32x4, i32x4, i16x8, i16x8, epi16_epi32, s16)
+d_m3SimdExtend (i32x4, u32x4, u16x8, u16x8, epu16_epi32, u16)
+d_m3SimdExtend (i64x2, i64x2, i32x4, i32x4, epi32_epi64, s32)
+d_m3SimdExtend (i64x2, u64x2, u32x4, u32x4, epu32_epi64, u32)
+
+// the products of the low or high halves, widened
+# define d_m3SimdExtMultiply(TO, TO_LANES, WIDE, FROM, FROM_LANES, NEON)            \
+d_m3SimdBinary (TO##_ExtMulLow_##FROM)                                              \
+{                                                                                   \
+    d_neonWiden (NEON, vmull_##NEON (vget_low_##NEON (d_neonGet (NEON, a)), vget_low_##NEON (d_neonGet (NEON, b))))   \
+    m3v128_t r;                                                                     \
+    for (u32 i = 0; i < M3_COUNT_OF (r.TO_LANES); ++i)                              \
+        r.TO_LANES [i] = (WIDE) a.FROM_LANES [i] * (WIDE) b.FROM_LANES [i];         \
+    return r;                                                                       \
+}                                                                                   \
+d_m3SimdBinary (TO##_ExtMulHigh_##FROM)                                             \
+{                                                                                   \
+    d_neonWiden (NEON, vmull_high_##NEON (d_neonGet (NEON, a), d_neonGet (NEON, b)))    \
+    m3v128_t r;                                                                     \
+    const u32 half = M3_COUNT_OF (r.TO_LANES);                                      \
+    for (u32 i = 0; i < half; ++i)                                                  \
+        r.TO_LANES [i] = (WIDE) a.FROM_LANES [i + half] * (WIDE) b.FROM_LANES [i + half];   \
+    return r;                                                                       \
+}
+
+d_m3SimdExtMultiply (i16x8, i16x8, i32, i8x16, i8x16, s8)
+d_m3SimdExtMultiply (i16x8, u16x8, u32, u8x16, u8x16, u8)
+d_m3SimdExtMultiply (i32x4, i32x4, i32, i16x8, i16x8, s16)
+d_m3SimdExtMultiply (i32x4, u32x4, u32, u16x8, u16x8, u16)
+d_m3SimdExtMultiply (i64x2, i64x2, i64, i32x4, i32x4, s32)
+d_m3SimdExtMultiply (i64x2, u64x2, u64, u32x4, u32x4, u32)
+
+// signed saturation of the lanes of 'a' then 'b' into lanes of half the width
+# define d_m3SimdNarrow(TO, TO_LANES, FROM, FROM_LANES, MIN, MAX)                   \
+d_m3SimdBinary (TO##_Narrow_##FROM)                                                 \
+{                                                                                   \
+    d_m3SimdNarrow_##TO##_##FROM                                                    \
+    m3v128_t r;                                                                     \
+    const u32 half = M3_COUNT_OF (r.FROM_LANES);                                    \
+    for (u32 i = 0; i < half; ++i)                                                  \
+    {                                                                               \
+        r.TO_LANES [i]          = d_saturate (a.FROM_LANES [i], MIN, MAX);          \
+        r.TO_LANES [i + half]   = d_saturate (b.FROM_LANES [i], MIN, MAX);          \
+    }                                                                               \
+    return r;                                                                       \
+}
+
+# if d_m3SimdSSE2
+#   define d_m3SimdNarrow_i8x16_i16x8   d_sse (_mm_packs_epi16)
+#   define d_m3SimdNarrow_u8x16_i16x8   d_sse (_mm_packus_epi16)
+#   define d_m3SimdNarrow_i16x8_i32x4   d_sse (_mm_packs_epi32)
+#   define d_m3SimdNarrow_u16x8_i32x4   d_sse41 (_mm_packus_epi32)
+# elif d_m3SimdNEON
+#   define d_m3SimdNarrow_i8x16_i16x8   d_neonReturn (s8,  vcombine_s8  (vqmovn_s16  (d_neonGet (s16, a)), vqmovn_s16  (d_neonGet (s16, b))))
+#   define d_m3SimdNarrow_u8x16_i16x8   d_neonReturn (u8,  vcombine_u8  (vqmovun_s16 (d_neonGet (s16, a)), vqmovun_s16 (d_neonGet (s16, b))))
+#   define d_m3SimdNarrow_i16x8_i32x4   d_neonReturn (s16, vcombine_s16 (vqmovn_s32  (d_neonGet (s32, a)), vqmovn_s32  (d_neonGet (s32, b))))
+#   define d_m3SimdNarrow_u16x8_i32x4   d_neonReturn (u16, vcombine_u16 (vqmovun_s32 (d_neonGet (s32, a)), vqmovun_s32 (d_neonGet (s32, b))))
+# else
+#   define d_m3SimdNarrow_i8x16_i16x8
+#   define d_m3SimdNarrow_u8x16_i16x8
+#   define d_m3SimdNarrow_i16x8_i32x4
+#   define d_m3SimdNarrow_u16x8_i32x4
+# endif
+
+d_m3SimdNarrow (i8x16, i8x16, i16x8, i16x8, INT8_MIN,  INT8_MAX)
+d_m3SimdNarrow (u8x16, u8x16, i16x8, i16x8, 0,         UINT8_MAX)
+d_m3SimdNarrow (i16x8, i16x8, i32x4, i32x4, INT16_MIN, INT16_MAX)
+d_m3SimdNarrow (u16x8, u16x8, i32x4, i32x4, 0,         UINT16_MAX)
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// shifts. the count is taken modulo the lane width
+
+d_m3SimdShift (i8x16_ShiftLeft)         { d_neonShift (s8, s8, (i8) (n & 7))                                                d_lanes1 (u8x16, u32, x << (n & 7)) }
+d_m3SimdShift (i16x8_ShiftLeft)         { d_sseShift (_mm_sll_epi16, 15)    d_neonShift (s16, s16, (i16) (n & 15))          d_lanes1 (u16x8, u32, x << (n & 15)) }
+d_m3SimdShift (i32x4_ShiftLeft)         { d_sseShift (_mm_sll_epi32, 31)    d_neonShift (s32, s32, (i32) (n & 31))          d_lanes1 (u32x4, u32, x << (n & 31)) }
+d_m3SimdShift (i64x2_ShiftLeft)         { d_sseShift (_mm_sll_epi64, 63)    d_neonShift (s64, s64, (i64) (n & 63))          d_lanes1 (u64x2, u64, x << (n & 63)) }
+
+d_m3SimdShift (i8x16_ShiftRight)        { d_neonShift (s8, s8, - (i8) (n & 7))                                              d_lanes1 (i8x16, i32, x >> (n & 7)) }
+d_m3SimdShift (u8x16_ShiftRight)        { d_neonShift (u8, s8, - (i8) (n & 7))                                              d_lanes1 (u8x16, u32, x >> (n & 7)) }
+d_m3SimdShift (i16x8_ShiftRight)        { d_sseShift (_mm_sra_epi16, 15)    d_neonShift (s16, s16, - (i16) (n & 15))        d_lanes1 (i16x8, i32, x >> (n & 15)) }
+d_m3SimdShift (u16x8_ShiftRight)        { d_sseShift (_mm_srl_epi16, 15)    d_neonShift (u16, s16, - (i16) (n & 15))        d_lanes1 (u16x8, u32, x >> (n & 15)) }
+d_m3SimdShift (i32x4_ShiftRight)        { d_sseShift (_mm_sra_epi32, 31)    d_neonShift (s32, s32, - (i32) (n & 31))        d_lanes1 (i32x4, i32, x >> (n & 31)) }
+d_m3SimdShift (u32x4_ShiftRight)        { d_sseShift (_mm_srl_epi32, 31)    d_neonShift (u32, s32, - (i32) (n & 31))        d_lanes1 (u32x4, u32, x >> (n & 31)) }
+d_m3SimdShift (i64x2_ShiftRight)        {                                   d_neonShift (s64, s64, - (i64) (n & 63))        d_lanes1 (i64x2, i64, x >> (n & 63)) }
+d_m3SimdShift (u64x2_ShiftRight)        { d_sseShift (_mm_srl_epi64, 63)    d_neonShift (u64, s64, - (i64) (n & 63))        d_lanes1 (u64x2, u64, x >> (n & 63)) }
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// comparisons
+
+d_m3SimdBinary (i8x16_Equal)                    { d_sse (_mm_cmpeq_epi8)    d_neonCompare (s8, u8, vceqq_s8)        d_compare (i8x16, i8x16, ==) }
+d_m3SimdBinary (i8x16_NotEqual)                 {                                                                   d_compare (i8x16, i8x16, !=) }
+d_m3SimdBinary (i8x16_LessThan)                 { d_sse (_mm_cmplt_epi8)    d_neonCompare (s8, u8, vcltq_s8)        d_compare (i8x16, i8x16, <) }
+d_m3SimdBinary (u8x16_LessThan)                 {                           d_neonCompare (u8, u8, vcltq_u8)        d_compare (u8x16, i8x16, <) }
+d_m3SimdBinary (i8x16_GreaterThan)              { d_sse (_mm_cmpgt_epi8)    d_neonCompare (s8, u8, vcgtq_s8)        d_compare (i8x16, i8x16, >) }
+d_m3SimdBinary (u8x16_GreaterThan)              {                           d_neonCompare (u8, u8, vcgtq_u8)        d_compare (u8x16, i8x16, >) }
+d_m3SimdBinary (i8x16_LessThanOrEqual)          {                           d_neonCompare (s8, u8, vcleq_s8)        d_compare (i8x16, i8x16, <=) }
+d_m3SimdBinary (u8x16_LessThanOrEqual)          {                           d_neonCompare (u8, u8, vcleq_u8)        d_compare (u8x16, i8x16, <=) }
+d_m3SimdBinary (i8x16_GreaterThanOrEqual)       {                           d_neonCompare (s8, u8, vcgeq_s8)        d_compare (i8x16, i8x16, >=) }
+d_m3SimdBinary (u8x16_GreaterThanOrEqual)       {                           d_neonCompare (u8, u8, vcgeq_u8)        d_compare (u8x16, i8x16, >=) }
+
+d_m3SimdBinary (i16x8_Equal)                    { d_sse (_mm_cmpeq_epi16)   d_neonCompare (s16, u16, vceqq_s16)     d_compare (i16x8, i16x8, ==) }
+d_m3SimdBinary (i16x8_NotEqual)                 {                                                                   d_compare (i16x8, i16x8, !=) }
+d_m3SimdBinary (i16x8_LessThan)                 { d_sse (_mm_cmplt_epi16)   d_neonCompare (s16, u16, vcltq_s16)     d_compare (i16x8, i16x8, <) }
+d_m3SimdBinary (u16x8_LessThan)                 {                           d_neonCompare (u16, u16, vcltq_u16)     d_compare (u16x8, i16x8, <) }
+d_m3SimdBinary (i16x8_GreaterThan)              { d_sse (_mm_cmpgt_epi16)   d_neonCompare (s16, u16, vcgtq_s16)     d_compare (i16x8, i16x8, >) }
+d_m3SimdBinary (u16x8_GreaterThan)              {                           d_neonCompare (u16, u16, vcgtq_u16)     d_compare (u16x8, i16x8, >) }
+d_m3SimdBinary (i16x8_LessThanOrEqual)          {                           d_neonCompare (s16, u16, vcleq_s16)     d_compare (i16x8, i16x8, <=) }
+d_m3SimdBinary (u16x8_LessThanOrEqual)          {                           d_neonCompare (u16, u16, vcleq_u16)     d_compare (u16x8, i16x8, <=) }
+d_m3SimdBinary (i16x8_GreaterThanOrEqual)       {                           d_neonCompare (s16, u16, vcgeq_s16)     d_compare (i16x8, i16x8, >=) }
+d_m3SimdBinary (u16x8_GreaterThanOrEqual)       {                           d_neonCompare (u16, u16, vcgeq_u16)     d_compare (u16x8, i16x8, >=) }
+
+d_m3SimdBinary (i32x4_Equal)                    { d_sse (_mm_cmpeq_epi32)   d_neonCompare (s32, u32, vceqq_s32)     d_compare (i32x4, i32x4, ==) }
+d_m3SimdBinary (i32x4_NotEqual)                 {                                                                   d_compare (i32x4, i32x4, !=) }
+d_m3SimdBinary (i32x4_LessThan)                 { d_sse (_mm_cmplt_epi32)   d_neonCompare (s32, u32, vcltq_s32)     d_compare (i32x4, i32x4, <) }
+d_m3SimdBinary (u32x4_LessThan)                 {                           d_neonCompare (u32, u32, vcltq_u32)     d_compare (u32x4, i32x4, <) }
+d_m3SimdBinary (i32x4_GreaterThan)              { d_sse (_mm_cmpgt_epi32)   d_neonCompare (s32, u32, vcgtq_s32)     d_compare (i32x4, i32x4, >) }
+d_m3SimdBinary (u32x4_GreaterThan)              {                           d_neonCompare (u32, u32, vcgtq_u32)     d_compare (u32x4, i32x4, >) }
+d_m3SimdBinary (i32x4_LessThanOrEqual)          {                           d_neonCompare (s32, u32, vcleq_s32)     d_compare (i32x4, i32x4, <=) }
+d_m3SimdBinary (u32x4_LessThanOrEqual)          {                           d_neonCompare (u32, u32, vcleq_u32)     d_compare (u32x4, i32x4, <=) }
+d_m3SimdBinary (i32x4_GreaterThanOrEqual)       {                           d_neonCompare (s32, u32, vcgeq_s32)     d_compare (i32x4, i32x4, >=) }
+d_m3SimdBinary (u32x4_GreaterThanOrEqual)       {                           d_neonCompare (u32, u32, vcgeq_u32)     d_compare (u32x4, i32x4, >=) }
+
+d_m3SimdBinary (i64x2_Equal)                    { d_sse41 (_mm_cmpeq_epi64) d_neonCompare (s64, u64, vceqq_s64)     d_compare (i64x2, i64x2, ==) }
+d_m3SimdBinary (i64x2_NotEqual)                 {                                                                   d_compare (i64x2, i64x2, !=) }
+d_m3SimdBinary (i64x2_LessThan)                 {                           d_neonCompare (s64, u64, vcltq_s64)     d_compare (i64x2, i64x2, <) }
+d_m3SimdBinary (i64x2_GreaterThan)              {                           d_neonCompare (s64, u64, vcgtq_s64)     d_compare (i64x2, i64x2, >) }
+d_m3SimdBinary (i64x2_LessThanOrEqual)          {                           d_neonCompare (s64, u64, vcleq_s64)     d_compare (i64x2, i64x2, <=) }
+d_m3SimdBinary (i64x2_GreaterThanOrEqual)       {                           d_neonCompare (s64, u64, vcgeq_s64)     d_compare (i64x2, i64x2, >=) }
+
+d_m3SimdBinary (f32x4_Equal)                    { d_ssePs (_mm_cmpeq_ps)    d_neonCompare (f32, u32, vceqq_f32)     d_compare (f32x4, i32x4, ==) }
+d_m3SimdBinary (f32x4_NotEqual)                 { d_ssePs (_mm_cmpneq_ps)                                           d_compare (f32x4, i32x4, !=) }
+d_m3SimdBinary (f32x4_LessThan)                 { d_ssePs (_mm_cmplt_ps)    d_neonCompare (f32, u32, vcltq_f32)     d_compare (f32x4, i32x4, <) }
+d_m3SimdBinary (f32x4_GreaterThan)              { d_ssePs (_mm_cmpgt_ps)    d_neonCompare (f32, u32, vcgtq_f32)     d_compare (f32x4, i32x4, >) }
+d_m3SimdBinary (f32x4_LessThanOrEqual)          { d_ssePs (_mm_cmple_ps)    d_neonCompare (f32, u32, vcleq_f32)     d_compare (f32x4, i32x4, <=) }
+d_m3SimdBinary (f32x4_GreaterThanOrEqual)       { d_ssePs (_mm_cmpge_ps)    d_neonCompare (f32, u32, vcgeq_f32)     d_compare (f32x4, i32x4, >=) }
+
+d_m3SimdBinary (f64x2_Equal)                    { d_ssePd (_mm_cmpeq_pd)    d_neonCompare (f64, u64, vceqq_f64)     d_compare (f64x2, i64x2, ==) }
+d_m3SimdBinary (f64x2_NotEqual)                 { d_ssePd (_mm_cmpneq_pd)                                           d_compare (f64x2, i64x2, !=) }
+d_m3SimdBinary (f64x2_LessThan)                 { d_ssePd (_mm_cmplt_pd)    d_neonCompare (f64, u64, vcltq_f64)     d_compare (f64x2, i64x2, <) }
+d_m3SimdBinary (f64x2_GreaterThan)              { d_ssePd (_mm_cmpgt_pd)    d_neonCompare (f64, u64, vcgtq_f64)     d_compare (f64x2, i64x2, >) }
+d_m3SimdBinary (f64x2_LessThanOrEqual)          { d_ssePd (_mm_cmple_pd)    d_neonCompare (f64, u64, vcleq_f64)     d_compare (f64x2, i64x2, <=) }
+d_m3SimdBinary (f64x2_GreaterThanOrEqual)       { d_ssePd (_mm_cmpge_pd)    d_neonCompare (f64, u64, vcgeq_f64)     d_compare (f64x2, i64x2, >=) }
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// lane tests
+
+# define d_m3SimdAllTrue(LANES, SSE, NEON)                                  \
+d_m3SimdTest (LANES##_AllTrue)                                              \
+{                                                                           \
+    SSE                                                                     \
+    NEON                                                                    \
+    for (u32 i = 0; i < M3_COUNT_OF (a.LANES); ++i)                         \
+        if (a.LANES [i] == 0) return 0;                                     \
+    return 1;                                                               \
+}
+
+# if d_m3SimdSSE2
+#   define d_sseAllTrue(WIDTH)          return _mm_movemask_epi8 (_mm_cmpeq_##WIDTH (ToM128i (a), _mm_setzero_si128 ())) == 0;
+# else
+#   define d_sseAllTrue(WIDTH)
+# endif
+# if d_m3SimdNEON
+#   define d_neonAllTrue(T)             return vminvq_##T (d_neonGet (T, a)) != 0;
+# else
+#   define d_neonAllTrue(T)
+# endif
+
+d_m3SimdAllTrue (i8x16, d_sseAllTrue (epi8),    d_neonAllTrue (u8))
+d_m3SimdAllTrue (i16x8, d_sseAllTrue (epi16),   d_neonAllTrue (u16))
+d_m3SimdAllTrue (i32x4, d_sseAllTrue (epi32),   d_neonAllTrue (u32))
+# if d_m3SimdSSE41
+d_m3SimdAllTrue (i64x2, d_sseAllTrue (epi64),   )
+# else
+d_m3SimdAllTrue (i64x2, ,                       )
+# endif
+
+// the top bit of each lane, lane 0 in bit 0
+# define d_m3SimdBitmask(LANES, ULANES, SSE)                                \
+d_m3SimdTest (LANES##_Bitmask)                                              \
+{                                                                           \
+    SSE                                                                     \
+    i32 mask = 0;                                                           \
+    const u32 numLanes = M3_COUNT_OF (a.ULANES);                            \
+    const u32 topBit = sizeof (a.ULANES [0]) * 8 - 1;                       \
+    for (u32 i = 0; i < numLanes; ++i)                                      \
+        mask |= (i32) (a.ULANES [i] >> topBit) << i;                        \
+    return mask;                                                            \
+}
+
+# if d_m3SimdSSE2
+d_m3SimdBitmask (i8x16, u8x16, return _mm_movemask_epi8 (ToM128i (a));)
+d_m3SimdBitmask (i16x8, u16x8, return _mm_movemask_epi8 (_mm_packs_epi16 (ToM128i (a), _mm_setzero_si128 ()));)
+d_m3SimdBitmask (i32x4, u32x4, return _mm_movemask_ps (ToM128 (a));)
+d_m3SimdBitmask (i64x2, u64x2, return _mm_movemask_pd (ToM128d (a));)
+# else
+d_m3SimdBitmask (i8x16, u8x16, )
+d_m3SimdBitmask (i16x8, u16x8, )
+d_m3SimdBitmask (i32x4, u32x4, )
+d_m3SimdBitmask (i64x2, u64x2, )
+# endif
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// floating point
+
+d_m3SimdBinary (f32x4_Add)              { d_ssePs (_mm_add_ps)          d_neon (f32, vaddq_f32)     d_lanes (f32x4, f32, x + y) }
+d_m3SimdBinary (f32x4_Subtract)         { d_ssePs (_mm_sub_ps)          d_neon (f32, vsubq_f32)     d_lanes (f32x4, f32, x - y) }
+d_m3SimdBinary (f32x4_Multiply)         { d_ssePs (_mm_mul_ps)          d_neon (f32, vmulq_f32)     d_lanes (f32x4, f32, x * y) }
+d_m3SimdBinary (f32x4_Divide)           { d_ssePs (_mm_div_ps)          d_neon (f32, vdivq_f32)     d_lanes (f32x4, f32, x / y) }
+
+d_m3SimdBinary (f64x2_Add)              { d_ssePd (_mm_add_pd)          d_neon (f64, vaddq_f64)     d_lanes (f64x2, f64, x + y) }
+d_m3SimdBinary (f64x2_Subtract)         { d_ssePd (_mm_sub_pd)          d_neon (f64, vsubq_f64)     d_lanes (f64x2, f64, x - y) }
+d_m3SimdBinary (f64x2_Multiply)         { d_ssePd (_mm_mul_pd)          d_neon (f64, vmulq_f64)     d_lanes (f64x2, f64, x * y) }
+d_m3SimdBinary (f64x2_Divide)           { d_ssePd (_mm_div_pd)          d_neon (f64, vdivq_f64)     d_lanes (f64x2, f64, x / y) }
+
+// minps/maxps don't propagate NaN or order zeros the way wasm does; aarch64 fmin/fmax do
+d_m3SimdBinary (f32x4_Min)              { d_neon (f32, vminq_f32)                                   d_lanes (f32x4, f32, min_f32 (x, y)) }
+d_m3SimdBinary (f32x4_Max)              { d_neon (f32, vmaxq_f32)                                   d_lanes (f32x4, f32, max_f32 (x, y)) }
+d_m3SimdBinary (f64x2_Min)              { d_neon (f64, vminq_f64)                                   d_lanes (f64x2, f64, min_f64 (x, y)) }
+d_m3SimdBinary (f64x2_Max)              { d_neon (f64, vmaxq_f64)                                   d_lanes (f64x2, f64, max_f64 (x, y)) }
+
+// pmin = b < a ? b : a; pmax = a < b ? b : a. exactly the minps/maxps operand order
+# if d_m3SimdSSE2
+#   define d_ssePseudo(OP, SUFFIX)      return FromM128##SUFFIX (OP (ToM128##SUFFIX (b), ToM128##SUFFIX (a)));
+# else
+#   define d_ssePseudo(OP, SUFFIX)
+# endif
+
+d_m3SimdBinary (f32x4_PseudoMin)        { d_ssePseudo (_mm_min_ps, )                                d_lanes (f32x4, f32, y < x ? y : x) }
+d_m3SimdBinary (f32x4_PseudoMax)        { d_ssePseudo (_mm_max_ps, )                                d_lanes (f32x4, f32, x < y ? y : x) }
+d_m3SimdBinary (f64x2_PseudoMin)        { d_ssePseudo (_mm_min_pd, d)                               d_lanes (f64x2, f64, y < x ? y : x) }
+d_m3SimdBinary (f64x2_PseudoMax)        { d_ssePseudo (_mm_max_pd, d)                               d_lanes (f64x2, f64, x < y ? y : x) }
+
+d_m3SimdUnary  (f32x4_Abs)              { d_neonUnary (f32, vabsq_f32)                              d_lanes1 (u32x4, u32, x & 0x7fffffff) }
+d_m3SimdUnary  (f64x2_Abs)              { d_neonUnary (f64, vabsq_f64)                              d_lanes1 (u64x2, u64, x & 0x7fffffffffffffffull) }
+d_m3SimdUnary  (f32x4_Negate)           { d_neonUnary (f32, vnegq_f32)                              d_lanes1 (u32x4, u32, x ^ 0x80000000) }
+d_m3SimdUnary  (f64x2_Negate)           { d_neonUnary (f64, vnegq_f64)                              d_lanes1 (u64x2, u64, x ^ 0x8000000000000000ull) }
+
+# if d_m3SimdSSE2
+#   define d_sseSqrt(OP, SUFFIX)        return FromM128##SUFFIX (OP (ToM128##SUFFIX (a)));
+# else
+#   define d_sseSqrt(OP, SUFFIX)
+# endif
+
+d_m3SimdUnary  (f32x4_Sqrt)             { d_sseSqrt (_mm_sqrt_ps, )  d_neonUnary (f32, vsqrtq_f32)     d_lanes1 (f32x4, f32, sqrtf (x)) }
+d_m3SimdUnary  (f64x2_Sqrt)             { d_sseSqrt (_mm_sqrt_pd, d) d_neonUnary (f64, vsqrtq_f64)     d_lanes1 (f64x2, f64, sqrt (x)) }
+
+# if d_m3SimdSSE41
+#   define d_sseRoundPs(MODE)           return FromM128 (_mm_round_ps (ToM128 (a), MODE | _MM_FROUND_NO_EXC));
+#   define d_sseRoundPd(MODE)           return FromM128d (_mm_round_pd (ToM128d (a), MODE | _MM_FROUND_NO_EXC));
+# else
+#   define d_sseRoundPs(MODE)
+#   define d_sseRoundPd(MODE)
+# endif
+
+d_m3SimdUnary  (f32x4_Ceil)             { d_sseRoundPs (_MM_FROUND_TO_POS_INF)      d_neonUnary (f32, vrndpq_f32)       d_lanes1 (f32x4, f32, ceilf (x)) }
+d_m3SimdUnary  (f32x4_Floor)            { d_sseRoundPs (_MM_FROUND_TO_NEG_INF)      d_neonUnary (f32, vrndmq_f32)       d_lanes1 (f32x4, f32, floorf (x)) }
+d_m3SimdUnary  (f32x4_Trunc)            { d_sseRoundPs (_MM_FROUND_TO_ZERO)         d_neonUnary (f32, vrndq_f32)        d_lanes1 (f32x4, f32, truncf (x)) }
+d_m3SimdUnary  (f32x4_Nearest)          { d_sseRoundPs (_MM_FROUND_TO_NEAREST_INT)  d_neonUnary (f32, vrndnq_f32)       d_lanes1 (f32x4, f32, rintf (x)) }
+d_m3SimdUnary  (f64x2_Ceil)             { d_sseRoundPd (_MM_FROUND_TO_POS_INF)      d_neonUnary (f64, vrndpq_f64)       d_lanes1 (f64x2, f64, ceil (x)) }
+d_m3SimdUnary  (f64x2_Floor)            { d_sseRoundPd (_MM_FROUND_TO_NEG_INF)      d_neonUnary (f64, vrndmq_f64)       d_lanes1 (f64x2, f64, floor (x)) }
+d_m3SimdUnary  (f64x2_Trunc)            { d_sseRoundPd (_MM_FROUND_TO_ZERO)         d_neonUnary (f64, vrndq_f64)        d_lanes1 (f64x2, f64, trunc (x)) }
+d_m3SimdUnary  (f64x2_Nearest)          { d_sseRoundPd (_MM_FROUND_TO_NEAREST_INT)  d_neonUnary (f64, vrndnq_f64)       d_lanes1 (f64x2, f64, rint (x)) }
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// conversions
+
+d_m3SimdUnary (i32x4_TruncSat_f32x4)
+{
+    d_neonReturn (s32, vcvtq_s32_f32 (d_neonGet (f32, a)))
+    m3v128_t r;
+    for (u32 i = 0; i < 4; ++i)
+        OP_I32_TRUNC_SAT_F32 (r.i32x4 [i], a.f32x4 [i]);
+    return r;
+}
+
+d_m3SimdUnary (u32x4_TruncSat_f32x4)
+{
+    d_neonReturn (u32, vcvtq_u32_f32 (d_neonGet (f32, a)))
+    m3v128_t r;
+    for (u32 i = 0; i < 4; ++i)
+        OP_U32_TRUNC_SAT_F32 (r.u32x4 [i], a.f32x4 [i]);
+    return r;
+}
+
+// the two results fill the low lanes; the high lanes are zero
+d_m3SimdUnary (i32x4_TruncSatZero_f64x2)
+{
+    d_neonReturn (s32, vcombine_s32 (vqmovn_s64 (vcvtq_s64_f64 (d_neonGet (f64, a))), vdup_n_s32 (0)))
+    m3v128_t r = { { 0 } };
+    for (u32 i = 0; i < 2; ++i)
+        OP_I32_TRUNC_SAT_F64 (r.i32x4 [i], a.f64x2 [i]);
+    return r;
+}
+
+d_m3SimdUnary (u32x4_TruncSatZero_f64x2)
+{
+    d_neonReturn (u32, vcombine_u32 (vqmovn_u64 (vcvtq_u64_f64 (d_neonGet (f64, a))), vdup_n_u32 (0)))
+    m3v128_t r = { { 0 } };
+    for (u32 i = 0; i < 2; ++i)
+        OP_U32_TRUNC_SAT_F64 (r.u32x4 [i], a.f64x2 [i]);
+    return r;
+}
+
+d_m3SimdUnary (f32x4_Convert_i32x4)
+{
+# if d_m3SimdSSE2
+    return FromM128 (_mm_cvtepi32_ps (ToM128i (a)));
+# endif
+    d_neonReturn (f32, vcvtq_f32_s32 (d_neonGet (s32, a)))
+    m3v128_t r;
+    for (u32 i = 0; i < 4; ++i)
+        r.f32x4 [i] = (f32) a.i32x4 [i];
+    return r;
+}
+
+d_m3SimdUnary (f32x4_Convert_u32x4)
+{
+    d_neonReturn (f32, vcvtq_f32_u32 (d_neonGet (u32, a)))
+    m3v128_t r;
+    for (u32 i = 0; i < 4; ++i)
+        r.f32x4 [i] = (f32) a.u32x4 [i];
+    return r;
+}
+
+d_m3SimdUnary (f64x2_ConvertLow_i32x4)
+{
+# if d_m3SimdSSE2
+    return FromM128d (_mm_cvtepi32_pd (ToM128i (a)));
+# endif
+    d_neonReturn (f64, vcvtq_f64_s64 (vmovl_s32 (vget_low_s32 (d_neonGet (s32, a)))))
+    m3v128_t r;
+    for (u32 i = 0; i < 2; ++i)
+        r.f64x2 [i] = (f64) a.i32x4 [i];
+    return r;
+}
+
+d_m3SimdUnary (f64x2_ConvertLow_u32x4)
+{
+    d_neonReturn (f64, vcvtq_f64_u64 (vmovl_u32 (vget_low_u32 (d_neonGet (u32, a)))))
+    m3v128_t r;
+    for (u32 i = 0; i < 2; ++i)
+        r.f64x2 [i] = (f64) a.u32x4 [i];
+    return r;
+}
+
+d_m3SimdUnary (f32x4_DemoteZero_f64x2)
+{
+# if d_m3SimdSSE2
+    return FromM128 (_mm_cvtpd_ps (ToM128d (a)));
+# endif
+    d_neonReturn (f32, vcombine_f32 (vcvt_f32_f64 (d_neonGet (f64, a)), vdup_n_f32 (0)))
+    m3v128_t r = { { 0 } };
+    for (u32 i = 0; i < 2; ++i)
+        r.f32x4 [i] = (f32) a.f64x2 [i];
+    return r;
+}
+
+d_m3SimdUnary (f64x2_PromoteLow_f32x4)
+{
+# if d_m3SimdSSE2
+    return FromM128d (_mm_cvtps_pd (ToM128 (a)));
+# endif
+    d_neonReturn (f64, vcvt_f64_f32 (vget_low_f32 (d_neonGet (f32, a))))
+    m3v128_t r;
+    for (u32 i = 0; i < 2; ++i)
+        r.f64x2 [i] = a.f32x4 [i];
+    return r;
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// byte permutations
+
+d_m3SimdBinary (i8x16_Swizzle)
+{
+# if d_m3SimdSSSE3
+    // indices of 16 and up have their top bit set by the saturating add, which pshufb turns into zero
+    return FromM128i (_mm_shuffle_epi8 (ToM128i (a), _mm_adds_epu8 (ToM128i (b), _mm_set1_epi8 (0x70))));
+# endif
+    d_neon (u8, vqtbl1q_u8)
+    d_lanes (u8x16, u8, y < 16 ? a.u8x16 [y] : 0)
+}
+
+// i_lanes holds indices below 32 (checked by the compiler) into the concatenation of a and b
+static inline
+m3v128_t  simd_i8x16_Shuffle  (m3v128_t a, m3v128_t b, m3v128_t i_lanes)
+{
+# if d_m3SimdSSSE3
+    __m128i lanes = ToM128i (i_lanes);
+    __m128i fromA = _mm_shuffle_epi8 (ToM128i (a), _mm_adds_epu8 (lanes, _mm_set1_epi8 (0x70)));
+    __m128i fromB = _mm_shuffle_epi8 (ToM128i (b), _mm_sub_epi8 (lanes, _mm_set1_epi8 (16)));
+    return FromM128i (_mm_or_si128 (fromA, fromB));
+# elif d_m3SimdNEON
+    uint8x16x2_t table = { { d_neonGet (u8, a), d_neonGet (u8, b) } };
+    d_neonReturn (u8, vqtbl2q_u8 (table, d_neonGet (u8, i_lanes)))
+# else
+    m3v128_t r;
+    for (u32 i = 0; i < 16; ++i)
+    {
+        u8 lane = i_lanes.u8x16 [i];
+        r.u8x16 [i] = (lane < 16) ? a.u8x16 [lane] : b.u8x16 [lane - 16];
+    }
+    return r;
+# endif
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// operations
+//---------------------------------------------------------------------------------------------------------------------
+
+// immediates: [b] [a] [result]
+# define d_m3SimdBinaryOp(NAME)                         \
+d_m3Op  (NAME)                                          \
+{                                                       \
+    m3v128_t b = v128_slot ();                          \
+    m3v128_t a = v128_slot ();                          \
+    m3v128_t r = simd_##NAME (a, b);                    \
+    v128_setSlot (r);                                   \
+                                                        \
+    nextOp ();                                          \
+}
+
+// immediates: [a] [result]
+# define d_m3SimdUnaryOp(NAME)                          \
+d_m3Op  (NAME)                                          \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    m3v128_t r = simd_##NAME (a);                       \
+    v128_setSlot (r);                                   \
+                                                        \
+    nextOp ();                                          \
+}
+
+// immediates: [a]. the i32 result goes to _r0
+# define d_m3SimdTestOp(NAME)                           \
+d_m3Op  (NAME)                                          \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    _r0 = simd_##NAME (a);                              \
+                                                        \
+    nextOp ();                                          \
+}
+
+// immediates: ([count]) [a] [result]
+# define d_m3SimdShiftOp(NAME)                          \
+d_m3Op  (NAME##_r)                                      \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    m3v128_t r = simd_##NAME (a, (u32) _r0);            \
+    v128_setSlot (r);                                   \
+                                                        \
+    nextOp ();                                          \
+}                                                       \
+d_m3Op  (NAME##_s)                                      \
+{                                                       \
+    u32 count = slot (u32);                             \
+    m3v128_t a = v128_slot ();                          \
+    m3v128_t r = simd_##NAME (a, count);                \
+    v128_setSlot (r);                                   \
+                                                        \
+    nextOp ();                                          \
+}
+
+
+d_m3SimdUnaryOp     (v128_Not)
+d_m3SimdBinaryOp    (v128_And)
+d_m3SimdBinaryOp    (v128_AndNot)
+d_m3SimdBinaryOp    (v128_Or)
+d_m3SimdBinaryOp    (v128_Xor)
+d_m3SimdTestOp      (v128_AnyTrue)
+
+d_m3Op  (v128_BitSelect)
+{
+    m3v128_t c = v128_slot ();
+    m3v128_t b = v128_slot ();
+    m3v128_t a = v128_slot ();
+    m3v128_t r = simd_v128_BitSelect (a, b, c);
+    v128_setSlot (r);
+
+    nextOp ();
+}
+
+
+d_m3SimdBinaryOp    (i8x16_Add)                 d_m3SimdBinaryOp    (i16x8_Add)
+d_m3SimdBinaryOp    (i32x4_Add)                 d_m3SimdBinaryOp    (i64x2_Add)
+d_m3SimdBinaryOp    (i8x16_Subtract)            d_m3SimdBinaryOp    (i16x8_Subtract)
+d_m3SimdBinaryOp    (i32x4_Subtract)            d_m3SimdBinaryOp    (i64x2_Subtract)
+d_m3SimdBinaryOp    (i16x8_Multiply)            d_m3SimdBinaryOp    (i32x4_Multiply)
+d_m3SimdBinaryOp    (i64x2_Multiply)
+
+d_m3SimdUnaryOp     (i8x16_Negate)              d_m3SimdUnaryOp     (i16x8_Negate)
+d_m3SimdUnaryOp     (i32x4_Negate)              d_m3SimdUnaryOp     (i64x2_Negate)
+d_m3SimdUnaryOp     (i8x16_Abs)                 d_m3SimdUnaryOp     (i16x8_Abs)
+d_m3SimdUnaryOp     (i32x4_Abs)                 d_m3SimdUnaryOp     (i64x2_Abs)
+
+d_m3SimdBinaryOp    (i8x16_AddSat)              d_m3SimdBinaryOp    (u8x16_AddSat)
+d_m3SimdBinaryOp    (i16x8_AddSat)              d_m3SimdBinaryOp    (u16x8_AddSat)
+d_m3SimdBinaryOp    (i8x16_SubtractSat)         d_m3SimdBinaryOp    (u8x16_SubtractSat)
+d_m3SimdBinaryOp    (i16x8_SubtractSat)         d_m3SimdBinaryOp    (u16x8_SubtractSat)
+
+d_m3SimdBinaryOp    (i8x16_Min)                 d_m3SimdBinaryOp    (u8x16_Min)
+d_m3SimdBinaryOp    (i16x8_Min)                 d_m3SimdBinaryOp    (u16x8_Min)
+d_m3SimdBinaryOp    (i32x4_Min)                 d_m3SimdBinaryOp    (u32x4_Min)
+d_m3SimdBinaryOp    (i8x16_Max)                 d_m3SimdBinaryOp    (u8x16_Max)
+d_m3SimdBinaryOp    (i16x8_Max)                 d_m3SimdBinaryOp    (u16x8_Max)
+d_m3SimdBinaryOp    (i32x4_Max)                 d_m3SimdBinaryOp    (u32x4_Max)
+
+d_m3SimdBinaryOp    (u8x16_AvgRound)            d_m3SimdBinaryOp    (u16x8_AvgRound)
+d_m3SimdUnaryOp     (i8x16_Popcnt)
+d_m3SimdBinaryOp    (i16x8_Q15MulRSat)
+d_m3SimdBinaryOp    (i32x4_Dot_i16x8)
+
+d_m3SimdUnaryOp     (i16x8_ExtAddPairwise_i8x16)    d_m3SimdUnaryOp     (i16x8_ExtAddPairwise_u8x16)
+d_m3SimdUnaryOp     (i32x4_ExtAddPairwise_i16x8)    d_m3SimdUnaryOp     (i32x4_ExtAddPairwise_u16x8)
+
+d_m3SimdUnaryOp     (i16x8_ExtendLow_i8x16)     d_m3SimdUnaryOp     (i16x8_ExtendHigh_i8x16)
+d_m3SimdUnaryOp     (i16x8_ExtendLow_u8x16)     d_m3SimdUnaryOp     (i16x8_ExtendHigh_u8x16)
+d_m3SimdUnaryOp     (i32x4_ExtendLow_i16x8)     d_m3SimdUnaryOp     (i32x4_ExtendHigh_i16x8)
+d_m3SimdUnaryOp     (i32x4_ExtendLow_u16x8)     d_m3SimdUnaryOp     (i32x4_ExtendHigh_u16x8)
+d_m3SimdUnaryOp     (i64x2_ExtendLow_i32x4)     d_m3SimdUnaryOp     (i64x2_ExtendHigh_i32x4)
+d_m3SimdUnaryOp     (i64x2_ExtendLow_u32x4)     d_m3SimdUnaryOp     (i64x2_ExtendHigh_u32x4)
+
+d_m3SimdBinaryOp    (i16x8_ExtMulLow_i8x16)     d_m3SimdBinaryOp    (i16x8_ExtMulHigh_i8x16)
+d_m3SimdBinaryOp    (i16x8_ExtMulLow_u8x16)     d_m3SimdBinaryOp    (i16x8_ExtMulHigh_u8x16)
+d_m3SimdBinaryOp    (i32x4_ExtMulLow_i16x8)     d_m3SimdBinaryOp    (i32x4_ExtMulHigh_i16x8)
+d_m3SimdBinaryOp    (i32x4_ExtMulLow_u16x8)     d_m3SimdBinaryOp    (i32x4_ExtMulHigh_u16x8)
+d_m3SimdBinaryOp    (i64x2_ExtMulLow_i32x4)     d_m3SimdBinaryOp    (i64x2_ExtMulHigh_i32x4)
+d_m3SimdBinaryOp    (i64x2_ExtMulLow_u32x4)     d_m3SimdBinaryOp    (i64x2_ExtMulHigh_u32x4)
+
+d_m3SimdBinaryOp    (i8x16_Narrow_i16x8)        d_m3SimdBinaryOp    (u8x16_Narrow_i16x8)
+d_m3SimdBinaryOp    (i16x8_Narrow_i32x4)        d_m3SimdBinaryOp    (u16x8_Narrow_i32x4)
+
+d_m3SimdShiftOp     (i8x16_ShiftLeft)           d_m3SimdShiftOp     (i16x8_ShiftLeft)
+d_m3SimdShiftOp     (i32x4_ShiftLeft)           d_m3SimdShiftOp     (i64x2_ShiftLeft)
+d_m3SimdShiftOp     (i8x16_ShiftRight)          d_m3SimdShiftOp     (u8x16_ShiftRight)
+d_m3SimdShiftOp     (i16x8_ShiftRight)          d_m3SimdShiftOp     (u16x8_ShiftRight)
+d_m3SimdShiftOp     (i32x4_ShiftRight)          d_m3SimdShiftOp     (u32x4_ShiftRight)
+d_m3SimdShiftOp     (i64x2_ShiftRight)          d_m3SimdShiftOp     (u64x2_ShiftRight)
+
+# define d_m3SimdCompareOps(TYPE)                                                           \
+d_m3SimdBinaryOp    (TYPE##_Equal)              d_m3SimdBinaryOp    (TYPE##_NotEqual)       \
+d_m3SimdBinaryOp    (TYPE##_LessThan)           d_m3SimdBinaryOp    (TYPE##_GreaterThan)    \
+d_m3SimdBinaryOp    (TYPE##_LessThanOrEqual)    d_m3SimdBinaryOp    (TYPE##_GreaterThanOrEqual)
+
+d_m3SimdCompareOps  (i8x16)
+d_m3SimdCompareOps  (i16x8)
+d_m3SimdCompareOps  (i32x4)
+d_m3SimdCompareOps  (i64x2)
+d_m3SimdCompareOps  (f32x4)
+d_m3SimdCompareOps  (f64x2)
+
+d_m3SimdBinaryOp    (u8x16_LessThan)            d_m3SimdBinaryOp    (u8x16_GreaterThan)
+d_m3SimdBinaryOp    (u8x16_LessThanOrEqual)     d_m3SimdBinaryOp    (u8x16_GreaterThanOrEqual)
+d_m3SimdBinaryOp    (u16x8_LessThan)            d_m3SimdBinaryOp    (u16x8_GreaterThan)
+d_m3SimdBinaryOp    (u16x8_LessThanOrEqual)     d_m3SimdBinaryOp    (u16x8_GreaterThanOrEqual)
+d_m3SimdBinaryOp    (u32x4_LessThan)            d_m3SimdBinaryOp    (u32x4_GreaterThan)
+d_m3SimdBinaryOp    (u32x4_LessThanOrEqual)     d_m3SimdBinaryOp    (u32x4_GreaterThanOrEqual)
+
+d_m3SimdTestOp      (i8x16_AllTrue)             d_m3SimdTestOp      (i16x8_AllTrue)
+d_m3SimdTestOp      (i32x4_AllTrue)             d_m3SimdTestOp      (i64x2_AllTrue)
+d_m3SimdTestOp      (i8x16_Bitmask)             d_m3SimdTestOp      (i16x8_Bitmask)
+d_m3SimdTestOp      (i32x4_Bitmask)             d_m3SimdTestOp      (i64x2_Bitmask)
+
+d_m3SimdBinaryOp    (f32x4_Add)                 d_m3SimdBinaryOp    (f64x2_Add)
+d_m3SimdBinaryOp    (f32x4_Subtract)            d_m3SimdBinaryOp    (f64x2_Subtract)
+d_m3SimdBinaryOp    (f32x4_Multiply)            d_m3SimdBinaryOp    (f64x2_Multiply)
+d_m3SimdBinaryOp    (f32x4_Divide)              d_m3SimdBinaryOp    (f64x2_Divide)
+d_m3SimdBinaryOp    (f32x4_Min)                 d_m3SimdBinaryOp    (f64x2_Min)
+d_m3SimdBinaryOp    (f32x4_Max)                 d_m3SimdBinaryOp    (f64x2_Max)
+d_m3SimdBinaryOp    (f32x4_PseudoMin)           d_m3SimdBinaryOp    (f64x2_PseudoMin)
+d_m3SimdBinaryOp    (f32x4_PseudoMax)           d_m3SimdBinaryOp    (f64x2_PseudoMax)
+
+d_m3SimdUnaryOp     (f32x4_Abs)                 d_m3SimdUnaryOp     (f64x2_Abs)
+d_m3SimdUnaryOp     (f32x4_Negate)              d_m3SimdUnaryOp     (f64x2_Negate)
+d_m3SimdUnaryOp     (f32x4_Sqrt)                d_m3SimdUnaryOp     (f64x2_Sqrt)
+d_m3SimdUnaryOp     (f32x4_Ceil)                d_m3SimdUnaryOp     (f64x2_Ceil)
+d_m3SimdUnaryOp     (f32x4_Floor)               d_m3SimdUnaryOp     (f64x2_Floor)
+d_m3SimdUnaryOp     (f32x4_Trunc)               d_m3SimdUnaryOp     (f64x2_Trunc)
+d_m3SimdUnaryOp     (f32x4_Nearest)             d_m3SimdUnaryOp     (f64x2_Nearest)
+
+d_m3SimdUnaryOp     (i32x4_TruncSat_f32x4)      d_m3SimdUnaryOp     (u32x4_TruncSat_f32x4)
+d_m3SimdUnaryOp     (i32x4_TruncSatZero_f64x2)  d_m3SimdUnaryOp     (u32x4_TruncSatZero_f64x2)
+d_m3SimdUnaryOp     (f32x4_Convert_i32x4)       d_m3SimdUnaryOp     (f32x4_Convert_u32x4)
+d_m3SimdUnaryOp     (f64x2_ConvertLow_i32x4)    d_m3SimdUnaryOp     (f64x2_ConvertLow_u32x4)
+d_m3SimdUnaryOp     (f32x4_DemoteZero_f64x2)    d_m3SimdUnaryOp     (f64x2_PromoteLow_f32x4)
+
+d_m3SimdBinaryOp    (i8x16_Swizzle)
+
+
+// immediates: [b] [a] [16 lane indices] [result]
+d_m3Op  (i8x16_Shuffle)
+{
+    m3v128_t b = v128_slot ();
+    m3v128_t a = v128_slot ();
+    m3v128_t lanes = v128_Load (_pc);
+    _pc += c_m3V128CodeLines;
+
+    m3v128_t r = simd_i8x16_Shuffle (a, b, lanes);
+    v128_setSlot (r);
+
+    nextOp ();
+}
+
+
+// immediates: [16 bytes] [result]
+d_m3Op  (Const128)
+{
+    m3v128_t value = v128_Load (_pc);
+    _pc += c_m3V128CodeLines;
+
+    v128_setSlot (value);
+
+    nextOp ();
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// lanes
+
+// immediates: ([value]) [result]
+# define d_m3SimdSplat(NAME, LANES, TYPE, SLOT_TYPE, REG)    \
+d_m3Op  (NAME##_r)                                      \
+{                                                       \
+    TYPE value = (TYPE) REG;                            \
+    m3v128_t r;                                         \
+    for (u32 i = 0; i < M3_COUNT_OF (r.LANES); ++i)     \
+        r.LANES [i] = value;                            \
+    v128_setSlot (r);                                   \
+                                                        \
+    nextOp ();                                          \
+}                                                       \
+d_m3Op  (NAME##_s)                                      \
+{                                                       \
+    TYPE value = (TYPE) slot (SLOT_TYPE);               \
+    m3v128_t r;                                         \
+    for (u32 i = 0; i < M3_COUNT_OF (r.LANES); ++i)     \
+        r.LANES [i] = value;                            \
+    v128_setSlot (r);                                   \
+                                                        \
+    nextOp ();                                          \
+}
+
+// immediates: [a] [lane]. the scalar goes to REG
+# define d_m3SimdExtractLane(NAME, LANES, REG)          \
+d_m3Op  (NAME)                                          \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    REG = a.LANES [immediate (u32)];                    \
+                                                        \
+    nextOp ();                                          \
+}
+
+// immediates: ([value]) [a] [lane] [result]
+# define d_m3SimdReplaceLane(NAME, LANES, TYPE, SLOT_TYPE, REG)  \
+d_m3Op  (NAME##_r)                                      \
+{                                                       \
+    TYPE value = (TYPE) REG;                            \
+    m3v128_t a = v128_slot ();                          \
+    a.LANES [immediate (u32)] = value;                  \
+    v128_setSlot (a);                                   \
+                                                        \
+    nextOp ();                                          \
+}                                                       \
+d_m3Op  (NAME##_s)                                      \
+{                                                       \
+    TYPE value = (TYPE) slot (SLOT_TYPE);               \
+    m3v128_t a = v128_slot ();                          \
+    a.LANES [immediate (u32)] = value;                  \
+    v128_setSlot (a);                                   \
+                                                        \
+    nextOp ();                                          \
+}
+
+d_m3SimdSplat           (i8x16_Splat,           i8x16,  i8,     i32,    _r0)
+d_m3SimdSplat           (i16x8_Splat,           i16x8,  i16,    i32,    _r0)
+d_m3SimdSplat           (i32x4_Splat,           i32x4,  i32,    i32,    _r0)
+d_m3SimdSplat           (i64x2_Splat,           i64x2,  i64,    i64,    _r0)
+d_m3SimdSplat           (f32x4_Splat,           f32x4,  f32,    f32,    _fp0)
+d_m3SimdSplat           (f64x2_Splat,           f64x2,  f64,    f64,    _fp0)
+
+d_m3SimdExtractLane     (i8x16_ExtractLane,     i8x16,  _r0)
+d_m3SimdExtractLane     (u8x16_ExtractLane,     u8x16,  _r0)
+d_m3SimdExtractLane     (i16x8_ExtractLane,     i16x8,  _r0)
+d_m3SimdExtractLane     (u16x8_ExtractLane,     u16x8,  _r0)
+d_m3SimdExtractLane     (i32x4_ExtractLane,     i32x4,  _r0)
+d_m3SimdExtractLane     (i64x2_ExtractLane,     i64x2,  _r0)
+d_m3SimdExtractLane     (f32x4_ExtractLane,     f32x4,  _fp0)
+d_m3SimdExtractLane     (f64x2_ExtractLane,     f64x2,  _fp0)
+
+d_m3SimdReplaceLane     (i8x16_ReplaceLane,     i8x16,  i8,     i32,    _r0)
+d_m3SimdReplaceLane     (i16x8_ReplaceLane,     i16x8,  i16,    i32,    _r0)
+d_m3SimdReplaceLane     (i32x4_ReplaceLane,     i32x4,  i32,    i32,    _r0)
+d_m3SimdReplaceLane     (i64x2_ReplaceLane,     i64x2,  i64,    i64,    _r0)
+d_m3SimdReplaceLane     (f32x4_ReplaceLane,     f32x4,  f32,    f32,    _fp0)
+d_m3SimdReplaceLane     (f64x2_ReplaceLane,     f64x2,  f64,    f64,    _fp0)
+
+
+// immediates: ([condition]) [b] [a] [result]
+d_m3Op  (Select_v128_rss)
+{
+    i32 condition = (i32) _r0;
+
+    m3v128_t operand2 = v128_slot ();
+    m3v128_t operand1 = v128_slot ();
+    v128_setSlot (condition ? operand1 : operand2);
+
+    nextOp ();
+}
+
+d_m3Op  (Select_v128_sss)
+{
+    i32 condition = slot (i32);
+
+    m3v128_t operand2 = v128_slot ();
+    m3v128_t operand1 = v128_slot ();
+    v128_setSlot (condition ? operand1 : operand2);
+
+    nextOp ();
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// slots & globals
+
+d_m3Op  (CopySlot_128)
+{
+    u8 * dest   = slot_ptr (u8);
+    u8 * src    = slot_ptr (u8);
+
+    v128_Store (dest, v128_Load (src));
+
+    nextOp ();
+}
+
+d_m3Op  (PreserveCopySlot_128)
+{
+    u8 * dest       = slot_ptr (u8);
+    u8 * src        = slot_ptr (u8);
+    u8 * preserve   = slot_ptr (u8);
+
+    v128_Store (preserve, v128_Load (dest));
+    v128_Store (dest, v128_Load (src));
+
+    nextOp ();
+}
+
+d_m3Op  (GetGlobal_s128)
+{
+    m3v128_t * global = immediate (m3v128_t *);
+    v128_setSlot (* global);
+
+    nextOp ();
+}
+
+d_m3Op  (SetGlobal_s128)
+{
+    m3v128_t * global = immediate (m3v128_t *);
+    * global = v128_slot ();
+
+    nextOp ();
+}
+
+d_m3Op  (GetInstanceGlobal_s128)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    v128_setSlot (global->v128Value);
+
+    nextOp ();
+}
+
+d_m3Op  (SetInstanceGlobal_s128)
+{
+    IM3Global global = d_m3InstanceGlobal ();
+    global->v128Value = v128_slot ();
+
+    nextOp ();
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------
+// memory
+
+static inline m3v128_t  simd_v128_Load  (const u8 * i_source)     { return v128_Load (i_source); }
+
+// N lanes read from memory and widened
+# define d_m3SimdLoadExtend(NAME, LANES, TYPE, COUNT)                   \
+static inline                                                           \
+m3v128_t  simd_##NAME  (const u8 * i_source)                            \
+{                                                                       \
+    TYPE source [COUNT];                                                \
+    memcpy (source, i_source, sizeof (source));                         \
+    m3v128_t r;                                                         \
+    for (u32 i = 0; i < COUNT; ++i)                                     \
+        r.LANES [i] = source [i];                                       \
+    return r;                                                           \
+}
+
+d_m3SimdLoadExtend (i16x8_Load_i8x8,    i16x8,  i8,     8)
+d_m3SimdLoadExtend (i16x8_Load_u8x8,    u16x8,  u8,     8)
+d_m3SimdLoadExtend (i32x4_Load_i16x4,   i32x4,  i16,    4)
+d_m3SimdLoadExtend (i32x4_Load_u16x4,   u32x4,  u16,    4)
+d_m3SimdLoadExtend (i64x2_Load_i32x2,   i64x2,  i32,    2)
+d_m3SimdLoadExtend (i64x2_Load_u32x2,   u64x2,  u32,    2)
+
+// one lane read from memory and copied to all
+# define d_m3SimdLoadSplat(NAME, LANES, TYPE)                           \
+static inline                                                           \
+m3v128_t  simd_##NAME  (const u8 * i_source)                            \
+{                                                                       \
+    TYPE value;                                                         \
+    memcpy (& value, i_source, sizeof (value));                         \
+    m3v128_t r;                                                         \
+    for (u32 i = 0; i < M3_COUNT_OF (r.LANES); ++i)                     \
+        r.LANES [i] = value;                                            \
+    return r;                                                           \
+}
+
+d_m3SimdLoadSplat  (i8x16_LoadSplat,    u8x16,  u8)
+d_m3SimdLoadSplat  (i16x8_LoadSplat,    u16x8,  u16)
+d_m3SimdLoadSplat  (i32x4_LoadSplat,    u32x4,  u32)
+d_m3SimdLoadSplat  (i64x2_LoadSplat,    u64x2,  u64)
+
+static inline
+m3v128_t  simd_i32x4_LoadZero  (const u8 * i_source)
+{
+    m3v128_t r = { { 0 } };
+    memcpy (& r, i_source, sizeof (u32));
+    return r;
+}
+
+static inline
+m3v128_t  simd_i64x2_LoadZero  (const u8 * i_source)
+{
+    m3v128_t r = { { 0 } };
+    memcpy (& r, i_source, sizeof (u64));
+    return r;
+}
+
+
+// immediates: ([address]) [offset] [result]
+# define d_m3SimdLoad(NAME, SIZE)                       \
+d_m3Op  (NAME##_r)                                      \
+{                                                       \
+    u32 offset = immediate (u32);                       \
+    u64 operand = (u32) _r0;                            \
+    operand += offset;                                  \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + SIZE <= _mem->length                  \
+    )) {                                                \
+        m3v128_t r = simd_##NAME (m3MemData (_mem) + operand);  \
+        v128_setSlot (r);                               \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}                                                       \
+d_m3Op  (NAME##_s)                                      \
+{                                                       \
+    u64 operand = slot (u32);                           \
+    u32 offset = immediate (u32);                       \
+    operand += offset;                                  \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + SIZE <= _mem->length                  \
+    )) {                                                \
+        m3v128_t r = simd_##NAME (m3MemData (_mem) + operand);  \
+        v128_setSlot (r);                               \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}
+
+d_m3SimdLoad (v128_Load,            16)
+d_m3SimdLoad (i16x8_Load_i8x8,      8)
+d_m3SimdLoad (i16x8_Load_u8x8,      8)
+d_m3SimdLoad (i32x4_Load_i16x4,     8)
+d_m3SimdLoad (i32x4_Load_u16x4,     8)
+d_m3SimdLoad (i64x2_Load_i32x2,     8)
+d_m3SimdLoad (i64x2_Load_u32x2,     8)
+d_m3SimdLoad (i8x16_LoadSplat,      1)
+d_m3SimdLoad (i16x8_LoadSplat,      2)
+d_m3SimdLoad (i32x4_LoadSplat,      4)
+d_m3SimdLoad (i64x2_LoadSplat,      8)
+d_m3SimdLoad (i32x4_LoadZero,       4)
+d_m3SimdLoad (i64x2_LoadZero,       8)
+
+
+// immediates: [value] ([address]) [offset]
+d_m3Op  (v128_Store_r)
+{
+    m3v128_t value = v128_slot ();
+    u32 offset = immediate (u32);
+    u64 operand = (u32) _r0;
+    operand += offset;
+
+    if (m3MemCheck(
+        operand + sizeof (m3v128_t) <= _mem->length
+    )) {
+        v128_Store (m3MemData (_mem) + operand, value);
+        nextOp ();
+    } else d_outOfBounds;
+}
+
+d_m3Op  (v128_Store_s)
+{
+    m3v128_t value = v128_slot ();
+    u64 operand = slot (u32);
+    u32 offset = immediate (u32);
+    operand += offset;
+
+    if (m3MemCheck(
+        operand + sizeof (m3v128_t) <= _mem->length
+    )) {
+        v128_Store (m3MemData (_mem) + operand, value);
+        nextOp ();
+    } else d_outOfBounds;
+}
+
+
+// immediates: [a] ([address]) [offset] [lane] [result]
+# define d_m3SimdLoadLane(NAME, LANES)                  \
+d_m3Op  (NAME##_r)                                      \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    u64 operand = (u32) _r0;                            \
+    u32 offset = immediate (u32);                       \
+    operand += offset;                                  \
+    u32 lane = immediate (u32);                         \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + sizeof (a.LANES [0]) <= _mem->length  \
+    )) {                                                \
+        memcpy (& a.LANES [lane], m3MemData (_mem) + operand, sizeof (a.LANES [0]));   \
+        v128_setSlot (a);                               \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}                                                       \
+d_m3Op  (NAME##_s)                                      \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    u64 operand = slot (u32);                           \
+    u32 offset = immediate (u32);                       \
+    operand += offset;                                  \
+    u32 lane = immediate (u32);                         \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + sizeof (a.LANES [0]) <= _mem->length  \
+    )) {                                                \
+        memcpy (& a.LANES [lane], m3MemData (_mem) + operand, sizeof (a.LANES [0]));   \
+        v128_setSlot (a);                               \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}
+
+// immediates: [a] ([address]) [offset] [lane]
+# define d_m3SimdStoreLane(NAME, LANES)                 \
+d_m3Op  (NAME##_r)                                      \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    u64 operand = (u32) _r0;                            \
+    u32 offset = immediate (u32);                       \
+    operand += offset;                                  \
+    u32 lane = immediate (u32);                         \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + sizeof (a.LANES [0]) <= _mem->length  \
+    )) {                                                \
+        memcpy (m3MemData (_mem) + operand, & a.LANES [lane], sizeof (a.LANES [0]));   \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}                                                       \
+d_m3Op  (NAME##_s)                                      \
+{                                                       \
+    m3v128_t a = v128_slot ();                          \
+    u64 operand = slot (u32);                           \
+    u32 offset = immediate (u32);                       \
+    operand += offset;                                  \
+    u32 lane = immediate (u32);                         \
+                                                        \
+    if (m3MemCheck(                                     \
+        operand + sizeof (a.LANES [0]) <= _mem->length  \
+    )) {                                                \
+        memcpy (m3MemData (_mem) + operand, & a.LANES [lane], sizeof (a.LANES [0]));   \
+        nextOp ();                                      \
+    } else d_outOfBounds;                               \
+}
+
+d_m3SimdLoadLane    (i8x16_LoadLane,    u8x16)
+d_m3SimdLoadLane    (i16x8_LoadLane,    u16x8)
+d_m3SimdLoadLane    (i32x4_LoadLane,    u32x4)
+d_m3SimdLoadLane    (i64x2_LoadLane,    u64x2)
+
+d_m3SimdStoreLane   (i8x16_StoreLane,   u8x16)
+d_m3SimdStoreLane   (i16x8_StoreLane,   u16x8)
+d_m3SimdStoreLane   (i32x4_StoreLane,   u32x4)
+d_m3SimdStoreLane   (i64x2_StoreLane,   u64x2)
+
+#endif // d_m3HasSIMD
+
+#endif // m3_exec_simd_h
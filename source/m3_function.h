@@ -72,11 +72,20 @@ typedef struct M3Function
 
     u16                     numLocals;                              // not including args
     u16                     numLocalBytes;
+    u16                     firstZeroedLocalByte;                   // the locals that might be read before they're
+    u16                     numZeroedLocalBytes;                    // written; op_Entry zeroes just these
 
     bool                    ownsWasmCode;
 
     u16                     numConstantBytes;
     void *                  constants;
+
+# if d_m3HasJit
+    void *                  native;                                 // the body translated by m3_jit.c; op_JitEntry calls it
+
+    u32                     hotness;                                // calls & loop iterations counted by op_CountHotness
+    u8                      tier;                                   // 1 once it's been recompiled for the jit (see TierUpFunction)
+# endif
 }
 M3Function;
 
@@ -27,6 +27,14 @@ size_t  SPrintArg  (char * o_string, size_t i_stringBufferSize, voidptr_t i_sp,
     else if (i_type == c_m3Type_f64)
         len = snprintf (o_string, i_stringBufferSize, "%" PRIf64, * (f64 *) i_sp);
 #endif
+#if d_m3HasSIMD
+    else if (i_type == c_m3Type_v128)
+    {
+        u64 lanes [2];
+        memcpy (lanes, i_sp, sizeof (lanes));
+        len = snprintf (o_string, i_stringBufferSize, "0x%016" PRIx64 "%016" PRIx64, lanes [1], lanes [0]);
+    }
+#endif
 
     len = M3_MAX (0, len);
 
@@ -59,7 +67,8 @@ cstr_t  SPrintFunctionArgList  (IM3Function i_function, m3stack_t i_sp)
             ret = snprintf (s, e-s, "%s: ", c_waTypes [type]);
             s += M3_MAX (0, ret);
 
-            s += SPrintArg (s, e-s, argSp + i, type);
+            s += SPrintArg (s, e-s, argSp, type);
+            argSp += IsVectorType (type) ? 2 : 1;
 
             if (i != numArgs - 1) {
                 ret = snprintf (s, e-s, ", ");
@@ -128,7 +137,7 @@ void  m3_PrintRuntimeInfo  (IM3Runtime i_runtime)
 
 cstr_t  GetTypeName  (u8 i_m3Type)
 {
-    if (i_m3Type < 5)
+    if (i_m3Type <= c_m3Type_v128)
         return c_waTypes [i_m3Type];
     else
         return "?";
@@ -205,7 +214,7 @@ OpInfo find_operation_info  (IM3Operation i_operation)
 
 
 #undef fetch
-#define fetch(TYPE) (* (TYPE *) ((*o_pc)++))
+#define fetch(TYPE) (* (TYPE *) ((*o_pc += d_m3CodeLines (TYPE)) - d_m3CodeLines (TYPE)))
 
 #define d_m3Decoder(FUNC) void Decode_##FUNC (char * o_string, u8 i_opcode, IM3Operation i_operation, IM3OpInfo i_opInfo, pc_t * o_pc)
 
@@ -306,7 +315,7 @@ void  dump_code_page  (IM3CodePage i_codePage, pc_t i_startPC)
         while (pc < end)
         {
             pc_t operationPC = pc;
-            IM3Operation op = (IM3Operation) (* pc++);
+            IM3Operation op = d_m3Operation (* pc++);
 
                 OpInfo i = find_operation_info (op);
 
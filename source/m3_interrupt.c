@@ -0,0 +1,212 @@
+//
+//  m3_interrupt.c
+//
+//  Interrupting a runtime from another thread & deadlines
+//
+
+#include "m3_interrupt.h"
+#include "m3_exception.h"
+
+// m3_InterruptRuntime only raises runtime->interrupted. the code polls it where a runaway call has to pass
+// sooner or later -- op_Loop, before it starts another iteration, and function entry (op_Entry & tail calls) -- so
+// straight-line code doesn't pay for it, and a loop pays for a load & a branch rather than a call to m3_Yield.
+
+void  m3_InterruptRuntime  (IM3Runtime io_runtime)
+{
+    io_runtime->interrupted = 1;
+}
+
+
+#if d_m3HasPthreads
+
+#include <pthread.h>
+#include <time.h>
+
+// deadlines are kept by a single watchdog thread, started the first time one is armed. armed runtimes are in a
+// binary min-heap on their deadline (each knows its index), so arming, disarming & expiring cost O(log n) with
+// many thousands of them.
+
+static pthread_mutex_t      s_watchdogLock      = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t       s_watchdogWake      = PTHREAD_COND_INITIALIZER;
+static bool                 s_watchdogStarted   = false;
+
+static IM3Runtime *         s_deadlines         = NULL;
+static u32                  s_numDeadlines      = 0;
+static u32                  s_deadlinesCapacity = 0;
+
+
+static
+i64  GetMonotonicTime  ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, & now);
+
+    return (i64) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+
+static
+void  PlaceDeadline  (IM3Runtime i_runtime, u32 i_index)
+{
+    s_deadlines [i_index] = i_runtime;
+    i_runtime->deadlineIndex = i_index + 1;
+}
+
+
+static
+void  SiftDeadline  (u32 i_index)
+{
+    IM3Runtime runtime = s_deadlines [i_index];
+
+    while (i_index)
+    {
+        u32 parent = (i_index - 1) / 2;
+        if (s_deadlines [parent]->deadline <= runtime->deadline)
+            break;
+
+        PlaceDeadline (s_deadlines [parent], i_index);
+        i_index = parent;
+    }
+
+    while (true)
+    {
+        u32 child = 2 * i_index + 1;
+        if (child >= s_numDeadlines)
+            break;
+
+        if (child + 1 < s_numDeadlines and s_deadlines [child + 1]->deadline < s_deadlines [child]->deadline)
+            ++child;
+
+        if (runtime->deadline <= s_deadlines [child]->deadline)
+            break;
+
+        PlaceDeadline (s_deadlines [child], i_index);
+        i_index = child;
+    }
+
+    PlaceDeadline (runtime, i_index);
+}
+
+
+static
+void  RemoveDeadline  (IM3Runtime io_runtime)
+{
+    u32 index = io_runtime->deadlineIndex - 1;
+    io_runtime->deadlineIndex = 0;
+
+    IM3Runtime last = s_deadlines [--s_numDeadlines];
+
+    if (last != io_runtime)
+    {
+        PlaceDeadline (last, index);
+        SiftDeadline (index);
+    }
+}
+
+
+static
+void *  Watchdog  (void * i_unused)
+{
+    pthread_mutex_lock (& s_watchdogLock);
+
+    while (true)
+    {
+        i64 now = GetMonotonicTime ();
+
+        while (s_numDeadlines and s_deadlines [0]->deadline <= now)
+        {
+            IM3Runtime runtime = s_deadlines [0];
+            RemoveDeadline (runtime);
+
+            runtime->interrupted = 1;
+        }
+
+        if (s_numDeadlines)
+        {
+            // condition variables time out against the realtime clock
+            i64 timeLeft = s_deadlines [0]->deadline - now;
+
+            struct timespec wake;
+            clock_gettime (CLOCK_REALTIME, & wake);
+
+            i64 end = (i64) wake.tv_nsec + timeLeft;
+            wake.tv_sec += end / 1000000000;
+            wake.tv_nsec = end % 1000000000;
+
+            pthread_cond_timedwait (& s_watchdogWake, & s_watchdogLock, & wake);
+        }
+        else pthread_cond_wait (& s_watchdogWake, & s_watchdogLock);
+    }
+
+    return NULL;
+}
+
+
+void  DisarmDeadline  (IM3Runtime io_runtime)
+{
+    pthread_mutex_lock (& s_watchdogLock);
+
+    if (io_runtime->deadlineIndex)
+        RemoveDeadline (io_runtime);
+
+    pthread_mutex_unlock (& s_watchdogLock);
+}
+
+
+M3Result  m3_SetDeadline  (IM3Runtime io_runtime, uint32_t i_milliseconds)
+{
+    M3Result result = m3Err_none;
+
+    pthread_mutex_lock (& s_watchdogLock);
+
+    if (io_runtime->deadlineIndex)
+        RemoveDeadline (io_runtime);
+
+    io_runtime->interrupted = 0;
+
+    if (i_milliseconds)
+    {
+        if (not s_watchdogStarted)
+        {
+            pthread_t thread;
+            _throwif ("couldn't start the watchdog thread", pthread_create (& thread, NULL, Watchdog, NULL));
+
+            pthread_detach (thread);
+            s_watchdogStarted = true;
+        }
+
+        if (s_numDeadlines == s_deadlinesCapacity)
+        {
+            u32 capacity = s_deadlinesCapacity ? s_deadlinesCapacity * 2 : 64;
+
+            IM3Runtime * deadlines = m3_ReallocArray (IM3Runtime, s_deadlines, capacity, s_deadlinesCapacity);
+            _throwifnull (deadlines);
+
+            s_deadlines = deadlines;
+            s_deadlinesCapacity = capacity;
+        }
+
+        io_runtime->deadline = GetMonotonicTime () + (i64) i_milliseconds * 1000000;
+
+        PlaceDeadline (io_runtime, s_numDeadlines++);
+        SiftDeadline (s_numDeadlines - 1);
+
+        // the watchdog may be asleep until a later deadline
+        if (io_runtime->deadlineIndex == 1)
+            pthread_cond_signal (& s_watchdogWake);
+    }
+
+    _catch:
+    pthread_mutex_unlock (& s_watchdogLock);
+
+    return result;
+}
+
+#else // d_m3HasPthreads
+
+M3Result  m3_SetDeadline  (IM3Runtime io_runtime, uint32_t i_milliseconds)
+{
+    return "deadlines aren't supported by this build";
+}
+
+#endif // d_m3HasPthreads
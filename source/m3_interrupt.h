@@ -0,0 +1,23 @@
+//
+//  m3_interrupt.h
+//
+//  Interrupting a runtime from another thread & deadlines
+//
+
+#ifndef m3_interrupt_h
+#define m3_interrupt_h
+
+#include "m3_env.h"
+
+d_m3BeginExternC
+
+#if d_m3HasPthreads
+
+// takes the runtime off the watchdog's list; a runtime must be disarmed before it's freed
+void        DisarmDeadline              (IM3Runtime io_runtime);
+
+#endif
+
+d_m3EndExternC
+
+#endif // m3_interrupt_h
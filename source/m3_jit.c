@@ -0,0 +1,1837 @@
+//
+//  m3_jit.c
+//
+//  Baseline x86-64 translation of compiled functions
+//
+
+#include "m3_jit.h"
+#include "m3_compile.h"
+#include "m3_exception.h"
+
+#if d_m3HasJit
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// a translated function is a copy of its metacode in which each op is replaced by a native template with the op's
+// immediates baked in; the slot layout, the branch structure & the calling convention stay the ones m3_compile.c
+// chose. the interpreter's state lives in the same registers for the whole function:
+//
+//      rbx   _sp           r12   _mem          r13   _r0           xmm0  _fp0          r14   the runtime
+//
+// so at every op boundary the machine state is the interpreter's. that's what makes the fallback cheap: an op
+// without a template -- or the slow path of one that has a template, like a trap -- calls the op's implementation
+// with those registers. it runs the rest of the function in the interpreter & returns like a loop body does:
+// 0 when the function returned, a loop id to continue that loop natively, or a trap.
+
+enum
+{
+    c_rax, c_rcx, c_rdx, c_rbx, c_rsp, c_rbp, c_rsi, c_rdi,
+    c_r8, c_r9, c_r10, c_r11, c_r12, c_r13, c_r14, c_r15
+};
+
+enum { c_xmm0, c_xmm1, c_xmm2 };
+
+enum    // condition codes
+{
+    c_jb = 0x2, c_jae = 0x3, c_je = 0x4, c_jne = 0x5, c_jbe = 0x6, c_ja = 0x7, c_js = 0x8,
+    c_jl = 0xc, c_jge = 0xd, c_jle = 0xe, c_jg = 0xf,
+
+    c_jmp = 0x10
+};
+
+// the interpreter's registers
+# define c_sp                       c_rbx
+# define c_mem                      c_r12
+# define c_r0                       c_r13
+# define c_runtime                  c_r14
+
+static const i32 c_inRegister       = -1;           // an operand that's in _r0/_fp0 rather than a slot
+static const u32 c_noLabel          = 0xffffffff;
+
+# define c_jitOpsHashSize           2048            // c_m3JitOps has some 700 entries
+# define c_jitChunkSize             (1024*1024)
+
+
+typedef struct M3JitChunk
+{
+    struct M3JitChunk *     next;
+    size_t                  size;
+}
+M3JitChunk;
+
+typedef struct M3Jit
+{
+    M3JitChunk *            chunks;         // the first is being filled. the code is kept read-only & executable
+    size_t                  chunkUsed;
+
+    const M3JitOp *         ops             [c_jitOpsHashSize];
+}
+M3Jit;
+
+
+typedef struct M3JitSite
+{
+    pc_t                    pc;
+    u32                     offset;
+}
+M3JitSite;
+
+typedef struct M3JitFixup
+{
+    u32                     at;             // where the rel32 is
+    u32                     base;           // what it's relative to
+    u32                     label;          // the target: a label, or
+    pc_t                    pc;             // the native code of a metacode op
+}
+M3JitFixup;
+
+typedef struct M3JitLoop
+{
+    pc_t                    id;             // what op_ContinueLoop returns; the first op of the body
+    u32                     body;
+    u32                     iterate;        // polls for an interrupt & jumps back to the body
+}
+M3JitLoop;
+
+typedef struct M3JitStub
+{
+    pc_t                    pc;
+    u32                     label;
+    bool                    isCallTrap;     // else the op is run by the interpreter
+}
+M3JitStub;
+
+typedef struct M3JitTranslation
+{
+    IM3Jit                  jit;
+    IM3Function             function;
+
+    u8 *                    code;
+    u32                     size,           codeCapacity;
+
+    M3JitSite *             sites;          // open addressing on the pc
+    u32                     numSites,       sitesCapacity;
+
+    pc_t *                  pending;
+    u32                     numPending,     pendingCapacity;
+
+    M3JitFixup *            fixups;
+    u32                     numFixups,      fixupsCapacity;
+
+    u32 *                   labels;
+    u32                     numLabels,      labelsCapacity;
+
+    M3JitLoop *             loops;
+    u32                     numLoops,       loopsCapacity;
+
+    pc_t *                  backEdges;      // the loop ids that translated op_ContinueLoops jump back to
+    u32                     numBackEdges,   backEdgesCapacity;
+
+    M3JitStub *             stubs;
+    u32                     numStubs,       stubsCapacity;
+
+    u32                     exit;
+    u32                     dispatch;
+    u32                     interrupt;
+
+    bool                    failed;
+}
+M3JitTranslation;
+
+typedef M3JitTranslation *  IM3JitTranslation;
+
+
+static
+bool  Reserve  (IM3JitTranslation o, void * io_itemsPointer, u32 * io_capacity, u32 i_count, size_t i_itemSize)
+{
+    if (i_count >= * io_capacity and not o->failed)
+    {
+        u32 capacity = * io_capacity ? * io_capacity * 2 : 64;
+        while (capacity <= i_count)
+            capacity *= 2;
+
+        void * items;
+        memcpy (& items, io_itemsPointer, sizeof (items));
+        items = m3_Realloc ("M3JitTranslation", items, capacity * i_itemSize, * io_capacity * i_itemSize);
+
+        if (items)
+        {
+            memcpy (io_itemsPointer, & items, sizeof (items));
+            * io_capacity = capacity;
+        }
+        else o->failed = true;
+    }
+
+    return not o->failed;
+}
+
+// the array pointer is copied through memcpy rather than a void ** cast
+# define d_reserve(ARRAY, COUNT)    Reserve (o, & o->ARRAY, & o->ARRAY##Capacity, (COUNT), sizeof (* o->ARRAY))
+
+
+static inline
+u32  HashPointer  (const void * i_pointer, u32 i_mask)
+{
+    return (u32) (((u64) i_pointer * 0x9E3779B97F4A7C15ull) >> 40) & i_mask;
+}
+
+
+static
+const M3JitOp *  FindOp  (IM3Jit i_jit, const void * i_op)
+{
+    u32 i = HashPointer (i_op, c_jitOpsHashSize - 1);
+
+    while (i_jit->ops [i])
+    {
+        if ((const void *) i_jit->ops [i]->op == i_op)
+            return i_jit->ops [i];
+
+        i = (i + 1) & (c_jitOpsHashSize - 1);
+    }
+
+    return NULL;
+}
+
+
+static
+M3JitSite *  FindSite  (IM3JitTranslation o, pc_t i_pc)
+{
+    u32 mask = o->sitesCapacity - 1;
+    u32 i = HashPointer (i_pc, mask);
+
+    while (o->sites [i].pc)
+    {
+        if (o->sites [i].pc == i_pc)
+            return & o->sites [i];
+
+        i = (i + 1) & mask;
+    }
+
+    return & o->sites [i];
+}
+
+
+static
+void  AddSite  (IM3JitTranslation o, pc_t i_pc)
+{
+    // kept at most half full
+    if (2 * (o->numSites + 1) > o->sitesCapacity)
+    {
+        M3JitSite * sites = o->sites;
+        u32 capacity = o->sitesCapacity;
+
+        o->sitesCapacity = capacity ? capacity * 2 : 1024;
+        o->sites = m3_AllocArray (M3JitSite, o->sitesCapacity);
+
+        if (not o->sites)
+        {
+            o->sites = sites;
+            o->sitesCapacity = capacity;
+            o->failed = true;
+            return;
+        }
+
+        for (u32 i = 0; i < capacity; ++i)
+        {
+            if (sites [i].pc)
+                * FindSite (o, sites [i].pc) = sites [i];
+        }
+
+        m3_Free (sites);
+    }
+
+    M3JitSite * site = FindSite (o, i_pc);
+    site->pc = i_pc;
+    site->offset = o->size;
+
+    o->numSites++;
+}
+
+
+static
+bool  IsTranslated  (IM3JitTranslation o, pc_t i_pc)
+{
+    return o->numSites and FindSite (o, i_pc)->pc;
+}
+
+
+//----- EMIT --------------------------------------------------------------------------------------------------------------
+
+static
+void  Emit8  (IM3JitTranslation o, u8 i_byte)
+{
+    if (d_reserve (code, o->size + 1))
+        o->code [o->size++] = i_byte;
+}
+
+
+static
+void  Emit32  (IM3JitTranslation o, u32 i_value)
+{
+    for (u32 i = 0; i < 4; ++i)
+        Emit8 (o, (u8) (i_value >> (i * 8)));
+}
+
+
+static
+void  Emit64  (IM3JitTranslation o, u64 i_value)
+{
+    Emit32 (o, (u32) i_value);
+    Emit32 (o, (u32) (i_value >> 32));
+}
+
+
+static
+u32  NewLabel  (IM3JitTranslation o)
+{
+    if (not d_reserve (labels, o->numLabels))
+        return 0;
+
+    o->labels [o->numLabels] = c_noLabel;
+    return o->numLabels++;
+}
+
+
+static
+void  BindLabel  (IM3JitTranslation o, u32 i_label)
+{
+    if (not o->failed)
+        o->labels [i_label] = o->size;
+}
+
+
+static
+void  AddFixup  (IM3JitTranslation o, u32 i_base, u32 i_label, pc_t i_pc)
+{
+    if (d_reserve (fixups, o->numFixups))
+    {
+        M3JitFixup * fixup = & o->fixups [o->numFixups++];
+
+        fixup->at = o->size;
+        fixup->base = i_base;
+        fixup->label = i_label;
+        fixup->pc = i_pc;
+    }
+
+    Emit32 (o, 0);
+}
+
+
+// prefix: 0x66, 0xf2, 0xf3 or none; opcode: one byte or 0x0fxx
+static
+void  EmitOpcode  (IM3JitTranslation o, u8 i_prefix, bool i_wide, u32 i_opcode, u8 i_reg, u8 i_index, u8 i_base)
+{
+    if (i_prefix)
+        Emit8 (o, i_prefix);
+
+    u8 rex = 0x40 | (i_wide << 3) | ((i_reg & 8) >> 1) | ((i_index & 8) >> 2) | ((i_base & 8) >> 3);
+    if (rex != 0x40)
+        Emit8 (o, rex);
+
+    if (i_opcode > 0xff)
+        Emit8 (o, (u8) (i_opcode >> 8));
+
+    Emit8 (o, (u8) i_opcode);
+}
+
+
+static
+void  EmitDisplacement  (IM3JitTranslation o, u8 i_modRM, i32 i_displacement, bool i_hasSIB, u8 i_sib)
+{
+    bool isShort = (i_displacement == (i8) i_displacement);
+
+    // always with a displacement, which sidesteps the special cases of rbp & r13 as a base
+    Emit8 (o, i_modRM | (isShort ? 0x40 : 0x80));
+
+    if (i_hasSIB)
+        Emit8 (o, i_sib);
+
+    if (isShort)
+        Emit8 (o, (u8) i_displacement);
+    else
+        Emit32 (o, (u32) i_displacement);
+}
+
+
+// op reg, reg/rm
+static
+void  EmitRR  (IM3JitTranslation o, u8 i_prefix, bool i_wide, u32 i_opcode, u8 i_reg, u8 i_rm)
+{
+    EmitOpcode (o, i_prefix, i_wide, i_opcode, i_reg, 0, i_rm);
+    Emit8 (o, 0xc0 | ((i_reg & 7) << 3) | (i_rm & 7));
+}
+
+
+// op reg, [base + displacement]
+static
+void  EmitRM  (IM3JitTranslation o, u8 i_prefix, bool i_wide, u32 i_opcode, u8 i_reg, u8 i_base, i32 i_displacement)
+{
+    EmitOpcode (o, i_prefix, i_wide, i_opcode, i_reg, 0, i_base);
+
+    bool needsSIB = ((i_base & 7) == c_rsp);
+    EmitDisplacement (o, ((i_reg & 7) << 3) | (needsSIB ? 4 : (i_base & 7)), i_displacement, needsSIB, 0x24);
+}
+
+
+// op reg, [base + index + displacement]
+static
+void  EmitRMI  (IM3JitTranslation o, u8 i_prefix, bool i_wide, u32 i_opcode, u8 i_reg, u8 i_base, u8 i_index, i32 i_displacement)
+{
+    EmitOpcode (o, i_prefix, i_wide, i_opcode, i_reg, i_index, i_base);
+    EmitDisplacement (o, ((i_reg & 7) << 3) | 4, i_displacement, true, ((i_index & 7) << 3) | (i_base & 7));
+}
+
+
+static
+void  EmitMovImm64  (IM3JitTranslation o, u8 i_reg, u64 i_value)
+{
+    if (i_value <= 0xffffffff)
+    {
+        EmitOpcode (o, 0, false, 0xb8 + (i_reg & 7), 0, 0, i_reg);
+        Emit32 (o, (u32) i_value);
+    }
+    else
+    {
+        EmitOpcode (o, 0, true, 0xb8 + (i_reg & 7), 0, 0, i_reg);
+        Emit64 (o, i_value);
+    }
+}
+
+
+static
+void  EmitCallC  (IM3JitTranslation o, const void * i_function)
+{
+    EmitMovImm64 (o, c_rax, (u64) i_function);
+    EmitRR (o, 0, false, 0xff, 2, c_rax);                                   // call rax
+}
+
+
+static
+void  EmitJump  (IM3JitTranslation o, u8 i_condition, u32 i_label, pc_t i_pc)
+{
+    if (i_condition == c_jmp)
+        Emit8 (o, 0xe9);
+    else
+    {
+        Emit8 (o, 0x0f);
+        Emit8 (o, 0x80 | i_condition);
+    }
+
+    AddFixup (o, o->size + 4, i_label, i_pc);
+}
+
+
+static
+void  EmitJumpToLabel  (IM3JitTranslation o, u8 i_condition, u32 i_label)
+{
+    EmitJump (o, i_condition, i_label, NULL);
+}
+
+
+static
+void  EmitJumpToPC  (IM3JitTranslation o, u8 i_condition, pc_t i_pc)
+{
+    EmitJump (o, i_condition, 0, i_pc);
+
+    if (not IsTranslated (o, i_pc) and d_reserve (pending, o->numPending))
+        o->pending [o->numPending++] = i_pc;
+}
+
+
+// a slow path that's emitted after the function body
+static
+u32  AddStub  (IM3JitTranslation o, pc_t i_pc, bool i_isCallTrap)
+{
+    u32 label = NewLabel (o);
+
+    if (d_reserve (stubs, o->numStubs))
+    {
+        M3JitStub * stub = & o->stubs [o->numStubs++];
+
+        stub->pc = i_pc;
+        stub->label = label;
+        stub->isCallTrap = i_isCallTrap;
+    }
+
+    return label;
+}
+
+
+static
+M3JitLoop *  FindLoop  (IM3JitTranslation o, pc_t i_id)
+{
+    for (u32 i = 0; i < o->numLoops; ++i)
+    {
+        if (o->loops [i].id == i_id)
+            return & o->loops [i];
+    }
+
+    return NULL;
+}
+
+
+// i_site: the loop id immediate of a translated op_ContinueLoop
+static
+void  NoteBackEdge  (IM3JitTranslation o, pc_t i_site)
+{
+# if d_m3FlattenLoops
+    if (d_reserve (backEdges, o->numBackEdges))
+        o->backEdges [o->numBackEdges++] = i_site;
+# endif
+}
+
+
+// an interpreted loop iterates by jumping back to its body (d_m3FlattenLoops), which would keep the rest of a call
+// that the translation hands to the interpreter (see EmitBridge) there. so the loops that were translated are
+// made to return their id instead: op_Loop becomes op_JitLoop & the back-edges jump to it
+static
+void  PatchTranslatedLoops  (IM3JitTranslation o)
+{
+# if d_m3FlattenLoops
+    for (u32 i = 0; i < o->numLoops; ++i)
+        * (void **) (o->loops [i].id - 1) = (void *) c_m3JitOps.jitLoop;
+
+    for (u32 i = 0; i < o->numBackEdges; ++i)
+    {
+        pc_t * target = (pc_t *) o->backEdges [i];
+        * target = * target - 1;
+    }
+# endif
+}
+
+
+//----- TEMPLATES ---------------------------------------------------------------------------------------------------------
+
+static inline
+i32  SlotImmediate  (pc_t i_pc)
+{
+    return * (i32 *) i_pc * (i32) sizeof (m3slot_t);
+}
+
+
+static inline
+bool  IsWide  (u8 i_type)
+{
+    return (i_type == c_m3Type_i64 or i_type == c_m3Type_f64);
+}
+
+
+// hands the rest of the call to the interpreter, starting at the op at i_pc
+static
+void  EmitBridge  (IM3JitTranslation o, pc_t i_pc)
+{
+    EmitMovImm64 (o, c_rax, (u64) i_pc);
+    EmitRM (o, 0, true, 0x8d, c_rdi, c_rax, sizeof (void *));                // lea rdi, [rax + 8]
+    EmitRR (o, 0, true, 0x8b, c_rsi, c_sp);
+    EmitRR (o, 0, true, 0x8b, c_rdx, c_mem);
+    EmitRR (o, 0, true, 0x8b, c_rcx, c_r0);
+    EmitRM (o, 0, false, 0xff, 2, c_rax, 0);                                // call [rax]; _fp0 is already in xmm0
+    EmitJumpToLabel (o, c_jmp, o->dispatch);
+}
+
+
+static
+void  EmitReloadMemory  (IM3JitTranslation o)
+{
+    EmitRM (o, 0, true, 0x8b, c_mem, c_runtime, offsetof (M3Runtime, memory) + offsetof (M3Memory, mallocated));
+}
+
+
+static
+void  EmitLoadInt  (IM3JitTranslation o, bool i_wide, u8 i_reg, i32 i_operand)
+{
+    if (i_operand == c_inRegister)
+        EmitRR (o, 0, i_wide, 0x8b, i_reg, c_r0);
+    else
+        EmitRM (o, 0, i_wide, 0x8b, i_reg, c_sp, i_operand);
+}
+
+
+static
+void  EmitLoadFloat  (IM3JitTranslation o, u8 i_type, u8 i_xmm, i32 i_operand)
+{
+    bool isF64 = (i_type == c_m3Type_f64);
+
+    if (i_operand == c_inRegister)
+        EmitRR (o, isF64 ? 0x66 : 0xf2, false, isF64 ? 0x0f28 : 0x0f5a, i_xmm, c_xmm0);     // movapd / cvtsd2ss
+    else
+        EmitRM (o, isF64 ? 0xf2 : 0xf3, false, 0x0f10, i_xmm, c_sp, i_operand);            // movsd / movss
+}
+
+
+static
+void  EmitStoreFloat  (IM3JitTranslation o, u8 i_type, u8 i_xmm, u8 i_base, i32 i_displacement)
+{
+    EmitRM (o, (i_type == c_m3Type_f64) ? 0xf2 : 0xf3, false, 0x0f11, i_xmm, i_base, i_displacement);
+}
+
+
+// _fp0 = xmm1, widening an f32
+static
+void  EmitSetFloatRegister  (IM3JitTranslation o, u8 i_type)
+{
+    if (i_type == c_m3Type_f64)
+        EmitRR (o, 0x66, false, 0x0f28, c_xmm0, c_xmm1);
+    else
+        EmitRR (o, 0xf3, false, 0x0f5a, c_xmm0, c_xmm1);
+}
+
+
+// the operands of a binary op (or a compare & branch) by form; returns the number of slot immediates read
+static
+u32  GetOperands  (u8 i_form, pc_t i_immediates, i32 * o_operand1, i32 * o_operand2)
+{
+    switch (i_form)
+    {
+        case c_m3JitForm_rs:    * o_operand1 = SlotImmediate (i_immediates);        * o_operand2 = c_inRegister;                        return 1;
+        case c_m3JitForm_sr:    * o_operand1 = c_inRegister;                        * o_operand2 = SlotImmediate (i_immediates);        return 1;
+        case c_m3JitForm_ss:    * o_operand1 = SlotImmediate (i_immediates + 1);    * o_operand2 = SlotImmediate (i_immediates);        return 2;
+        case c_m3JitForm_s:     * o_operand1 = SlotImmediate (i_immediates);        * o_operand2 = c_inRegister;                        return 1;
+        default:                * o_operand1 = c_inRegister;                        * o_operand2 = c_inRegister;                        return 0;
+    }
+}
+
+
+static
+u8  GetCondition  (u8 i_op)
+{
+    switch (i_op)
+    {
+        case c_m3JitOp_Eq:      return c_je;
+        case c_m3JitOp_Ne:      return c_jne;
+        case c_m3JitOp_LtS:     return c_jl;
+        case c_m3JitOp_LtU:     return c_jb;
+        case c_m3JitOp_GtS:     return c_jg;
+        case c_m3JitOp_GtU:     return c_ja;
+        case c_m3JitOp_LeS:     return c_jle;
+        case c_m3JitOp_LeU:     return c_jbe;
+        case c_m3JitOp_GeS:     return c_jge;
+        case c_m3JitOp_GeU:     return c_jae;
+        case c_m3JitOp_Eqz:     return c_je;
+        default:                return c_jne;       // c_m3JitOp_NonZero
+    }
+}
+
+
+// sets the flags for a condition & returns the condition code that holds when it's true
+static
+u8  EmitCondition  (IM3JitTranslation o, const M3JitOp * i_op, i32 i_operand1, i32 i_operand2)
+{
+    bool wide = IsWide (i_op->type);
+
+    if (i_op->arg == c_m3JitOp_NonZero or i_op->arg == c_m3JitOp_Eqz)
+    {
+        EmitLoadInt (o, i_op->arg == c_m3JitOp_Eqz and wide, c_rax, i_operand1);
+        EmitRR (o, 0, wide, 0x85, c_rax, c_rax);                            // test
+    }
+    else
+    {
+        EmitLoadInt (o, wide, c_rax, i_operand1);
+        EmitLoadInt (o, wide, c_rcx, i_operand2);
+        EmitRR (o, 0, wide, 0x3b, c_rax, c_rcx);                            // cmp
+    }
+
+    return GetCondition (i_op->arg);
+}
+
+
+static
+void  EmitIntegerOp  (IM3JitTranslation o, const M3JitOp * i_op, pc_t i_pc, i32 i_operand1, i32 i_operand2)
+{
+    bool wide = IsWide (i_op->type);
+    u8 op = i_op->arg;
+
+    EmitLoadInt (o, wide, c_rax, i_operand1);
+
+    if (i_op->form != c_m3JitForm_r and i_op->form != c_m3JitForm_s)
+        EmitLoadInt (o, wide, c_rcx, i_operand2);
+
+    switch (op)
+    {
+        case c_m3JitOp_Add:     EmitRR (o, 0, wide, 0x03, c_rax, c_rcx);    break;
+        case c_m3JitOp_Sub:     EmitRR (o, 0, wide, 0x2b, c_rax, c_rcx);    break;
+        case c_m3JitOp_Mul:     EmitRR (o, 0, wide, 0x0faf, c_rax, c_rcx);  break;
+        case c_m3JitOp_And:     EmitRR (o, 0, wide, 0x23, c_rax, c_rcx);    break;
+        case c_m3JitOp_Or:      EmitRR (o, 0, wide, 0x0b, c_rax, c_rcx);    break;
+        case c_m3JitOp_Xor:     EmitRR (o, 0, wide, 0x33, c_rax, c_rcx);    break;
+
+        // by cl, which masks the count like wasm does
+        case c_m3JitOp_Shl:     EmitRR (o, 0, wide, 0xd3, 4, c_rax);        break;
+        case c_m3JitOp_ShrS:    EmitRR (o, 0, wide, 0xd3, 7, c_rax);        break;
+        case c_m3JitOp_ShrU:    EmitRR (o, 0, wide, 0xd3, 5, c_rax);        break;
+        case c_m3JitOp_Rotl:    EmitRR (o, 0, wide, 0xd3, 0, c_rax);        break;
+        case c_m3JitOp_Rotr:    EmitRR (o, 0, wide, 0xd3, 1, c_rax);        break;
+
+        case c_m3JitOp_DivS:
+        case c_m3JitOp_RemS:
+        case c_m3JitOp_DivU:
+        case c_m3JitOp_RemU:
+        {
+            bool isSigned = (op == c_m3JitOp_DivS or op == c_m3JitOp_RemS);
+
+            // the interpreter traps on a zero divisor. a divisor of -1 is rare enough to leave to it as well;
+            // idiv faults on INT_MIN / -1
+            u32 slowPath = AddStub (o, i_pc, false);
+
+            EmitRR (o, 0, wide, 0x85, c_rcx, c_rcx);
+            EmitJumpToLabel (o, c_je, slowPath);
+
+            if (isSigned)
+            {
+                EmitRR (o, 0, wide, 0x83, 7, c_rcx);                        // cmp rcx, -1
+                Emit8 (o, 0xff);
+                EmitJumpToLabel (o, c_je, slowPath);
+
+                EmitOpcode (o, 0, wide, 0x99, 0, 0, 0);                     // cdq / cqo
+                EmitRR (o, 0, wide, 0xf7, 7, c_rcx);                        // idiv
+            }
+            else
+            {
+                EmitRR (o, 0, false, 0x33, c_rdx, c_rdx);
+                EmitRR (o, 0, wide, 0xf7, 6, c_rcx);                        // div
+            }
+
+            if (op == c_m3JitOp_RemS or op == c_m3JitOp_RemU)
+                EmitRR (o, 0, true, 0x8b, c_rax, c_rdx);
+            break;
+        }
+
+        case c_m3JitOp_Eq:  case c_m3JitOp_Ne:  case c_m3JitOp_LtS: case c_m3JitOp_LtU: case c_m3JitOp_GtS:
+        case c_m3JitOp_GtU: case c_m3JitOp_LeS: case c_m3JitOp_LeU: case c_m3JitOp_GeS: case c_m3JitOp_GeU:
+        case c_m3JitOp_Eqz:
+        {
+            if (op == c_m3JitOp_Eqz)
+                EmitRR (o, 0, wide, 0x85, c_rax, c_rax);
+            else
+                EmitRR (o, 0, wide, 0x3b, c_rax, c_rcx);
+
+            EmitRR (o, 0, false, 0x0f90 | GetCondition (op), 0, c_rax);       // setcc al
+            EmitRR (o, 0, false, 0x0fb6, c_rax, c_rax);                         // movzx eax, al
+            break;
+        }
+
+        case c_m3JitOp_Extend8:     EmitRR (o, 0, wide, 0x0fbe, c_rax, c_rax);  break;
+        case c_m3JitOp_Extend16:    EmitRR (o, 0, wide, 0x0fbf, c_rax, c_rax);  break;
+        case c_m3JitOp_Extend32:    EmitRR (o, 0, true, 0x63, c_rax, c_rax);    break;
+        case c_m3JitOp_ExtendU32:
+        case c_m3JitOp_Wrap:        EmitRR (o, 0, false, 0x8b, c_rax, c_rax);   break;
+
+        default:
+            o->failed = true;
+    }
+
+    EmitRR (o, 0, true, 0x8b, c_r0, c_rax);
+}
+
+
+// see div_const_i32: a multiply-high by the magic number, corrected by the dividend's sign
+static
+void  EmitDivideByConstant  (IM3JitTranslation o, const M3JitOp * i_op, i32 i_operand, i64 i_magic, i64 i_divisor, u32 i_shift)
+{
+    bool wide = IsWide (i_op->type);
+    u64 mask = wide ? UINT64_MAX : UINT32_MAX;
+
+    EmitLoadInt (o, wide, c_rcx, i_operand);
+    EmitMovImm64 (o, c_rax, (u64) i_magic & mask);
+    EmitRR (o, 0, wide, 0xf7, 5, c_rcx);                                    // imul rcx: rdx = the high half
+
+    if (i_divisor > 0 and i_magic < 0)
+        EmitRR (o, 0, wide, 0x03, c_rdx, c_rcx);
+    else if (i_divisor < 0 and i_magic > 0)
+        EmitRR (o, 0, wide, 0x2b, c_rdx, c_rcx);
+
+    if (i_shift)
+    {
+        EmitRR (o, 0, wide, 0xc1, 7, c_rdx);                                // sar rdx, shift
+        Emit8 (o, (u8) i_shift);
+    }
+
+    EmitRR (o, 0, wide, 0x8b, c_rax, c_rdx);
+    EmitRR (o, 0, wide, 0xc1, 5, c_rax);                                    // shr rax, 31 / 63
+    Emit8 (o, wide ? 63 : 31);
+    EmitRR (o, 0, wide, 0x03, c_rax, c_rdx);
+
+    if (i_op->arg == c_m3JitOp_RemS)
+    {
+        EmitMovImm64 (o, c_rdx, (u64) i_divisor & mask);
+        EmitRR (o, 0, wide, 0x0faf, c_rax, c_rdx);
+        EmitRR (o, 0, wide, 0x2b, c_rcx, c_rax);
+        EmitRR (o, 0, true, 0x8b, c_rax, c_rcx);
+    }
+
+    EmitRR (o, 0, true, 0x8b, c_r0, c_rax);
+}
+
+
+static
+void  EmitFloatOp  (IM3JitTranslation o, const M3JitOp * i_op, i32 i_operand1, i32 i_operand2)
+{
+    u8 prefix = (i_op->type == c_m3Type_f64) ? 0xf2 : 0xf3;
+
+    EmitLoadFloat (o, i_op->type, c_xmm1, i_operand1);
+    EmitLoadFloat (o, i_op->type, c_xmm2, i_operand2);
+
+    switch (i_op->arg)
+    {
+        case c_m3JitOp_Add:     EmitRR (o, prefix, false, 0x0f58, c_xmm1, c_xmm2);      break;
+        case c_m3JitOp_Mul:     EmitRR (o, prefix, false, 0x0f59, c_xmm1, c_xmm2);      break;
+        case c_m3JitOp_Sub:     EmitRR (o, prefix, false, 0x0f5c, c_xmm1, c_xmm2);      break;
+        case c_m3JitOp_Div:     EmitRR (o, prefix, false, 0x0f5e, c_xmm1, c_xmm2);      break;
+        default:                o->failed = true;
+    }
+
+    EmitSetFloatRegister (o, i_op->type);
+}
+
+
+// the byte offset of the constant slots in the frame
+static
+i32  GetConstantsOffset  (IM3Function i_function)
+{
+    return i_function->numRetAndArgSlots * sizeof (m3slot_t) + i_function->numLocalBytes;
+}
+
+
+// a constant operand's slot is filled by EmitStoreConstants on entry, so its value is known here
+static
+bool  GetConstantOperand  (IM3JitTranslation o, i32 i_operand, u32 * o_value)
+{
+    IM3Function function = o->function;
+    i32 constants = GetConstantsOffset (function);
+
+    if (i_operand == c_inRegister or i_operand < constants or i_operand + (i32) sizeof (u32) > constants + function->numConstantBytes)
+        return false;
+
+    memcpy (o_value, (u8 *) function->constants + (i_operand - constants), sizeof (u32));
+
+    return true;
+}
+
+
+// memory never shrinks, so an access through a constant address within the memory the module starts with can't be
+// out of bounds. an imported memory's size isn't known until it's run
+static
+bool  IsInInitialMemory  (IM3JitTranslation o, u64 i_end)
+{
+    IM3Module module = o->function->module;
+
+    if (module->memoryImported)
+        return false;
+
+    u32 pageSize = module->memoryInfo.pageSize ? module->memoryInfo.pageSize : d_m3DefaultMemPageSize;
+    u64 length = (u64) module->memoryInfo.initPages * pageSize;
+
+    if (module->runtime->memoryLimit)
+        length = M3_MIN (length, module->runtime->memoryLimit);
+
+    return i_end <= length;
+}
+
+
+// rax = the effective address of a memory access; jumps to the op's own implementation when it's out of bounds
+static
+void  EmitAddress  (IM3JitTranslation o, pc_t i_pc, i32 i_address, u32 i_offset, u32 i_size)
+{
+    u32 address;
+
+    if (GetConstantOperand (o, i_address, & address) and IsInInitialMemory (o, (u64) address + i_offset + i_size))
+    {
+        EmitMovImm64 (o, c_rax, (u64) address + i_offset);
+        return;
+    }
+
+    EmitLoadInt (o, false, c_rax, i_address);                               // zero-extended
+
+    if (i_offset > INT32_MAX)
+    {
+        EmitMovImm64 (o, c_rcx, i_offset);
+        EmitRR (o, 0, true, 0x03, c_rax, c_rcx);
+    }
+    else if (i_offset)
+    {
+        EmitRR (o, 0, true, 0x81, 0, c_rax);                                // add rax, imm32
+        Emit32 (o, i_offset);
+    }
+
+# if !d_m3SkipMemoryBoundsCheck && !d_m3UseGuardPages
+    EmitRM (o, 0, true, 0x8d, c_rcx, c_rax, i_size);                        // lea rcx, [rax + size]
+    EmitRM (o, 0, true, 0x3b, c_rcx, c_mem, offsetof (M3MemoryHeader, length));
+    EmitJumpToLabel (o, c_ja, AddStub (o, i_pc, false));
+# endif
+}
+
+
+static
+u32  GetAccessSize  (u8 i_access)
+{
+    switch (i_access)
+    {
+        case c_m3JitAccess_i8:  case c_m3JitAccess_u8:      return 1;
+        case c_m3JitAccess_i16: case c_m3JitAccess_u16:     return 2;
+        case c_m3JitAccess_64:  case c_m3JitAccess_f64:     return 8;
+        default:                                            return 4;
+    }
+}
+
+
+static
+void  EmitLoad  (IM3JitTranslation o, const M3JitOp * i_op, pc_t i_pc, i32 i_address, u32 i_offset)
+{
+    EmitAddress (o, i_pc, i_address, i_offset, GetAccessSize (i_op->arg));
+
+    bool wide = IsWide (i_op->type);
+    i32 data = sizeof (M3MemoryHeader);
+
+    switch (i_op->arg)
+    {
+        case c_m3JitAccess_i8:  EmitRMI (o, 0, wide, 0x0fbe, c_rax, c_mem, c_rax, data);    break;
+        case c_m3JitAccess_u8:  EmitRMI (o, 0, false, 0x0fb6, c_rax, c_mem, c_rax, data);   break;
+        case c_m3JitAccess_i16: EmitRMI (o, 0, wide, 0x0fbf, c_rax, c_mem, c_rax, data);    break;
+        case c_m3JitAccess_u16: EmitRMI (o, 0, false, 0x0fb7, c_rax, c_mem, c_rax, data);   break;
+        case c_m3JitAccess_i32:
+            if (wide)
+                EmitRMI (o, 0, true, 0x63, c_rax, c_mem, c_rax, data);                      // movsxd
+            else
+                EmitRMI (o, 0, false, 0x8b, c_rax, c_mem, c_rax, data);
+            break;
+        case c_m3JitAccess_u32: EmitRMI (o, 0, false, 0x8b, c_rax, c_mem, c_rax, data);     break;
+        case c_m3JitAccess_64:  EmitRMI (o, 0, true, 0x8b, c_rax, c_mem, c_rax, data);      break;
+        case c_m3JitAccess_f32: EmitRMI (o, 0xf3, false, 0x0f5a, c_xmm0, c_mem, c_rax, data);   return;  // cvtss2sd
+        case c_m3JitAccess_f64: EmitRMI (o, 0xf2, false, 0x0f10, c_xmm0, c_mem, c_rax, data);   return;
+    }
+
+    EmitRR (o, 0, true, 0x8b, c_r0, c_rax);
+}
+
+
+static
+void  EmitStore  (IM3JitTranslation o, const M3JitOp * i_op, pc_t i_pc, i32 i_value, i32 i_address, u32 i_offset)
+{
+    EmitAddress (o, i_pc, i_address, i_offset, GetAccessSize (i_op->arg));
+
+    i32 data = sizeof (M3MemoryHeader);
+
+    if (i_op->arg == c_m3JitAccess_f32 or i_op->arg == c_m3JitAccess_f64)
+    {
+        u8 xmm = c_xmm0;
+
+        if (i_value != c_inRegister or i_op->arg == c_m3JitAccess_f32)
+        {
+            EmitLoadFloat (o, i_op->type, c_xmm1, i_value);
+            xmm = c_xmm1;
+        }
+
+        EmitRMI (o, (i_op->arg == c_m3JitAccess_f64) ? 0xf2 : 0xf3, false, 0x0f11, xmm, c_mem, c_rax, data);
+    }
+    else
+    {
+        EmitLoadInt (o, IsWide (i_op->type), c_rdx, i_value);
+
+        switch (i_op->arg)
+        {
+            case c_m3JitAccess_u8:  EmitRMI (o, 0, false, 0x88, c_rdx, c_mem, c_rax, data);     break;
+            case c_m3JitAccess_u16: EmitRMI (o, 0x66, false, 0x89, c_rdx, c_mem, c_rax, data);  break;
+            case c_m3JitAccess_u32: EmitRMI (o, 0, false, 0x89, c_rdx, c_mem, c_rax, data);     break;
+            default:                EmitRMI (o, 0, true, 0x89, c_rdx, c_mem, c_rax, data);      break;
+        }
+    }
+}
+
+
+static
+void  EmitSetSlot  (IM3JitTranslation o, u8 i_type, i32 i_slot)
+{
+    if (i_type == c_m3Type_f32)
+    {
+        EmitRR (o, 0xf2, false, 0x0f5a, c_xmm1, c_xmm0);                    // cvtsd2ss
+        EmitStoreFloat (o, i_type, c_xmm1, c_sp, i_slot);
+    }
+    else if (i_type == c_m3Type_f64)
+        EmitStoreFloat (o, i_type, c_xmm0, c_sp, i_slot);
+    else
+        EmitRM (o, 0, IsWide (i_type), 0x89, c_r0, c_sp, i_slot);
+}
+
+
+static
+void  EmitCopySlot  (IM3JitTranslation o, bool i_wide, i32 i_to, i32 i_from)
+{
+    EmitRM (o, 0, i_wide, 0x8b, c_rax, c_sp, i_from);
+    EmitRM (o, 0, i_wide, 0x89, c_rax, c_sp, i_to);
+}
+
+
+// op_Compile is rewritten into op_Call the first time it runs, so its callee is read from the metacode
+static
+m3ret_t  LinkCall  (pc_t i_pc)
+{
+    IM3Function function = * (IM3Function *) (i_pc + 1);
+
+    M3Result result = m3Err_none;
+
+    if (not function->compiled)
+        result = CompileFunction (function);
+
+    if (not result)
+    {
+        * (void **) (i_pc + 1) = (void *) function->compiled;
+        * (void **) i_pc = (void *) c_m3JitOps.call;
+    }
+
+    return result;
+}
+
+
+// op_CallIndirect
+static
+m3ret_t  CallIndirect  (pc_t i_pc, m3stack_t i_sp, M3MemoryHeader * i_mem)
+{
+    u32 tableIndex              = * (u32 *) (i_sp + * (i32 *) (i_pc + 1));
+    IM3Module module            = * (IM3Module *) (i_pc + 2);
+    IM3FuncType type            = * (IM3FuncType *) (i_pc + 3);
+    i32 stackOffset             = * (i32 *) (i_pc + 4);
+    M3CallCache * cache         = (M3CallCache *) (i_pc + 5);
+    IM3Runtime runtime          = i_mem->runtime;
+
+    pc_t pc;
+
+    if (M3_LIKELY(module and tableIndex == cache->tableIndex and module->table0Version == cache->tableVersion))
+    {
+        pc = cache->compiled;
+        runtime->callCacheHits++;
+    }
+    else
+    {
+        IM3Module instance = module ? module : runtime->instance;
+
+        runtime->callCacheMisses++;
+
+        if (M3_UNLIKELY(tableIndex >= instance->table0Size))
+            return m3Err_trapTableIndexOutOfRange;
+
+        IM3Function function = instance->table0 [tableIndex];
+
+        if (M3_UNLIKELY(not function))
+            return m3Err_trapTableElementIsNull;
+
+        if (M3_UNLIKELY(type != function->funcType))
+            return m3Err_trapIndirectCallTypeMismatch;
+
+        if (M3_UNLIKELY(not function->compiled))
+        {
+            M3Result result = CompileFunction (function);
+            if (result)
+                return result;
+        }
+
+        pc = function->compiled;
+
+        if (module)
+            * cache = (M3CallCache) { tableIndex, module->table0Version, pc };
+    }
+
+    m3ret_t r = m3_Yield ();
+    if (M3_UNLIKELY(r))
+        return r;
+
+    return ((IM3Operation) * pc) (pc + 1, i_sp + stackOffset, i_mem, 0, 0.);
+}
+
+
+// a trap from a call is forwarded as it is
+static
+u32  GetCallTrapLabel  (IM3JitTranslation o, pc_t i_pc)
+{
+# if d_m3RecordBacktraces
+    return AddStub (o, i_pc, true);
+# else
+    return o->exit;
+# endif
+}
+
+
+static
+void  EmitCall  (IM3JitTranslation o, const M3JitOp * i_op, pc_t i_pc)
+{
+    u32 trap = GetCallTrapLabel (o, i_pc);
+    i32 stackOffset = * (i32 *) (i_pc + 2) * (i32) sizeof (m3slot_t);
+
+    EmitRM (o, 0xf2, false, 0x0f11, c_xmm0, c_rsp, 0);                      // save _fp0
+
+    if (i_op->kind == c_m3JitCallIndirect)
+    {
+        stackOffset = 0;
+
+        EmitMovImm64 (o, c_rdi, (u64) i_pc);
+        EmitRR (o, 0, true, 0x8b, c_rsi, c_sp);
+        EmitRR (o, 0, true, 0x8b, c_rdx, c_mem);
+        EmitCallC (o, (const void *) CallIndirect);
+    }
+    else
+    {
+        bool isLinked = (i_op->kind == c_m3JitCall);
+
+        if (not isLinked)
+        {
+            IM3Function function = * (IM3Function *) (i_pc + 1);
+            u32 linked = NewLabel (o);
+
+            EmitMovImm64 (o, c_rax, (u64) (i_pc + 1));
+            EmitRM (o, 0, true, 0x8b, c_rdi, c_rax, 0);
+            EmitMovImm64 (o, c_rcx, (u64) function);
+            EmitRR (o, 0, true, 0x3b, c_rdi, c_rcx);
+            EmitJumpToLabel (o, c_jne, linked);
+
+            EmitMovImm64 (o, c_rdi, (u64) i_pc);
+            EmitCallC (o, (const void *) LinkCall);
+            EmitRR (o, 0, true, 0x85, c_rax, c_rax);
+            EmitJumpToLabel (o, c_jne, trap);
+
+            BindLabel (o, linked);
+        }
+
+        EmitCallC (o, (const void *) m3_Yield);
+        EmitRR (o, 0, true, 0x85, c_rax, c_rax);
+        EmitJumpToLabel (o, c_jne, trap);
+
+        if (isLinked)
+            EmitMovImm64 (o, c_rdi, (u64) * (pc_t *) (i_pc + 1));
+        else
+        {
+            EmitMovImm64 (o, c_rax, (u64) (i_pc + 1));
+            EmitRM (o, 0, true, 0x8b, c_rdi, c_rax, 0);
+        }
+
+        // the callee's entry op, with the same registers Call () passes
+        EmitRM (o, 0, true, 0x8d, c_rsi, c_sp, stackOffset);
+        EmitRR (o, 0, true, 0x8b, c_rdx, c_mem);
+        EmitRR (o, 0, false, 0x33, c_rcx, c_rcx);
+        EmitRR (o, 0, false, 0x0f57, c_xmm0, c_xmm0);                       // xorps
+        EmitRM (o, 0, true, 0x8b, c_rax, c_rdi, 0);
+        EmitRR (o, 0, true, 0x83, 0, c_rdi);                                // add rdi, 8
+        Emit8 (o, sizeof (void *));
+        EmitRR (o, 0, false, 0xff, 2, c_rax);
+    }
+
+    EmitReloadMemory (o);
+    EmitRR (o, 0, true, 0x85, c_rax, c_rax);
+    EmitJumpToLabel (o, c_jne, trap);
+
+    EmitRM (o, 0xf2, false, 0x0f10, c_xmm0, c_rsp, 0);                      // restore _fp0
+}
+
+
+static
+void  EmitBranchTable  (IM3JitTranslation o, pc_t i_immediates)
+{
+    u32 numTargets = * (u32 *) (i_immediates + 1);
+    pc_t * targets = (pc_t *) (i_immediates + 2);
+
+    EmitRM (o, 0, false, 0x8b, c_rax, c_sp, SlotImmediate (i_immediates));
+    EmitMovImm64 (o, c_rcx, numTargets);
+    EmitRR (o, 0, false, 0x3b, c_rax, c_rcx);
+    EmitRR (o, 0, false, 0x0f47, c_rax, c_rcx);                             // cmova: the last target is the default
+
+    // the table holds the targets relative to itself
+    u32 table = NewLabel (o);
+
+    EmitOpcode (o, 0, true, 0x8d, c_rcx, 0, 0);                             // lea rcx, [rip + table]
+    Emit8 (o, 0x0d);
+    AddFixup (o, o->size + 4, table, NULL);
+
+    Emit8 (o, 0x48); Emit8 (o, 0x63); Emit8 (o, 0x04); Emit8 (o, 0x81);     // movsxd rax, [rcx + rax * 4]
+    EmitRR (o, 0, true, 0x03, c_rax, c_rcx);
+    EmitRR (o, 0, false, 0xff, 4, c_rax);                                   // jmp rax
+
+    BindLabel (o, table);
+    u32 base = o->size;
+
+    for (u32 i = 0; i <= numTargets; ++i)
+    {
+        AddFixup (o, base, 0, targets [i]);
+
+        if (not IsTranslated (o, targets [i]) and d_reserve (pending, o->numPending))
+            o->pending [o->numPending++] = targets [i];
+    }
+}
+
+
+// translates a straight run of ops, up to one that doesn't fall through
+static
+void  TranslateRun  (IM3JitTranslation o, pc_t i_pc)
+{
+    pc_t pc = i_pc;
+
+    while (pc and not o->failed)
+    {
+        if (IsTranslated (o, pc))
+        {
+            EmitJumpToPC (o, c_jmp, pc);
+            break;
+        }
+
+        AddSite (o, pc);
+
+        const M3JitOp * op = FindOp (o->jit, * pc);
+
+        if (not op)
+        {
+            EmitBridge (o, pc);
+            break;
+        }
+
+        pc_t immediates = pc + 1;
+        i32 operand1, operand2;
+
+        switch (op->kind)
+        {
+            case c_m3JitAlu:
+            case c_m3JitAluSetSlot:
+            {
+                u32 numOperands = GetOperands (op->form, immediates, & operand1, & operand2);
+
+                if (op->type == c_m3Type_f32 or op->type == c_m3Type_f64)
+                    EmitFloatOp (o, op, operand1, operand2);
+                else
+                    EmitIntegerOp (o, op, pc, operand1, operand2);
+
+                if (op->kind == c_m3JitAluSetSlot)
+                    EmitSetSlot (o, op->type, SlotImmediate (immediates + numOperands++));
+
+                pc = immediates + numOperands;
+                break;
+            }
+
+            case c_m3JitDivideByConstant:
+            {
+                u32 numOperands = GetOperands (op->form, immediates, & operand1, & operand2);
+                pc_t constants = immediates + numOperands;
+
+                i64 magic, divisor;
+                if (IsWide (op->type))
+                {
+                    memcpy (& magic, constants++, sizeof (magic));
+                    memcpy (& divisor, constants++, sizeof (divisor));
+                }
+                else
+                {
+                    magic = * (i32 *) constants++;
+                    divisor = * (i32 *) constants++;
+                }
+
+                u32 shift = * (u32 *) constants++;
+
+                EmitDivideByConstant (o, op, operand1, magic, divisor, shift);
+
+                pc = constants;
+                break;
+            }
+
+            case c_m3JitBranchIf:
+            case c_m3JitIf:
+            case c_m3JitContinueLoopIf:
+            {
+                u32 numOperands = GetOperands (op->form, immediates, & operand1, & operand2);
+                pc_t target = * (pc_t *) (immediates + numOperands);
+
+                u8 condition = EmitCondition (o, op, operand1, operand2);
+
+                if (op->kind == c_m3JitContinueLoopIf)
+                {
+                    M3JitLoop * loop = FindLoop (o, target);
+
+                    if (loop)
+                    {
+                        EmitJumpToLabel (o, condition, loop->iterate);
+                        NoteBackEdge (o, immediates + numOperands);
+                    }
+                    else
+                        o->failed = true;
+                }
+                else if (op->kind == c_m3JitIf)
+                    EmitJumpToPC (o, condition ^ 1, target);
+                else
+                    EmitJumpToPC (o, condition, target);
+
+                pc = immediates + numOperands + 1;
+                break;
+            }
+
+            case c_m3JitLoad:
+            case c_m3JitLoadSetSlot:
+            {
+                u32 n = (op->form == c_m3JitForm_s);
+                i32 address = n ? SlotImmediate (immediates) : c_inRegister;
+
+                EmitLoad (o, op, pc, address, * (u32 *) (immediates + n++));
+
+                if (op->kind == c_m3JitLoadSetSlot)
+                    EmitSetSlot (o, op->type, SlotImmediate (immediates + n++));
+
+                pc = immediates + n;
+                break;
+            }
+
+            case c_m3JitStore:
+            {
+                i32 value = c_inRegister, address = c_inRegister;
+                u32 n = 0;
+
+                if (op->form == c_m3JitForm_rs)
+                    address = SlotImmediate (immediates + n++);
+                else if (op->form == c_m3JitForm_sr)
+                    value = SlotImmediate (immediates + n++);
+                else if (op->form == c_m3JitForm_ss)
+                {
+                    value = SlotImmediate (immediates + n++);
+                    address = SlotImmediate (immediates + n++);
+                }
+
+                EmitStore (o, op, pc, value, address, * (u32 *) (immediates + n++));
+
+                pc = immediates + n;
+                break;
+            }
+
+            case c_m3JitSetRegister:
+            {
+                i32 slot = SlotImmediate (immediates);
+
+                if (op->type == c_m3Type_f32)
+                    EmitRM (o, 0xf3, false, 0x0f5a, c_xmm0, c_sp, slot);           // cvtss2sd
+                else if (op->type == c_m3Type_f64)
+                    EmitRM (o, 0xf2, false, 0x0f10, c_xmm0, c_sp, slot);
+                else
+                    EmitRM (o, 0, IsWide (op->type), 0x8b, c_r0, c_sp, slot);
+
+                pc = immediates + 1;
+                break;
+            }
+
+            case c_m3JitSetSlot:
+                EmitSetSlot (o, op->type, SlotImmediate (immediates));
+                pc = immediates + 1;
+                break;
+
+            case c_m3JitPreserveSetSlot:
+                EmitCopySlot (o, IsWide (op->type), SlotImmediate (immediates + 1), SlotImmediate (immediates));
+                EmitSetSlot (o, op->type, SlotImmediate (immediates));
+                pc = immediates + 2;
+                break;
+
+            case c_m3JitCopySlot:
+                EmitCopySlot (o, IsWide (op->type), SlotImmediate (immediates), SlotImmediate (immediates + 1));
+                pc = immediates + 2;
+                break;
+
+            case c_m3JitPreserveCopySlot:
+                EmitCopySlot (o, IsWide (op->type), SlotImmediate (immediates + 2), SlotImmediate (immediates));
+                EmitCopySlot (o, IsWide (op->type), SlotImmediate (immediates), SlotImmediate (immediates + 1));
+                pc = immediates + 3;
+                break;
+
+            case c_m3JitConst:
+            {
+                i32 slot = SlotImmediate (immediates + 1);
+
+                if (IsWide (op->type))
+                {
+                    EmitMovImm64 (o, c_rax, * (u64 *) immediates);
+                    EmitRM (o, 0, true, 0x89, c_rax, c_sp, slot);
+                }
+                else
+                {
+                    EmitRM (o, 0, false, 0xc7, 0, c_sp, slot);
+                    Emit32 (o, * (u32 *) immediates);
+                }
+
+                pc = immediates + 2;
+                break;
+            }
+
+            case c_m3JitGetGlobal:
+                EmitMovImm64 (o, c_rax, (u64) * (void **) immediates);
+                EmitRM (o, 0, IsWide (op->type), 0x8b, c_rax, c_rax, 0);
+                EmitRM (o, 0, IsWide (op->type), 0x89, c_rax, c_sp, SlotImmediate (immediates + 1));
+                pc = immediates + 2;
+                break;
+
+            case c_m3JitSetGlobal:
+            {
+                EmitMovImm64 (o, c_rax, (u64) * (void **) immediates);
+
+                if (op->form == c_m3JitForm_s)
+                {
+                    EmitRM (o, 0, IsWide (op->type), 0x8b, c_rcx, c_sp, SlotImmediate (immediates + 1));
+                    EmitRM (o, 0, IsWide (op->type), 0x89, c_rcx, c_rax, 0);
+                }
+                else if (op->type == c_m3Type_f32)
+                {
+                    EmitRR (o, 0xf2, false, 0x0f5a, c_xmm1, c_xmm0);
+                    EmitStoreFloat (o, op->type, c_xmm1, c_rax, 0);
+                }
+                else if (op->type == c_m3Type_f64)
+                    EmitStoreFloat (o, op->type, c_xmm0, c_rax, 0);
+                else
+                    EmitRM (o, 0, IsWide (op->type), 0x89, c_r0, c_rax, 0);
+
+                pc = immediates + 1 + (op->form == c_m3JitForm_s);
+                break;
+            }
+
+            case c_m3JitSelect:
+            case c_m3JitSelectSetSlot:
+            {
+                i32 condition = c_inRegister, operand1 = c_inRegister, operand2 = c_inRegister;
+                u32 n = 0;
+
+                if (op->form != c_m3JitForm_rss)    condition = SlotImmediate (immediates + n++);
+                if (op->form != c_m3JitForm_srs)    operand2 = SlotImmediate (immediates + n++);
+                if (op->form != c_m3JitForm_ssr)    operand1 = SlotImmediate (immediates + n++);
+
+                bool wide = IsWide (op->type);
+
+                EmitLoadInt (o, false, c_rdx, condition);
+                EmitLoadInt (o, wide, c_rax, operand1);
+                EmitLoadInt (o, wide, c_rcx, operand2);
+                EmitRR (o, 0, false, 0x85, c_rdx, c_rdx);
+                EmitRR (o, 0, wide, 0x0f44, c_rax, c_rcx);                      // cmove
+                EmitRR (o, 0, true, 0x8b, c_r0, c_rax);
+
+                if (op->kind == c_m3JitSelectSetSlot)
+                    EmitSetSlot (o, op->type, SlotImmediate (immediates + n++));
+
+                pc = immediates + n;
+                break;
+            }
+
+            case c_m3JitMemSize:
+                EmitRM (o, 0, false, 0x8b, c_r0, c_runtime, offsetof (M3Runtime, memory) + offsetof (M3Memory, numPages));
+                pc = immediates;
+                break;
+
+            case c_m3JitUseGas:
+            {
+                // charged only when there's enough left; otherwise op_UseGas charges it & traps
+                u32 gas = * (u32 *) immediates;
+                i32 gasLeft = offsetof (M3Runtime, gasLeft);
+
+                EmitRM (o, 0, true, 0x8b, c_rax, c_runtime, gasLeft);
+                EmitMovImm64 (o, c_rcx, gas);
+                EmitRR (o, 0, true, 0x2b, c_rax, c_rcx);
+                EmitJumpToLabel (o, c_js, AddStub (o, pc, false));
+                EmitRM (o, 0, true, 0x89, c_rax, c_runtime, gasLeft);
+
+                pc = immediates + 1;
+                break;
+            }
+
+            case c_m3JitBranch:
+            {
+                pc_t target = * (pc_t *) immediates;
+
+                // an unconditional branch just moves the run along, unless the target is already translated
+                if (IsTranslated (o, target))
+                {
+                    EmitJumpToPC (o, c_jmp, target);
+                    pc = NULL;
+                }
+                else pc = target;
+                break;
+            }
+
+            case c_m3JitBranchTable:
+                EmitBranchTable (o, immediates);
+                pc = NULL;
+                break;
+
+            case c_m3JitLoop:
+            {
+                // natively the body is jumped back to, after polling for an interrupt. the interpreter's
+                // registers are dead going into a loop
+                if (d_reserve (loops, o->numLoops))
+                {
+                    M3JitLoop * loop = & o->loops [o->numLoops++];
+
+                    loop->id = immediates;
+                    loop->body = NewLabel (o);
+                    loop->iterate = NewLabel (o);
+
+                    BindLabel (o, loop->body);
+                }
+
+                pc = immediates;
+                break;
+            }
+
+            case c_m3JitContinueLoop:
+            {
+                M3JitLoop * loop = FindLoop (o, * (pc_t *) immediates);
+
+                if (loop)
+                {
+                    EmitJumpToLabel (o, c_jmp, loop->iterate);
+                    NoteBackEdge (o, immediates);
+                }
+                else
+                    o->failed = true;
+
+                pc = NULL;
+                break;
+            }
+
+            case c_m3JitReturn:
+                EmitRR (o, 0, false, 0x33, c_rax, c_rax);
+                EmitJumpToLabel (o, c_jmp, o->exit);
+                pc = NULL;
+                break;
+
+            case c_m3JitCall:
+            case c_m3JitCompile:
+                EmitCall (o, op, pc);
+                pc = immediates + 2;
+                break;
+
+            case c_m3JitCallIndirect:
+                EmitCall (o, op, pc);
+                pc = immediates + 4 + d_m3CodeLines (M3CallCache);
+                break;
+
+            default:
+                EmitBridge (o, pc);
+                pc = NULL;
+        }
+    }
+}
+
+
+static
+void  EmitPrologue  (IM3JitTranslation o)
+{
+    Emit8 (o, 0x55);                                                        // push rbp
+    Emit8 (o, 0x53);                                                        // push rbx
+    Emit8 (o, 0x41); Emit8 (o, 0x54);                                       // push r12
+    Emit8 (o, 0x41); Emit8 (o, 0x55);                                       // push r13
+    Emit8 (o, 0x41); Emit8 (o, 0x56);                                       // push r14
+    EmitRR (o, 0, true, 0x83, 5, c_rsp); Emit8 (o, 16);                     // sub rsp, 16; keeps the calls aligned
+
+    EmitRR (o, 0, true, 0x8b, c_sp, c_rsi);
+    EmitRR (o, 0, true, 0x8b, c_mem, c_rdx);
+    EmitRM (o, 0, true, 0x8b, c_runtime, c_rdx, offsetof (M3MemoryHeader, runtime));
+    EmitRR (o, 0, false, 0x33, c_r0, c_r0);
+    EmitRR (o, 0, false, 0x0f57, c_xmm0, c_xmm0);
+}
+
+
+// rather than op_JitEntry copying function->constants into the frame, they're stored as immediates
+static
+void  EmitStoreConstants  (IM3JitTranslation o)
+{
+    IM3Function function = o->function;
+    i32 constants = GetConstantsOffset (function);
+
+    for (u32 i = 0; i + sizeof (u32) <= function->numConstantBytes; i += sizeof (u32))
+    {
+        u32 value;
+        memcpy (& value, (u8 *) function->constants + i, sizeof (value));
+
+        EmitRM (o, 0, false, 0xc7, 0, c_sp, constants + i);
+        Emit32 (o, value);
+    }
+}
+
+
+static
+void  EmitEpilogue  (IM3JitTranslation o)
+{
+    // the interpreter returned: a loop id continues the loop, anything else is the function's result
+    BindLabel (o, o->dispatch);
+    EmitReloadMemory (o);
+
+    for (u32 i = 0; i < o->numLoops; ++i)
+    {
+        EmitMovImm64 (o, c_rcx, (u64) o->loops [i].id);
+        EmitRR (o, 0, true, 0x3b, c_rax, c_rcx);
+        EmitJumpToLabel (o, c_je, o->loops [i].iterate);
+    }
+
+    BindLabel (o, o->exit);
+    EmitRR (o, 0, true, 0x83, 0, c_rsp); Emit8 (o, 16);                     // add rsp, 16
+    Emit8 (o, 0x41); Emit8 (o, 0x5e);                                       // pop r14
+    Emit8 (o, 0x41); Emit8 (o, 0x5d);
+    Emit8 (o, 0x41); Emit8 (o, 0x5c);
+    Emit8 (o, 0x5b);
+    Emit8 (o, 0x5d);
+    Emit8 (o, 0xc3);
+
+    // a loop iterates again unless the runtime was interrupted; see op_Loop
+    for (u32 i = 0; i < o->numLoops; ++i)
+    {
+        BindLabel (o, o->loops [i].iterate);
+        EmitRM (o, 0, false, 0x83, 7, c_runtime, offsetof (M3Runtime, interrupted));  Emit8 (o, 0);
+        EmitJumpToLabel (o, c_jne, o->interrupt);
+        EmitJumpToLabel (o, c_jmp, o->loops [i].body);
+    }
+
+    BindLabel (o, o->interrupt);
+    EmitRM (o, 0, false, 0xc7, 0, c_runtime, offsetof (M3Runtime, interrupted));  Emit32 (o, 0);
+    EmitMovImm64 (o, c_rax, (u64) m3Err_trapInterrupted);
+    EmitJumpToLabel (o, c_jmp, o->exit);
+
+    // stubs can add no further stubs
+    for (u32 i = 0; i < o->numStubs; ++i)
+    {
+        M3JitStub stub = o->stubs [i];
+        BindLabel (o, stub.label);
+
+# if d_m3RecordBacktraces
+        if (stub.isCallTrap)
+        {
+            EmitRM (o, 0, true, 0x89, c_rax, c_rsp, 8);
+            EmitRR (o, 0, true, 0x8b, c_rdi, c_runtime);
+            EmitMovImm64 (o, c_rsi, (u64) stub.pc);
+            EmitCallC (o, (const void *) PushBacktraceFrame);
+            EmitRM (o, 0, true, 0x8b, c_rax, c_rsp, 8);
+            EmitJumpToLabel (o, c_jmp, o->exit);
+        }
+        else
+# endif
+        EmitBridge (o, stub.pc);
+    }
+}
+
+
+static
+void  ResolveFixups  (IM3JitTranslation o)
+{
+    for (u32 i = 0; i < o->numFixups and not o->failed; ++i)
+    {
+        M3JitFixup * fixup = & o->fixups [i];
+        u32 target = c_noLabel;
+
+        if (fixup->pc)
+        {
+            M3JitSite * site = FindSite (o, fixup->pc);
+            if (site->pc)
+                target = site->offset;
+        }
+        else target = o->labels [fixup->label];
+
+        if (target != c_noLabel)
+        {
+            i32 relative = (i32) target - (i32) fixup->base;
+            memcpy (o->code + fixup->at, & relative, sizeof (relative));
+        }
+        else o->failed = true;
+    }
+}
+
+
+//----- CODE ARENA --------------------------------------------------------------------------------------------------------
+
+static
+u8 *  AllocateCode  (IM3Jit io_jit, u32 i_size)
+{
+    size_t size = (i_size + 15) & ~15;
+
+    if (not io_jit->chunks or io_jit->chunkUsed + size > io_jit->chunks->size)
+    {
+        size_t pageSize = (size_t) sysconf (_SC_PAGESIZE);
+        size_t chunkSize = M3_MAX (c_jitChunkSize, size + sizeof (M3JitChunk) + 16);
+        chunkSize = (chunkSize + pageSize - 1) & ~(pageSize - 1);
+
+        M3JitChunk * chunk = (M3JitChunk *) mmap (NULL, chunkSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (chunk == MAP_FAILED)
+            return NULL;
+
+        chunk->next = io_jit->chunks;
+        chunk->size = chunkSize;
+
+        mprotect (chunk, chunkSize, PROT_READ | PROT_EXEC);
+
+        io_jit->chunks = chunk;
+        io_jit->chunkUsed = (sizeof (M3JitChunk) + 15) & ~15;
+    }
+
+    u8 * code = (u8 *) io_jit->chunks + io_jit->chunkUsed;
+    io_jit->chunkUsed += size;
+
+    return code;
+}
+
+
+// the pages are only writable while the code is copied in
+static
+bool  WriteCode  (u8 * o_code, const u8 * i_code, u32 i_size)
+{
+    uintptr_t pageSize = (uintptr_t) sysconf (_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t) o_code & ~(pageSize - 1);
+    uintptr_t end = ((uintptr_t) o_code + i_size + pageSize - 1) & ~(pageSize - 1);
+
+    if (mprotect ((void *) start, end - start, PROT_READ | PROT_WRITE))
+        return false;
+
+    memcpy (o_code, i_code, i_size);
+
+    return mprotect ((void *) start, end - start, PROT_READ | PROT_EXEC) == 0;
+}
+
+
+//----- TRANSLATION -------------------------------------------------------------------------------------------------------
+
+void  TranslateFunction  (IM3Function io_function)
+{
+    IM3Module module = io_function->module;
+    IM3Jit jit = module->runtime->jit;
+    pc_t compiled = io_function->compiled;
+
+    // template code is shared by runtimes that may not be translating
+    if (not jit or module->isTemplate or module->templateModule or io_function->native)
+        return;
+
+    if (not compiled or * compiled != (void *) c_m3JitOps.entry)
+        return;
+
+    // counted code is translated once it's recompiled; see TierUpFunction
+    if (compiled [2] == (void *) c_m3JitOps.countHotness)
+        return;
+
+    M3JitTranslation translation = { 0 };
+    IM3JitTranslation o = & translation;
+
+    o->jit = jit;
+    o->function = io_function;
+    o->exit = NewLabel (o);
+    o->dispatch = NewLabel (o);
+    o->interrupt = NewLabel (o);
+
+    EmitPrologue (o);
+    EmitStoreConstants (o);
+
+    if (d_reserve (pending, 0))
+        o->pending [o->numPending++] = compiled + 2;
+
+    while (o->numPending and not o->failed)
+    {
+        pc_t pc = o->pending [--o->numPending];
+
+        if (not IsTranslated (o, pc))
+            TranslateRun (o, pc);
+    }
+
+    EmitEpilogue (o);
+    ResolveFixups (o);
+
+    if (not o->failed)
+    {
+        u8 * code = AllocateCode (jit, o->size);
+
+        if (code and WriteCode (code, o->code, o->size))
+        {
+            io_function->native = code;                                     m3log (runtime, "translated %s: %u bytes",
+                                                                                   m3_GetFunctionName (io_function), o->size);
+            PatchTranslatedLoops (o);
+            * (void **) compiled = (void *) c_m3JitOps.jitEntry;
+        }
+    }
+
+    m3_Free (o->code);
+    m3_Free (o->sites);
+    m3_Free (o->pending);
+    m3_Free (o->fixups);
+    m3_Free (o->labels);
+    m3_Free (o->loops);
+    m3_Free (o->backEdges);
+    m3_Free (o->stubs);
+}
+
+
+void  TranslateModule  (IM3Module io_module)
+{
+    if (not io_module->runtime->jit)
+        return;
+
+    for (u32 i = 0; i < io_module->numFunctions; ++i)
+        TranslateFunction (& io_module->functions [i]);
+}
+
+
+static
+void *  v_TranslateModule  (IM3Module i_module, void * i_info)
+{
+    TranslateModule (i_module);
+    return NULL;
+}
+
+
+M3Result  m3_EnableJit  (IM3Runtime io_runtime)
+{
+    M3Result result = m3Err_none;
+
+    if (not io_runtime->jit)
+    {
+        IM3Jit jit = m3_AllocStruct (M3Jit);
+        _throwifnull (jit);
+
+        for (u32 i = 0; i < c_m3JitOps.numOps; ++i)
+        {
+            const M3JitOp * op = & c_m3JitOps.ops [i];
+            u32 h = HashPointer ((const void *) op->op, c_jitOpsHashSize - 1);
+
+            while (jit->ops [h])
+                h = (h + 1) & (c_jitOpsHashSize - 1);
+
+            jit->ops [h] = op;
+        }
+
+        io_runtime->jit = jit;
+
+        ForEachModule (io_runtime, v_TranslateModule, NULL);
+    }
+
+    _catch: return result;
+}
+
+
+M3Result  m3_EnableTiering  (IM3Runtime io_runtime, uint32_t i_threshold)
+{
+    // set first, so that m3_EnableJit leaves the functions that are compiled with counters to TierUpFunction
+    io_runtime->tierThreshold = M3_MAX (1, i_threshold);
+
+    return m3_EnableJit (io_runtime);
+}
+
+
+void  FreeJit  (IM3Runtime io_runtime)
+{
+    IM3Jit jit = io_runtime->jit;
+
+    if (jit)
+    {
+        while (jit->chunks)
+        {
+            M3JitChunk * chunk = jit->chunks;
+            jit->chunks = chunk->next;
+
+            munmap (chunk, chunk->size);
+        }
+
+        m3_Free (io_runtime->jit);
+    }
+}
+
+#else // d_m3HasJit
+
+M3Result  m3_EnableJit  (IM3Runtime io_runtime)
+{
+    return "the jit isn't supported by this build";
+}
+
+
+M3Result  m3_EnableTiering  (IM3Runtime io_runtime, uint32_t i_threshold)
+{
+    return "the jit isn't supported by this build";
+}
+
+#endif // d_m3HasJit
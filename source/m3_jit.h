@@ -0,0 +1,122 @@
+//
+//  m3_jit.h
+//
+//  Baseline x86-64 translation of compiled functions
+//
+
+#ifndef m3_jit_h
+#define m3_jit_h
+
+#include "m3_env.h"
+
+d_m3BeginExternC
+
+#if d_m3HasJit
+
+// what the translator needs to know about an operation: how its operands & immediates are laid out (the form) and
+// what it does with them. m3_compile.c describes the operations it emits in c_m3JitOps; any other op is run by
+// handing the rest of the call to the interpreter
+enum
+{
+    c_m3JitAlu,                 // arg: c_m3JitOp_*; result in the register
+    c_m3JitAluSetSlot,          // also stored to the slot that trails the operands
+    c_m3JitDivideByConstant,    // arg: c_m3JitOp_DivS or RemS; the magic number, divisor & shift trail the operand
+    c_m3JitBranchIf,            // arg: the condition (c_m3JitOp_ compare, or c_m3JitOp_NonZero); target trails
+    c_m3JitIf,                  // jumps when the condition is false (BranchIfPrologue too)
+    c_m3JitContinueLoopIf,
+    c_m3JitLoad,                // arg: c_m3JitAccess_*; type: the type loaded into the register
+    c_m3JitLoadSetSlot,
+    c_m3JitStore,               // type: the type of the value stored
+    c_m3JitSetRegister,
+    c_m3JitSetSlot,
+    c_m3JitPreserveSetSlot,
+    c_m3JitCopySlot,
+    c_m3JitPreserveCopySlot,
+    c_m3JitConst,
+    c_m3JitGetGlobal,
+    c_m3JitSetGlobal,           // form r or s
+    c_m3JitSelect,              // form: which of condition, operand 2 & operand 1 are in the register
+    c_m3JitSelectSetSlot,
+    c_m3JitMemSize,
+    c_m3JitUseGas,
+    c_m3JitBranch,
+    c_m3JitBranchTable,
+    c_m3JitLoop,
+    c_m3JitContinueLoop,
+    c_m3JitReturn,
+    c_m3JitCall,
+    c_m3JitCompile,
+    c_m3JitCallIndirect
+};
+
+enum
+{
+    c_m3JitForm_none,
+    c_m3JitForm_r,
+    c_m3JitForm_s,
+    c_m3JitForm_rs,             // operand 1 in a slot, operand 2 (the top of the stack) in the register
+    c_m3JitForm_sr,
+    c_m3JitForm_ss,
+    c_m3JitForm_rr,             // float stores: the address in _r0, the value in _fp0
+    c_m3JitForm_rss,            // selects: condition, operand 2, operand 1
+    c_m3JitForm_srs,
+    c_m3JitForm_ssr,
+    c_m3JitForm_sss
+};
+
+enum
+{
+    c_m3JitOp_Add, c_m3JitOp_Sub, c_m3JitOp_Mul, c_m3JitOp_And, c_m3JitOp_Or, c_m3JitOp_Xor,
+    c_m3JitOp_Shl, c_m3JitOp_ShrS, c_m3JitOp_ShrU, c_m3JitOp_Rotl, c_m3JitOp_Rotr,
+    c_m3JitOp_DivS, c_m3JitOp_DivU, c_m3JitOp_RemS, c_m3JitOp_RemU, c_m3JitOp_Div,
+
+    c_m3JitOp_Eq, c_m3JitOp_Ne, c_m3JitOp_LtS, c_m3JitOp_LtU, c_m3JitOp_GtS, c_m3JitOp_GtU,
+    c_m3JitOp_LeS, c_m3JitOp_LeU, c_m3JitOp_GeS, c_m3JitOp_GeU, c_m3JitOp_Eqz, c_m3JitOp_NonZero,
+
+    c_m3JitOp_Extend8, c_m3JitOp_Extend16, c_m3JitOp_Extend32, c_m3JitOp_ExtendU32, c_m3JitOp_Wrap
+};
+
+enum
+{
+    c_m3JitAccess_i8, c_m3JitAccess_u8, c_m3JitAccess_i16, c_m3JitAccess_u16,
+    c_m3JitAccess_i32, c_m3JitAccess_u32, c_m3JitAccess_64, c_m3JitAccess_f32, c_m3JitAccess_f64
+};
+
+typedef struct M3JitOp
+{
+    IM3Operation            op;
+    u8                      kind;
+    u8                      form;
+    u8                      type;           // c_m3Type_*: the operand type
+    u8                      arg;
+}
+M3JitOp;
+
+typedef struct M3JitOps
+{
+    IM3Operation            entry;          // op_Entry, which op_JitEntry replaces in a translated function
+    IM3Operation            jitEntry;
+    IM3Operation            call;           // what op_Compile rewrites itself into
+    IM3Operation            countHotness;   // heads the body of a function that's waiting to be tiered up
+    IM3Operation            jitLoop;        // returns a translated loop to the native code; see PatchTranslatedLoops
+
+    const M3JitOp *         ops;
+    u32                     numOps;
+}
+M3JitOps;
+
+extern const M3JitOps       c_m3JitOps;
+
+typedef struct M3Jit *      IM3Jit;
+
+// these keep the function interpreted when they can't translate it
+void        TranslateFunction           (IM3Function io_function);
+void        TranslateModule             (IM3Module io_module);
+
+void        FreeJit                     (IM3Runtime io_runtime);
+
+#endif // d_m3HasJit
+
+d_m3EndExternC
+
+#endif // m3_jit_h
@@ -183,6 +183,58 @@ u64 rotr64(u64 n, unsigned c) {
 
 #endif
 
+/*
+ * Signed division by a constant, as a multiply-high by a magic number
+ * (see Hacker's Delight, 10-1). The compiler finds the magic number & the shift
+ * for divisors other than 0, 1 & -1, so these can't trap.
+ */
+
+static inline
+i64 mulhs64(i64 a, i64 b) {
+#if defined(__SIZEOF_INT128__)
+    return (i64)(((__int128)a * b) >> 64);
+#else
+    u64 ua = (u64)a, ub = (u64)b;
+    u64 lo_lo = (ua & 0xFFFFFFFF) * (ub & 0xFFFFFFFF);
+    u64 hi_lo = (ua >> 32) * (ub & 0xFFFFFFFF);
+    u64 lo_hi = (ua & 0xFFFFFFFF) * (ub >> 32);
+    u64 hi_hi = (ua >> 32) * (ub >> 32);
+    u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    u64 hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    if (a < 0) hi -= ub;
+    if (b < 0) hi -= ua;
+    return (i64)hi;
+#endif
+}
+
+static inline
+i32 div_const_i32(i32 n, i32 magic, i32 d, u32 shift) {
+    u32 q = (u32)(i32)(((i64)n * magic) >> 32);
+    if (d > 0 and magic < 0) q += (u32)n;
+    else if (d < 0 and magic > 0) q -= (u32)n;
+    q = (u32)((i32)q >> shift);
+    return (i32)(q + (q >> 31));
+}
+
+static inline
+i64 div_const_i64(i64 n, i64 magic, i64 d, u32 shift) {
+    u64 q = (u64)mulhs64(n, magic);
+    if (d > 0 and magic < 0) q += (u64)n;
+    else if (d < 0 and magic > 0) q -= (u64)n;
+    q = (u64)((i64)q >> shift);
+    return (i64)(q + (q >> 63));
+}
+
+static inline
+i32 rem_const_i32(i32 n, i32 magic, i32 d, u32 shift) {
+    return (i32)((u32)n - (u32)div_const_i32(n, magic, d, shift) * (u32)d);
+}
+
+static inline
+i64 rem_const_i64(i64 n, i64 magic, i64 d, u32 shift) {
+    return (i64)((u64)n - (u64)div_const_i64(n, magic, d, shift) * (u64)d);
+}
+
 /*
  * Trunc
  */
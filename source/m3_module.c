@@ -26,12 +26,24 @@ void  m3_FreeModule  (IM3Module i_module)
         m3log (module, "freeing module: %s (funcs: %d; segments: %d)",
                i_module->name, i_module->numFunctions, i_module->numDataSegments);
 
+        if (i_module->templateModule)
+        {
+            // everything else is borrowed from the template
+            m3_Free (i_module->functions);
+            m3_Free (i_module->globals);
+            m3_Free (i_module->droppedDataSegments);
+            m3_Free (i_module->table0);
+            m3_Free (i_module);
+            return;
+        }
+
         Module_FreeFunctions (i_module);
 
         m3_Free (i_module->functions);
         //m3_Free (i_module->imports);
         m3_Free (i_module->funcTypes);
         m3_Free (i_module->dataSegments);
+        m3_Free (i_module->droppedDataSegments);
         m3_Free (i_module->table0);
 
         for (u32 i = 0; i < i_module->numGlobals; ++i)
@@ -32,6 +32,9 @@ _   (ReadLEB_u32 (& o_memory->initPages, io_bytes, i_end));
     if (flag & (1u << 0))
 _       (ReadLEB_u32 (& o_memory->maxPages, io_bytes, i_end));
 
+    o_memory->shared = (flag & (1u << 1));
+    _throwif ("shared memory must have maximum", o_memory->shared and not (flag & (1u << 0)));
+
     o_memory->pageSize = 0;
     if (flag & (1u << 3)) {
         u32 logPageSize;
@@ -310,18 +313,20 @@ M3Result  Parse_InitExpr  (M3Module * io_module, bytes_t * io_bytes, cbytes_t i_
 
     // this doesn't generate code pages. just walks the wasm bytecode to find the end
 
-#if defined(d_m3PreferStaticAlloc)
-    static M3Compilation compilation;
-#else
-    M3Compilation compilation;
-#endif
-    compilation = (M3Compilation){ .runtime = NULL, .module = io_module, .wasm = * io_bytes, .wasmEnd = i_end };
+    IM3Compilation o = Environment_AcquireCompilation (io_module->environment);
+    _throwifnull (o);
 
-    result = CompileBlockStatements (& compilation);
+    o->module = io_module;
+    o->wasm = * io_bytes;
+    o->wasmEnd = i_end;
 
-    * io_bytes = compilation.wasm;
+    result = CompileBlockStatements (o);
 
-    return result;
+    * io_bytes = o->wasm;
+
+    Environment_ReleaseCompilation (io_module->environment, o);
+
+    _catch: return result;
 }
 
 
@@ -426,13 +431,22 @@ _   (ReadLEB_u32 (& numDataSegments, & i_bytes, i_end));
     {
         M3DataSegment * segment = & io_module->dataSegments [i];
 
-_       (ReadLEB_u32 (& segment->memoryRegion, & i_bytes, i_end));
+        // 0: active, memory 0; 1: passive (copied by memory.init); 2: active, explicit memory index
+        u32 kind;
+_       (ReadLEB_u32 (& kind, & i_bytes, i_end));
+        _throwif ("unknown data segment kind", kind > 2);
 
-        segment->initExpr = i_bytes;
-_       (Parse_InitExpr (io_module, & i_bytes, i_end));
-        segment->initExprSize = (u32) (i_bytes - segment->initExpr);
+        if (kind == 2)
+_           (ReadLEB_u32 (& segment->memoryRegion, & i_bytes, i_end));
 
-        _throwif (m3Err_wasmMissingInitExpr, segment->initExprSize <= 1);
+        if (kind != 1)
+        {
+            segment->initExpr = i_bytes;
+_           (Parse_InitExpr (io_module, & i_bytes, i_end));
+            segment->initExprSize = (u32) (i_bytes - segment->initExpr);
+
+            _throwif (m3Err_wasmMissingInitExpr, segment->initExprSize <= 1);
+        }
 
 _       (ReadLEB_u32 (& segment->size, & i_bytes, i_end));
         segment->data = i_bytes;                                                    m3log (parse, "    segment [%u]  memory: %u;  expr-size: %d;  size: %d",
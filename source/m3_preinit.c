@@ -0,0 +1,504 @@
+//
+//  m3_preinit.c
+//
+//  Pre-initialization: write out a module as its start & init functions left it
+//
+
+#include "m3_env.h"
+#include "m3_compile.h"
+#include "m3_exception.h"
+
+// the original module is copied section by section, except for:
+//
+//  memory:     the initial size is the current one
+//  global:     every defined global is initialized to its current value
+//  start:      dropped; it has run
+//  data:       the linear memory, as one active segment per run of nonzero bytes. if the module has a DataCount
+//              section, its code may refer to segments by index (memory.init & data.drop), so the original segments
+//              come first, as passive ones: empty once dropped (as active segments are after instantiation),
+//              and unchanged otherwise
+//  datacount:  updated to match
+//
+// tables can't be changed by the code wasm3 runs, so the element section still describes table0.
+
+#define c_m3MaxZeroGap          32          // zero runs shorter than this stay within a segment; a segment header is ~12 bytes
+
+typedef struct M3WasmWriter
+{
+    u8 *                    bytes;
+    size_t                  numBytes;
+    size_t                  capacity;
+}
+M3WasmWriter;
+
+
+typedef struct M3DataRun
+{
+    u32                     offset;
+    u32                     size;
+}
+M3DataRun;
+
+
+static
+M3Result  WriteBytes  (M3WasmWriter * io_writer, const void * i_bytes, size_t i_numBytes)
+{
+    M3Result result = m3Err_none;
+
+    if (io_writer->numBytes + i_numBytes > io_writer->capacity)
+    {
+        size_t capacity = M3_MAX (io_writer->capacity * 2, io_writer->numBytes + i_numBytes + 256);
+
+        u8 * bytes = m3_Realloc ("Wasm Writer", io_writer->bytes, capacity, io_writer->capacity);
+        _throwifnull (bytes);
+
+        io_writer->bytes = bytes;
+        io_writer->capacity = capacity;
+    }
+
+    if (i_numBytes)
+        memcpy (io_writer->bytes + io_writer->numBytes, i_bytes, i_numBytes);
+
+    io_writer->numBytes += i_numBytes;
+
+    _catch: return result;
+}
+
+
+static
+M3Result  WriteByte  (M3WasmWriter * io_writer, u8 i_byte)
+{
+    return WriteBytes (io_writer, & i_byte, 1);
+}
+
+
+static
+M3Result  WriteLEB_u32  (M3WasmWriter * io_writer, u32 i_value)
+{
+    u8 bytes [5];
+    size_t numBytes = 0;
+
+    do
+    {
+        u8 byte = i_value & 0x7f;
+        i_value >>= 7;
+
+        bytes [numBytes++] = byte | (i_value ? 0x80 : 0);
+    }
+    while (i_value);
+
+    return WriteBytes (io_writer, bytes, numBytes);
+}
+
+
+static
+M3Result  WriteLEB_i64  (M3WasmWriter * io_writer, i64 i_value)
+{
+    u8 bytes [10];
+    size_t numBytes = 0;
+
+    while (true)
+    {
+        u8 byte = i_value & 0x7f;
+        i_value >>= 7;                                  // arithmetic
+
+        bool done = (i_value == 0 and not (byte & 0x40)) or (i_value == -1 and (byte & 0x40));
+
+        bytes [numBytes++] = byte | (done ? 0 : 0x80);
+
+        if (done)
+            break;
+    }
+
+    return WriteBytes (io_writer, bytes, numBytes);
+}
+
+
+// little-endian, as wasm stores float constants
+static
+M3Result  WriteFixed  (M3WasmWriter * io_writer, u64 i_value, u32 i_numBytes)
+{
+    u8 bytes [8];
+
+    for (u32 i = 0; i < i_numBytes; ++i)
+        bytes [i] = (u8) (i_value >> (8 * i));
+
+    return WriteBytes (io_writer, bytes, i_numBytes);
+}
+
+
+static
+M3Result  WriteSection  (M3WasmWriter * io_writer, u8 i_sectionId, M3WasmWriter * i_payload)
+{
+    M3Result result = m3Err_none;
+
+    _throwif ("section is too large", i_payload->numBytes > UINT32_MAX);
+
+_   (WriteByte (io_writer, i_sectionId));
+_   (WriteLEB_u32 (io_writer, (u32) i_payload->numBytes));
+_   (WriteBytes (io_writer, i_payload->bytes, i_payload->numBytes));
+
+    _catch: return result;
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------
+
+static
+M3Result  WriteMemory  (M3WasmWriter * io_payload, IM3Module i_module, bytes_t i_bytes, cbytes_t i_end)
+{
+    M3Result result = m3Err_none;
+
+    u32 numMemories, initPages;
+    u8 flags;
+
+_   (ReadLEB_u32 (& numMemories, & i_bytes, i_end));
+_   (ReadLEB_u7 (& flags, & i_bytes, i_end));
+_   (ReadLEB_u32 (& initPages, & i_bytes, i_end));
+
+    _throwif (m3Err_tooManyMemorySections, numMemories != 1);
+
+    // the limits (& page size) that follow are kept
+_   (WriteLEB_u32 (io_payload, 1));
+_   (WriteByte (io_payload, flags));
+_   (WriteLEB_u32 (io_payload, i_module->runtime->memory.numPages));
+_   (WriteBytes (io_payload, i_bytes, i_end - i_bytes));
+
+    _catch: return result;
+}
+
+
+static
+M3Result  WriteGlobals  (M3WasmWriter * io_payload, IM3Module i_module)
+{
+    M3Result result = m3Err_none;
+
+    u32 numDefined = 0;
+
+    for (u32 i = 0; i < i_module->numGlobals; ++i)
+    {
+        if (not i_module->globals [i].imported)
+            ++numDefined;
+    }
+
+_   (WriteLEB_u32 (io_payload, numDefined));
+
+    for (u32 i = 0; i < i_module->numGlobals; ++i)
+    {
+        M3Global * global = & i_module->globals [i];
+
+        if (global->imported)
+            continue;
+
+_       (WriteByte (io_payload, GetWasmValueType (global->type)));
+_       (WriteByte (io_payload, global->isMutable ? 1 : 0));
+
+        switch (global->type)
+        {
+            case c_m3Type_i32:
+_               (WriteByte (io_payload, c_waOp_i32_const));
+_               (WriteLEB_i64 (io_payload, global->i32Value));
+                break;
+
+            case c_m3Type_i64:
+_               (WriteByte (io_payload, c_waOp_i64_const));
+_               (WriteLEB_i64 (io_payload, global->i64Value));
+                break;
+
+#if d_m3HasFloat
+            case c_m3Type_f32:
+            {
+                u32 bits;
+                memcpy (& bits, & global->f32Value, sizeof (bits));
+_               (WriteByte (io_payload, c_waOp_f32_const));
+_               (WriteFixed (io_payload, bits, sizeof (bits)));
+            }
+            break;
+
+            case c_m3Type_f64:
+            {
+                u64 bits;
+                memcpy (& bits, & global->f64Value, sizeof (bits));
+_               (WriteByte (io_payload, c_waOp_f64_const));
+_               (WriteFixed (io_payload, bits, sizeof (bits)));
+            }
+            break;
+#endif
+
+#if d_m3HasSIMD
+            case c_m3Type_v128:
+_               (WriteByte (io_payload, c_waOp_simd));
+_               (WriteLEB_u32 (io_payload, c_waOp_v128_const));
+_               (WriteBytes (io_payload, & global->v128Value, sizeof (global->v128Value)));
+                break;
+#endif
+
+            default: _throw ("unsupported global type");
+        }
+
+_       (WriteByte (io_payload, c_waOp_end));
+    }
+
+    _catch: return result;
+}
+
+
+static
+M3Result  FindDataRuns  (M3DataRun ** o_runs, u32 * o_numRuns, const u8 * i_data, size_t i_length)
+{
+    M3Result result = m3Err_none;
+
+    M3DataRun * runs = NULL;
+    u32 numRuns = 0, capacity = 0;
+
+    size_t offset = 0;
+
+    while (offset < i_length)
+    {
+        // skip zero pages wholesale
+        if (offset % 4096 == 0 and offset + 4096 <= i_length and i_data [offset] == 0 and
+            memcmp (i_data + offset, i_data + offset + 1, 4095) == 0)
+        {
+            offset += 4096;
+            continue;
+        }
+
+        if (i_data [offset] == 0)
+        {
+            ++offset;
+            continue;
+        }
+
+        size_t start = offset, end = offset;            // end is just past the last nonzero byte
+        size_t numZeros = 0;
+
+        while (offset < i_length and numZeros < c_m3MaxZeroGap)
+        {
+            if (i_data [offset])
+            {
+                end = offset + 1;
+                numZeros = 0;
+            }
+            else ++numZeros;
+
+            ++offset;
+        }
+
+        if (numRuns == capacity)
+        {
+            u32 newCapacity = capacity ? capacity * 2 : 64;
+
+            M3DataRun * newRuns = m3_ReallocArray (M3DataRun, runs, newCapacity, capacity);
+            _throwifnull (newRuns);
+
+            runs = newRuns;
+            capacity = newCapacity;
+        }
+
+        runs [numRuns].offset = (u32) start;
+        runs [numRuns].size = (u32) (end - start);
+        ++numRuns;
+    }
+
+    * o_runs = runs;
+    * o_numRuns = numRuns;
+    runs = NULL;
+
+    _catch:
+
+    m3_Free (runs);
+
+    return result;
+}
+
+
+static
+M3Result  WriteData  (M3WasmWriter * io_payload, IM3Module i_module, M3DataRun * i_runs, u32 i_numRuns, bool i_keepSegments)
+{
+    M3Result result = m3Err_none;
+
+    u8 * memory = m3MemData (i_module->runtime->memory.mallocated);
+    u32 numSegments = i_keepSegments ? i_module->numDataSegments : 0;
+
+_   (WriteLEB_u32 (io_payload, numSegments + i_numRuns));
+
+    for (u32 i = 0; i < numSegments; ++i)
+    {
+        M3DataSegment * segment = & i_module->dataSegments [i];
+        bool dropped = i_module->droppedDataSegments [i];
+
+_       (WriteByte (io_payload, 1));                            // passive
+_       (WriteLEB_u32 (io_payload, dropped ? 0 : segment->size));
+
+        if (not dropped)
+_           (WriteBytes (io_payload, segment->data, segment->size));
+    }
+
+    for (u32 i = 0; i < i_numRuns; ++i)
+    {
+_       (WriteByte (io_payload, 0));                            // active, memory 0
+_       (WriteByte (io_payload, c_waOp_i32_const));
+_       (WriteLEB_i64 (io_payload, (i32) i_runs [i].offset));
+_       (WriteByte (io_payload, c_waOp_end));
+_       (WriteLEB_u32 (io_payload, i_runs [i].size));
+_       (WriteBytes (io_payload, memory + i_runs [i].offset, i_runs [i].size));
+    }
+
+    _catch: return result;
+}
+
+
+static
+M3Result  WriteInitializedModule  (M3WasmWriter * io_writer, IM3Module i_module)
+{
+    M3Result result = m3Err_none;
+
+    M3WasmWriter payload;
+    M3_INIT (payload);
+
+    M3DataRun * runs = NULL;
+    u32 numRuns = 0;
+
+    bytes_t pos = i_module->wasmStart + 8;
+    cbytes_t end = i_module->wasmEnd;
+
+    bool hasMemory = false, hasDataCount = false, hasData = false, wroteData = false;
+
+    // a first pass finds whether the module defines the memory, where the data section goes, and whether segment
+    // indices have to be kept
+    while (pos < end)
+    {
+        u8 sectionId;
+        u32 sectionLength;
+_       (ReadLEB_u7 (& sectionId, & pos, end));
+_       (ReadLEB_u32 (& sectionLength, & pos, end));
+
+        hasMemory |= (sectionId == 5);
+        hasDataCount |= (sectionId == 12);
+        hasData |= (sectionId == 11);
+
+        pos += sectionLength;
+    }
+
+    if (hasMemory)
+    {
+        M3MemoryHeader * memory = i_module->runtime->memory.mallocated;
+_       (FindDataRuns (& runs, & numRuns, m3MemData (memory), memory->length));
+    }
+
+_   (WriteBytes (io_writer, i_module->wasmStart, 8));         // magic & version
+
+    pos = i_module->wasmStart + 8;
+
+    while (pos < end)
+    {
+        bytes_t sectionStart = pos;
+
+        u8 sectionId;
+        u32 sectionLength;
+_       (ReadLEB_u7 (& sectionId, & pos, end));
+_       (ReadLEB_u32 (& sectionLength, & pos, end));
+
+        cbytes_t sectionEnd = pos + sectionLength;
+
+        payload.numBytes = 0;
+
+        switch (sectionId)
+        {
+            case 5:
+_               (WriteMemory (& payload, i_module, pos, sectionEnd));
+_               (WriteSection (io_writer, sectionId, & payload));
+                break;
+
+            case 6:
+_               (WriteGlobals (& payload, i_module));
+_               (WriteSection (io_writer, sectionId, & payload));
+                break;
+
+            case 8:
+                break;
+
+            case 11:
+_               (WriteData (& payload, i_module, runs, numRuns, hasDataCount));
+_               (WriteSection (io_writer, sectionId, & payload));
+                wroteData = true;
+                break;
+
+            case 12:
+_               (WriteLEB_u32 (& payload, i_module->numDataSegments + numRuns));
+_               (WriteSection (io_writer, sectionId, & payload));
+                break;
+
+            default:
+_               (WriteBytes (io_writer, sectionStart, sectionEnd - sectionStart));
+        }
+
+        // a module without data segments gets a data section after its code
+        if (sectionId == 10 and not hasData and numRuns)
+        {
+            payload.numBytes = 0;
+_           (WriteData (& payload, i_module, runs, numRuns, false));
+_           (WriteSection (io_writer, 11, & payload));
+            wroteData = true;
+        }
+
+        pos = sectionEnd;
+    }
+
+    if (not wroteData and numRuns)
+    {
+        payload.numBytes = 0;
+_       (WriteData (& payload, i_module, runs, numRuns, false));
+_       (WriteSection (io_writer, 11, & payload));
+    }
+
+    _catch:
+
+    m3_Free (payload.bytes);
+    m3_Free (runs);
+
+    return result;
+}
+
+
+M3Result  m3_PreinitializeModule  (IM3Module io_module, const char * i_initFunction, uint8_t ** o_wasmBytes, uint32_t * o_numWasmBytes)
+{
+    M3Result result = m3Err_none;
+
+    M3WasmWriter writer;
+    M3_INIT (writer);
+
+    _throwif (m3Err_moduleNotLinked, not io_module->runtime);
+    _throwif ("imported memories can't be pre-initialized", io_module->memoryImported);
+    _throwif ("shared memories can't be pre-initialized", io_module->memoryInfo.shared);
+
+_   (m3_RunStart (io_module));
+
+    if (i_initFunction)
+    {
+        IM3Function function;
+_       (m3_FindFunction (& function, io_module->runtime, i_initFunction));
+        _throwif ("init function belongs to another module", function->module != io_module);
+
+_       (m3_CallV (function));
+    }
+
+_   (WriteInitializedModule (& writer, io_module));
+    _throwif ("module is too large", writer.numBytes > UINT32_MAX);
+
+    * o_wasmBytes = writer.bytes;
+    * o_numWasmBytes = (u32) writer.numBytes;
+    writer.bytes = NULL;
+
+    _catch:
+
+    m3_Free (writer.bytes);
+
+    return result;
+}
+
+
+void  m3_FreePreinitializedModule  (uint8_t * i_wasmBytes)
+{
+    m3_Free (i_wasmBytes);
+}
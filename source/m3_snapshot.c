@@ -0,0 +1,711 @@
+//
+//  m3_snapshot.c
+//
+//  Copy-on-write runtime snapshots & memory checkpoints
+//
+
+#include <stddef.h>
+
+#include "m3_snapshot.h"
+#include "m3_exception.h"
+
+#if d_m3HasSnapshots
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// a memory image keeps the linear memory in an anonymous file, leaving holes where its pages are zero. restoring
+// maps the file MAP_PRIVATE over the memory: whatever the runtime wrote since is dropped by the kernel, and a page is
+// only copied again once it's written to. that needs page-aligned data, so a malloc'd memory (no guard pages) is
+// first moved into a reservation laid out like the guard page one -- a leading page that holds the M3MemoryHeader,
+// then room for the maximum size -- where it stays from then on, growing with mprotect.
+
+#define d_m3GlobalValueSize     (offsetof (M3Global, name) - offsetof (M3Global, i64Value))
+
+typedef struct M3MemoryImage
+{
+    int                     fd;
+    size_t                  length;
+    u32                     numPages;
+    u32                     pageSize;
+}
+M3MemoryImage;
+
+
+typedef struct M3ModuleSnapshot
+{
+    u32                     numFunctions;
+    u32                     numGlobals;
+    u32                     numDataSegments;
+    u32                     table0Size;
+    i32                     startFunction;
+
+    u8 *                    globals;                // d_m3GlobalValueSize bytes each
+    i32 *                   table0;                 // function indices; -1 for a null entry
+    bool *                  droppedDataSegments;
+}
+M3ModuleSnapshot;
+
+
+typedef struct M3Snapshot
+{
+    M3MemoryImage *         memory;                 // NULL if the runtime has none
+
+    u32                     numModules;
+    M3ModuleSnapshot *      modules;                // in runtime->modules order
+}
+M3Snapshot;
+
+
+static
+size_t  GetHostPageSize  ()
+{
+    return (size_t) sysconf (_SC_PAGESIZE);
+}
+
+
+static
+size_t  RoundUpToHostPage  (size_t i_numBytes)
+{
+    size_t hostPageSize = GetHostPageSize ();
+
+    return (i_numBytes + hostPageSize - 1) / hostPageSize * hostPageSize;
+}
+
+
+static
+u32  CountModules  (IM3Runtime i_runtime)
+{
+    u32 numModules = 0;
+
+    IM3Module module = i_runtime->modules;
+    while (module)
+    {
+        ++numModules;
+        module = module->next;
+    }
+
+    return numModules;
+}
+
+
+static
+bool  IsZero  (const u8 * i_bytes, size_t i_numBytes)
+{
+    return i_bytes [0] == 0 and memcmp (i_bytes, i_bytes + 1, i_numBytes - 1) == 0;
+}
+
+
+static
+bool  WriteAt  (int i_fd, const u8 * i_bytes, size_t i_numBytes, size_t i_offset)
+{
+    while (i_numBytes)
+    {
+        ssize_t numWritten = pwrite (i_fd, i_bytes, i_numBytes, (off_t) i_offset);
+
+        if (numWritten < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        i_bytes += numWritten;
+        i_numBytes -= numWritten;
+        i_offset += numWritten;
+    }
+
+    return true;
+}
+
+
+static
+void  FreeMemoryImage  (M3MemoryImage * i_image)
+{
+    if (i_image)
+    {
+        if (i_image->fd >= 0)
+            close (i_image->fd);
+
+        m3_Free (i_image);
+    }
+}
+
+
+static
+M3Result  NewMemoryImage  (M3MemoryImage ** o_image, IM3Memory i_memory)
+{
+    M3Result result = m3Err_none;
+
+    size_t hostPageSize = GetHostPageSize ();
+    size_t length = i_memory->mallocated->length;
+    u8 * data = m3MemData (i_memory->mallocated);
+
+    size_t runStart = 0;
+    size_t offset = 0;
+
+    M3MemoryImage * image = m3_AllocStruct (M3MemoryImage);
+    _throwifnull (image);
+
+    image->length = length;
+    image->numPages = i_memory->numPages;
+    image->pageSize = i_memory->pageSize;
+
+    image->fd = OpenAnonymousFile ("wasm3 memory image");
+    _throwif ("couldn't create memory image file", image->fd < 0);
+
+    _throwif (m3Err_mallocFailed, ftruncate (image->fd, (off_t) RoundUpToHostPage (length)));
+
+    // runs of written pages are copied out; zero pages are left as holes, which cost nothing & read back as zero
+    while (offset < length)
+    {
+        size_t numBytes = M3_MIN (hostPageSize, length - offset);
+
+        if (IsZero (data + offset, numBytes))
+        {
+            _throwif ("couldn't write memory image file", not WriteAt (image->fd, data + runStart, offset - runStart, runStart));
+            runStart = offset + numBytes;
+        }
+
+        offset += numBytes;
+    }
+
+    _throwif ("couldn't write memory image file", not WriteAt (image->fd, data + runStart, length - runStart, runStart));
+
+    * o_image = image;
+    image = NULL;
+
+    _catch:
+
+    FreeMemoryImage (image);
+
+    return result;
+}
+
+
+static
+M3Result  SnapshotModule  (M3ModuleSnapshot * o_snapshot, IM3Module i_module)
+{
+    M3Result result = m3Err_none;
+
+    o_snapshot->numFunctions = i_module->numFunctions;
+    o_snapshot->numGlobals = i_module->numGlobals;
+    o_snapshot->numDataSegments = i_module->numDataSegments;
+    o_snapshot->table0Size = i_module->table0Size;
+    o_snapshot->startFunction = i_module->startFunction;
+
+    if (i_module->numGlobals)
+    {
+        o_snapshot->globals = m3_Malloc ("Snapshot Globals", i_module->numGlobals * d_m3GlobalValueSize);
+        _throwifnull (o_snapshot->globals);
+
+        for (u32 i = 0; i < i_module->numGlobals; ++i)
+            memcpy (o_snapshot->globals + i * d_m3GlobalValueSize, & i_module->globals [i].i64Value, d_m3GlobalValueSize);
+    }
+
+    if (i_module->table0Size)
+    {
+        o_snapshot->table0 = m3_AllocArray (i32, i_module->table0Size);
+        _throwifnull (o_snapshot->table0);
+
+        for (u32 i = 0; i < i_module->table0Size; ++i)
+        {
+            IM3Function function = i_module->table0 [i];
+            i32 index = -1;
+
+            if (function)
+            {
+                ptrdiff_t offset = function - i_module->functions;
+                _throwif ("table element isn't a function of its module", offset < 0 or offset >= (ptrdiff_t) i_module->numFunctions);
+
+                index = (i32) offset;
+            }
+
+            o_snapshot->table0 [i] = index;
+        }
+    }
+
+    if (i_module->droppedDataSegments)
+    {
+        o_snapshot->droppedDataSegments = m3_CopyMem (i_module->droppedDataSegments, i_module->numDataSegments * sizeof (bool));
+        _throwifnull (o_snapshot->droppedDataSegments);
+    }
+
+    _catch: return result;
+}
+
+
+M3Result  m3_SnapshotRuntime  (IM3Runtime i_runtime, IM3Snapshot * o_snapshot)
+{
+    M3Result result = m3Err_none;
+
+    IM3Memory memory = & i_runtime->memory;
+    IM3Module module = i_runtime->modules;
+
+    M3Snapshot * snapshot = m3_AllocStruct (M3Snapshot);
+    _throwifnull (snapshot);
+
+# if d_m3HasThreads
+    _throwif ("shared memories can't be snapshotted", memory->shared);
+# endif
+
+    if (memory->mallocated)
+    {
+_       (NewMemoryImage (& snapshot->memory, memory));
+    }
+
+    snapshot->numModules = CountModules (i_runtime);
+
+    if (snapshot->numModules)
+    {
+        snapshot->modules = m3_AllocArray (M3ModuleSnapshot, snapshot->numModules);
+        _throwifnull (snapshot->modules);
+    }
+
+    for (u32 i = 0; i < snapshot->numModules; ++i)
+    {
+_       (SnapshotModule (& snapshot->modules [i], module));
+        module = module->next;
+    }
+
+    * o_snapshot = snapshot;
+    snapshot = NULL;
+
+    _catch:
+
+    m3_FreeSnapshot (snapshot);
+
+    return result;
+}
+
+
+void  m3_FreeSnapshot  (IM3Snapshot i_snapshot)
+{
+    if (i_snapshot)
+    {
+        for (u32 i = 0; i < i_snapshot->numModules and i_snapshot->modules; ++i)
+        {
+            M3ModuleSnapshot * module = & i_snapshot->modules [i];
+
+            m3_Free (module->globals);
+            m3_Free (module->table0);
+            m3_Free (module->droppedDataSegments);
+        }
+
+        m3_Free (i_snapshot->modules);
+        FreeMemoryImage (i_snapshot->memory);
+
+        m3_Free (i_snapshot);
+    }
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------
+
+#if !d_m3UseGuardPages
+
+static
+M3Result  MoveMemoryToReservation  (IM3Memory io_memory)
+{
+    M3Result result = m3Err_none;
+
+    size_t hostPageSize = GetHostPageSize ();
+
+    u64 maxBytes = (u64) io_memory->maxPages * io_memory->pageSize;
+# if d_m3MaxLinearMemoryPages > 0
+    maxBytes = M3_MIN (maxBytes, (u64) d_m3MaxLinearMemoryPages * io_memory->pageSize);
+# endif
+
+    size_t numMappedBytes = RoundUpToHostPage ((size_t) maxBytes);
+
+    M3MemoryHeader * header;
+
+    // the memory's contents are replaced by the snapshot's, so only its header is carried over
+    u8 * base = (u8 *) mmap (NULL, hostPageSize + numMappedBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    _throwif (m3Err_mallocFailed, base == MAP_FAILED);
+
+    if (mprotect (base, hostPageSize, PROT_READ | PROT_WRITE))
+    {
+        munmap (base, hostPageSize + numMappedBytes);
+        _throw (m3Err_mallocFailed);
+    }
+
+    header = (M3MemoryHeader *) (base + hostPageSize - sizeof (M3MemoryHeader));
+    * header = * io_memory->mallocated;
+    header->length = 0;
+
+    m3_Free (io_memory->mallocated);
+
+    io_memory->mallocated = header;
+    io_memory->numMappedBytes = numMappedBytes;
+
+    _catch: return result;
+}
+
+
+M3Result  ResizeMappedMemory  (IM3Memory io_memory, size_t i_numPageBytes)
+{
+    M3Result result = m3Err_none;
+
+    size_t numAccessibleBytes = RoundUpToHostPage (i_numPageBytes);
+
+    _throwif (m3Err_wasmMemoryOverflow, numAccessibleBytes > io_memory->numMappedBytes);
+
+    if (numAccessibleBytes)
+    {
+        _throwif (m3Err_mallocFailed, mprotect (m3MemData (io_memory->mallocated), numAccessibleBytes, PROT_READ | PROT_WRITE));
+    }
+
+    _catch: return result;
+}
+
+
+void  FreeMappedMemory  (IM3Memory io_memory)
+{
+    munmap (m3MemData (io_memory->mallocated) - GetHostPageSize (), GetHostPageSize () + io_memory->numMappedBytes);
+
+    io_memory->mallocated = NULL;
+    io_memory->numMappedBytes = 0;
+}
+
+#endif // !d_m3UseGuardPages
+
+
+static
+M3Result  CheckRestorable  (IM3Runtime i_runtime, M3Snapshot * i_snapshot)
+{
+    M3Result result = m3Err_none;
+
+    IM3Memory memory = & i_runtime->memory;
+    IM3Module module = i_runtime->modules;
+
+# if d_m3HasThreads
+    _throwif ("shared memories can't be restored", memory->shared);
+# endif
+
+    _throwif ("snapshot doesn't match the runtime's modules", CountModules (i_runtime) != i_snapshot->numModules);
+    _throwif ("snapshot doesn't match the runtime's memory", (i_snapshot->memory != NULL) != (memory->mallocated != NULL));
+
+    if (i_snapshot->memory)
+    {
+        _throwif ("snapshot doesn't match the runtime's memory", i_snapshot->memory->pageSize != memory->pageSize);
+        _throwif (m3Err_wasmMemoryOverflow, i_snapshot->memory->numPages > memory->maxPages);
+    }
+
+    for (u32 i = 0; i < i_snapshot->numModules; ++i)
+    {
+        M3ModuleSnapshot * snapshot = & i_snapshot->modules [i];
+
+        _throwif ("snapshot doesn't match the runtime's modules", snapshot->numFunctions != module->numFunctions or
+                                                                  snapshot->numGlobals != module->numGlobals or
+                                                                  snapshot->numDataSegments != module->numDataSegments or
+                                                                  (snapshot->droppedDataSegments != NULL) != (module->droppedDataSegments != NULL));
+
+        // the only allocation a restore needs is done up front, so that failing leaves the runtime as it was
+        if (snapshot->table0Size > module->table0Size)
+        {
+            IM3Function * table0 = m3_ReallocArray (IM3Function, module->table0, snapshot->table0Size, module->table0Size);
+            _throwifnull (table0);
+
+            module->table0 = table0;
+        }
+
+        module = module->next;
+    }
+
+    _catch: return result;
+}
+
+
+// returns the pages that the memory grew into beyond i_numBytes (host page aligned) to the reservation
+static
+M3Result  TrimMemory  (IM3Memory io_memory, size_t i_numBytes)
+{
+    M3Result result = m3Err_none;
+
+    u8 * data = m3MemData (io_memory->mallocated);
+    size_t numCurrentBytes = RoundUpToHostPage (io_memory->mallocated->length);
+
+    if (numCurrentBytes > i_numBytes)
+    {
+        _throwif (m3Err_mallocFailed, mmap (data + i_numBytes, numCurrentBytes - i_numBytes, PROT_NONE,
+                                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0) == MAP_FAILED);
+    }
+
+    _catch: return result;
+}
+
+
+static
+M3Result  MapMemoryImage  (IM3Memory io_memory, M3MemoryImage * i_image)
+{
+    M3Result result = m3Err_none;
+
+    size_t numImageBytes = RoundUpToHostPage (i_image->length);
+
+# if !d_m3UseGuardPages
+    if (not io_memory->numMappedBytes)
+    {
+_       (MoveMemoryToReservation (io_memory));
+    }
+# endif
+
+    if (numImageBytes)
+    {
+        _throwif (m3Err_mallocFailed, mmap (m3MemData (io_memory->mallocated), numImageBytes, PROT_READ | PROT_WRITE,
+                                            MAP_PRIVATE | MAP_FIXED, i_image->fd, 0) == MAP_FAILED);
+    }
+
+_   (TrimMemory (io_memory, numImageBytes));
+
+    io_memory->numPages = i_image->numPages;
+    io_memory->mallocated->length = i_image->length;
+
+    _catch: return result;
+}
+
+
+static
+void  RestoreModule  (IM3Module io_module, M3ModuleSnapshot * i_snapshot)
+{
+    for (u32 i = 0; i < i_snapshot->numGlobals; ++i)
+        memcpy (& io_module->globals [i].i64Value, i_snapshot->globals + i * d_m3GlobalValueSize, d_m3GlobalValueSize);
+
+    for (u32 i = 0; i < i_snapshot->table0Size; ++i)
+    {
+        i32 index = i_snapshot->table0 [i];
+        io_module->table0 [i] = (index >= 0) ? & io_module->functions [index] : NULL;
+    }
+
+    io_module->table0Size = i_snapshot->table0Size;
+    io_module->table0Version++;
+
+    if (i_snapshot->droppedDataSegments)
+        memcpy (io_module->droppedDataSegments, i_snapshot->droppedDataSegments, i_snapshot->numDataSegments * sizeof (bool));
+
+    io_module->startFunction = i_snapshot->startFunction;
+}
+
+
+M3Result  m3_RestoreRuntime  (IM3Runtime io_runtime, IM3Snapshot i_snapshot)
+{
+    M3Result result = m3Err_none;
+
+    IM3Module module = io_runtime->modules;
+
+_   (CheckRestorable (io_runtime, i_snapshot));
+
+    if (i_snapshot->memory)
+    {
+        // the pages are no longer the checkpoint's
+        ReleaseMemoryCheckpoint (& io_runtime->memory);
+_       (MapMemoryImage (& io_runtime->memory, i_snapshot->memory));
+    }
+
+    for (u32 i = 0; i < i_snapshot->numModules; ++i)
+    {
+        RestoreModule (module, & i_snapshot->modules [i]);
+        module = module->next;
+    }
+
+    m3_ResetErrorInfo (io_runtime);
+
+    _catch: return result;
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------
+// a memory checkpoint is a memory image that's mapped over the memory straight away. the pages written since are then
+// the ones the kernel had to copy, which are no longer backed by the image's file -- including those written by
+// system calls (e.g. a WASI fd_read), which a write-protect fault scheme wouldn't see. on linux the pagemap tells
+// them apart, for 8 bytes read per host page, and only those runs of pages are mapped again. elsewhere all of them
+// are, which still just takes a couple of system calls.
+
+void  ReleaseMemoryCheckpoint  (IM3Memory io_memory)
+{
+    FreeMemoryImage (io_memory->checkpoint);
+    io_memory->checkpoint = NULL;
+}
+
+
+static
+M3Result  RemapPages  (IM3Memory io_memory, M3MemoryImage * i_image, size_t i_offset, size_t i_numBytes)
+{
+    M3Result result = m3Err_none;
+
+    if (i_numBytes)
+    {
+        _throwif (m3Err_mallocFailed, mmap (m3MemData (io_memory->mallocated) + i_offset, i_numBytes, PROT_READ | PROT_WRITE,
+                                            MAP_PRIVATE | MAP_FIXED, i_image->fd, (off_t) i_offset) == MAP_FAILED);
+    }
+
+    _catch: return result;
+}
+
+
+#if defined(__linux__)
+
+#define c_m3PagemapPresent          (1ull << 63)
+#define c_m3PagemapSwapped          (1ull << 62)
+#define c_m3PagemapFileOrShared     (1ull << 61)
+
+static
+int  GetPagemap  ()
+{
+    static int s_pagemap = -1;
+
+    if (s_pagemap < 0)
+    {
+        int fd = open ("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+
+        if (fd >= 0 and not __sync_bool_compare_and_swap (& s_pagemap, -1, fd))
+            close (fd);
+    }
+
+    return s_pagemap;
+}
+
+#endif
+
+
+// i_numBytes is host page aligned
+static
+M3Result  RemapDirtyPages  (IM3Memory io_memory, M3MemoryImage * i_image, size_t i_numBytes)
+{
+    M3Result result = m3Err_none;
+
+    size_t hostPageSize = GetHostPageSize ();
+    size_t numPages = i_numBytes / hostPageSize;
+    size_t page = 0;
+
+# if defined(__linux__)
+    int pagemap = GetPagemap ();
+
+    size_t runStart = 0, runEnd = 0;        // the pages of the latest run that was written to
+
+    u64 entries [512];
+
+    while (pagemap >= 0 and page < numPages)
+    {
+        size_t firstEntry = (uintptr_t) m3MemData (io_memory->mallocated) / hostPageSize + page;
+        size_t numEntries = M3_MIN (numPages - page, 512);
+
+        ssize_t numRead = pread (pagemap, entries, numEntries * sizeof (u64), (off_t) (firstEntry * sizeof (u64)));
+        if (numRead < (ssize_t) sizeof (u64))
+            break;
+
+        numEntries = numRead / sizeof (u64);
+
+        for (size_t i = 0; i < numEntries; ++i, ++page)
+        {
+            u64 entry = entries [i];
+
+            if ((entry & (c_m3PagemapPresent | c_m3PagemapSwapped)) and not (entry & c_m3PagemapFileOrShared))
+            {
+                if (page != runEnd)
+                {
+_                   (RemapPages (io_memory, i_image, runStart * hostPageSize, (runEnd - runStart) * hostPageSize));
+                    runStart = page;
+                }
+
+                runEnd = page + 1;
+            }
+        }
+    }
+
+_   (RemapPages (io_memory, i_image, runStart * hostPageSize, (runEnd - runStart) * hostPageSize));
+# endif
+
+    // whatever couldn't be told apart
+_   (RemapPages (io_memory, i_image, page * hostPageSize, (numPages - page) * hostPageSize));
+
+    _catch: return result;
+}
+
+
+M3Result  m3_CheckpointMemory  (IM3Runtime io_runtime)
+{
+    M3Result result = m3Err_none;
+
+    IM3Memory memory = & io_runtime->memory;
+    M3MemoryImage * image = NULL;
+
+# if d_m3HasThreads
+    _throwif ("shared memories can't be checkpointed", memory->shared);
+# endif
+    _throwif ("runtime has no memory", not memory->mallocated);
+
+_   (NewMemoryImage (& image, memory));
+_   (MapMemoryImage (memory, image));
+
+    ReleaseMemoryCheckpoint (memory);
+
+    memory->checkpoint = image;
+    image = NULL;
+
+    _catch:
+
+    FreeMemoryImage (image);
+
+    return result;
+}
+
+
+M3Result  m3_ResetMemory  (IM3Runtime io_runtime)
+{
+    M3Result result = m3Err_none;
+
+    IM3Memory memory = & io_runtime->memory;
+    M3MemoryImage * checkpoint = memory->checkpoint;
+
+    size_t numImageBytes, numCurrentBytes;
+
+    _throwif ("memory has no checkpoint", not checkpoint);
+
+    numImageBytes = RoundUpToHostPage (checkpoint->length);
+    numCurrentBytes = RoundUpToHostPage (memory->mallocated->length);
+
+_   (RemapDirtyPages (memory, checkpoint, M3_MIN (numImageBytes, numCurrentBytes)));
+_   (TrimMemory (memory, numImageBytes));
+
+    memory->numPages = checkpoint->numPages;
+    memory->mallocated->length = checkpoint->length;
+
+    _catch: return result;
+}
+
+#else // d_m3HasSnapshots
+
+M3Result  m3_SnapshotRuntime  (IM3Runtime i_runtime, IM3Snapshot * o_snapshot)
+{
+    return "snapshots aren't supported by this build";
+}
+
+
+M3Result  m3_RestoreRuntime  (IM3Runtime io_runtime, IM3Snapshot i_snapshot)
+{
+    return "snapshots aren't supported by this build";
+}
+
+
+void  m3_FreeSnapshot  (IM3Snapshot i_snapshot)
+{
+}
+
+
+M3Result  m3_CheckpointMemory  (IM3Runtime io_runtime)
+{
+    return "snapshots aren't supported by this build";
+}
+
+
+M3Result  m3_ResetMemory  (IM3Runtime io_runtime)
+{
+    return "snapshots aren't supported by this build";
+}
+
+#endif // d_m3HasSnapshots
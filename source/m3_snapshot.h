@@ -0,0 +1,30 @@
+//
+//  m3_snapshot.h
+//
+//  Copy-on-write runtime snapshots & memory checkpoints
+//
+
+#ifndef m3_snapshot_h
+#define m3_snapshot_h
+
+#include "m3_env.h"
+
+d_m3BeginExternC
+
+#if d_m3HasSnapshots
+
+void        ReleaseMemoryCheckpoint     (IM3Memory io_memory);
+
+#endif
+
+#if d_m3HasSnapshots && !d_m3UseGuardPages
+
+// a memory that was moved into a reservation (see MoveMemoryToReservation) grows in place & is unmapped rather than freed
+M3Result    ResizeMappedMemory          (IM3Memory io_memory, size_t i_numPageBytes);
+void        FreeMappedMemory            (IM3Memory io_memory);
+
+#endif
+
+d_m3EndExternC
+
+#endif // m3_snapshot_h
@@ -0,0 +1,362 @@
+//
+//  m3_suspend.c
+//
+//  Suspendable calls on a per-runtime native stack
+//
+
+#include "m3_suspend.h"
+#include "m3_exception.h"
+
+#if d_m3HasSuspend
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+// a call is one C call stack deep (op_Call recurses), so parking it means parking that stack. a runtime with
+// suspension enabled owns a fiber: a stack of its own that m3_Call switches onto to run the guest. m3_Suspend
+// switches back to whoever entered the fiber & leaves the frames where they are; m3_Resume switches onto it again.
+// the switch only saves the callee-saved registers (it's an ordinary function call as far as the compiler can tell),
+// so it's a few dozen instructions rather than the signal mask syscall that swapcontext makes.
+
+enum
+{
+    c_m3FiberIdle,
+    c_m3FiberRunning,
+    c_m3FiberSuspended
+};
+
+typedef struct M3Fiber
+{
+    u8 *                    stack;                  // lowest page is a guard
+    size_t                  stackSize;
+
+    void *                  sp;                     // where the fiber stopped
+    void *                  callerSp;               // where m3_Call / m3_Resume is waiting while the fiber runs
+
+    IM3Runtime              runtime;
+    IM3Function             function;               // the call in progress
+    M3Result                result;
+    M3Result                wakeResult;             // what m3_Suspend returns once the fiber is entered again
+
+    u8                      state;
+
+# if d_m3UseGuardPages
+    void *                  faultContext;           // the fiber's own chain of RunCodeWithFaultHandler frames
+# endif
+}
+M3Fiber;
+
+
+void  SwitchStack       (void ** o_sp, void * i_sp);
+void  FiberTrampoline   (void);
+
+# if defined(__APPLE__)
+#   define d_m3AsmSymbol(NAME)      "_" #NAME
+#   define d_m3AsmFunction(NAME)    ".private_extern _" #NAME "\n_" #NAME ":\n"
+# else
+#   define d_m3AsmSymbol(NAME)      #NAME
+#   define d_m3AsmFunction(NAME)    ".hidden " #NAME "\n.type " #NAME ", @function\n" #NAME ":\n"
+# endif
+
+# if defined(__x86_64__)
+
+__asm__ (
+    ".text\n"
+    ".p2align 4\n"
+    ".globl " d_m3AsmSymbol (SwitchStack) "\n"
+    d_m3AsmFunction (SwitchStack)
+    "   pushq   %rbp\n"
+    "   pushq   %rbx\n"
+    "   pushq   %r12\n"
+    "   pushq   %r13\n"
+    "   pushq   %r14\n"
+    "   pushq   %r15\n"
+    "   subq    $8, %rsp\n"
+    "   stmxcsr (%rsp)\n"
+    "   fnstcw  4(%rsp)\n"
+    "   movq    %rsp, (%rdi)\n"
+    "   movq    %rsi, %rsp\n"
+    "   ldmxcsr (%rsp)\n"
+    "   fldcw   4(%rsp)\n"
+    "   addq    $8, %rsp\n"
+    "   popq    %r15\n"
+    "   popq    %r14\n"
+    "   popq    %r13\n"
+    "   popq    %r12\n"
+    "   popq    %rbx\n"
+    "   popq    %rbp\n"
+    "   ret\n"
+    ".p2align 4\n"
+    ".globl " d_m3AsmSymbol (FiberTrampoline) "\n"
+    d_m3AsmFunction (FiberTrampoline)
+    "   movq    %r12, %rdi\n"
+    "   callq   *%r13\n"
+    "   ud2\n"
+);
+
+// the frame SwitchStack pops: control words, r15, r14, r13 (entry), r12 (argument), rbx, rbp, return address
+#   define d_m3FiberFrameWords      10
+#   define d_m3FiberFrameControl    0
+#   define d_m3FiberFrameEntry      3
+#   define d_m3FiberFrameArg        4
+#   define d_m3FiberFrameReturn     7
+#   define d_m3FiberInitialControl  (0x1F80 | (0x037Full << 32))    // default mxcsr & x87 control word
+
+# elif defined(__aarch64__)
+
+__asm__ (
+    ".text\n"
+    ".p2align 4\n"
+    ".globl " d_m3AsmSymbol (SwitchStack) "\n"
+    d_m3AsmFunction (SwitchStack)
+    "   sub     sp, sp, #160\n"
+    "   stp     x19, x20, [sp, #0]\n"
+    "   stp     x21, x22, [sp, #16]\n"
+    "   stp     x23, x24, [sp, #32]\n"
+    "   stp     x25, x26, [sp, #48]\n"
+    "   stp     x27, x28, [sp, #64]\n"
+    "   stp     x29, x30, [sp, #80]\n"
+    "   stp     d8, d9, [sp, #96]\n"
+    "   stp     d10, d11, [sp, #112]\n"
+    "   stp     d12, d13, [sp, #128]\n"
+    "   stp     d14, d15, [sp, #144]\n"
+    "   mov     x9, sp\n"
+    "   str     x9, [x0]\n"
+    "   mov     sp, x1\n"
+    "   ldp     x19, x20, [sp, #0]\n"
+    "   ldp     x21, x22, [sp, #16]\n"
+    "   ldp     x23, x24, [sp, #32]\n"
+    "   ldp     x25, x26, [sp, #48]\n"
+    "   ldp     x27, x28, [sp, #64]\n"
+    "   ldp     x29, x30, [sp, #80]\n"
+    "   ldp     d8, d9, [sp, #96]\n"
+    "   ldp     d10, d11, [sp, #112]\n"
+    "   ldp     d12, d13, [sp, #128]\n"
+    "   ldp     d14, d15, [sp, #144]\n"
+    "   add     sp, sp, #160\n"
+    "   ret\n"
+    ".p2align 4\n"
+    ".globl " d_m3AsmSymbol (FiberTrampoline) "\n"
+    d_m3AsmFunction (FiberTrampoline)
+    "   mov     x0, x19\n"
+    "   blr     x20\n"
+    "   brk     #0\n"
+);
+
+// the frame SwitchStack pops: x19 (argument), x20 (entry), x21-x28, x29, x30 (return address), d8-d15
+#   define d_m3FiberFrameWords      20
+#   define d_m3FiberFrameArg        0
+#   define d_m3FiberFrameEntry      1
+#   define d_m3FiberFrameReturn     11
+
+# endif
+
+
+static __thread M3Fiber *   s_currentFiber      = NULL;
+
+
+static
+void  FiberMain  (M3Fiber * io_fiber)
+{
+    // a finished call parks the fiber here, ready for the next one
+    while (true)
+    {
+        io_fiber->result = RunFunctionCode (io_fiber->runtime, io_fiber->function->compiled);
+        io_fiber->state = c_m3FiberIdle;
+
+        SwitchStack (& io_fiber->sp, io_fiber->callerSp);
+    }
+}
+
+
+static
+M3Result  EnterFiber  (M3Fiber * io_fiber)
+{
+    M3Fiber * caller = s_currentFiber;                      // a host function of another runtime's fiber may be calling
+
+    s_currentFiber = io_fiber;
+    io_fiber->state = c_m3FiberRunning;
+
+# if d_m3UseGuardPages
+    void * faultContext = SwapFaultContext (io_fiber->faultContext);
+# endif
+
+    SwitchStack (& io_fiber->callerSp, io_fiber->sp);
+
+# if d_m3UseGuardPages
+    io_fiber->faultContext = SwapFaultContext (faultContext);
+# endif
+
+    s_currentFiber = caller;
+
+    return io_fiber->result;
+}
+
+
+static
+M3Result  NewFiber  (M3Fiber ** o_fiber, IM3Runtime i_runtime, size_t i_stackSize)
+{
+    M3Result result = m3Err_none;
+
+    size_t pageSize = (size_t) sysconf (_SC_PAGESIZE);
+    size_t stackSize = (i_stackSize + pageSize - 1) & ~(pageSize - 1);
+
+    M3Fiber * fiber = m3_AllocStruct (M3Fiber);
+    _throwifnull (fiber);
+
+    // only the pages the guest's call depth reaches are ever committed, so idle fibers cost little more than address space
+    fiber->stack = mmap (NULL, stackSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    _throwif (m3Err_mallocFailed, fiber->stack == MAP_FAILED);
+
+    fiber->stackSize = stackSize + pageSize;
+    mprotect (fiber->stack, pageSize, PROT_NONE);
+
+    fiber->runtime = i_runtime;
+
+    {
+        // the first switch onto the fiber "returns" into FiberTrampoline, which calls FiberMain (fiber)
+        void ** frame = (void **) (fiber->stack + fiber->stackSize) - d_m3FiberFrameWords;
+        frame [d_m3FiberFrameArg]       = fiber;
+        frame [d_m3FiberFrameEntry]     = (void *) FiberMain;
+        frame [d_m3FiberFrameReturn]    = (void *) FiberTrampoline;
+# ifdef d_m3FiberInitialControl
+        frame [d_m3FiberFrameControl]   = (void *) d_m3FiberInitialControl;
+# endif
+
+        fiber->sp = frame;
+    }
+
+    * o_fiber = fiber;
+    fiber = NULL;
+
+    _catch:
+    if (fiber)
+    {
+        if (fiber->stack != MAP_FAILED)
+            munmap (fiber->stack, fiber->stackSize);
+        m3_Free (fiber);
+    }
+
+    return result;
+}
+
+
+void  FreeFiber  (IM3Runtime io_runtime)
+{
+    M3Fiber * fiber = io_runtime->fiber;
+
+    if (fiber)
+    {
+        // a suspended call is abandoned with its frames; host functions on it don't get to clean up
+        munmap (fiber->stack, fiber->stackSize);
+        m3_Free (fiber);
+
+        io_runtime->fiber = NULL;
+    }
+}
+
+
+bool  IsSuspended  (IM3Runtime i_runtime)
+{
+    return i_runtime->fiber and i_runtime->fiber->state == c_m3FiberSuspended;
+}
+
+
+M3Result  RunSuspendableCall  (IM3Runtime io_runtime, IM3Function i_function)
+{
+    M3Fiber * fiber = io_runtime->fiber;
+
+    // a host function re-entering its own runtime is already on the fiber
+    if (fiber->state == c_m3FiberRunning)
+        return RunFunctionCode (io_runtime, i_function->compiled);
+
+    fiber->function = i_function;
+
+    return EnterFiber (fiber);
+}
+
+
+M3Result  m3_EnableSuspension  (IM3Runtime io_runtime, uint32_t i_nativeStackSize)
+{
+    M3Result result = m3Err_none;
+
+    M3Fiber * fiber = io_runtime->fiber;
+    _throwif ("the runtime is executing", fiber and fiber->state != c_m3FiberIdle);
+
+    FreeFiber (io_runtime);
+
+_   (NewFiber (& io_runtime->fiber, io_runtime, i_nativeStackSize ? i_nativeStackSize : d_m3FiberStackSize));
+
+    _catch: return result;
+}
+
+
+M3Result  m3_Suspend  (IM3Runtime i_runtime)
+{
+    M3Fiber * fiber = s_currentFiber;
+
+    if (not fiber or (i_runtime and i_runtime->fiber != fiber))
+        return m3Err_notSuspendable;
+
+    fiber->result = m3Err_suspended;
+    fiber->state = c_m3FiberSuspended;
+
+    SwitchStack (& fiber->sp, fiber->callerSp);
+
+    return fiber->wakeResult;
+}
+
+
+static
+M3Result  WakeFiber  (IM3Runtime io_runtime, M3Result i_wakeResult)
+{
+    M3Fiber * fiber = io_runtime->fiber;
+
+    if (not fiber or fiber->state != c_m3FiberSuspended)
+        return m3Err_notSuspended;
+
+    fiber->wakeResult = i_wakeResult;
+
+    M3Result result = EnterFiber (fiber);
+
+    io_runtime->lastCalled = result ? NULL : fiber->function;
+
+    return result;
+}
+
+
+M3Result  m3_Resume  (IM3Runtime io_runtime)
+{
+    return WakeFiber (io_runtime, m3Err_none);
+}
+
+
+M3Result  m3_CancelSuspended  (IM3Runtime io_runtime)
+{
+    return WakeFiber (io_runtime, m3Err_trapSuspendedCallCancelled);
+}
+
+
+#else // d_m3HasSuspend
+
+M3Result  m3_EnableSuspension  (IM3Runtime io_runtime, uint32_t i_nativeStackSize)
+{
+    return "suspension isn't supported by this build";
+}
+
+M3Result  m3_Suspend  (IM3Runtime i_runtime)
+{
+    return m3Err_notSuspendable;
+}
+
+M3Result  m3_Resume  (IM3Runtime io_runtime)
+{
+    return m3Err_notSuspended;
+}
+
+M3Result  m3_CancelSuspended  (IM3Runtime io_runtime)
+{
+    return m3Err_notSuspended;
+}
+
+#endif // d_m3HasSuspend
@@ -0,0 +1,27 @@
+//
+//  m3_suspend.h
+//
+//  Suspendable calls on a per-runtime native stack
+//
+
+#ifndef m3_suspend_h
+#define m3_suspend_h
+
+#include "m3_env.h"
+
+d_m3BeginExternC
+
+#if d_m3HasSuspend
+
+// runs the call on the runtime's fiber (see m3_EnableSuspension); returns m3Err_suspended if the guest parked it
+M3Result    RunSuspendableCall          (IM3Runtime io_runtime, IM3Function i_function);
+void        FreeFiber                   (IM3Runtime io_runtime);
+
+// the suspended call's frames occupy the bottom of the wasm stack, so no other call may start until it's finished
+bool        IsSuspended                 (IM3Runtime i_runtime);
+
+#endif
+
+d_m3EndExternC
+
+#endif // m3_suspend_h
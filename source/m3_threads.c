@@ -0,0 +1,531 @@
+//
+//  m3_threads.c
+//
+//  Shared linear memories & atomic waiting (threads proposal)
+//
+
+#include "m3_threads.h"
+#include "m3_exception.h"
+
+#if d_m3HasThreads
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(__linux__)
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#endif
+
+// the pages of a shared memory live in an anonymous shared-memory file. every runtime attached to it maps the file
+// at the start of its own reservation, behind a private page that holds that runtime's M3MemoryHeader, so the
+// operations address a shared memory exactly like any other: m3MemData (_mem) + offset. the mapping is sized
+// for the maximum up front and the memory is never moved; growing only makes more of it accessible.
+//
+// waiting threads queue up in FIFO order on the memory, keyed by the offset of the address they wait on (not the
+// address itself: each runtime sees the pages somewhere else). each waiter then sleeps on a word of its own (a
+// futex on linux, a condition variable otherwise) until it's notified or its timeout elapses.
+
+typedef struct M3Waiter
+{
+    struct M3Waiter *       next;
+    u64                     offset;
+    _Atomic u32             woken;
+
+# if !defined(__linux__)
+    pthread_cond_t          condition;
+# endif
+}
+M3Waiter;
+
+
+typedef struct M3SharedMemory
+{
+    int                     fd;
+    _Atomic u32             numRefs;
+
+    pthread_mutex_t         lock;               // guards everything below
+
+    u32                     numPages;
+    u32                     maxPages;
+    u32                     pageSize;
+    size_t                  numMappedBytes;     // the whole file; maxPages rounded up to host pages
+
+    IM3Memory               attached;           // the memories of the runtimes mapping this file
+
+    M3Waiter *              waiters;
+    M3Waiter **             waitersEnd;
+}
+M3SharedMemory;
+
+
+static
+size_t  GetHostPageSize  ()
+{
+    return (size_t) sysconf (_SC_PAGESIZE);
+}
+
+
+static
+size_t  RoundUpToHostPage  (size_t i_numBytes)
+{
+    size_t hostPageSize = GetHostPageSize ();
+
+    return (i_numBytes + hostPageSize - 1) / hostPageSize * hostPageSize;
+}
+
+
+static
+size_t  GetReservationSize  (M3SharedMemory * i_shared)
+{
+# if d_m3UseGuardPages
+    return GetHostPageSize () + c_m3GuardRegionSize;
+# else
+    return GetHostPageSize () + i_shared->numMappedBytes;
+# endif
+}
+
+
+static
+M3Result  NewSharedMemory  (M3SharedMemory ** o_shared, u32 i_maxPages, u32 i_pageSize)
+{
+    M3Result result = m3Err_none;
+
+    u64 maxBytes = (u64) i_maxPages * i_pageSize;
+# if d_m3MaxLinearMemoryPages > 0
+    maxBytes = M3_MIN (maxBytes, (u64) d_m3MaxLinearMemoryPages * i_pageSize);
+# endif
+
+    M3SharedMemory * shared = m3_AllocStruct (M3SharedMemory);
+    _throwifnull (shared);
+
+    shared->fd = -1;
+    shared->numRefs = 1;
+    shared->maxPages = i_maxPages;
+    shared->pageSize = i_pageSize;
+    shared->waitersEnd = & shared->waiters;
+
+    pthread_mutex_init (& shared->lock, NULL);
+
+    _throwif ("shared memory is larger than the address space", maxBytes > SIZE_MAX - 2 * GetHostPageSize ());
+    shared->numMappedBytes = RoundUpToHostPage ((size_t) maxBytes);
+
+# if d_m3UseGuardPages
+    _throwif ("linear memory size isn't a multiple of the host page size", i_pageSize % GetHostPageSize ());
+# endif
+
+    shared->fd = OpenAnonymousFile ("wasm3 shared memory");
+    _throwif ("couldn't create shared memory", shared->fd < 0);
+
+    // the file's pages are only backed once they're touched
+    _throwif (m3Err_mallocFailed, ftruncate (shared->fd, (off_t) shared->numMappedBytes));
+
+    * o_shared = shared;
+    shared = NULL;
+
+    _catch:
+
+    if (shared)
+    {
+        if (shared->fd >= 0)
+            close (shared->fd);
+
+        pthread_mutex_destroy (& shared->lock);
+        m3_Free (shared);
+    }
+
+    return result;
+}
+
+
+static
+void  ReleaseSharedMemory  (M3SharedMemory * i_shared)
+{
+    if (atomic_fetch_sub (& i_shared->numRefs, 1) == 1)
+    {
+        close (i_shared->fd);
+        pthread_mutex_destroy (& i_shared->lock);
+        m3_Free (i_shared);
+    }
+}
+
+
+// lock held
+static
+M3Result  MapSharedMemory  (IM3Memory io_memory, M3SharedMemory * i_shared)
+{
+    M3Result result = m3Err_none;
+
+    size_t hostPageSize = GetHostPageSize ();
+    size_t reservationSize = GetReservationSize (i_shared);
+    size_t numAccessibleBytes = RoundUpToHostPage ((size_t) i_shared->numPages * i_shared->pageSize);
+
+    u8 * base, * pages;
+
+# if d_m3UseGuardPages
+_   (InstallMemoryFaultHandler ());
+# endif
+
+    base = (u8 *) mmap (NULL, reservationSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    _throwif (m3Err_mallocFailed, base == MAP_FAILED);
+
+    pages = base + hostPageSize;
+
+    if (mprotect (base, hostPageSize, PROT_READ | PROT_WRITE) or
+        mmap (pages, i_shared->numMappedBytes, PROT_NONE, MAP_SHARED | MAP_FIXED, i_shared->fd, 0) == MAP_FAILED or
+        (numAccessibleBytes and mprotect (pages, numAccessibleBytes, PROT_READ | PROT_WRITE)))
+    {
+        munmap (base, reservationSize);
+        _throw (m3Err_mallocFailed);
+    }
+
+    io_memory->mallocated = (M3MemoryHeader *) (pages - sizeof (M3MemoryHeader));
+    io_memory->mallocated->length = (size_t) i_shared->numPages * i_shared->pageSize;
+
+    io_memory->numPages = i_shared->numPages;
+    io_memory->maxPages = i_shared->maxPages;
+    io_memory->pageSize = i_shared->pageSize;
+
+    io_memory->nextAttached = i_shared->attached;
+    i_shared->attached = io_memory;
+
+    _catch: return result;
+}
+
+
+// lock held
+static
+M3Result  GrowPages  (M3SharedMemory * io_shared, u32 i_numPages)
+{
+    M3Result result = m3Err_none;
+
+    size_t numBytes = (size_t) i_numPages * io_shared->pageSize;
+    size_t numAccessibleBytes = RoundUpToHostPage (numBytes);
+
+    IM3Memory memory = io_shared->attached;
+
+    _throwif (m3Err_wasmMemoryOverflow, i_numPages > io_shared->maxPages);
+# if d_m3MaxLinearMemoryPages > 0
+    _throwif ("linear memory limitation exceeded", i_numPages > d_m3MaxLinearMemoryPages);
+# endif
+
+    while (memory)
+    {
+        _throwif (m3Err_mallocFailed, mprotect (m3MemData (memory->mallocated), numAccessibleBytes, PROT_READ | PROT_WRITE));
+        memory = memory->nextAttached;
+    }
+
+    // the new length is only published once the pages are accessible everywhere
+    io_shared->numPages = i_numPages;
+
+    memory = io_shared->attached;
+    while (memory)
+    {
+        memory->numPages = i_numPages;
+        memory->mallocated->length = numBytes;
+        memory = memory->nextAttached;
+    }
+
+    _catch: return result;
+}
+
+
+M3Result  AttachSharedMemory  (IM3Runtime io_runtime, IM3Module i_module)
+{
+    M3Result result = m3Err_none;
+
+    IM3Memory memory = & io_runtime->memory;
+    M3MemoryInfo * info = & i_module->memoryInfo;
+
+    u32 pageSize = info->pageSize ? info->pageSize : d_m3DefaultMemPageSize;
+
+    M3SharedMemory * shared;
+
+    _throwif ("runtime memory is already in use", memory->mallocated);
+
+    if (not memory->shared)
+    {
+_       (NewSharedMemory (& memory->shared, info->maxPages, pageSize));
+    }
+
+    shared = memory->shared;
+
+    _throwif ("shared memory page size mismatch", shared->pageSize != pageSize);
+    _throwif ("shared memory maximum mismatch", shared->maxPages > info->maxPages);
+
+    pthread_mutex_lock (& shared->lock);
+
+    result = MapSharedMemory (memory, shared);
+
+    if (not result and info->initPages > shared->numPages)
+        result = GrowPages (shared, info->initPages);
+
+    pthread_mutex_unlock (& shared->lock);
+
+    if (not result)
+    {
+        memory->mallocated->runtime = io_runtime;
+        memory->mallocated->maxStack = (m3slot_t *) io_runtime->stack + io_runtime->numStackSlots;
+    }
+
+    _catch: return result;
+}
+
+
+void  DetachSharedMemory  (IM3Memory io_memory)
+{
+    M3SharedMemory * shared = io_memory->shared;
+
+    if (io_memory->mallocated)
+    {
+        pthread_mutex_lock (& shared->lock);
+
+        IM3Memory * link = & shared->attached;
+        while (* link != io_memory)
+            link = & (* link)->nextAttached;
+
+        * link = io_memory->nextAttached;
+
+        pthread_mutex_unlock (& shared->lock);
+
+        munmap (m3MemData (io_memory->mallocated) - GetHostPageSize (), GetReservationSize (shared));
+        io_memory->mallocated = NULL;
+    }
+
+    io_memory->shared = NULL;
+    io_memory->nextAttached = NULL;
+
+    ReleaseSharedMemory (shared);
+}
+
+
+M3Result  ResizeSharedMemory  (IM3Runtime io_runtime, u32 i_numPages)
+{
+    M3Result result = m3Err_none;
+
+    M3SharedMemory * shared = io_runtime->memory.shared;
+
+    pthread_mutex_lock (& shared->lock);
+
+    if (i_numPages > shared->numPages)
+        result = GrowPages (shared, i_numPages);
+
+    pthread_mutex_unlock (& shared->lock);
+
+    return result;
+}
+
+
+i32  GrowSharedMemory  (IM3Memory io_memory, u32 i_numPagesToGrow)
+{
+    M3SharedMemory * shared = io_memory->shared;
+
+    pthread_mutex_lock (& shared->lock);
+
+    // the previous size is read under the lock so that concurrent memory.grow's each get their own
+    i32 previousPages = (i32) shared->numPages;
+    u64 numPages = (u64) shared->numPages + i_numPagesToGrow;
+
+    if (i_numPagesToGrow)
+    {
+        if (numPages > shared->maxPages or GrowPages (shared, (u32) numPages))
+            previousPages = -1;
+    }
+
+    pthread_mutex_unlock (& shared->lock);
+
+    return previousPages;
+}
+
+
+M3Result  m3_ShareMemory  (IM3Runtime io_runtime, IM3Runtime i_source)
+{
+    M3Result result = m3Err_none;
+
+    _throwif ("runtime memory is already in use", io_runtime->memory.mallocated or io_runtime->memory.shared);
+    _throwif ("memory isn't shared", not i_source->memory.shared);
+
+    atomic_fetch_add (& i_source->memory.shared->numRefs, 1);
+    io_runtime->memory.shared = i_source->memory.shared;
+
+    _catch: return result;
+}
+
+
+//---------------------------------------------------------------------------------------------------------------------------------
+
+static
+i64  GetMonotonicTime  ()
+{
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, & now);
+
+    return (i64) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+
+static
+void  UnlinkWaiter  (M3SharedMemory * io_shared, M3Waiter * i_waiter)
+{
+    M3Waiter ** link = & io_shared->waiters;
+    while (* link != i_waiter)
+        link = & (* link)->next;
+
+    * link = i_waiter->next;
+
+    if (io_shared->waitersEnd == & i_waiter->next)
+        io_shared->waitersEnd = link;
+}
+
+
+// lock held on entry & exit. returns once the waiter is woken or i_deadline (when non-negative) has passed
+static
+void  ParkWaiter  (M3SharedMemory * io_shared, M3Waiter * io_waiter, i64 i_deadline)
+{
+# if defined(__linux__)
+    pthread_mutex_unlock (& io_shared->lock);
+
+    while (not atomic_load (& io_waiter->woken))
+    {
+        struct timespec remaining, * timeout = NULL;
+
+        if (i_deadline >= 0)
+        {
+            i64 timeLeft = i_deadline - GetMonotonicTime ();
+            if (timeLeft <= 0)
+                break;
+
+            remaining.tv_sec = timeLeft / 1000000000;
+            remaining.tv_nsec = timeLeft % 1000000000;
+            timeout = & remaining;
+        }
+
+        syscall (SYS_futex, (u32 *) & io_waiter->woken, FUTEX_WAIT_PRIVATE, 0, timeout, NULL, 0);
+    }
+
+    // notify wakes the futex while holding the lock, so the waiter can't be released before it has
+    pthread_mutex_lock (& io_shared->lock);
+# else
+    struct timespec deadline;
+
+    if (i_deadline >= 0)
+    {
+        // condition variables time out against the realtime clock
+        i64 timeLeft = i_deadline - GetMonotonicTime ();
+        clock_gettime (CLOCK_REALTIME, & deadline);
+
+        i64 end = (i64) deadline.tv_nsec + (timeLeft > 0 ? timeLeft : 0);
+        deadline.tv_sec += end / 1000000000;
+        deadline.tv_nsec = end % 1000000000;
+    }
+
+    while (not atomic_load (& io_waiter->woken))
+    {
+        if (i_deadline < 0)
+            pthread_cond_wait (& io_waiter->condition, & io_shared->lock);
+        else if (pthread_cond_timedwait (& io_waiter->condition, & io_shared->lock, & deadline) == ETIMEDOUT)
+            break;
+    }
+# endif
+}
+
+
+u32  SharedMemory_Wait  (IM3Memory i_memory, u64 i_offset, u64 i_expected, u32 i_size, i64 i_timeoutNs)
+{
+    M3SharedMemory * shared = i_memory->shared;
+    u8 * address = m3MemData (i_memory->mallocated) + i_offset;
+
+    i64 deadline = -1;
+    if (i_timeoutNs >= 0)
+        deadline = GetMonotonicTime () + i_timeoutNs;
+
+    M3Waiter waiter;
+    waiter.next = NULL;
+    waiter.offset = i_offset;
+    atomic_init (& waiter.woken, 0);
+
+    pthread_mutex_lock (& shared->lock);
+
+    // a notify has to take the lock, so it can't slip in between this comparison & the enqueue
+    u64 value = (i_size == sizeof (u32)) ? atomic_load ((_Atomic u32 *) address) : atomic_load ((_Atomic u64 *) address);
+
+    u32 outcome = 1;
+
+    if (value == i_expected)
+    {
+# if !defined(__linux__)
+        pthread_cond_init (& waiter.condition, NULL);
+# endif
+        * shared->waitersEnd = & waiter;
+        shared->waitersEnd = & waiter.next;
+
+        ParkWaiter (shared, & waiter, deadline);
+
+        if (atomic_load (& waiter.woken))
+        {
+            outcome = 0;
+        }
+        else
+        {
+            UnlinkWaiter (shared, & waiter);
+            outcome = 2;
+        }
+
+# if !defined(__linux__)
+        pthread_cond_destroy (& waiter.condition);
+# endif
+    }
+
+    pthread_mutex_unlock (& shared->lock);
+
+    return outcome;
+}
+
+
+u32  SharedMemory_Notify  (IM3Memory i_memory, u64 i_offset, u32 i_count)
+{
+    M3SharedMemory * shared = i_memory->shared;
+
+    u32 numWoken = 0;
+
+    pthread_mutex_lock (& shared->lock);
+
+    M3Waiter ** link = & shared->waiters;
+    while (* link and numWoken < i_count)
+    {
+        M3Waiter * waiter = * link;
+
+        if (waiter->offset == i_offset)
+        {
+            * link = waiter->next;
+            if (shared->waitersEnd == & waiter->next)
+                shared->waitersEnd = link;
+
+            atomic_store (& waiter->woken, 1);
+# if defined(__linux__)
+            syscall (SYS_futex, (u32 *) & waiter->woken, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+# else
+            pthread_cond_signal (& waiter->condition);
+# endif
+            ++numWoken;
+        }
+        else link = & waiter->next;
+    }
+
+    pthread_mutex_unlock (& shared->lock);
+
+    return numWoken;
+}
+
+#else // d_m3HasThreads
+
+M3Result  m3_ShareMemory  (IM3Runtime io_runtime, IM3Runtime i_source)
+{
+    return "shared memories aren't supported by this build";
+}
+
+#endif // d_m3HasThreads
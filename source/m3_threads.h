@@ -0,0 +1,36 @@
+//
+//  m3_threads.h
+//
+//  Shared linear memories & atomic waiting (threads proposal)
+//
+
+#ifndef m3_threads_h
+#define m3_threads_h
+
+#include "m3_env.h"
+
+d_m3BeginExternC
+
+#if d_m3HasThreads
+
+// maps the module's shared memory into io_runtime; the memory is created unless m3_ShareMemory already supplied one
+M3Result    AttachSharedMemory          (IM3Runtime io_runtime, IM3Module i_module);
+void        DetachSharedMemory          (IM3Memory io_memory);
+
+// grows the memory to (at least) i_numPages in every runtime it's attached to
+M3Result    ResizeSharedMemory          (IM3Runtime io_runtime, u32 i_numPages);
+
+// memory.grow: returns the previous number of pages or -1
+i32         GrowSharedMemory            (IM3Memory io_memory, u32 i_numPagesToGrow);
+
+// memory.atomic.wait32/64: returns 0 (woken), 1 (value wasn't i_expected) or 2 (timed out). a negative timeout waits forever.
+u32         SharedMemory_Wait           (IM3Memory i_memory, u64 i_offset, u64 i_expected, u32 i_size, i64 i_timeoutNs);
+
+// memory.atomic.notify: returns the number of waiters woken
+u32         SharedMemory_Notify         (IM3Memory i_memory, u64 i_offset, u32 i_count);
+
+#endif
+
+d_m3EndExternC
+
+#endif // m3_threads_h
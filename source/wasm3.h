@@ -35,6 +35,8 @@ struct M3Runtime;       typedef struct M3Runtime *      IM3Runtime;
 struct M3Module;        typedef struct M3Module *       IM3Module;
 struct M3Function;      typedef struct M3Function *     IM3Function;
 struct M3Global;        typedef struct M3Global *       IM3Global;
+struct M3ModuleTemplate; typedef struct M3ModuleTemplate * IM3ModuleTemplate;
+struct M3Snapshot;      typedef struct M3Snapshot *     IM3Snapshot;
 
 typedef struct M3ErrorInfo
 {
@@ -75,7 +77,9 @@ typedef enum M3ValueType
     c_m3Type_f32    = 3,
     c_m3Type_f64    = 4,
 
-    c_m3Type_unknown
+    c_m3Type_unknown = 5,
+
+    c_m3Type_v128   = 6         // after unknown, so that the values above keep their meaning
 } M3ValueType;
 
 typedef struct M3TaggedValue
@@ -184,6 +188,17 @@ d_m3ErrorConst  (trapExit,                      "[trap] program called exit")
 d_m3ErrorConst  (trapAbort,                     "[trap] program called abort")
 d_m3ErrorConst  (trapUnreachable,               "[trap] unreachable executed")
 d_m3ErrorConst  (trapStackOverflow,             "[trap] stack overflow")
+d_m3ErrorConst  (trapUnalignedAtomic,           "[trap] unaligned atomic")
+d_m3ErrorConst  (trapExpectedSharedMemory,      "[trap] expected shared memory")
+d_m3ErrorConst  (trapSuspendedCallCancelled,    "[trap] suspended call was cancelled")
+d_m3ErrorConst  (trapOutOfGas,                  "[trap] out of gas")
+d_m3ErrorConst  (trapInterrupted,               "[trap] execution interrupted")
+
+// suspension
+d_m3ErrorConst  (suspended,                     "execution is suspended")
+d_m3ErrorConst  (notSuspendable,                "no suspendable call is executing on this thread")
+d_m3ErrorConst  (notSuspended,                  "the runtime isn't suspended")
+d_m3ErrorConst  (runtimeSuspended,              "the runtime has a suspended call")
 
 
 //-------------------------------------------------------------------------------------------------------------------------------
@@ -201,6 +216,16 @@ d_m3ErrorConst  (trapStackOverflow,             "[trap] stack overflow")
 
     void                m3_SetCustomSectionHandler  (IM3Environment i_environment,    M3SectionHandler i_handler);
 
+    // Compiled code is cached in this directory, keyed by a hash of the module bytes and of the wasm3 build.
+    // m3_CompileModule (and m3_CompileModuleParallel) then restore a module from the cache instead of compiling
+    // it, or store the module once compiled. Host functions must be linked first. NULL disables the cache.
+    M3Result            m3_SetCodeCacheDirectory    (IM3Environment i_environment,    const char * i_path);
+
+    // Functions compiled from now on charge each straight-line run of their code (a loop iteration, an arm of an if, ...)
+    // the cost of its opcodes as it's entered. i_opcodeCosts holds 256 costs, indexed by opcode (a prefixed opcode costs
+    // what its prefix byte does); NULL charges 1 per opcode. See m3_SetGasLimit.
+    M3Result            m3_EnableGasMetering        (IM3Environment i_environment,    const uint32_t * i_opcodeCosts);
+
 
 //-------------------------------------------------------------------------------------------------------------------------------
 //  execution context
@@ -220,8 +245,48 @@ d_m3ErrorConst  (trapStackOverflow,             "[trap] stack overflow")
     // This is used internally by Raw Function helpers
     uint32_t            m3_GetMemorySize            (IM3Runtime             i_runtime);
 
+    // Attaches io_runtime to the shared memory of i_source, so that host threads each running one of the runtimes
+    // work on the same linear memory (threads proposal). Call it before loading a module into io_runtime; that
+    // module has to define or import a shared memory.
+    M3Result            m3_ShareMemory              (IM3Runtime             io_runtime,
+                                                     IM3Runtime             i_source);
+
     void *              m3_GetUserData              (IM3Runtime             i_runtime);
 
+    // Resets the gas used to zero and limits it to i_limit; a run of code that would go past the limit traps with
+    // m3Err_trapOutOfGas (and counts as used). Without a limit, gas is still counted. Needs m3_EnableGasMetering.
+    M3Result            m3_SetGasLimit              (IM3Runtime             io_runtime,
+                                                     uint64_t               i_limit);
+
+    uint64_t            m3_GetGasUsed               (IM3Runtime             i_runtime);
+
+    // Each call_indirect site remembers the last table entry it called, until the table changes. These count the
+    // calls made in i_runtime that found their callee there (hits) & those that looked it up in the table (misses).
+    // Code shared by the instances of a module template always looks up. Either output may be NULL.
+    void                m3_GetCallCacheCounts       (IM3Runtime             i_runtime,
+                                                     uint64_t *             o_hits,
+                                                     uint64_t *             o_misses);
+
+    // Safe to call from any thread: the call executing in io_runtime (or the next one, if none is) traps with
+    // m3Err_trapInterrupted at its next loop iteration or function entry. Host functions aren't interrupted.
+    void                m3_InterruptRuntime         (IM3Runtime             io_runtime);
+
+    // Interrupts io_runtime once i_milliseconds have passed; 0 disarms it. Arming (or disarming) clears a pending
+    // interrupt. A watchdog thread, started on first use, keeps the deadlines of all runtimes.
+    M3Result            m3_SetDeadline              (IM3Runtime             io_runtime,
+                                                     uint32_t               i_milliseconds);
+
+    // Translates the functions compiled in io_runtime, now and from then on, to native code (x86-64 Linux builds).
+    // Ops the translator doesn't cover hand the rest of that call to the interpreter. Code shared by the instances
+    // of a module template stays interpreted.
+    M3Result            m3_EnableJit                (IM3Runtime             io_runtime);
+
+    // Makes the jit lazy. Functions compiled from now on are interpreted, counting their calls and loop iterations,
+    // until the count reaches i_threshold. Then they're recompiled, translated and swapped in: later calls, through
+    // existing call sites too, run the native code while calls in progress finish interpreted. Implies m3_EnableJit.
+    M3Result            m3_EnableTiering            (IM3Runtime             io_runtime,
+                                                     uint32_t               i_threshold);
+
 
 //-------------------------------------------------------------------------------------------------------------------------------
 //  modules
@@ -244,6 +309,10 @@ d_m3ErrorConst  (trapStackOverflow,             "[trap] stack overflow")
     // Optional, compiles all functions in the module
     M3Result            m3_CompileModule            (IM3Module io_module);
 
+    // Optional, compiles all functions in the module using up to i_numThreads threads (0 = one per core).
+    // Falls back to m3_CompileModule on platforms without pthreads. Don't run the module meanwhile.
+    M3Result            m3_CompileModuleParallel    (IM3Module io_module, uint32_t i_numThreads);
+
     // Calling m3_RunStart is optional
     M3Result            m3_RunStart                 (IM3Module i_module);
 
@@ -269,6 +338,94 @@ d_m3ErrorConst  (trapStackOverflow,             "[trap] stack overflow")
     void                m3_SetModuleName            (IM3Module i_module, const char* name);
     IM3Runtime          m3_GetModuleRuntime         (IM3Module i_module);
 
+//-------------------------------------------------------------------------------------------------------------------------------
+//  module templates: parse and compile once, then instantiate into many runtimes that share the compiled code
+//-------------------------------------------------------------------------------------------------------------------------------
+
+    // Host functions must be linked into the template module (see m3_GetTemplateModule) before the first
+    // instantiation, which compiles it. Once compiled the template isn't written to, so after calling
+    // m3_CompileModule on the template module up front, instances can be created from several threads, each
+    // into a runtime of its own. i_wasmBytes and the template must outlive all of its instances.
+    M3Result            m3_NewModuleTemplate        (IM3Environment         i_environment,
+                                                     IM3ModuleTemplate *    o_template,
+                                                     const uint8_t * const  i_wasmBytes,
+                                                     uint32_t               i_numWasmBytes);
+
+    void                m3_FreeModuleTemplate       (IM3ModuleTemplate      i_template);
+
+    IM3Module           m3_GetTemplateModule        (IM3ModuleTemplate      i_template);
+
+    // Loads an instance with its own memory, globals and table into the runtime, which takes ownership of it
+    // as it does with m3_LoadModule. A runtime holds at most one template instance.
+    M3Result            m3_InstantiateTemplate      (IM3Runtime             io_runtime,
+                                                     IM3ModuleTemplate      i_template,
+                                                     IM3Module *            o_module);
+
+//-------------------------------------------------------------------------------------------------------------------------------
+//  snapshots: capture an initialized runtime once, then reset it (or a runtime loaded the same way) to that state
+//-------------------------------------------------------------------------------------------------------------------------------
+
+    // Captures the linear memory and, for each loaded module, its globals, table0, dropped data segments and whether
+    // the start function has run. Take it after linking, m3_RunStart & any init exports. Shared memories aren't supported.
+    M3Result            m3_SnapshotRuntime          (IM3Runtime             i_runtime,
+                                                     IM3Snapshot *          o_snapshot);
+
+    // The runtime must hold the same modules, loaded in the same order, as the one the snapshot was taken of. The
+    // memory is remapped copy-on-write from the snapshot rather than copied, so restoring costs a few system calls
+    // and each page is only copied if it's written again. Host state (e.g. WASI file descriptors) isn't restored.
+    // If it fails after the memory was remapped, the runtime's state is undefined.
+    M3Result            m3_RestoreRuntime           (IM3Runtime             io_runtime,
+                                                     IM3Snapshot            i_snapshot);
+
+    void                m3_FreeSnapshot             (IM3Snapshot            i_snapshot);
+
+    // Makes the current contents of the linear memory the ones m3_ResetMemory returns to. The memory is then mapped
+    // copy-on-write from a copy of itself, so that the pages written since can be told apart. m3_RestoreRuntime
+    // discards the checkpoint.
+    M3Result            m3_CheckpointMemory         (IM3Runtime             io_runtime);
+
+    // Puts back just the pages written since the checkpoint (on Linux; elsewhere all of them are remapped) and gives
+    // up the pages the memory grew into. Globals and tables aren't affected.
+    M3Result            m3_ResetMemory              (IM3Runtime             io_runtime);
+
+//-------------------------------------------------------------------------------------------------------------------------------
+//  pre-initialization: bake the state that initialization leaves behind into a new module
+//-------------------------------------------------------------------------------------------------------------------------------
+
+    // Runs the module's start function (unless it has run) and then i_initFunction (an export without arguments; may
+    // be NULL), and writes out the module as they left it: its data segments hold the linear memory, its globals are
+    // initialized to their current values and it has no start function, so that instantiating it, in any engine,
+    // skips the initialization. The module has to define its memory, unshared. Free the bytes with
+    // m3_FreePreinitializedModule.
+    M3Result            m3_PreinitializeModule      (IM3Module              io_module,
+                                                     const char *           i_initFunction,
+                                                     uint8_t **             o_wasmBytes,
+                                                     uint32_t *             o_numWasmBytes);
+
+    void                m3_FreePreinitializedModule (uint8_t *              i_wasmBytes);
+
+//-------------------------------------------------------------------------------------------------------------------------------
+//  suspension: park a call mid-execution and continue it later, so that many runtimes can share a few threads
+//-------------------------------------------------------------------------------------------------------------------------------
+
+    // From now on the runtime's calls run on a native stack of its own (0 picks d_m3FiberStackSize), so that they can
+    // be suspended. A call that suspends returns m3Err_suspended; other calls on the runtime then fail with
+    // m3Err_runtimeSuspended until it's been resumed to completion or cancelled. Freeing the runtime abandons it.
+    M3Result            m3_EnableSuspension         (IM3Runtime             io_runtime,
+                                                     uint32_t               i_nativeStackSize);
+
+    // Called from a host function (or an m3_Yield override, with a NULL runtime) of a suspendable call. Returns once
+    // the call is resumed, with m3Err_none, or cancelled, with m3Err_trapSuspendedCallCancelled, which the host
+    // function should return so that the guest unwinds.
+    M3Result            m3_Suspend                  (IM3Runtime             i_runtime);
+
+    // Continues the suspended call, on any thread (with d_m3UseGuardPages, the thread it was suspended on). Returns
+    // like the m3_Call that started it: m3Err_none (see m3_GetResults), a trap or m3Err_suspended again.
+    M3Result            m3_Resume                   (IM3Runtime             io_runtime);
+
+    // Resumes the call with m3_Suspend returning m3Err_trapSuspendedCallCancelled.
+    M3Result            m3_CancelSuspended          (IM3Runtime             io_runtime);
+
 //-------------------------------------------------------------------------------------------------------------------------------
 //  globals
 //-------------------------------------------------------------------------------------------------------------------------------
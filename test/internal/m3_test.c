@@ -6,13 +6,16 @@
 //
 
 #include <stdio.h>
+#include <math.h>
 
-#include "wasm3_ext.h"
 #include "m3_bind.h"
 
 #define Test(NAME) if (RunTest (argc, argv, #NAME) != 0)
 #define DisabledTest(NAME) printf ("\ndisabled: %s\n", #NAME); if (false)
-#define expect(TEST) if (not (TEST)) { printf ("failed: (%s) on line: %d\n", #TEST, __LINE__); }
+#define expect(TEST) if (not (TEST)) { printf ("failed: (%s) on line: %d\n", #TEST, __LINE__); ++s_numFailures; }
+
+
+static u32 s_numFailures = 0;
 
 
 bool RunTest (int i_argc, const char * i_argv [], cstr_t i_name)
@@ -28,6 +31,511 @@ bool RunTest (int i_argc, const char * i_argv [], cstr_t i_name)
 }
 
 
+# if d_m3UseGuardPages
+
+#include <signal.h>
+#include <setjmp.h>
+#include <sys/mman.h>
+
+static sigjmp_buf   s_probeJump;
+static void *       s_probePage = NULL;
+
+static void  HandleProbeFault  (int i_signal, siginfo_t * i_info, void * i_context)
+{
+    if (i_info->si_addr == s_probePage)
+        siglongjmp (s_probeJump, 1);
+
+    signal (i_signal, SIG_DFL);
+}
+
+# endif
+
+
+// the feature tests load their modules from test/regression (so run this from test/); each .wasm is built from the
+// .wat beside it. the bytes have to outlive the module, so they're kept until the end of main
+static u8 *     s_wasm [64];
+static u32      s_numWasm = 0;
+
+u8 *  ReadTestModule  (cstr_t i_name, u32 * o_size)
+{
+    char path [256];
+    snprintf (path, sizeof (path), "regression/%s.wasm", i_name);
+
+    FILE * file = fopen (path, "rb");
+    if (not file or s_numWasm >= 64)
+    {
+        if (file) fclose (file);
+        return NULL;
+    }
+
+    fseek (file, 0, SEEK_END);
+    u32 size = (u32) ftell (file);
+    fseek (file, 0, SEEK_SET);
+
+    u8 * wasm = (u8 *) malloc (size);
+    size_t numRead = fread (wasm, 1, size, file);
+    fclose (file);
+
+    s_wasm [s_numWasm++] = wasm;
+    * o_size = size;
+
+    return (numRead == size) ? wasm : NULL;
+}
+
+
+# if d_m3DispatchLoop and d_m3HasThreads
+
+u8 *  WriteLEB  (u8 * o_bytes, u32 i_value)
+{
+    do
+    {
+        u8 byte = i_value & 0x7f;
+        i_value >>= 7;
+        * o_bytes++ = byte | (i_value ? 0x80 : 0);
+    }
+    while (i_value);
+
+    return o_bytes;
+}
+
+
+// a module exporting "run" (x): a body of i_numAdds x = x + 1 in a row, then returns x
+u8 *  NewStraightLineModule  (u32 i_numAdds, u32 * o_size)
+{
+    const u8 add [] = { 0x20, 0x00, 0x41, 0x01, 0x6a, 0x21, 0x00 };         // local.get 0, i32.const 1, i32.add, local.set 0
+    const u8 ret [] = { 0x20, 0x00, 0x0b };                                 // local.get 0, end
+
+    u32 bodySize = 1 + i_numAdds * sizeof (add) + sizeof (ret);
+
+    u8 * wasm = (u8 *) malloc (bodySize + 64);
+    if (not wasm)
+        return NULL;
+
+    const u8 header [] =
+    {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,                     // type: (i32) -> i32
+        0x03, 0x02, 0x01, 0x00,                                             // function
+        0x07, 0x07, 0x01, 0x03, 'r', 'u', 'n', 0x00, 0x00                   // export "run"
+    };
+
+    u8 * bytes = wasm;
+    memcpy (bytes, header, sizeof (header));
+    bytes += sizeof (header);
+
+    // code section: one body, with no locals besides x
+    u8 bodySizeLEB [5];
+    u32 sectionSize = 1 + (u32) (WriteLEB (bodySizeLEB, bodySize) - bodySizeLEB) + bodySize;
+
+    * bytes++ = 0x0a;
+    bytes = WriteLEB (bytes, sectionSize);
+    * bytes++ = 0x01;
+    bytes = WriteLEB (bytes, bodySize);
+    * bytes++ = 0x00;
+
+    for (u32 i = 0; i < i_numAdds; ++i)
+    {
+        memcpy (bytes, add, sizeof (add));
+        bytes += sizeof (add);
+    }
+
+    memcpy (bytes, ret, sizeof (ret));
+    bytes += sizeof (ret);
+
+    * o_size = (u32) (bytes - wasm);
+
+    return wasm;
+}
+
+# endif
+
+
+M3Result  LoadTestModule  (IM3Runtime i_runtime, IM3Module * o_module, cstr_t i_name)
+{
+    u32 size = 0;
+    u8 * wasm = ReadTestModule (i_name, & size);
+    if (not wasm)
+        return "couldn't read test module";
+
+    IM3Module module = NULL;
+    M3Result result = m3_ParseModule (i_runtime->environment, & module, wasm, size);
+
+    if (not result)
+    {
+        result = m3_LoadModule (i_runtime, module);
+
+        if (result)
+            m3_FreeModule (module);
+        else if (o_module)
+            * o_module = module;
+    }
+
+    return result;
+}
+
+
+# if !defined(_WIN32)
+
+#include <dirent.h>
+#include <unistd.h>
+
+// the code cache files are named after hashes of the build & module, so these just go over the directory
+u32  ForEachCacheFile  (cstr_t i_directory, void (* i_function) (cstr_t i_path))
+{
+    u32 count = 0;
+
+    DIR * dir = opendir (i_directory);
+    struct dirent * entry;
+
+    while (dir and (entry = readdir (dir)))
+    {
+        if (entry->d_name [0] == '.')
+            continue;
+
+        char path [512];
+        snprintf (path, sizeof (path), "%s/%s", i_directory, entry->d_name);
+
+        if (i_function)
+            i_function (path);
+
+        ++count;
+    }
+
+    if (dir)
+        closedir (dir);
+
+    return count;
+}
+
+
+void  CorruptCacheFile  (cstr_t i_path)
+{
+    FILE * file = fopen (i_path, "r+b");
+    if (file)
+    {
+        fseek (file, 64, SEEK_SET);
+        for (u32 i = 0; i < 256; ++i)
+            fputc (0xa5, file);
+
+        fclose (file);
+    }
+}
+
+
+void  RemoveCacheFile  (cstr_t i_path)
+{
+    remove (i_path);
+}
+
+#define CountCacheFiles(DIRECTORY)          ForEachCacheFile (DIRECTORY, NULL)
+#define CorruptCacheFiles(DIRECTORY)        ForEachCacheFile (DIRECTORY, CorruptCacheFile)
+#define RemoveCacheFiles(DIRECTORY)         (ForEachCacheFile (DIRECTORY, RemoveCacheFile), rmdir (DIRECTORY))
+
+# endif
+
+
+m3ApiRawFunction (AddI32)
+{
+    m3ApiReturnType (i32)
+    m3ApiGetArg     (i32, a)
+    m3ApiGetArg     (i32, b)
+
+    m3ApiReturn (a + b);
+}
+
+
+m3ApiRawFunction (SwapV128)
+{
+    m3ApiReturnType (i32)
+
+    u64 * swapped = _sp;
+    _sp += 2;
+    u64 low = _sp [0], high = _sp [1];
+
+    swapped [0] = high;
+    swapped [1] = low;
+
+    m3ApiReturn ((i32) (low + high));
+}
+
+
+m3ApiRawFunction (Pause)
+{
+    m3ApiReturnType (i32)
+    m3ApiGetArg     (i32, value)
+
+    M3Result result = m3_Suspend (runtime);
+    if (result)
+        return result;
+
+    m3ApiReturn (value * 2);
+}
+
+
+m3ApiRawFunction (Interrupt)
+{
+    m3_InterruptRuntime (runtime);
+
+    m3ApiSuccess ();
+}
+
+
+# if d_m3HasPthreads
+#include <pthread.h>
+# endif
+
+
+# if d_m3HasSuspend and d_m3HasPthreads
+
+void *  ResumeThread  (void * i_runtime)
+{
+    return (void *) m3_Resume ((IM3Runtime) i_runtime);
+}
+
+# endif
+
+
+// calls an export taking & returning (at most one) i32
+M3Result  CallTest  (IM3Runtime i_runtime, cstr_t i_name, u32 i_numArgs, const i32 * i_args, i32 * o_result)
+{
+    IM3Function function = NULL;
+    M3Result result = m3_FindFunction (& function, i_runtime, i_name);
+
+    if (not result)
+    {
+        const void * args [8];
+        for (u32 i = 0; i < i_numArgs and i < 8; ++i)
+            args [i] = & i_args [i];
+
+        result = m3_Call (function, i_numArgs, args);
+
+        if (not result and o_result)
+        {
+            const void * ret [1] = { o_result };
+            result = m3_GetResults (function, 1, ret);
+        }
+    }
+
+    return result;
+}
+
+
+// what result-target.wasm's "<name>" (a, b) returns
+i32  ExpectedTargetResult  (cstr_t i_name, i32 a, i32 b)
+{
+    u32 ua = (u32) a, ub = (u32) b;
+
+    if (not strcmp (i_name, "spill"))     return (i32) ((ua + ub) * (ua - ub) + ((ua ^ ub) - (ua & ub)));
+    if (not strcmp (i_name, "spill64"))
+    {
+        u64 x = (u64) (i64) a, y = (u64) (i64) b * 0x100000001ULL;
+        u64 r = (x + y) * (x - y) + ((x ^ y) - (x & y));
+        return (i32) ((u32) r ^ (u32) (r >> 32));
+    }
+    if (not strcmp (i_name, "spill_f64"))
+    {
+        f64 r = ((f64) a + (f64) b) * ((f64) a - (f64) b);
+        return (i32) M3_MAX (-1e9, M3_MIN (1e9, r));
+    }
+    if (not strcmp (i_name, "block"))     return (i32) ((ua + ub) - (a ? ua * ub : 7));
+    if (not strcmp (i_name, "if"))        return (i32) ((a < b ? ua - ub : ua * ub) + (ub << 3));
+    if (not strcmp (i_name, "loop"))      return (i32) (ua * M3_MAX (1, ub & 7));
+    if (not strcmp (i_name, "return"))    return (i32) (a ? (ua + ub) * ua : ub * ub);
+    if (not strcmp (i_name, "call"))      return (i32) (100 * (ua + ub) + 10 * (ua * ub) + (ua - ub));
+    if (not strcmp (i_name, "select"))    return (i32) ((u32) M3_MAX (a, b) - 10 * (u32) M3_MIN (a, b));
+    if (not strcmp (i_name, "loads"))     return (i32) ((u32) (i8) a * ((u32) (i16) a + (ua >> 16)) + ((ua >> 8) & 0xff));
+
+    return 0;
+}
+
+
+// like CallTest, for functions that take & return i32s or i64s. i32 arguments are truncated; an i32 result is
+// sign-extended
+M3Result  CallTest64  (IM3Runtime i_runtime, cstr_t i_name, u32 i_numArgs, const i64 * i_args, i64 * o_result)
+{
+    IM3Function function = NULL;
+    M3Result result = m3_FindFunction (& function, i_runtime, i_name);
+
+    if (not result)
+    {
+        i32 narrowArgs [8];
+        const void * args [8];
+        for (u32 i = 0; i < i_numArgs and i < 8; ++i)
+        {
+            narrowArgs [i] = (i32) i_args [i];
+            args [i] = (m3_GetArgType (function, i) == c_m3Type_i64) ? (const void *) & i_args [i] : & narrowArgs [i];
+        }
+
+        result = m3_Call (function, i_numArgs, args);
+
+        if (not result)
+        {
+            i32 narrowResult = 0;
+            bool isWide = (m3_GetRetType (function, 0) == c_m3Type_i64);
+
+            const void * ret [1] = { isWide ? (const void *) o_result : & narrowResult };
+            result = m3_GetResults (function, 1, ret);
+
+            if (not isWide)
+                * o_result = narrowResult;
+        }
+    }
+
+    return result;
+}
+
+
+// the outcome compare-branch.wasm expects for "<type>.<comparison>"; b = 999 is NaN for the float types
+bool  ExpectedComparison  (cstr_t i_name, i32 a, i32 b)
+{
+    char type = i_name [0];
+    cstr_t comparison = i_name + 4;
+
+    if (type == 'f')
+    {
+        f64 x = a, y = (b == 999) ? NAN : b;
+
+        if (not strcmp (comparison, "eq")) return x == y;
+        if (not strcmp (comparison, "ne")) return x != y;
+        if (not strcmp (comparison, "lt")) return x < y;
+        if (not strcmp (comparison, "gt")) return x > y;
+        if (not strcmp (comparison, "le")) return x <= y;
+        if (not strcmp (comparison, "ge")) return x >= y;
+    }
+    else
+    {
+        // the i64 operands are sign-extended, so the unsigned comparisons see 64-bit values
+        i64 x = a, y = b;
+        u64 ux = (type == '6' or i_name [1] == '6') ? (u64) x : (u32) a;
+        u64 uy = (type == '6' or i_name [1] == '6') ? (u64) y : (u32) b;
+
+        if (not strcmp (comparison, "eqz"))  return x == 0;
+        if (not strcmp (comparison, "eq"))   return x == y;
+        if (not strcmp (comparison, "ne"))   return x != y;
+        if (not strcmp (comparison, "lt_s")) return x < y;
+        if (not strcmp (comparison, "gt_s")) return x > y;
+        if (not strcmp (comparison, "le_s")) return x <= y;
+        if (not strcmp (comparison, "ge_s")) return x >= y;
+        if (not strcmp (comparison, "lt_u")) return ux < uy;
+        if (not strcmp (comparison, "gt_u")) return ux > uy;
+        if (not strcmp (comparison, "le_u")) return ux <= uy;
+        if (not strcmp (comparison, "ge_u")) return ux >= uy;
+    }
+
+    return false;
+}
+
+
+# if d_m3HasThreads
+
+typedef struct TestCall
+{
+    IM3Runtime      runtime;
+    cstr_t          name;
+    u32             numArgs;
+    i32             args [3];
+    i32             ret;
+    M3Result        result;
+}
+TestCall;
+
+void *  CallTestThread  (void * i_call)
+{
+    TestCall * call = (TestCall *) i_call;
+    call->result = CallTest (call->runtime, call->name, call->numArgs, call->args, & call->ret);
+
+    return NULL;
+}
+
+# endif
+
+
+# if d_m3HasPthreads
+
+// parses, loads & runs template.wasm in a runtime of its own, over & over; all of its runtimes share one environment.
+// with a module template, each runtime holds an instance of it instead
+typedef struct TestLoad
+{
+    IM3Environment      environment;
+    const u8 *          wasm;
+    u32                 size;
+    IM3ModuleTemplate   moduleTemplate;
+    M3Result            result;
+}
+TestLoad;
+
+void *  LoadTestThread  (void * i_load)
+{
+    TestLoad * load = (TestLoad *) i_load;
+
+    for (u32 i = 0; i < 50 and not load->result; ++i)
+    {
+        IM3Runtime runtime = m3_NewRuntime (load->environment, 8 * 1024, NULL);
+        IM3Module module = NULL;
+        M3Result result;
+
+        if (load->moduleTemplate)
+            result = m3_InstantiateTemplate (runtime, load->moduleTemplate, & module);
+        else
+        {
+            result = m3_ParseModule (load->environment, & module, load->wasm, load->size);
+            if (not result)
+            {
+                result = m3_LoadModule (runtime, module);
+                if (result)
+                    m3_FreeModule (module);
+            }
+        }
+
+        // each function is compiled as it's first called
+        i32 ret = 0;
+        if (not result)
+            result = CallTest (runtime, "inc", 0, NULL, & ret);
+        if (not result)
+            result = CallTest (runtime, "inc_indirect", 0, NULL, & ret);
+        if (not result and ret != 12)
+            result = "inc_indirect returned the wrong count";
+        if (not result)
+            result = CallTest (runtime, "load", 0, NULL, & ret);
+        if (not result and ret != 7)
+            result = "the data segment wasn't loaded";
+
+        i32 arg = 5;
+        if (not result)
+            result = CallTest (runtime, "call_later", 1, & arg, & ret);
+        if (not result and ret != 105)
+            result = "call_later returned the wrong sum";
+
+        m3_FreeRuntime (runtime);
+        load->result = result;
+    }
+
+    return NULL;
+}
+
+
+// a checksum of the code in a runtime's pages
+u64  HashCodePages  (IM3Runtime i_runtime)
+{
+    u64 hash = 14695981039346656037ULL;
+    IM3CodePage lists [2] = { i_runtime->pagesOpen, i_runtime->pagesFull };
+
+    for (u32 l = 0; l < 2; ++l)
+    {
+        for (IM3CodePage page = lists [l]; page; page = page->info.next)
+        {
+            const u8 * bytes = (const u8 *) page->code;
+            for (size_t i = 0; i < page->info.lineIndex * sizeof (code_t); ++i)
+                hash = (hash ^ bytes [i]) * 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+# endif
+
+
 int  main  (int argc, const char  * argv [])
 {
     Test (signatures)
@@ -138,6 +646,8 @@ int  main  (int argc, const char  * argv [])
     }
      
      
+    // m3_NewModule, m3_InjectFunction & m3_GetFunctionByIndex are no longer part of the api
+# if 0
     Test (extensions)
     {
         M3Result result;
@@ -177,7 +687,114 @@ int  main  (int argc, const char  * argv [])
         
         m3_FreeRuntime (runtime);
     }
+# endif
     
+    Test (compilations.pool)
+    {
+        IM3Environment env = m3_NewEnvironment ();
+
+        IM3Compilation a = Environment_AcquireCompilation (env);                        expect (a)
+        IM3Compilation b = Environment_AcquireCompilation (env);                        expect (b and b != a)
+
+        a->stackIndex = 12;
+        Environment_ReleaseCompilation (env, a);                                        expect (env->compilationsReleased == a)
+
+        // reused, zeroed
+        IM3Compilation c = Environment_AcquireCompilation (env);                        expect (c == a)
+                                                                                        expect (c->stackIndex == 0)
+                                                                                        expect (env->compilationsReleased == NULL)
+        Environment_ReleaseCompilation (env, c);
+        Environment_ReleaseCompilation (env, b);                                        expect (env->compilationsReleased == b)
+
+        m3_FreeEnvironment (env);
+    }
+
+
+    // this has to be the first test to load a module (which reserves a memory): the runtime's fault handler is then
+    // installed on top of HandleProbeFault and has to pass it the faults that aren't wasm accesses
+    Test (memory.guard)
+    {
+        M3Result result;
+
+# if d_m3UseGuardPages
+        struct sigaction action;
+        memset (& action, 0, sizeof (action));
+        action.sa_sigaction = HandleProbeFault;
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset (& action.sa_mask);
+        sigaction (SIGSEGV, & action, NULL);
+
+        s_probePage = mmap (NULL, 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+# endif
+
+        IM3Environment env = m3_NewEnvironment ();
+        IM3Runtime runtime = m3_NewRuntime (env, 64 * 1024, NULL);
+
+        result = LoadTestModule (runtime, NULL, "memory-guard");                       expect (result == m3Err_none)
+
+        i32 ret = 0;
+        i32 address = 65532;
+        result = CallTest (runtime, "load", 1, & address, & ret);                       expect (result == m3Err_none)
+                                                                                        expect (ret == 42)
+        address = 65533;
+        result = CallTest (runtime, "load", 1, & address, & ret);                       expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+        address = -1;
+        result = CallTest (runtime, "load_far", 1, & address, & ret);                   expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+        address = 65536;
+        result = CallTest (runtime, "store", 1, & address, NULL);                       expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+
+        result = CallTest (runtime, "grow", 0, NULL, & ret);                            expect (result == m3Err_none)
+                                                                                        expect (ret == 1)
+        result = CallTest (runtime, "store", 1, & address, NULL);                       expect (result == m3Err_none)
+        result = CallTest (runtime, "load", 1, & address, & ret);                       expect (result == m3Err_none)
+                                                                                        expect (ret == 7)
+        address = 2 * 65536;
+        result = CallTest (runtime, "load", 1, & address, & ret);                       expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+
+# if d_m3UseGuardPages
+        // a fault elsewhere goes to the handler that was there before; the runtime's handler stays installed
+        volatile bool recovered = false;
+
+        if (sigsetjmp (s_probeJump, 1) == 0)
+            * (volatile u8 *) s_probePage = 1;
+        else
+            recovered = true;
+                                                                                        expect (recovered)
+        result = CallTest (runtime, "load", 1, & address, & ret);                       expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+
+        munmap (s_probePage, 4096);
+# endif
+
+        m3_FreeRuntime (runtime);
+
+        // a memory limit that isn't a multiple of the host page size: the memory's length is the limit, but with guard
+        // pages, an access only faults past the next host page boundary
+        runtime = m3_NewRuntime (env, 64 * 1024, NULL);
+        runtime->memoryLimit = 65536 + 100;
+
+        result = LoadTestModule (runtime, NULL, "memory-guard");                       expect (result == m3Err_none)
+        result = CallTest (runtime, "grow", 0, NULL, & ret);                            expect (result == m3Err_none and ret == 1)
+        result = CallTest (runtime, "size", 0, NULL, & ret);                            expect (result == m3Err_none and ret == 2)
+
+        u32 length = 0;
+        m3_GetMemory (runtime, & length, 0);                                            expect (length == 65536 + 100)
+
+        address = 65536 + 96;
+        result = CallTest (runtime, "store", 1, & address, NULL);                       expect (result == m3Err_none)
+        result = CallTest (runtime, "load", 1, & address, & ret);                       expect (result == m3Err_none and ret == 7)
+        address = 65536 + 97;
+        result = CallTest (runtime, "load", 1, & address, & ret);
+# if d_m3UseGuardPages
+                                                                                        expect (result == m3Err_none)
+        address = 65536 + (i32) sysconf (_SC_PAGESIZE);
+        result = CallTest (runtime, "load", 1, & address, & ret);
+# endif
+                                                                                        expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+        m3_FreeRuntime (runtime);
+        m3_FreeEnvironment (env);
+    }
+
+
 	IM3Environment env = m3_NewEnvironment ();
 
 
@@ -257,6 +874,1318 @@ int  main  (int argc, const char  * argv [])
 			)
 #			endif
 	}
-    
-    return 0;
+
+
+    Test (tailcall)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 16 * 1024, NULL);
+
+        IM3Module module = NULL;
+        result = LoadTestModule (runtime, & module, "tail-call");                       expect (result == m3Err_none)
+        result = m3_LinkRawFunction (module, "env", "add", "i(ii)", & AddI32);          expect (result == m3Err_none)
+
+        // each tail call enters the callee past its op_Entry & function pointer, which take three lines in
+        // compact code (see the gcc-compact-code CI build)
+        i32 ret = 0;
+        i32 args [2] = { 10, 5 };
+        result = CallTest (runtime, "count", 2, args, & ret);                           expect (result == m3Err_none)
+                                                                                        expect (ret == 15)
+        // more calls than the stack has room for frames
+        args [0] = 5000; args [1] = 0;
+        result = CallTest (runtime, "count", 2, args, & ret);                           expect (result == m3Err_none)
+                                                                                        expect (ret == 5000)
+        result = CallTest (runtime, "count_indirect", 2, args, & ret);                  expect (result == m3Err_none)
+                                                                                        expect (ret == 5000)
+        args [0] = 5001;
+        result = CallTest (runtime, "is_even", 1, args, & ret);                         expect (result == m3Err_none)
+                                                                                        expect (ret == 0)
+        args [0] = 20; args [1] = 22;
+        result = CallTest (runtime, "call_host", 2, args, & ret);                       expect (result == m3Err_none)
+                                                                                        expect (ret == 42)
+        result = CallTest (runtime, "call_missing", 2, args, & ret);                    expect (result == m3Err_functionImportMissing)
+
+        m3_FreeRuntime (runtime);
+    }
+
+    Test (compilations.shared)
+    {
+        M3Result result;
+
+        // runtimes compile with the environment's contexts; compiling doesn't nest, so one is enough for all of them
+        IM3Environment env = m3_NewEnvironment ();
+
+        for (u32 i = 0; i < 2; ++i)
+        {
+            IM3Runtime runtime = m3_NewRuntime (env, 16 * 1024, NULL);
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtime, & module, "tail-call");                   expect (result == m3Err_none)
+            result = m3_LinkRawFunction (module, "env", "add", "i(ii)", & AddI32);      expect (result == m3Err_none)
+
+            i32 ret = 0;
+            i32 args [2] = { 10, 5 };
+            result = CallTest (runtime, "count_indirect", 2, args, & ret);              expect (result == m3Err_none)
+                                                                                        expect (ret == 15)
+            m3_FreeRuntime (runtime);
+        }
+
+        u32 numCompilations = 0;
+        for (IM3Compilation c = env->compilationsReleased; c; c = c->next)
+            ++numCompilations;
+                                                                                        expect (numCompilations == 1)
+        m3_FreeEnvironment (env);
+    }
+
+
+# if d_m3HasPthreads
+    Test (compilations.threads)
+    {
+        // runtimes of one environment, on threads of their own: parsing, init expressions & lazy compilation all take
+        // from the environment's pools at once
+        IM3Environment env = m3_NewEnvironment ();
+
+        u32 size = 0;
+        u8 * wasm = ReadTestModule ("template", & size);                                expect (wasm)
+
+        pthread_t threads [4];
+        TestLoad loads [4];
+
+        for (u32 i = 0; i < 4; ++i)
+        {
+            loads [i] = (TestLoad) { env, wasm, size, NULL, m3Err_none };
+            pthread_create (& threads [i], NULL, LoadTestThread, & loads [i]);
+        }
+
+        for (u32 i = 0; i < 4; ++i)
+        {
+            pthread_join (threads [i], NULL);                                           expect (loads [i].result == m3Err_none)
+        }
+
+        u32 numCompilations = 0;
+        for (IM3Compilation c = env->compilationsReleased; c; c = c->next)
+            ++numCompilations;
+                                                                                        expect (numCompilations >= 1 and numCompilations <= 4)
+        m3_FreeEnvironment (env);
+    }
+# endif
+
+
+    Test (compile.parallel)
+    {
+        M3Result result;
+
+        u32 numThreads [2] = { 4, 0 };              // 0: one per core
+
+        for (u32 t = 0; t < 2; ++t)
+        {
+            IM3Runtime runtime = m3_NewRuntime (env, 16 * 1024, NULL);
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtime, & module, "compile-parallel");            expect (result == m3Err_none)
+            result = m3_CompileModuleParallel (module, numThreads [t]);                 expect (result == m3Err_none)
+
+            u32 numCompiled = 0;
+            for (u32 i = 0; i < module->numFunctions; ++i)
+                numCompiled += (module->functions [i].compiled != NULL);
+                                                                                        expect (numCompiled == module->numFunctions)
+            i32 ret = 0;
+            i32 arg = 2;
+            result = CallTest (runtime, "sum", 1, & arg, & ret);                        expect (result == m3Err_none)
+                                                                                        expect (ret == 408)
+            m3_FreeRuntime (runtime);
+        }
+    }
+
+
+    Test (codecache)
+    {
+# if !defined(_WIN32)
+        M3Result result;
+
+        char directory [] = "/tmp/m3_test_XXXXXX";
+        expect (mkdtemp (directory))
+
+        IM3Environment env = m3_NewEnvironment ();
+        result = m3_SetCodeCacheDirectory (env, directory);                             expect (result == m3Err_none)
+
+        // the first compile writes the cache, the second restores from it; a damaged file is compiled over
+        for (u32 pass = 0; pass < 3; ++pass)
+        {
+            if (pass == 2)
+                CorruptCacheFiles (directory);
+
+            IM3Runtime runtime = m3_NewRuntime (env, 16 * 1024, NULL);
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtime, & module, "tail-call");                   expect (result == m3Err_none)
+            result = m3_LinkRawFunction (module, "env", "add", "i(ii)", & AddI32);      expect (result == m3Err_none)
+            result = m3_CompileModule (module);                                         expect (result == m3Err_none)
+                                                                                        expect (CountCacheFiles (directory) == 1)
+            i32 ret = 0;
+            i32 args [2] = { 5000, 0 };
+            result = CallTest (runtime, "count_indirect", 2, args, & ret);              expect (result == m3Err_none)
+                                                                                        expect (ret == 5000)
+            args [0] = 20; args [1] = 22;
+            result = CallTest (runtime, "call_host", 2, args, & ret);                   expect (result == m3Err_none)
+                                                                                        expect (ret == 42)
+            m3_FreeRuntime (runtime);
+        }
+
+        RemoveCacheFiles (directory);
+        m3_FreeEnvironment (env);
+# endif
+    }
+
+
+    Test (templates)
+    {
+        M3Result result;
+
+        u32 size = 0;
+        u8 * wasm = ReadTestModule ("template", & size);                                expect (wasm)
+
+        IM3ModuleTemplate moduleTemplate = NULL;
+        result = m3_NewModuleTemplate (env, & moduleTemplate, wasm, size);              expect (result == m3Err_none)
+
+        IM3Runtime runtimes [2];
+        IM3Module modules [2];
+
+        for (u32 i = 0; i < 2; ++i)
+        {
+            runtimes [i] = m3_NewRuntime (env, 8 * 1024, NULL);
+            result = m3_InstantiateTemplate (runtimes [i], moduleTemplate, & modules [i]);   expect (result == m3Err_none)
+        }
+
+        IM3Module other = NULL;
+        result = m3_InstantiateTemplate (runtimes [0], moduleTemplate, & other);        expect (result != m3Err_none)
+
+        i32 ret = 0;
+        for (u32 i = 0; i < 3; ++i)
+        {
+            result = CallTest (runtimes [0], "inc", 0, NULL, & ret);                    expect (result == m3Err_none)
+        }
+                                                                                        expect (ret == 13)
+        result = CallTest (runtimes [1], "inc", 0, NULL, & ret);                        expect (result == m3Err_none)
+                                                                                        expect (ret == 11)
+        result = CallTest (runtimes [1], "inc_indirect", 0, NULL, & ret);               expect (result == m3Err_none)
+                                                                                        expect (ret == 12)
+        i32 value = 99;
+        result = CallTest (runtimes [1], "store", 1, & value, NULL);                    expect (result == m3Err_none)
+        result = CallTest (runtimes [1], "load", 0, NULL, & ret);                       expect (ret == 99)
+        result = CallTest (runtimes [0], "load", 0, NULL, & ret);                       expect (ret == 7)
+
+        // both run the template's code
+        IM3Function function = NULL;
+        m3_FindFunction (& function, runtimes [1], "inc");                              expect (function)
+        if (function)
+        {
+                                                                                        expect (function->compiled)
+                                                                                        expect (function->compiled == m3_GetTemplateModule (moduleTemplate)->functions [0].compiled)
+        }
+
+        for (u32 i = 0; i < 2; ++i)
+            m3_FreeRuntime (runtimes [i]);
+
+        m3_FreeModuleTemplate (moduleTemplate);
+    }
+
+
+# if d_m3HasPthreads
+    Test (templates.threads)
+    {
+        M3Result result;
+
+        u32 size = 0;
+        u8 * wasm = ReadTestModule ("template", & size);                                expect (wasm)
+
+        IM3ModuleTemplate moduleTemplate = NULL;
+        result = m3_NewModuleTemplate (env, & moduleTemplate, wasm, size);              expect (result == m3Err_none)
+
+        // compiled up front, the template's code is only read by the instances: its calls are already linked
+        result = m3_CompileModule (m3_GetTemplateModule (moduleTemplate));              expect (result == m3Err_none)
+        IM3Runtime templateRuntime = m3_GetTemplateModule (moduleTemplate)->runtime;
+        u64 hash = HashCodePages (templateRuntime);
+
+        pthread_t threads [4];
+        TestLoad loads [4];
+
+        for (u32 i = 0; i < 4; ++i)
+        {
+            loads [i] = (TestLoad) { env, NULL, 0, moduleTemplate, m3Err_none };
+            pthread_create (& threads [i], NULL, LoadTestThread, & loads [i]);
+        }
+
+        for (u32 i = 0; i < 4; ++i)
+        {
+            pthread_join (threads [i], NULL);                                           expect (loads [i].result == m3Err_none)
+        }
+                                                                                        expect (HashCodePages (templateRuntime) == hash)
+        m3_FreeModuleTemplate (moduleTemplate);
+    }
+# endif
+
+
+    Test (simd)
+    {
+# if d_m3HasSIMD
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+
+        IM3Module module = NULL;
+        result = LoadTestModule (runtime, & module, "simd");                            expect (result == m3Err_none)
+        result = m3_LinkRawFunction (module, "env", "swap", NULL, & SwapV128);          expect (result == m3Err_none)
+
+        struct { cstr_t name; u32 numArgs; i32 args [2]; i32 expected; } calls [] =
+        {
+            { "mul",        2, { 3, -5 },       -60 },
+            { "add_sat",    2, { 100, 100 },    127 },
+            { "add_sat",    2, { -100, -100 },  -128 },
+            { "shuffle",    0, { 0 },           0x011e001f },
+            { "memory",     1, { 2 },           6 },
+            { "memory",     1, { 3 },           8 },
+            { "bitmask",    1, { 1 },           0xc },
+            { "bitmask",    1, { -1 },          0xf },
+            { "sqrt",       1, { 49 },          7 },
+            { "select",     1, { 1 },           2 },
+            { "select",     1, { 0 },           6 },
+            { "call_twice", 1, { 21 },          42 },
+        };
+
+        for (u32 i = 0; i < sizeof (calls) / sizeof (calls [0]); ++i)
+        {
+            i32 ret = 0;
+            result = CallTest (runtime, calls [i].name, calls [i].numArgs, calls [i].args, & ret);  expect (result == m3Err_none)
+                                                                                        expect (ret == calls [i].expected)
+        }
+
+        // v128 comes after c_m3Type_unknown, which keeps its value
+                                                                                        expect (c_m3Type_unknown == 5)
+        IM3Function function = NULL;
+        result = m3_FindFunction (& function, runtime, "tail_swap");                    expect (result == m3Err_none)
+        if (function)
+        {
+                                                                                        expect (m3_GetArgType (function, 0) == c_m3Type_v128)
+                                                                                        expect (m3_GetRetType (function, 1) == c_m3Type_v128)
+            u64 vector [2] = { 0x0123456789abcdefull, 0x1122334455667788ull };
+            const void * args [1] = { vector };
+            result = m3_Call (function, 1, args);                                       expect (result == m3Err_none)
+
+            i32 sum = 0;
+            u64 swapped [2] = { 0, 0 };
+            const void * rets [2] = { & sum, swapped };
+            result = m3_GetResults (function, 2, rets);                                 expect (result == m3Err_none)
+                                                                                        expect (sum == (i32) (vector [0] + vector [1]))
+                                                                                        expect (swapped [0] == vector [1] and swapped [1] == vector [0])
+        }
+
+        m3_FreeRuntime (runtime);
+# endif
+    }
+
+
+    Test (atomics)
+    {
+# if d_m3HasThreads
+        M3Result result;
+
+        // the second runtime works on the memory of the first
+        IM3Runtime runtimes [2];
+        for (u32 i = 0; i < 2; ++i)
+        {
+            runtimes [i] = m3_NewRuntime (env, 16 * 1024, NULL);
+
+            if (i == 1)
+            {
+                result = m3_ShareMemory (runtimes [1], runtimes [0]);                   expect (result == m3Err_none)
+            }
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtimes [i], & module, "atomics");                expect (result == m3Err_none)
+
+            // the environment's compilations aren't shared between threads, so compile before running concurrently
+            if (module)
+            {
+                result = m3_CompileModule (module);                                     expect (result == m3Err_none)
+            }
+        }
+
+        i32 ret = 0;
+        i32 args [3] = { 8, 5 };
+        result = CallTest (runtimes [0], "store", 2, args, NULL);                       expect (result == m3Err_none)
+        result = CallTest (runtimes [1], "load", 1, args, & ret);                       expect (ret == 5)
+
+        args [1] = 3;
+        result = CallTest (runtimes [1], "add", 2, args, & ret);                        expect (ret == 5)
+        result = CallTest (runtimes [0], "load", 1, args, & ret);                       expect (ret == 8)
+
+        args [0] = 9; args [1] = 255;
+        result = CallTest (runtimes [0], "add_byte", 2, args, & ret);                   expect (ret == 0)
+        args [0] = 8;
+        result = CallTest (runtimes [1], "load", 1, args, & ret);                       expect (ret == 0xff08)
+
+        args [1] = 0xff08; args [2] = 100;
+        result = CallTest (runtimes [0], "cmpxchg", 3, args, & ret);                    expect (ret == 0xff08)
+        args [2] = 7;
+        result = CallTest (runtimes [0], "cmpxchg", 3, args, & ret);                    expect (ret == 100)
+        result = CallTest (runtimes [1], "load", 1, args, & ret);                       expect (ret == 100)
+
+        args [0] = 16; args [1] = -1;
+        result = CallTest (runtimes [0], "add64", 2, args, & ret);                      expect (result == m3Err_none and ret == 0)
+        result = CallTest (runtimes [1], "load", 1, args, & ret);                       expect (ret == -1)
+
+        args [0] = 2;
+        result = CallTest (runtimes [0], "load", 1, args, & ret);                       expect (result == m3Err_trapUnalignedAtomic)
+        args [0] = 6; args [1] = 1;
+        result = CallTest (runtimes [0], "add", 2, args, & ret);                        expect (result == m3Err_trapUnalignedAtomic)
+        args [0] = 65536;
+        result = CallTest (runtimes [1], "load", 1, args, & ret);                       expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+
+        args [0] = 8; args [1] = 0; args [2] = 0;
+        result = CallTest (runtimes [0], "wait", 3, args, & ret);                       expect (result == m3Err_none and ret == 1)
+        args [1] = 100;
+        result = CallTest (runtimes [0], "wait", 3, args, & ret);                       expect (result == m3Err_none and ret == 2)
+        result = CallTest (runtimes [1], "notify", 1, args, & ret);                     expect (result == m3Err_none and ret == 0)
+
+        // growing shows in every runtime
+        result = CallTest (runtimes [0], "grow", 0, NULL, & ret);                       expect (ret == 1)
+        result = CallTest (runtimes [1], "size", 0, NULL, & ret);                       expect (ret == 2)
+        args [0] = 65536; args [1] = 42;
+        result = CallTest (runtimes [1], "store", 2, args, NULL);                       expect (result == m3Err_none)
+        result = CallTest (runtimes [0], "load", 1, args, & ret);                       expect (ret == 42)
+
+        // both runtimes counting at once
+        TestCall counts [2];
+        pthread_t threads [2];
+        for (u32 i = 0; i < 2; ++i)
+        {
+            counts [i] = (TestCall) { runtimes [i], "count", 2, { 32, 100000 } };
+            pthread_create (& threads [i], NULL, CallTestThread, & counts [i]);
+        }
+
+        for (u32 i = 0; i < 2; ++i)
+        {
+            pthread_join (threads [i], NULL);                                           expect (counts [i].result == m3Err_none)
+        }
+
+        args [0] = 32;
+        result = CallTest (runtimes [0], "load", 1, args, & ret);                       expect (ret == 200000)
+
+        // a waiter in one runtime is woken from the other (or gives up after 5 s)
+        TestCall wait = { runtimes [1], "wait", 3, { 40, 0, 5000 }, -1 };
+        pthread_create (& threads [0], NULL, CallTestThread, & wait);
+
+        i32 numWoken = 0;
+        args [0] = 40;
+        for (u32 i = 0; i < 5000 and numWoken == 0; ++i)
+        {
+            result = CallTest (runtimes [0], "notify", 1, args, & numWoken);            expect (result == m3Err_none)
+            if (not numWoken)
+                usleep (1000);
+        }
+
+        pthread_join (threads [0], NULL);                                               expect (wait.result == m3Err_none)
+                                                                                        expect (numWoken == 1 and wait.ret == 0)
+        for (u32 i = 0; i < 2; ++i)
+            m3_FreeRuntime (runtimes [i]);
+# endif
+    }
+
+
+    Test (snapshots)
+    {
+# if d_m3HasSnapshots
+        M3Result result;
+
+        IM3Runtime runtimes [3];
+        for (u32 i = 0; i < 3; ++i)
+            runtimes [i] = m3_NewRuntime (env, 8 * 1024, NULL);
+
+        result = LoadTestModule (runtimes [0], NULL, "state");                          expect (result == m3Err_none)
+        result = CallTest (runtimes [0], "init", 0, NULL, NULL);                        expect (result == m3Err_none)
+
+        IM3Snapshot snapshot = NULL;
+        result = m3_SnapshotRuntime (runtimes [0], & snapshot);                         expect (result == m3Err_none)
+
+        // the same state comes back each time, in the runtime it was taken of and in another one loaded the same way
+        result = LoadTestModule (runtimes [1], NULL, "state");                          expect (result == m3Err_none)
+
+        for (u32 pass = 0; pass < 3; ++pass)
+        {
+            IM3Runtime runtime = runtimes [pass == 2];
+
+            i32 ret = 0;
+            i32 args [2] = { 100, 7 };
+            result = CallTest (runtime, "store", 2, args, NULL);                        expect (result == m3Err_none)
+            result = CallTest (runtime, "bump", 0, NULL, & ret);                        expect (result == m3Err_none)
+            result = CallTest (runtime, "grow", 0, NULL, & ret);                        expect (result == m3Err_none)
+
+            result = m3_RestoreRuntime (runtime, snapshot);                             expect (result == m3Err_none)
+
+            result = CallTest (runtime, "load", 1, args, & ret);                        expect (ret == 123)
+            args [0] = 8;
+            result = CallTest (runtime, "load", 1, args, & ret);                        expect (ret == 7)
+            result = CallTest (runtime, "value", 0, NULL, & ret);                       expect (ret == 50)
+            result = CallTest (runtime, "size", 0, NULL, & ret);                        expect (ret == 1)
+            result = CallTest (runtime, "started", 0, NULL, & ret);                     expect (ret == 1)
+            // the segment stays dropped
+            args [0] = 200;
+            result = CallTest (runtime, "copy_segment", 1, args, NULL);                 expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+        }
+
+        // the modules have to match
+        result = LoadTestModule (runtimes [2], NULL, "template");                       expect (result == m3Err_none)
+        result = m3_RestoreRuntime (runtimes [2], snapshot);                            expect (result != m3Err_none)
+
+        // restored memory doesn't depend on the snapshot living on
+        m3_FreeSnapshot (snapshot);
+
+        i32 ret = 0;
+        i32 args [2] = { 100, 9 };
+        result = CallTest (runtimes [0], "load", 1, args, & ret);                       expect (ret == 123)
+        result = CallTest (runtimes [0], "store", 2, args, NULL);                       expect (result == m3Err_none)
+        result = CallTest (runtimes [0], "load", 1, args, & ret);                       expect (ret == 9)
+
+        for (u32 i = 0; i < 3; ++i)
+            m3_FreeRuntime (runtimes [i]);
+# endif
+    }
+
+
+    Test (checkpoints)
+    {
+# if d_m3HasSnapshots
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        result = LoadTestModule (runtime, NULL, "state");                               expect (result == m3Err_none)
+        result = m3_ResetMemory (runtime);                                              expect (result != m3Err_none)
+
+        result = CallTest (runtime, "init", 0, NULL, NULL);                             expect (result == m3Err_none)
+        result = m3_CheckpointMemory (runtime);                                         expect (result == m3Err_none)
+
+        for (u32 pass = 0; pass < 3; ++pass)
+        {
+            i32 ret = 0;
+
+            // dirty a few pages, some of them only after growing
+            i32 numPages = 1;
+            for (i32 address = 100; address < 3 * 65536; address += 5000)
+            {
+                if (address >= numPages * 65536)
+                {
+                    result = CallTest (runtime, "grow", 0, NULL, & ret);                expect (ret == numPages)
+                    ++numPages;
+                }
+
+                i32 args [2] = { address, pass + 1 };
+                result = CallTest (runtime, "store", 2, args, NULL);                    expect (result == m3Err_none)
+            }
+
+            result = CallTest (runtime, "bump", 0, NULL, & ret);                        expect (ret == 51 + (i32) pass)
+
+            result = m3_ResetMemory (runtime);                                          expect (result == m3Err_none)
+
+            i32 address = 100;
+            result = CallTest (runtime, "load", 1, & address, & ret);                   expect (ret == 123)
+            address = 5100;
+            result = CallTest (runtime, "load", 1, & address, & ret);                   expect (ret == 0)
+            address = 8;
+            result = CallTest (runtime, "load", 1, & address, & ret);                   expect (ret == 7)
+            result = CallTest (runtime, "size", 0, NULL, & ret);                        expect (ret == 1)
+            address = 65536;
+            result = CallTest (runtime, "load", 1, & address, & ret);                   expect (result == m3Err_trapOutOfBoundsMemoryAccess)
+        }
+
+        // a snapshot restore discards the checkpoint
+        IM3Snapshot snapshot = NULL;
+        result = m3_SnapshotRuntime (runtime, & snapshot);                              expect (result == m3Err_none)
+        result = m3_RestoreRuntime (runtime, snapshot);                                 expect (result == m3Err_none)
+        result = m3_ResetMemory (runtime);                                              expect (result != m3Err_none)
+
+        m3_FreeSnapshot (snapshot);
+        m3_FreeRuntime (runtime);
+# endif
+    }
+
+
+    Test (preinit)
+    {
+        M3Result result;
+
+        cstr_t initFunctions [2] = { "init", NULL };
+
+        for (u32 i = 0; i < 2; ++i)
+        {
+            IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtime, & module, "state");                       expect (result == m3Err_none)
+
+            u8 * wasm = NULL;
+            u32 size = 0;
+            result = m3_PreinitializeModule (module, initFunctions [i], & wasm, & size); expect (result == m3Err_none)
+
+            // the new module starts out where the old one was left
+            IM3Runtime preinitialized = m3_NewRuntime (env, 8 * 1024, NULL);
+
+            IM3Module baked = NULL;
+            result = m3_ParseModule (env, & baked, wasm, size);                         expect (result == m3Err_none)
+            result = m3_LoadModule (preinitialized, baked);                             expect (result == m3Err_none)
+
+            i32 ret = 0;
+            result = CallTest (preinitialized, "started", 0, NULL, & ret);              expect (result == m3Err_none and ret == 1)
+
+            i32 address = 100;
+            result = CallTest (preinitialized, "load", 1, & address, & ret);            expect (ret == (initFunctions [i] ? 123 : 0))
+            address = 8;
+            result = CallTest (preinitialized, "load", 1, & address, & ret);            expect (ret == (initFunctions [i] ? 7 : 0))
+            address = 0;
+            result = CallTest (preinitialized, "load", 1, & address, & ret);            expect (ret == 42)
+            result = CallTest (preinitialized, "value", 0, NULL, & ret);                expect (ret == (initFunctions [i] ? 50 : 1))
+            result = CallTest (preinitialized, "bump", 0, NULL, & ret);                 expect (ret == (initFunctions [i] ? 51 : 2))
+
+            m3_FreeRuntime (preinitialized);
+            m3_FreeRuntime (runtime);
+            m3_FreePreinitializedModule (wasm);
+        }
+    }
+
+
+    Test (suspend)
+    {
+# if d_m3HasSuspend
+        M3Result result;
+
+        IM3Runtime runtimes [2];
+        for (u32 r = 0; r < 2; ++r)
+        {
+            runtimes [r] = m3_NewRuntime (env, 8 * 1024, NULL);
+            result = m3_EnableSuspension (runtimes [r], 0);                             expect (result == m3Err_none)
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtimes [r], & module, "suspend");                expect (result == m3Err_none)
+            result = m3_LinkRawFunction (module, "env", "pause", "i(i)", & Pause);      expect (result == m3Err_none)
+        }
+
+        // the two calls take turns; each pauses once per iteration
+        i32 args [2] = { 3, 4 };
+        for (u32 r = 0; r < 2; ++r)
+        {
+            result = CallTest (runtimes [r], "run", 1, & args [r], NULL);               expect (result == m3Err_suspended)
+        }
+
+        i32 ret = 0;
+        result = CallTest (runtimes [0], "twice", 1, args, & ret);                      expect (result == m3Err_runtimeSuspended)
+
+        for (u32 i = 0; i < 2; ++i)
+        {
+            for (u32 r = 0; r < 2; ++r)
+            {
+                result = m3_Resume (runtimes [r]);                                      expect (result == m3Err_suspended)
+            }
+        }
+
+        result = m3_Resume (runtimes [1]);                                              expect (result == m3Err_suspended)
+        result = m3_Resume (runtimes [0]);                                              expect (result == m3Err_none)
+
+        IM3Function function = NULL;
+        m3_FindFunction (& function, runtimes [0], "run");
+        if (function)
+        {
+            const void * rets [1] = { & ret };
+            result = m3_GetResults (function, 1, rets);                                 expect (ret == 6)
+        }
+
+        result = m3_Resume (runtimes [0]);                                              expect (result == m3Err_notSuspended)
+        result = CallTest (runtimes [0], "twice", 1, args, & ret);                      expect (result == m3Err_none and ret == 6)
+
+#   if d_m3HasPthreads and not d_m3UseGuardPages
+        // and is picked up by another thread
+        i32 two = 2;
+        result = CallTest (runtimes [0], "run", 1, & two, NULL);                        expect (result == m3Err_suspended)
+
+        pthread_t thread;
+        void * threadResult = NULL;
+        pthread_create (& thread, NULL, ResumeThread, runtimes [0]);
+        pthread_join (thread, & threadResult);                                          expect (threadResult == m3Err_suspended)
+
+        result = m3_Resume (runtimes [0]);                                              expect (result == m3Err_none)
+        if (function)
+        {
+            const void * rets [1] = { & ret };
+            result = m3_GetResults (function, 1, rets);                                 expect (ret == 2)
+        }
+#   endif
+
+        // the other one is abandoned part way
+        result = m3_CancelSuspended (runtimes [1]);                                     expect (result == m3Err_trapSuspendedCallCancelled)
+        result = CallTest (runtimes [1], "run", 1, args, & ret);                        expect (result == m3Err_suspended)
+        m3_FreeRuntime (runtimes [1]);
+
+        // a call that never pauses
+        i32 zero = 0;
+        result = CallTest (runtimes [0], "run", 1, & zero, & ret);                      expect (result == m3Err_none and ret == 0)
+
+        m3_FreeRuntime (runtimes [0]);
+# endif
+    }
+
+
+    Test (gas)
+    {
+        M3Result result;
+
+        // the default charges 1 per opcode; the other only charges i32.add
+        u32 addCosts [256] = { 0 };
+        addCosts [0x6a] = 5;
+
+        for (u32 e = 0; e < 2; ++e)
+        {
+            IM3Environment env = m3_NewEnvironment ();
+            result = m3_EnableGasMetering (env, e ? addCosts : NULL);                   expect (result == m3Err_none)
+
+            IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+            result = LoadTestModule (runtime, NULL, "gas");                             expect (result == m3Err_none)
+
+            // the cost grows by the same amount with each iteration
+            u64 used [3];
+            for (i32 i = 0; i < 3; ++i)
+            {
+                result = m3_SetGasLimit (runtime, 1000000);                             expect (result == m3Err_none)
+
+                i32 ret = 0, n = i * 10;
+                result = CallTest (runtime, "sum", 1, & n, & ret);                      expect (result == m3Err_none and ret == n * (n - 1) / 2)
+                used [i] = m3_GetGasUsed (runtime);
+            }
+                                                                                        expect (used [1] > used [0])
+                                                                                        expect (used [2] - used [1] == used [1] - used [0])
+            if (e)
+            {
+                // the entered loop body is paid for in full, including the run that leaves it
+                                                                                        expect (used [0] == 10 and used [1] == 110)
+            }
+
+            // a call is charged for its callee too
+            result = m3_SetGasLimit (runtime, 1000000);                                 expect (result == m3Err_none)
+            i32 ret = 0, n = 10;
+            result = CallTest (runtime, "call_sum", 1, & n, & ret);                     expect (result == m3Err_none and ret == 45)
+                                                                                        expect (m3_GetGasUsed (runtime) >= used [1])
+            // running out traps, and the runtime carries on with a new limit
+            result = m3_SetGasLimit (runtime, 1000);                                    expect (result == m3Err_none)
+            result = CallTest (runtime, "spin", 0, NULL, NULL);                         expect (result == m3Err_trapOutOfGas)
+                                                                                        expect (m3_GetGasUsed (runtime) >= 1000)
+            result = m3_SetGasLimit (runtime, used [1] - 1);                            expect (result == m3Err_none)
+            result = CallTest (runtime, "sum", 1, & n, & ret);                          expect (result == m3Err_trapOutOfGas)
+            result = m3_SetGasLimit (runtime, used [1]);                                expect (result == m3Err_none)
+            result = CallTest (runtime, "sum", 1, & n, & ret);                          expect (result == m3Err_none and ret == 45)
+
+            m3_FreeRuntime (runtime);
+            m3_FreeEnvironment (env);
+        }
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        result = m3_SetGasLimit (runtime, 1000);                                        expect (result != m3Err_none)
+        m3_FreeRuntime (runtime);
+    }
+
+
+    Test (interrupts)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        IM3Module module;
+        result = LoadTestModule (runtime, & module, "interrupt");                       expect (result == m3Err_none)
+        result = m3_LinkRawFunction (module, "env", "interrupt", "v()", & Interrupt);   expect (result == m3Err_none)
+
+        // an interrupt raised between calls traps the next one, & only that one
+        i32 ret = 0, n = 100;
+        m3_InterruptRuntime (runtime);
+        result = CallTest (runtime, "count", 1, & n, & ret);                            expect (result == m3Err_trapInterrupted)
+        result = CallTest (runtime, "count", 1, & n, & ret);                            expect (result == m3Err_none and ret == n)
+
+        // tail calls are polled too, as they skip the callee's entry; host functions run to completion
+        result = CallTest (runtime, "tail", 0, NULL, & ret);                            expect (result == m3Err_trapInterrupted)
+        result = CallTest (runtime, "count", 1, & n, & ret);                            expect (result == m3Err_none and ret == n)
+
+# if d_m3HasPthreads
+        // arming a deadline clears a pending interrupt
+        m3_InterruptRuntime (runtime);
+        result = m3_SetDeadline (runtime, 0);                                           expect (result == m3Err_none)
+        result = CallTest (runtime, "count", 1, & n, & ret);                            expect (result == m3Err_none and ret == n)
+
+        result = m3_SetDeadline (runtime, 20);                                          expect (result == m3Err_none)
+        result = CallTest (runtime, "spin", 0, NULL, NULL);                             expect (result == m3Err_trapInterrupted)
+
+        // a disarmed deadline doesn't fire
+        result = m3_SetDeadline (runtime, 20);                                          expect (result == m3Err_none)
+        result = m3_SetDeadline (runtime, 0);                                           expect (result == m3Err_none)
+        usleep (50 * 1000);
+        result = CallTest (runtime, "count", 1, & n, & ret);                            expect (result == m3Err_none and ret == n)
+
+        // of two armed runtimes, each is interrupted by its own deadline
+        IM3Runtime other = m3_NewRuntime (env, 8 * 1024, NULL);
+        result = LoadTestModule (other, NULL, "interrupt");                             expect (result == m3Err_none)
+        result = m3_SetDeadline (other, 10 * 1000);                                     expect (result == m3Err_none)
+        result = m3_SetDeadline (runtime, 20);                                          expect (result == m3Err_none)
+        result = CallTest (runtime, "spin", 0, NULL, NULL);                             expect (result == m3Err_trapInterrupted)
+        result = CallTest (other, "count", 1, & n, & ret);                              expect (result == m3Err_none and ret == n)
+
+        // freeing an armed runtime disarms it
+        m3_FreeRuntime (other);
+        result = m3_SetDeadline (runtime, 20);                                          expect (result == m3Err_none)
+        result = CallTest (runtime, "spin", 0, NULL, NULL);                             expect (result == m3Err_trapInterrupted)
+
+#   if d_m3HasThreads
+        // interrupting from another thread
+        TestCall spin = { runtime, "spin", 0 };
+        pthread_t thread;
+        pthread_create (& thread, NULL, CallTestThread, & spin);
+        usleep (10 * 1000);
+        m3_InterruptRuntime (runtime);
+        pthread_join (thread, NULL);                                                    expect (spin.result == m3Err_trapInterrupted)
+#   endif
+# else
+        result = m3_SetDeadline (runtime, 20);                                          expect (result != m3Err_none)
+# endif
+
+        m3_FreeRuntime (runtime);
+    }
+
+
+    Test (jit)
+    {
+        M3Result result;
+
+        // each export runs interpreted & translated; the results, or the traps, must match
+        const i32 operands [] = { 0, 1, -1, 2, 3, 7, -7, 31, 100, 999, 65535, 0x12345678, 0x7fffffff, (i32) 0x80000000 };
+        const u32 numOperands = sizeof (operands) / sizeof (operands [0]);
+
+        cstr_t names [] = { "jit", "compare-branch" };
+
+        for (u32 m = 0; m < 2; ++m)
+        {
+            IM3Runtime runtimes [2];
+            IM3Module modules [2] = { NULL, NULL };
+
+            for (u32 r = 0; r < 2; ++r)
+            {
+                runtimes [r] = m3_NewRuntime (env, 64 * 1024, NULL);
+                if (r)
+                {
+                    result = m3_EnableJit (runtimes [r]);
+# if d_m3HasJit
+                                                                                        expect (result == m3Err_none)
+# else
+                                                                                        expect (result != m3Err_none)
+# endif
+                }
+
+                result = LoadTestModule (runtimes [r], & modules [r], names [m]);       expect (result == m3Err_none)
+                if (m == 0)
+                {
+                    result = m3_LinkRawFunction (modules [r], "env", "add", "i(ii)", & AddI32);
+                                                                                        expect (result == m3Err_none)
+                }
+            }
+
+            u32 numCompared = 0;
+
+            for (u32 f = 0; modules [0] and f < modules [0]->numFunctions; ++f)
+            {
+                cstr_t name = modules [0]->functions [f].export_name;
+                if (not name)
+                    continue;
+
+                for (u32 i = 0; i < numOperands * numOperands; ++i)
+                {
+                    i32 args [3] = { operands [i / numOperands], operands [i % numOperands], 0 };
+                    i32 ret [2] = { 0, 0 };
+                    M3Result results [2];
+
+                    for (u32 r = 0; r < 2; ++r)
+                    {
+                        IM3Function function = NULL;
+                        results [r] = m3_FindFunction (& function, runtimes [r], name);
+                        if (not results [r])
+                            results [r] = CallTest (runtimes [r], name, m3_GetArgCount (function), args, & ret [r]);
+                    }
+
+                    if (results [0] != results [1] or (not results [0] and ret [0] != ret [1]))
+                        printf ("%s (%d, %d): %s %d, jit: %s %d\n", name, args [0], args [1],
+                                results [0] ? results [0] : "", ret [0], results [1] ? results [1] : "", ret [1]);
+                                                                                        expect (results [0] == results [1])
+                                                                                        expect (results [0] or ret [0] == ret [1])
+                    ++numCompared;
+                }
+
+# if d_m3HasJit
+                // compiled by the calls
+                IM3Function function = NULL;
+                result = m3_FindFunction (& function, runtimes [1], name);               expect (result == m3Err_none)
+                                                                                        expect (function->native != NULL)
+# endif
+            }
+                                                                                        expect (numCompared > 0)
+            for (u32 r = 0; r < 2; ++r)
+                m3_FreeRuntime (runtimes [r]);
+        }
+    }
+
+
+    Test (tiering)
+    {
+# if d_m3HasJit and !defined(_WIN32)
+        M3Result result;
+
+        char directory [] = "/tmp/m3_test_XXXXXX";
+        expect (mkdtemp (directory))
+
+        IM3Environment cacheEnv = m3_NewEnvironment ();
+        result = m3_SetCodeCacheDirectory (cacheEnv, directory);                        expect (result == m3Err_none)
+
+        // however the module is compiled, a tiering runtime starts out interpreted. the last pass doesn't tier,
+        // so it can't use the cached (counted) code & translates everything up front
+        enum { c_compile, c_compileParallel, c_cacheWrite, c_cacheRead, c_cacheEager, c_numPasses };
+
+        for (u32 pass = 0; pass < c_numPasses; ++pass)
+        {
+            IM3Runtime runtime = m3_NewRuntime (pass >= c_cacheWrite ? cacheEnv : env, 16 * 1024, NULL);
+            bool tiering = (pass != c_cacheEager);
+
+            result = tiering ? m3_EnableTiering (runtime, 5) : m3_EnableJit (runtime);  expect (result == m3Err_none)
+
+            IM3Module module = NULL;
+            result = LoadTestModule (runtime, & module, "compile-parallel");            expect (result == m3Err_none)
+            result = (pass == c_compileParallel) ? m3_CompileModuleParallel (module, 4) : m3_CompileModule (module);
+                                                                                        expect (result == m3Err_none)
+            if (pass >= c_cacheWrite)
+            {
+                                                                                        expect (CountCacheFiles (directory) == (pass == c_cacheEager ? 2 : 1))
+            }
+
+            u32 numNative = 0;
+            for (u32 i = 0; module and i < module->numFunctions; ++i)
+                numNative += (module->functions [i].native != NULL);
+                                                                                        expect (numNative == (tiering ? 0 : module->numFunctions))
+            for (u32 c = 0; c < 10; ++c)
+            {
+                i32 ret = 0, arg = 2;
+                result = CallTest (runtime, "sum", 1, & arg, & ret);                    expect (result == m3Err_none and ret == 408)
+            }
+
+            // everything has been called often enough to be swapped for native code
+            numNative = 0;
+            for (u32 i = 0; module and i < module->numFunctions; ++i)
+                numNative += (module->functions [i].native != NULL and module->functions [i].tier == tiering);
+                                                                                        expect (numNative == module->numFunctions)
+            m3_FreeRuntime (runtime);
+        }
+
+        RemoveCacheFiles (directory);
+        m3_FreeEnvironment (cacheEnv);
+# endif
+    }
+
+
+    Test (fold)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+
+        IM3Module module = NULL;
+        result = LoadTestModule (runtime, & module, "fold");                            expect (result == m3Err_none)
+
+        // the constants of fold.wat; every pair of the first numFolded is folded
+        const i64 constants [] = { 0, 1, -1, 33, -0x80000000LL, INT64_MIN, 2, 3, 7, -7, 10, 16, 641, -1000003,
+                                   0x7fffffff, 0xffffffffLL, 0x100000000LL, 0x123456789aLL, INT64_MAX };
+        const u32 numConstants = sizeof (constants) / sizeof (constants [0]);
+        const u32 numFolded = 6;
+
+        u32 numCompared = 0;
+
+        for (u32 f = 0; module and f < module->numFunctions; ++f)
+        {
+            // the operator's own export computes the results that its variants are compared with
+            cstr_t name = module->functions [f].export_name;
+            if (not name or strchr (name, '.') != strrchr (name, '.'))
+                continue;
+
+            IM3Function function = NULL;
+            result = m3_FindFunction (& function, runtime, name);                       expect (result == m3Err_none)
+            if (result)
+                continue;
+
+            u32 numOperands = m3_GetArgCount (function);
+
+            cstr_t variants [] = { "folded", "by", "of" };
+            for (u32 v = 0; v < 3; ++v)
+            {
+                char variant [64];
+                snprintf (variant, sizeof (variant), "%s.%s", name, variants [v]);
+
+                // only some operators have by & of
+                IM3Function unused;
+                if (m3_FindFunction (& unused, runtime, variant))
+                {
+                                                                                        expect (v > 0)
+                    continue;
+                }
+
+                // folded takes the index of the pair of constants (of the one, for unary operators). by & of take
+                // the index of the constant operand & the other operand
+                u32 n = v ? numConstants : numFolded;
+                u32 numCases = (numOperands == 1) ? numConstants : n * n;
+
+                for (u32 i = 0; i < numCases; ++i)
+                {
+                    i64 operands [2] = { constants [i / n], constants [i % n] };
+                    i64 args [2] = { i, 0 };
+
+                    if (numOperands == 1)
+                        operands [0] = constants [i];
+                    else if (v == 1)
+                    {
+                        args [0] = i % n;
+                        args [1] = operands [0];
+                    }
+                    else if (v == 2)
+                    {
+                        args [0] = i / n;
+                        args [1] = operands [1];
+                    }
+
+                    i64 expected = 0, ret = 0;
+                    M3Result expectedResult = CallTest64 (runtime, name, numOperands, operands, & expected);
+                    result = CallTest64 (runtime, variant, v ? 2 : 1, args, & ret);
+
+                    if (result != expectedResult or (not result and ret != expected))
+                        printf ("%s (%lld, %lld): %s %lld, expected: %s %lld\n", variant, (long long) operands [0], (long long) operands [1],
+                                result ? result : "", (long long) ret, expectedResult ? expectedResult : "", (long long) expected);
+                                                                                        expect (result == expectedResult)
+                                                                                        expect (result or ret == expected)
+                    ++numCompared;
+                }
+            }
+        }
+                                                                                        expect (numCompared > 0)
+        m3_FreeRuntime (runtime);
+    }
+
+
+    Test (fuse.target)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+
+        IM3Module module = NULL;
+        result = LoadTestModule (runtime, & module, "result-target");                   expect (result == m3Err_none)
+
+        const i32 operands [] [2] = { { 3, 5 }, { -7, 2 }, { 0, 9 }, { 100000, -3 }, { 0x7fffffff, 1 }, { -1, -1 }, { 0x12345678, 6 } };
+
+        u32 numExports = 0;
+
+        for (u32 f = 0; module and f < module->numFunctions; ++f)
+        {
+            cstr_t name = module->functions [f].export_name;
+            if (not name)
+                continue;
+
+            ++numExports;
+
+            for (u32 i = 0; i < sizeof (operands) / sizeof (operands [0]); ++i)
+            {
+                i32 ret = 0;
+                result = CallTest (runtime, name, 2, operands [i], & ret);              expect (result == m3Err_none)
+
+                i32 expected = ExpectedTargetResult (name, operands [i][0], operands [i][1]);
+                if (ret != expected)
+                    printf ("%s (%d, %d): %d, expected: %d\n", name, operands [i][0], operands [i][1], ret, expected);
+                                                                                        expect (ret == expected)
+            }
+        }
+                                                                                        expect (numExports == 10)
+        m3_FreeRuntime (runtime);
+    }
+
+
+    Test (dispatch)
+    {
+# if d_m3DispatchLoop and d_m3HasThreads
+        M3Result result;
+
+        // every op returns to the dispatch loop, so a long run of them needs no more native stack than a short one,
+        // even if the C compiler doesn't eliminate tail calls. the call runs on a thread with a small stack
+        u32 size = 0;
+        u8 * wasm = NewStraightLineModule (100000, & size);                            expect (wasm)
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+
+        IM3Module module = NULL;
+        result = m3_ParseModule (env, & module, wasm, size);                            expect (result == m3Err_none)
+        result = m3_LoadModule (runtime, module);                                       expect (result == m3Err_none)
+        result = m3_CompileModule (module);                                             expect (result == m3Err_none)
+
+        TestCall run = { runtime, "run", 1, { 7 } };
+
+        pthread_attr_t attributes;
+        pthread_attr_init (& attributes);
+        pthread_attr_setstacksize (& attributes, 256 * 1024);
+
+        pthread_t thread;
+        pthread_create (& thread, & attributes, CallTestThread, & run);
+        pthread_join (thread, NULL);                                                    expect (run.result == m3Err_none and run.ret == 100007)
+
+        pthread_attr_destroy (& attributes);
+        m3_FreeRuntime (runtime);
+        free (wasm);
+# endif
+    }
+
+
+    Test (loops)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        result = LoadTestModule (runtime, NULL, "loops");                               expect (result == m3Err_none)
+
+        // enough iterations to run out of native stack if any of them left a frame behind (see d_m3FlattenLoops)
+        i32 args [2] = { 10000, 1000 }, ret = 0;
+        result = CallTest (runtime, "nested", 2, args, & ret);                          expect (result == m3Err_none and ret == 10000000)
+        args [0] = 1;
+        result = CallTest (runtime, "nested", 2, args, & ret);                          expect (result == m3Err_none and ret == 1000)
+        args [1] = 0;
+        result = CallTest (runtime, "nested", 2, args, & ret);                          expect (result == m3Err_none and ret == 0)
+
+        i32 n = 100000;
+        result = CallTest (runtime, "result", 1, & n, & ret);                           expect (result == m3Err_none and ret == (i32) (100000ULL * 100001 / 2))
+        result = CallTest (runtime, "param", 1, & n, & ret);                            expect (result == m3Err_none and ret == (i32) (100000ULL * 100001 / 2))
+        n = 1000000;
+        result = CallTest (runtime, "call", 1, & n, & ret);                             expect (result == m3Err_none and ret == n)
+
+        IM3Function function;
+        result = m3_FindFunction (& function, runtime, "float");                        expect (result == m3Err_none)
+        const void * floatArgs [1] = { & n };
+        result = m3_Call (function, 1, floatArgs);                                      expect (result == m3Err_none)
+        f64 x = 0;
+        const void * floatResults [1] = { & x };
+        result = m3_GetResults (function, 1, floatResults);                             expect (result == m3Err_none and x == n / 2.0)
+
+        // each step takes the back-edge of the loop the new count's parity picks: the outer one when it's even
+        for (i64 count = 0; count < 6; ++count)
+        {
+            i64 arg = count * 100001, entries = 0;
+            result = CallTest64 (runtime, "table", 1, & arg, & entries);                expect (result == m3Err_none)
+                                                                                        expect (entries >> 32 == 1 + (arg + 1) / 2 and (u32) entries == 1 + arg)
+        }
+
+        m3_FreeRuntime (runtime);
+
+        // the gas runs out part way through the iterations
+        args [0] = 10000; args [1] = 10000;
+
+        IM3Environment gasEnv = m3_NewEnvironment ();
+        result = m3_EnableGasMetering (gasEnv, NULL);                                   expect (result == m3Err_none)
+        runtime = m3_NewRuntime (gasEnv, 8 * 1024, NULL);
+        result = LoadTestModule (runtime, NULL, "loops");                               expect (result == m3Err_none)
+        result = m3_SetGasLimit (runtime, 1000000);                                     expect (result == m3Err_none)
+        result = CallTest (runtime, "nested", 2, args, & ret);                          expect (result == m3Err_trapOutOfGas)
+        result = m3_SetGasLimit (runtime, 1000000);                                     expect (result == m3Err_none)
+        args [0] = 1;
+        result = CallTest (runtime, "nested", 2, args, & ret);                          expect (result == m3Err_none and ret == 10000)
+
+        m3_FreeRuntime (runtime);
+        m3_FreeEnvironment (gasEnv);
+    }
+
+
+    Test (callcache)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        IM3Module module = NULL;
+        result = LoadTestModule (runtime, & module, "call-cache");                      expect (result == m3Err_none)
+
+        u64 hits = 0, misses = 0;
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 0 and misses == 0)
+
+        // a site misses until it calls the same entry twice running
+        i32 args [2] = { 0, 5 }, ret = 0;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_none and ret == 6)
+        args [0] = 1;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_none and ret == 10)
+        args [1] = 6;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_none and ret == 12)
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 1 and misses == 2)
+
+        // traps aren't cached
+        args [0] = 2;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_trapIndirectCallTypeMismatch)
+        args [0] = 3;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_trapTableIndexOutOfRange)
+        args [0] = -1;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_trapTableIndexOutOfRange)
+        args [0] = 1;
+        result = CallTest (runtime, "dispatch", 2, args, & ret);                        expect (result == m3Err_none and ret == 12)
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 2 and misses == 5)
+
+        args [0] = 1000; args [1] = 0;
+        result = CallTest (runtime, "same", 2, args, & ret);                            expect (result == m3Err_none and ret == 1000 * 1001 / 2)
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 2 + 999 and misses == 5 + 1)
+
+        result = CallTest (runtime, "alternate", 1, args, & ret);                       expect (result == m3Err_none and ret == 250000 + 500000)
+        m3_GetCallCacheCounts (runtime, NULL, & misses);                                expect (misses == 6 + 1000)
+
+        // a changed table empties the caches: the site calls the new entry
+        IM3Function first = module->table0 [0];
+        module->table0 [0] = module->table0 [1];
+        module->table0Version++;
+        args [0] = 10;
+        result = CallTest (runtime, "same", 2, args, & ret);                            expect (result == m3Err_none and ret == 90)
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 1001 + 9 and misses == 1006 + 1)
+
+        // so does restoring a snapshot, which rewrites the table
+        module->table0 [0] = first;
+        module->table0Version++;
+        IM3Snapshot snapshot = NULL;
+        result = m3_SnapshotRuntime (runtime, & snapshot);                              expect (result == m3Err_none)
+        result = CallTest (runtime, "same", 2, args, & ret);                            expect (result == m3Err_none and ret == 55)
+        result = m3_RestoreRuntime (runtime, snapshot);                                 expect (result == m3Err_none)
+        result = CallTest (runtime, "same", 2, args, & ret);                            expect (result == m3Err_none and ret == 55)
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 1010 + 18 and misses == 1007 + 2)
+
+        m3_FreeSnapshot (snapshot);
+        m3_FreeRuntime (runtime);
+
+        // a template's code is shared by its instances, and always looks up
+        u32 size = 0;
+        u8 * wasm = ReadTestModule ("template", & size);                                expect (wasm)
+
+        IM3ModuleTemplate moduleTemplate = NULL;
+        result = m3_NewModuleTemplate (env, & moduleTemplate, wasm, size);              expect (result == m3Err_none)
+        runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        result = m3_InstantiateTemplate (runtime, moduleTemplate, & module);            expect (result == m3Err_none)
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            result = CallTest (runtime, "inc_indirect", 0, NULL, & ret);                expect (result == m3Err_none)
+        }
+        m3_GetCallCacheCounts (runtime, & hits, & misses);                              expect (hits == 0 and misses == 3)
+
+        m3_FreeRuntime (runtime);
+        m3_FreeModuleTemplate (moduleTemplate);
+    }
+
+
+    Test (zero.locals)
+    {
+        M3Result result;
+
+        // run (case, x) dirties the stack before it calls the case; the locals it reads first must still be 0
+        const i32 values [] = { 0, 1, 2, 10, 1000 };
+
+        for (u32 r = 0; r < 1 + d_m3HasJit; ++r)
+        {
+            IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+            if (r)
+            {
+                result = m3_EnableJit (runtime);                                        expect (result == m3Err_none)
+            }
+            result = LoadTestModule (runtime, NULL, "zero-locals");                     expect (result == m3Err_none)
+
+            for (u32 i = 0; i < sizeof (values) / sizeof (values [0]); ++i)
+            {
+                i32 x = values [i];
+                i32 expected [6] = { x ? 5 : 0, x, x + 7, x > 1 ? (x - 1) * (x - 2) / 2 : 0, x + 3, x };
+
+                for (i32 c = 0; c < 6; ++c)
+                {
+                    i32 args [2] = { c, x }, ret = -1;
+                    result = CallTest (runtime, "run", 2, args, & ret);                 expect (result == m3Err_none and ret == expected [c])
+                }
+            }
+
+            m3_FreeRuntime (runtime);
+        }
+    }
+
+
+    Test (fuse.branch)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+
+        IM3Module module = NULL;
+        result = LoadTestModule (runtime, & module, "compare-branch");                  expect (result == m3Err_none)
+
+        const i32 operands [] [2] = { { 3, 5 }, { 5, 3 }, { 4, 4 }, { -1, 2 }, { 2, -1 }, { 0, 0 }, { -7, -7 }, { 1, 999 }, { 999, 999 } };
+
+        for (u32 f = 0; module and f < module->numFunctions; ++f)
+        {
+            cstr_t name = module->functions [f].export_name;
+            bool isEqz = strstr (name, "eqz");
+            i32 mask = isEqz ? 0xff : 0xfff;
+
+            for (u32 i = 0; i < sizeof (operands) / sizeof (operands [0]); ++i)
+            {
+                i32 args [3] = { operands [i][0], operands [i][1], 0 };
+                i32 ret = -1;
+                result = CallTest (runtime, name, 3, args, & ret);                      expect (result == m3Err_none)
+
+                i32 expected = ExpectedComparison (name, args [0], args [1]) ? mask : 0;
+                if (ret != expected)
+                    printf ("%s (%d, %d): 0x%x\n", name, args [0], args [1], ret);
+                                                                                        expect (ret == expected)
+            }
+        }
+
+        m3_FreeRuntime (runtime);
+    }
+
+
+    Test (fuse.setlocal)
+    {
+        M3Result result;
+
+        IM3Runtime runtime = m3_NewRuntime (env, 8 * 1024, NULL);
+        result = LoadTestModule (runtime, NULL, "fuse-set-local");                      expect (result == m3Err_none)
+
+        struct { cstr_t name; u32 numArgs; i32 args [2]; i32 expected; } calls [] =
+        {
+            { "sum",        1, { 100 },     4950 },
+            { "shifts",     2, { 20, 2 },   165 },
+            { "preserve",   1, { 3 },       -12 },
+            { "tee",        1, { 13 },      25 },
+            { "load",       1, { 0 },       0x08070604 },
+            { "branch",     1, { 5 },       6 },
+            { "branch",     1, { 0 },       2 },
+            { "wide",       1, { -6 },      -9 },
+        };
+
+        for (u32 i = 0; i < sizeof (calls) / sizeof (calls [0]); ++i)
+        {
+            i32 ret = 0;
+            result = CallTest (runtime, calls [i].name, calls [i].numArgs, calls [i].args, & ret);  expect (result == m3Err_none)
+                                                                                        expect (ret == calls [i].expected)
+        }
+
+        m3_FreeRuntime (runtime);
+    }
+
+    m3_FreeEnvironment (env);
+
+    for (u32 i = 0; i < s_numWasm; ++i)
+        free (s_wasm [i]);
+
+    printf ("\n%s\n", s_numFailures ? "FAILED" : "ok");
+
+    return s_numFailures ? 1 : 0;
 }
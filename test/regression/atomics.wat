@@ -0,0 +1,81 @@
+;; threads proposal: a shared memory and the 0xFE atomic operations; several runtimes attach to the same memory
+(module
+  (memory 1 4 shared)
+
+  (func (export "load") (param $address i32) (result i32)
+    local.get $address
+    i32.atomic.load)
+
+  (func (export "store") (param $address i32) (param $value i32)
+    local.get $address
+    local.get $value
+    i32.atomic.store)
+
+  ;; returns the previous value
+  (func (export "add") (param $address i32) (param $value i32) (result i32)
+    local.get $address
+    local.get $value
+    i32.atomic.rmw.add)
+
+  (func (export "add_byte") (param $address i32) (param $value i32) (result i32)
+    local.get $address
+    local.get $value
+    i32.atomic.rmw8.add_u)
+
+  (func (export "add64") (param $address i32) (param $value i32) (result i32)
+    local.get $address
+    local.get $value
+    i64.extend_i32_s
+    i64.atomic.rmw.add
+    i32.wrap_i64)
+
+  (func (export "cmpxchg") (param $address i32) (param $expected i32) (param $value i32) (result i32)
+    local.get $address
+    local.get $expected
+    local.get $value
+    i32.atomic.rmw.cmpxchg)
+
+  ;; adds 1 to the word at address, n times; returns the value it last added to
+  (func (export "count") (param $address i32) (param $n i32) (result i32) (local $last i32)
+    block
+      loop
+        local.get $n
+        i32.eqz
+        br_if 1
+        local.get $address
+        i32.const 1
+        i32.atomic.rmw.add
+        local.set $last
+        atomic.fence
+        local.get $n
+        i32.const 1
+        i32.sub
+        local.set $n
+        br 0
+      end
+    end
+    local.get $last)
+
+  ;; 0: woken, 1: the value wasn't expected, 2: timed out
+  (func (export "wait") (param $address i32) (param $expected i32) (param $milliseconds i32) (result i32)
+    local.get $address
+    local.get $expected
+    local.get $milliseconds
+    i64.extend_i32_s
+    i64.const 1000000
+    i64.mul
+    memory.atomic.wait32)
+
+  ;; the number of waiters woken
+  (func (export "notify") (param $address i32) (result i32)
+    local.get $address
+    i32.const 1
+    memory.atomic.notify)
+
+  (func (export "grow") (result i32)
+    i32.const 1
+    memory.grow)
+
+  (func (export "size") (result i32)
+    memory.size)
+)
@@ -0,0 +1,74 @@
+;; each call_indirect site caches the last table entry it called (see M3CallCache)
+(module
+  (type $unary (func (param i32) (result i32)))
+
+  (table 3 funcref)
+  (elem (i32.const 0) $inc $double $wide)
+
+  (func $inc (type $unary)
+    local.get 0
+    i32.const 1
+    i32.add)
+
+  (func $double (type $unary)
+    local.get 0
+    i32.const 2
+    i32.mul)
+
+  ;; a different type: calling it through $unary traps
+  (func $wide (param i64) (result i64)
+    local.get 0)
+
+  (func (export "dispatch") (param $index i32) (param $x i32) (result i32)
+    local.get $x
+    local.get $index
+    call_indirect (type $unary))
+
+  ;; the sum of table[index] (i) for i < n: the site calls the same entry each time
+  (func (export "same") (param $n i32) (param $index i32) (result i32) (local $i i32) (local $sum i32)
+    block
+      loop
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if 1
+        local.get $sum
+        local.get $i
+        local.get $index
+        call_indirect (type $unary)
+        i32.add
+        local.set $sum
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br 0
+      end
+    end
+    local.get $sum)
+
+  ;; the sum of table[i & 1] (i) for i < n: the site alternates between two entries
+  (func (export "alternate") (param $n i32) (result i32) (local $i i32) (local $sum i32)
+    block
+      loop
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if 1
+        local.get $sum
+        local.get $i
+        local.get $i
+        i32.const 1
+        i32.and
+        call_indirect (type $unary)
+        i32.add
+        local.set $sum
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br 0
+      end
+    end
+    local.get $sum)
+)
@@ -0,0 +1,788 @@
+;; every comparison feeding if, br_if (with and without a result) and a loop back-edge, with its operands in each
+;; form (_ss, _rs, _sr; _s and _r for eqz); see c_branchFusions. each export returns a mask with one bit per
+;; branch, set when it saw the condition as true. $z is always 0 and only keeps an operand in the register.
+;; for the float comparisons, b = 999 stands for NaN.
+(module
+
+  (func (export "i32.eqz") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _s
+    local.get $x i32.eqz if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x i32.eqz br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x i32.eqz br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x i32.eqz br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _r
+    local.get $x local.get $zz i32.xor i32.eqz if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor i32.eqz br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor i32.eqz br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor i32.eqz br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.eq") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.eq if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.eq br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.eq if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.eq br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.eq if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.eq br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.ne") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.ne if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.ne br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.ne if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.ne br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.ne if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.ne br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.lt_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.lt_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.lt_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.lt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.lt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.lt_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.lt_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.lt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.lt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.lt_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.lt_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.lt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.lt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.lt_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.lt_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.lt_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.lt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.lt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.lt_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.lt_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.lt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.lt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.lt_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.lt_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.lt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.lt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.gt_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.gt_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.gt_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.gt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.gt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.gt_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.gt_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.gt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.gt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.gt_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.gt_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.gt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.gt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.gt_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.gt_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.gt_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.gt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.gt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.gt_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.gt_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.gt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.gt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.gt_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.gt_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.gt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.gt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.le_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.le_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.le_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.le_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.le_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.le_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.le_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.le_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.le_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.le_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.le_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.le_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.le_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.le_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.le_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.le_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.le_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.le_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.le_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.le_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.le_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.le_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.le_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.le_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.le_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.le_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.ge_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.ge_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.ge_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.ge_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.ge_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.ge_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.ge_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.ge_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.ge_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.ge_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.ge_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.ge_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.ge_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i32.ge_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i32) (local $y i32) (local $zz i32) (local $k i32) (local $m i32)
+    local.get $a local.set $x  local.get $b local.set $y  local.get $z local.set $zz
+    ;; _ss
+    local.get $x local.get $y i32.ge_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i32.ge_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i32.ge_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i32.ge_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i32.xor local.get $y i32.ge_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i32.xor local.get $y i32.ge_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i32.xor local.get $y i32.ge_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i32.xor local.get $y i32.ge_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i32.xor i32.ge_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i32.xor i32.ge_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i32.xor i32.ge_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i32.xor i32.ge_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.eqz") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _s
+    local.get $x i64.eqz if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x i64.eqz br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x i64.eqz br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x i64.eqz br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _r
+    local.get $x local.get $zz i64.xor i64.eqz if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor i64.eqz br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor i64.eqz br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor i64.eqz br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.eq") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.eq if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.eq br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.eq if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.eq br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.eq if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.eq br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.ne") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.ne if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.ne br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.ne if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.ne br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.ne if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.ne br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.lt_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.lt_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.lt_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.lt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.lt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.lt_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.lt_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.lt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.lt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.lt_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.lt_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.lt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.lt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.lt_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.lt_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.lt_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.lt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.lt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.lt_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.lt_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.lt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.lt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.lt_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.lt_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.lt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.lt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.gt_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.gt_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.gt_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.gt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.gt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.gt_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.gt_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.gt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.gt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.gt_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.gt_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.gt_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.gt_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.gt_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.gt_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.gt_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.gt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.gt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.gt_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.gt_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.gt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.gt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.gt_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.gt_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.gt_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.gt_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.le_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.le_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.le_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.le_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.le_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.le_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.le_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.le_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.le_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.le_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.le_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.le_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.le_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.le_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.le_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.le_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.le_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.le_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.le_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.le_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.le_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.le_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.le_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.le_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.le_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.le_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.ge_s") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.ge_s if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.ge_s br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.ge_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.ge_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.ge_s if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.ge_s br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.ge_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.ge_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.ge_s if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.ge_s br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.ge_s br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.ge_s br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "i64.ge_u") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x i64) (local $y i64) (local $zz i64) (local $k i32) (local $m i32)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s local.set $y  local.get $z i64.extend_i32_s local.set $zz
+    ;; _ss
+    local.get $x local.get $y i64.ge_u if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y i64.ge_u br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y i64.ge_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y i64.ge_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz i64.xor local.get $y i64.ge_u if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz i64.xor local.get $y i64.ge_u br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz i64.xor local.get $y i64.ge_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz i64.xor local.get $y i64.ge_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz i64.xor i64.ge_u if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz i64.xor i64.ge_u br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz i64.xor i64.ge_u br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz i64.xor i64.ge_u br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f32.eq") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f32) (local $y f32) (local $zz f32) (local $k i32) (local $m i32)
+    local.get $a f32.convert_i32_s local.set $x  local.get $b f32.convert_i32_s local.set $y  local.get $z f32.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f32.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f32.eq if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f32.eq br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f32.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f32.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f32.add local.get $y f32.eq if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f32.add local.get $y f32.eq br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f32.add local.get $y f32.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f32.add local.get $y f32.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f32.add f32.eq if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f32.add f32.eq br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f32.add f32.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f32.add f32.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f32.ne") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f32) (local $y f32) (local $zz f32) (local $k i32) (local $m i32)
+    local.get $a f32.convert_i32_s local.set $x  local.get $b f32.convert_i32_s local.set $y  local.get $z f32.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f32.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f32.ne if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f32.ne br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f32.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f32.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f32.add local.get $y f32.ne if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f32.add local.get $y f32.ne br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f32.add local.get $y f32.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f32.add local.get $y f32.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f32.add f32.ne if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f32.add f32.ne br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f32.add f32.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f32.add f32.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f32.lt") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f32) (local $y f32) (local $zz f32) (local $k i32) (local $m i32)
+    local.get $a f32.convert_i32_s local.set $x  local.get $b f32.convert_i32_s local.set $y  local.get $z f32.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f32.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f32.lt if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f32.lt br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f32.lt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f32.lt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f32.add local.get $y f32.lt if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f32.add local.get $y f32.lt br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f32.add local.get $y f32.lt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f32.add local.get $y f32.lt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f32.add f32.lt if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f32.add f32.lt br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f32.add f32.lt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f32.add f32.lt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f32.gt") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f32) (local $y f32) (local $zz f32) (local $k i32) (local $m i32)
+    local.get $a f32.convert_i32_s local.set $x  local.get $b f32.convert_i32_s local.set $y  local.get $z f32.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f32.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f32.gt if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f32.gt br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f32.gt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f32.gt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f32.add local.get $y f32.gt if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f32.add local.get $y f32.gt br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f32.add local.get $y f32.gt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f32.add local.get $y f32.gt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f32.add f32.gt if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f32.add f32.gt br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f32.add f32.gt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f32.add f32.gt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f32.le") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f32) (local $y f32) (local $zz f32) (local $k i32) (local $m i32)
+    local.get $a f32.convert_i32_s local.set $x  local.get $b f32.convert_i32_s local.set $y  local.get $z f32.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f32.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f32.le if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f32.le br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f32.le br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f32.le br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f32.add local.get $y f32.le if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f32.add local.get $y f32.le br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f32.add local.get $y f32.le br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f32.add local.get $y f32.le br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f32.add f32.le if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f32.add f32.le br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f32.add f32.le br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f32.add f32.le br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f32.ge") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f32) (local $y f32) (local $zz f32) (local $k i32) (local $m i32)
+    local.get $a f32.convert_i32_s local.set $x  local.get $b f32.convert_i32_s local.set $y  local.get $z f32.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f32.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f32.ge if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f32.ge br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f32.ge br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f32.ge br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f32.add local.get $y f32.ge if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f32.add local.get $y f32.ge br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f32.add local.get $y f32.ge br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f32.add local.get $y f32.ge br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f32.add f32.ge if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f32.add f32.ge br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f32.add f32.ge br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f32.add f32.ge br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f64.eq") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f64) (local $y f64) (local $zz f64) (local $k i32) (local $m i32)
+    local.get $a f64.convert_i32_s local.set $x  local.get $b f64.convert_i32_s local.set $y  local.get $z f64.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f64.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f64.eq if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f64.eq br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f64.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f64.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f64.add local.get $y f64.eq if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f64.add local.get $y f64.eq br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f64.add local.get $y f64.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f64.add local.get $y f64.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f64.add f64.eq if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f64.add f64.eq br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f64.add f64.eq br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f64.add f64.eq br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f64.ne") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f64) (local $y f64) (local $zz f64) (local $k i32) (local $m i32)
+    local.get $a f64.convert_i32_s local.set $x  local.get $b f64.convert_i32_s local.set $y  local.get $z f64.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f64.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f64.ne if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f64.ne br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f64.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f64.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f64.add local.get $y f64.ne if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f64.add local.get $y f64.ne br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f64.add local.get $y f64.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f64.add local.get $y f64.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f64.add f64.ne if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f64.add f64.ne br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f64.add f64.ne br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f64.add f64.ne br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f64.lt") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f64) (local $y f64) (local $zz f64) (local $k i32) (local $m i32)
+    local.get $a f64.convert_i32_s local.set $x  local.get $b f64.convert_i32_s local.set $y  local.get $z f64.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f64.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f64.lt if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f64.lt br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f64.lt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f64.lt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f64.add local.get $y f64.lt if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f64.add local.get $y f64.lt br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f64.add local.get $y f64.lt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f64.add local.get $y f64.lt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f64.add f64.lt if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f64.add f64.lt br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f64.add f64.lt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f64.add f64.lt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f64.gt") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f64) (local $y f64) (local $zz f64) (local $k i32) (local $m i32)
+    local.get $a f64.convert_i32_s local.set $x  local.get $b f64.convert_i32_s local.set $y  local.get $z f64.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f64.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f64.gt if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f64.gt br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f64.gt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f64.gt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f64.add local.get $y f64.gt if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f64.add local.get $y f64.gt br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f64.add local.get $y f64.gt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f64.add local.get $y f64.gt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f64.add f64.gt if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f64.add f64.gt br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f64.add f64.gt br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f64.add f64.gt br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f64.le") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f64) (local $y f64) (local $zz f64) (local $k i32) (local $m i32)
+    local.get $a f64.convert_i32_s local.set $x  local.get $b f64.convert_i32_s local.set $y  local.get $z f64.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f64.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f64.le if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f64.le br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f64.le br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f64.le br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f64.add local.get $y f64.le if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f64.add local.get $y f64.le br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f64.add local.get $y f64.le br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f64.add local.get $y f64.le br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f64.add f64.le if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f64.add f64.le br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f64.add f64.le br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f64.add f64.le br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+
+  (func (export "f64.ge") (param $a i32) (param $b i32) (param $z i32) (result i32)
+    (local $x f64) (local $y f64) (local $zz f64) (local $k i32) (local $m i32)
+    local.get $a f64.convert_i32_s local.set $x  local.get $b f64.convert_i32_s local.set $y  local.get $z f64.convert_i32_s local.set $zz
+    local.get $b i32.const 999 i32.eq if f64.const nan local.set $y end
+    ;; _ss
+    local.get $x local.get $y f64.ge if local.get $m i32.const 1 i32.or local.set $m end
+    local.get $m i32.const 2 i32.or local.set $m  block local.get $x local.get $y f64.ge br_if 0 local.get $m i32.const 2 i32.xor local.set $m end
+    block (result i32) i32.const 4 local.get $x local.get $y f64.ge br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y f64.ge br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 8 i32.or local.set $m end
+    ;; _rs
+    local.get $x local.get $zz f64.add local.get $y f64.ge if local.get $m i32.const 16 i32.or local.set $m end
+    local.get $m i32.const 32 i32.or local.set $m  block local.get $x local.get $zz f64.add local.get $y f64.ge br_if 0 local.get $m i32.const 32 i32.xor local.set $m end
+    block (result i32) i32.const 64 local.get $x local.get $zz f64.add local.get $y f64.ge br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $zz f64.add local.get $y f64.ge br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 128 i32.or local.set $m end
+    ;; _sr
+    local.get $x local.get $y local.get $zz f64.add f64.ge if local.get $m i32.const 256 i32.or local.set $m end
+    local.get $m i32.const 512 i32.or local.set $m  block local.get $x local.get $y local.get $zz f64.add f64.ge br_if 0 local.get $m i32.const 512 i32.xor local.set $m end
+    block (result i32) i32.const 1024 local.get $x local.get $y local.get $zz f64.add f64.ge br_if 0 drop i32.const 0 end local.get $m i32.or local.set $m
+    i32.const 0 local.set $k  block loop local.get $k i32.const 1 i32.add local.tee $k i32.const 2 i32.ge_u br_if 1 local.get $x local.get $y local.get $zz f64.add f64.ge br_if 0 end end
+    local.get $k i32.const 2 i32.eq if local.get $m i32.const 2048 i32.or local.set $m end
+    local.get $m)
+)
@@ -0,0 +1,164 @@
+;; enough functions to spread over several compile threads (m3_CompileModuleParallel); $fK (x) = x * K + K
+(module
+  (func $f1 (param i32) (result i32)
+    local.get 0
+    i32.const 1
+    i32.mul
+    i32.const 1
+    i32.add)
+
+  (func $f2 (param i32) (result i32)
+    local.get 0
+    i32.const 2
+    i32.mul
+    i32.const 2
+    i32.add)
+
+  (func $f3 (param i32) (result i32)
+    local.get 0
+    i32.const 3
+    i32.mul
+    i32.const 3
+    i32.add)
+
+  (func $f4 (param i32) (result i32)
+    local.get 0
+    i32.const 4
+    i32.mul
+    i32.const 4
+    i32.add)
+
+  (func $f5 (param i32) (result i32)
+    local.get 0
+    i32.const 5
+    i32.mul
+    i32.const 5
+    i32.add)
+
+  (func $f6 (param i32) (result i32)
+    local.get 0
+    i32.const 6
+    i32.mul
+    i32.const 6
+    i32.add)
+
+  (func $f7 (param i32) (result i32)
+    local.get 0
+    i32.const 7
+    i32.mul
+    i32.const 7
+    i32.add)
+
+  (func $f8 (param i32) (result i32)
+    local.get 0
+    i32.const 8
+    i32.mul
+    i32.const 8
+    i32.add)
+
+  (func $f9 (param i32) (result i32)
+    local.get 0
+    i32.const 9
+    i32.mul
+    i32.const 9
+    i32.add)
+
+  (func $f10 (param i32) (result i32)
+    local.get 0
+    i32.const 10
+    i32.mul
+    i32.const 10
+    i32.add)
+
+  (func $f11 (param i32) (result i32)
+    local.get 0
+    i32.const 11
+    i32.mul
+    i32.const 11
+    i32.add)
+
+  (func $f12 (param i32) (result i32)
+    local.get 0
+    i32.const 12
+    i32.mul
+    i32.const 12
+    i32.add)
+
+  (func $f13 (param i32) (result i32)
+    local.get 0
+    i32.const 13
+    i32.mul
+    i32.const 13
+    i32.add)
+
+  (func $f14 (param i32) (result i32)
+    local.get 0
+    i32.const 14
+    i32.mul
+    i32.const 14
+    i32.add)
+
+  (func $f15 (param i32) (result i32)
+    local.get 0
+    i32.const 15
+    i32.mul
+    i32.const 15
+    i32.add)
+
+  (func $f16 (param i32) (result i32)
+    local.get 0
+    i32.const 16
+    i32.mul
+    i32.const 16
+    i32.add)
+
+  ;; (x + 1) * 136
+  (func (export "sum") (param i32) (result i32)
+    local.get 0
+    call $f1
+    local.get 0
+    call $f2
+    i32.add
+    local.get 0
+    call $f3
+    i32.add
+    local.get 0
+    call $f4
+    i32.add
+    local.get 0
+    call $f5
+    i32.add
+    local.get 0
+    call $f6
+    i32.add
+    local.get 0
+    call $f7
+    i32.add
+    local.get 0
+    call $f8
+    i32.add
+    local.get 0
+    call $f9
+    i32.add
+    local.get 0
+    call $f10
+    i32.add
+    local.get 0
+    call $f11
+    i32.add
+    local.get 0
+    call $f12
+    i32.add
+    local.get 0
+    call $f13
+    i32.add
+    local.get 0
+    call $f14
+    i32.add
+    local.get 0
+    call $f15
+    i32.add
+    local.get 0
+    call $f16
+    i32.add)
+)
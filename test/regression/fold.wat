@@ -0,0 +1,2926 @@
+;; every integer operator that the compiler folds. each has an export that takes its operands as parameters, so
+;; there's nothing to fold, and one that folds the ith pair of constants ("folded"). the operators that are
+;; strength-reduced also have the ith constant as the right operand ("by"); the multiplier can be the left ("of").
+;; the test checks that they agree, traps included. generated by a script; the constants are s_foldConstants in
+;; m3_test.c.
+(module
+  (func (export "i32.add") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.add)
+
+  (func (export "i32.add.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.add return
+    end i32.const 0 i32.const 1 i32.add return
+    end i32.const 0 i32.const -1 i32.add return
+    end i32.const 0 i32.const 33 i32.add return
+    end i32.const 0 i32.const -2147483648 i32.add return
+    end i32.const 0 i32.const 0 i32.add return
+    end i32.const 1 i32.const 0 i32.add return
+    end i32.const 1 i32.const 1 i32.add return
+    end i32.const 1 i32.const -1 i32.add return
+    end i32.const 1 i32.const 33 i32.add return
+    end i32.const 1 i32.const -2147483648 i32.add return
+    end i32.const 1 i32.const 0 i32.add return
+    end i32.const -1 i32.const 0 i32.add return
+    end i32.const -1 i32.const 1 i32.add return
+    end i32.const -1 i32.const -1 i32.add return
+    end i32.const -1 i32.const 33 i32.add return
+    end i32.const -1 i32.const -2147483648 i32.add return
+    end i32.const -1 i32.const 0 i32.add return
+    end i32.const 33 i32.const 0 i32.add return
+    end i32.const 33 i32.const 1 i32.add return
+    end i32.const 33 i32.const -1 i32.add return
+    end i32.const 33 i32.const 33 i32.add return
+    end i32.const 33 i32.const -2147483648 i32.add return
+    end i32.const 33 i32.const 0 i32.add return
+    end i32.const -2147483648 i32.const 0 i32.add return
+    end i32.const -2147483648 i32.const 1 i32.add return
+    end i32.const -2147483648 i32.const -1 i32.add return
+    end i32.const -2147483648 i32.const 33 i32.add return
+    end i32.const -2147483648 i32.const -2147483648 i32.add return
+    end i32.const -2147483648 i32.const 0 i32.add return
+    end i32.const 0 i32.const 0 i32.add return
+    end i32.const 0 i32.const 1 i32.add return
+    end i32.const 0 i32.const -1 i32.add return
+    end i32.const 0 i32.const 33 i32.add return
+    end i32.const 0 i32.const -2147483648 i32.add return
+    end i32.const 0 i32.const 0 i32.add return
+    end unreachable)
+
+  (func (export "i32.sub") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.sub)
+
+  (func (export "i32.sub.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.sub return
+    end i32.const 0 i32.const 1 i32.sub return
+    end i32.const 0 i32.const -1 i32.sub return
+    end i32.const 0 i32.const 33 i32.sub return
+    end i32.const 0 i32.const -2147483648 i32.sub return
+    end i32.const 0 i32.const 0 i32.sub return
+    end i32.const 1 i32.const 0 i32.sub return
+    end i32.const 1 i32.const 1 i32.sub return
+    end i32.const 1 i32.const -1 i32.sub return
+    end i32.const 1 i32.const 33 i32.sub return
+    end i32.const 1 i32.const -2147483648 i32.sub return
+    end i32.const 1 i32.const 0 i32.sub return
+    end i32.const -1 i32.const 0 i32.sub return
+    end i32.const -1 i32.const 1 i32.sub return
+    end i32.const -1 i32.const -1 i32.sub return
+    end i32.const -1 i32.const 33 i32.sub return
+    end i32.const -1 i32.const -2147483648 i32.sub return
+    end i32.const -1 i32.const 0 i32.sub return
+    end i32.const 33 i32.const 0 i32.sub return
+    end i32.const 33 i32.const 1 i32.sub return
+    end i32.const 33 i32.const -1 i32.sub return
+    end i32.const 33 i32.const 33 i32.sub return
+    end i32.const 33 i32.const -2147483648 i32.sub return
+    end i32.const 33 i32.const 0 i32.sub return
+    end i32.const -2147483648 i32.const 0 i32.sub return
+    end i32.const -2147483648 i32.const 1 i32.sub return
+    end i32.const -2147483648 i32.const -1 i32.sub return
+    end i32.const -2147483648 i32.const 33 i32.sub return
+    end i32.const -2147483648 i32.const -2147483648 i32.sub return
+    end i32.const -2147483648 i32.const 0 i32.sub return
+    end i32.const 0 i32.const 0 i32.sub return
+    end i32.const 0 i32.const 1 i32.sub return
+    end i32.const 0 i32.const -1 i32.sub return
+    end i32.const 0 i32.const 33 i32.sub return
+    end i32.const 0 i32.const -2147483648 i32.sub return
+    end i32.const 0 i32.const 0 i32.sub return
+    end unreachable)
+
+  (func (export "i32.mul") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.mul)
+
+  (func (export "i32.mul.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.mul return
+    end i32.const 0 i32.const 1 i32.mul return
+    end i32.const 0 i32.const -1 i32.mul return
+    end i32.const 0 i32.const 33 i32.mul return
+    end i32.const 0 i32.const -2147483648 i32.mul return
+    end i32.const 0 i32.const 0 i32.mul return
+    end i32.const 1 i32.const 0 i32.mul return
+    end i32.const 1 i32.const 1 i32.mul return
+    end i32.const 1 i32.const -1 i32.mul return
+    end i32.const 1 i32.const 33 i32.mul return
+    end i32.const 1 i32.const -2147483648 i32.mul return
+    end i32.const 1 i32.const 0 i32.mul return
+    end i32.const -1 i32.const 0 i32.mul return
+    end i32.const -1 i32.const 1 i32.mul return
+    end i32.const -1 i32.const -1 i32.mul return
+    end i32.const -1 i32.const 33 i32.mul return
+    end i32.const -1 i32.const -2147483648 i32.mul return
+    end i32.const -1 i32.const 0 i32.mul return
+    end i32.const 33 i32.const 0 i32.mul return
+    end i32.const 33 i32.const 1 i32.mul return
+    end i32.const 33 i32.const -1 i32.mul return
+    end i32.const 33 i32.const 33 i32.mul return
+    end i32.const 33 i32.const -2147483648 i32.mul return
+    end i32.const 33 i32.const 0 i32.mul return
+    end i32.const -2147483648 i32.const 0 i32.mul return
+    end i32.const -2147483648 i32.const 1 i32.mul return
+    end i32.const -2147483648 i32.const -1 i32.mul return
+    end i32.const -2147483648 i32.const 33 i32.mul return
+    end i32.const -2147483648 i32.const -2147483648 i32.mul return
+    end i32.const -2147483648 i32.const 0 i32.mul return
+    end i32.const 0 i32.const 0 i32.mul return
+    end i32.const 0 i32.const 1 i32.mul return
+    end i32.const 0 i32.const -1 i32.mul return
+    end i32.const 0 i32.const 33 i32.mul return
+    end i32.const 0 i32.const -2147483648 i32.mul return
+    end i32.const 0 i32.const 0 i32.mul return
+    end unreachable)
+
+  (func (export "i32.mul.by") (param $i i32) (param $a i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i32.const 0 i32.mul return
+    end local.get $a i32.const 1 i32.mul return
+    end local.get $a i32.const -1 i32.mul return
+    end local.get $a i32.const 33 i32.mul return
+    end local.get $a i32.const -2147483648 i32.mul return
+    end local.get $a i32.const 0 i32.mul return
+    end local.get $a i32.const 2 i32.mul return
+    end local.get $a i32.const 3 i32.mul return
+    end local.get $a i32.const 7 i32.mul return
+    end local.get $a i32.const -7 i32.mul return
+    end local.get $a i32.const 10 i32.mul return
+    end local.get $a i32.const 16 i32.mul return
+    end local.get $a i32.const 641 i32.mul return
+    end local.get $a i32.const -1000003 i32.mul return
+    end local.get $a i32.const 2147483647 i32.mul return
+    end local.get $a i32.const -1 i32.mul return
+    end local.get $a i32.const 0 i32.mul return
+    end local.get $a i32.const 878082202 i32.mul return
+    end local.get $a i32.const -1 i32.mul return
+    end unreachable)
+
+  (func (export "i32.mul.of") (param $i i32) (param $a i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 local.get $a i32.mul return
+    end i32.const 1 local.get $a i32.mul return
+    end i32.const -1 local.get $a i32.mul return
+    end i32.const 33 local.get $a i32.mul return
+    end i32.const -2147483648 local.get $a i32.mul return
+    end i32.const 0 local.get $a i32.mul return
+    end i32.const 2 local.get $a i32.mul return
+    end i32.const 3 local.get $a i32.mul return
+    end i32.const 7 local.get $a i32.mul return
+    end i32.const -7 local.get $a i32.mul return
+    end i32.const 10 local.get $a i32.mul return
+    end i32.const 16 local.get $a i32.mul return
+    end i32.const 641 local.get $a i32.mul return
+    end i32.const -1000003 local.get $a i32.mul return
+    end i32.const 2147483647 local.get $a i32.mul return
+    end i32.const -1 local.get $a i32.mul return
+    end i32.const 0 local.get $a i32.mul return
+    end i32.const 878082202 local.get $a i32.mul return
+    end i32.const -1 local.get $a i32.mul return
+    end unreachable)
+
+  (func (export "i32.div_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.div_s)
+
+  (func (export "i32.div_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.div_s return
+    end i32.const 0 i32.const 1 i32.div_s return
+    end i32.const 0 i32.const -1 i32.div_s return
+    end i32.const 0 i32.const 33 i32.div_s return
+    end i32.const 0 i32.const -2147483648 i32.div_s return
+    end i32.const 0 i32.const 0 i32.div_s return
+    end i32.const 1 i32.const 0 i32.div_s return
+    end i32.const 1 i32.const 1 i32.div_s return
+    end i32.const 1 i32.const -1 i32.div_s return
+    end i32.const 1 i32.const 33 i32.div_s return
+    end i32.const 1 i32.const -2147483648 i32.div_s return
+    end i32.const 1 i32.const 0 i32.div_s return
+    end i32.const -1 i32.const 0 i32.div_s return
+    end i32.const -1 i32.const 1 i32.div_s return
+    end i32.const -1 i32.const -1 i32.div_s return
+    end i32.const -1 i32.const 33 i32.div_s return
+    end i32.const -1 i32.const -2147483648 i32.div_s return
+    end i32.const -1 i32.const 0 i32.div_s return
+    end i32.const 33 i32.const 0 i32.div_s return
+    end i32.const 33 i32.const 1 i32.div_s return
+    end i32.const 33 i32.const -1 i32.div_s return
+    end i32.const 33 i32.const 33 i32.div_s return
+    end i32.const 33 i32.const -2147483648 i32.div_s return
+    end i32.const 33 i32.const 0 i32.div_s return
+    end i32.const -2147483648 i32.const 0 i32.div_s return
+    end i32.const -2147483648 i32.const 1 i32.div_s return
+    end i32.const -2147483648 i32.const -1 i32.div_s return
+    end i32.const -2147483648 i32.const 33 i32.div_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.div_s return
+    end i32.const -2147483648 i32.const 0 i32.div_s return
+    end i32.const 0 i32.const 0 i32.div_s return
+    end i32.const 0 i32.const 1 i32.div_s return
+    end i32.const 0 i32.const -1 i32.div_s return
+    end i32.const 0 i32.const 33 i32.div_s return
+    end i32.const 0 i32.const -2147483648 i32.div_s return
+    end i32.const 0 i32.const 0 i32.div_s return
+    end unreachable)
+
+  (func (export "i32.div_s.by") (param $i i32) (param $a i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i32.const 0 i32.div_s return
+    end local.get $a i32.const 1 i32.div_s return
+    end local.get $a i32.const -1 i32.div_s return
+    end local.get $a i32.const 33 i32.div_s return
+    end local.get $a i32.const -2147483648 i32.div_s return
+    end local.get $a i32.const 0 i32.div_s return
+    end local.get $a i32.const 2 i32.div_s return
+    end local.get $a i32.const 3 i32.div_s return
+    end local.get $a i32.const 7 i32.div_s return
+    end local.get $a i32.const -7 i32.div_s return
+    end local.get $a i32.const 10 i32.div_s return
+    end local.get $a i32.const 16 i32.div_s return
+    end local.get $a i32.const 641 i32.div_s return
+    end local.get $a i32.const -1000003 i32.div_s return
+    end local.get $a i32.const 2147483647 i32.div_s return
+    end local.get $a i32.const -1 i32.div_s return
+    end local.get $a i32.const 0 i32.div_s return
+    end local.get $a i32.const 878082202 i32.div_s return
+    end local.get $a i32.const -1 i32.div_s return
+    end unreachable)
+
+  (func (export "i32.div_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.div_u)
+
+  (func (export "i32.div_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.div_u return
+    end i32.const 0 i32.const 1 i32.div_u return
+    end i32.const 0 i32.const -1 i32.div_u return
+    end i32.const 0 i32.const 33 i32.div_u return
+    end i32.const 0 i32.const -2147483648 i32.div_u return
+    end i32.const 0 i32.const 0 i32.div_u return
+    end i32.const 1 i32.const 0 i32.div_u return
+    end i32.const 1 i32.const 1 i32.div_u return
+    end i32.const 1 i32.const -1 i32.div_u return
+    end i32.const 1 i32.const 33 i32.div_u return
+    end i32.const 1 i32.const -2147483648 i32.div_u return
+    end i32.const 1 i32.const 0 i32.div_u return
+    end i32.const -1 i32.const 0 i32.div_u return
+    end i32.const -1 i32.const 1 i32.div_u return
+    end i32.const -1 i32.const -1 i32.div_u return
+    end i32.const -1 i32.const 33 i32.div_u return
+    end i32.const -1 i32.const -2147483648 i32.div_u return
+    end i32.const -1 i32.const 0 i32.div_u return
+    end i32.const 33 i32.const 0 i32.div_u return
+    end i32.const 33 i32.const 1 i32.div_u return
+    end i32.const 33 i32.const -1 i32.div_u return
+    end i32.const 33 i32.const 33 i32.div_u return
+    end i32.const 33 i32.const -2147483648 i32.div_u return
+    end i32.const 33 i32.const 0 i32.div_u return
+    end i32.const -2147483648 i32.const 0 i32.div_u return
+    end i32.const -2147483648 i32.const 1 i32.div_u return
+    end i32.const -2147483648 i32.const -1 i32.div_u return
+    end i32.const -2147483648 i32.const 33 i32.div_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.div_u return
+    end i32.const -2147483648 i32.const 0 i32.div_u return
+    end i32.const 0 i32.const 0 i32.div_u return
+    end i32.const 0 i32.const 1 i32.div_u return
+    end i32.const 0 i32.const -1 i32.div_u return
+    end i32.const 0 i32.const 33 i32.div_u return
+    end i32.const 0 i32.const -2147483648 i32.div_u return
+    end i32.const 0 i32.const 0 i32.div_u return
+    end unreachable)
+
+  (func (export "i32.div_u.by") (param $i i32) (param $a i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i32.const 0 i32.div_u return
+    end local.get $a i32.const 1 i32.div_u return
+    end local.get $a i32.const -1 i32.div_u return
+    end local.get $a i32.const 33 i32.div_u return
+    end local.get $a i32.const -2147483648 i32.div_u return
+    end local.get $a i32.const 0 i32.div_u return
+    end local.get $a i32.const 2 i32.div_u return
+    end local.get $a i32.const 3 i32.div_u return
+    end local.get $a i32.const 7 i32.div_u return
+    end local.get $a i32.const -7 i32.div_u return
+    end local.get $a i32.const 10 i32.div_u return
+    end local.get $a i32.const 16 i32.div_u return
+    end local.get $a i32.const 641 i32.div_u return
+    end local.get $a i32.const -1000003 i32.div_u return
+    end local.get $a i32.const 2147483647 i32.div_u return
+    end local.get $a i32.const -1 i32.div_u return
+    end local.get $a i32.const 0 i32.div_u return
+    end local.get $a i32.const 878082202 i32.div_u return
+    end local.get $a i32.const -1 i32.div_u return
+    end unreachable)
+
+  (func (export "i32.rem_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.rem_s)
+
+  (func (export "i32.rem_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.rem_s return
+    end i32.const 0 i32.const 1 i32.rem_s return
+    end i32.const 0 i32.const -1 i32.rem_s return
+    end i32.const 0 i32.const 33 i32.rem_s return
+    end i32.const 0 i32.const -2147483648 i32.rem_s return
+    end i32.const 0 i32.const 0 i32.rem_s return
+    end i32.const 1 i32.const 0 i32.rem_s return
+    end i32.const 1 i32.const 1 i32.rem_s return
+    end i32.const 1 i32.const -1 i32.rem_s return
+    end i32.const 1 i32.const 33 i32.rem_s return
+    end i32.const 1 i32.const -2147483648 i32.rem_s return
+    end i32.const 1 i32.const 0 i32.rem_s return
+    end i32.const -1 i32.const 0 i32.rem_s return
+    end i32.const -1 i32.const 1 i32.rem_s return
+    end i32.const -1 i32.const -1 i32.rem_s return
+    end i32.const -1 i32.const 33 i32.rem_s return
+    end i32.const -1 i32.const -2147483648 i32.rem_s return
+    end i32.const -1 i32.const 0 i32.rem_s return
+    end i32.const 33 i32.const 0 i32.rem_s return
+    end i32.const 33 i32.const 1 i32.rem_s return
+    end i32.const 33 i32.const -1 i32.rem_s return
+    end i32.const 33 i32.const 33 i32.rem_s return
+    end i32.const 33 i32.const -2147483648 i32.rem_s return
+    end i32.const 33 i32.const 0 i32.rem_s return
+    end i32.const -2147483648 i32.const 0 i32.rem_s return
+    end i32.const -2147483648 i32.const 1 i32.rem_s return
+    end i32.const -2147483648 i32.const -1 i32.rem_s return
+    end i32.const -2147483648 i32.const 33 i32.rem_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.rem_s return
+    end i32.const -2147483648 i32.const 0 i32.rem_s return
+    end i32.const 0 i32.const 0 i32.rem_s return
+    end i32.const 0 i32.const 1 i32.rem_s return
+    end i32.const 0 i32.const -1 i32.rem_s return
+    end i32.const 0 i32.const 33 i32.rem_s return
+    end i32.const 0 i32.const -2147483648 i32.rem_s return
+    end i32.const 0 i32.const 0 i32.rem_s return
+    end unreachable)
+
+  (func (export "i32.rem_s.by") (param $i i32) (param $a i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i32.const 0 i32.rem_s return
+    end local.get $a i32.const 1 i32.rem_s return
+    end local.get $a i32.const -1 i32.rem_s return
+    end local.get $a i32.const 33 i32.rem_s return
+    end local.get $a i32.const -2147483648 i32.rem_s return
+    end local.get $a i32.const 0 i32.rem_s return
+    end local.get $a i32.const 2 i32.rem_s return
+    end local.get $a i32.const 3 i32.rem_s return
+    end local.get $a i32.const 7 i32.rem_s return
+    end local.get $a i32.const -7 i32.rem_s return
+    end local.get $a i32.const 10 i32.rem_s return
+    end local.get $a i32.const 16 i32.rem_s return
+    end local.get $a i32.const 641 i32.rem_s return
+    end local.get $a i32.const -1000003 i32.rem_s return
+    end local.get $a i32.const 2147483647 i32.rem_s return
+    end local.get $a i32.const -1 i32.rem_s return
+    end local.get $a i32.const 0 i32.rem_s return
+    end local.get $a i32.const 878082202 i32.rem_s return
+    end local.get $a i32.const -1 i32.rem_s return
+    end unreachable)
+
+  (func (export "i32.rem_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.rem_u)
+
+  (func (export "i32.rem_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.rem_u return
+    end i32.const 0 i32.const 1 i32.rem_u return
+    end i32.const 0 i32.const -1 i32.rem_u return
+    end i32.const 0 i32.const 33 i32.rem_u return
+    end i32.const 0 i32.const -2147483648 i32.rem_u return
+    end i32.const 0 i32.const 0 i32.rem_u return
+    end i32.const 1 i32.const 0 i32.rem_u return
+    end i32.const 1 i32.const 1 i32.rem_u return
+    end i32.const 1 i32.const -1 i32.rem_u return
+    end i32.const 1 i32.const 33 i32.rem_u return
+    end i32.const 1 i32.const -2147483648 i32.rem_u return
+    end i32.const 1 i32.const 0 i32.rem_u return
+    end i32.const -1 i32.const 0 i32.rem_u return
+    end i32.const -1 i32.const 1 i32.rem_u return
+    end i32.const -1 i32.const -1 i32.rem_u return
+    end i32.const -1 i32.const 33 i32.rem_u return
+    end i32.const -1 i32.const -2147483648 i32.rem_u return
+    end i32.const -1 i32.const 0 i32.rem_u return
+    end i32.const 33 i32.const 0 i32.rem_u return
+    end i32.const 33 i32.const 1 i32.rem_u return
+    end i32.const 33 i32.const -1 i32.rem_u return
+    end i32.const 33 i32.const 33 i32.rem_u return
+    end i32.const 33 i32.const -2147483648 i32.rem_u return
+    end i32.const 33 i32.const 0 i32.rem_u return
+    end i32.const -2147483648 i32.const 0 i32.rem_u return
+    end i32.const -2147483648 i32.const 1 i32.rem_u return
+    end i32.const -2147483648 i32.const -1 i32.rem_u return
+    end i32.const -2147483648 i32.const 33 i32.rem_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.rem_u return
+    end i32.const -2147483648 i32.const 0 i32.rem_u return
+    end i32.const 0 i32.const 0 i32.rem_u return
+    end i32.const 0 i32.const 1 i32.rem_u return
+    end i32.const 0 i32.const -1 i32.rem_u return
+    end i32.const 0 i32.const 33 i32.rem_u return
+    end i32.const 0 i32.const -2147483648 i32.rem_u return
+    end i32.const 0 i32.const 0 i32.rem_u return
+    end unreachable)
+
+  (func (export "i32.rem_u.by") (param $i i32) (param $a i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i32.const 0 i32.rem_u return
+    end local.get $a i32.const 1 i32.rem_u return
+    end local.get $a i32.const -1 i32.rem_u return
+    end local.get $a i32.const 33 i32.rem_u return
+    end local.get $a i32.const -2147483648 i32.rem_u return
+    end local.get $a i32.const 0 i32.rem_u return
+    end local.get $a i32.const 2 i32.rem_u return
+    end local.get $a i32.const 3 i32.rem_u return
+    end local.get $a i32.const 7 i32.rem_u return
+    end local.get $a i32.const -7 i32.rem_u return
+    end local.get $a i32.const 10 i32.rem_u return
+    end local.get $a i32.const 16 i32.rem_u return
+    end local.get $a i32.const 641 i32.rem_u return
+    end local.get $a i32.const -1000003 i32.rem_u return
+    end local.get $a i32.const 2147483647 i32.rem_u return
+    end local.get $a i32.const -1 i32.rem_u return
+    end local.get $a i32.const 0 i32.rem_u return
+    end local.get $a i32.const 878082202 i32.rem_u return
+    end local.get $a i32.const -1 i32.rem_u return
+    end unreachable)
+
+  (func (export "i32.and") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.and)
+
+  (func (export "i32.and.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.and return
+    end i32.const 0 i32.const 1 i32.and return
+    end i32.const 0 i32.const -1 i32.and return
+    end i32.const 0 i32.const 33 i32.and return
+    end i32.const 0 i32.const -2147483648 i32.and return
+    end i32.const 0 i32.const 0 i32.and return
+    end i32.const 1 i32.const 0 i32.and return
+    end i32.const 1 i32.const 1 i32.and return
+    end i32.const 1 i32.const -1 i32.and return
+    end i32.const 1 i32.const 33 i32.and return
+    end i32.const 1 i32.const -2147483648 i32.and return
+    end i32.const 1 i32.const 0 i32.and return
+    end i32.const -1 i32.const 0 i32.and return
+    end i32.const -1 i32.const 1 i32.and return
+    end i32.const -1 i32.const -1 i32.and return
+    end i32.const -1 i32.const 33 i32.and return
+    end i32.const -1 i32.const -2147483648 i32.and return
+    end i32.const -1 i32.const 0 i32.and return
+    end i32.const 33 i32.const 0 i32.and return
+    end i32.const 33 i32.const 1 i32.and return
+    end i32.const 33 i32.const -1 i32.and return
+    end i32.const 33 i32.const 33 i32.and return
+    end i32.const 33 i32.const -2147483648 i32.and return
+    end i32.const 33 i32.const 0 i32.and return
+    end i32.const -2147483648 i32.const 0 i32.and return
+    end i32.const -2147483648 i32.const 1 i32.and return
+    end i32.const -2147483648 i32.const -1 i32.and return
+    end i32.const -2147483648 i32.const 33 i32.and return
+    end i32.const -2147483648 i32.const -2147483648 i32.and return
+    end i32.const -2147483648 i32.const 0 i32.and return
+    end i32.const 0 i32.const 0 i32.and return
+    end i32.const 0 i32.const 1 i32.and return
+    end i32.const 0 i32.const -1 i32.and return
+    end i32.const 0 i32.const 33 i32.and return
+    end i32.const 0 i32.const -2147483648 i32.and return
+    end i32.const 0 i32.const 0 i32.and return
+    end unreachable)
+
+  (func (export "i32.or") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.or)
+
+  (func (export "i32.or.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.or return
+    end i32.const 0 i32.const 1 i32.or return
+    end i32.const 0 i32.const -1 i32.or return
+    end i32.const 0 i32.const 33 i32.or return
+    end i32.const 0 i32.const -2147483648 i32.or return
+    end i32.const 0 i32.const 0 i32.or return
+    end i32.const 1 i32.const 0 i32.or return
+    end i32.const 1 i32.const 1 i32.or return
+    end i32.const 1 i32.const -1 i32.or return
+    end i32.const 1 i32.const 33 i32.or return
+    end i32.const 1 i32.const -2147483648 i32.or return
+    end i32.const 1 i32.const 0 i32.or return
+    end i32.const -1 i32.const 0 i32.or return
+    end i32.const -1 i32.const 1 i32.or return
+    end i32.const -1 i32.const -1 i32.or return
+    end i32.const -1 i32.const 33 i32.or return
+    end i32.const -1 i32.const -2147483648 i32.or return
+    end i32.const -1 i32.const 0 i32.or return
+    end i32.const 33 i32.const 0 i32.or return
+    end i32.const 33 i32.const 1 i32.or return
+    end i32.const 33 i32.const -1 i32.or return
+    end i32.const 33 i32.const 33 i32.or return
+    end i32.const 33 i32.const -2147483648 i32.or return
+    end i32.const 33 i32.const 0 i32.or return
+    end i32.const -2147483648 i32.const 0 i32.or return
+    end i32.const -2147483648 i32.const 1 i32.or return
+    end i32.const -2147483648 i32.const -1 i32.or return
+    end i32.const -2147483648 i32.const 33 i32.or return
+    end i32.const -2147483648 i32.const -2147483648 i32.or return
+    end i32.const -2147483648 i32.const 0 i32.or return
+    end i32.const 0 i32.const 0 i32.or return
+    end i32.const 0 i32.const 1 i32.or return
+    end i32.const 0 i32.const -1 i32.or return
+    end i32.const 0 i32.const 33 i32.or return
+    end i32.const 0 i32.const -2147483648 i32.or return
+    end i32.const 0 i32.const 0 i32.or return
+    end unreachable)
+
+  (func (export "i32.xor") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.xor)
+
+  (func (export "i32.xor.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.xor return
+    end i32.const 0 i32.const 1 i32.xor return
+    end i32.const 0 i32.const -1 i32.xor return
+    end i32.const 0 i32.const 33 i32.xor return
+    end i32.const 0 i32.const -2147483648 i32.xor return
+    end i32.const 0 i32.const 0 i32.xor return
+    end i32.const 1 i32.const 0 i32.xor return
+    end i32.const 1 i32.const 1 i32.xor return
+    end i32.const 1 i32.const -1 i32.xor return
+    end i32.const 1 i32.const 33 i32.xor return
+    end i32.const 1 i32.const -2147483648 i32.xor return
+    end i32.const 1 i32.const 0 i32.xor return
+    end i32.const -1 i32.const 0 i32.xor return
+    end i32.const -1 i32.const 1 i32.xor return
+    end i32.const -1 i32.const -1 i32.xor return
+    end i32.const -1 i32.const 33 i32.xor return
+    end i32.const -1 i32.const -2147483648 i32.xor return
+    end i32.const -1 i32.const 0 i32.xor return
+    end i32.const 33 i32.const 0 i32.xor return
+    end i32.const 33 i32.const 1 i32.xor return
+    end i32.const 33 i32.const -1 i32.xor return
+    end i32.const 33 i32.const 33 i32.xor return
+    end i32.const 33 i32.const -2147483648 i32.xor return
+    end i32.const 33 i32.const 0 i32.xor return
+    end i32.const -2147483648 i32.const 0 i32.xor return
+    end i32.const -2147483648 i32.const 1 i32.xor return
+    end i32.const -2147483648 i32.const -1 i32.xor return
+    end i32.const -2147483648 i32.const 33 i32.xor return
+    end i32.const -2147483648 i32.const -2147483648 i32.xor return
+    end i32.const -2147483648 i32.const 0 i32.xor return
+    end i32.const 0 i32.const 0 i32.xor return
+    end i32.const 0 i32.const 1 i32.xor return
+    end i32.const 0 i32.const -1 i32.xor return
+    end i32.const 0 i32.const 33 i32.xor return
+    end i32.const 0 i32.const -2147483648 i32.xor return
+    end i32.const 0 i32.const 0 i32.xor return
+    end unreachable)
+
+  (func (export "i32.shl") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.shl)
+
+  (func (export "i32.shl.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.shl return
+    end i32.const 0 i32.const 1 i32.shl return
+    end i32.const 0 i32.const -1 i32.shl return
+    end i32.const 0 i32.const 33 i32.shl return
+    end i32.const 0 i32.const -2147483648 i32.shl return
+    end i32.const 0 i32.const 0 i32.shl return
+    end i32.const 1 i32.const 0 i32.shl return
+    end i32.const 1 i32.const 1 i32.shl return
+    end i32.const 1 i32.const -1 i32.shl return
+    end i32.const 1 i32.const 33 i32.shl return
+    end i32.const 1 i32.const -2147483648 i32.shl return
+    end i32.const 1 i32.const 0 i32.shl return
+    end i32.const -1 i32.const 0 i32.shl return
+    end i32.const -1 i32.const 1 i32.shl return
+    end i32.const -1 i32.const -1 i32.shl return
+    end i32.const -1 i32.const 33 i32.shl return
+    end i32.const -1 i32.const -2147483648 i32.shl return
+    end i32.const -1 i32.const 0 i32.shl return
+    end i32.const 33 i32.const 0 i32.shl return
+    end i32.const 33 i32.const 1 i32.shl return
+    end i32.const 33 i32.const -1 i32.shl return
+    end i32.const 33 i32.const 33 i32.shl return
+    end i32.const 33 i32.const -2147483648 i32.shl return
+    end i32.const 33 i32.const 0 i32.shl return
+    end i32.const -2147483648 i32.const 0 i32.shl return
+    end i32.const -2147483648 i32.const 1 i32.shl return
+    end i32.const -2147483648 i32.const -1 i32.shl return
+    end i32.const -2147483648 i32.const 33 i32.shl return
+    end i32.const -2147483648 i32.const -2147483648 i32.shl return
+    end i32.const -2147483648 i32.const 0 i32.shl return
+    end i32.const 0 i32.const 0 i32.shl return
+    end i32.const 0 i32.const 1 i32.shl return
+    end i32.const 0 i32.const -1 i32.shl return
+    end i32.const 0 i32.const 33 i32.shl return
+    end i32.const 0 i32.const -2147483648 i32.shl return
+    end i32.const 0 i32.const 0 i32.shl return
+    end unreachable)
+
+  (func (export "i32.shr_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.shr_s)
+
+  (func (export "i32.shr_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.shr_s return
+    end i32.const 0 i32.const 1 i32.shr_s return
+    end i32.const 0 i32.const -1 i32.shr_s return
+    end i32.const 0 i32.const 33 i32.shr_s return
+    end i32.const 0 i32.const -2147483648 i32.shr_s return
+    end i32.const 0 i32.const 0 i32.shr_s return
+    end i32.const 1 i32.const 0 i32.shr_s return
+    end i32.const 1 i32.const 1 i32.shr_s return
+    end i32.const 1 i32.const -1 i32.shr_s return
+    end i32.const 1 i32.const 33 i32.shr_s return
+    end i32.const 1 i32.const -2147483648 i32.shr_s return
+    end i32.const 1 i32.const 0 i32.shr_s return
+    end i32.const -1 i32.const 0 i32.shr_s return
+    end i32.const -1 i32.const 1 i32.shr_s return
+    end i32.const -1 i32.const -1 i32.shr_s return
+    end i32.const -1 i32.const 33 i32.shr_s return
+    end i32.const -1 i32.const -2147483648 i32.shr_s return
+    end i32.const -1 i32.const 0 i32.shr_s return
+    end i32.const 33 i32.const 0 i32.shr_s return
+    end i32.const 33 i32.const 1 i32.shr_s return
+    end i32.const 33 i32.const -1 i32.shr_s return
+    end i32.const 33 i32.const 33 i32.shr_s return
+    end i32.const 33 i32.const -2147483648 i32.shr_s return
+    end i32.const 33 i32.const 0 i32.shr_s return
+    end i32.const -2147483648 i32.const 0 i32.shr_s return
+    end i32.const -2147483648 i32.const 1 i32.shr_s return
+    end i32.const -2147483648 i32.const -1 i32.shr_s return
+    end i32.const -2147483648 i32.const 33 i32.shr_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.shr_s return
+    end i32.const -2147483648 i32.const 0 i32.shr_s return
+    end i32.const 0 i32.const 0 i32.shr_s return
+    end i32.const 0 i32.const 1 i32.shr_s return
+    end i32.const 0 i32.const -1 i32.shr_s return
+    end i32.const 0 i32.const 33 i32.shr_s return
+    end i32.const 0 i32.const -2147483648 i32.shr_s return
+    end i32.const 0 i32.const 0 i32.shr_s return
+    end unreachable)
+
+  (func (export "i32.shr_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.shr_u)
+
+  (func (export "i32.shr_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.shr_u return
+    end i32.const 0 i32.const 1 i32.shr_u return
+    end i32.const 0 i32.const -1 i32.shr_u return
+    end i32.const 0 i32.const 33 i32.shr_u return
+    end i32.const 0 i32.const -2147483648 i32.shr_u return
+    end i32.const 0 i32.const 0 i32.shr_u return
+    end i32.const 1 i32.const 0 i32.shr_u return
+    end i32.const 1 i32.const 1 i32.shr_u return
+    end i32.const 1 i32.const -1 i32.shr_u return
+    end i32.const 1 i32.const 33 i32.shr_u return
+    end i32.const 1 i32.const -2147483648 i32.shr_u return
+    end i32.const 1 i32.const 0 i32.shr_u return
+    end i32.const -1 i32.const 0 i32.shr_u return
+    end i32.const -1 i32.const 1 i32.shr_u return
+    end i32.const -1 i32.const -1 i32.shr_u return
+    end i32.const -1 i32.const 33 i32.shr_u return
+    end i32.const -1 i32.const -2147483648 i32.shr_u return
+    end i32.const -1 i32.const 0 i32.shr_u return
+    end i32.const 33 i32.const 0 i32.shr_u return
+    end i32.const 33 i32.const 1 i32.shr_u return
+    end i32.const 33 i32.const -1 i32.shr_u return
+    end i32.const 33 i32.const 33 i32.shr_u return
+    end i32.const 33 i32.const -2147483648 i32.shr_u return
+    end i32.const 33 i32.const 0 i32.shr_u return
+    end i32.const -2147483648 i32.const 0 i32.shr_u return
+    end i32.const -2147483648 i32.const 1 i32.shr_u return
+    end i32.const -2147483648 i32.const -1 i32.shr_u return
+    end i32.const -2147483648 i32.const 33 i32.shr_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.shr_u return
+    end i32.const -2147483648 i32.const 0 i32.shr_u return
+    end i32.const 0 i32.const 0 i32.shr_u return
+    end i32.const 0 i32.const 1 i32.shr_u return
+    end i32.const 0 i32.const -1 i32.shr_u return
+    end i32.const 0 i32.const 33 i32.shr_u return
+    end i32.const 0 i32.const -2147483648 i32.shr_u return
+    end i32.const 0 i32.const 0 i32.shr_u return
+    end unreachable)
+
+  (func (export "i32.rotl") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.rotl)
+
+  (func (export "i32.rotl.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.rotl return
+    end i32.const 0 i32.const 1 i32.rotl return
+    end i32.const 0 i32.const -1 i32.rotl return
+    end i32.const 0 i32.const 33 i32.rotl return
+    end i32.const 0 i32.const -2147483648 i32.rotl return
+    end i32.const 0 i32.const 0 i32.rotl return
+    end i32.const 1 i32.const 0 i32.rotl return
+    end i32.const 1 i32.const 1 i32.rotl return
+    end i32.const 1 i32.const -1 i32.rotl return
+    end i32.const 1 i32.const 33 i32.rotl return
+    end i32.const 1 i32.const -2147483648 i32.rotl return
+    end i32.const 1 i32.const 0 i32.rotl return
+    end i32.const -1 i32.const 0 i32.rotl return
+    end i32.const -1 i32.const 1 i32.rotl return
+    end i32.const -1 i32.const -1 i32.rotl return
+    end i32.const -1 i32.const 33 i32.rotl return
+    end i32.const -1 i32.const -2147483648 i32.rotl return
+    end i32.const -1 i32.const 0 i32.rotl return
+    end i32.const 33 i32.const 0 i32.rotl return
+    end i32.const 33 i32.const 1 i32.rotl return
+    end i32.const 33 i32.const -1 i32.rotl return
+    end i32.const 33 i32.const 33 i32.rotl return
+    end i32.const 33 i32.const -2147483648 i32.rotl return
+    end i32.const 33 i32.const 0 i32.rotl return
+    end i32.const -2147483648 i32.const 0 i32.rotl return
+    end i32.const -2147483648 i32.const 1 i32.rotl return
+    end i32.const -2147483648 i32.const -1 i32.rotl return
+    end i32.const -2147483648 i32.const 33 i32.rotl return
+    end i32.const -2147483648 i32.const -2147483648 i32.rotl return
+    end i32.const -2147483648 i32.const 0 i32.rotl return
+    end i32.const 0 i32.const 0 i32.rotl return
+    end i32.const 0 i32.const 1 i32.rotl return
+    end i32.const 0 i32.const -1 i32.rotl return
+    end i32.const 0 i32.const 33 i32.rotl return
+    end i32.const 0 i32.const -2147483648 i32.rotl return
+    end i32.const 0 i32.const 0 i32.rotl return
+    end unreachable)
+
+  (func (export "i32.rotr") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.rotr)
+
+  (func (export "i32.rotr.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.rotr return
+    end i32.const 0 i32.const 1 i32.rotr return
+    end i32.const 0 i32.const -1 i32.rotr return
+    end i32.const 0 i32.const 33 i32.rotr return
+    end i32.const 0 i32.const -2147483648 i32.rotr return
+    end i32.const 0 i32.const 0 i32.rotr return
+    end i32.const 1 i32.const 0 i32.rotr return
+    end i32.const 1 i32.const 1 i32.rotr return
+    end i32.const 1 i32.const -1 i32.rotr return
+    end i32.const 1 i32.const 33 i32.rotr return
+    end i32.const 1 i32.const -2147483648 i32.rotr return
+    end i32.const 1 i32.const 0 i32.rotr return
+    end i32.const -1 i32.const 0 i32.rotr return
+    end i32.const -1 i32.const 1 i32.rotr return
+    end i32.const -1 i32.const -1 i32.rotr return
+    end i32.const -1 i32.const 33 i32.rotr return
+    end i32.const -1 i32.const -2147483648 i32.rotr return
+    end i32.const -1 i32.const 0 i32.rotr return
+    end i32.const 33 i32.const 0 i32.rotr return
+    end i32.const 33 i32.const 1 i32.rotr return
+    end i32.const 33 i32.const -1 i32.rotr return
+    end i32.const 33 i32.const 33 i32.rotr return
+    end i32.const 33 i32.const -2147483648 i32.rotr return
+    end i32.const 33 i32.const 0 i32.rotr return
+    end i32.const -2147483648 i32.const 0 i32.rotr return
+    end i32.const -2147483648 i32.const 1 i32.rotr return
+    end i32.const -2147483648 i32.const -1 i32.rotr return
+    end i32.const -2147483648 i32.const 33 i32.rotr return
+    end i32.const -2147483648 i32.const -2147483648 i32.rotr return
+    end i32.const -2147483648 i32.const 0 i32.rotr return
+    end i32.const 0 i32.const 0 i32.rotr return
+    end i32.const 0 i32.const 1 i32.rotr return
+    end i32.const 0 i32.const -1 i32.rotr return
+    end i32.const 0 i32.const 33 i32.rotr return
+    end i32.const 0 i32.const -2147483648 i32.rotr return
+    end i32.const 0 i32.const 0 i32.rotr return
+    end unreachable)
+
+  (func (export "i32.eq") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.eq)
+
+  (func (export "i32.eq.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.eq return
+    end i32.const 0 i32.const 1 i32.eq return
+    end i32.const 0 i32.const -1 i32.eq return
+    end i32.const 0 i32.const 33 i32.eq return
+    end i32.const 0 i32.const -2147483648 i32.eq return
+    end i32.const 0 i32.const 0 i32.eq return
+    end i32.const 1 i32.const 0 i32.eq return
+    end i32.const 1 i32.const 1 i32.eq return
+    end i32.const 1 i32.const -1 i32.eq return
+    end i32.const 1 i32.const 33 i32.eq return
+    end i32.const 1 i32.const -2147483648 i32.eq return
+    end i32.const 1 i32.const 0 i32.eq return
+    end i32.const -1 i32.const 0 i32.eq return
+    end i32.const -1 i32.const 1 i32.eq return
+    end i32.const -1 i32.const -1 i32.eq return
+    end i32.const -1 i32.const 33 i32.eq return
+    end i32.const -1 i32.const -2147483648 i32.eq return
+    end i32.const -1 i32.const 0 i32.eq return
+    end i32.const 33 i32.const 0 i32.eq return
+    end i32.const 33 i32.const 1 i32.eq return
+    end i32.const 33 i32.const -1 i32.eq return
+    end i32.const 33 i32.const 33 i32.eq return
+    end i32.const 33 i32.const -2147483648 i32.eq return
+    end i32.const 33 i32.const 0 i32.eq return
+    end i32.const -2147483648 i32.const 0 i32.eq return
+    end i32.const -2147483648 i32.const 1 i32.eq return
+    end i32.const -2147483648 i32.const -1 i32.eq return
+    end i32.const -2147483648 i32.const 33 i32.eq return
+    end i32.const -2147483648 i32.const -2147483648 i32.eq return
+    end i32.const -2147483648 i32.const 0 i32.eq return
+    end i32.const 0 i32.const 0 i32.eq return
+    end i32.const 0 i32.const 1 i32.eq return
+    end i32.const 0 i32.const -1 i32.eq return
+    end i32.const 0 i32.const 33 i32.eq return
+    end i32.const 0 i32.const -2147483648 i32.eq return
+    end i32.const 0 i32.const 0 i32.eq return
+    end unreachable)
+
+  (func (export "i32.ne") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.ne)
+
+  (func (export "i32.ne.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.ne return
+    end i32.const 0 i32.const 1 i32.ne return
+    end i32.const 0 i32.const -1 i32.ne return
+    end i32.const 0 i32.const 33 i32.ne return
+    end i32.const 0 i32.const -2147483648 i32.ne return
+    end i32.const 0 i32.const 0 i32.ne return
+    end i32.const 1 i32.const 0 i32.ne return
+    end i32.const 1 i32.const 1 i32.ne return
+    end i32.const 1 i32.const -1 i32.ne return
+    end i32.const 1 i32.const 33 i32.ne return
+    end i32.const 1 i32.const -2147483648 i32.ne return
+    end i32.const 1 i32.const 0 i32.ne return
+    end i32.const -1 i32.const 0 i32.ne return
+    end i32.const -1 i32.const 1 i32.ne return
+    end i32.const -1 i32.const -1 i32.ne return
+    end i32.const -1 i32.const 33 i32.ne return
+    end i32.const -1 i32.const -2147483648 i32.ne return
+    end i32.const -1 i32.const 0 i32.ne return
+    end i32.const 33 i32.const 0 i32.ne return
+    end i32.const 33 i32.const 1 i32.ne return
+    end i32.const 33 i32.const -1 i32.ne return
+    end i32.const 33 i32.const 33 i32.ne return
+    end i32.const 33 i32.const -2147483648 i32.ne return
+    end i32.const 33 i32.const 0 i32.ne return
+    end i32.const -2147483648 i32.const 0 i32.ne return
+    end i32.const -2147483648 i32.const 1 i32.ne return
+    end i32.const -2147483648 i32.const -1 i32.ne return
+    end i32.const -2147483648 i32.const 33 i32.ne return
+    end i32.const -2147483648 i32.const -2147483648 i32.ne return
+    end i32.const -2147483648 i32.const 0 i32.ne return
+    end i32.const 0 i32.const 0 i32.ne return
+    end i32.const 0 i32.const 1 i32.ne return
+    end i32.const 0 i32.const -1 i32.ne return
+    end i32.const 0 i32.const 33 i32.ne return
+    end i32.const 0 i32.const -2147483648 i32.ne return
+    end i32.const 0 i32.const 0 i32.ne return
+    end unreachable)
+
+  (func (export "i32.lt_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.lt_s)
+
+  (func (export "i32.lt_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.lt_s return
+    end i32.const 0 i32.const 1 i32.lt_s return
+    end i32.const 0 i32.const -1 i32.lt_s return
+    end i32.const 0 i32.const 33 i32.lt_s return
+    end i32.const 0 i32.const -2147483648 i32.lt_s return
+    end i32.const 0 i32.const 0 i32.lt_s return
+    end i32.const 1 i32.const 0 i32.lt_s return
+    end i32.const 1 i32.const 1 i32.lt_s return
+    end i32.const 1 i32.const -1 i32.lt_s return
+    end i32.const 1 i32.const 33 i32.lt_s return
+    end i32.const 1 i32.const -2147483648 i32.lt_s return
+    end i32.const 1 i32.const 0 i32.lt_s return
+    end i32.const -1 i32.const 0 i32.lt_s return
+    end i32.const -1 i32.const 1 i32.lt_s return
+    end i32.const -1 i32.const -1 i32.lt_s return
+    end i32.const -1 i32.const 33 i32.lt_s return
+    end i32.const -1 i32.const -2147483648 i32.lt_s return
+    end i32.const -1 i32.const 0 i32.lt_s return
+    end i32.const 33 i32.const 0 i32.lt_s return
+    end i32.const 33 i32.const 1 i32.lt_s return
+    end i32.const 33 i32.const -1 i32.lt_s return
+    end i32.const 33 i32.const 33 i32.lt_s return
+    end i32.const 33 i32.const -2147483648 i32.lt_s return
+    end i32.const 33 i32.const 0 i32.lt_s return
+    end i32.const -2147483648 i32.const 0 i32.lt_s return
+    end i32.const -2147483648 i32.const 1 i32.lt_s return
+    end i32.const -2147483648 i32.const -1 i32.lt_s return
+    end i32.const -2147483648 i32.const 33 i32.lt_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.lt_s return
+    end i32.const -2147483648 i32.const 0 i32.lt_s return
+    end i32.const 0 i32.const 0 i32.lt_s return
+    end i32.const 0 i32.const 1 i32.lt_s return
+    end i32.const 0 i32.const -1 i32.lt_s return
+    end i32.const 0 i32.const 33 i32.lt_s return
+    end i32.const 0 i32.const -2147483648 i32.lt_s return
+    end i32.const 0 i32.const 0 i32.lt_s return
+    end unreachable)
+
+  (func (export "i32.lt_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.lt_u)
+
+  (func (export "i32.lt_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.lt_u return
+    end i32.const 0 i32.const 1 i32.lt_u return
+    end i32.const 0 i32.const -1 i32.lt_u return
+    end i32.const 0 i32.const 33 i32.lt_u return
+    end i32.const 0 i32.const -2147483648 i32.lt_u return
+    end i32.const 0 i32.const 0 i32.lt_u return
+    end i32.const 1 i32.const 0 i32.lt_u return
+    end i32.const 1 i32.const 1 i32.lt_u return
+    end i32.const 1 i32.const -1 i32.lt_u return
+    end i32.const 1 i32.const 33 i32.lt_u return
+    end i32.const 1 i32.const -2147483648 i32.lt_u return
+    end i32.const 1 i32.const 0 i32.lt_u return
+    end i32.const -1 i32.const 0 i32.lt_u return
+    end i32.const -1 i32.const 1 i32.lt_u return
+    end i32.const -1 i32.const -1 i32.lt_u return
+    end i32.const -1 i32.const 33 i32.lt_u return
+    end i32.const -1 i32.const -2147483648 i32.lt_u return
+    end i32.const -1 i32.const 0 i32.lt_u return
+    end i32.const 33 i32.const 0 i32.lt_u return
+    end i32.const 33 i32.const 1 i32.lt_u return
+    end i32.const 33 i32.const -1 i32.lt_u return
+    end i32.const 33 i32.const 33 i32.lt_u return
+    end i32.const 33 i32.const -2147483648 i32.lt_u return
+    end i32.const 33 i32.const 0 i32.lt_u return
+    end i32.const -2147483648 i32.const 0 i32.lt_u return
+    end i32.const -2147483648 i32.const 1 i32.lt_u return
+    end i32.const -2147483648 i32.const -1 i32.lt_u return
+    end i32.const -2147483648 i32.const 33 i32.lt_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.lt_u return
+    end i32.const -2147483648 i32.const 0 i32.lt_u return
+    end i32.const 0 i32.const 0 i32.lt_u return
+    end i32.const 0 i32.const 1 i32.lt_u return
+    end i32.const 0 i32.const -1 i32.lt_u return
+    end i32.const 0 i32.const 33 i32.lt_u return
+    end i32.const 0 i32.const -2147483648 i32.lt_u return
+    end i32.const 0 i32.const 0 i32.lt_u return
+    end unreachable)
+
+  (func (export "i32.gt_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.gt_s)
+
+  (func (export "i32.gt_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.gt_s return
+    end i32.const 0 i32.const 1 i32.gt_s return
+    end i32.const 0 i32.const -1 i32.gt_s return
+    end i32.const 0 i32.const 33 i32.gt_s return
+    end i32.const 0 i32.const -2147483648 i32.gt_s return
+    end i32.const 0 i32.const 0 i32.gt_s return
+    end i32.const 1 i32.const 0 i32.gt_s return
+    end i32.const 1 i32.const 1 i32.gt_s return
+    end i32.const 1 i32.const -1 i32.gt_s return
+    end i32.const 1 i32.const 33 i32.gt_s return
+    end i32.const 1 i32.const -2147483648 i32.gt_s return
+    end i32.const 1 i32.const 0 i32.gt_s return
+    end i32.const -1 i32.const 0 i32.gt_s return
+    end i32.const -1 i32.const 1 i32.gt_s return
+    end i32.const -1 i32.const -1 i32.gt_s return
+    end i32.const -1 i32.const 33 i32.gt_s return
+    end i32.const -1 i32.const -2147483648 i32.gt_s return
+    end i32.const -1 i32.const 0 i32.gt_s return
+    end i32.const 33 i32.const 0 i32.gt_s return
+    end i32.const 33 i32.const 1 i32.gt_s return
+    end i32.const 33 i32.const -1 i32.gt_s return
+    end i32.const 33 i32.const 33 i32.gt_s return
+    end i32.const 33 i32.const -2147483648 i32.gt_s return
+    end i32.const 33 i32.const 0 i32.gt_s return
+    end i32.const -2147483648 i32.const 0 i32.gt_s return
+    end i32.const -2147483648 i32.const 1 i32.gt_s return
+    end i32.const -2147483648 i32.const -1 i32.gt_s return
+    end i32.const -2147483648 i32.const 33 i32.gt_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.gt_s return
+    end i32.const -2147483648 i32.const 0 i32.gt_s return
+    end i32.const 0 i32.const 0 i32.gt_s return
+    end i32.const 0 i32.const 1 i32.gt_s return
+    end i32.const 0 i32.const -1 i32.gt_s return
+    end i32.const 0 i32.const 33 i32.gt_s return
+    end i32.const 0 i32.const -2147483648 i32.gt_s return
+    end i32.const 0 i32.const 0 i32.gt_s return
+    end unreachable)
+
+  (func (export "i32.gt_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.gt_u)
+
+  (func (export "i32.gt_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.gt_u return
+    end i32.const 0 i32.const 1 i32.gt_u return
+    end i32.const 0 i32.const -1 i32.gt_u return
+    end i32.const 0 i32.const 33 i32.gt_u return
+    end i32.const 0 i32.const -2147483648 i32.gt_u return
+    end i32.const 0 i32.const 0 i32.gt_u return
+    end i32.const 1 i32.const 0 i32.gt_u return
+    end i32.const 1 i32.const 1 i32.gt_u return
+    end i32.const 1 i32.const -1 i32.gt_u return
+    end i32.const 1 i32.const 33 i32.gt_u return
+    end i32.const 1 i32.const -2147483648 i32.gt_u return
+    end i32.const 1 i32.const 0 i32.gt_u return
+    end i32.const -1 i32.const 0 i32.gt_u return
+    end i32.const -1 i32.const 1 i32.gt_u return
+    end i32.const -1 i32.const -1 i32.gt_u return
+    end i32.const -1 i32.const 33 i32.gt_u return
+    end i32.const -1 i32.const -2147483648 i32.gt_u return
+    end i32.const -1 i32.const 0 i32.gt_u return
+    end i32.const 33 i32.const 0 i32.gt_u return
+    end i32.const 33 i32.const 1 i32.gt_u return
+    end i32.const 33 i32.const -1 i32.gt_u return
+    end i32.const 33 i32.const 33 i32.gt_u return
+    end i32.const 33 i32.const -2147483648 i32.gt_u return
+    end i32.const 33 i32.const 0 i32.gt_u return
+    end i32.const -2147483648 i32.const 0 i32.gt_u return
+    end i32.const -2147483648 i32.const 1 i32.gt_u return
+    end i32.const -2147483648 i32.const -1 i32.gt_u return
+    end i32.const -2147483648 i32.const 33 i32.gt_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.gt_u return
+    end i32.const -2147483648 i32.const 0 i32.gt_u return
+    end i32.const 0 i32.const 0 i32.gt_u return
+    end i32.const 0 i32.const 1 i32.gt_u return
+    end i32.const 0 i32.const -1 i32.gt_u return
+    end i32.const 0 i32.const 33 i32.gt_u return
+    end i32.const 0 i32.const -2147483648 i32.gt_u return
+    end i32.const 0 i32.const 0 i32.gt_u return
+    end unreachable)
+
+  (func (export "i32.le_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.le_s)
+
+  (func (export "i32.le_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.le_s return
+    end i32.const 0 i32.const 1 i32.le_s return
+    end i32.const 0 i32.const -1 i32.le_s return
+    end i32.const 0 i32.const 33 i32.le_s return
+    end i32.const 0 i32.const -2147483648 i32.le_s return
+    end i32.const 0 i32.const 0 i32.le_s return
+    end i32.const 1 i32.const 0 i32.le_s return
+    end i32.const 1 i32.const 1 i32.le_s return
+    end i32.const 1 i32.const -1 i32.le_s return
+    end i32.const 1 i32.const 33 i32.le_s return
+    end i32.const 1 i32.const -2147483648 i32.le_s return
+    end i32.const 1 i32.const 0 i32.le_s return
+    end i32.const -1 i32.const 0 i32.le_s return
+    end i32.const -1 i32.const 1 i32.le_s return
+    end i32.const -1 i32.const -1 i32.le_s return
+    end i32.const -1 i32.const 33 i32.le_s return
+    end i32.const -1 i32.const -2147483648 i32.le_s return
+    end i32.const -1 i32.const 0 i32.le_s return
+    end i32.const 33 i32.const 0 i32.le_s return
+    end i32.const 33 i32.const 1 i32.le_s return
+    end i32.const 33 i32.const -1 i32.le_s return
+    end i32.const 33 i32.const 33 i32.le_s return
+    end i32.const 33 i32.const -2147483648 i32.le_s return
+    end i32.const 33 i32.const 0 i32.le_s return
+    end i32.const -2147483648 i32.const 0 i32.le_s return
+    end i32.const -2147483648 i32.const 1 i32.le_s return
+    end i32.const -2147483648 i32.const -1 i32.le_s return
+    end i32.const -2147483648 i32.const 33 i32.le_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.le_s return
+    end i32.const -2147483648 i32.const 0 i32.le_s return
+    end i32.const 0 i32.const 0 i32.le_s return
+    end i32.const 0 i32.const 1 i32.le_s return
+    end i32.const 0 i32.const -1 i32.le_s return
+    end i32.const 0 i32.const 33 i32.le_s return
+    end i32.const 0 i32.const -2147483648 i32.le_s return
+    end i32.const 0 i32.const 0 i32.le_s return
+    end unreachable)
+
+  (func (export "i32.le_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.le_u)
+
+  (func (export "i32.le_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.le_u return
+    end i32.const 0 i32.const 1 i32.le_u return
+    end i32.const 0 i32.const -1 i32.le_u return
+    end i32.const 0 i32.const 33 i32.le_u return
+    end i32.const 0 i32.const -2147483648 i32.le_u return
+    end i32.const 0 i32.const 0 i32.le_u return
+    end i32.const 1 i32.const 0 i32.le_u return
+    end i32.const 1 i32.const 1 i32.le_u return
+    end i32.const 1 i32.const -1 i32.le_u return
+    end i32.const 1 i32.const 33 i32.le_u return
+    end i32.const 1 i32.const -2147483648 i32.le_u return
+    end i32.const 1 i32.const 0 i32.le_u return
+    end i32.const -1 i32.const 0 i32.le_u return
+    end i32.const -1 i32.const 1 i32.le_u return
+    end i32.const -1 i32.const -1 i32.le_u return
+    end i32.const -1 i32.const 33 i32.le_u return
+    end i32.const -1 i32.const -2147483648 i32.le_u return
+    end i32.const -1 i32.const 0 i32.le_u return
+    end i32.const 33 i32.const 0 i32.le_u return
+    end i32.const 33 i32.const 1 i32.le_u return
+    end i32.const 33 i32.const -1 i32.le_u return
+    end i32.const 33 i32.const 33 i32.le_u return
+    end i32.const 33 i32.const -2147483648 i32.le_u return
+    end i32.const 33 i32.const 0 i32.le_u return
+    end i32.const -2147483648 i32.const 0 i32.le_u return
+    end i32.const -2147483648 i32.const 1 i32.le_u return
+    end i32.const -2147483648 i32.const -1 i32.le_u return
+    end i32.const -2147483648 i32.const 33 i32.le_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.le_u return
+    end i32.const -2147483648 i32.const 0 i32.le_u return
+    end i32.const 0 i32.const 0 i32.le_u return
+    end i32.const 0 i32.const 1 i32.le_u return
+    end i32.const 0 i32.const -1 i32.le_u return
+    end i32.const 0 i32.const 33 i32.le_u return
+    end i32.const 0 i32.const -2147483648 i32.le_u return
+    end i32.const 0 i32.const 0 i32.le_u return
+    end unreachable)
+
+  (func (export "i32.ge_s") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.ge_s)
+
+  (func (export "i32.ge_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.ge_s return
+    end i32.const 0 i32.const 1 i32.ge_s return
+    end i32.const 0 i32.const -1 i32.ge_s return
+    end i32.const 0 i32.const 33 i32.ge_s return
+    end i32.const 0 i32.const -2147483648 i32.ge_s return
+    end i32.const 0 i32.const 0 i32.ge_s return
+    end i32.const 1 i32.const 0 i32.ge_s return
+    end i32.const 1 i32.const 1 i32.ge_s return
+    end i32.const 1 i32.const -1 i32.ge_s return
+    end i32.const 1 i32.const 33 i32.ge_s return
+    end i32.const 1 i32.const -2147483648 i32.ge_s return
+    end i32.const 1 i32.const 0 i32.ge_s return
+    end i32.const -1 i32.const 0 i32.ge_s return
+    end i32.const -1 i32.const 1 i32.ge_s return
+    end i32.const -1 i32.const -1 i32.ge_s return
+    end i32.const -1 i32.const 33 i32.ge_s return
+    end i32.const -1 i32.const -2147483648 i32.ge_s return
+    end i32.const -1 i32.const 0 i32.ge_s return
+    end i32.const 33 i32.const 0 i32.ge_s return
+    end i32.const 33 i32.const 1 i32.ge_s return
+    end i32.const 33 i32.const -1 i32.ge_s return
+    end i32.const 33 i32.const 33 i32.ge_s return
+    end i32.const 33 i32.const -2147483648 i32.ge_s return
+    end i32.const 33 i32.const 0 i32.ge_s return
+    end i32.const -2147483648 i32.const 0 i32.ge_s return
+    end i32.const -2147483648 i32.const 1 i32.ge_s return
+    end i32.const -2147483648 i32.const -1 i32.ge_s return
+    end i32.const -2147483648 i32.const 33 i32.ge_s return
+    end i32.const -2147483648 i32.const -2147483648 i32.ge_s return
+    end i32.const -2147483648 i32.const 0 i32.ge_s return
+    end i32.const 0 i32.const 0 i32.ge_s return
+    end i32.const 0 i32.const 1 i32.ge_s return
+    end i32.const 0 i32.const -1 i32.ge_s return
+    end i32.const 0 i32.const 33 i32.ge_s return
+    end i32.const 0 i32.const -2147483648 i32.ge_s return
+    end i32.const 0 i32.const 0 i32.ge_s return
+    end unreachable)
+
+  (func (export "i32.ge_u") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.ge_u)
+
+  (func (export "i32.ge_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i32.const 0 i32.const 0 i32.ge_u return
+    end i32.const 0 i32.const 1 i32.ge_u return
+    end i32.const 0 i32.const -1 i32.ge_u return
+    end i32.const 0 i32.const 33 i32.ge_u return
+    end i32.const 0 i32.const -2147483648 i32.ge_u return
+    end i32.const 0 i32.const 0 i32.ge_u return
+    end i32.const 1 i32.const 0 i32.ge_u return
+    end i32.const 1 i32.const 1 i32.ge_u return
+    end i32.const 1 i32.const -1 i32.ge_u return
+    end i32.const 1 i32.const 33 i32.ge_u return
+    end i32.const 1 i32.const -2147483648 i32.ge_u return
+    end i32.const 1 i32.const 0 i32.ge_u return
+    end i32.const -1 i32.const 0 i32.ge_u return
+    end i32.const -1 i32.const 1 i32.ge_u return
+    end i32.const -1 i32.const -1 i32.ge_u return
+    end i32.const -1 i32.const 33 i32.ge_u return
+    end i32.const -1 i32.const -2147483648 i32.ge_u return
+    end i32.const -1 i32.const 0 i32.ge_u return
+    end i32.const 33 i32.const 0 i32.ge_u return
+    end i32.const 33 i32.const 1 i32.ge_u return
+    end i32.const 33 i32.const -1 i32.ge_u return
+    end i32.const 33 i32.const 33 i32.ge_u return
+    end i32.const 33 i32.const -2147483648 i32.ge_u return
+    end i32.const 33 i32.const 0 i32.ge_u return
+    end i32.const -2147483648 i32.const 0 i32.ge_u return
+    end i32.const -2147483648 i32.const 1 i32.ge_u return
+    end i32.const -2147483648 i32.const -1 i32.ge_u return
+    end i32.const -2147483648 i32.const 33 i32.ge_u return
+    end i32.const -2147483648 i32.const -2147483648 i32.ge_u return
+    end i32.const -2147483648 i32.const 0 i32.ge_u return
+    end i32.const 0 i32.const 0 i32.ge_u return
+    end i32.const 0 i32.const 1 i32.ge_u return
+    end i32.const 0 i32.const -1 i32.ge_u return
+    end i32.const 0 i32.const 33 i32.ge_u return
+    end i32.const 0 i32.const -2147483648 i32.ge_u return
+    end i32.const 0 i32.const 0 i32.ge_u return
+    end unreachable)
+
+  (func (export "i64.add") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.add)
+
+  (func (export "i64.add.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.add return
+    end i64.const 0 i64.const 1 i64.add return
+    end i64.const 0 i64.const -1 i64.add return
+    end i64.const 0 i64.const 33 i64.add return
+    end i64.const 0 i64.const -2147483648 i64.add return
+    end i64.const 0 i64.const -9223372036854775808 i64.add return
+    end i64.const 1 i64.const 0 i64.add return
+    end i64.const 1 i64.const 1 i64.add return
+    end i64.const 1 i64.const -1 i64.add return
+    end i64.const 1 i64.const 33 i64.add return
+    end i64.const 1 i64.const -2147483648 i64.add return
+    end i64.const 1 i64.const -9223372036854775808 i64.add return
+    end i64.const -1 i64.const 0 i64.add return
+    end i64.const -1 i64.const 1 i64.add return
+    end i64.const -1 i64.const -1 i64.add return
+    end i64.const -1 i64.const 33 i64.add return
+    end i64.const -1 i64.const -2147483648 i64.add return
+    end i64.const -1 i64.const -9223372036854775808 i64.add return
+    end i64.const 33 i64.const 0 i64.add return
+    end i64.const 33 i64.const 1 i64.add return
+    end i64.const 33 i64.const -1 i64.add return
+    end i64.const 33 i64.const 33 i64.add return
+    end i64.const 33 i64.const -2147483648 i64.add return
+    end i64.const 33 i64.const -9223372036854775808 i64.add return
+    end i64.const -2147483648 i64.const 0 i64.add return
+    end i64.const -2147483648 i64.const 1 i64.add return
+    end i64.const -2147483648 i64.const -1 i64.add return
+    end i64.const -2147483648 i64.const 33 i64.add return
+    end i64.const -2147483648 i64.const -2147483648 i64.add return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.add return
+    end i64.const -9223372036854775808 i64.const 0 i64.add return
+    end i64.const -9223372036854775808 i64.const 1 i64.add return
+    end i64.const -9223372036854775808 i64.const -1 i64.add return
+    end i64.const -9223372036854775808 i64.const 33 i64.add return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.add return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.add return
+    end unreachable)
+
+  (func (export "i64.sub") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.sub)
+
+  (func (export "i64.sub.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.sub return
+    end i64.const 0 i64.const 1 i64.sub return
+    end i64.const 0 i64.const -1 i64.sub return
+    end i64.const 0 i64.const 33 i64.sub return
+    end i64.const 0 i64.const -2147483648 i64.sub return
+    end i64.const 0 i64.const -9223372036854775808 i64.sub return
+    end i64.const 1 i64.const 0 i64.sub return
+    end i64.const 1 i64.const 1 i64.sub return
+    end i64.const 1 i64.const -1 i64.sub return
+    end i64.const 1 i64.const 33 i64.sub return
+    end i64.const 1 i64.const -2147483648 i64.sub return
+    end i64.const 1 i64.const -9223372036854775808 i64.sub return
+    end i64.const -1 i64.const 0 i64.sub return
+    end i64.const -1 i64.const 1 i64.sub return
+    end i64.const -1 i64.const -1 i64.sub return
+    end i64.const -1 i64.const 33 i64.sub return
+    end i64.const -1 i64.const -2147483648 i64.sub return
+    end i64.const -1 i64.const -9223372036854775808 i64.sub return
+    end i64.const 33 i64.const 0 i64.sub return
+    end i64.const 33 i64.const 1 i64.sub return
+    end i64.const 33 i64.const -1 i64.sub return
+    end i64.const 33 i64.const 33 i64.sub return
+    end i64.const 33 i64.const -2147483648 i64.sub return
+    end i64.const 33 i64.const -9223372036854775808 i64.sub return
+    end i64.const -2147483648 i64.const 0 i64.sub return
+    end i64.const -2147483648 i64.const 1 i64.sub return
+    end i64.const -2147483648 i64.const -1 i64.sub return
+    end i64.const -2147483648 i64.const 33 i64.sub return
+    end i64.const -2147483648 i64.const -2147483648 i64.sub return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.sub return
+    end i64.const -9223372036854775808 i64.const 0 i64.sub return
+    end i64.const -9223372036854775808 i64.const 1 i64.sub return
+    end i64.const -9223372036854775808 i64.const -1 i64.sub return
+    end i64.const -9223372036854775808 i64.const 33 i64.sub return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.sub return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.sub return
+    end unreachable)
+
+  (func (export "i64.mul") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.mul)
+
+  (func (export "i64.mul.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.mul return
+    end i64.const 0 i64.const 1 i64.mul return
+    end i64.const 0 i64.const -1 i64.mul return
+    end i64.const 0 i64.const 33 i64.mul return
+    end i64.const 0 i64.const -2147483648 i64.mul return
+    end i64.const 0 i64.const -9223372036854775808 i64.mul return
+    end i64.const 1 i64.const 0 i64.mul return
+    end i64.const 1 i64.const 1 i64.mul return
+    end i64.const 1 i64.const -1 i64.mul return
+    end i64.const 1 i64.const 33 i64.mul return
+    end i64.const 1 i64.const -2147483648 i64.mul return
+    end i64.const 1 i64.const -9223372036854775808 i64.mul return
+    end i64.const -1 i64.const 0 i64.mul return
+    end i64.const -1 i64.const 1 i64.mul return
+    end i64.const -1 i64.const -1 i64.mul return
+    end i64.const -1 i64.const 33 i64.mul return
+    end i64.const -1 i64.const -2147483648 i64.mul return
+    end i64.const -1 i64.const -9223372036854775808 i64.mul return
+    end i64.const 33 i64.const 0 i64.mul return
+    end i64.const 33 i64.const 1 i64.mul return
+    end i64.const 33 i64.const -1 i64.mul return
+    end i64.const 33 i64.const 33 i64.mul return
+    end i64.const 33 i64.const -2147483648 i64.mul return
+    end i64.const 33 i64.const -9223372036854775808 i64.mul return
+    end i64.const -2147483648 i64.const 0 i64.mul return
+    end i64.const -2147483648 i64.const 1 i64.mul return
+    end i64.const -2147483648 i64.const -1 i64.mul return
+    end i64.const -2147483648 i64.const 33 i64.mul return
+    end i64.const -2147483648 i64.const -2147483648 i64.mul return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.mul return
+    end i64.const -9223372036854775808 i64.const 0 i64.mul return
+    end i64.const -9223372036854775808 i64.const 1 i64.mul return
+    end i64.const -9223372036854775808 i64.const -1 i64.mul return
+    end i64.const -9223372036854775808 i64.const 33 i64.mul return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.mul return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.mul return
+    end unreachable)
+
+  (func (export "i64.mul.by") (param $i i32) (param $a i64) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i64.const 0 i64.mul return
+    end local.get $a i64.const 1 i64.mul return
+    end local.get $a i64.const -1 i64.mul return
+    end local.get $a i64.const 33 i64.mul return
+    end local.get $a i64.const -2147483648 i64.mul return
+    end local.get $a i64.const -9223372036854775808 i64.mul return
+    end local.get $a i64.const 2 i64.mul return
+    end local.get $a i64.const 3 i64.mul return
+    end local.get $a i64.const 7 i64.mul return
+    end local.get $a i64.const -7 i64.mul return
+    end local.get $a i64.const 10 i64.mul return
+    end local.get $a i64.const 16 i64.mul return
+    end local.get $a i64.const 641 i64.mul return
+    end local.get $a i64.const -1000003 i64.mul return
+    end local.get $a i64.const 2147483647 i64.mul return
+    end local.get $a i64.const 4294967295 i64.mul return
+    end local.get $a i64.const 4294967296 i64.mul return
+    end local.get $a i64.const 78187493530 i64.mul return
+    end local.get $a i64.const 9223372036854775807 i64.mul return
+    end unreachable)
+
+  (func (export "i64.mul.of") (param $i i32) (param $a i64) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 local.get $a i64.mul return
+    end i64.const 1 local.get $a i64.mul return
+    end i64.const -1 local.get $a i64.mul return
+    end i64.const 33 local.get $a i64.mul return
+    end i64.const -2147483648 local.get $a i64.mul return
+    end i64.const -9223372036854775808 local.get $a i64.mul return
+    end i64.const 2 local.get $a i64.mul return
+    end i64.const 3 local.get $a i64.mul return
+    end i64.const 7 local.get $a i64.mul return
+    end i64.const -7 local.get $a i64.mul return
+    end i64.const 10 local.get $a i64.mul return
+    end i64.const 16 local.get $a i64.mul return
+    end i64.const 641 local.get $a i64.mul return
+    end i64.const -1000003 local.get $a i64.mul return
+    end i64.const 2147483647 local.get $a i64.mul return
+    end i64.const 4294967295 local.get $a i64.mul return
+    end i64.const 4294967296 local.get $a i64.mul return
+    end i64.const 78187493530 local.get $a i64.mul return
+    end i64.const 9223372036854775807 local.get $a i64.mul return
+    end unreachable)
+
+  (func (export "i64.div_s") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.div_s)
+
+  (func (export "i64.div_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.div_s return
+    end i64.const 0 i64.const 1 i64.div_s return
+    end i64.const 0 i64.const -1 i64.div_s return
+    end i64.const 0 i64.const 33 i64.div_s return
+    end i64.const 0 i64.const -2147483648 i64.div_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.div_s return
+    end i64.const 1 i64.const 0 i64.div_s return
+    end i64.const 1 i64.const 1 i64.div_s return
+    end i64.const 1 i64.const -1 i64.div_s return
+    end i64.const 1 i64.const 33 i64.div_s return
+    end i64.const 1 i64.const -2147483648 i64.div_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.div_s return
+    end i64.const -1 i64.const 0 i64.div_s return
+    end i64.const -1 i64.const 1 i64.div_s return
+    end i64.const -1 i64.const -1 i64.div_s return
+    end i64.const -1 i64.const 33 i64.div_s return
+    end i64.const -1 i64.const -2147483648 i64.div_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.div_s return
+    end i64.const 33 i64.const 0 i64.div_s return
+    end i64.const 33 i64.const 1 i64.div_s return
+    end i64.const 33 i64.const -1 i64.div_s return
+    end i64.const 33 i64.const 33 i64.div_s return
+    end i64.const 33 i64.const -2147483648 i64.div_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.div_s return
+    end i64.const -2147483648 i64.const 0 i64.div_s return
+    end i64.const -2147483648 i64.const 1 i64.div_s return
+    end i64.const -2147483648 i64.const -1 i64.div_s return
+    end i64.const -2147483648 i64.const 33 i64.div_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.div_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.div_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.div_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.div_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.div_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.div_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.div_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.div_s return
+    end unreachable)
+
+  (func (export "i64.div_s.by") (param $i i32) (param $a i64) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i64.const 0 i64.div_s return
+    end local.get $a i64.const 1 i64.div_s return
+    end local.get $a i64.const -1 i64.div_s return
+    end local.get $a i64.const 33 i64.div_s return
+    end local.get $a i64.const -2147483648 i64.div_s return
+    end local.get $a i64.const -9223372036854775808 i64.div_s return
+    end local.get $a i64.const 2 i64.div_s return
+    end local.get $a i64.const 3 i64.div_s return
+    end local.get $a i64.const 7 i64.div_s return
+    end local.get $a i64.const -7 i64.div_s return
+    end local.get $a i64.const 10 i64.div_s return
+    end local.get $a i64.const 16 i64.div_s return
+    end local.get $a i64.const 641 i64.div_s return
+    end local.get $a i64.const -1000003 i64.div_s return
+    end local.get $a i64.const 2147483647 i64.div_s return
+    end local.get $a i64.const 4294967295 i64.div_s return
+    end local.get $a i64.const 4294967296 i64.div_s return
+    end local.get $a i64.const 78187493530 i64.div_s return
+    end local.get $a i64.const 9223372036854775807 i64.div_s return
+    end unreachable)
+
+  (func (export "i64.div_u") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.div_u)
+
+  (func (export "i64.div_u.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.div_u return
+    end i64.const 0 i64.const 1 i64.div_u return
+    end i64.const 0 i64.const -1 i64.div_u return
+    end i64.const 0 i64.const 33 i64.div_u return
+    end i64.const 0 i64.const -2147483648 i64.div_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.div_u return
+    end i64.const 1 i64.const 0 i64.div_u return
+    end i64.const 1 i64.const 1 i64.div_u return
+    end i64.const 1 i64.const -1 i64.div_u return
+    end i64.const 1 i64.const 33 i64.div_u return
+    end i64.const 1 i64.const -2147483648 i64.div_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.div_u return
+    end i64.const -1 i64.const 0 i64.div_u return
+    end i64.const -1 i64.const 1 i64.div_u return
+    end i64.const -1 i64.const -1 i64.div_u return
+    end i64.const -1 i64.const 33 i64.div_u return
+    end i64.const -1 i64.const -2147483648 i64.div_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.div_u return
+    end i64.const 33 i64.const 0 i64.div_u return
+    end i64.const 33 i64.const 1 i64.div_u return
+    end i64.const 33 i64.const -1 i64.div_u return
+    end i64.const 33 i64.const 33 i64.div_u return
+    end i64.const 33 i64.const -2147483648 i64.div_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.div_u return
+    end i64.const -2147483648 i64.const 0 i64.div_u return
+    end i64.const -2147483648 i64.const 1 i64.div_u return
+    end i64.const -2147483648 i64.const -1 i64.div_u return
+    end i64.const -2147483648 i64.const 33 i64.div_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.div_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.div_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.div_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.div_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.div_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.div_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.div_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.div_u return
+    end unreachable)
+
+  (func (export "i64.div_u.by") (param $i i32) (param $a i64) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i64.const 0 i64.div_u return
+    end local.get $a i64.const 1 i64.div_u return
+    end local.get $a i64.const -1 i64.div_u return
+    end local.get $a i64.const 33 i64.div_u return
+    end local.get $a i64.const -2147483648 i64.div_u return
+    end local.get $a i64.const -9223372036854775808 i64.div_u return
+    end local.get $a i64.const 2 i64.div_u return
+    end local.get $a i64.const 3 i64.div_u return
+    end local.get $a i64.const 7 i64.div_u return
+    end local.get $a i64.const -7 i64.div_u return
+    end local.get $a i64.const 10 i64.div_u return
+    end local.get $a i64.const 16 i64.div_u return
+    end local.get $a i64.const 641 i64.div_u return
+    end local.get $a i64.const -1000003 i64.div_u return
+    end local.get $a i64.const 2147483647 i64.div_u return
+    end local.get $a i64.const 4294967295 i64.div_u return
+    end local.get $a i64.const 4294967296 i64.div_u return
+    end local.get $a i64.const 78187493530 i64.div_u return
+    end local.get $a i64.const 9223372036854775807 i64.div_u return
+    end unreachable)
+
+  (func (export "i64.rem_s") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.rem_s)
+
+  (func (export "i64.rem_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.rem_s return
+    end i64.const 0 i64.const 1 i64.rem_s return
+    end i64.const 0 i64.const -1 i64.rem_s return
+    end i64.const 0 i64.const 33 i64.rem_s return
+    end i64.const 0 i64.const -2147483648 i64.rem_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.rem_s return
+    end i64.const 1 i64.const 0 i64.rem_s return
+    end i64.const 1 i64.const 1 i64.rem_s return
+    end i64.const 1 i64.const -1 i64.rem_s return
+    end i64.const 1 i64.const 33 i64.rem_s return
+    end i64.const 1 i64.const -2147483648 i64.rem_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.rem_s return
+    end i64.const -1 i64.const 0 i64.rem_s return
+    end i64.const -1 i64.const 1 i64.rem_s return
+    end i64.const -1 i64.const -1 i64.rem_s return
+    end i64.const -1 i64.const 33 i64.rem_s return
+    end i64.const -1 i64.const -2147483648 i64.rem_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.rem_s return
+    end i64.const 33 i64.const 0 i64.rem_s return
+    end i64.const 33 i64.const 1 i64.rem_s return
+    end i64.const 33 i64.const -1 i64.rem_s return
+    end i64.const 33 i64.const 33 i64.rem_s return
+    end i64.const 33 i64.const -2147483648 i64.rem_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.rem_s return
+    end i64.const -2147483648 i64.const 0 i64.rem_s return
+    end i64.const -2147483648 i64.const 1 i64.rem_s return
+    end i64.const -2147483648 i64.const -1 i64.rem_s return
+    end i64.const -2147483648 i64.const 33 i64.rem_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.rem_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.rem_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.rem_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.rem_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.rem_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.rem_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.rem_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.rem_s return
+    end unreachable)
+
+  (func (export "i64.rem_s.by") (param $i i32) (param $a i64) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i64.const 0 i64.rem_s return
+    end local.get $a i64.const 1 i64.rem_s return
+    end local.get $a i64.const -1 i64.rem_s return
+    end local.get $a i64.const 33 i64.rem_s return
+    end local.get $a i64.const -2147483648 i64.rem_s return
+    end local.get $a i64.const -9223372036854775808 i64.rem_s return
+    end local.get $a i64.const 2 i64.rem_s return
+    end local.get $a i64.const 3 i64.rem_s return
+    end local.get $a i64.const 7 i64.rem_s return
+    end local.get $a i64.const -7 i64.rem_s return
+    end local.get $a i64.const 10 i64.rem_s return
+    end local.get $a i64.const 16 i64.rem_s return
+    end local.get $a i64.const 641 i64.rem_s return
+    end local.get $a i64.const -1000003 i64.rem_s return
+    end local.get $a i64.const 2147483647 i64.rem_s return
+    end local.get $a i64.const 4294967295 i64.rem_s return
+    end local.get $a i64.const 4294967296 i64.rem_s return
+    end local.get $a i64.const 78187493530 i64.rem_s return
+    end local.get $a i64.const 9223372036854775807 i64.rem_s return
+    end unreachable)
+
+  (func (export "i64.rem_u") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.rem_u)
+
+  (func (export "i64.rem_u.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.rem_u return
+    end i64.const 0 i64.const 1 i64.rem_u return
+    end i64.const 0 i64.const -1 i64.rem_u return
+    end i64.const 0 i64.const 33 i64.rem_u return
+    end i64.const 0 i64.const -2147483648 i64.rem_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.rem_u return
+    end i64.const 1 i64.const 0 i64.rem_u return
+    end i64.const 1 i64.const 1 i64.rem_u return
+    end i64.const 1 i64.const -1 i64.rem_u return
+    end i64.const 1 i64.const 33 i64.rem_u return
+    end i64.const 1 i64.const -2147483648 i64.rem_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.rem_u return
+    end i64.const -1 i64.const 0 i64.rem_u return
+    end i64.const -1 i64.const 1 i64.rem_u return
+    end i64.const -1 i64.const -1 i64.rem_u return
+    end i64.const -1 i64.const 33 i64.rem_u return
+    end i64.const -1 i64.const -2147483648 i64.rem_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.rem_u return
+    end i64.const 33 i64.const 0 i64.rem_u return
+    end i64.const 33 i64.const 1 i64.rem_u return
+    end i64.const 33 i64.const -1 i64.rem_u return
+    end i64.const 33 i64.const 33 i64.rem_u return
+    end i64.const 33 i64.const -2147483648 i64.rem_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.rem_u return
+    end i64.const -2147483648 i64.const 0 i64.rem_u return
+    end i64.const -2147483648 i64.const 1 i64.rem_u return
+    end i64.const -2147483648 i64.const -1 i64.rem_u return
+    end i64.const -2147483648 i64.const 33 i64.rem_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.rem_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.rem_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.rem_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.rem_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.rem_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.rem_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.rem_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.rem_u return
+    end unreachable)
+
+  (func (export "i64.rem_u.by") (param $i i32) (param $a i64) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end local.get $a i64.const 0 i64.rem_u return
+    end local.get $a i64.const 1 i64.rem_u return
+    end local.get $a i64.const -1 i64.rem_u return
+    end local.get $a i64.const 33 i64.rem_u return
+    end local.get $a i64.const -2147483648 i64.rem_u return
+    end local.get $a i64.const -9223372036854775808 i64.rem_u return
+    end local.get $a i64.const 2 i64.rem_u return
+    end local.get $a i64.const 3 i64.rem_u return
+    end local.get $a i64.const 7 i64.rem_u return
+    end local.get $a i64.const -7 i64.rem_u return
+    end local.get $a i64.const 10 i64.rem_u return
+    end local.get $a i64.const 16 i64.rem_u return
+    end local.get $a i64.const 641 i64.rem_u return
+    end local.get $a i64.const -1000003 i64.rem_u return
+    end local.get $a i64.const 2147483647 i64.rem_u return
+    end local.get $a i64.const 4294967295 i64.rem_u return
+    end local.get $a i64.const 4294967296 i64.rem_u return
+    end local.get $a i64.const 78187493530 i64.rem_u return
+    end local.get $a i64.const 9223372036854775807 i64.rem_u return
+    end unreachable)
+
+  (func (export "i64.and") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.and)
+
+  (func (export "i64.and.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.and return
+    end i64.const 0 i64.const 1 i64.and return
+    end i64.const 0 i64.const -1 i64.and return
+    end i64.const 0 i64.const 33 i64.and return
+    end i64.const 0 i64.const -2147483648 i64.and return
+    end i64.const 0 i64.const -9223372036854775808 i64.and return
+    end i64.const 1 i64.const 0 i64.and return
+    end i64.const 1 i64.const 1 i64.and return
+    end i64.const 1 i64.const -1 i64.and return
+    end i64.const 1 i64.const 33 i64.and return
+    end i64.const 1 i64.const -2147483648 i64.and return
+    end i64.const 1 i64.const -9223372036854775808 i64.and return
+    end i64.const -1 i64.const 0 i64.and return
+    end i64.const -1 i64.const 1 i64.and return
+    end i64.const -1 i64.const -1 i64.and return
+    end i64.const -1 i64.const 33 i64.and return
+    end i64.const -1 i64.const -2147483648 i64.and return
+    end i64.const -1 i64.const -9223372036854775808 i64.and return
+    end i64.const 33 i64.const 0 i64.and return
+    end i64.const 33 i64.const 1 i64.and return
+    end i64.const 33 i64.const -1 i64.and return
+    end i64.const 33 i64.const 33 i64.and return
+    end i64.const 33 i64.const -2147483648 i64.and return
+    end i64.const 33 i64.const -9223372036854775808 i64.and return
+    end i64.const -2147483648 i64.const 0 i64.and return
+    end i64.const -2147483648 i64.const 1 i64.and return
+    end i64.const -2147483648 i64.const -1 i64.and return
+    end i64.const -2147483648 i64.const 33 i64.and return
+    end i64.const -2147483648 i64.const -2147483648 i64.and return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.and return
+    end i64.const -9223372036854775808 i64.const 0 i64.and return
+    end i64.const -9223372036854775808 i64.const 1 i64.and return
+    end i64.const -9223372036854775808 i64.const -1 i64.and return
+    end i64.const -9223372036854775808 i64.const 33 i64.and return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.and return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.and return
+    end unreachable)
+
+  (func (export "i64.or") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.or)
+
+  (func (export "i64.or.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.or return
+    end i64.const 0 i64.const 1 i64.or return
+    end i64.const 0 i64.const -1 i64.or return
+    end i64.const 0 i64.const 33 i64.or return
+    end i64.const 0 i64.const -2147483648 i64.or return
+    end i64.const 0 i64.const -9223372036854775808 i64.or return
+    end i64.const 1 i64.const 0 i64.or return
+    end i64.const 1 i64.const 1 i64.or return
+    end i64.const 1 i64.const -1 i64.or return
+    end i64.const 1 i64.const 33 i64.or return
+    end i64.const 1 i64.const -2147483648 i64.or return
+    end i64.const 1 i64.const -9223372036854775808 i64.or return
+    end i64.const -1 i64.const 0 i64.or return
+    end i64.const -1 i64.const 1 i64.or return
+    end i64.const -1 i64.const -1 i64.or return
+    end i64.const -1 i64.const 33 i64.or return
+    end i64.const -1 i64.const -2147483648 i64.or return
+    end i64.const -1 i64.const -9223372036854775808 i64.or return
+    end i64.const 33 i64.const 0 i64.or return
+    end i64.const 33 i64.const 1 i64.or return
+    end i64.const 33 i64.const -1 i64.or return
+    end i64.const 33 i64.const 33 i64.or return
+    end i64.const 33 i64.const -2147483648 i64.or return
+    end i64.const 33 i64.const -9223372036854775808 i64.or return
+    end i64.const -2147483648 i64.const 0 i64.or return
+    end i64.const -2147483648 i64.const 1 i64.or return
+    end i64.const -2147483648 i64.const -1 i64.or return
+    end i64.const -2147483648 i64.const 33 i64.or return
+    end i64.const -2147483648 i64.const -2147483648 i64.or return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.or return
+    end i64.const -9223372036854775808 i64.const 0 i64.or return
+    end i64.const -9223372036854775808 i64.const 1 i64.or return
+    end i64.const -9223372036854775808 i64.const -1 i64.or return
+    end i64.const -9223372036854775808 i64.const 33 i64.or return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.or return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.or return
+    end unreachable)
+
+  (func (export "i64.xor") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.xor)
+
+  (func (export "i64.xor.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.xor return
+    end i64.const 0 i64.const 1 i64.xor return
+    end i64.const 0 i64.const -1 i64.xor return
+    end i64.const 0 i64.const 33 i64.xor return
+    end i64.const 0 i64.const -2147483648 i64.xor return
+    end i64.const 0 i64.const -9223372036854775808 i64.xor return
+    end i64.const 1 i64.const 0 i64.xor return
+    end i64.const 1 i64.const 1 i64.xor return
+    end i64.const 1 i64.const -1 i64.xor return
+    end i64.const 1 i64.const 33 i64.xor return
+    end i64.const 1 i64.const -2147483648 i64.xor return
+    end i64.const 1 i64.const -9223372036854775808 i64.xor return
+    end i64.const -1 i64.const 0 i64.xor return
+    end i64.const -1 i64.const 1 i64.xor return
+    end i64.const -1 i64.const -1 i64.xor return
+    end i64.const -1 i64.const 33 i64.xor return
+    end i64.const -1 i64.const -2147483648 i64.xor return
+    end i64.const -1 i64.const -9223372036854775808 i64.xor return
+    end i64.const 33 i64.const 0 i64.xor return
+    end i64.const 33 i64.const 1 i64.xor return
+    end i64.const 33 i64.const -1 i64.xor return
+    end i64.const 33 i64.const 33 i64.xor return
+    end i64.const 33 i64.const -2147483648 i64.xor return
+    end i64.const 33 i64.const -9223372036854775808 i64.xor return
+    end i64.const -2147483648 i64.const 0 i64.xor return
+    end i64.const -2147483648 i64.const 1 i64.xor return
+    end i64.const -2147483648 i64.const -1 i64.xor return
+    end i64.const -2147483648 i64.const 33 i64.xor return
+    end i64.const -2147483648 i64.const -2147483648 i64.xor return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.xor return
+    end i64.const -9223372036854775808 i64.const 0 i64.xor return
+    end i64.const -9223372036854775808 i64.const 1 i64.xor return
+    end i64.const -9223372036854775808 i64.const -1 i64.xor return
+    end i64.const -9223372036854775808 i64.const 33 i64.xor return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.xor return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.xor return
+    end unreachable)
+
+  (func (export "i64.shl") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.shl)
+
+  (func (export "i64.shl.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.shl return
+    end i64.const 0 i64.const 1 i64.shl return
+    end i64.const 0 i64.const -1 i64.shl return
+    end i64.const 0 i64.const 33 i64.shl return
+    end i64.const 0 i64.const -2147483648 i64.shl return
+    end i64.const 0 i64.const -9223372036854775808 i64.shl return
+    end i64.const 1 i64.const 0 i64.shl return
+    end i64.const 1 i64.const 1 i64.shl return
+    end i64.const 1 i64.const -1 i64.shl return
+    end i64.const 1 i64.const 33 i64.shl return
+    end i64.const 1 i64.const -2147483648 i64.shl return
+    end i64.const 1 i64.const -9223372036854775808 i64.shl return
+    end i64.const -1 i64.const 0 i64.shl return
+    end i64.const -1 i64.const 1 i64.shl return
+    end i64.const -1 i64.const -1 i64.shl return
+    end i64.const -1 i64.const 33 i64.shl return
+    end i64.const -1 i64.const -2147483648 i64.shl return
+    end i64.const -1 i64.const -9223372036854775808 i64.shl return
+    end i64.const 33 i64.const 0 i64.shl return
+    end i64.const 33 i64.const 1 i64.shl return
+    end i64.const 33 i64.const -1 i64.shl return
+    end i64.const 33 i64.const 33 i64.shl return
+    end i64.const 33 i64.const -2147483648 i64.shl return
+    end i64.const 33 i64.const -9223372036854775808 i64.shl return
+    end i64.const -2147483648 i64.const 0 i64.shl return
+    end i64.const -2147483648 i64.const 1 i64.shl return
+    end i64.const -2147483648 i64.const -1 i64.shl return
+    end i64.const -2147483648 i64.const 33 i64.shl return
+    end i64.const -2147483648 i64.const -2147483648 i64.shl return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.shl return
+    end i64.const -9223372036854775808 i64.const 0 i64.shl return
+    end i64.const -9223372036854775808 i64.const 1 i64.shl return
+    end i64.const -9223372036854775808 i64.const -1 i64.shl return
+    end i64.const -9223372036854775808 i64.const 33 i64.shl return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.shl return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.shl return
+    end unreachable)
+
+  (func (export "i64.shr_s") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.shr_s)
+
+  (func (export "i64.shr_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.shr_s return
+    end i64.const 0 i64.const 1 i64.shr_s return
+    end i64.const 0 i64.const -1 i64.shr_s return
+    end i64.const 0 i64.const 33 i64.shr_s return
+    end i64.const 0 i64.const -2147483648 i64.shr_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.shr_s return
+    end i64.const 1 i64.const 0 i64.shr_s return
+    end i64.const 1 i64.const 1 i64.shr_s return
+    end i64.const 1 i64.const -1 i64.shr_s return
+    end i64.const 1 i64.const 33 i64.shr_s return
+    end i64.const 1 i64.const -2147483648 i64.shr_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.shr_s return
+    end i64.const -1 i64.const 0 i64.shr_s return
+    end i64.const -1 i64.const 1 i64.shr_s return
+    end i64.const -1 i64.const -1 i64.shr_s return
+    end i64.const -1 i64.const 33 i64.shr_s return
+    end i64.const -1 i64.const -2147483648 i64.shr_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.shr_s return
+    end i64.const 33 i64.const 0 i64.shr_s return
+    end i64.const 33 i64.const 1 i64.shr_s return
+    end i64.const 33 i64.const -1 i64.shr_s return
+    end i64.const 33 i64.const 33 i64.shr_s return
+    end i64.const 33 i64.const -2147483648 i64.shr_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.shr_s return
+    end i64.const -2147483648 i64.const 0 i64.shr_s return
+    end i64.const -2147483648 i64.const 1 i64.shr_s return
+    end i64.const -2147483648 i64.const -1 i64.shr_s return
+    end i64.const -2147483648 i64.const 33 i64.shr_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.shr_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.shr_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.shr_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.shr_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.shr_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.shr_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.shr_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.shr_s return
+    end unreachable)
+
+  (func (export "i64.shr_u") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.shr_u)
+
+  (func (export "i64.shr_u.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.shr_u return
+    end i64.const 0 i64.const 1 i64.shr_u return
+    end i64.const 0 i64.const -1 i64.shr_u return
+    end i64.const 0 i64.const 33 i64.shr_u return
+    end i64.const 0 i64.const -2147483648 i64.shr_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.shr_u return
+    end i64.const 1 i64.const 0 i64.shr_u return
+    end i64.const 1 i64.const 1 i64.shr_u return
+    end i64.const 1 i64.const -1 i64.shr_u return
+    end i64.const 1 i64.const 33 i64.shr_u return
+    end i64.const 1 i64.const -2147483648 i64.shr_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.shr_u return
+    end i64.const -1 i64.const 0 i64.shr_u return
+    end i64.const -1 i64.const 1 i64.shr_u return
+    end i64.const -1 i64.const -1 i64.shr_u return
+    end i64.const -1 i64.const 33 i64.shr_u return
+    end i64.const -1 i64.const -2147483648 i64.shr_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.shr_u return
+    end i64.const 33 i64.const 0 i64.shr_u return
+    end i64.const 33 i64.const 1 i64.shr_u return
+    end i64.const 33 i64.const -1 i64.shr_u return
+    end i64.const 33 i64.const 33 i64.shr_u return
+    end i64.const 33 i64.const -2147483648 i64.shr_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.shr_u return
+    end i64.const -2147483648 i64.const 0 i64.shr_u return
+    end i64.const -2147483648 i64.const 1 i64.shr_u return
+    end i64.const -2147483648 i64.const -1 i64.shr_u return
+    end i64.const -2147483648 i64.const 33 i64.shr_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.shr_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.shr_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.shr_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.shr_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.shr_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.shr_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.shr_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.shr_u return
+    end unreachable)
+
+  (func (export "i64.rotl") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.rotl)
+
+  (func (export "i64.rotl.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.rotl return
+    end i64.const 0 i64.const 1 i64.rotl return
+    end i64.const 0 i64.const -1 i64.rotl return
+    end i64.const 0 i64.const 33 i64.rotl return
+    end i64.const 0 i64.const -2147483648 i64.rotl return
+    end i64.const 0 i64.const -9223372036854775808 i64.rotl return
+    end i64.const 1 i64.const 0 i64.rotl return
+    end i64.const 1 i64.const 1 i64.rotl return
+    end i64.const 1 i64.const -1 i64.rotl return
+    end i64.const 1 i64.const 33 i64.rotl return
+    end i64.const 1 i64.const -2147483648 i64.rotl return
+    end i64.const 1 i64.const -9223372036854775808 i64.rotl return
+    end i64.const -1 i64.const 0 i64.rotl return
+    end i64.const -1 i64.const 1 i64.rotl return
+    end i64.const -1 i64.const -1 i64.rotl return
+    end i64.const -1 i64.const 33 i64.rotl return
+    end i64.const -1 i64.const -2147483648 i64.rotl return
+    end i64.const -1 i64.const -9223372036854775808 i64.rotl return
+    end i64.const 33 i64.const 0 i64.rotl return
+    end i64.const 33 i64.const 1 i64.rotl return
+    end i64.const 33 i64.const -1 i64.rotl return
+    end i64.const 33 i64.const 33 i64.rotl return
+    end i64.const 33 i64.const -2147483648 i64.rotl return
+    end i64.const 33 i64.const -9223372036854775808 i64.rotl return
+    end i64.const -2147483648 i64.const 0 i64.rotl return
+    end i64.const -2147483648 i64.const 1 i64.rotl return
+    end i64.const -2147483648 i64.const -1 i64.rotl return
+    end i64.const -2147483648 i64.const 33 i64.rotl return
+    end i64.const -2147483648 i64.const -2147483648 i64.rotl return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.rotl return
+    end i64.const -9223372036854775808 i64.const 0 i64.rotl return
+    end i64.const -9223372036854775808 i64.const 1 i64.rotl return
+    end i64.const -9223372036854775808 i64.const -1 i64.rotl return
+    end i64.const -9223372036854775808 i64.const 33 i64.rotl return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.rotl return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.rotl return
+    end unreachable)
+
+  (func (export "i64.rotr") (param $a i64) (param $b i64) (result i64)
+    local.get $a local.get $b i64.rotr)
+
+  (func (export "i64.rotr.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.rotr return
+    end i64.const 0 i64.const 1 i64.rotr return
+    end i64.const 0 i64.const -1 i64.rotr return
+    end i64.const 0 i64.const 33 i64.rotr return
+    end i64.const 0 i64.const -2147483648 i64.rotr return
+    end i64.const 0 i64.const -9223372036854775808 i64.rotr return
+    end i64.const 1 i64.const 0 i64.rotr return
+    end i64.const 1 i64.const 1 i64.rotr return
+    end i64.const 1 i64.const -1 i64.rotr return
+    end i64.const 1 i64.const 33 i64.rotr return
+    end i64.const 1 i64.const -2147483648 i64.rotr return
+    end i64.const 1 i64.const -9223372036854775808 i64.rotr return
+    end i64.const -1 i64.const 0 i64.rotr return
+    end i64.const -1 i64.const 1 i64.rotr return
+    end i64.const -1 i64.const -1 i64.rotr return
+    end i64.const -1 i64.const 33 i64.rotr return
+    end i64.const -1 i64.const -2147483648 i64.rotr return
+    end i64.const -1 i64.const -9223372036854775808 i64.rotr return
+    end i64.const 33 i64.const 0 i64.rotr return
+    end i64.const 33 i64.const 1 i64.rotr return
+    end i64.const 33 i64.const -1 i64.rotr return
+    end i64.const 33 i64.const 33 i64.rotr return
+    end i64.const 33 i64.const -2147483648 i64.rotr return
+    end i64.const 33 i64.const -9223372036854775808 i64.rotr return
+    end i64.const -2147483648 i64.const 0 i64.rotr return
+    end i64.const -2147483648 i64.const 1 i64.rotr return
+    end i64.const -2147483648 i64.const -1 i64.rotr return
+    end i64.const -2147483648 i64.const 33 i64.rotr return
+    end i64.const -2147483648 i64.const -2147483648 i64.rotr return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.rotr return
+    end i64.const -9223372036854775808 i64.const 0 i64.rotr return
+    end i64.const -9223372036854775808 i64.const 1 i64.rotr return
+    end i64.const -9223372036854775808 i64.const -1 i64.rotr return
+    end i64.const -9223372036854775808 i64.const 33 i64.rotr return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.rotr return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.rotr return
+    end unreachable)
+
+  (func (export "i64.eq") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.eq)
+
+  (func (export "i64.eq.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.eq return
+    end i64.const 0 i64.const 1 i64.eq return
+    end i64.const 0 i64.const -1 i64.eq return
+    end i64.const 0 i64.const 33 i64.eq return
+    end i64.const 0 i64.const -2147483648 i64.eq return
+    end i64.const 0 i64.const -9223372036854775808 i64.eq return
+    end i64.const 1 i64.const 0 i64.eq return
+    end i64.const 1 i64.const 1 i64.eq return
+    end i64.const 1 i64.const -1 i64.eq return
+    end i64.const 1 i64.const 33 i64.eq return
+    end i64.const 1 i64.const -2147483648 i64.eq return
+    end i64.const 1 i64.const -9223372036854775808 i64.eq return
+    end i64.const -1 i64.const 0 i64.eq return
+    end i64.const -1 i64.const 1 i64.eq return
+    end i64.const -1 i64.const -1 i64.eq return
+    end i64.const -1 i64.const 33 i64.eq return
+    end i64.const -1 i64.const -2147483648 i64.eq return
+    end i64.const -1 i64.const -9223372036854775808 i64.eq return
+    end i64.const 33 i64.const 0 i64.eq return
+    end i64.const 33 i64.const 1 i64.eq return
+    end i64.const 33 i64.const -1 i64.eq return
+    end i64.const 33 i64.const 33 i64.eq return
+    end i64.const 33 i64.const -2147483648 i64.eq return
+    end i64.const 33 i64.const -9223372036854775808 i64.eq return
+    end i64.const -2147483648 i64.const 0 i64.eq return
+    end i64.const -2147483648 i64.const 1 i64.eq return
+    end i64.const -2147483648 i64.const -1 i64.eq return
+    end i64.const -2147483648 i64.const 33 i64.eq return
+    end i64.const -2147483648 i64.const -2147483648 i64.eq return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.eq return
+    end i64.const -9223372036854775808 i64.const 0 i64.eq return
+    end i64.const -9223372036854775808 i64.const 1 i64.eq return
+    end i64.const -9223372036854775808 i64.const -1 i64.eq return
+    end i64.const -9223372036854775808 i64.const 33 i64.eq return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.eq return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.eq return
+    end unreachable)
+
+  (func (export "i64.ne") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.ne)
+
+  (func (export "i64.ne.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.ne return
+    end i64.const 0 i64.const 1 i64.ne return
+    end i64.const 0 i64.const -1 i64.ne return
+    end i64.const 0 i64.const 33 i64.ne return
+    end i64.const 0 i64.const -2147483648 i64.ne return
+    end i64.const 0 i64.const -9223372036854775808 i64.ne return
+    end i64.const 1 i64.const 0 i64.ne return
+    end i64.const 1 i64.const 1 i64.ne return
+    end i64.const 1 i64.const -1 i64.ne return
+    end i64.const 1 i64.const 33 i64.ne return
+    end i64.const 1 i64.const -2147483648 i64.ne return
+    end i64.const 1 i64.const -9223372036854775808 i64.ne return
+    end i64.const -1 i64.const 0 i64.ne return
+    end i64.const -1 i64.const 1 i64.ne return
+    end i64.const -1 i64.const -1 i64.ne return
+    end i64.const -1 i64.const 33 i64.ne return
+    end i64.const -1 i64.const -2147483648 i64.ne return
+    end i64.const -1 i64.const -9223372036854775808 i64.ne return
+    end i64.const 33 i64.const 0 i64.ne return
+    end i64.const 33 i64.const 1 i64.ne return
+    end i64.const 33 i64.const -1 i64.ne return
+    end i64.const 33 i64.const 33 i64.ne return
+    end i64.const 33 i64.const -2147483648 i64.ne return
+    end i64.const 33 i64.const -9223372036854775808 i64.ne return
+    end i64.const -2147483648 i64.const 0 i64.ne return
+    end i64.const -2147483648 i64.const 1 i64.ne return
+    end i64.const -2147483648 i64.const -1 i64.ne return
+    end i64.const -2147483648 i64.const 33 i64.ne return
+    end i64.const -2147483648 i64.const -2147483648 i64.ne return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.ne return
+    end i64.const -9223372036854775808 i64.const 0 i64.ne return
+    end i64.const -9223372036854775808 i64.const 1 i64.ne return
+    end i64.const -9223372036854775808 i64.const -1 i64.ne return
+    end i64.const -9223372036854775808 i64.const 33 i64.ne return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.ne return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.ne return
+    end unreachable)
+
+  (func (export "i64.lt_s") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.lt_s)
+
+  (func (export "i64.lt_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.lt_s return
+    end i64.const 0 i64.const 1 i64.lt_s return
+    end i64.const 0 i64.const -1 i64.lt_s return
+    end i64.const 0 i64.const 33 i64.lt_s return
+    end i64.const 0 i64.const -2147483648 i64.lt_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.lt_s return
+    end i64.const 1 i64.const 0 i64.lt_s return
+    end i64.const 1 i64.const 1 i64.lt_s return
+    end i64.const 1 i64.const -1 i64.lt_s return
+    end i64.const 1 i64.const 33 i64.lt_s return
+    end i64.const 1 i64.const -2147483648 i64.lt_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.lt_s return
+    end i64.const -1 i64.const 0 i64.lt_s return
+    end i64.const -1 i64.const 1 i64.lt_s return
+    end i64.const -1 i64.const -1 i64.lt_s return
+    end i64.const -1 i64.const 33 i64.lt_s return
+    end i64.const -1 i64.const -2147483648 i64.lt_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.lt_s return
+    end i64.const 33 i64.const 0 i64.lt_s return
+    end i64.const 33 i64.const 1 i64.lt_s return
+    end i64.const 33 i64.const -1 i64.lt_s return
+    end i64.const 33 i64.const 33 i64.lt_s return
+    end i64.const 33 i64.const -2147483648 i64.lt_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.lt_s return
+    end i64.const -2147483648 i64.const 0 i64.lt_s return
+    end i64.const -2147483648 i64.const 1 i64.lt_s return
+    end i64.const -2147483648 i64.const -1 i64.lt_s return
+    end i64.const -2147483648 i64.const 33 i64.lt_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.lt_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.lt_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.lt_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.lt_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.lt_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.lt_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.lt_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.lt_s return
+    end unreachable)
+
+  (func (export "i64.lt_u") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.lt_u)
+
+  (func (export "i64.lt_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.lt_u return
+    end i64.const 0 i64.const 1 i64.lt_u return
+    end i64.const 0 i64.const -1 i64.lt_u return
+    end i64.const 0 i64.const 33 i64.lt_u return
+    end i64.const 0 i64.const -2147483648 i64.lt_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.lt_u return
+    end i64.const 1 i64.const 0 i64.lt_u return
+    end i64.const 1 i64.const 1 i64.lt_u return
+    end i64.const 1 i64.const -1 i64.lt_u return
+    end i64.const 1 i64.const 33 i64.lt_u return
+    end i64.const 1 i64.const -2147483648 i64.lt_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.lt_u return
+    end i64.const -1 i64.const 0 i64.lt_u return
+    end i64.const -1 i64.const 1 i64.lt_u return
+    end i64.const -1 i64.const -1 i64.lt_u return
+    end i64.const -1 i64.const 33 i64.lt_u return
+    end i64.const -1 i64.const -2147483648 i64.lt_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.lt_u return
+    end i64.const 33 i64.const 0 i64.lt_u return
+    end i64.const 33 i64.const 1 i64.lt_u return
+    end i64.const 33 i64.const -1 i64.lt_u return
+    end i64.const 33 i64.const 33 i64.lt_u return
+    end i64.const 33 i64.const -2147483648 i64.lt_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.lt_u return
+    end i64.const -2147483648 i64.const 0 i64.lt_u return
+    end i64.const -2147483648 i64.const 1 i64.lt_u return
+    end i64.const -2147483648 i64.const -1 i64.lt_u return
+    end i64.const -2147483648 i64.const 33 i64.lt_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.lt_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.lt_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.lt_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.lt_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.lt_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.lt_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.lt_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.lt_u return
+    end unreachable)
+
+  (func (export "i64.gt_s") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.gt_s)
+
+  (func (export "i64.gt_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.gt_s return
+    end i64.const 0 i64.const 1 i64.gt_s return
+    end i64.const 0 i64.const -1 i64.gt_s return
+    end i64.const 0 i64.const 33 i64.gt_s return
+    end i64.const 0 i64.const -2147483648 i64.gt_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.gt_s return
+    end i64.const 1 i64.const 0 i64.gt_s return
+    end i64.const 1 i64.const 1 i64.gt_s return
+    end i64.const 1 i64.const -1 i64.gt_s return
+    end i64.const 1 i64.const 33 i64.gt_s return
+    end i64.const 1 i64.const -2147483648 i64.gt_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.gt_s return
+    end i64.const -1 i64.const 0 i64.gt_s return
+    end i64.const -1 i64.const 1 i64.gt_s return
+    end i64.const -1 i64.const -1 i64.gt_s return
+    end i64.const -1 i64.const 33 i64.gt_s return
+    end i64.const -1 i64.const -2147483648 i64.gt_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.gt_s return
+    end i64.const 33 i64.const 0 i64.gt_s return
+    end i64.const 33 i64.const 1 i64.gt_s return
+    end i64.const 33 i64.const -1 i64.gt_s return
+    end i64.const 33 i64.const 33 i64.gt_s return
+    end i64.const 33 i64.const -2147483648 i64.gt_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.gt_s return
+    end i64.const -2147483648 i64.const 0 i64.gt_s return
+    end i64.const -2147483648 i64.const 1 i64.gt_s return
+    end i64.const -2147483648 i64.const -1 i64.gt_s return
+    end i64.const -2147483648 i64.const 33 i64.gt_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.gt_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.gt_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.gt_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.gt_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.gt_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.gt_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.gt_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.gt_s return
+    end unreachable)
+
+  (func (export "i64.gt_u") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.gt_u)
+
+  (func (export "i64.gt_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.gt_u return
+    end i64.const 0 i64.const 1 i64.gt_u return
+    end i64.const 0 i64.const -1 i64.gt_u return
+    end i64.const 0 i64.const 33 i64.gt_u return
+    end i64.const 0 i64.const -2147483648 i64.gt_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.gt_u return
+    end i64.const 1 i64.const 0 i64.gt_u return
+    end i64.const 1 i64.const 1 i64.gt_u return
+    end i64.const 1 i64.const -1 i64.gt_u return
+    end i64.const 1 i64.const 33 i64.gt_u return
+    end i64.const 1 i64.const -2147483648 i64.gt_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.gt_u return
+    end i64.const -1 i64.const 0 i64.gt_u return
+    end i64.const -1 i64.const 1 i64.gt_u return
+    end i64.const -1 i64.const -1 i64.gt_u return
+    end i64.const -1 i64.const 33 i64.gt_u return
+    end i64.const -1 i64.const -2147483648 i64.gt_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.gt_u return
+    end i64.const 33 i64.const 0 i64.gt_u return
+    end i64.const 33 i64.const 1 i64.gt_u return
+    end i64.const 33 i64.const -1 i64.gt_u return
+    end i64.const 33 i64.const 33 i64.gt_u return
+    end i64.const 33 i64.const -2147483648 i64.gt_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.gt_u return
+    end i64.const -2147483648 i64.const 0 i64.gt_u return
+    end i64.const -2147483648 i64.const 1 i64.gt_u return
+    end i64.const -2147483648 i64.const -1 i64.gt_u return
+    end i64.const -2147483648 i64.const 33 i64.gt_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.gt_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.gt_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.gt_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.gt_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.gt_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.gt_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.gt_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.gt_u return
+    end unreachable)
+
+  (func (export "i64.le_s") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.le_s)
+
+  (func (export "i64.le_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.le_s return
+    end i64.const 0 i64.const 1 i64.le_s return
+    end i64.const 0 i64.const -1 i64.le_s return
+    end i64.const 0 i64.const 33 i64.le_s return
+    end i64.const 0 i64.const -2147483648 i64.le_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.le_s return
+    end i64.const 1 i64.const 0 i64.le_s return
+    end i64.const 1 i64.const 1 i64.le_s return
+    end i64.const 1 i64.const -1 i64.le_s return
+    end i64.const 1 i64.const 33 i64.le_s return
+    end i64.const 1 i64.const -2147483648 i64.le_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.le_s return
+    end i64.const -1 i64.const 0 i64.le_s return
+    end i64.const -1 i64.const 1 i64.le_s return
+    end i64.const -1 i64.const -1 i64.le_s return
+    end i64.const -1 i64.const 33 i64.le_s return
+    end i64.const -1 i64.const -2147483648 i64.le_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.le_s return
+    end i64.const 33 i64.const 0 i64.le_s return
+    end i64.const 33 i64.const 1 i64.le_s return
+    end i64.const 33 i64.const -1 i64.le_s return
+    end i64.const 33 i64.const 33 i64.le_s return
+    end i64.const 33 i64.const -2147483648 i64.le_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.le_s return
+    end i64.const -2147483648 i64.const 0 i64.le_s return
+    end i64.const -2147483648 i64.const 1 i64.le_s return
+    end i64.const -2147483648 i64.const -1 i64.le_s return
+    end i64.const -2147483648 i64.const 33 i64.le_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.le_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.le_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.le_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.le_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.le_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.le_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.le_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.le_s return
+    end unreachable)
+
+  (func (export "i64.le_u") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.le_u)
+
+  (func (export "i64.le_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.le_u return
+    end i64.const 0 i64.const 1 i64.le_u return
+    end i64.const 0 i64.const -1 i64.le_u return
+    end i64.const 0 i64.const 33 i64.le_u return
+    end i64.const 0 i64.const -2147483648 i64.le_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.le_u return
+    end i64.const 1 i64.const 0 i64.le_u return
+    end i64.const 1 i64.const 1 i64.le_u return
+    end i64.const 1 i64.const -1 i64.le_u return
+    end i64.const 1 i64.const 33 i64.le_u return
+    end i64.const 1 i64.const -2147483648 i64.le_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.le_u return
+    end i64.const -1 i64.const 0 i64.le_u return
+    end i64.const -1 i64.const 1 i64.le_u return
+    end i64.const -1 i64.const -1 i64.le_u return
+    end i64.const -1 i64.const 33 i64.le_u return
+    end i64.const -1 i64.const -2147483648 i64.le_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.le_u return
+    end i64.const 33 i64.const 0 i64.le_u return
+    end i64.const 33 i64.const 1 i64.le_u return
+    end i64.const 33 i64.const -1 i64.le_u return
+    end i64.const 33 i64.const 33 i64.le_u return
+    end i64.const 33 i64.const -2147483648 i64.le_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.le_u return
+    end i64.const -2147483648 i64.const 0 i64.le_u return
+    end i64.const -2147483648 i64.const 1 i64.le_u return
+    end i64.const -2147483648 i64.const -1 i64.le_u return
+    end i64.const -2147483648 i64.const 33 i64.le_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.le_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.le_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.le_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.le_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.le_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.le_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.le_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.le_u return
+    end unreachable)
+
+  (func (export "i64.ge_s") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.ge_s)
+
+  (func (export "i64.ge_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.ge_s return
+    end i64.const 0 i64.const 1 i64.ge_s return
+    end i64.const 0 i64.const -1 i64.ge_s return
+    end i64.const 0 i64.const 33 i64.ge_s return
+    end i64.const 0 i64.const -2147483648 i64.ge_s return
+    end i64.const 0 i64.const -9223372036854775808 i64.ge_s return
+    end i64.const 1 i64.const 0 i64.ge_s return
+    end i64.const 1 i64.const 1 i64.ge_s return
+    end i64.const 1 i64.const -1 i64.ge_s return
+    end i64.const 1 i64.const 33 i64.ge_s return
+    end i64.const 1 i64.const -2147483648 i64.ge_s return
+    end i64.const 1 i64.const -9223372036854775808 i64.ge_s return
+    end i64.const -1 i64.const 0 i64.ge_s return
+    end i64.const -1 i64.const 1 i64.ge_s return
+    end i64.const -1 i64.const -1 i64.ge_s return
+    end i64.const -1 i64.const 33 i64.ge_s return
+    end i64.const -1 i64.const -2147483648 i64.ge_s return
+    end i64.const -1 i64.const -9223372036854775808 i64.ge_s return
+    end i64.const 33 i64.const 0 i64.ge_s return
+    end i64.const 33 i64.const 1 i64.ge_s return
+    end i64.const 33 i64.const -1 i64.ge_s return
+    end i64.const 33 i64.const 33 i64.ge_s return
+    end i64.const 33 i64.const -2147483648 i64.ge_s return
+    end i64.const 33 i64.const -9223372036854775808 i64.ge_s return
+    end i64.const -2147483648 i64.const 0 i64.ge_s return
+    end i64.const -2147483648 i64.const 1 i64.ge_s return
+    end i64.const -2147483648 i64.const -1 i64.ge_s return
+    end i64.const -2147483648 i64.const 33 i64.ge_s return
+    end i64.const -2147483648 i64.const -2147483648 i64.ge_s return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.ge_s return
+    end i64.const -9223372036854775808 i64.const 0 i64.ge_s return
+    end i64.const -9223372036854775808 i64.const 1 i64.ge_s return
+    end i64.const -9223372036854775808 i64.const -1 i64.ge_s return
+    end i64.const -9223372036854775808 i64.const 33 i64.ge_s return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.ge_s return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.ge_s return
+    end unreachable)
+
+  (func (export "i64.ge_u") (param $a i64) (param $b i64) (result i32)
+    local.get $a local.get $b i64.ge_u)
+
+  (func (export "i64.ge_u.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36
+    end i64.const 0 i64.const 0 i64.ge_u return
+    end i64.const 0 i64.const 1 i64.ge_u return
+    end i64.const 0 i64.const -1 i64.ge_u return
+    end i64.const 0 i64.const 33 i64.ge_u return
+    end i64.const 0 i64.const -2147483648 i64.ge_u return
+    end i64.const 0 i64.const -9223372036854775808 i64.ge_u return
+    end i64.const 1 i64.const 0 i64.ge_u return
+    end i64.const 1 i64.const 1 i64.ge_u return
+    end i64.const 1 i64.const -1 i64.ge_u return
+    end i64.const 1 i64.const 33 i64.ge_u return
+    end i64.const 1 i64.const -2147483648 i64.ge_u return
+    end i64.const 1 i64.const -9223372036854775808 i64.ge_u return
+    end i64.const -1 i64.const 0 i64.ge_u return
+    end i64.const -1 i64.const 1 i64.ge_u return
+    end i64.const -1 i64.const -1 i64.ge_u return
+    end i64.const -1 i64.const 33 i64.ge_u return
+    end i64.const -1 i64.const -2147483648 i64.ge_u return
+    end i64.const -1 i64.const -9223372036854775808 i64.ge_u return
+    end i64.const 33 i64.const 0 i64.ge_u return
+    end i64.const 33 i64.const 1 i64.ge_u return
+    end i64.const 33 i64.const -1 i64.ge_u return
+    end i64.const 33 i64.const 33 i64.ge_u return
+    end i64.const 33 i64.const -2147483648 i64.ge_u return
+    end i64.const 33 i64.const -9223372036854775808 i64.ge_u return
+    end i64.const -2147483648 i64.const 0 i64.ge_u return
+    end i64.const -2147483648 i64.const 1 i64.ge_u return
+    end i64.const -2147483648 i64.const -1 i64.ge_u return
+    end i64.const -2147483648 i64.const 33 i64.ge_u return
+    end i64.const -2147483648 i64.const -2147483648 i64.ge_u return
+    end i64.const -2147483648 i64.const -9223372036854775808 i64.ge_u return
+    end i64.const -9223372036854775808 i64.const 0 i64.ge_u return
+    end i64.const -9223372036854775808 i64.const 1 i64.ge_u return
+    end i64.const -9223372036854775808 i64.const -1 i64.ge_u return
+    end i64.const -9223372036854775808 i64.const 33 i64.ge_u return
+    end i64.const -9223372036854775808 i64.const -2147483648 i64.ge_u return
+    end i64.const -9223372036854775808 i64.const -9223372036854775808 i64.ge_u return
+    end unreachable)
+
+  (func (export "i32.eqz") (param $a i32) (result i32)
+    local.get $a i32.eqz)
+
+  (func (export "i32.eqz.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i32.eqz return
+    end i32.const 1 i32.eqz return
+    end i32.const -1 i32.eqz return
+    end i32.const 33 i32.eqz return
+    end i32.const -2147483648 i32.eqz return
+    end i32.const 0 i32.eqz return
+    end i32.const 2 i32.eqz return
+    end i32.const 3 i32.eqz return
+    end i32.const 7 i32.eqz return
+    end i32.const -7 i32.eqz return
+    end i32.const 10 i32.eqz return
+    end i32.const 16 i32.eqz return
+    end i32.const 641 i32.eqz return
+    end i32.const -1000003 i32.eqz return
+    end i32.const 2147483647 i32.eqz return
+    end i32.const -1 i32.eqz return
+    end i32.const 0 i32.eqz return
+    end i32.const 878082202 i32.eqz return
+    end i32.const -1 i32.eqz return
+    end unreachable)
+
+  (func (export "i32.clz") (param $a i32) (result i32)
+    local.get $a i32.clz)
+
+  (func (export "i32.clz.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i32.clz return
+    end i32.const 1 i32.clz return
+    end i32.const -1 i32.clz return
+    end i32.const 33 i32.clz return
+    end i32.const -2147483648 i32.clz return
+    end i32.const 0 i32.clz return
+    end i32.const 2 i32.clz return
+    end i32.const 3 i32.clz return
+    end i32.const 7 i32.clz return
+    end i32.const -7 i32.clz return
+    end i32.const 10 i32.clz return
+    end i32.const 16 i32.clz return
+    end i32.const 641 i32.clz return
+    end i32.const -1000003 i32.clz return
+    end i32.const 2147483647 i32.clz return
+    end i32.const -1 i32.clz return
+    end i32.const 0 i32.clz return
+    end i32.const 878082202 i32.clz return
+    end i32.const -1 i32.clz return
+    end unreachable)
+
+  (func (export "i32.ctz") (param $a i32) (result i32)
+    local.get $a i32.ctz)
+
+  (func (export "i32.ctz.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i32.ctz return
+    end i32.const 1 i32.ctz return
+    end i32.const -1 i32.ctz return
+    end i32.const 33 i32.ctz return
+    end i32.const -2147483648 i32.ctz return
+    end i32.const 0 i32.ctz return
+    end i32.const 2 i32.ctz return
+    end i32.const 3 i32.ctz return
+    end i32.const 7 i32.ctz return
+    end i32.const -7 i32.ctz return
+    end i32.const 10 i32.ctz return
+    end i32.const 16 i32.ctz return
+    end i32.const 641 i32.ctz return
+    end i32.const -1000003 i32.ctz return
+    end i32.const 2147483647 i32.ctz return
+    end i32.const -1 i32.ctz return
+    end i32.const 0 i32.ctz return
+    end i32.const 878082202 i32.ctz return
+    end i32.const -1 i32.ctz return
+    end unreachable)
+
+  (func (export "i32.popcnt") (param $a i32) (result i32)
+    local.get $a i32.popcnt)
+
+  (func (export "i32.popcnt.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i32.popcnt return
+    end i32.const 1 i32.popcnt return
+    end i32.const -1 i32.popcnt return
+    end i32.const 33 i32.popcnt return
+    end i32.const -2147483648 i32.popcnt return
+    end i32.const 0 i32.popcnt return
+    end i32.const 2 i32.popcnt return
+    end i32.const 3 i32.popcnt return
+    end i32.const 7 i32.popcnt return
+    end i32.const -7 i32.popcnt return
+    end i32.const 10 i32.popcnt return
+    end i32.const 16 i32.popcnt return
+    end i32.const 641 i32.popcnt return
+    end i32.const -1000003 i32.popcnt return
+    end i32.const 2147483647 i32.popcnt return
+    end i32.const -1 i32.popcnt return
+    end i32.const 0 i32.popcnt return
+    end i32.const 878082202 i32.popcnt return
+    end i32.const -1 i32.popcnt return
+    end unreachable)
+
+  (func (export "i32.extend8_s") (param $a i32) (result i32)
+    local.get $a i32.extend8_s)
+
+  (func (export "i32.extend8_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i32.extend8_s return
+    end i32.const 1 i32.extend8_s return
+    end i32.const -1 i32.extend8_s return
+    end i32.const 33 i32.extend8_s return
+    end i32.const -2147483648 i32.extend8_s return
+    end i32.const 0 i32.extend8_s return
+    end i32.const 2 i32.extend8_s return
+    end i32.const 3 i32.extend8_s return
+    end i32.const 7 i32.extend8_s return
+    end i32.const -7 i32.extend8_s return
+    end i32.const 10 i32.extend8_s return
+    end i32.const 16 i32.extend8_s return
+    end i32.const 641 i32.extend8_s return
+    end i32.const -1000003 i32.extend8_s return
+    end i32.const 2147483647 i32.extend8_s return
+    end i32.const -1 i32.extend8_s return
+    end i32.const 0 i32.extend8_s return
+    end i32.const 878082202 i32.extend8_s return
+    end i32.const -1 i32.extend8_s return
+    end unreachable)
+
+  (func (export "i32.extend16_s") (param $a i32) (result i32)
+    local.get $a i32.extend16_s)
+
+  (func (export "i32.extend16_s.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i32.extend16_s return
+    end i32.const 1 i32.extend16_s return
+    end i32.const -1 i32.extend16_s return
+    end i32.const 33 i32.extend16_s return
+    end i32.const -2147483648 i32.extend16_s return
+    end i32.const 0 i32.extend16_s return
+    end i32.const 2 i32.extend16_s return
+    end i32.const 3 i32.extend16_s return
+    end i32.const 7 i32.extend16_s return
+    end i32.const -7 i32.extend16_s return
+    end i32.const 10 i32.extend16_s return
+    end i32.const 16 i32.extend16_s return
+    end i32.const 641 i32.extend16_s return
+    end i32.const -1000003 i32.extend16_s return
+    end i32.const 2147483647 i32.extend16_s return
+    end i32.const -1 i32.extend16_s return
+    end i32.const 0 i32.extend16_s return
+    end i32.const 878082202 i32.extend16_s return
+    end i32.const -1 i32.extend16_s return
+    end unreachable)
+
+  (func (export "i64.extend_i32_s") (param $a i32) (result i64)
+    local.get $a i64.extend_i32_s)
+
+  (func (export "i64.extend_i32_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i64.extend_i32_s return
+    end i32.const 1 i64.extend_i32_s return
+    end i32.const -1 i64.extend_i32_s return
+    end i32.const 33 i64.extend_i32_s return
+    end i32.const -2147483648 i64.extend_i32_s return
+    end i32.const 0 i64.extend_i32_s return
+    end i32.const 2 i64.extend_i32_s return
+    end i32.const 3 i64.extend_i32_s return
+    end i32.const 7 i64.extend_i32_s return
+    end i32.const -7 i64.extend_i32_s return
+    end i32.const 10 i64.extend_i32_s return
+    end i32.const 16 i64.extend_i32_s return
+    end i32.const 641 i64.extend_i32_s return
+    end i32.const -1000003 i64.extend_i32_s return
+    end i32.const 2147483647 i64.extend_i32_s return
+    end i32.const -1 i64.extend_i32_s return
+    end i32.const 0 i64.extend_i32_s return
+    end i32.const 878082202 i64.extend_i32_s return
+    end i32.const -1 i64.extend_i32_s return
+    end unreachable)
+
+  (func (export "i64.extend_i32_u") (param $a i32) (result i64)
+    local.get $a i64.extend_i32_u)
+
+  (func (export "i64.extend_i32_u.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i32.const 0 i64.extend_i32_u return
+    end i32.const 1 i64.extend_i32_u return
+    end i32.const -1 i64.extend_i32_u return
+    end i32.const 33 i64.extend_i32_u return
+    end i32.const -2147483648 i64.extend_i32_u return
+    end i32.const 0 i64.extend_i32_u return
+    end i32.const 2 i64.extend_i32_u return
+    end i32.const 3 i64.extend_i32_u return
+    end i32.const 7 i64.extend_i32_u return
+    end i32.const -7 i64.extend_i32_u return
+    end i32.const 10 i64.extend_i32_u return
+    end i32.const 16 i64.extend_i32_u return
+    end i32.const 641 i64.extend_i32_u return
+    end i32.const -1000003 i64.extend_i32_u return
+    end i32.const 2147483647 i64.extend_i32_u return
+    end i32.const -1 i64.extend_i32_u return
+    end i32.const 0 i64.extend_i32_u return
+    end i32.const 878082202 i64.extend_i32_u return
+    end i32.const -1 i64.extend_i32_u return
+    end unreachable)
+
+  (func (export "i64.eqz") (param $a i64) (result i32)
+    local.get $a i64.eqz)
+
+  (func (export "i64.eqz.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.eqz return
+    end i64.const 1 i64.eqz return
+    end i64.const -1 i64.eqz return
+    end i64.const 33 i64.eqz return
+    end i64.const -2147483648 i64.eqz return
+    end i64.const -9223372036854775808 i64.eqz return
+    end i64.const 2 i64.eqz return
+    end i64.const 3 i64.eqz return
+    end i64.const 7 i64.eqz return
+    end i64.const -7 i64.eqz return
+    end i64.const 10 i64.eqz return
+    end i64.const 16 i64.eqz return
+    end i64.const 641 i64.eqz return
+    end i64.const -1000003 i64.eqz return
+    end i64.const 2147483647 i64.eqz return
+    end i64.const 4294967295 i64.eqz return
+    end i64.const 4294967296 i64.eqz return
+    end i64.const 78187493530 i64.eqz return
+    end i64.const 9223372036854775807 i64.eqz return
+    end unreachable)
+
+  (func (export "i64.clz") (param $a i64) (result i64)
+    local.get $a i64.clz)
+
+  (func (export "i64.clz.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.clz return
+    end i64.const 1 i64.clz return
+    end i64.const -1 i64.clz return
+    end i64.const 33 i64.clz return
+    end i64.const -2147483648 i64.clz return
+    end i64.const -9223372036854775808 i64.clz return
+    end i64.const 2 i64.clz return
+    end i64.const 3 i64.clz return
+    end i64.const 7 i64.clz return
+    end i64.const -7 i64.clz return
+    end i64.const 10 i64.clz return
+    end i64.const 16 i64.clz return
+    end i64.const 641 i64.clz return
+    end i64.const -1000003 i64.clz return
+    end i64.const 2147483647 i64.clz return
+    end i64.const 4294967295 i64.clz return
+    end i64.const 4294967296 i64.clz return
+    end i64.const 78187493530 i64.clz return
+    end i64.const 9223372036854775807 i64.clz return
+    end unreachable)
+
+  (func (export "i64.ctz") (param $a i64) (result i64)
+    local.get $a i64.ctz)
+
+  (func (export "i64.ctz.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.ctz return
+    end i64.const 1 i64.ctz return
+    end i64.const -1 i64.ctz return
+    end i64.const 33 i64.ctz return
+    end i64.const -2147483648 i64.ctz return
+    end i64.const -9223372036854775808 i64.ctz return
+    end i64.const 2 i64.ctz return
+    end i64.const 3 i64.ctz return
+    end i64.const 7 i64.ctz return
+    end i64.const -7 i64.ctz return
+    end i64.const 10 i64.ctz return
+    end i64.const 16 i64.ctz return
+    end i64.const 641 i64.ctz return
+    end i64.const -1000003 i64.ctz return
+    end i64.const 2147483647 i64.ctz return
+    end i64.const 4294967295 i64.ctz return
+    end i64.const 4294967296 i64.ctz return
+    end i64.const 78187493530 i64.ctz return
+    end i64.const 9223372036854775807 i64.ctz return
+    end unreachable)
+
+  (func (export "i64.popcnt") (param $a i64) (result i64)
+    local.get $a i64.popcnt)
+
+  (func (export "i64.popcnt.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.popcnt return
+    end i64.const 1 i64.popcnt return
+    end i64.const -1 i64.popcnt return
+    end i64.const 33 i64.popcnt return
+    end i64.const -2147483648 i64.popcnt return
+    end i64.const -9223372036854775808 i64.popcnt return
+    end i64.const 2 i64.popcnt return
+    end i64.const 3 i64.popcnt return
+    end i64.const 7 i64.popcnt return
+    end i64.const -7 i64.popcnt return
+    end i64.const 10 i64.popcnt return
+    end i64.const 16 i64.popcnt return
+    end i64.const 641 i64.popcnt return
+    end i64.const -1000003 i64.popcnt return
+    end i64.const 2147483647 i64.popcnt return
+    end i64.const 4294967295 i64.popcnt return
+    end i64.const 4294967296 i64.popcnt return
+    end i64.const 78187493530 i64.popcnt return
+    end i64.const 9223372036854775807 i64.popcnt return
+    end unreachable)
+
+  (func (export "i64.extend8_s") (param $a i64) (result i64)
+    local.get $a i64.extend8_s)
+
+  (func (export "i64.extend8_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.extend8_s return
+    end i64.const 1 i64.extend8_s return
+    end i64.const -1 i64.extend8_s return
+    end i64.const 33 i64.extend8_s return
+    end i64.const -2147483648 i64.extend8_s return
+    end i64.const -9223372036854775808 i64.extend8_s return
+    end i64.const 2 i64.extend8_s return
+    end i64.const 3 i64.extend8_s return
+    end i64.const 7 i64.extend8_s return
+    end i64.const -7 i64.extend8_s return
+    end i64.const 10 i64.extend8_s return
+    end i64.const 16 i64.extend8_s return
+    end i64.const 641 i64.extend8_s return
+    end i64.const -1000003 i64.extend8_s return
+    end i64.const 2147483647 i64.extend8_s return
+    end i64.const 4294967295 i64.extend8_s return
+    end i64.const 4294967296 i64.extend8_s return
+    end i64.const 78187493530 i64.extend8_s return
+    end i64.const 9223372036854775807 i64.extend8_s return
+    end unreachable)
+
+  (func (export "i64.extend16_s") (param $a i64) (result i64)
+    local.get $a i64.extend16_s)
+
+  (func (export "i64.extend16_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.extend16_s return
+    end i64.const 1 i64.extend16_s return
+    end i64.const -1 i64.extend16_s return
+    end i64.const 33 i64.extend16_s return
+    end i64.const -2147483648 i64.extend16_s return
+    end i64.const -9223372036854775808 i64.extend16_s return
+    end i64.const 2 i64.extend16_s return
+    end i64.const 3 i64.extend16_s return
+    end i64.const 7 i64.extend16_s return
+    end i64.const -7 i64.extend16_s return
+    end i64.const 10 i64.extend16_s return
+    end i64.const 16 i64.extend16_s return
+    end i64.const 641 i64.extend16_s return
+    end i64.const -1000003 i64.extend16_s return
+    end i64.const 2147483647 i64.extend16_s return
+    end i64.const 4294967295 i64.extend16_s return
+    end i64.const 4294967296 i64.extend16_s return
+    end i64.const 78187493530 i64.extend16_s return
+    end i64.const 9223372036854775807 i64.extend16_s return
+    end unreachable)
+
+  (func (export "i64.extend32_s") (param $a i64) (result i64)
+    local.get $a i64.extend32_s)
+
+  (func (export "i64.extend32_s.folded") (param $i i32) (result i64)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i64.extend32_s return
+    end i64.const 1 i64.extend32_s return
+    end i64.const -1 i64.extend32_s return
+    end i64.const 33 i64.extend32_s return
+    end i64.const -2147483648 i64.extend32_s return
+    end i64.const -9223372036854775808 i64.extend32_s return
+    end i64.const 2 i64.extend32_s return
+    end i64.const 3 i64.extend32_s return
+    end i64.const 7 i64.extend32_s return
+    end i64.const -7 i64.extend32_s return
+    end i64.const 10 i64.extend32_s return
+    end i64.const 16 i64.extend32_s return
+    end i64.const 641 i64.extend32_s return
+    end i64.const -1000003 i64.extend32_s return
+    end i64.const 2147483647 i64.extend32_s return
+    end i64.const 4294967295 i64.extend32_s return
+    end i64.const 4294967296 i64.extend32_s return
+    end i64.const 78187493530 i64.extend32_s return
+    end i64.const 9223372036854775807 i64.extend32_s return
+    end unreachable)
+
+  (func (export "i32.wrap_i64") (param $a i64) (result i32)
+    local.get $a i32.wrap_i64)
+
+  (func (export "i32.wrap_i64.folded") (param $i i32) (result i32)
+    block block block block block block block block block block block block block block block block block block block block
+      local.get $i br_table 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19
+    end i64.const 0 i32.wrap_i64 return
+    end i64.const 1 i32.wrap_i64 return
+    end i64.const -1 i32.wrap_i64 return
+    end i64.const 33 i32.wrap_i64 return
+    end i64.const -2147483648 i32.wrap_i64 return
+    end i64.const -9223372036854775808 i32.wrap_i64 return
+    end i64.const 2 i32.wrap_i64 return
+    end i64.const 3 i32.wrap_i64 return
+    end i64.const 7 i32.wrap_i64 return
+    end i64.const -7 i32.wrap_i64 return
+    end i64.const 10 i32.wrap_i64 return
+    end i64.const 16 i32.wrap_i64 return
+    end i64.const 641 i32.wrap_i64 return
+    end i64.const -1000003 i32.wrap_i64 return
+    end i64.const 2147483647 i32.wrap_i64 return
+    end i64.const 4294967295 i32.wrap_i64 return
+    end i64.const 4294967296 i32.wrap_i64 return
+    end i64.const 78187493530 i32.wrap_i64 return
+    end i64.const 9223372036854775807 i32.wrap_i64 return
+    end unreachable)
+)
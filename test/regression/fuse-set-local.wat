@@ -0,0 +1,111 @@
+;; operations followed by the local.set/tee that takes their result (see c_setLocalFusions)
+(module
+  (memory 1)
+  (data (i32.const 0) "\01\02\03\04\05\06\07\08")
+
+  ;; 0 + 1 + ... + (n - 1)
+  (func (export "sum") (param $n i32) (result i32) (local $i i32) (local $acc i32)
+    loop
+      local.get $acc
+      local.get $i
+      i32.add
+      local.set $acc
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_s
+      br_if 0
+    end
+    local.get $acc)
+
+  ;; (x << s) ^ ((x + 3) >> s) + (100 - x)
+  (func (export "shifts") (param $x i32) (param $s i32) (result i32) (local $a i32) (local $b i32)
+    local.get $x
+    local.get $s
+    i32.shl
+    local.set $a
+    local.get $x
+    i32.const 3
+    i32.add
+    local.get $s
+    i32.shr_u
+    local.set $b
+    i32.const 100
+    local.get $x
+    i32.sub
+    local.set $x
+    local.get $a
+    local.get $b
+    i32.xor
+    local.get $x
+    i32.add)
+
+  ;; the old value of x is still on the stack when it's overwritten: x - 5x
+  (func (export "preserve") (param $x i32) (result i32)
+    local.get $x
+    local.get $x
+    i32.const 5
+    i32.mul
+    local.set $x
+    local.get $x
+    i32.sub)
+
+  ;; (x & 7) squared
+  (func (export "tee") (param $x i32) (result i32) (local $y i32)
+    local.get $x
+    i32.const 7
+    i32.and
+    local.tee $y
+    local.get $y
+    i32.mul)
+
+  ;; the word at p + 4 minus the byte at p
+  (func (export "load") (param $p i32) (result i32) (local $v i32) (local $w i32)
+    local.get $p
+    i32.load offset=4
+    local.set $v
+    local.get $p
+    i32.load8_u
+    local.set $w
+    local.get $v
+    local.get $w
+    i32.sub)
+
+  ;; the add before the end isn't the only way into the local.set: x ? x + 1 : 2
+  (func (export "branch") (param $x i32) (result i32) (local $r i32)
+    block (result i32)
+      local.get $x
+      i32.const 1
+      i32.add
+      local.get $x
+      br_if 0
+      drop
+      i32.const 2
+      i32.const 0
+      i32.add
+    end
+    local.set $r
+    local.get $r)
+
+  ;; ((i64) x << 40 >> 40) + (i32) (x * 0.5)
+  (func (export "wide") (param $x i32) (result i32) (local $a i64) (local $f f64)
+    local.get $x
+    i64.extend_i32_s
+    i64.const 40
+    i64.shl
+    local.set $a
+    local.get $x
+    f64.convert_i32_s
+    f64.const 0.5
+    f64.mul
+    local.set $f
+    local.get $a
+    i64.const 40
+    i64.shr_s
+    i32.wrap_i64
+    local.get $f
+    i32.trunc_f64_s
+    i32.add)
+)
@@ -0,0 +1,37 @@
+;; gas metering charges each straight-line run of code as it's entered
+(module
+  ;; 0 + 1 + ... + (n - 1); a loop iteration is one run with two adds
+  (func $sum (export "sum") (param $n i32) (result i32) (local $i i32) (local $sum i32)
+    block
+      loop
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if 1
+        local.get $sum
+        local.get $i
+        i32.add
+        local.set $sum
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br 0
+      end
+    end
+    local.get $sum)
+
+  (func (export "call_sum") (param $n i32) (result i32)
+    local.get $n
+    call $sum)
+
+  ;; i32.add is the only opcode charged for by the second cost table
+  (func (export "spin")
+    loop
+      i32.const 1
+      i32.const 1
+      i32.add
+      drop
+      br 0
+    end)
+)
@@ -0,0 +1,33 @@
+;; an interrupt is noticed when a loop iterates or a function is entered
+(module
+  (import "env" "interrupt" (func $interrupt))
+
+  (func (export "spin")
+    loop
+      br 0
+    end)
+
+  (func $answer (result i32)
+    i32.const 42)
+
+  ;; the interrupt is raised by the host function, and noticed by the tail call
+  (func (export "tail") (result i32)
+    call $interrupt
+    return_call $answer)
+
+  (func (export "count") (param $n i32) (result i32) (local $i i32)
+    block
+      loop
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if 1
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br 0
+      end
+    end
+    local.get $i)
+)
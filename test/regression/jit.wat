@@ -0,0 +1,663 @@
+;; every integer operation the jit translates, in each operand form (both in slots, one of them in the register or
+;; a constant), plus loads, stores, globals, selects, branches & calls. the test runs each export interpreted &
+;; translated and compares. every export takes (a, b) and returns an i32; i64 results are folded to 32 bits.
+(module
+  (type $binary (func (param i32 i32) (result i32)))
+  (import "env" "add" (func $add (type $binary)))
+
+  (memory 1 2)
+  (global $g32 (mut i32) (i32.const 0))
+  (global $g64 (mut i64) (i64.const 0))
+  (table 3 funcref)
+  (elem (i32.const 0) $double $negate $add)
+
+  (func $fold (param $x i64) (result i32)
+    local.get $x i32.wrap_i64 local.get $x i64.const 32 i64.shr_u i32.wrap_i64 i32.const 31 i32.mul i32.xor)
+
+  (func (export "i32.add") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.add
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.add i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.add i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.add i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.add i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.add i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.add i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.add i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.sub") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.sub
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.sub i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.sub i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.sub i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.sub i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.sub i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.sub i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.sub i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.mul") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.mul
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.mul i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.mul i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.mul i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.mul i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.mul i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.mul i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.mul i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.and") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.and
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.and i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.and i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.and i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.and i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.and i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.and i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.and i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.or") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.or
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.or i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.or i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.or i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.or i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.or i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.or i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.or i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.xor") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.xor
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.xor i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.xor i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.xor i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.xor i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.xor i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.xor i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.xor i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.shl") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.shl
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.shl i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.shl i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.shl i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.shl i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.shl i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.shl i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.shl i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.shr_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.shr_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.shr_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.shr_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.shr_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.shr_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.shr_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.shr_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.shr_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.shr_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.shr_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.shr_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.shr_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.shr_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.shr_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.shr_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.shr_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.shr_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.rotl") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.rotl
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.rotl i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.rotl i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.rotl i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.rotl i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.rotl i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.rotl i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.rotl i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.rotr") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.rotr
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.rotr i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.rotr i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.rotr i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.rotr i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.rotr i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.rotr i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.rotr i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.div_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.div_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.div_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.div_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.div_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.div_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.div_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.div_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.div_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.div_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.div_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.div_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.div_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.div_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.div_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.div_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.div_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.div_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.rem_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.rem_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.rem_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.rem_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.rem_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.rem_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.rem_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.rem_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.rem_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.rem_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.rem_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.rem_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.rem_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.rem_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.rem_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.rem_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.rem_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.rem_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.eq") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.eq
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.eq i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.eq i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.eq i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.eq i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.eq i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.eq i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.eq i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.ne") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.ne
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.ne i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.ne i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.ne i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.ne i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.ne i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.ne i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.ne i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.lt_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.lt_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.lt_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.lt_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.lt_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.lt_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.lt_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.lt_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.lt_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.lt_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.lt_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.lt_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.lt_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.lt_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.lt_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.lt_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.lt_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.lt_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.gt_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.gt_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.gt_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.gt_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.gt_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.gt_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.gt_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.gt_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.gt_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.gt_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.gt_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.gt_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.gt_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.gt_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.gt_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.gt_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.gt_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.gt_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.le_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.le_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.le_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.le_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.le_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.le_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.le_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.le_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.le_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.le_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.le_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.le_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.le_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.le_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.le_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.le_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.le_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.le_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.ge_s") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.ge_s
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.ge_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.ge_s i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.ge_s i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.ge_s i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.ge_s i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.ge_s i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.ge_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.ge_u") (param $a i32) (param $b i32) (result i32) (local $x i32) (local $y i32)
+    local.get $a local.set $x  local.get $b local.set $y
+    local.get $x local.get $y i32.ge_u
+    local.get $x local.get $y i32.xor local.get $y i32.xor local.get $y i32.ge_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i32.xor local.get $x i32.xor i32.ge_u i32.const 5 i32.mul i32.add
+    local.get $x i32.const 7 i32.ge_u i32.const 7 i32.mul i32.add
+    local.get $x i32.const -3 i32.ge_u i32.const 9 i32.mul i32.add
+    local.get $x i32.const 1 i32.ge_u i32.const 11 i32.mul i32.add
+    local.get $x i32.const -1 i32.ge_u i32.const 13 i32.mul i32.add
+    i32.const -100 local.get $y i32.ge_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i32.eqz") (param $a i32) (param $b i32) (result i32) (local $x i32)
+    local.get $a local.set $x  local.get $x i32.eqz  local.get $x local.get $x i32.xor i32.eqz i32.const 2 i32.mul i32.add)
+
+  (func (export "i64.add") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.add call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.add call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.add call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.add call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.add call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.add call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.add call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.add call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.sub") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.sub call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.sub call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.sub call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.sub call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.sub call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.sub call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.sub call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.sub call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.mul") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.mul call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.mul call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.mul call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.mul call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.mul call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.mul call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.mul call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.mul call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.and") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.and call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.and call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.and call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.and call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.and call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.and call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.and call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.and call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.or") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.or call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.or call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.or call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.or call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.or call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.or call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.or call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.or call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.xor") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.xor call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.xor call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.xor call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.xor call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.xor call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.xor call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.xor call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.xor call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.shl") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.shl call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.shl call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.shl call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.shl call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.shl call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.shl call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.shl call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.shl call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.shr_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.shr_s call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.shr_s call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.shr_s call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.shr_s call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.shr_s call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.shr_s call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.shr_s call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.shr_s call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.shr_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.shr_u call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.shr_u call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.shr_u call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.shr_u call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.shr_u call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.shr_u call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.shr_u call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.shr_u call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.rotl") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.rotl call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.rotl call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.rotl call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.rotl call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.rotl call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.rotl call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.rotl call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.rotl call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.rotr") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.rotr call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.rotr call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.rotr call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.rotr call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.rotr call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.rotr call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.rotr call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.rotr call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.div_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.div_s call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.div_s call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.div_s call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.div_s call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.div_s call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.div_s call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.div_s call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.div_s call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.div_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.div_u call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.div_u call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.div_u call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.div_u call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.div_u call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.div_u call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.div_u call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.div_u call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.rem_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.rem_s call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.rem_s call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.rem_s call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.rem_s call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.rem_s call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.rem_s call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.rem_s call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.rem_s call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.rem_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.rem_u call $fold
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.rem_u call $fold i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.rem_u call $fold i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.rem_u call $fold i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.rem_u call $fold i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.rem_u call $fold i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.rem_u call $fold i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.rem_u call $fold i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.eq") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.eq
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.eq i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.eq i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.eq i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.eq i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.eq i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.eq i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.eq i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.ne") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.ne
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.ne i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.ne i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.ne i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.ne i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.ne i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.ne i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.ne i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.lt_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.lt_s
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.lt_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.lt_s i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.lt_s i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.lt_s i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.lt_s i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.lt_s i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.lt_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.lt_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.lt_u
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.lt_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.lt_u i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.lt_u i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.lt_u i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.lt_u i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.lt_u i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.lt_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.gt_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.gt_s
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.gt_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.gt_s i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.gt_s i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.gt_s i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.gt_s i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.gt_s i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.gt_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.gt_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.gt_u
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.gt_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.gt_u i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.gt_u i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.gt_u i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.gt_u i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.gt_u i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.gt_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.le_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.le_s
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.le_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.le_s i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.le_s i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.le_s i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.le_s i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.le_s i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.le_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.le_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.le_u
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.le_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.le_u i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.le_u i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.le_u i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.le_u i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.le_u i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.le_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.ge_s") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.ge_s
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.ge_s i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.ge_s i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.ge_s i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.ge_s i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.ge_s i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.ge_s i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.ge_s i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.ge_u") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.ge_u
+    local.get $x local.get $y i64.xor local.get $y i64.xor local.get $y i64.ge_u i32.const 3 i32.mul i32.add
+    local.get $x local.get $y local.get $x i64.xor local.get $x i64.xor i64.ge_u i32.const 5 i32.mul i32.add
+    local.get $x i64.const 7 i64.ge_u i32.const 7 i32.mul i32.add
+    local.get $x i64.const -3 i64.ge_u i32.const 9 i32.mul i32.add
+    local.get $x i64.const 1 i64.ge_u i32.const 11 i32.mul i32.add
+    local.get $x i64.const -1 i64.ge_u i32.const 13 i32.mul i32.add
+    i64.const -100 local.get $y i64.ge_u i32.const 17 i32.mul i32.add)
+
+  (func (export "i64.eqz") (param $a i32) (param $b i32) (result i32) (local $x i64)
+    local.get $a i64.extend_i32_s local.set $x  local.get $x i64.eqz  local.get $x local.get $x i64.xor i64.eqz i32.const 2 i32.mul i32.add)
+
+  (func (export "extend") (param $a i32) (param $b i32) (result i32)
+    local.get $a i32.extend8_s
+    local.get $a i32.extend16_s i32.const 3 i32.mul i32.add
+    local.get $a i64.extend_i32_u local.get $b i64.extend_i32_s i64.add call $fold i32.const 5 i32.mul i32.add
+    local.get $a i64.extend_i32_s i64.extend8_s call $fold i32.const 7 i32.mul i32.add
+    local.get $b i64.extend_i32_s i64.extend16_s call $fold i32.const 9 i32.mul i32.add
+    local.get $b i64.extend_i32_u i64.extend32_s call $fold i32.const 11 i32.mul i32.add)
+
+  ;; stores a at b, then loads it back in every width; out of bounds traps
+  (func (export "memory") (param $a i32) (param $b i32) (result i32)
+    local.get $b local.get $a i32.store
+    local.get $b i32.const 4 i32.add local.get $a i64.extend_i32_s i64.const 0x1234567 i64.mul i64.store offset=4
+    local.get $b i32.const 16 i32.add local.get $a i32.store8
+    local.get $b i32.const 18 i32.add local.get $a i32.store16
+    local.get $b i32.const 20 i32.add local.get $a f32.convert_i32_s f32.store
+    local.get $b i32.const 24 i32.add local.get $a f64.convert_i32_s f64.store
+    local.get $b i32.load
+    local.get $b i32.load8_s i32.const 3 i32.mul i32.add
+    local.get $b i32.load8_u i32.const 5 i32.mul i32.add
+    local.get $b i32.load16_s i32.const 7 i32.mul i32.add
+    local.get $b i32.load16_u offset=2 i32.const 9 i32.mul i32.add
+    local.get $b i64.load offset=8 call $fold i32.const 11 i32.mul i32.add
+    local.get $b i64.load32_s offset=8 call $fold i32.const 13 i32.mul i32.add
+    local.get $b i64.load16_u offset=16 call $fold i32.const 15 i32.mul i32.add
+    local.get $b i64.load8_s offset=16 call $fold i32.const 17 i32.mul i32.add
+    local.get $b f32.load offset=20 i32.trunc_f32_s i32.const 19 i32.mul i32.add
+    local.get $b f64.load offset=24 f64.const 0.5 f64.mul i32.trunc_f64_s i32.const 21 i32.mul i32.add)
+
+  ;; the memory moves when it grows, so later accesses must reload its base
+  (func (export "grow") (param $a i32) (param $b i32) (result i32) (local $size i32)
+    memory.size local.set $size
+    i32.const 100 local.get $a i32.store
+    i32.const 1 memory.grow drop
+    memory.size local.get $size i32.sub
+    i32.const 100 i32.load i32.add
+    local.get $size i32.const 65536 i32.mul local.get $b i32.const 15 i32.and i32.add i32.load8_u i32.add)
+
+  (func (export "globals") (param $a i32) (param $b i32) (result i32)
+    global.get $g32 local.get $a i32.add global.set $g32
+    global.get $g64 local.get $b i64.extend_i32_s i64.sub global.set $g64
+    global.get $g32 global.get $g64 call $fold i32.xor)
+
+  (func (export "select") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b local.get $a local.get $b i32.lt_s select
+    local.get $a local.get $b i32.const 1 i32.add local.get $b select i32.const 3 i32.mul i32.add
+    local.get $a i64.extend_i32_s local.get $b i64.extend_i32_s local.get $a i32.eqz select call $fold i32.const 5 i32.mul i32.add
+    local.get $a f64.convert_i32_s local.get $b f64.convert_i32_s local.get $b select i32.trunc_f64_s i32.const 7 i32.mul i32.add)
+
+  (func (export "floats") (param $a i32) (param $b i32) (result i32) (local $x f64) (local $y f32)
+    local.get $a f64.convert_i32_s f64.const 0.25 f64.add local.set $x
+    local.get $b f32.convert_i32_s local.set $y
+    local.get $x local.get $y f64.promote_f32 f64.mul local.get $x f64.add f64.const 1000 f64.div
+    local.get $x f64.sqrt f64.add f64.floor i32.trunc_f64_s
+    local.get $y local.get $x f32.demote_f64 f32.lt i32.const 3 i32.mul i32.add
+    local.get $y f32.abs local.get $y f32.neg f32.sub f32.nearest i32.trunc_f32_s i32.add)
+
+  (func (export "branches") (param $a i32) (param $b i32) (result i32) (local $r i32)
+    block block block block
+      local.get $a i32.const 3 i32.and br_table 0 1 2 3
+    end local.get $r i32.const 10 i32.add local.set $r
+    end local.get $r i32.const 100 i32.add local.set $r
+    end local.get $r i32.const 1000 i32.add local.set $r
+    end
+    local.get $a local.get $b i32.gt_s if (result i32) i32.const 1 else i32.const 2 end local.get $r i32.add local.set $r
+    block (result i32) i32.const 7 local.get $b br_if 0 drop i32.const 9 end local.get $r i32.add)
+
+  ;; sums a * i for i < b (& 255), and counts down by recursion
+  (func $loop (export "loop") (param $a i32) (param $b i32) (result i32) (local $i i32) (local $s i32)
+    local.get $b i32.const 255 i32.and local.set $b
+    block loop
+      local.get $i local.get $b i32.ge_u br_if 1
+      local.get $s local.get $a local.get $i i32.mul i32.add local.set $s
+      local.get $i i32.const 1 i32.add local.set $i
+      br 0
+    end end
+    local.get $s)
+
+  (func $fib (export "fib") (param $a i32) (param $b i32) (result i32)
+    local.get $a i32.const 15 i32.and local.tee $a i32.const 2 i32.lt_u if (result i32) local.get $a else
+      local.get $a i32.const 1 i32.sub local.get $b call $fib
+      local.get $a i32.const 2 i32.sub local.get $b call $fib i32.add end)
+
+  (func $double (param $a i32) (param $b i32) (result i32) local.get $a local.get $a i32.add)
+  (func $negate (param $a i32) (param $b i32) (result i32) i32.const 0 local.get $a i32.sub)
+
+  ;; index 2 is the host function; 3 and up trap
+  (func (export "calls") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b local.get $b i32.const 3 i32.and call_indirect (type $binary)
+    local.get $a local.get $b call $add i32.add
+    local.get $a local.get $b call $loop i32.add)
+)
@@ -0,0 +1,137 @@
+;; loops iterate by jumping back to their head (d_m3FlattenLoops) or by returning to op_Loop; either way the
+;; native stack mustn't grow with the iterations, and values must carry across the back-edge
+(module
+  (func $one (param $x i32) (result i32)
+    local.get $x
+    i32.const 1
+    i32.add)
+
+  ;; counts n * m with a do-while loop nested in another: both iterate by br_if
+  (func (export "nested") (param $n i32) (param $m i32) (result i32) (local $i i32) (local $j i32) (local $count i32)
+    local.get $n
+    i32.eqz
+    local.get $m
+    i32.eqz
+    i32.or
+    if
+      i32.const 0
+      return
+    end
+    loop $outer
+      i32.const 0
+      local.set $j
+      loop $inner
+        local.get $count
+        i32.const 1
+        i32.add
+        local.set $count
+        local.get $j
+        i32.const 1
+        i32.add
+        local.tee $j
+        local.get $m
+        i32.lt_u
+        br_if $inner
+      end
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_u
+      br_if $outer
+    end
+    local.get $count)
+
+  ;; the loop's result is left on the stack as it falls through
+  (func (export "result") (param $n i32) (result i32) (local $sum i32)
+    loop (result i32)
+      local.get $sum
+      local.get $n
+      i32.add
+      local.set $sum
+      local.get $n
+      i32.const 1
+      i32.sub
+      local.tee $n
+      br_if 0
+      local.get $sum
+    end)
+
+  ;; a loop parameter is carried across the back-edge on the stack
+  (func (export "param") (param $n i32) (result i32)
+    i32.const 0
+    loop (param i32) (result i32)
+      local.get $n
+      i32.add
+      local.get $n
+      i32.const 1
+      i32.sub
+      local.tee $n
+      br_if 0
+    end)
+
+  ;; a float accumulator, in case it's kept in a register across the back-edge
+  (func (export "float") (param $n i32) (result f64) (local $x f64)
+    loop
+      local.get $x
+      f64.const 0.5
+      f64.add
+      local.set $x
+      local.get $n
+      i32.const 1
+      i32.sub
+      local.tee $n
+      br_if 0
+    end
+    local.get $x)
+
+  ;; br_table iterates either loop, or leaves them both: the entries of the outer loop are counted in the high
+  ;; half of the result, the inner loop's in the low half
+  (func (export "table") (param $n i32) (result i64) (local $outer i64) (local $inner i64)
+    block $done
+      loop $even
+        local.get $outer
+        i64.const 1
+        i64.add
+        local.set $outer
+        loop $odd
+          local.get $inner
+          i64.const 1
+          i64.add
+          local.set $inner
+          local.get $n
+          i32.eqz
+          br_if $done
+          local.get $n
+          i32.const 1
+          i32.sub
+          local.tee $n
+          i32.const 1
+          i32.and
+          br_table $even $odd $done
+        end
+      end
+    end
+    local.get $outer
+    i64.const 32
+    i64.shl
+    local.get $inner
+    i64.or)
+
+  ;; a call in the body; returns from inside the loop once the count reaches n
+  (func (export "call") (param $n i32) (result i32) (local $i i32)
+    loop
+      local.get $i
+      call $one
+      local.tee $i
+      local.get $n
+      i32.ge_u
+      if
+        local.get $i
+        return
+      end
+      br 0
+    end
+    unreachable)
+)
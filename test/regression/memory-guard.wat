@@ -0,0 +1,26 @@
+;; out-of-bounds accesses have to trap, whether they're bounds checked or fault on a guard page (d_m3UseGuardPages)
+(module
+  (memory 1 2)
+  (data (i32.const 65532) "\2a\00\00\00")
+
+  (func (export "load") (param i32) (result i32)
+    local.get 0
+    i32.load)
+
+  ;; the largest address & offset a load can combine
+  (func (export "load_far") (param i32) (result i32)
+    local.get 0
+    i32.load offset=0xffffffff)
+
+  (func (export "store") (param i32)
+    local.get 0
+    i32.const 7
+    i32.store)
+
+  (func (export "grow") (result i32)
+    i32.const 1
+    memory.grow)
+
+  (func (export "size") (result i32)
+    memory.size)
+)
@@ -0,0 +1,116 @@
+;; values produced in the register that are then needed in a slot: spilled by the next operation, kept as a block,
+;; branch, loop or return result, or passed as call arguments. each is written straight to its slot by the op that
+;; produces it (see TargetResultToSlot)
+(module
+  (memory 1)
+
+  (func $combine (param $a i32) (param $b i32) (param $c i32) (result i32)
+    local.get $a i32.const 100 i32.mul
+    local.get $b i32.const 10 i32.mul
+    i32.add
+    local.get $c
+    i32.add)
+
+  ;; (a + b) * (a - b) + ((a ^ b) - (a & b))
+  (func (export "spill") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.add
+    local.get $a local.get $b i32.sub
+    i32.mul
+    local.get $a local.get $b i32.xor
+    local.get $a local.get $b i32.and
+    i32.sub
+    i32.add)
+
+  ;; the same with x = a & y = b * 0x100000001, folded to 32 bits
+  (func (export "spill64") (param $a i32) (param $b i32) (result i32) (local $x i64) (local $y i64)
+    local.get $a i64.extend_i32_s local.set $x
+    local.get $b i64.extend_i32_s i64.const 0x100000001 i64.mul local.set $y
+    local.get $x local.get $y i64.add
+    local.get $x local.get $y i64.sub
+    i64.mul
+    local.get $x local.get $y i64.xor
+    local.get $x local.get $y i64.and
+    i64.sub
+    i64.add
+    local.tee $x i32.wrap_i64
+    local.get $x i64.const 32 i64.shr_u i32.wrap_i64
+    i32.xor)
+
+  ;; (a + b) * (a - b), in doubles clamped to +/-1e9
+  (func (export "spill_f64") (param $a i32) (param $b i32) (result i32)
+    local.get $a f64.convert_i32_s local.get $b f64.convert_i32_s f64.add
+    local.get $a f64.convert_i32_s local.get $b f64.convert_i32_s f64.sub
+    f64.mul
+    f64.const 1e9 f64.min
+    f64.const -1e9 f64.max
+    i32.trunc_f64_s)
+
+  ;; (a + b) - (a ? a * b : 7)
+  (func (export "block") (param $a i32) (param $b i32) (result i32)
+    block (result i32)
+      local.get $a local.get $b i32.add
+    end
+    block (result i32)
+      local.get $a local.get $b i32.mul
+      local.get $a
+      br_if 0
+      drop
+      i32.const 7
+    end
+    i32.sub)
+
+  ;; (a < b ? a - b : a * b) + (b << 3)
+  (func (export "if") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.lt_s
+    if (result i32)
+      local.get $a local.get $b i32.sub
+    else
+      local.get $a local.get $b i32.mul
+    end
+    local.get $b i32.const 3 i32.shl
+    i32.add)
+
+  ;; a * max (1, b & 7)
+  (func (export "loop") (param $a i32) (param $b i32) (result i32) (local $i i32)
+    loop (result i32)
+      local.get $i i32.const 1 i32.add local.tee $i
+      local.get $a i32.mul
+      local.get $i local.get $b i32.const 7 i32.and i32.lt_u
+      br_if 0
+    end)
+
+  ;; a ? (a + b) * a : b * b
+  (func (export "return") (param $a i32) (param $b i32) (result i32)
+    local.get $a i32.eqz
+    if
+      local.get $b local.get $b i32.mul
+      return
+    end
+    local.get $a local.get $b i32.add
+    local.get $a i32.mul)
+
+  ;; 100 * (a + b) + 10 * (a * b) + (a - b)
+  (func (export "call") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b i32.add
+    local.get $a local.get $b i32.mul
+    local.get $a local.get $b i32.sub
+    call $combine)
+
+  ;; max (a, b) - 10 * min (a, b)
+  (func (export "select") (param $a i32) (param $b i32) (result i32)
+    local.get $a local.get $b local.get $a local.get $b i32.gt_s select
+    local.get $a local.get $b local.get $a local.get $b i32.lt_s select
+    i32.const 10 i32.mul
+    i32.sub)
+
+  ;; with a stored at 0: i8 (a) * (i16 (a) + u16 (a >> 16)) + u8 (a >> 8)
+  (func (export "loads") (param $a i32) (param $b i32) (result i32)
+    i32.const 0 local.get $a i32.store
+    i32.const 0 i32.load8_s
+    i32.const 0 i32.load16_s
+    i32.const 0 i32.load16_u offset=2
+    i32.add
+    i32.mul
+    i32.const 0 i32.load8_u offset=1
+    i32.add)
+)
@@ -0,0 +1,105 @@
+;; fixed-width SIMD: lane arithmetic, shuffles, memory, compares, v128 locals/params/results and a v128 result
+;; handed back through a tail call to a host function
+(module
+  (type $swap (func (param v128) (result i32 v128)))
+
+  (import "env" "swap" (func $host_swap (type $swap)))     ;; (sum of the u64 halves, the halves swapped)
+
+  (table 1 funcref)
+  (elem (i32.const 0) $host_swap)
+
+  (memory 1)
+  (data (i32.const 0) "\01\00\00\00\02\00\00\00\03\00\00\00\04\00\00\00")
+
+  ;; the sum of the lanes of splat (a) * splat (b): 4ab
+  (func (export "mul") (param $a i32) (param $b i32) (result i32) (local $v v128)
+    local.get $a
+    i32x4.splat
+    local.get $b
+    i32x4.splat
+    i32x4.mul
+    local.set $v
+    local.get $v
+    i32x4.extract_lane 0
+    local.get $v
+    i32x4.extract_lane 1
+    i32.add
+    local.get $v
+    i32x4.extract_lane 2
+    i32.add
+    local.get $v
+    i32x4.extract_lane 3
+    i32.add)
+
+  ;; saturating signed byte add
+  (func (export "add_sat") (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    i8x16.splat
+    local.get $b
+    i8x16.splat
+    i8x16.add_sat_s
+    i8x16.extract_lane_s 7)
+
+  ;; lane 0 of the bytes 31, 0, 30, 1
+  (func (export "shuffle") (result i32)
+    v128.const i8x16 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15
+    v128.const i8x16 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31
+    i8x16.shuffle 31 0 30 1 4 5 6 7 8 9 10 11 12 13 14 15
+    i32x4.extract_lane 0)
+
+  ;; doubles the four words at 0 into 16 and returns the word at 16 + 4 * i
+  (func (export "memory") (param $i i32) (result i32)
+    i32.const 16
+    i32.const 0
+    v128.load
+    i32.const 0
+    v128.load offset=0
+    i32x4.add
+    v128.store
+    local.get $i
+    i32.const 2
+    i32.shl
+    i32.load offset=16)
+
+  ;; which of the lanes 0, 1, 2, 3 are greater than a
+  (func (export "bitmask") (param $a i32) (result i32)
+    local.get $a
+    i32x4.splat
+    v128.const i32x4 0 1 2 3
+    i32x4.lt_s
+    i32x4.bitmask)
+
+  (func (export "sqrt") (param $a i32) (result i32)
+    local.get $a
+    f64.convert_i32_s
+    f64x2.splat
+    f64x2.sqrt
+    f64x2.extract_lane 1
+    i32.trunc_f64_s)
+
+  ;; a ? x : y, lane 1
+  (func (export "select") (param $a i32) (result i32)
+    v128.const i32x4 1 2 3 4
+    v128.const i32x4 5 6 7 8
+    local.get $a
+    select
+    i32x4.extract_lane 1)
+
+  ;; v128 parameters & results
+  (func $twice (export "twice") (param v128) (result v128)
+    local.get 0
+    local.get 0
+    i32x4.add)
+
+  (func (export "call_twice") (param $a i32) (result i32)
+    local.get $a
+    i32x4.splat
+    call $twice
+    i32x4.extract_lane 3)
+
+  ;; the host's results are handed back to our caller
+  (func (export "tail_swap") (param v128) (result i32 v128)
+    local.get 0
+    i32.const 0
+    return_call_indirect (type $swap))
+)
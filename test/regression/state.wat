@@ -0,0 +1,69 @@
+;; state that snapshots, memory checkpoints & pre-initialization capture: linear memory (active and passive data),
+;; a mutable global, the start function having run and data.drop
+(module
+  (memory 1 4)
+  (data (i32.const 0) "\2a\00\00\00")
+  (data "\07\00\00\00")
+
+  (global $value (export "current") (mut i32) (i32.const 1))
+  (global $started (mut i32) (i32.const 0))
+
+  (func $start
+    global.get $started
+    i32.const 1
+    i32.add
+    global.set $started)
+  (start $start)
+
+  (func (export "started") (result i32)
+    global.get $started)
+
+  (func (export "load") (param $address i32) (result i32)
+    local.get $address
+    i32.load)
+
+  (func (export "store") (param $address i32) (param $value i32)
+    local.get $address
+    local.get $value
+    i32.store)
+
+  (func (export "value") (result i32)
+    global.get $value)
+
+  (func (export "bump") (result i32)
+    global.get $value
+    i32.const 1
+    i32.add
+    global.set $value
+    global.get $value)
+
+  (func (export "grow") (result i32)
+    i32.const 1
+    memory.grow)
+
+  (func (export "size") (result i32)
+    memory.size)
+
+  ;; copies the passive segment to address
+  (func (export "copy_segment") (param $address i32)
+    local.get $address
+    i32.const 0
+    i32.const 4
+    memory.init 1)
+
+  (func (export "drop_segment")
+    data.drop 1)
+
+  ;; what pre-initialization bakes in
+  (func (export "init")
+    i32.const 100
+    i32.const 123
+    i32.store
+    i32.const 8
+    i32.const 0
+    i32.const 4
+    memory.init 1
+    data.drop 1
+    i32.const 50
+    global.set $value)
+)
@@ -0,0 +1,31 @@
+;; env.pause suspends the call it's made from and returns twice its argument once resumed
+(module
+  (import "env" "pause" (func $pause (param i32) (result i32)))
+
+  ;; pause (0) + pause (1) + ... + pause (n - 1)
+  (func (export "run") (param $n i32) (result i32) (local $i i32) (local $sum i32)
+    block
+      loop
+        local.get $i
+        local.get $n
+        i32.ge_u
+        br_if 1
+        local.get $sum
+        local.get $i
+        call $pause
+        i32.add
+        local.set $sum
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br 0
+      end
+    end
+    local.get $sum)
+
+  (func (export "twice") (param i32) (result i32)
+    local.get 0
+    i32.const 2
+    i32.mul)
+)
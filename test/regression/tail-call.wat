@@ -0,0 +1,79 @@
+;; return_call & return_call_indirect reuse the caller's frame, so none of these grow the stack with the count
+(module
+  (type $binop (func (param i32 i32) (result i32)))
+
+  (import "env" "add" (func $add (type $binop)))
+  (import "env" "missing" (func $missing (type $binop)))    ;; never linked
+
+  (table 4 funcref)
+  (elem (i32.const 0) $add $missing $count_indirect)
+
+  ;; counts n down to 0, adding 1 to acc each time
+  (func $count (export "count") (param $n i32) (param $acc i32) (result i32)
+    local.get $n
+    i32.eqz
+    if
+      local.get $acc
+      return
+    end
+    local.get $n
+    i32.const 1
+    i32.sub
+    local.get $acc
+    i32.const 1
+    i32.add
+    return_call $count)
+
+  (func $count_indirect (export "count_indirect") (param $n i32) (param $acc i32) (result i32)
+    local.get $n
+    i32.eqz
+    if
+      local.get $acc
+      return
+    end
+    local.get $n
+    i32.const 1
+    i32.sub
+    local.get $acc
+    i32.const 1
+    i32.add
+    i32.const 2
+    return_call_indirect (type $binop))
+
+  (func $is_even (export "is_even") (param $n i32) (result i32)
+    local.get $n
+    i32.eqz
+    if
+      i32.const 1
+      return
+    end
+    local.get $n
+    i32.const 1
+    i32.sub
+    return_call $is_odd)
+
+  (func $is_odd (param $n i32) (result i32)
+    local.get $n
+    i32.eqz
+    if
+      i32.const 0
+      return
+    end
+    local.get $n
+    i32.const 1
+    i32.sub
+    return_call $is_even)
+
+  ;; tail calls a host function through the table: its result is handed back to our caller
+  (func (export "call_host") (param i32 i32) (result i32)
+    local.get 0
+    local.get 1
+    i32.const 0
+    return_call_indirect (type $binop))
+
+  (func (export "call_missing") (param i32 i32) (result i32)
+    local.get 0
+    local.get 1
+    i32.const 1
+    return_call_indirect (type $binop))
+)
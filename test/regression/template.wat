@@ -0,0 +1,42 @@
+;; instances of a module template share its compiled code but each has its own memory, globals & table
+(module
+  (type $get (func (result i32)))
+
+  (memory 1)
+  (data (i32.const 0) "\07\00\00\00")
+
+  (global $counter (mut i32) (i32.const 10))
+
+  (table 1 funcref)
+  (elem (i32.const 0) $inc)
+
+  (func $inc (export "inc") (result i32)
+    global.get $counter
+    i32.const 1
+    i32.add
+    global.set $counter
+    global.get $counter)
+
+  (func (export "inc_indirect") (result i32)
+    i32.const 0
+    call_indirect (type $get))
+
+  (func (export "store") (param i32)
+    i32.const 0
+    local.get 0
+    i32.store)
+
+  (func (export "load") (result i32)
+    i32.const 0
+    i32.load)
+
+  ;; calls a function that's compiled after it; the call is linked when the template is compiled
+  (func (export "call_later") (param i32) (result i32)
+    local.get 0
+    call $later)
+
+  (func $later (param i32) (result i32)
+    local.get 0
+    i32.const 100
+    i32.add)
+)
@@ -0,0 +1,97 @@
+;; op_Entry only zeroes the locals that might be read before they're written (see firstZeroedLocalByte). "run"
+;; fills the stack with garbage first, so that a local that isn't zeroed when it should be reads it
+(module
+  (type $case (func (param i32) (result i32)))
+
+  (table 6 funcref)
+  (elem (i32.const 0) $branch $wide $block $loop $written $tee)
+
+  (func $dirty (local i64 i64 i64 i64 i64 i64 i64 i64 i64 i64 i64 i64 i64 i64 i64 i64)
+    i64.const -1 local.set 0    i64.const -1 local.set 1    i64.const -1 local.set 2    i64.const -1 local.set 3
+    i64.const -1 local.set 4    i64.const -1 local.set 5    i64.const -1 local.set 6    i64.const -1 local.set 7
+    i64.const -1 local.set 8    i64.const -1 local.set 9    i64.const -1 local.set 10   i64.const -1 local.set 11
+    i64.const -1 local.set 12   i64.const -1 local.set 13   i64.const -1 local.set 14   i64.const -1 local.set 15)
+
+  ;; table [case] (x), called on top of the garbage $dirty left
+  (func (export "run") (param $case i32) (param $x i32) (result i32)
+    call $dirty
+    local.get $x
+    local.get $case
+    call_indirect (type $case))
+
+  ;; written on one path only: x ? 5 : 0
+  (func $branch (param $x i32) (result i32) (local $a i32)
+    block
+      local.get $x
+      i32.eqz
+      br_if 0
+      i32.const 5
+      local.set $a
+    end
+    local.get $a)
+
+  ;; never written: x
+  (func $wide (param $x i32) (result i32) (local $a i64) (local $b f64) (local $c f32)
+    local.get $x
+    local.get $a
+    i32.wrap_i64
+    i32.add
+    local.get $b
+    i32.trunc_f64_s
+    i32.add
+    local.get $c
+    i32.trunc_f32_s
+    i32.add)
+
+  ;; read in a block before it's written at the top level: x + 7
+  (func $block (param $x i32) (result i32) (local $a i32) (local $b i32)
+    block
+      local.get $a
+      local.set $b
+    end
+    i32.const 7
+    local.set $a
+    local.get $b
+    local.get $a
+    i32.add
+    local.get $x
+    i32.add)
+
+  ;; each iteration adds the index the previous one stored: 0 + 0 + 1 + ... + (x - 2)
+  (func $loop (param $x i32) (result i32) (local $i i32) (local $previous i32) (local $sum i32)
+    block
+      loop
+        local.get $i
+        local.get $x
+        i32.ge_u
+        br_if 1
+        local.get $sum
+        local.get $previous
+        i32.add
+        local.set $sum
+        local.get $i
+        local.set $previous
+        local.get $i
+        i32.const 1
+        i32.add
+        local.set $i
+        br 0
+      end
+    end
+    local.get $sum)
+
+  ;; written before it's read: x + 3
+  (func $written (param $x i32) (result i32) (local $a i32)
+    i32.const 3
+    local.set $a
+    local.get $a
+    local.get $x
+    i32.add)
+
+  ;; read, then written in the same expression: x
+  (func $tee (param $x i32) (result i32) (local $a i32)
+    local.get $a
+    local.get $x
+    local.tee $a
+    i32.add)
+)